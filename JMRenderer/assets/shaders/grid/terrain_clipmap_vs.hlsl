@@ -0,0 +1,95 @@
+cbuffer SceneCB : register(b0){
+    float4x4 gWVP;
+    float3   gLightDir; float _pad0;
+    float3   gFogColor; float gFogDensity;
+    float3   gCamPos;   float _pad1;
+}
+cbuffer TerrainCB : register(b1){
+    float   HeightScale;
+    float   UseBakedNormals;             // 클립맵 경로는 사용 안 함
+    float2  _padA;
+    float2  GridSize;                    // world size (X,Z) in meters
+    float2  TexelSize;                   // (1/texW, 1/texH) - 원본 레벨 0 기준
+}
+// 레벨 드로우 상수 (TerrainClipmapCB)
+cbuffer ClipmapCB : register(b3){
+    int2    ClipOrigin;                  // 창 원점 (레벨 샘플)
+    float2  CamSample;                   // 카메라 (레벨 샘플 좌표)
+    float   LevelScale;                  // 2^level (레벨 0 텍셀 단위 간격)
+    float   Level;
+    float   CoarseLevel;                 // 모핑 대상 레벨 (-1 = 없음)
+    float   MorphStart;
+    float   MorphInvWidth;
+    float   ClipSize;                    // 레벨 텍스처 한 변 (2의 거듭제곱)
+    float2  _padC;
+}
+
+// 슬라이스 = 레벨, 토러스 주소 (샘플 i → i & (ClipSize-1))
+Texture2DArray<float> gClip : register(t0);
+
+struct VSOut
+{
+    float4 pos:SV_POSITION;
+    float3 nrmWS:NORMAL;
+    float2 uv:TEXCOORD0;
+    float3 worldPos:TEXCOORD1;
+};
+
+float LoadHeight(int2 s, float level)
+{
+    int m = (int)ClipSize - 1;
+    return gClip.Load(int4(s.x & m, s.y & m, (int)level, 0)) * HeightScale;
+}
+
+// 거친 레벨 높이를 고운 레벨 샘플 위치에서 (홀수 좌표는 이웃 평균 = 거친 격자 변 위의 점)
+float CoarseHeight(int2 s)
+{
+    int2 c = s >> 1;
+    int2 f = s & 1;
+    return 0.25 * (LoadHeight(c, CoarseLevel) + LoadHeight(c + int2(f.x, 0), CoarseLevel) +
+                   LoadHeight(c + int2(0, f.y), CoarseLevel) + LoadHeight(c + f, CoarseLevel));
+}
+
+// 중앙 차분 노멀 (step: 샘플 간격의 월드 크기)
+float3 NormalFromDiff(float hl, float hr, float hd, float hu, float2 step)
+{
+    return normalize(float3(-(hr - hl) / (2.0 * step.x), 1.0, -(hu - hd) / (2.0 * step.y)));
+}
+
+VSOut VSMain(uint vid : SV_VertexID)
+{
+    VSOut o;
+
+    // 행 우선 정점 번호 → 창 안 격자 좌표 → 레벨 샘플
+    uint vn = (uint)ClipSize - 1;
+    int2 s = ClipOrigin + int2(vid % vn, vid / vn);
+
+    // 이웃은 창 안으로 (창 밖 토러스 텍셀은 다른 위치)
+    int2 lo = ClipOrigin, hi = ClipOrigin + (int)ClipSize - 1;
+    float2 step = LevelScale * GridSize * TexelSize;
+    float  h = LoadHeight(s, Level);
+    float3 n = NormalFromDiff(LoadHeight(max(s - int2(1, 0), lo), Level), LoadHeight(min(s + int2(1, 0), hi), Level),
+                              LoadHeight(max(s - int2(0, 1), lo), Level), LoadHeight(min(s + int2(0, 1), hi), Level), step);
+
+    // 창 바깥쪽은 거친 레벨로 모핑: 가장자리 정점은 거친 링의 변 위에 놓인다 (틈 없음)
+    if (CoarseLevel >= 0.0) {
+        float2 d = abs(float2(s) - CamSample);
+        float  a = saturate((max(d.x, d.y) - MorphStart) * MorphInvWidth);
+        if (a > 0.0) {
+            float  hc = CoarseHeight(s);
+            float3 nc = NormalFromDiff(CoarseHeight(s - int2(2, 0)), CoarseHeight(s + int2(2, 0)),
+                                       CoarseHeight(s - int2(0, 2)), CoarseHeight(s + int2(0, 2)), step);
+            h = lerp(h, hc, a);
+            n = normalize(lerp(n, nc, a));
+        }
+    }
+
+    // 레벨 0 텍셀 중심 기준 월드 XZ (지형은 원점 중심, 원본 밖은 래핑 반복)
+    float2 xz = ((float2(s) * LevelScale + 0.5) * TexelSize - 0.5) * GridSize;
+    float3 p = float3(xz.x, h, xz.y);
+    o.pos   = mul(float4(p, 1), gWVP);
+    o.nrmWS = n;
+    o.uv    = xz / GridSize + 0.5;
+    o.worldPos = p;
+    return o;
+}
@@ -1,3 +1,12 @@
+// 변형 define (ShaderProgram 기능 키). 없으면 전부 켠 기본 셰이더
+// FOG: 0이면 거리 안개 생략 / SPLAT_COUNT: 0 = 텍스처 없음(와이어프레임), 1 = 풀, 2 = +바위, 3 = +눈
+#ifndef FOG
+#define FOG 1
+#endif
+#ifndef SPLAT_COUNT
+#define SPLAT_COUNT 3
+#endif
+
 cbuffer SceneCB : register(b0)
 {
     float4x4 gWVP;
@@ -8,7 +17,7 @@ cbuffer SceneCB : register(b0)
 
 cbuffer TerrainCB : register(b1)
 { 
-    float   HeightScale; float3 _padA;
+    float   HeightScale; float UseBakedNormals; float2 _padA;
     float2  GridSize;
     float2  TexelSize;
 }
@@ -41,13 +50,25 @@ float4 PSMain(PSIn i) : SV_TARGET
     float3 N = normalize(i.nrmWS);
     float  ndl = saturate(dot(N, normalize(-gLightDir)));
 
+#if SPLAT_COUNT == 0
+    float3 albedo = float3(0.6, 0.6, 0.6);
+#else
+    float2 uv = i.uv * uvScale;
+    float3 cGrass = tGrass.Sample(sAlbedo, uv).rgb;
+  #if SPLAT_COUNT == 1
+    float3 albedo = cGrass;
+  #else
+    float slope = 1.0 - saturate(N.y);
+    float wRock = smoothstep(thresholds.z, thresholds.w, slope);
+    float3 cRock = tRock.Sample(sAlbedo, uv).rgb;
+    #if SPLAT_COUNT == 2
+    float3 albedo = lerp(cGrass, cRock, wRock);     // 두 가중치 합이 1 → 정규화 불필요
+    #else
     // 높이 0~1 추정 (HeightScale 사용 안 하면 스스로 정규화해도 OK)
     float hNorm = saturate((i.worldPos.y) / max(HeightScale, 1e-4));
-    float slope = 1.0 - saturate(N.y);
 
     // 가중치
     float wSnow  = smoothstep(thresholds.y - band, thresholds.y + band, hNorm);
-    float wRock  = smoothstep(thresholds.z, thresholds.w, slope);
     float wGrass = 1.0 - max(wSnow, wRock);
 
     // 정규화(선택)
@@ -56,20 +77,19 @@ float4 PSMain(PSIn i) : SV_TARGET
     wRock /= sum; 
     wSnow /= sum;
 
-    // 샘플
-    float2 uv = i.uv * uvScale;
-    float3 cGrass = tGrass.Sample(sAlbedo, uv).rgb;
-    float3 cRock  = tRock .Sample(sAlbedo, uv).rgb;
     float3 cSnow  = tSnow .Sample(sAlbedo, uv).rgb;
-
     float3 albedo = wGrass*cGrass + wRock*cRock + wSnow*cSnow;
-    // float3 albedo = wGrass*cGrass;
+    #endif
+  #endif
+#endif
     float3 col = albedo * (0.2 + 0.8 * ndl);
 
+#if FOG
     // Fog: 거리 기반
     float d = distance(i.worldPos, gCamPos);
     float f = saturate(1.0 - exp(-gFogDensity * d));
     col = lerp(col, gFogColor, f);
+#endif
 
     return float4(col, 1);
 }
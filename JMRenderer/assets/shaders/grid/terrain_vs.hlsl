@@ -5,21 +5,43 @@ cbuffer SceneCB : register(b0){
     float3   gCamPos;   float _pad1;
 }
 cbuffer TerrainCB : register(b1){
-    float   HeightScale; float3 _padA;   // 16B
+    float   HeightScale;
+    float   UseBakedNormals;             // 1: gNormalHeight 한 번 샘플 (CPU 베이크)
+    float2  _padA;                       // 16B
     float2  GridSize;                    // world size (X,Z) in meters
     float2  TexelSize;                   // (1/texW, 1/texH)
 }
+cbuffer NodeCB : register(b3){
+    float2  NodeOrigin;                  // 노드 최소 모서리 (world XZ)
+    float2  NodeSize;                    // 노드 크기 (world XZ)
+    float2  MorphConsts;                 // (start, 1/(end-start))
+    float   PatchRes;                    // 패치 한 변의 쿼드 수
+    float   _padN;
+}
 
 Texture2D    gHeight : register(t0);
+Texture2D    gNormalHeight : register(t1);   // rgb = 노멀*0.5+0.5, a = 높이
 SamplerState gSamp   : register(s0);
 
+// BAKED_NORMALS: 변형 define (1 = t1 한 번 샘플, 0 = 높이 3번 + 차분). 없으면 UseBakedNormals로 런타임 분기
+#ifdef BAKED_NORMALS
+#define USE_BAKED_NORMALS (BAKED_NORMALS != 0)
+#else
+#define USE_BAKED_NORMALS (UseBakedNormals > 0.5)
+#endif
+
+// Float32: VertexPNT 중 uv만 사용 (POSITION/NORMAL은 레이아웃에만 남음)
 struct VSIn  
 { 
-    float3 pos:POSITION; 
-    float3 nrm:NORMAL; 
     float2 uv:TEXCOORD0; 
 };
 
+// Quant16: 정수 격자 좌표 (R16G16_UINT)
+struct VSInQuant16
+{
+    uint2 cell:TEXCOORD0;
+};
+
 struct VSOut 
 {
     float4 pos:SV_POSITION;
@@ -28,16 +50,28 @@ struct VSOut
     float3 worldPos:TEXCOORD1;   
 };
 
-VSOut VSMain(VSIn i)
+// 패치 로컬 좌표(0~1)를 한 단계 거친 LOD 격자로 모핑 (CDLOD)
+float2 MorphVertex(float2 g, float k)
 {
-    VSOut o;
+    float2 f = frac(g * PatchRes * 0.5) * 2.0 / PatchRes;
+    return g - f * k;
+}
+
+float2 WorldXZ(float2 g) { return NodeOrigin + g * NodeSize; }
+float2 TerrainUV(float2 xz) { return xz / GridSize + 0.5; } // 지형은 원점 중심
 
-    // 중앙 높이
-    float h  = gHeight.SampleLevel(gSamp, i.uv, 0).r * HeightScale;
+float SampleHeight(float2 uv)
+{
+    if (USE_BAKED_NORMALS) return gNormalHeight.SampleLevel(gSamp, uv, 0).a * HeightScale;
+    return gHeight.SampleLevel(gSamp, uv, 0).r * HeightScale;
+}
 
+// 기존 경로: 높이 3번 샘플 + 전방 차분 노멀
+float3 NormalFromHeights(float2 uv, float h)
+{
     // 이웃 샘플(오른쪽/아래)로 기울기 근사
-    float hr = gHeight.SampleLevel(gSamp, i.uv + float2(TexelSize.x, 0), 0).r * HeightScale;
-    float hd = gHeight.SampleLevel(gSamp, i.uv + float2(0, TexelSize.y), 0).r * HeightScale;
+    float hr = gHeight.SampleLevel(gSamp, uv + float2(TexelSize.x, 0), 0).r * HeightScale;
+    float hd = gHeight.SampleLevel(gSamp, uv + float2(0, TexelSize.y), 0).r * HeightScale;
 
     // 월드 기준 이웃 간격(그리드 전체 크기 × 텍셀 크기)
     float dx = GridSize.x * TexelSize.x;
@@ -47,12 +81,50 @@ VSOut VSMain(VSIn i)
     float3 Tr = float3(dx, hr - h, 0);
     float3 Bd = float3(0,  hd - h, dz);
 
-    float3 n = normalize(cross(Bd, Tr)); // 우핸드(LH) 기준
+    return normalize(cross(Bd, Tr)); // 우핸드(LH) 기준
+}
 
-    float3 p = i.pos; p.y += h;          // 위치 변위
+// g: 패치 로컬 좌표(0~1)
+VSOut TerrainVS(float2 g)
+{
+    VSOut o;
+
+    // 모핑 계수: 모핑 전 정점 위치의 카메라 거리 (CPU LOD 거리와 동일 기준)
+    float2 xz0 = WorldXZ(g);
+    float  h0  = SampleHeight(TerrainUV(xz0));
+    float  k   = saturate((distance(float3(xz0.x, h0, xz0.y), gCamPos) - MorphConsts.x) * MorphConsts.y);
+
+    float2 xz = WorldXZ(MorphVertex(g, k));
+    float2 uv = TerrainUV(xz);
+
+    // 높이 + 노멀: 베이크 경로는 한 번 샘플
+    float  h;
+    float3 n;
+    if (USE_BAKED_NORMALS) {
+        float4 nh = gNormalHeight.SampleLevel(gSamp, uv, 0);
+        h = nh.a * HeightScale;
+        n = normalize(nh.rgb * 2.0 - 1.0);
+    }
+    else {
+        h = gHeight.SampleLevel(gSamp, uv, 0).r * HeightScale;
+        n = NormalFromHeights(uv, h);
+    }
+
+    float3 p = float3(xz.x, h, xz.y);    // 위치 변위
     o.pos   = mul(float4(p,1), gWVP);
     o.nrmWS = n;
-    o.uv    = i.uv;
+    o.uv    = uv;
     o.worldPos = p;
     return o;
 }
+
+VSOut VSMain(VSIn i) { return TerrainVS(i.uv); }
+
+VSOut VSMainQuant16(VSInQuant16 i) { return TerrainVS(float2(i.cell) / PatchRes); }
+
+// 정점 버퍼 없음: 행 우선 정점 번호 → 격자 좌표
+VSOut VSMainVertexId(uint vid : SV_VertexID)
+{
+    uint vn = (uint)PatchRes + 1;
+    return TerrainVS(float2(vid % vn, vid / vn) / PatchRes);
+}
@@ -0,0 +1,613 @@
+#include "AssetManager.h"
+#include "../utils/BMPDecode.h"
+#include "../utils/BMTexture.h"
+#include "../utils/FileWatcher.h"
+#include "../utils/JobSystem.h"
+#include "../utils/Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+
+using Microsoft::WRL::ComPtr;
+
+//  TextureHandle 
+TextureHandle::TextureHandle(AssetManager* owner, uint32_t slot, uint32_t gen)
+    : mOwner(owner), mSlot(slot), mGen(gen) {}
+
+TextureHandle::TextureHandle(const TextureHandle& o) : mOwner(o.mOwner), mSlot(o.mSlot), mGen(o.mGen)
+{
+    if (mOwner) mOwner->AddRef(mSlot, mGen);
+}
+
+TextureHandle::TextureHandle(TextureHandle&& o) noexcept : mOwner(o.mOwner), mSlot(o.mSlot), mGen(o.mGen)
+{
+    o.mOwner = nullptr;
+}
+
+TextureHandle& TextureHandle::operator=(const TextureHandle& o)
+{
+    if (this != &o) {
+        if (o.mOwner) o.mOwner->AddRef(o.mSlot, o.mGen);
+        Reset();
+        mOwner = o.mOwner; mSlot = o.mSlot; mGen = o.mGen;
+    }
+    return *this;
+}
+
+TextureHandle& TextureHandle::operator=(TextureHandle&& o) noexcept
+{
+    if (this != &o) {
+        Reset();
+        mOwner = o.mOwner; mSlot = o.mSlot; mGen = o.mGen;
+        o.mOwner = nullptr;
+    }
+    return *this;
+}
+
+TextureHandle::~TextureHandle() { Reset(); }
+
+void TextureHandle::Reset()
+{
+    if (mOwner) mOwner->Release(mSlot, mGen);
+    mOwner = nullptr;
+}
+
+//   ƿ 
+static size_t TextureBytes(ID3D11ShaderResourceView* srv)
+{
+    if (!srv) return 0;
+    ComPtr<ID3D11Resource> res;
+    srv->GetResource(res.GetAddressOf());
+    ComPtr<ID3D11Texture2D> tex;
+    if (FAILED(res.As(&tex))) return 0;
+
+    D3D11_TEXTURE2D_DESC td{};
+    tex->GetDesc(&td);
+    size_t total = 0;
+    for (UINT m = 0; m < td.MipLevels; ++m) {
+        const size_t w = std::max(1u, td.Width >> m), h = std::max(1u, td.Height >> m);
+        const size_t blocks = ((w + 3) / 4) * ((h + 3) / 4);
+        switch (td.Format) {
+        case DXGI_FORMAT_BC1_UNORM:
+        case DXGI_FORMAT_BC4_UNORM: total += blocks * 8; break;
+        case DXGI_FORMAT_BC5_UNORM: total += blocks * 16; break;
+        case DXGI_FORMAT_R8_UNORM:  total += w * h; break;
+        default:                    total += w * h * 4; break;
+        }
+    }
+    return total * td.ArraySize;
+}
+
+static bool IsBC(TextureKind k) { return k == TextureKind::BC1 || k == TextureKind::BC4 || k == TextureKind::BC5; }
+
+static BC::Format ToBC(TextureKind k)
+{
+    return k == TextureKind::BC4 ? BC::Format::BC4 : (k == TextureKind::BC5 ? BC::Format::BC5 : BC::Format::BC1);
+}
+
+// ε   (px). BC 4x4  
+static constexpr unsigned kHashBlock = 64;
+
+//   ϳ ޸ ġ:   = ȼ   (BC 4x4   )
+struct LevelLayout {
+    unsigned w, h;          // px
+    unsigned unitPx;        // 1 Ǵ 4 (BC)
+    size_t   unitBytes;     // ȼ Ǵ  ϳ
+    unsigned Units() const { return (w + unitPx - 1) / unitPx; }
+    unsigned Rows() const { return (h + unitPx - 1) / unitPx; }
+};
+
+static LevelLayout LevelOf(DXGI_FORMAT fmt, unsigned w0, unsigned h0, size_t level)
+{
+    LevelLayout L{ std::max(1u, w0 >> level), std::max(1u, h0 >> level), 1, 4 };
+    switch (fmt) {
+    case DXGI_FORMAT_BC1_UNORM:
+    case DXGI_FORMAT_BC4_UNORM: L.unitPx = 4; L.unitBytes = 8; break;
+    case DXGI_FORMAT_BC5_UNORM: L.unitPx = 4; L.unitBytes = 16; break;
+    case DXGI_FORMAT_R8_UNORM:  L.unitBytes = 1; break;
+    default: break;
+    }
+    return L;
+}
+
+// 8Ʈ /ȸ (ȣ ؽ ƴ, ٲ  ã)
+static uint64_t HashBytes(const uint8_t* p, size_t n, uint64_t h)
+{
+    for (; n >= 8; p += 8, n -= 8) {
+        uint64_t v;
+        memcpy(&v, p, 8);
+        h = (h ^ v) * 0x9E3779B97F4A7C15ull;
+        h = (h << 31) | (h >> 33);
+    }
+    for (; n; ++p, --n) h = (h ^ *p) * 0x100000001B3ull;
+    return h;
+}
+
+// ĳ Ű ɼ κ:  ؽó/CPU 纻 ٲٴ ʵ  ( ε AddTexture )
+static std::string OptionsKey(const TextureLoadOptions& opt)
+{
+    std::string key;
+    key += '|'; key += std::to_string((int)opt.kind);
+    key += '|'; key += std::to_string((int)opt.mips);
+    key += "|q"; key += std::to_string((int)opt.quality);
+    key += opt.keepCpuCopy ? "|cpu1" : "|cpu0";
+    return key;
+}
+
+//  AssetManager 
+std::string AssetManager::MakeKey(const std::filesystem::path& path, const TextureLoadOptions& opt)
+{
+    return FileWatcher::PathKey(path) + OptionsKey(opt);
+}
+
+void AssetManager::Init(ID3D11Device* dev, ID3D11DeviceContext* ctx)
+{
+    mDev = dev;
+    mCtx = ctx;
+    mEpoch = std::chrono::steady_clock::now();
+    mMarkers.clear();
+
+    // 1x1 ÷̽Ȧ: ˺ ߰ ȸ, ̴ 0 ()
+    static const uint8_t gray[4] = { 128, 128, 128, 255 };
+    static const uint8_t zero[1] = { 0 };
+    BMP::Image img;
+    img.width = img.height = 1;
+    img.format = BMP::PixelFormat::RGBA8; img.rowPitch = 4; img.data = gray;
+    BMP::CreateSRV(dev, img, mPlaceholderColor);
+    img.format = BMP::PixelFormat::R8; img.rowPitch = 1; img.data = zero;
+    BMP::CreateSRV(dev, img, mPlaceholderHeight);
+}
+
+double AssetManager::NowMs() const
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - mEpoch).count();
+}
+
+//  Ŀ  (D3D ȣ ) 
+void AssetManager::PrepareImage(const BMP::Image& img, const TextureLoadOptions& opt, LoadResult& r)
+{
+    r.width = img.width; r.height = img.height;
+    r.ok = IsBC(opt.kind)
+        ? BMP::PrepareCompressed(img, ToBC(opt.kind), opt.quality, opt.mips, r.data, true)
+        : BMP::Prepare(img, opt.mips, r.data);
+
+    //  0  ŰǷ 
+    if (r.ok && opt.keepCpuCopy && img.format == BMP::PixelFormat::R8) {
+        r.cpuPixels.resize((size_t)img.width * img.height);
+        for (unsigned y = 0; y < img.height; ++y)
+            std::copy_n(img.data + y * img.rowPitch, img.width, r.cpuPixels.data() + (size_t)y * img.width);
+    }
+    if (r.ok) HashBlocks(r.data, r.blockHashes);
+}
+
+void AssetManager::HashBlocks(const BMP::TextureData& d, std::vector<std::vector<uint64_t>>& out)
+{
+    //        ش  ؽÿ 
+    out.assign(d.levels.size(), {});
+    for (size_t l = 0; l < d.levels.size(); ++l) {
+        const LevelLayout L = LevelOf(d.format, d.width, d.height, l);
+        const unsigned gx = (L.w + kHashBlock - 1) / kHashBlock, gz = (L.h + kHashBlock - 1) / kHashBlock;
+        const unsigned perBlock = kHashBlock / L.unitPx, units = L.Units();
+        const uint8_t* base = static_cast<const uint8_t*>(d.levels[l].pSysMem);
+        std::vector<uint64_t>& hs = out[l];
+        hs.assign((size_t)gx * gz, 0xCBF29CE484222325ull);
+        for (unsigned row = 0; row < L.Rows(); ++row) {
+            const uint8_t* src = base + (size_t)row * d.levels[l].SysMemPitch;
+            uint64_t* hrow = hs.data() + (size_t)(row * L.unitPx / kHashBlock) * gx;
+            for (unsigned bx = 0; bx < gx; ++bx) {
+                const unsigned u0 = bx * perBlock, n = std::min(perBlock, units - u0);
+                hrow[bx] = HashBytes(src + u0 * L.unitBytes, n * L.unitBytes, hrow[bx]);
+            }
+        }
+    }
+}
+
+void AssetManager::PrepareFile(const std::filesystem::path& path, const TextureLoadOptions& opt, LoadResult& r)
+{
+    const bool gray = (opt.kind == TextureKind::R8 || opt.kind == TextureKind::BC4);
+    BMP::Image& img = r.data.source;   // TextureData   Ѵ
+    if (!(gray ? BMP::DecodeR8(path, img) : BMP::DecodeRGBA8(path, img))) { r.ok = false; return; }
+    PrepareImage(img, opt, r);
+}
+
+//    
+uint32_t AssetManager::NewEntry(const std::string& key, const std::string& name, TextureKind kind)
+{
+    uint32_t slot;
+    if (!mFreeSlots.empty()) { slot = mFreeSlots.back(); mFreeSlots.pop_back(); }
+    else { slot = (uint32_t)mEntries.size(); mEntries.emplace_back(); }
+
+    Entry& e = mEntries[slot];
+    e.used = true;
+    e.kind = kind;
+    e.info = TextureInfo{};
+    e.info.key = key;
+    e.info.name = name;
+    e.info.queuedMs = NowMs();
+
+    mByKey[key] = slot;
+    ++mStats.entries;
+    return slot;
+}
+
+void AssetManager::Complete(uint32_t slot, LoadResult& r)
+{
+    Entry& e = mEntries[slot];
+    e.info.beginMs = r.beginMs;
+    e.info.decodedMs = r.decodedMs;
+    if (r.ok && mDev) r.ok = BMP::CreateSRV(mDev, r.data, e.srv);
+
+    e.info.readyMs = NowMs();
+    e.info.loadMs = e.info.readyMs - e.info.beginMs;
+    if (r.ok) {
+        e.info.state = AssetState::Ready;
+        e.info.width = r.width; e.info.height = r.height;
+        e.info.psnr = r.data.psnr;
+        e.info.cpuPixels = std::move(r.cpuPixels);
+        e.info.gpuBytes = TextureBytes(e.srv.Get());
+        e.blockHashes = std::move(r.blockHashes);
+        mStats.gpuBytes += e.info.gpuBytes;
+        ++mStats.loads;
+    }
+    else e.info.state = AssetState::Failed;
+
+    // ݹ ȿ  ε尡  mEntries Ŀ  ־   д
+    std::vector<LoadCallback> cbs;
+    cbs.swap(e.callbacks);
+    const TextureInfo info = e.info;
+    for (auto& cb : cbs) cb(r.ok, info);
+}
+
+TextureHandle AssetManager::LoadTexture(const std::filesystem::path& path, const TextureLoadOptions& opt)
+{
+    const std::string key = MakeKey(path, opt);
+    auto it = mByKey.find(key);
+    if (it != mByKey.end()) {
+        ++mStats.hits;
+        return Acquire(it->second);
+    }
+    if (!mDev) return {};
+
+    LoadResult r;
+    r.beginMs = NowMs();
+    PrepareFile(path, opt, r);
+    r.decodedMs = NowMs();
+    if (!r.ok) return {};
+
+    const uint32_t slot = NewEntry(key, path.filename().u8string(), opt.kind);
+    SetSource(mEntries[slot], path, opt);
+    Complete(slot, r);
+    return Acquire(slot);
+}
+
+TextureHandle AssetManager::LoadTextureAsync(const std::filesystem::path& path, const TextureLoadOptions& opt,
+    LoadCallback onDone)
+{
+    const std::string key = MakeKey(path, opt);
+    auto it = mByKey.find(key);
+    if (it != mByKey.end()) {
+        ++mStats.hits;
+        Entry& e = mEntries[it->second];
+        if (onDone) {
+            if (e.info.state == AssetState::Pending) e.callbacks.push_back(std::move(onDone));
+            else onDone(e.info.state == AssetState::Ready, e.info);
+        }
+        return Acquire(it->second);
+    }
+    if (!mDev) return {};
+
+    const uint32_t slot = NewEntry(key, path.filename().u8string(), opt.kind);
+    SetSource(mEntries[slot], path, opt);
+    if (onDone) mEntries[slot].callbacks.push_back(std::move(onDone));
+
+    PendingLoad pl;
+    pl.slot = slot;
+    pl.gen = mEntries[slot].gen;
+    pl.result = StartLoad(path, opt);
+    mPending.push_back(std::move(pl));
+    return Acquire(slot);
+}
+
+std::future<AssetManager::LoadResult> AssetManager::StartLoad(const std::filesystem::path& path,
+    const TextureLoadOptions& opt)
+{
+    const auto epoch = mEpoch;
+    auto ms = [epoch] { return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - epoch).count(); };
+    // ε帶 带  ʰ ٷ Ŀ ( ڵ  = Ŀ )
+    auto done = std::make_shared<std::promise<LoadResult>>();
+    std::future<LoadResult> result = done->get_future();
+    Jobs::Run([path, opt, ms, done] {
+        JM_PROFILE_ZONE("Texture Decode");
+        LoadResult r;
+        r.beginMs = ms();
+        PrepareFile(path, opt, r);
+        r.decodedMs = ms();
+        done->set_value(std::move(r));
+    }, &mLoads);
+    return result;
+}
+
+void AssetManager::SetSource(Entry& e, const std::filesystem::path& path, const TextureLoadOptions& opt)
+{
+    e.path = path;
+    e.pathKey = FileWatcher::PathKey(path);
+    e.opt = opt;
+}
+
+size_t AssetManager::Reload(const std::filesystem::path& path, LoadCallback onDone)
+{
+    //   ɼǸ ޸   о  ִ
+    const std::string pathKey = FileWatcher::PathKey(path);
+    size_t started = 0;
+    for (uint32_t i = 0; i < (uint32_t)mEntries.size(); ++i) {
+        Entry& e = mEntries[i];
+        // ù ε尡    ׸ ǳʶڴ (  Ϸ   ʰ)
+        if (!e.used || e.info.state == AssetState::Pending || e.pathKey != pathKey) continue;
+        if (e.reloading) { e.reloadAgain = true; continue; }
+        StartReload(i, onDone);
+        ++started;
+    }
+    return started;
+}
+
+void AssetManager::StartReload(uint32_t slot, LoadCallback onDone)
+{
+    Entry& e = mEntries[slot];
+    e.reloading = true;
+    e.reloadAgain = false;
+    PendingLoad pl;
+    pl.slot = slot;
+    pl.gen = e.gen;
+    pl.reload = true;
+    pl.onReload = std::move(onDone);
+    pl.result = StartLoad(e.path, e.opt);
+    mPending.push_back(std::move(pl));
+}
+
+size_t AssetManager::UploadChangedBlocks(Entry& e, const LoadResult& r, unsigned& row0, unsigned& row1)
+{
+    ComPtr<ID3D11Resource> res;
+    e.srv->GetResource(res.GetAddressOf());
+    size_t uploaded = 0;
+    row0 = r.data.height; row1 = 0;
+    for (size_t l = 0; l < r.data.levels.size(); ++l) {
+        const LevelLayout L = LevelOf(r.data.format, r.data.width, r.data.height, l);
+        const std::vector<uint64_t>& oldH = e.blockHashes[l];
+        const std::vector<uint64_t>& newH = r.blockHashes[l];
+        const uint8_t* base = static_cast<const uint8_t*>(r.data.levels[l].pSysMem);
+        const UINT pitch = r.data.levels[l].SysMemPitch;
+        const UINT sub = (UINT)l;
+
+        // BC  (4  ƴ ) ڽ  迡   °
+        if (L.unitPx > 1 && ((L.w | L.h) & 3u)) {
+            if (oldH != newH) {
+                mCtx->UpdateSubresource(res.Get(), sub, nullptr, base, pitch, 0);
+                uploaded += (size_t)L.Rows() * L.Units() * L.unitBytes;
+                if (l == 0) { row0 = 0; row1 = L.h; }
+            }
+            continue;
+        }
+
+        const unsigned gx = (L.w + kHashBlock - 1) / kHashBlock;
+        for (size_t b = 0; b < newH.size(); ++b) {
+            if (oldH[b] == newH[b]) continue;
+            D3D11_BOX box{};
+            box.left = (UINT)(b % gx) * kHashBlock;  box.right = std::min(L.w, box.left + kHashBlock);
+            box.top = (UINT)(b / gx) * kHashBlock;   box.bottom = std::min(L.h, box.top + kHashBlock);
+            box.front = 0; box.back = 1;
+            const uint8_t* src = base + (size_t)(box.top / L.unitPx) * pitch + (size_t)(box.left / L.unitPx) * L.unitBytes;
+            mCtx->UpdateSubresource(res.Get(), sub, &box, src, pitch, 0);
+            if (l == 0) { row0 = std::min(row0, (unsigned)box.top); row1 = std::max(row1, (unsigned)box.bottom); }
+            uploaded += (size_t)((box.bottom - box.top + L.unitPx - 1) / L.unitPx) *
+                        ((box.right - box.left + L.unitPx - 1) / L.unitPx) * L.unitBytes;
+        }
+    }
+    if (row1 <= row0) row0 = row1 = 0;
+    return uploaded;
+}
+
+void AssetManager::CompleteReload(uint32_t slot, LoadResult& r, const LoadCallback& onDone)
+{
+    Entry& e = mEntries[slot];
+    e.reloading = false;
+    // ϸ (  ߸  )  ؽó ״ д
+    if (r.ok && mDev) {
+        D3D11_TEXTURE2D_DESC td{};
+        if (e.srv) {
+            ComPtr<ID3D11Resource> res;
+            e.srv->GetResource(res.GetAddressOf());
+            ComPtr<ID3D11Texture2D> tex;
+            if (SUCCEEDED(res.As(&tex))) tex->GetDesc(&td);
+        }
+        const bool inPlace = mCtx && e.srv && td.Format == r.data.format && td.Width == r.data.width &&
+            td.Height == r.data.height && td.MipLevels == r.data.levels.size() &&
+            e.blockHashes.size() == r.blockHashes.size();
+
+        size_t uploaded;
+        unsigned row0 = 0, row1 = r.data.height;
+        if (inPlace) uploaded = UploadChangedBlocks(e, r, row0, row1);
+        else {
+            ComPtr<ID3D11ShaderResourceView> srv;
+            r.ok = BMP::CreateSRV(mDev, r.data, srv);
+            if (r.ok) {
+                mStats.gpuBytes -= e.info.gpuBytes;
+                e.srv = srv;
+                e.info.gpuBytes = TextureBytes(e.srv.Get());
+                mStats.gpuBytes += e.info.gpuBytes;
+            }
+            uploaded = e.info.gpuBytes;
+        }
+
+        if (r.ok) {
+            e.blockHashes = std::move(r.blockHashes);
+            e.info.state = AssetState::Ready;
+            e.info.width = r.width; e.info.height = r.height;
+            e.info.psnr = r.data.psnr;
+            if (e.opt.keepCpuCopy) e.info.cpuPixels = std::move(r.cpuPixels);
+            e.info.reloads++;
+            e.info.reloadUploadBytes = uploaded;
+            e.info.reloadMs = NowMs() - r.beginMs;
+            e.info.reloadRow0 = row0;
+            e.info.reloadRow1 = row1;
+            ++mStats.reloads;
+            mStats.reloadUploadBytes += uploaded;
+            mStats.reloadFullBytes += e.info.gpuBytes;
+        }
+    }
+    const bool again = e.reloadAgain;
+    if (onDone) {
+        const TextureInfo info = e.info;
+        onDone(r.ok, info);
+    }
+    // ݹ mEntries Ű  ־ e  slot
+    if (again && mEntries[slot].used) StartReload(slot, onDone);
+}
+
+TextureHandle AssetManager::AddTexture(const std::string& name, const BMP::Image& img, const TextureLoadOptions& opt)
+{
+    const std::string key = name + OptionsKey(opt);
+    auto it = mByKey.find(key);
+    if (it != mByKey.end()) {
+        ++mStats.hits;
+        return Acquire(it->second);
+    }
+    if (!mDev) return {};
+
+    LoadResult r;
+    r.beginMs = NowMs();
+    PrepareImage(img, opt, r);
+    r.decodedMs = NowMs();
+    if (!r.ok) return {};
+
+    const uint32_t slot = NewEntry(key, name, opt.kind);
+    Complete(slot, r);
+    return Acquire(slot);
+}
+
+size_t AssetManager::Update()
+{
+    size_t done = 0;
+    for (size_t i = 0; i < mPending.size();) {
+        PendingLoad& pl = mPending[i];
+        if (pl.result.wait_for(std::chrono::seconds(0)) != std::future_status::ready) { ++i; continue; }
+
+        LoadResult r = pl.result.get();
+        const uint32_t slot = pl.slot, gen = pl.gen;
+        const bool reload = pl.reload;
+        LoadCallback onReload = std::move(pl.onReload);
+        mPending.erase(mPending.begin() + i);
+        if (mEntries[slot].gen != gen || !mEntries[slot].used) continue;
+        if (reload) CompleteReload(slot, r, onReload);
+        else Complete(slot, r);
+        ++done;
+    }
+    return done;
+}
+
+void AssetManager::WaitAll()
+{
+    // ٸ   嵵 ڵ带 ´ (Ŀ  ̾ )
+    while (!mPending.empty()) {
+        Jobs::Wait(mLoads);
+        Update();
+    }
+}
+
+TextureHandle AssetManager::Acquire(uint32_t slot)
+{
+    Entry& e = mEntries[slot];
+    if (e.info.refCount++ == 0) ++mStats.live;
+    e.info.lastUse = ++mClock;
+    return TextureHandle(this, slot, e.gen);
+}
+
+void AssetManager::AddRef(uint32_t slot, uint32_t gen)
+{
+    if (slot >= mEntries.size() || mEntries[slot].gen != gen || !mEntries[slot].used) return;
+    Entry& e = mEntries[slot];
+    if (e.info.refCount++ == 0) ++mStats.live;
+}
+
+void AssetManager::Release(uint32_t slot, uint32_t gen)
+{
+    // Shutdown/Evict   ڵ 
+    if (slot >= mEntries.size() || mEntries[slot].gen != gen || !mEntries[slot].used) return;
+    Entry& e = mEntries[slot];
+    if (e.info.refCount > 0 && --e.info.refCount == 0) --mStats.live;
+}
+
+void AssetManager::Free(uint32_t slot)
+{
+    Entry& e = mEntries[slot];
+    if (e.info.refCount > 0) --mStats.live;
+    mStats.gpuBytes -= e.info.gpuBytes;
+    --mStats.entries;
+    mByKey.erase(e.info.key);
+    e.srv.Reset();
+    e.info = TextureInfo{};
+    e.callbacks.clear();
+    e.blockHashes.clear();
+    e.path.clear();
+    e.pathKey.clear();
+    e.reloading = e.reloadAgain = false;
+    e.used = false;
+    ++e.gen;
+    mFreeSlots.push_back(slot);
+}
+
+const AssetManager::Entry* AssetManager::Find(const TextureHandle& h) const
+{
+    if (h.mOwner != this || h.mSlot >= mEntries.size()) return nullptr;
+    const Entry& e = mEntries[h.mSlot];
+    return (e.gen == h.mGen && e.used) ? &e : nullptr;
+}
+
+ID3D11ShaderResourceView* AssetManager::SRV(const TextureHandle& h) const
+{
+    const Entry* e = Find(h);
+    if (!e) return nullptr;
+    if (e->srv) return e->srv.Get();
+    const bool height = (e->kind == TextureKind::R8 || e->kind == TextureKind::BC4);
+    return height ? mPlaceholderHeight.Get() : mPlaceholderColor.Get();
+}
+
+const TextureInfo* AssetManager::Info(const TextureHandle& h) const
+{
+    const Entry* e = Find(h);
+    return e ? &e->info : nullptr;
+}
+
+size_t AssetManager::EvictUnused(size_t budgetBytes)
+{
+    // ε  ׸ 
+    std::vector<uint32_t> idle;
+    for (uint32_t i = 0; i < (uint32_t)mEntries.size(); ++i) {
+        const Entry& e = mEntries[i];
+        if (e.used && e.info.refCount == 0 && e.info.state != AssetState::Pending) idle.push_back(i);
+    }
+    std::sort(idle.begin(), idle.end(), [&](uint32_t a, uint32_t b) {
+        return mEntries[a].info.lastUse < mEntries[b].info.lastUse;
+    });
+
+    size_t evicted = 0;
+    for (uint32_t slot : idle) {
+        if (budgetBytes && mStats.gpuBytes <= budgetBytes) break;
+        Free(slot);
+        ++evicted;
+    }
+    mStats.evictions += evicted;
+    return evicted;
+}
+
+void AssetManager::Shutdown()
+{
+    Jobs::Wait(mLoads);
+    mPending.clear();
+    for (uint32_t i = 0; i < (uint32_t)mEntries.size(); ++i)
+        if (mEntries[i].used) Free(i);
+    mPlaceholderColor.Reset();
+    mPlaceholderHeight.Reset();
+    mDev = nullptr;
+    mCtx = nullptr;
+}
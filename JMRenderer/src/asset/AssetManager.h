@@ -0,0 +1,208 @@
+#pragma once
+#include <d3d11.h>
+#include <wrl/client.h>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../utils/BMTexture.h"
+#include "../utils/JobSystem.h"
+
+// ؽó ĳ: (ȭ  + ε ɼ) Ű ߺ ε带 
+//  īƮ ڵ ش.  0  ׸ EvictUnused  ĳÿ ´
+// 񵿱 ε:  б/ڵ//BC ڵ ۾ ٷ(Jobs) Ŀ, ؽó  Update()
+//  ε: Reload(path)   ׸ Ŀ ٽ ڵϰ, ũ/ 
+// 64px  ؽð ٲ  UpdateSubresource (ٸ ؽó ü).    ؽó ׸
+// AssetManager ü (̽)  
+
+enum class TextureKind {
+    RGBA8,  // 24/32-bit BMP ״
+    R8,     // ׷ (̸)
+    BC1, BC4, BC5,
+};
+
+struct TextureLoadOptions {
+    TextureKind kind = TextureKind::RGBA8;
+    MipFilter   mips = MipFilter::SRGB;
+    BC::Quality quality = BC::Quality::Normal;
+    bool        keepCpuCopy = false;    // R8 : ڵ ȼ 
+};
+
+enum class AssetState { Pending, Ready, Failed };
+
+struct TextureInfo {
+    std::string key;                // ȭ  + ɼ
+    std::string name;               // ǥÿ (ϸ)
+    AssetState state = AssetState::Pending;
+    unsigned width = 0, height = 0;
+    size_t   gpuBytes = 0;          //   ؽó ޸
+    double   loadMs = 0.0;          // ڵ + ڵ + ε
+    double   psnr = 0.0;            // BC ˸
+    uint32_t refCount = 0;
+    uint64_t lastUse = 0;           //  ȹ  (Evict )
+    std::vector<uint8_t> cpuPixels; // keepCpuCopy
+
+    // ŸӶ (Init  ms): û  Ŀ   CPU ۾   ؽó 
+    double queuedMs = 0.0, beginMs = 0.0, decodedMs = 0.0, readyMs = 0.0;
+
+    //  ε (  )
+    uint32_t reloads = 0;
+    size_t   reloadUploadBytes = 0;     //  ø Ʈ (ü ü gpuBytes)
+    double   reloadMs = 0.0;            // ڵ + ε
+    unsigned reloadRow0 = 0, reloadRow1 = 0;    // ٲ  0  [row0, row1) (ü ü 0~height)
+};
+
+class AssetManager;
+
+// ϸ  +1, Ҹϸ -1
+class TextureHandle {
+public:
+    TextureHandle() = default;
+    TextureHandle(const TextureHandle& o);
+    TextureHandle(TextureHandle&& o) noexcept;
+    TextureHandle& operator=(const TextureHandle& o);
+    TextureHandle& operator=(TextureHandle&& o) noexcept;
+    ~TextureHandle();
+
+    explicit operator bool() const { return mOwner != nullptr; }
+    void Reset();
+
+private:
+    friend class AssetManager;
+    TextureHandle(AssetManager* owner, uint32_t slot, uint32_t gen);
+
+    AssetManager* mOwner = nullptr;
+    uint32_t mSlot = 0, mGen = 0;
+};
+
+class AssetManager {
+public:
+    struct Stats {
+        size_t entries = 0;     // ĳõ ׸
+        size_t live = 0;        //   ׸
+        size_t gpuBytes = 0;
+        size_t loads = 0;       //  ε Ƚ
+        size_t hits = 0;        // ĳ  Ƚ
+        size_t evictions = 0;
+        size_t reloads = 0;
+        size_t reloadUploadBytes = 0;   //  ε ø Ʈ
+        size_t reloadFullBytes = 0;     //  ε带 ° ÷ȴٸ
+    };
+
+    // Ϸ ݹ (Update ȿ,  )
+    using LoadCallback = std::function<void(bool ok, const TextureInfo& info)>;
+
+    // ÷̽Ȧ , ŸӶ  ð. ctx  ε ׻ ؽó ü
+    void Init(ID3D11Device* dev, ID3D11DeviceContext* ctx = nullptr);
+    void Shutdown();                //   ε带 ٸ  ڵ  ־  
+
+    //  ε. ϸ  ڵ
+    TextureHandle LoadTexture(const std::filesystem::path& path, const TextureLoadOptions& opt = {});
+    // 񵿱 ε. ڵ  ȯǰ Ϸ  SRV() ÷̽Ȧ
+    //  Ű ̹   ׸ Ѵ (Ϸ ¸ ݹ  ȣ)
+    // Init (̽ )̸  ڵ, ݹ 
+    TextureHandle LoadTextureAsync(const std::filesystem::path& path, const TextureLoadOptions& opt = {},
+        LoadCallback onDone = {});
+    // ޸ ̹  ( ؽó). name Ű 
+    TextureHandle AddTexture(const std::string& name, const BMP::Image& img, const TextureLoadOptions& opt = {});
+
+    // path  ׸  ٽ д´ (ɼǺ ). ȯ: ε带  ׸ 
+    // onDone ׸񸶴 Update ȿ ȣ. ε  ׸      д´ (ù ε ̸ ǳʶ)
+    size_t Reload(const std::filesystem::path& path, LoadCallback onDone = {});
+
+    //  񵿱 ε带 ؽó  ݹ ȣ.   ȣ, ȯ Ϸ 
+    size_t Update();
+    void WaitAll();
+    size_t PendingCount() const { return mPending.size(); }
+
+    // Pending/Failed ׸ ÷̽Ȧ(ȸ RGBA,  0 R8)
+    ID3D11ShaderResourceView* SRV(const TextureHandle& h) const;
+    const TextureInfo* Info(const TextureHandle& h) const;
+
+    // ŸӶ Ŀ (ù  )
+    double NowMs() const;
+    void Mark(const char* name) { mMarkers.push_back({ name, NowMs() }); }
+    const std::vector<std::pair<std::string, double>>& Markers() const { return mMarkers; }
+
+    //  0 ׸    gpuBytes <= budget ǰ Ѵ (0 = )
+    size_t EvictUnused(size_t budgetBytes = 0);
+
+    const Stats& GetStats() const { return mStats; }
+    template<class F> void ForEach(F&& fn) const {
+        for (const Entry& e : mEntries) if (e.used) fn(e.info);
+    }
+
+    static std::string MakeKey(const std::filesystem::path& path, const TextureLoadOptions& opt);
+
+private:
+    friend class TextureHandle;
+
+    struct Entry {
+        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srv;
+        TextureInfo info;
+        TextureKind kind = TextureKind::RGBA8;
+        uint32_t gen = 0;
+        bool used = false;
+        bool reloading = false;
+        bool reloadAgain = false;       // ε ߿   ٲ
+        std::vector<LoadCallback> callbacks;
+
+        // ε:   (AddTexture ׸  ),  64px  ؽ
+        std::filesystem::path path;
+        std::string pathKey;
+        TextureLoadOptions opt;
+        std::vector<std::vector<uint64_t>> blockHashes;
+    };
+
+    // Ŀ  CPU   (D3D ȣ )
+    struct LoadResult {
+        bool ok = false;
+        BMP::TextureData data;
+        std::vector<uint8_t> cpuPixels;
+        unsigned width = 0, height = 0;     //  ũ
+        double beginMs = 0.0, decodedMs = 0.0;
+        std::vector<std::vector<uint64_t>> blockHashes;
+    };
+
+    void StartReload(uint32_t slot, LoadCallback onDone);
+
+    struct PendingLoad {
+        uint32_t slot = 0, gen = 0;
+        std::future<LoadResult> result;
+        bool reload = false;
+        LoadCallback onReload;
+    };
+
+    static void PrepareImage(const BMP::Image& img, const TextureLoadOptions& opt, LoadResult& r);
+    static void PrepareFile(const std::filesystem::path& path, const TextureLoadOptions& opt, LoadResult& r);
+    static void HashBlocks(const BMP::TextureData& d, std::vector<std::vector<uint64_t>>& out);
+    std::future<LoadResult> StartLoad(const std::filesystem::path& path, const TextureLoadOptions& opt);
+
+    const Entry* Find(const TextureHandle& h) const;
+    TextureHandle Acquire(uint32_t slot);
+    uint32_t NewEntry(const std::string& key, const std::string& name, TextureKind kind);
+    static void SetSource(Entry& e, const std::filesystem::path& path, const TextureLoadOptions& opt);
+    void Complete(uint32_t slot, LoadResult& r);
+    void CompleteReload(uint32_t slot, LoadResult& r, const LoadCallback& onDone);
+    size_t UploadChangedBlocks(Entry& e, const LoadResult& r, unsigned& row0, unsigned& row1);
+    void AddRef(uint32_t slot, uint32_t gen);
+    void Release(uint32_t slot, uint32_t gen);
+    void Free(uint32_t slot);
+
+    ID3D11Device* mDev = nullptr;
+    ID3D11DeviceContext* mCtx = nullptr;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> mPlaceholderColor, mPlaceholderHeight;
+    std::chrono::steady_clock::time_point mEpoch;
+    std::vector<PendingLoad> mPending;
+    Jobs::Counter mLoads;                   // Ŀ ڵ  ε
+    std::vector<std::pair<std::string, double>> mMarkers;
+    std::vector<Entry> mEntries;
+    std::vector<uint32_t> mFreeSlots;
+    std::unordered_map<std::string, uint32_t> mByKey;
+    uint64_t mClock = 0;
+    Stats mStats;
+};
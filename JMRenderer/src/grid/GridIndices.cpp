@@ -0,0 +1,190 @@
+#include "GridIndices.h"
+#include "../utils/JobSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+
+namespace {
+
+    template<class I>
+    void WriteStrips(int qx, int qz, int vn, int stripW, I* dst, size_t item0, size_t item1)
+    {
+        for (size_t item = item0; item < item1; ++item) {
+            const int s = (int)(item / qz), z = (int)(item % qz);
+            const int x0 = s * stripW, sw = std::min(stripW, qx - x0);
+            I* o = dst + ((size_t)x0 * qz + (size_t)z * sw) * 6;
+            for (int x = x0; x < x0 + sw; ++x) {
+                const I i0 = (I)(z * vn + x), i1 = (I)(i0 + 1);
+                const I i2 = (I)(i0 + vn), i3 = (I)(i2 + 1);
+                o[0] = i0; o[1] = i2; o[2] = i1;
+                o[3] = i1; o[4] = i2; o[5] = i3;
+                o += 6;
+            }
+        }
+    }
+
+    //  Init  ( vector + ε push_back), ġũ 񱳿
+    size_t BuildLegacy(int vx, int vz, float sizeX, float sizeZ)
+    {
+        std::vector<VertexPNT> verts(vx * vz);
+        std::vector<uint32_t>  inds;
+        inds.reserve((vx - 1) * (vz - 1) * 6);
+        Grid::WriteVertices(GridVertexFormat::Float32, vx, vz, sizeX, sizeZ, verts.data(), 0, vz);
+        for (int z = 0; z < vz - 1; ++z)
+            for (int x = 0; x < vx - 1; ++x)
+                Grid::AppendQuad(x, z, vx, inds);
+        return verts.capacity() * sizeof(VertexPNT) + inds.capacity() * sizeof(uint32_t);
+    }
+
+    // Ʈ  ε  켱 带       (Ʋ  )
+    template<class I>
+    size_t CountStripMismatches(const I* inds, int n)
+    {
+        const int q = n - 1;
+        std::vector<uint8_t> seen((size_t)q * q, 0);
+        size_t bad = 0;
+        for (size_t p = 0; p < (size_t)q * q * 6; p += 6) {
+            const uint32_t i0 = inds[p];
+            const int x = (int)(i0 % n), z = (int)(i0 / n);
+            const uint32_t i1 = i0 + 1, i2 = i0 + n, i3 = i2 + 1;
+            const bool ok = x < q && z < q && !seen[(size_t)z * q + x] &&
+                inds[p + 1] == i2 && inds[p + 2] == i1 && inds[p + 3] == i1 && inds[p + 4] == i2 && inds[p + 5] == i3;
+            if (!ok) { ++bad; continue; }
+            seen[(size_t)z * q + x] = 1;
+        }
+        return bad;
+    }
+
+} // namespace
+
+namespace Grid {
+
+    unsigned VertexStride(GridVertexFormat format)
+    {
+        switch (format) {
+        case GridVertexFormat::Quant16:  return (unsigned)sizeof(VertexQuant16);
+        case GridVertexFormat::VertexId: return 0;
+        default:                         return (unsigned)sizeof(VertexPNT);
+        }
+    }
+
+    const char* FormatName(GridVertexFormat format)
+    {
+        switch (format) {
+        case GridVertexFormat::Quant16:  return "Quant16";
+        case GridVertexFormat::VertexId: return "VertexId";
+        default:                         return "Float32";
+        }
+    }
+
+    void AppendQuad(int x, int z, int vn, std::vector<uint32_t>& out)
+    {
+        const uint32_t i0 = z * vn + x;
+        const uint32_t i1 = z * vn + (x + 1);
+        const uint32_t i2 = (z + 1) * vn + x;
+        const uint32_t i3 = (z + 1) * vn + (x + 1);
+        out.push_back(i0); out.push_back(i2); out.push_back(i1);
+        out.push_back(i1); out.push_back(i2); out.push_back(i3);
+    }
+
+    void AppendStrips(const QuadRect& r, int stripW, int vn, std::vector<uint32_t>& out)
+    {
+        for (int sx = r.x0; sx < r.x0 + r.w; sx += stripW)
+            for (int z = r.z0; z < r.z0 + r.h; ++z)
+                for (int x = sx; x < std::min(r.x0 + r.w, sx + stripW); ++x)
+                    AppendQuad(x, z, vn, out);
+    }
+
+    void BuildPatchIndices(int res, std::vector<uint32_t>& out)
+    {
+        const int vn = res + 1;
+        const int h = res / 2;
+        out.clear();
+        out.reserve(res * res * 6);
+
+        // и : (-X-Z), (+X-Z), (-X+Z), (+X+Z) - TerrainDraw::quadMask Ʈ 
+        for (int q = 0; q < 4; ++q) {
+            const int x0 = (q & 1) * h, z0 = (q >> 1) * h;
+            for (int z = z0; z < z0 + h; ++z)
+                for (int x = x0; x < x0 + h; ++x)
+                    AppendQuad(x, z, vn, out);
+        }
+    }
+
+    int AnalyticStripWidth(int cacheSize) { return std::max(1, cacheSize / 2 - 1); }
+
+    size_t StripItemCount(int qx, int qz, int stripW)
+    {
+        return (size_t)((qx + stripW - 1) / stripW) * qz;
+    }
+
+    void WriteStripIndices(int qx, int qz, int vn, int stripW, uint16_t* dst, size_t item0, size_t item1)
+    {
+        WriteStrips(qx, qz, vn, stripW, dst, item0, item1);
+    }
+
+    void WriteStripIndices(int qx, int qz, int vn, int stripW, uint32_t* dst, size_t item0, size_t item1)
+    {
+        WriteStrips(qx, qz, vn, stripW, dst, item0, item1);
+    }
+
+    void WriteVertices(GridVertexFormat fmt, int vx, int vz, float sizeX, float sizeZ, void* dst, size_t z0, size_t z1)
+    {
+        if (fmt == GridVertexFormat::VertexId) return;
+        const float halfX = sizeX * 0.5f, halfZ = sizeZ * 0.5f;
+        for (size_t z = z0; z < z1; ++z) {
+            if (fmt == GridVertexFormat::Quant16) {
+                VertexQuant16* o = static_cast<VertexQuant16*>(dst) + z * vx;
+                for (int x = 0; x < vx; ++x) o[x] = { (uint16_t)x, (uint16_t)z };
+                continue;
+            }
+            VertexPNT* o = static_cast<VertexPNT*>(dst) + z * vx;
+            const float v = (float)z / (vz - 1);
+            for (int x = 0; x < vx; ++x) {
+                const float u = (float)x / (vx - 1);
+                o[x] = { { -halfX + u * sizeX, 0.0f, -halfZ + v * sizeZ }, { 0,1,0 }, { u, v } };
+            }
+        }
+    }
+
+    BenchResult Benchmark(int n, GridVertexFormat format, bool legacy)
+    {
+        BenchResult r;
+        r.n = n;
+        if (n < 2) return r;
+
+        // ε ޸  ʱȭ    ۿ   (vector 0 ʱȭ/Ҵ )
+        const int q = n - 1;
+        const size_t vertices = (size_t)n * n, indices = (size_t)q * q * 6;
+        const size_t stride = VertexStride(format), istride = vertices <= 65536 ? 2 : 4;
+        const int stripW = AnalyticStripWidth(16);
+        const size_t items = StripItemCount(q, q, stripW);
+
+        auto t0 = std::chrono::steady_clock::now();
+        std::unique_ptr<uint8_t[]> vb(stride ? new uint8_t[vertices * stride] : nullptr);
+        std::unique_ptr<uint8_t[]> ib(new uint8_t[indices * istride]);
+        Jobs::Counter fills;
+        if (stride)
+            Jobs::For(0, (size_t)n, 16, [&](size_t a, size_t b) {
+                WriteVertices(format, n, n, 10.0f, 10.0f, vb.get(), a, b);
+            }, fills);
+        Jobs::For(0, items, 64, [&](size_t a, size_t b) {
+            if (istride == 2) WriteStripIndices(q, q, n, stripW, reinterpret_cast<uint16_t*>(ib.get()), a, b);
+            else WriteStripIndices(q, q, n, stripW, reinterpret_cast<uint32_t*>(ib.get()), a, b);
+        }, fills);
+        Jobs::Wait(fills);
+        r.buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        r.bytes = vertices * stride + indices * istride;
+        r.bytesPerVertex = (double)r.bytes / vertices;
+
+        if (legacy) {
+            auto t1 = std::chrono::steady_clock::now();
+            r.legacyBytes = BuildLegacy(n, n, 10.0f, 10.0f);
+            r.legacyMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t1).count();
+            r.mismatches = istride == 2 ? CountStripMismatches(reinterpret_cast<const uint16_t*>(ib.get()), n)
+                                        : CountStripMismatches(reinterpret_cast<const uint32_t*>(ib.get()), n);
+        }
+        return r;
+    }
+
+} // namespace Grid
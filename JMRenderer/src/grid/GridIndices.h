@@ -0,0 +1,69 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//  /ε CPU  (D3D  , 帮  )
+// GridMesh(D3D  ) CPU Ͷ  ġ Ѵ
+
+// : POSITION, NORMAL, TEXCOORD
+struct VertexPNT {
+    float pos[3];
+    float nrm[3];
+    float uv[2];
+};
+
+//   ǥ (R16G16_UINT). XZ/UV ̴ ǥ / ػ󵵷  (ս )
+struct VertexQuant16 {
+    uint16_t x, z;
+};
+
+enum class GridVertexFormat {
+    Float32,    // VertexPNT 32B
+    Quant16,    // VertexQuant16 4B (   65536 )
+    VertexId,   //   : SV_VertexID( 켱 ȣ)  ǥ 
+};
+
+namespace Grid {
+
+    //   簢 (ε  ϳ =  켱  w*h)
+    struct QuadRect { int x0, z0, w, h; };
+
+    unsigned VertexStride(GridVertexFormat format);     // VertexId 0
+    const char* FormatName(GridVertexFormat format);
+
+    //  ϳ = ﰢ   (i0 i2 i1 / i1 i2 i3), vn =    
+    void AppendQuad(int x, int z, int vn, std::vector<uint32_t>& out);
+    //  stripW  η ȴ  (stripW == w  켱)
+    void AppendStrips(const QuadRect& r, int stripW, int vn, std::vector<uint32_t>& out);
+
+    // Ʈ   ġ (res+1)^2   켱 ε (ȭ )
+    // и麰  ġ  и  ο 
+    void BuildPatchIndices(int res, std::vector<uint32_t>& out);
+
+    // ū ڿ Ʈ  (  ùķ̼ǿ FIFO 16  7, 32  13 α )
+    int AnalyticStripWidth(int cacheSize);
+
+    // qx x qz 带 stripW  Ʈ , ׸ [item0, item1) = (Ʈ, )  dst 
+    //  Ʈ    Ƿ  ġ ٷ    尡    ִ
+    size_t StripItemCount(int qx, int qz, int stripW);
+    void WriteStripIndices(int qx, int qz, int vn, int stripW, uint16_t* dst, size_t item0, size_t item1);
+    void WriteStripIndices(int qx, int qz, int vn, int stripW, uint32_t* dst, size_t item0, size_t item1);
+
+    //  [z0, z1)  ( 켱 ȣ,  XZ ߽  sizeX x sizeZ), VertexId   
+    void WriteVertices(GridVertexFormat fmt, int vx, int vz, float sizeX, float sizeZ, void* dst, size_t z0, size_t z1);
+
+    // ̽  CPU ޸𸮿 n x n  ڸ  
+    // legacy:  push_back (Float32, 32Ʈ ε) Բ 
+    struct BenchResult {
+        int    n = 0;
+        double buildMs = 0.0;
+        double legacyMs = 0.0;          //    0
+        size_t bytes = 0;               //  + ε
+        size_t legacyBytes = 0;
+        double bytesPerVertex = 0.0;    //  + ε /  
+        size_t mismatches = 0;          // legacy ﰢ  ٸ   (legacy )
+    };
+    BenchResult Benchmark(int n, GridVertexFormat format, bool legacy);
+
+} // namespace Grid
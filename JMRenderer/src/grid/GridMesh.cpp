@@ -1,70 +1,350 @@
 #include "GridMesh.h"
+#include "../utils/JobSystem.h"
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <map>
 
 #ifndef HR
 #define HR(x) do { HRESULT __hr=(x); assert(SUCCEEDED(__hr)); } while(0)
 #endif
 
-bool GridMesh::Init(ID3D11Device* d, int rows, int cols, float sizeX, float sizeZ)
+namespace {
+
+    //  Ʈ  ĺ + Forsyth  ùķ̼ ACMR    
+    // remapVerts ü ε   ó ̴  ġ (  )
+    MeshOpt::CacheReport OptimizeGrid(std::vector<uint32_t>& inds, size_t vertexCount,
+        int vn, const Grid::QuadRect* rects, int rectCount, int cacheSize,
+        bool remapVerts, std::vector<uint32_t>& remap)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        MeshOpt::CacheReport rep;
+        rep.cacheSize = cacheSize;
+        rep.model = MeshOpt::CacheModel::FIFO;
+        rep.before = MeshOpt::Simulate(inds.data(), inds.size(), vertexCount, cacheSize, rep.model);
+
+        std::vector<uint32_t> cand, best;
+        size_t offset = 0;
+        for (int i = 0; i < rectCount; ++i) {
+            const Grid::QuadRect& r = rects[i];
+            const size_t count = (size_t)r.w * r.h * 6;
+            best.assign(inds.begin() + offset, inds.begin() + offset + count);
+            size_t bestCost = MeshOpt::Simulate(best.data(), count, vertexCount, cacheSize).transforms;
+
+            auto consider = [&] {
+                const size_t cost = MeshOpt::Simulate(cand.data(), count, vertexCount, cacheSize).transforms;
+                if (cost < bestCost) { bestCost = cost; best.swap(cand); }
+            };
+            //   ĳ ũ  (   +   ĳÿ ƾ )
+            for (int sw = 1; sw <= std::min(r.w - 1, cacheSize); ++sw) {
+                cand.clear();
+                Grid::AppendStrips(r, sw, vn, cand);
+                consider();
+            }
+            cand.assign(inds.begin() + offset, inds.begin() + offset + count);
+            MeshOpt::OptimizeVertexCache(cand.data(), count, vertexCount, cacheSize * 2);
+            consider();
+
+            std::copy(best.begin(), best.end(), inds.begin() + offset);
+            offset += count;
+        }
+
+        // VertexId  ȣ   ǥ ȣ Ұ
+        if (remapVerts) {
+            MeshOpt::OptimizeVertexFetch(inds.data(), inds.size(), vertexCount, remap);
+        }
+        else {
+            remap.resize(vertexCount);
+            for (size_t v = 0; v < vertexCount; ++v) remap[v] = (uint32_t)v;
+        }
+
+        rep.after = MeshOpt::Simulate(inds.data(), inds.size(), vertexCount, cacheSize, rep.model);
+        rep.optimizeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        return rep;
+    }
+
+    bool CreateBuffer(ID3D11Device* d, UINT bind, const void* data, size_t bytes, ComPtr<ID3D11Buffer>& out)
+    {
+        D3D11_BUFFER_DESC bd{};
+        bd.ByteWidth = (UINT)bytes;
+        bd.Usage = D3D11_USAGE_DEFAULT;
+        bd.BindFlags = bind;
+        D3D11_SUBRESOURCE_DATA init{};
+        init.pSysMem = data;
+        HR(d->CreateBuffer(&bd, data ? &init : nullptr, out.ReleaseAndGetAddressOf()));
+        return out != nullptr;
+    }
+
+    //   ε : (̽, , ĳ ũ, ȣ ) ϳ 
+    struct SharedKey {
+        ID3D11Device* dev; int vx, vz, cacheSize; bool patch, remap;
+        bool operator<(const SharedKey& o) const {
+            if (dev != o.dev) return dev < o.dev;
+            if (vx != o.vx) return vx < o.vx;
+            if (vz != o.vz) return vz < o.vz;
+            if (cacheSize != o.cacheSize) return cacheSize < o.cacheSize;
+            if (patch != o.patch) return patch < o.patch;
+            return remap < o.remap;
+        }
+    };
+
+    struct SharedIndices {
+        ComPtr<ID3D11Buffer> ib;
+        UINT count = 0;
+        DXGI_FORMAT format = DXGI_FORMAT_R32_UINT;
+        std::vector<uint32_t> remap;        //  ڸ ( ȣ)
+        MeshOpt::CacheReport report;
+    };
+
+    std::map<SharedKey, SharedIndices>& SharedCache()
+    {
+        static std::map<SharedKey, SharedIndices> cache;
+        return cache;
+    }
+
+    //  켱 ε ȭ 16/32Ʈ ε ۷ (̹  )
+    const SharedIndices* AcquireIndices(ID3D11Device* d, const SharedKey& key, std::vector<uint32_t>& rowMajor,
+        const Grid::QuadRect* rects, int rectCount, bool& reused)
+    {
+        auto& cache = SharedCache();
+        auto it = cache.find(key);
+        reused = (it != cache.end());
+        if (reused) return &it->second;
+
+        const size_t vertexCount = (size_t)key.vx * key.vz;
+        SharedIndices s;
+        s.report = OptimizeGrid(rowMajor, vertexCount, key.vx, rects, rectCount, key.cacheSize, key.remap, s.remap);
+        s.count = (UINT)rowMajor.size();
+        if (vertexCount <= 65536) {
+            std::vector<uint16_t> i16(rowMajor.begin(), rowMajor.end());
+            s.format = DXGI_FORMAT_R16_UINT;
+            if (!CreateBuffer(d, D3D11_BIND_INDEX_BUFFER, i16.data(), i16.size() * 2, s.ib)) return nullptr;
+        }
+        else {
+            s.format = DXGI_FORMAT_R32_UINT;
+            if (!CreateBuffer(d, D3D11_BIND_INDEX_BUFFER, rowMajor.data(), rowMajor.size() * 4, s.ib)) return nullptr;
+        }
+        return &(cache[key] = std::move(s));
+    }
+
+} // namespace
+
+void GridMesh::ReleaseSharedIndexBuffers()
+{
+    SharedCache().clear();
+}
+
+bool GridMesh::Init(ID3D11Device* d, int rows, int cols, float sizeX, float sizeZ, int cacheSize,
+    GridVertexFormat format)
 {
     const int vx = cols;  // x   
     const int vz = rows;  // z   
     if (vx < 2 || vz < 2) return false;
+    if (format == GridVertexFormat::Quant16 && (vx > 65536 || vz > 65536)) return false;
 
-    std::vector<VertexPNT> verts(vx * vz);
-    std::vector<uint32_t>  inds;
-    inds.reserve((vx - 1) * (vz - 1) * 6);
+    auto t0 = std::chrono::steady_clock::now();
+    mFormat = format;
+    mPatchRes = 0;
+    mStats = {};
+    if ((size_t)vx * vz > 65536) {
+        if (!InitLarge(d, vx, vz, sizeX, sizeZ, cacheSize)) return false;
+    }
+    else {
+        std::vector<uint32_t> inds;
+        inds.reserve((vx - 1) * (vz - 1) * 6);
+        for (int z = 0; z < vz - 1; ++z)
+            for (int x = 0; x < vx - 1; ++x)
+                Grid::AppendQuad(x, z, vx, inds);   //  ﰢ
+
+        const Grid::QuadRect all{ 0, 0, vx - 1, vz - 1 };
+        const SharedKey key{ d, vx, vz, cacheSize, false, format != GridVertexFormat::VertexId };
+        const SharedIndices* s = AcquireIndices(d, key, inds, &all, 1, mStats.sharedIB);
+        if (!s) return false;
+        mIB = s->ib;
+        mIndexCount = s->count;
+        mIndexFormat = s->format;
+        mCacheReport = s->report;
+
+        mVertexStride = Grid::VertexStride(format);
+        mVB.Reset();
+        if (format == GridVertexFormat::Quant16) {
+            std::vector<VertexQuant16> verts(vx * vz);
+            Grid::WriteVertices(format, vx, vz, sizeX, sizeZ, verts.data(), 0, vz);
+            MeshOpt::RemapVertices(verts, s->remap);
+            if (!CreateBuffer(d, D3D11_BIND_VERTEX_BUFFER, verts.data(), verts.size() * sizeof(VertexQuant16), mVB)) return false;
+        }
+        else if (format == GridVertexFormat::Float32) {
+            std::vector<VertexPNT> verts(vx * vz);
+            Grid::WriteVertices(format, vx, vz, sizeX, sizeZ, verts.data(), 0, vz);
+            MeshOpt::RemapVertices(verts, s->remap);
+            if (!CreateBuffer(d, D3D11_BIND_VERTEX_BUFFER, verts.data(), verts.size() * sizeof(VertexPNT), mVB)) return false;
+        }
+    }
+
+    mStats.vertices = (UINT)(vx * vz);
+    mStats.indices = mIndexCount;
+    mStats.vertexStride = mVertexStride;
+    mStats.indexStride = (mIndexFormat == DXGI_FORMAT_R16_UINT) ? 2 : 4;
+    mStats.vertexBytes = (size_t)mStats.vertices * mStats.vertexStride;
+    mStats.indexBytes = (size_t)mStats.indices * mStats.indexStride;
+    mStats.buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    return true;
+}
+
+// ū : ȭ ùķ̼  Ʈ , ¡ ۸ Map  尡  
+// ε  ä⸦  īͿ Բ ־  For  Ŀ   
+bool GridMesh::InitLarge(ID3D11Device* d, int vx, int vz, float sizeX, float sizeZ, int cacheSize)
+{
+    const int qx = vx - 1, qz = vz - 1;
+    const size_t indexCount = (size_t)qx * qz * 6;
+    if (indexCount > 0xFFFFFFFFull) return false;
+
+    ComPtr<ID3D11DeviceContext> ctx;
+    d->GetImmediateContext(ctx.GetAddressOf());
+
+    struct Staging {
+        ComPtr<ID3D11Buffer> buf;
+        size_t bytes = 0;
+        void* data = nullptr;
+    };
+    auto map = [&](size_t bytes, Staging& s) {
+        D3D11_BUFFER_DESC sd{};
+        sd.ByteWidth = (UINT)bytes;
+        sd.Usage = D3D11_USAGE_STAGING;
+        sd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+        if (FAILED(d->CreateBuffer(&sd, nullptr, s.buf.GetAddressOf()))) return false;
+        D3D11_MAPPED_SUBRESOURCE m{};
+        if (FAILED(ctx->Map(s.buf.Get(), 0, D3D11_MAP_WRITE, 0, &m))) return false;
+        s.bytes = bytes;
+        s.data = m.pData;
+        return true;
+    };
+    auto unmap = [&](Staging& s) {
+        if (s.data) ctx->Unmap(s.buf.Get(), 0);
+        s.data = nullptr;
+    };
+    auto upload = [&](UINT bind, Staging& s, ComPtr<ID3D11Buffer>& out) {
+        if (!CreateBuffer(d, bind, nullptr, s.bytes, out)) return false;
+        ctx->CopyResource(out.Get(), s.buf.Get());
+        return true;
+    };
 
-    const float halfX = sizeX * 0.5f;
-    const float halfZ = sizeZ * 0.5f;
+    // ε ˰  (  켱 ״)  
+    const SharedKey key{ d, vx, vz, cacheSize, false, false };
+    auto& cache = SharedCache();
+    auto it = cache.find(key);
+    mStats.sharedIB = (it != cache.end());
+    mVertexStride = Grid::VertexStride(mFormat);
+    mVB.Reset();
 
-    for (int z = 0; z < vz; ++z) {
-        for (int x = 0; x < vx; ++x) {
-            float u = (float)x / (vx - 1);
-            float v = (float)z / (vz - 1);
-            float px = -halfX + u * sizeX;
-            float pz = -halfZ + v * sizeZ;
-            verts[z * vx + x] = { {px, 0.0f, pz}, {0,1,0}, {u, v} };
+    Staging is, vs;
+    bool ok = true;
+    Jobs::Counter fills;
+    const int stripW = Grid::AnalyticStripWidth(cacheSize);
+    if (!mStats.sharedIB) {
+        ok = map(indexCount * 4, is);
+        if (ok) {
+            const size_t items = Grid::StripItemCount(qx, qz, stripW);
+            uint32_t* dst = static_cast<uint32_t*>(is.data);
+            Jobs::For(0, items, 64, [=](size_t a, size_t b) {
+                Grid::WriteStripIndices(qx, qz, vx, stripW, dst, a, b);
+            }, fills);
         }
     }
+    if (ok && mVertexStride) {
+        ok = map((size_t)vx * vz * mVertexStride, vs);
+        if (ok) {
+            const GridVertexFormat fmt = mFormat;
+            void* dst = vs.data;
+            Jobs::For(0, (size_t)vz, 16, [=](size_t a, size_t b) {
+                Grid::WriteVertices(fmt, vx, vz, sizeX, sizeZ, dst, a, b);
+            }, fills);
+        }
+    }
+    Jobs::Wait(fills);
+    unmap(is);
+    unmap(vs);
+    if (!ok) return false;
+
+    if (!mStats.sharedIB) {
+        SharedIndices s;
+        s.count = (UINT)indexCount;
+        s.format = DXGI_FORMAT_R32_UINT;
+        s.report.cacheSize = cacheSize;
+        if (!upload(D3D11_BIND_INDEX_BUFFER, is, s.ib)) return false;
+        it = cache.emplace(key, std::move(s)).first;
+    }
+    mIB = it->second.ib;
+    mIndexCount = it->second.count;
+    mIndexFormat = it->second.format;
+    mCacheReport = it->second.report;
+
+    if (mVertexStride && !upload(D3D11_BIND_VERTEX_BUFFER, vs, mVB)) return false;
+    mStats.parallel = true;
+    return true;
+}
 
-    for (int z = 0; z < vz - 1; ++z) {
-        for (int x = 0; x < vx - 1; ++x) {
-            uint32_t i0 = z * vx + x;
-            uint32_t i1 = z * vx + (x + 1);
-            uint32_t i2 = (z + 1) * vx + x;
-            uint32_t i3 = (z + 1) * vx + (x + 1);
-            //  ﰢ
-            inds.push_back(i0); inds.push_back(i2); inds.push_back(i1);
-            inds.push_back(i1); inds.push_back(i2); inds.push_back(i3);
+bool GridMesh::InitPatch(ID3D11Device* d, int res, int cacheSize, GridVertexFormat format)
+{
+    if (res < 2 || (res & 1)) return false; // и /  ¦
+
+    auto t0 = std::chrono::steady_clock::now();
+    const int vn = res + 1;
+    mFormat = format;
+    mPatchRes = res;
+    mStats = {};
+
+    std::vector<uint32_t> inds;
+    Grid::BuildPatchIndices(res, inds);
+
+    // и  ȿ ġ  QuadrantIndexCount  ο 
+    const int h = res / 2;
+    const Grid::QuadRect quads[4] = { { 0, 0, h, h }, { h, 0, h, h }, { 0, h, h, h }, { h, h, h, h } };
+    const SharedKey key{ d, vn, vn, cacheSize, true, format != GridVertexFormat::VertexId };
+    const SharedIndices* s = AcquireIndices(d, key, inds, quads, 4, mStats.sharedIB);
+    if (!s) return false;
+    mIB = s->ib;
+    mIndexCount = s->count;
+    mIndexFormat = s->format;
+    mCacheReport = s->report;
+
+    mVertexStride = Grid::VertexStride(format);
+    mVB.Reset();
+    if (format == GridVertexFormat::Quant16) {
+        std::vector<VertexQuant16> verts(vn * vn);
+        Grid::WriteVertices(format, vn, vn, 1.0f, 1.0f, verts.data(), 0, vn);
+        MeshOpt::RemapVertices(verts, s->remap);
+        if (!CreateBuffer(d, D3D11_BIND_VERTEX_BUFFER, verts.data(), verts.size() * sizeof(VertexQuant16), mVB)) return false;
+    }
+    else if (format == GridVertexFormat::Float32) {
+        std::vector<VertexPNT> verts(vn * vn);
+        for (int z = 0; z < vn; ++z) {
+            for (int x = 0; x < vn; ++x) {
+                float u = (float)x / res;
+                float v = (float)z / res;
+                verts[z * vn + x] = { {u, 0.0f, v}, {0,1,0}, {u, v} };
+            }
         }
+        MeshOpt::RemapVertices(verts, s->remap);
+        if (!CreateBuffer(d, D3D11_BIND_VERTEX_BUFFER, verts.data(), verts.size() * sizeof(VertexPNT), mVB)) return false;
     }
-    mIndexCount = (UINT)inds.size();
-
-    // VB
-    D3D11_BUFFER_DESC vbd{};
-    vbd.ByteWidth = (UINT)(verts.size() * sizeof(VertexPNT));
-    vbd.Usage = D3D11_USAGE_DEFAULT;
-    vbd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-    D3D11_SUBRESOURCE_DATA vinit{ verts.data() };
-    HR(d->CreateBuffer(&vbd, &vinit, mVB.GetAddressOf()));
-
-    // IB
-    D3D11_BUFFER_DESC ibd{};
-    ibd.ByteWidth = (UINT)(inds.size() * sizeof(uint32_t));
-    ibd.Usage = D3D11_USAGE_DEFAULT;
-    ibd.BindFlags = D3D11_BIND_INDEX_BUFFER;
-    D3D11_SUBRESOURCE_DATA iinit{ inds.data() };
-    HR(d->CreateBuffer(&ibd, &iinit, mIB.GetAddressOf()));
 
+    mStats.vertices = (UINT)(vn * vn);
+    mStats.indices = mIndexCount;
+    mStats.vertexStride = mVertexStride;
+    mStats.indexStride = (mIndexFormat == DXGI_FORMAT_R16_UINT) ? 2 : 4;
+    mStats.vertexBytes = (size_t)mStats.vertices * mStats.vertexStride;
+    mStats.indexBytes = (size_t)mStats.indices * mStats.indexStride;
+    mStats.buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
     return true;
 }
 
 void GridMesh::Bind(ID3D11DeviceContext* c) const
 {
-    UINT stride = sizeof(VertexPNT), offset = 0;
+    // VertexId:    SV_VertexID 
+    UINT stride = mVertexStride, offset = 0;
     ID3D11Buffer* vb = mVB.Get();
     c->IASetVertexBuffers(0, 1, &vb, &stride, &offset);
-    c->IASetIndexBuffer(mIB.Get(), DXGI_FORMAT_R32_UINT, 0);
+    c->IASetIndexBuffer(mIB.Get(), mIndexFormat, 0);
     c->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 }
@@ -4,40 +4,85 @@
 #include <wrl/client.h>
 #include <vector>
 #include <cstdint>
+#include "GridIndices.h"
+#include "MeshOptimize.h"
 
 using Microsoft::WRL::ComPtr;
 using namespace DirectX;
 
-// : POSITION, NORMAL, TEXCOORD
-struct VertexPNT {
-    XMFLOAT3 pos;
-    XMFLOAT3 nrm;
-    XMFLOAT2 uv;
+struct GridBuildStats {
+    UINT   vertices = 0, indices = 0;
+    UINT   vertexStride = 0, indexStride = 0;   // Ʈ (VertexId  0B)
+    size_t vertexBytes = 0, indexBytes = 0;
+    double buildMs = 0.0;
+    bool   parallel = false;    // ε ޸   (ū )
+    bool   sharedIB = false;    //  ػ ε  
 };
 
 class GridMesh {
 public:
     // rows x cols  (⺻ 64x64),  XZ 鿡 sizeX x sizeZ ũ
+    // cacheSize: ε   ȯ  ĳ(FIFO) ũ
+    //  65536 ϴ ùķ̼ ȭ + 16Ʈ ε, ׺ ũ  
     bool Init(ID3D11Device* d, int rows = 64, int cols = 64,
-        float sizeX = 10.0f, float sizeZ = 10.0f);
+        float sizeX = 10.0f, float sizeZ = 10.0f, int cacheSize = 16,
+        GridVertexFormat format = GridVertexFormat::Float32);
+
+    // Ʈ   ġ: (res+1)^2 , uv = ġ  ǥ(0~1)
+    // ε и麰  ġ  и  DrawIndexed 
+    bool InitPatch(ID3D11Device* d, int res, int cacheSize = 16,
+        GridVertexFormat format = GridVertexFormat::Float32);
 
     void Bind(ID3D11DeviceContext* c) const;
     UINT IndexCount() const { return mIndexCount; }
+    UINT QuadrantIndexCount() const { return mIndexCount / 4; }
+    int  PatchRes() const { return mPatchRes; }
+    GridVertexFormat Format() const { return mFormat; }
+    ID3D11Buffer* VertexBuffer() const { return mVB.Get(); }   // VertexId nullptr
+    ID3D11Buffer* IndexBuffer() const { return mIB.Get(); }
+    UINT VertexStride() const { return mVertexStride; }
+    DXGI_FORMAT IndexFormat() const { return mIndexFormat; }
+    const MeshOpt::CacheReport& VertexCacheReport() const { return mCacheReport; }
+    const GridBuildStats& BuildStats() const { return mStats; }
 
-    // ̴ Է ̾ƿ(IA)    
-    static void BuildInputLayoutDesc(std::vector<D3D11_INPUT_ELEMENT_DESC>& out) {
-        out = {
-            { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0,
-              (UINT)offsetof(VertexPNT, pos), D3D11_INPUT_PER_VERTEX_DATA, 0 },
-            { "NORMAL",   0, DXGI_FORMAT_R32G32B32_FLOAT, 0,
-              (UINT)offsetof(VertexPNT, nrm), D3D11_INPUT_PER_VERTEX_DATA, 0 },
-            { "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT,    0,
-              (UINT)offsetof(VertexPNT, uv),  D3D11_INPUT_PER_VERTEX_DATA, 0 },
-        };
+    // ̴ Է ̾ƿ(IA)     (VertexId  ̾ƿ)
+    static void BuildInputLayoutDesc(std::vector<D3D11_INPUT_ELEMENT_DESC>& out,
+        GridVertexFormat format = GridVertexFormat::Float32) {
+        switch (format) {
+        case GridVertexFormat::Quant16:
+            out = {
+                { "TEXCOORD", 0, DXGI_FORMAT_R16G16_UINT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+            };
+            break;
+        case GridVertexFormat::VertexId:
+            out.clear();
+            break;
+        default:
+            out = {
+                { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0,
+                  (UINT)offsetof(VertexPNT, pos), D3D11_INPUT_PER_VERTEX_DATA, 0 },
+                { "NORMAL",   0, DXGI_FORMAT_R32G32B32_FLOAT, 0,
+                  (UINT)offsetof(VertexPNT, nrm), D3D11_INPUT_PER_VERTEX_DATA, 0 },
+                { "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT,    0,
+                  (UINT)offsetof(VertexPNT, uv),  D3D11_INPUT_PER_VERTEX_DATA, 0 },
+            };
+            break;
+        }
     }
 
+    //  ε  ĳ  (̽  )
+    static void ReleaseSharedIndexBuffers();
+
 private:
+    bool InitLarge(ID3D11Device* d, int vx, int vz, float sizeX, float sizeZ, int cacheSize);
+
     ComPtr<ID3D11Buffer> mVB;
     ComPtr<ID3D11Buffer> mIB;
     UINT mIndexCount = 0;
+    UINT mVertexStride = 0;
+    DXGI_FORMAT mIndexFormat = DXGI_FORMAT_R32_UINT;
+    int  mPatchRes = 0;
+    GridVertexFormat mFormat = GridVertexFormat::Float32;
+    MeshOpt::CacheReport mCacheReport;
+    GridBuildStats mStats;
 };
@@ -0,0 +1,157 @@
+#include "MeshOptimize.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+    // Forsyth, "Linear-Speed Vertex Cache Optimisation" ⺻ 
+    constexpr int   kMaxCache = 64;
+    constexpr float kCacheDecayPower = 1.5f;
+    constexpr float kLastTriScore = 0.75f;
+    constexpr float kValenceBoostScale = 2.0f;
+    constexpr float kValenceBoostPower = 0.5f;
+
+    float VertexScore(int cachePos, int cacheSize, uint32_t valence)
+    {
+        if (valence == 0) return -1.0f;     //   ﰢ 
+        float s = 0.0f;
+        if (cachePos >= 0) {
+            if (cachePos < 3) s = kLastTriScore; //  ׸ ﰢ   
+            else s = std::pow(1.0f - (float)(cachePos - 3) / (float)(cacheSize - 3), kCacheDecayPower);
+        }
+        return s + kValenceBoostScale * std::pow((float)valence, -kValenceBoostPower);
+    }
+
+} // namespace
+
+namespace MeshOpt {
+
+    CacheStats Simulate(const uint32_t* indices, size_t count, size_t vertexCount, int cacheSize, CacheModel model)
+    {
+        CacheStats s;
+        s.triangles = count / 3;
+        cacheSize = std::max(1, cacheSize);
+
+        std::vector<uint8_t> used(vertexCount, 0);
+        std::vector<uint32_t> cache;   // [0]  ֱ
+        cache.reserve(cacheSize + 1);
+        for (size_t i = 0; i < s.triangles * 3; ++i) {
+            const uint32_t v = indices[i];
+            if (v >= vertexCount) continue;
+            if (!used[v]) { used[v] = 1; ++s.vertices; }
+
+            auto it = std::find(cache.begin(), cache.end(), v);
+            if (it != cache.end()) {
+                // LRU    (FIFO   )
+                if (model == CacheModel::LRU) { cache.erase(it); cache.insert(cache.begin(), v); }
+                continue;
+            }
+            ++s.transforms;
+            cache.insert(cache.begin(), v);
+            if ((int)cache.size() > cacheSize) cache.pop_back();
+        }
+        s.acmr = s.triangles ? (double)s.transforms / s.triangles : 0.0;
+        s.atvr = s.vertices ? (double)s.transforms / s.vertices : 0.0;
+        return s;
+    }
+
+    void OptimizeVertexCache(uint32_t* indices, size_t count, size_t vertexCount, int cacheSize)
+    {
+        const size_t triCount = count / 3;
+        if (triCount < 2) return;
+        cacheSize = std::min(std::max(cacheSize, 4), kMaxCache);
+
+        //   ﰢ   ( valence   ׸ ﰢ)
+        std::vector<uint32_t> valence(vertexCount, 0);
+        for (size_t i = 0; i < triCount * 3; ++i) ++valence[indices[i]];
+        std::vector<uint32_t> offset(vertexCount + 1, 0);
+        for (size_t v = 0; v < vertexCount; ++v) offset[v + 1] = offset[v] + valence[v];
+        std::vector<uint32_t> adj(offset[vertexCount]);
+        {
+            std::vector<uint32_t> fill(offset.begin(), offset.end() - 1);
+            for (size_t t = 0; t < triCount; ++t)
+                for (int k = 0; k < 3; ++k) adj[fill[indices[t * 3 + k]]++] = (uint32_t)t;
+        }
+
+        std::vector<int>   cachePos(vertexCount, -1);
+        std::vector<float> vScore(vertexCount);
+        for (size_t v = 0; v < vertexCount; ++v) vScore[v] = VertexScore(-1, cacheSize, valence[v]);
+
+        std::vector<uint8_t> emitted(triCount, 0);
+
+        std::vector<uint32_t> out;
+        out.reserve(triCount * 3);
+        std::vector<uint32_t> cache, next;
+        cache.reserve(cacheSize + 3); next.reserve(cacheSize + 3);
+
+        size_t cursor = 0;          // ĺ    ̹ ﰢ ã ġ
+        int64_t best = 0;
+        for (size_t n = 0; n < triCount; ++n) {
+            if (best < 0) {
+                while (cursor < triCount && emitted[cursor]) ++cursor;
+                best = (int64_t)cursor;
+            }
+            const size_t t = (size_t)best;
+            emitted[t] = 1;
+
+            //  +  Ͽ  + ĳ 
+            next.clear();
+            for (int k = 0; k < 3; ++k) {
+                const uint32_t v = indices[t * 3 + k];
+                out.push_back(v);
+                next.push_back(v);
+                uint32_t* a = adj.data() + offset[v];
+                for (uint32_t j = 0; j < valence[v]; ++j)
+                    if (a[j] == t) { a[j] = a[valence[v] - 1]; --valence[v]; break; }
+            }
+            for (uint32_t v : cache)
+                if (v != next[0] && v != next[1] && v != next[2]) next.push_back(v);
+
+            // з  ĳ  
+            for (size_t i = cacheSize; i < next.size(); ++i) {
+                cachePos[next[i]] = -1;
+                vScore[next[i]] = VertexScore(-1, cacheSize, valence[next[i]]);
+            }
+            if ((int)next.size() > cacheSize) next.resize(cacheSize);
+            cache.swap(next);
+
+            for (int i = 0; i < (int)cache.size(); ++i) {
+                cachePos[cache[i]] = i;
+                vScore[cache[i]] = VertexScore(i, cacheSize, valence[cache[i]]);
+            }
+
+            //  ĺ ĳ   ﰢ  ְ 
+            best = -1;
+            float bestScore = -1.0f;
+            for (uint32_t v : cache) {
+                const uint32_t* a = adj.data() + offset[v];
+                for (uint32_t j = 0; j < valence[v]; ++j) {
+                    const uint32_t tt = a[j];
+                    const float s = vScore[indices[tt * 3]] + vScore[indices[tt * 3 + 1]] + vScore[indices[tt * 3 + 2]];
+                    if (s > bestScore) { bestScore = s; best = tt; }
+                }
+            }
+        }
+        std::copy(out.begin(), out.end(), indices);
+    }
+
+    void OptimizeVertexFetch(uint32_t* indices, size_t count, size_t vertexCount, std::vector<uint32_t>& remap)
+    {
+        const uint32_t kUnused = ~0u;
+        remap.assign(vertexCount, kUnused);
+        uint32_t next = 0;
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t& r = remap[indices[i]];
+            if (r == kUnused) r = next++;
+            indices[i] = r;
+        }
+        for (uint32_t& r : remap)
+            if (r == kUnused) r = next++;
+    }
+
+    const char* ModelName(CacheModel model)
+    {
+        return model == CacheModel::LRU ? "LRU" : "FIFO";
+    }
+
+} // namespace MeshOpt
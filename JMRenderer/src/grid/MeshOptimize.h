@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ﰢ Ʈ ε ȭ (D3D  , 帮  )
+// 1)  ĳ: Forsyth  ﰢ  ġ (   и  )
+// 2)  ġ: ó ̴   ȣ (ε ġ ״)
+namespace MeshOpt {
+
+    enum class CacheModel { FIFO, LRU };
+
+    // ACMR = ȯ   / ﰢ  (̻ 0.5), ATVR = ȯ   /    (̻ 1)
+    struct CacheStats {
+        size_t triangles = 0;
+        size_t vertices = 0;      //  ٸ  
+        size_t transforms = 0;    // ĳ ̽ (VS  )
+        double acmr = 0.0;
+        double atvr = 0.0;
+    };
+
+    struct CacheReport {
+        int cacheSize = 0;
+        CacheModel model = CacheModel::FIFO;
+        CacheStats before, after;
+        double optimizeMs = 0.0;
+    };
+
+    // ȯ  ĳ ùķ (cacheSize ׸, ο ̿ ĳø  )
+    CacheStats Simulate(const uint32_t* indices, size_t count, size_t vertexCount,
+        int cacheSize = 16, CacheModel model = CacheModel::FIFO);
+
+    // [indices, indices+count) ȿ ﰢ  ٲ۴ ( ȣ ״)
+    // cacheSize:   LRU ũ ( ϵ FIFO 1.5~2)
+    void OptimizeVertexCache(uint32_t* indices, size_t count, size_t vertexCount, int cacheSize = 32);
+
+    // ó ̴   ȣ ٽ ű. remap[old] = new (   ڷ)
+    void OptimizeVertexFetch(uint32_t* indices, size_t count, size_t vertexCount, std::vector<uint32_t>& remap);
+
+    template<class V>
+    void RemapVertices(std::vector<V>& verts, const std::vector<uint32_t>& remap)
+    {
+        std::vector<V> out(verts.size());
+        for (size_t i = 0; i < verts.size(); ++i) out[remap[i]] = verts[i];
+        verts.swap(out);
+    }
+
+    const char* ModelName(CacheModel model);
+
+} // namespace MeshOpt
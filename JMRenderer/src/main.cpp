@@ -9,8 +9,37 @@
 #include <vector>
 #include <cassert>
 #include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
 
+#include "asset/AssetManager.h"
 #include "grid/GridMesh.h"
+#include "terrain/TerrainQuadTree.h"
+#include "terrain/TerrainHeightField.h"
+#include "terrain/TerrainPicker.h"
+#include "terrain/TerrainHorizonCull.h"
+#include "terrain/TerrainClipmap.h"
+#include "terrain/TerrainClipmapGPU.h"
+#include "terrain/TerrainTilePager.h"
+#include "terrain/TerrainTileSource.h"
+#include "terrain/TerrainTileFile.h"
+#include "terrain/TerrainNoise.h"
+#include "terrain/TerrainNormalMap.h"
+#include "terrain/TerrainPass.h"
+#include "terrain/TerrainSoft.h"
+#include "render/D3D11Executor.h"
+#include "render/NullExecutor.h"
+#include "render/ShaderCache.h"
+#include "render/ShaderPermutation.h"
+#include "render/D3DShaderCompiler.h"
+#include "utils/FileWatcher.h"
+#include "utils/FrameArena.h"
+#include "utils/FrustumCull.h"
+#include "utils/JobSystem.h"
+#include "utils/PixelKernels.h"
+#include "utils/Profiler.h"
 #include "utils/camera/Camera.h"
 #include "utils/BMTexture.h"
 
@@ -64,8 +93,11 @@ static bool GWireframe = false;
 static ComPtr<ID3D11RasterizerState> GRS_Solid;
 static ComPtr<ID3D11RasterizerState> GRS_Wire;
 
+// 텍스처 캐시 (핸들보다 먼저 선언 → 나중에 소멸)
+static AssetManager GAssets;
+
 // 알베도 텍스처 3장
-static ComPtr<ID3D11ShaderResourceView> GTexGrass, GTexRock, GTexSnow;
+static TextureHandle                    GTexGrass, GTexRock, GTexSnow;
 static ComPtr<ID3D11SamplerState>       GAlbedoSamp;
 
 // 스플랫 임계값(필요시 ImGui에서 조정)
@@ -171,31 +203,61 @@ private:
 
 /*
  * Init
- * ** 장치/경로/입력 레이아웃 정의를 저장.
- * ** 즉시 CompileAll() 호출로 VS/PS 컴파일 + 생성.
+ * ** 장치/경로/입력 레이아웃 정의 + 변형 기능(ShaderPermutations)을 저장.
+ * ** 즉시 CompileAll() 호출로 기본 변형(baseKey) VS/PS 컴파일 + 생성.
  * 
  * CompileAll
- * ** D3DCompileFromFile(path, ..., "VSMain","vs_5_0")로 컴파일 → CreateVertexShader
- * ** 주의: VS 컴파일 결과 blob이 InputLayout 생성에도 필요.
+ * ** GShaderCache 경유 (전처리 텍스트 해시가 같으면 디스크 바이트코드, 아니면 D3DCompile) → CreateVertexShader
+ * ** 주의: VS 컴파일 결과 blob이 InputLayout 생성에도 필요. (빈 레이아웃이면 IL 없음)
  * ** PS도 동일하게 "PSMain","ps_5_0"
+ * ** 실패하면 오류를 LastError()로 남기고 (파일 감시 HUD에 빨간 글씨) 이전 변형을 그대로 쓴다. 성공하면 나머지 변형은 버리고 다시 Lazy로
+ * 
+ * Select (변형)
+ * ** 기능 값 → 비트마스크 키 → 변형 테이블 인덱스. 준비된 변형이면 그대로
+ * ** 없으면 작업 스케줄러(Jobs::Run)에서 컴파일을 걸고 기본 변형을 돌려준다 → 바이트코드는 Jobs::RunOnMain으로 넘겨
+ *    메인 루프의 PumpMain에서 D3D 객체 생성 → 다음 프레임부터 교체
+ * ** PrecompileAll: 모든 유효 키를 코어 수만큼 병렬 컴파일 (Ahead of time)
  * 
  * TryHotReload
- * ** std::filesystem::last_write_time으로 파일 변경 감지.
+ * ** std::filesystem::last_write_time으로 파일 변경 감지. (GWatcher를 못 띄웠을 때만 매 프레임 폴링)
  * ** 변하면 CompileAll() 다시 호출 → 런타임 재컴파일(핫리로드).
+ * ** 보통은 GWatcher가 알려 준 파일이 Dependencies()(VS/PS + #include)에 있으면 Recompile().
  * 
  * Bind
- * ** IASetInputLayout, VSSetShader, PSSetShader 바인딩만 담당.
+ * ** IASetInputLayout, VSSetShader, PSSetShader 바인딩만 담당 (기본 변형).
+ * ** 지형 패스는 커맨드 리스트를 쓰므로 Select(key)의 il/vs/ps 핸들만 넘긴다.
  */
 
 // ---------------- Shader ----------------
+// 바이트코드 디스크 캐시 (InitAll에서 Init, 그 전/실패 시에는 매번 컴파일)
+static D3DShaderCompiler GShaderCompiler;
+static ShaderCache       GShaderCache;
+static int               GShaderCacheMB = 64;
+
 class ShaderProgram {
 public:
+    // 컴파일된 변형 하나
+    struct Variant {
+        ComPtr<ID3D11InputLayout>  il;
+        ComPtr<ID3D11VertexShader> vs;
+        ComPtr<ID3D11PixelShader>  ps;
+        bool     ready = false, pending = false, failed = false;
+        double   ms = 0.0;                      // VS + PS (캐시 적중이면 전처리 + 조회)
+        uint32_t vsInstructions = 0, psInstructions = 0;
+        bool     cacheHit = false;
+    };
+
     void Init(ID3D11Device* dev,
         const std::wstring& vsPath,
         const std::wstring& psPath,
-        const D3D11_INPUT_ELEMENT_DESC* layout, UINT n) {
-        mDev = dev; mVSPath = vsPath; mPSPath = psPath;
+        const D3D11_INPUT_ELEMENT_DESC* layout, UINT n,
+        const char* vsEntry = "VSMain",
+        ShaderPermutations perms = {}, uint32_t baseKey = 0) {
+        mDev = dev; mVSPath = vsPath; mPSPath = psPath; mVSEntry = vsEntry;
         mLayout.assign(layout, layout + n);
+        mPerms = std::move(perms);
+        mBaseKey = mPerms.Valid(baseKey) ? baseKey : 0;
+        mVariants.assign(mPerms.KeySpace(), Variant{});
         CompileAll();
     }
     void TryHotReload() {
@@ -209,44 +271,140 @@ public:
         if (changed(mVSPath, mVSTime) || changed(mPSPath, mPSTime)) CompileAll();
     }
     void Bind(ID3D11DeviceContext* ctx) {
-        ctx->IASetInputLayout(mIL.Get());
-        ctx->VSSetShader(mVS.Get(), nullptr, 0);
-        ctx->PSSetShader(mPS.Get(), nullptr, 0);
+        ctx->IASetInputLayout(InputLayout());
+        ctx->VSSetShader(VS(), nullptr, 0);
+        ctx->PSSetShader(PS(), nullptr, 0);
+    }
+    ID3D11InputLayout*  InputLayout() const { return Base().il.Get(); }
+    ID3D11VertexShader* VS() const { return Base().vs.Get(); }
+    ID3D11PixelShader*  PS() const { return Base().ps.Get(); }
+    void Recompile() { CompileAll(); }
+    // 마지막 컴파일에서 읽은 파일 (VS/PS 경로 + 전처리에서 열린 #include)
+    const std::vector<std::filesystem::path>& Dependencies() const { return mDeps; }
+    // 마지막 컴파일 오류 (기본 변형이 다시 컴파일되면 지워짐). 파일 감시 HUD에 표시
+    const std::string& LastError() const { return mLastError; }
+
+    const ShaderPermutations& Permutations() const { return mPerms; }
+    const std::vector<Variant>& Variants() const { return mVariants; }
+    uint32_t BaseKey() const { return mBaseKey; }
+
+    // key 변형 (없거나 컴파일 중이면 기본 변형)
+    const Variant& Select(uint32_t key) {
+        if (key >= mVariants.size()) return Base();
+        Variant& v = mVariants[key];
+        if (v.ready) return v;
+        if (!v.pending && !v.failed) {
+            v.pending = true;
+            const ShaderProgramDesc d = Desc();
+            const ShaderPermutations perms = mPerms;
+            const uint32_t gen = mGeneration;
+            Jobs::Run([this, d, perms, key, gen] {
+                auto b = std::make_shared<ShaderVariantBytecode>();
+                CompileShaderVariant(GShaderCache, GShaderCompiler, d, perms, key, *b);
+                // D3D 객체는 메인 스레드에서. 그 사이 핫 리로드됐으면 (세대가 다르면) 버린다
+                Jobs::RunOnMain([this, b, gen] { if (gen == mGeneration) Finish(mVariants[b->key], *b); });
+            }, &mCompiles);
+        }
+        return Base();
+    }
+
+    // 진행 중인 변형 컴파일을 모두 끝내고 결과까지 반영 (메인 스레드)
+    void WaitPending() {
+        Jobs::Wait(mCompiles);
+        Jobs::PumpMain();
+    }
+
+    // 아직 없는 유효 변형 전부를 병렬로. 반환: 컴파일한 변형 수
+    int PrecompileAll() {
+        std::vector<uint32_t> keys;
+        for (uint32_t k : mPerms.AllKeys())
+            if (!mVariants[k].ready && !mVariants[k].pending) keys.push_back(k);
+        std::vector<ShaderVariantBytecode> out;
+        CompileShaderVariants(GShaderCache, GShaderCompiler, Desc(), mPerms, keys, out);
+        for (const ShaderVariantBytecode& b : out) Finish(mVariants[b.key], b);
+        return (int)keys.size();
     }
+
 private:
-    void CompileAll() {
-        UINT f = D3DCOMPILE_ENABLE_STRICTNESS;
+    const Variant& Base() const { return mVariants[mBaseKey]; }
+
+    ShaderProgramDesc Desc() const {
+        ShaderProgramDesc d;
+        d.vsPath = mVSPath; d.psPath = mPSPath; d.vsEntry = mVSEntry;
+        d.flags = D3DCOMPILE_ENABLE_STRICTNESS;
 #if defined(_DEBUG)
-        f |= D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
+        d.flags |= D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
 #endif
-        ComPtr<ID3DBlob> vsb, psb;
-        HR(D3DCompileFromFile(mVSPath.c_str(), nullptr, nullptr,
-            "VSMain", "vs_5_0", f, 0, vsb.GetAddressOf(), nullptr));
-        HR(mDev->CreateVertexShader(vsb->GetBufferPointer(), vsb->GetBufferSize(), nullptr, mVS.GetAddressOf()));
-        HR(mDev->CreateInputLayout(mLayout.data(), (UINT)mLayout.size(),
-            vsb->GetBufferPointer(), vsb->GetBufferSize(), mIL.GetAddressOf()));
+        return d;
+    }
 
-        HR(D3DCompileFromFile(mPSPath.c_str(), nullptr, nullptr,
-            "PSMain", "ps_5_0", f, 0, psb.GetAddressOf(), nullptr));
-        HR(mDev->CreatePixelShader(psb->GetBufferPointer(), psb->GetBufferSize(), nullptr, mPS.GetAddressOf()));
+    // 실패하면 컴파일 오류를 LastError(HUD)와 디버그 출력에 남긴다 (변형은 기본 변형으로 계속 그림)
+    bool Finish(Variant& v, const ShaderVariantBytecode& b) {
+        v.pending = false;
+        v.ms = b.ms;
+        v.cacheHit = b.CacheHit();
+        if (!b.ok) {
+            mLastError = mPerms.Describe(b.key) + ": " + b.vs.errors + b.ps.errors;
+            OutputDebugStringA((mLastError + "\n").c_str());
+            v.failed = true;
+            return false;
+        }
+        HR(mDev->CreateVertexShader(b.vs.bytecode.data(), b.vs.bytecode.size(), nullptr, v.vs.ReleaseAndGetAddressOf()));
+        v.il.Reset();
+        if (!mLayout.empty()) {
+            HR(mDev->CreateInputLayout(mLayout.data(), (UINT)mLayout.size(),
+                b.vs.bytecode.data(), b.vs.bytecode.size(), v.il.GetAddressOf()));
+        }
+        HR(mDev->CreatePixelShader(b.ps.bytecode.data(), b.ps.bytecode.size(), nullptr, v.ps.ReleaseAndGetAddressOf()));
+        v.vsInstructions = b.vsInstructions;
+        v.psInstructions = b.psInstructions;
+        v.ready = true;
+        return true;
+    }
+
+    // 기본 변형은 동기 컴파일 (실패하면 이전 셰이더 유지, 처음 컴파일이면 assert)
+    void CompileAll() {
+        ShaderVariantBytecode b;
+        CompileShaderVariant(GShaderCache, GShaderCompiler, Desc(), mPerms, mBaseKey, b);
+        Variant base;
+        if (!Finish(base, b)) {
+            if (!Base().ready) HR(E_FAIL);
+            return;
+        }
+        mLastError.clear();
+
+        // 소스가 바뀌었으니 다른 변형은 다시 Lazy로 (진행 중인 것은 세대가 달라 버려짐)
+        ++mGeneration;
+        for (Variant& v : mVariants) v = Variant{};
+        mVariants[mBaseKey] = std::move(base);
+
+        mDeps = { mVSPath, mPSPath };
+        mDeps.insert(mDeps.end(), b.vs.includes.begin(), b.vs.includes.end());
+        mDeps.insert(mDeps.end(), b.ps.includes.begin(), b.ps.includes.end());
     }
     ID3D11Device* mDev{};
     std::wstring mVSPath, mPSPath;
+    std::string  mVSEntry = "VSMain";
     std::filesystem::file_time_type mVSTime{}, mPSTime{};
     std::vector<D3D11_INPUT_ELEMENT_DESC> mLayout;
-    ComPtr<ID3D11InputLayout> mIL;
-    ComPtr<ID3D11VertexShader> mVS;
-    ComPtr<ID3D11PixelShader>  mPS;
+    std::vector<std::filesystem::path> mDeps;
+    std::string mLastError;
+    ShaderPermutations mPerms;
+    uint32_t mBaseKey = 0;
+    uint32_t mGeneration = 0;
+    std::vector<Variant> mVariants;             // 키로 인덱싱 (KeySpace칸)
+    Jobs::Counter mCompiles;                   // 진행 중인 변형 컴파일
 };
 
 // ── Heightmap 리소스 ───────────────────────────────────────────
-static ComPtr<ID3D11ShaderResourceView> GHeightSRV;
+static TextureHandle                    GHeightTex;
 static ComPtr<ID3D11SamplerState>       GHeightSamp;
 
 // ── Terrain 상수버퍼(b1) ──────────────────────────────────────
 struct TerrainCBCPU {
     float HeightScale; 
-    float padA[3];     // 16바이트 정렬
+    float UseBakedNormals;  // 1이면 VS가 t1(노멀+높이) 한 번만 샘플
+    float padA[2];     // 16바이트 정렬
     DirectX::XMFLOAT2 GridSize;           // (worldX, worldZ)
     DirectX::XMFLOAT2 TexelSize;          // (1/texW, 1/texH)
 };
@@ -262,10 +420,104 @@ struct MatCBCPU
     float _pad2[3]; 
 };
 static ComPtr<ID3D11Buffer> GMatCB;
-static UINT GhmW = 0, GhmH = 0;
+static UINT GhmW = 1, GhmH = 1;   // 로드 전에는 1x1 플레이스홀더
+
+// ── Node 상수버퍼(b3): 쿼드트리 노드 드로우마다 갱신 (TerrainNodeCB) ─────────
+static ComPtr<ID3D11Buffer> GNodeCB;
+
+// ── 렌더 커맨드 리스트 (기록 → 정렬 → D3D11 또는 Null 실행기) ─────────
+static Render::CommandList GCmdList;
+static D3D11Executor       GD3DExec;
+static NullExecutor        GNullExec;
+static bool                GNullBackend = false;   // GPU 제출 없이 헤드리스 실행 (통계만)
+
+// ── CPU 소프트웨어 래스터 (헤드리스 렌더/골든 이미지) ─────────
+static TerrainSoftRenderer            GSoftRenderer;
+static Soft::Target                   GSoftTarget;
+static Soft::FrameStats               GSoftStats;
+static bool                           GSoftReady = false;     // 현재 높이맵으로 Init됨
+static bool                           GSoftWritten = false;
+static TerrainSoftRenderer::BenchResult GSoftBench[3];
+static const Soft::Path               GSoftBenchPaths[3] = { Soft::Path::Scalar, Soft::Path::SSE41, Soft::Path::AVX2 };
+
+// ── 쿼드트리 지형 ───────────────────────────────────────────
+static TerrainQuadTree          GTerrain;
+static std::vector<TerrainDraw> GTerrainDraws;
+static std::vector<uint8_t>     GHeightPixels;  // CPU 높이 사본 (노드 min/max용)
+static float GLodPixelError = 2.0f;
+
+// ── CPU 높이장 (지면 질의, 걷기 모드) ─────────────────────────
+static TerrainHeightField              GHeightField;
+static bool                            GWalkMode = false;
+static TerrainHeightField::BenchResult GHeightBench[3];
+static const TerrainHeightField::Path  GHeightBenchPaths[3] = {
+    TerrainHeightField::Path::Scalar, TerrainHeightField::Path::SSE41, TerrainHeightField::Path::AVX2 };
+
+// ── 지형 피킹 (min/max 피라미드, 커서 아래) ─────────────────────
+static TerrainPicker              GPicker;
+static TerrainRayHit              GPickHit;
+static TerrainPicker::BenchResult GPickBench;
+
+// ── 베이크된 노멀+높이 맵 (VS t1) ─────────────────────────────
+static TerrainNormalMap         GNormalMap;
+static bool                     GUseBakedNormals = true;
+static int                      GNormalFilter = (int)NormalBakeFilter::Sobel;
+static TerrainBake::BenchResult GNormalBench;
+
+// ── 절차적 높이맵 (hm.bmp가 없거나 HUD에서 재생성) ──────────────
+static NoiseParams                 GNoise;
+static int                         GNoiseSizeIdx = 2;  // 256 << idx
+static double                      GNoiseGenMs = 0.0;
+static TerrainNoise::BenchResult   GNoiseBench[3];
+static const TerrainNoise::Path    GNoiseBenchPaths[3] = {
+    TerrainNoise::Path::Scalar, TerrainNoise::Path::SSE41, TerrainNoise::Path::AVX2 };
+
+// ── 절두체 컬링 (노드 AABB, SoA) ──────────────────────────────
+static bool                  GFrustumCull = true;
+static AABBSoA               GTerrainBoxes;
+static std::vector<uint32_t> GTerrainVisible;
+static double                GCullMs = 0.0;
+static Cull::BenchResult     GCullBench[3][3];   // [경로][10k/100k/1M]
+static const CullPath        GCullBenchPaths[3] = { CullPath::Scalar, CullPath::SSE, CullPath::AVX };
+
+// ── 지평선 가림 컬링 (절두체 다음, 능선 뒤 노드 제거) ──────────
+static bool                                 GHorizonCull = true;
+static TerrainHorizonCull                   GHorizon;
+static TerrainHorizonCull::FlythroughResult GHorizonFly;
+
+// ── 지오메트리 클립맵 (디스크 타일 → LRU 페이저 → 토러스 레벨 텍스처) ─────────
+static bool                             GClipmapMode = false;
+static bool                             GClipFailed = false;
+static int                              GClipBudgetMB = 16;
+static bool                             GClipTileFile = true;   // 소스: 타일 파일 (.jmt, 밉 + 노멀) / 원시 R8
+static TerrainRawTileSource             GClipSource;
+static TerrainTileFile                  GClipTiles;
+static const TerrainTileSource*         GClipSrc = nullptr;
+static TerrainTileBuildStats            GClipBuild;
+static TerrainTileReadBench             GClipReadBench;
+static TerrainTilePager                 GTilePager;
+static TerrainClipmap                   GClipmap;
+static TerrainClipmapGPU                GClipmapGPU;
+static ShaderProgram                    GClipShader;
+static ComPtr<ID3D11Buffer>             GClipCB;       // b3: TerrainClipmapCB
+static TerrainClipmap::FlythroughResult GClipFly;
+
+// ── 텍스처 변환 커널 벤치 (4096x4096) ─────────────────────────
+static PixelKernels::BenchResult GPixelBench[3];
+static const PixelKernels::Path  GPixelBenchPaths[3] = {
+    PixelKernels::Path::Scalar, PixelKernels::Path::SSSE3, PixelKernels::Path::AVX2 };
+
+// ── 밉체인 검증 (4096x4096, 기준 박스 필터 대비) ──────────────
+static Mip::CheckResult GMipCheck[2];   // RGBA8 sRGB, R8 Linear
+
+// ── 블록 압축 인코더 벤치마크 (포맷 x 품질) ──────────────────
+static BC::BenchResult GBCBench[3][3];
+static const BC::Format  GBCFormats[3] = { BC::Format::BC1, BC::Format::BC4, BC::Format::BC5 };
+static const BC::Quality GBCQualities[3] = { BC::Quality::Fast, BC::Quality::Normal, BC::Quality::High };
 
 // ── UI/그리드 파라미터 (그리드 생성에 쓰는 값과 일치) ─────────
-static int   GGridRows = 64, GGridCols = 64;
+static int   GPatchRes = 16;
+static int   GPatchFormat = (int)GridVertexFormat::Quant16;   // 패치 정점 포맷 (셰이더 진입점과 짝)
 static float GGridSizeX = 10.0f, GGridSizeZ = 10.0f;
 static float GHeightScale = 1.5f;   // ImGui에서 조절할 값
 static DirectX::XMFLOAT3 GFogColor = { 0.6f, 0.7f, 0.8f };
@@ -273,38 +525,241 @@ static float             GFogDensity = 0.06f;
 
 // ---------------- Globals ----------------
 static DeviceResources GDev;
-static ShaderProgram   GShader;
-static GridMesh        GGrid;
+static ShaderProgram   GShader[3];    // GridVertexFormat 순서: VSMain / VSMainQuant16 / VSMainVertexId
+
+// ── 핫 리로드: assets 아래 변경은 감시 스레드가 디바운스해 큐로, RenderFrame이 비운다 ──
+static FileWatcher      GWatcher;
+static FileDependencies GShaderDeps;    // 파일 → GShaderPrograms 인덱스
+static ShaderProgram* const GShaderPrograms[] = { &GShader[0], &GShader[1], &GShader[2], &GClipShader };
+static int              GShaderReloads = 0, GTextureReloads = 0;
+static const char* const GShaderProgramNames[] = { "terrain VSMain", "terrain Quant16", "terrain VertexId", "clipmap" };
+
+// ── 지형 셰이더 변형 (선언 순서 = 키 비트 순서). 클립맵 VS는 베이크 노멀을 안 써서 앞의 둘만 ──
+enum TerrainFeature { kTerrainFog, kTerrainSplat, kTerrainBakedNormals };
+static int    GSplatCount = 3;      // 알베도 레이어 (1 = 풀, 2 = +바위, 3 = +눈). 와이어프레임은 0
+static int    GVariantsPrecompiled = 0;
+static double GVariantPrecompileMs = 0.0;
+
+static ShaderPermutations TerrainPermutations(bool bakedNormals) {
+    std::vector<ShaderFeature> f = { { "FOG", 1 }, { "SPLAT_COUNT", 3 } };
+    if (bakedNormals) f.push_back({ "BAKED_NORMALS", 1 });
+    return ShaderPermutations(std::move(f));
+}
+
+// 이번 프레임 설정 → 변형 키 (안개 0이면 FOG=0, 와이어프레임이면 텍스처 없음)
+static uint32_t TerrainVariantKey(const ShaderPermutations& p, bool fog, int splat, bool baked) {
+    uint32_t key = p.Set(0, kTerrainFog, fog ? 1u : 0u);
+    key = p.Set(key, kTerrainSplat, (uint32_t)splat);
+    if (p.FeatureCount() > kTerrainBakedNormals) key = p.Set(key, kTerrainBakedNormals, baked ? 1u : 0u);
+    return key;
+}
+static GridMesh        GPatch;
+static Grid::BenchResult GGridBench[3][3];  // 포맷 x 크기(256/1024/4096)
 static CameraFPS GCam;
 static float           GClear[4] = { 0.1f,0.1f,0.1f,1 };
 static bool            GVsync = true;
 
 // ---------------- Init/Loop ----------------
+// 쿼드트리: 노드별 높이 범위는 CPU 높이 사본에서 계산 (사본이 없으면 보수적 범위)
+static void BuildTerrainTree() {
+    TerrainQuadTreeDesc qd{};
+    qd.originX = -GGridSizeX * 0.5f; qd.originZ = -GGridSizeZ * 0.5f;
+    qd.sizeX = GGridSizeX; qd.sizeZ = GGridSizeZ;
+    qd.patchRes = GPatchRes;
+    qd.lodCount = TerrainQuadTree::SuggestLodCount((int)GhmW, (int)GhmH, GPatchRes);
+    GTerrain.Build(qd, GHeightPixels.empty() ? nullptr : GHeightPixels.data(), (int)GhmW, (int)GhmH);
+}
+
+// 높이맵이 준비되면 크기/CPU 사본을 갱신하고 쿼드트리를 다시 만든다
+static NormalBakeParams CurrentNormalBakeParams() {
+    NormalBakeParams p;
+    p.gridSizeX = GGridSizeX; p.gridSizeZ = GGridSizeZ;
+    p.heightScale = GHeightScale;
+    p.filter = (NormalBakeFilter)GNormalFilter;
+    return p;
+}
+
+// 클립맵 원본: 현재 높이맵을 원시 파일로 내려 두고 메모리 맵으로 타일 단위로 읽는다
+// (GPU에는 카메라 주변 레벨 창만 올라간다. 더 큰 원본은 같은 TerrainTileSource로 바꿔 끼운다)
+static void StopClipmap() {
+    GClipmap.Clear();
+    GTilePager.Stop();
+    GClipSource.Close();
+    GClipTiles.Close();
+    GClipSrc = nullptr;
+}
+
+static bool StartClipmap() {
+    StopClipmap();
+    if (GHeightPixels.empty()) return false;
+    std::error_code ec;
+    const std::filesystem::path dir = std::filesystem::temp_directory_path(ec);
+    const std::filesystem::path path = dir / L"jm_heightmap.r8";
+    if (ec || !TerrainRawTileSource::Write(path, GHeightPixels.data(), (int)GhmW, (int)GhmH)) return false;
+    if (GClipTileFile) {
+        // 원시 파일 → 타일 파일 (아웃오브코어 빌더를 그대로 사용)
+        TerrainTileBuildDesc bd;
+        bd.heightScale = GHeightScale;
+        bd.texelWorldX = GGridSizeX / (float)GhmW;
+        bd.texelWorldZ = GGridSizeZ / (float)GhmH;
+        const std::filesystem::path tiles = dir / L"jm_heightmap.jmt";
+        if (!TerrainTileFile::BuildFromRaw(tiles, path, (int)GhmW, (int)GhmH, bd, &GClipBuild) || !GClipTiles.Open(tiles)) return false;
+        GClipSrc = &GClipTiles;
+    } else {
+        if (!GClipSource.Open(path, (int)GhmW, (int)GhmH)) return false;
+        GClipSrc = &GClipSource;
+    }
+
+    ClipmapDesc cd;
+    cd.gridSizeX = GGridSizeX; cd.gridSizeZ = GGridSizeZ;
+    if (!GTilePager.Start(GClipSrc, (size_t)GClipBudgetMB << 20) || !GClipmap.Init(cd, *GClipSrc, GTilePager) ||
+        !GClipmapGPU.Init(GDev.Dev(), GClipmap.Size(), GClipmap.Levels())) {
+        StopClipmap();
+        return false;
+    }
+    return true;
+}
+
+static void OnHeightmapReady(const TextureInfo& info) {
+    GhmW = info.width; GhmH = info.height;
+    GHeightPixels = info.cpuPixels;
+    BuildTerrainTree();
+    if (GHeightPixels.empty()) GHeightField.Clear();
+    else GHeightField.Init(GHeightPixels.data(), (int)GhmW, (int)GhmH, GGridSizeX, GGridSizeZ, GHeightScale);
+    if (GHeightField.Empty()) GPicker.Clear();
+    else GPicker.Build(GHeightField);
+    GSoftReady = false;
+    if (!GHeightPixels.empty())
+        GNormalMap.Init(GDev.Dev(), GHeightPixels.data(), (int)GhmW, (int)GhmH, CurrentNormalBakeParams());
+    if (GClipmapMode) GClipFailed = !StartClipmap();
+}
+
+// 핫 리로드: 크기가 같으면 바뀐 행만 CPU 사본/쿼드트리/높이장/피커/노멀 맵에 반영 (노멀은 매 프레임 Update가 올린다)
+static void OnHeightmapReloaded(const TextureInfo& info) {
+    const bool partial = info.width == GhmW && info.height == GhmH && !GHeightPixels.empty() &&
+        info.cpuPixels.size() == GHeightPixels.size() && !GPicker.Empty() && GNormalMap.Ready();
+    if (!partial) { OnHeightmapReady(info); return; }
+
+    const int y0 = (int)info.reloadRow0, y1 = (int)info.reloadRow1;
+    if (y1 <= y0) return;
+    const size_t row = GhmW;
+    std::memcpy(GHeightPixels.data() + y0 * row, info.cpuPixels.data() + y0 * row, (y1 - y0) * row);
+    GTerrain.UpdateRows(GHeightPixels.data(), (int)GhmW, (int)GhmH, y0, y1);
+    GHeightField.SetRows(GHeightPixels.data(), y0, y1);
+    GPicker.UpdateRows(y0, y1);
+    GNormalMap.MarkDirty(GHeightPixels.data(), y0, y1);
+    GSoftReady = false;
+    if (GClipmapMode) GClipFailed = !StartClipmap();
+}
+
+// 높이맵: CPU 사본 유지 (노드 min/max용)
+static TextureLoadOptions HeightmapOptions() {
+    TextureLoadOptions opt;
+    opt.kind = TextureKind::R8;
+    opt.mips = MipFilter::Linear;
+    opt.keepCpuCopy = true;
+    return opt;
+}
+
+// 절차적 높이맵 (GNoise, 타일 병렬 + SIMD). 이름에 파라미터를 넣어 같은 설정은 캐시 적중
+static TextureHandle MakeProceduralHeightmap(const TextureLoadOptions& opt) {
+    const int texW = 256 << GNoiseSizeIdx, texH = texW;
+    char name[128];
+    snprintf(name, sizeof(name), "noise:%s %d s%u o%d c%d g%.2f w%.2f", TerrainNoise::TypeName(GNoise.type),
+        texW, GNoise.seed, GNoise.octaves, GNoise.baseCells, GNoise.gain, GNoise.warp);
+
+    const double t0 = GAssets.NowMs();
+    std::vector<uint8_t> hm = TerrainNoise::GenerateR8(GNoise, texW, texH);
+    GNoiseGenMs = GAssets.NowMs() - t0;
+
+    BMP::Image img;
+    img.width = texW; img.height = texH;
+    img.format = BMP::PixelFormat::R8;
+    img.rowPitch = texW * sizeof(uint8_t);
+    img.data = hm.data();
+    return GAssets.AddTexture(name, img, opt);
+}
+
+static void RegenerateHeightmap() {
+    GHeightTex = MakeProceduralHeightmap(HeightmapOptions());
+    if (const TextureInfo* hi = GAssets.Info(GHeightTex)) OnHeightmapReady(*hi);
+}
+
+static void RegisterShaderDeps() {
+    for (uint32_t i = 0; i < (uint32_t)std::size(GShaderPrograms); ++i)
+        GShaderDeps.Set(i, GShaderPrograms[i]->Dependencies());
+}
+
+// 감시 스레드가 올린 변경: 의존하는 셰이더는 한 번씩만 재컴파일, 텍스처는 GAssets가 워커에서 다시 읽는다
+static void PumpFileChanges() {
+    std::filesystem::path path;
+    std::vector<uint32_t> owners;
+    while (GWatcher.Poll(path)) {
+        GShaderDeps.Owners(FileWatcher::PathKey(path), owners);
+        GTextureReloads += (int)GAssets.Reload(path, [](bool ok, const TextureInfo& info) {
+            const TextureInfo* hi = GAssets.Info(GHeightTex);
+            if (ok && hi && hi->key == info.key) OnHeightmapReloaded(info);
+        });
+    }
+    std::sort(owners.begin(), owners.end());
+    owners.erase(std::unique(owners.begin(), owners.end()), owners.end());
+    for (uint32_t o : owners) {
+        GShaderPrograms[o]->Recompile();
+        GShaderDeps.Set(o, GShaderPrograms[o]->Dependencies());   // #include가 늘거나 줄었을 수 있다
+        ++GShaderReloads;
+    }
+}
+
+// 프레임 아레나 슬롯: 2 = 더블 버퍼, 3 = 트리플 (FrameMem::FrameArena::kMaxFrames까지)
+static const int GFrameSlots = 2;
+
 static void InitAll() {
+    JM_PROFILE_ZONE("InitAll");
+    Jobs::Init();   // 이 스레드가 0번 워커 (Wait 중에만 일을 돕는다)
+    FrameMem::Default().Init(GFrameSlots);
     GDev.Initialize(GWnd, GWidth, GHeight);
+    {
+        std::error_code ec;
+        const std::filesystem::path tmp = std::filesystem::temp_directory_path(ec);
+        GShaderCache.Init(ec ? std::filesystem::path() : tmp / L"jm_shader_cache", (size_t)GShaderCacheMB << 20, &GShaderCompiler);
+    }
 
     /*
      * BuildInputLayoutDesc 생성
-     * GridMesh로 전달
+     * GridMesh로 전달 (정점 포맷마다 레이아웃 + VS 진입점)
      */
-    std::vector<D3D11_INPUT_ELEMENT_DESC> layout;
-    GridMesh::BuildInputLayoutDesc(layout);
+    static const char* vsEntries[3] = { "VSMain", "VSMainQuant16", "VSMainVertexId" };
+    for (int f = 0; f < 3; ++f) {
+        std::vector<D3D11_INPUT_ELEMENT_DESC> layout;
+        GridMesh::BuildInputLayoutDesc(layout, (GridVertexFormat)f);
+
+        /*
+        * tODO: 파일 Path를 한 파이렝 모으도록 개선
+        */
+        GShader[f].Init(
+            GDev.Dev(),
+            L"assets/shaders/grid/terrain_vs.hlsl",   // ← 테레인용 VS
+            L"assets/shaders/grid/terrain_ps.hlsl",   // ← 테레인용 PS
+            layout.data(),
+            (UINT)layout.size(),
+            vsEntries[f],
+            TerrainPermutations(true),
+            TerrainVariantKey(TerrainPermutations(true), true, 3, true)   // 기본 변형 = 전부 켠 원래 셰이더
+        );
+    }
 
-    /*
-    * tODO: 파일 Path를 한 파이렝 모으도록 개선
-    */
-    GShader.Init(
-        GDev.Dev(),
-        L"assets/shaders/grid/terrain_vs.hlsl",   // ← 테레인용 VS
-        L"assets/shaders/grid/terrain_ps.hlsl",   // ← 테레인용 PS
-        layout.data(),
-        (UINT)layout.size()
-    );
+    // 클립맵 링: 정점 버퍼 없음 (SV_VertexID), PS는 지형과 공유
+    GClipShader.Init(GDev.Dev(), L"assets/shaders/grid/terrain_clipmap_vs.hlsl", L"assets/shaders/grid/terrain_ps.hlsl", nullptr, 0,
+        "VSMain", TerrainPermutations(false), TerrainVariantKey(TerrainPermutations(false), true, 3, false));
+    RegisterShaderDeps();
+    // 실패하면 (assets 폴더 없음 등) RenderFrame이 예전처럼 셰이더 파일 시각을 폴링
+    GWatcher.Start({ L"assets" });
 
     // 카메라 세팅
     GCam.SetPosition({ 0.f, 2.f, -5.f });
     GCam.SetMoveSpeed(8.f);
     GCam.SetTurnSpeed(2.0f);
+    GCam.SetEyeHeight(0.25f);   // 10m 지형 기준
 
     D3D11_BUFFER_DESC cbd{};
     UINT sz = (UINT)sizeof(SceneCB);
@@ -322,37 +777,8 @@ static void InitAll() {
 
     //////////////////////////////////////
     ////////// Heightmap ////////////////
-    // ── (A) CPU에서 256×256 높이맵 생성 (sin/cos 패턴) ─────────────
-    const UINT texW = 256, texH = 256;
-    std::vector<uint8_t> hm(texW * texH);
-    for (UINT y = 0; y < texH; ++y) {
-        for (UINT x = 0; x < texW; ++x) {
-            float u = (float)x / (texW - 1);
-            float v = (float)y / (texH - 1);
-            float h = 0.5f + 0.5f * (sinf(u * 8.0f) * cosf(v * 6.0f)); // 0~1
-            hm[y * texW + x] = (uint8_t)std::round(h * 255.0f);
-        }
-    }
-
-    // ── (B) Texture2D + SRV ───────────────────────────────────────
-    D3D11_TEXTURE2D_DESC td{};
-    td.Width = texW; td.Height = texH; td.MipLevels = 1; td.ArraySize = 1;
-    td.Format = DXGI_FORMAT_R8_UNORM;
-    td.SampleDesc.Count = 1;
-    td.BindFlags = D3D11_BIND_SHADER_RESOURCE;
-    D3D11_SUBRESOURCE_DATA srd{};
-    srd.pSysMem = hm.data();
-    srd.SysMemPitch = texW * sizeof(uint8_t);
-
-    ComPtr<ID3D11Texture2D> tex;
-    HR(GDev.Dev()->CreateTexture2D(&td, &srd, tex.GetAddressOf()));
-
-    D3D11_SHADER_RESOURCE_VIEW_DESC srvd{};
-    srvd.Format = td.Format;
-    srvd.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-    srvd.Texture2D.MostDetailedMip = 0;
-    srvd.Texture2D.MipLevels = 1;
-    HR(GDev.Dev()->CreateShaderResourceView(tex.Get(), &srvd, GHeightSRV.GetAddressOf()));
+    // 텍스처는 GAssets가 관리 (높이맵은 아래 hm.bmp 로드, 실패 시 절차적)
+    GAssets.Init(GDev.Dev(), GDev.Ctx());
 
     // ── (C) SamplerState ──────────────────────────────────────────
     D3D11_SAMPLER_DESC sd{};
@@ -369,8 +795,16 @@ static void InitAll() {
     cbd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
     HR(GDev.Dev()->CreateBuffer(&cbd, nullptr, GTerrainCB.GetAddressOf())); 
 
-    // 그리드 생성
-    GGrid.Init(GDev.Dev(), GGridRows, GGridCols, GGridSizeX, GGridSizeZ);
+    // ── (E) Node CB(b3) 생성 ──────────────────────────────────────
+    cbd.ByteWidth = ((UINT)sizeof(TerrainNodeCB) + 15u) & ~15u;
+    HR(GDev.Dev()->CreateBuffer(&cbd, nullptr, GNodeCB.GetAddressOf()));
+
+    // ── (F) Clipmap CB(b3) 생성 ───────────────────────────────────
+    cbd.ByteWidth = ((UINT)sizeof(TerrainClipmapCB) + 15u) & ~15u;
+    HR(GDev.Dev()->CreateBuffer(&cbd, nullptr, GClipCB.GetAddressOf()));
+
+    // 지형 패치 생성 (모든 쿼드트리 노드가 공유)
+    GPatch.InitPatch(GDev.Dev(), GPatchRes, 16, (GridVertexFormat)GPatchFormat);
 
     // 와이어프레임
     D3D11_RASTERIZER_DESC rs{}; 
@@ -392,11 +826,23 @@ static void InitAll() {
     HR(GDev.Dev()->CreateBuffer(&bd, nullptr, GMatCB.GetAddressOf()));
 
     
-    BMP::LoadR8(GDev.Dev(), L"assets\\heightmaps\\hm.bmp", GHeightSRV, &GhmW, &GhmH);
-    
-    BMP::LoadRGBA8(GDev.Dev(), L"assets\\textures\\grass.bmp", GTexGrass);
-    BMP::LoadRGBA8(GDev.Dev(), L"assets\\textures\\rock.bmp", GTexRock);
-    BMP::LoadRGBA8(GDev.Dev(), L"assets\\textures\\snow.bmp", GTexSnow);
+    // 텍스처는 워커에서 디코드/인코딩, 완료되면 RenderFrame의 GAssets.Update()에서 생성
+    // 그 전까지는 플레이스홀더(평지 + 회색)로 그린다
+    // 높이맵: 파일이 없으면 절차적 높이맵
+    GHeightTex = GAssets.LoadTextureAsync(L"assets\\heightmaps\\hm.bmp", HeightmapOptions(),
+        [](bool ok, const TextureInfo& info) {
+            if (ok) { OnHeightmapReady(info); return; }
+            RegenerateHeightmap();
+        });
+    BuildTerrainTree();
+
+    // 알베도: BC1 (RGBA8 대비 1/8 메모리), 감마 보정 밉
+    TextureLoadOptions albedoOpt;
+    albedoOpt.kind = TextureKind::BC1;
+    albedoOpt.mips = MipFilter::SRGB;
+    GTexGrass = GAssets.LoadTextureAsync(L"assets\\textures\\grass.bmp", albedoOpt);
+    GTexRock = GAssets.LoadTextureAsync(L"assets\\textures\\rock.bmp", albedoOpt);
+    GTexSnow = GAssets.LoadTextureAsync(L"assets\\textures\\snow.bmp", albedoOpt);
 
     D3D11_SAMPLER_DESC asd{};
     asd.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
@@ -405,17 +851,601 @@ static void InitAll() {
     asd.AddressW = D3D11_TEXTURE_ADDRESS_WRAP;
     asd.MaxLOD = D3D11_FLOAT32_MAX;
     HR(GDev.Dev()->CreateSamplerState(&asd, GAlbedoSamp.GetAddressOf()));
+
+    GAssets.Mark("InitAll");
 }
 static void ShutdownAll() {
+    GWatcher.Stop();
+    for (ShaderProgram* sp : GShaderPrograms) sp->WaitPending();
+    StopClipmap();
+    GAssets.Shutdown();
+    Jobs::Shutdown();
+    GridMesh::ReleaseSharedIndexBuffers();
     ImGui_ImplDX11_Shutdown();
     ImGui_ImplWin32_Shutdown();
     ImGui::DestroyContext();
 }
+// 작업 스케줄러: 워커별 실행/훔친 작업 수, 워커 수별 확장성 벤치마크, 스트레스 검사
+static std::vector<Jobs::ScalingResult> GJobBench;
+static Jobs::StressResult GJobStress;
+static bool GJobStressRan = false;
+
+static void DrawJobs() {
+    if (!ImGui::CollapsingHeader("Jobs")) return;
+    const Jobs::Stats st = Jobs::Default().GetStats();
+    uint64_t total = 0;
+    for (const Jobs::WorkerStats& w : st.workers) total += w.executed;
+    ImGui::Text("%u workers, %llu jobs (%llu injected, %llu run by other threads, %llu inlined on full deque)",
+        Jobs::Default().WorkerCount(), (unsigned long long)total, (unsigned long long)st.injected,
+        (unsigned long long)st.external, (unsigned long long)st.inlined);
+    for (size_t i = 0; i < st.workers.size(); ++i)
+        ImGui::Text("  %2zu%s: %8llu executed, %8llu stolen", i, i == 0 ? " (main)" : "",
+            (unsigned long long)st.workers[i].executed, (unsigned long long)st.workers[i].stolen);
+    if (ImGui::Button("Reset Job Stats")) Jobs::Default().ResetStats();
+
+    ImGui::SameLine();
+    if (ImGui::Button("Scaling Benchmark")) GJobBench = Jobs::BenchmarkScaling();
+    for (const Jobs::ScalingResult& r : GJobBench)
+        ImGui::Text("  %2u workers: For %7.2f ms (x%.2f) | tiny %6.0f ns/job | graph %6.2f ms",
+            r.workers, r.forMs, r.speedup, r.tinyNsPerJob, r.graphMs);
+
+    if (ImGui::Button("Stress Test")) { GJobStress = Jobs::StressTest(); GJobStressRan = true; }
+    if (GJobStressRan) {
+        ImGui::SameLine();
+        if (GJobStress.ok) ImGui::Text("OK: %llu jobs in %.0f ms", (unsigned long long)GJobStress.jobs, GJobStress.ms);
+        else ImGui::TextColored(ImVec4(1, 0.4f, 0.3f, 1), "FAILED: %s", GJobStress.firstError);
+    }
+}
+
+// 프레임 아레나: 프레임별 사용량(메인 + 워커 스레드), 최고치, 넘친 블록, std::allocator 대비 벤치마크
+static std::vector<FrameMem::BenchResult> GFrameMemBench;
+
+static void DrawFrameMemory() {
+    if (!ImGui::CollapsingHeader("Frame Memory")) return;
+    FrameMem::FrameArena& fa = FrameMem::Default();
+    const FrameMem::FrameStats& st = fa.LastFrame();
+    ImGui::Text("%d slots | last frame: main %.1f KB, %u worker threads %.1f KB, %u allocs",
+        fa.Frames(), st.mainBytes / 1024.0, st.threads, st.threadBytes / 1024.0, st.allocations);
+    ImGui::Text("high water %.1f KB, reserved %.1f KB, overflow blocks %u",
+        fa.HighWater() / 1024.0, st.capacity / 1024.0, st.overflowBlocks);
+
+    float hist[FrameMem::FrameArena::kHistory];
+    fa.History(hist);
+    float maxKB = 1.0f;
+    for (float v : hist) maxKB = std::max(maxKB, v);
+    ImGui::PlotLines("##framemem", hist, FrameMem::FrameArena::kHistory, 0, "KB / frame", 0.0f, maxKB * 1.1f,
+        ImVec2(ImGui::GetContentRegionAvail().x, 50.0f));
+
+    bool poison = fa.Poison();
+    if (ImGui::Checkbox("Poison Freed Memory (0xDD)", &poison)) fa.SetPoison(poison);
+
+    if (ImGui::Button("Arena Benchmark")) GFrameMemBench = FrameMem::Benchmark();
+    for (const FrameMem::BenchResult& r : GFrameMemBench)
+        ImGui::Text("  %-14s std %7.2f us | arena %7.2f us (x%.2f) | %.1f KB%s", r.name, r.stdUs, r.arenaUs,
+            r.stdUs / std::max(r.arenaUs, 1e-3), r.arenaBytes / 1024.0, r.checksum ? "" : "  MISMATCH");
+}
+
+// 시작 타임라인: 에셋별 [대기 | 디코드+인코딩 | 생성 대기] 막대와 마커
+static void DrawStartupTimeline() {
+    if (!ImGui::CollapsingHeader("Startup Timeline")) return;
+
+    double endMs = 1.0;
+    GAssets.ForEach([&](const TextureInfo& t) { endMs = std::max(endMs, t.readyMs); });
+    for (const auto& m : GAssets.Markers()) endMs = std::max(endMs, m.second);
+
+    const float labelW = 110.0f, rowH = ImGui::GetTextLineHeightWithSpacing();
+    const float barW = std::max(50.0f, ImGui::GetContentRegionAvail().x - labelW);
+    const float scale = barW / (float)endMs;
+    ImDrawList* dl = ImGui::GetWindowDrawList();
+    const float barsTop = ImGui::GetCursorScreenPos().y;
+
+    GAssets.ForEach([&](const TextureInfo& t) {
+        ImGui::TextUnformatted(t.name.c_str());
+        ImGui::SameLine(labelW);
+        const ImVec2 p = ImGui::GetCursorScreenPos();
+        const double ready = (t.state == AssetState::Pending) ? GAssets.NowMs() : t.readyMs;
+        auto bar = [&](double a, double b, ImU32 col) {
+            dl->AddRectFilled(ImVec2(p.x + (float)a * scale, p.y + 2.0f),
+                ImVec2(p.x + std::max((float)b * scale, (float)a * scale + 1.0f), p.y + rowH - 2.0f), col);
+        };
+        bar(t.queuedMs, t.beginMs, IM_COL32(90, 90, 90, 255));
+        bar(t.beginMs, t.decodedMs, IM_COL32(70, 140, 230, 255));
+        bar(t.decodedMs, ready, IM_COL32(230, 150, 60, 255));
+        ImGui::Dummy(ImVec2(barW, rowH));
+    });
+
+    const ImVec2 bottom = ImGui::GetCursorScreenPos();
+    for (const auto& m : GAssets.Markers()) {
+        const float x = bottom.x + labelW + (float)m.second * scale;
+        dl->AddLine(ImVec2(x, barsTop), ImVec2(x, bottom.y), IM_COL32(255, 255, 80, 255));
+        ImGui::Text("  %s: %.1f ms", m.first.c_str(), m.second);
+    }
+    ImGui::Text("  total %.1f ms (gray: queued, blue: decode/mips/BC, orange: wait for upload)", endMs);
+}
+
+// 프레임 구간 프로파일: 프레임 시간 히스토그램 + 마지막 프레임 플레임 그래프(스레드별) + 구간 합계
+static void DrawProfiler() {
+    if (!ImGui::CollapsingHeader("Profiler")) return;
+#if JM_PROFILE
+    static std::vector<Prof::ZoneStat> zones;
+    static size_t traceEvents = 0;
+    static bool traceTried = false;
+
+    float hist[Prof::kHistory];
+    Prof::FrameHistory(hist);
+    float maxMs = 1.0f, sumMs = 0.0f;
+    int filled = 0;
+    for (float v : hist) { if (v > 0.0f) { maxMs = std::max(maxMs, v); sumMs += v; ++filled; } }
+    char overlay[64];
+    snprintf(overlay, sizeof(overlay), "avg %.2f ms, max %.2f ms", filled ? sumMs / filled : 0.0f, maxMs);
+    ImGui::PlotHistogram("##frames", hist, Prof::kHistory, 0, overlay, 0.0f, maxMs * 1.1f,
+        ImVec2(ImGui::GetContentRegionAvail().x, 60.0f));
+
+    bool paused = Prof::Paused();
+    if (ImGui::Checkbox("Pause Capture", &paused)) Prof::SetPaused(paused);
+    ImGui::SameLine();
+    if (ImGui::Button("Export Chrome Trace")) {
+        traceEvents = Prof::WriteChromeTrace(L"trace.json");
+        traceTried = true;
+    }
+    if (traceTried) {
+        ImGui::SameLine();
+        if (traceEvents) ImGui::Text("%zu zones -> trace.json", traceEvents);
+        else ImGui::TextColored(ImVec4(1, 0.4f, 0.3f, 1), "export failed");
+    }
+
+    // 플레임 그래프: 가로 = 프레임 시간, 세로 = 중첩 깊이, 스레드마다 한 블록
+    const Prof::FrameCapture& f = Prof::LastFrame();
+    if (f.endNs <= f.beginNs) return;
+    ImGui::Text("Frame %.2f ms, %zu zones%s", f.Ms(), f.events.size(),
+        f.dropped ? " (ring overflow, some zones lost)" : "");
+    const float labelW = 80.0f, rowH = ImGui::GetTextLineHeight() + 2.0f;
+    const float barW = std::max(50.0f, ImGui::GetContentRegionAvail().x - labelW);
+    const float scale = barW / (float)(f.endNs - f.beginNs);
+    ImDrawList* dl = ImGui::GetWindowDrawList();
+    for (const Prof::ThreadInfo& t : f.threads) {
+        uint32_t depth = 0;
+        for (const Prof::Event& e : f.events)
+            if (e.thread == t.thread) depth = std::max(depth, e.depth + 1);
+        ImGui::TextUnformatted(t.name);
+        ImGui::SameLine(labelW);
+        const ImVec2 p = ImGui::GetCursorScreenPos();
+        const ImVec2 mouse = ImGui::GetIO().MousePos;
+        for (const Prof::Event& e : f.events) {
+            if (e.thread != t.thread) continue;
+            const float x0 = p.x + (float)(std::max(e.beginNs, f.beginNs) - f.beginNs) * scale;
+            const float x1 = std::max(p.x + (float)(std::min(e.endNs, f.endNs) - f.beginNs) * scale, x0 + 1.0f);
+            const float y0 = p.y + e.depth * rowH;
+            // 이름 해시로 색 (같은 구간은 프레임마다 같은 색)
+            uint32_t hsh = 2166136261u;
+            for (const char* c = e.name; *c; ++c) hsh = (hsh ^ (uint8_t)*c) * 16777619u;
+            const ImU32 col = IM_COL32(80 + (hsh & 0x7F), 80 + ((hsh >> 8) & 0x7F), 80 + ((hsh >> 16) & 0x7F), 255);
+            dl->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y0 + rowH - 1.0f), col);
+            if (x1 - x0 > 30.0f) {
+                dl->PushClipRect(ImVec2(x0, y0), ImVec2(x1, y0 + rowH), true);
+                dl->AddText(ImVec2(x0 + 2.0f, y0), IM_COL32(0, 0, 0, 255), e.name);
+                dl->PopClipRect();
+            }
+            if (mouse.x >= x0 && mouse.x < x1 && mouse.y >= y0 && mouse.y < y0 + rowH)
+                ImGui::SetTooltip("%s\n%.3f ms", e.name, (e.endNs - e.beginNs) * 1e-6);
+        }
+        ImGui::Dummy(ImVec2(barW, depth * rowH));
+    }
+
+    Prof::Summarize(f, zones);
+    for (const Prof::ZoneStat& z : zones)
+        ImGui::Text("  %-22s %7.3f ms (self %7.3f) x%u", z.name, z.totalMs, z.selfMs, z.calls);
+#else
+    ImGui::TextUnformatted("Built with JM_PROFILE=0");
+#endif
+}
+
+// 소프트 렌더러 준비 (높이맵이 바뀌면 다시). 알베도는 원본 BMP를 CPU로 디코드
+static bool EnsureSoftRenderer() {
+    if (GSoftReady) return true;
+    if (GHeightPixels.empty()) return false;
+    if (!GSoftRenderer.Init(GHeightPixels.data(), (int)GhmW, (int)GhmH, GGridSizeX, GGridSizeZ, GPatchRes)) return false;
+    const wchar_t* albedo[3] = { L"assets\\textures\\grass.bmp", L"assets\\textures\\rock.bmp", L"assets\\textures\\snow.bmp" };
+    for (int i = 0; i < 3; ++i) {
+        BMP::Image img;
+        if (BMP::DecodeRGBA8(albedo[i], img, false))
+            GSoftRenderer.SetAlbedo(i, img.data, (int)img.width, (int)img.height, img.rowPitch);
+    }
+    GSoftReady = true;
+    return true;
+}
+
+// 현재 카메라/HUD 설정 그대로 (GPU 프레임과 같은 입력)
+static TerrainSoftFrame CurrentSoftFrame() {
+    TerrainSoftFrame f;
+    DirectX::XMFLOAT4X4 vp;
+    DirectX::XMStoreFloat4x4(&vp, GCam.View() * GCam.Proj());
+    memcpy(f.viewProj, &vp, sizeof(f.viewProj));
+    DirectX::XMFLOAT3 cp = GCam.Position();
+    f.camPos[0] = cp.x; f.camPos[1] = cp.y; f.camPos[2] = cp.z;
+    f.fovY = GCam.FovY();
+    f.pixelError = GLodPixelError;
+    f.heightScale = GHeightScale;
+    f.bakedNormals = GUseBakedNormals;
+    f.frustumCull = GFrustumCull;
+    f.fogColor[0] = GFogColor.x; f.fogColor[1] = GFogColor.y; f.fogColor[2] = GFogColor.z;
+    f.fogDensity = GFogDensity;
+    f.thresholds[0] = GH_GrassMax; f.thresholds[1] = GH_SnowMin;
+    f.thresholds[2] = GS_SlopeLo;  f.thresholds[3] = GS_SlopeHi;
+    f.band = GBlendBand;
+    f.uvScale = GUvScale;
+    memcpy(f.clear, GClear, sizeof(f.clear));
+    f.format = (GridVertexFormat)GPatchFormat;
+    return f;
+}
+
+// HUD 창 (RenderFrame에서 ImGui 프레임 안에 호출)
+static void DrawHUD() {
+    ImGui::Begin("HUD");
+    ImGui::ColorEdit3("Clear", GClear);
+    ImGui::Checkbox("VSync", &GVsync);
+    ImGui::SliderFloat("HeightScale", &GHeightScale, 0.0f, 10.0f, "%.2f");
+
+    ImGui::SliderFloat("UV Scale", &GUvScale, 1.0f, 32.0f, "%.1f");
+    ImGui::SliderFloat("H GrassMax", &GH_GrassMax, 0.0f, 1.0f);
+    ImGui::SliderFloat("H SnowMin", &GH_SnowMin, 0.0f, 1.0f);
+    ImGui::SliderFloat("Slope Lo", &GS_SlopeLo, 0.0f, 1.0f);
+    ImGui::SliderFloat("Slope Hi", &GS_SlopeHi, 0.0f, 1.0f);
+    ImGui::SliderFloat("Blend Band", &GBlendBand, 0.01f, 0.2f, "%.2f");
+
+    ImGui::ColorEdit3("FogColor", &GFogColor.x);
+    ImGui::SliderFloat("FogDensity", &GFogDensity, 0.0f, 0.2f, "%.3f");
+
+    ImGui::Checkbox("Wireframe", &GWireframe);
+
+    // 커맨드 리스트 실행 통계 (이번 프레임)
+    ImGui::Checkbox("Null Backend", &GNullBackend);
+    const Render::ExecStats& es = GNullBackend ? GNullExec.Stats() : GD3DExec.Stats();
+    ImGui::Text("Cmd: %u draws, %u binds, %u uploads, %u API calls", es.draws, es.Binds(), es.uploads, es.apiCalls);
+    ImGui::Text("  elided %u binds / %u uploads, %u states", es.elidedBinds, es.elidedUploads, (unsigned)GCmdList.States().size());
+    if (es.invalidDraws)
+        ImGui::TextColored(ImVec4(1, 0.4f, 0.3f, 1), "  %u invalid draws skipped: %s", es.invalidDraws, es.firstError);
+
+    // 셰이더 바이트코드 캐시 (시작 + 핫 리로드 누적)
+    const ShaderCacheStats scs = GShaderCache.Stats();
+    ImGui::Text("Shader cache: %d hits, %d misses, %d failed | compiled %.0f ms, saved %.0f ms, preprocess %.1f ms",
+        scs.hits, scs.misses, scs.failures, scs.compileMs, scs.savedMs, scs.preprocessMs);
+    ImGui::Text("  %zu entries, %.2f MB, %d evicted, %d corrupt%s", scs.entries, scs.bytes / (1024.0 * 1024.0),
+        scs.evictions, scs.corrupt, GShaderCache.Enabled() ? "" : " (disabled)");
+    if (ImGui::SliderInt("Shader Cache MB", &GShaderCacheMB, 1, 256)) GShaderCache.SetMaxBytes((size_t)GShaderCacheMB << 20);
+    if (ImGui::Button("Recompile Shaders")) {
+        for (ShaderProgram* sp : GShaderPrograms) sp->Recompile();
+        RegisterShaderDeps();
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Clear Shader Cache")) GShaderCache.Clear();
+
+    // 파일 감시 (디바운스로 합쳐진 이벤트, 리로드 수, 텍스처는 바뀐 블록만 올린 양)
+    if (GWatcher.Running()) {
+        const FileWatcher::Stats ws = GWatcher.GetStats();
+        const AssetManager::Stats& as = GAssets.GetStats();
+        ImGui::Text("Watcher: %llu events -> %llu changes (%llu coalesced, %llu overflows), %zu files tracked",
+            (unsigned long long)ws.rawEvents, (unsigned long long)ws.posted, (unsigned long long)ws.coalesced,
+            (unsigned long long)ws.overflows, GShaderDeps.FileCount());
+        ImGui::Text("  reloads: %d shader, %d texture | uploaded %.2f MB of %.2f MB", GShaderReloads, GTextureReloads,
+            as.reloadUploadBytes / (1024.0 * 1024.0), as.reloadFullBytes / (1024.0 * 1024.0));
+    }
+    else ImGui::TextDisabled("Watcher: off (polling shader files every frame)");
+    for (size_t p = 0; p < std::size(GShaderPrograms); ++p)
+        if (!GShaderPrograms[p]->LastError().empty())
+            ImGui::TextColored(ImVec4(1, 0.4f, 0.3f, 1), "  %s: %s", GShaderProgramNames[p], GShaderPrograms[p]->LastError().c_str());
+
+    // 셰이더 변형: 기본은 처음 쓰일 때 워커에서 컴파일 (그동안 기본 변형), 버튼은 전부 미리 병렬로
+    ImGui::SliderInt("Splat Layers", &GSplatCount, 1, 3);
+    if (ImGui::Button("Precompile All Variants")) {
+        const auto t0 = std::chrono::steady_clock::now();
+        GVariantsPrecompiled = 0;
+        for (ShaderProgram* sp : GShaderPrograms) GVariantsPrecompiled += sp->PrecompileAll();
+        GVariantPrecompileMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    }
+    ImGui::SameLine();
+    ImGui::Text("%d variants in %.0f ms", GVariantsPrecompiled, GVariantPrecompileMs);
+    if (ImGui::TreeNode("Shader Variants")) {
+        for (size_t p = 0; p < std::size(GShaderPrograms); ++p) {
+            const ShaderProgram& sp = *GShaderPrograms[p];
+            ImGui::Text("%s", GShaderProgramNames[p]);
+            for (uint32_t k = 0; k < (uint32_t)sp.Variants().size(); ++k) {
+                const ShaderProgram::Variant& v = sp.Variants()[k];
+                const std::string desc = sp.Permutations().Describe(k);
+                if (v.ready)
+                    ImGui::Text("  %02X %-36s %6.1f ms  VS %3u / PS %3u instr%s%s", k, desc.c_str(), v.ms,
+                        v.vsInstructions, v.psInstructions, v.cacheHit ? "  (cache)" : "", k == sp.BaseKey() ? "  [base]" : "");
+                else if (v.pending) ImGui::TextDisabled("  %02X %-36s compiling...", k, desc.c_str());
+                else if (v.failed)  ImGui::TextColored(ImVec4(1, 0.4f, 0.3f, 1), "  %02X %-36s failed", k, desc.c_str());
+            }
+        }
+        ImGui::TreePop();
+    }
+
+    // CPU 래스터로 같은 프레임을 그려 파일로 (GPU 결과와 비교)
+    if (ImGui::Button("Software Render") && EnsureSoftRenderer()) {
+        GSoftTarget.Resize((int)GWidth, (int)GHeight);
+        GSoftStats = GSoftRenderer.Render(CurrentSoftFrame(), GSoftTarget);
+        GSoftWritten = GSoftTarget.WriteBMP(L"soft_frame.bmp");
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Soft Raster Benchmark") && EnsureSoftRenderer()) {
+        for (int i = 0; i < 3; ++i)
+            GSoftBench[i] = GSoftRenderer.Benchmark(CurrentSoftFrame(), (int)GWidth, (int)GHeight, GSoftBenchPaths[i]);
+    }
+    if (GSoftStats.draws) {
+        ImGui::Text("  %zu draws, %zu tris (%zu culled, %zu clipped), %zu px, %.1f ms (setup %.1f, bin %.1f, raster %.1f)%s",
+            GSoftStats.draws, GSoftStats.triangles, GSoftStats.culled, GSoftStats.clipped, GSoftStats.pixelsShaded,
+            GSoftStats.totalMs, GSoftStats.setupMs, GSoftStats.binMs, GSoftStats.rasterMs,
+            GSoftWritten ? " -> soft_frame.bmp" : "");
+    }
+    for (int i = 0; i < 3; ++i) {
+        const TerrainSoftRenderer::BenchResult& b = GSoftBench[i];
+        if (b.singleMs <= 0.0) continue;
+        // 같은 경로가 둘이면 CPU가 상위 경로를 지원하지 않는 것
+        ImGui::Text("  %-7s 1T %7.2f ms, MT %7.2f ms, %6.1f Mpix/s, mismatches %zu", Soft::PathName(b.path),
+            b.singleMs, b.parallelMs, b.mpixPerSec, b.mismatches);
+    }
+
+    // 절차적 높이맵
+    int noiseType = (int)GNoise.type;
+    if (ImGui::Combo("Noise", &noiseType, "fBm\0Ridged\0DomainWarp\0")) GNoise.type = (NoiseType)noiseType;
+    ImGui::Combo("Noise Size", &GNoiseSizeIdx, "256\0" "512\0" "1024\0" "2048\0" "4096\0" "8192\0");
+    int noiseSeed = (int)GNoise.seed;
+    if (ImGui::InputInt("Seed", &noiseSeed)) GNoise.seed = (uint32_t)noiseSeed;
+    ImGui::SliderInt("Octaves", &GNoise.octaves, 1, 16);
+    ImGui::SliderInt("Base Cells", &GNoise.baseCells, 1, 32);
+    ImGui::SliderFloat("Gain", &GNoise.gain, 0.2f, 0.8f, "%.2f");
+    if (GNoise.type == NoiseType::DomainWarp) ImGui::SliderFloat("Warp", &GNoise.warp, 0.0f, 1.0f, "%.2f");
+    if (ImGui::Button("Generate Heightmap")) RegenerateHeightmap();
+    ImGui::SameLine();
+    ImGui::Text("%.2f ms (%s)", GNoiseGenMs, TerrainNoise::PathName(TerrainNoise::Resolve(TerrainNoise::Path::Auto)));
+    if (ImGui::Button("Noise Benchmark")) {
+        for (int p = 0; p < 3; ++p)
+            GNoiseBench[p] = TerrainNoise::Benchmark(1024, 1024, GNoise.type, GNoiseBenchPaths[p]);
+    }
+    for (int p = 0; p < 3; ++p) {
+        const TerrainNoise::BenchResult& r = GNoiseBench[p];
+        if (r.singleMs <= 0.0) continue;
+        ImGui::Text("  %-6s %6.2f MS/s (1T) / %6.2f MS/s (MT), mismatch %d",
+            TerrainNoise::PathName(TerrainNoise::Resolve(GNoiseBenchPaths[p])),
+            r.msamplesPerSec, r.msamplesPerSecMT, (int)r.mismatches);
+    }
+
+    // 노멀 베이크: VS 샘플 4회 → 2회 (모핑 높이 + 노멀/높이)
+    ImGui::Checkbox("Baked Normals", &GUseBakedNormals);
+    ImGui::SameLine();
+    ImGui::Combo("##NormalFilter", &GNormalFilter, "Central\0Sobel\0");
+    const TerrainNormalMap::Stats& ns = GNormalMap.GetStats();
+    ImGui::Text("Normal bake: %.3f ms (%d rows), pending %d, rebakes %d",
+        ns.lastBakeMs, ns.lastRows, ns.pendingRows, (int)ns.rebakes);
+    if (ImGui::Button("Normal Bake Benchmark"))
+        GNormalBench = TerrainBake::Benchmark(2048, 2048, (NormalBakeFilter)GNormalFilter);
+    if (GNormalBench.parallelMs > 0.0) {
+        ImGui::Text("  2048^2 scalar %.2f / SIMD %.2f / MT %.2f ms, %.1f Mtexel/s, mismatch %d",
+            GNormalBench.scalarMs, GNormalBench.simdMs, GNormalBench.parallelMs,
+            GNormalBench.mtexelsPerSec, (int)GNormalBench.mismatches);
+    }
+
+    const TerrainSelectStats& ts = GTerrain.Stats();
+    ImGui::SliderFloat("LOD Pixel Error", &GLodPixelError, 0.25f, 16.0f, "%.2f");
+    ImGui::Text("Terrain: %d nodes visited, %d draws (%d quads)", ts.nodesVisited, ts.drawCount, ts.quadCount);
+    ImGui::Text("LOD select: %.3f ms", ts.selectMs);
+    if (ImGui::Checkbox("Geometry Clipmap (paged tiles)", &GClipmapMode)) {
+        if (GClipmapMode) GClipFailed = !StartClipmap();
+        else StopClipmap();
+    }
+    if (ImGui::Checkbox("Tiled Terrain File (.jmt)", &GClipTileFile) && GClipmapMode) GClipFailed = !StartClipmap();
+    ImGui::SliderInt("Tile Cache MB", &GClipBudgetMB, 1, 256);
+    if (GClipmapMode && GClipFailed) ImGui::TextColored(ImVec4(1, 0.4f, 0.3f, 1), "  clipmap source unavailable");
+    if (GClipmapMode && !GClipmap.Empty()) {
+        const ClipmapStats& cs = GClipmap.Stats();
+        const TilePagerStats& ps = GTilePager.Stats();
+        ImGui::Text("  Clipmap: levels %d..%d, %d texels in %d uploads, %d pieces waiting, %.3f ms",
+            cs.finestLevel, GClipmap.Levels() - 1, cs.texelsUpdated, cs.uploads, cs.pendingPieces, cs.updateMs);
+        ImGui::Text("  Tiles: hit %.1f%%, %zu resident (%.1f MB), %zu queued, %.2f MB/s streamed, %zu evicted",
+            ps.HitRate() * 100.0, ps.residentTiles, ps.residentBytes / (1024.0 * 1024.0), ps.queued, ps.mbPerSec, ps.evictions);
+        if (ImGui::Button("Clipmap Flythrough Check"))
+            GClipFly = TerrainClipmap::Flythrough(*GClipSrc, GClipmap.Desc(), (size_t)GClipBudgetMB << 20);
+        if (GClipFly.frames) {
+            ImGui::Text("  %d frames: update %.3f / max %.3f ms, %.0f texels/frame, %d not ready",
+                GClipFly.frames, GClipFly.avgUpdateMs, GClipFly.maxUpdateMs, GClipFly.avgTexelsPerFrame, GClipFly.notReadyFrames);
+            ImGui::Text("  hit %.1f%%, %.1f MB streamed (%.1f MB/s), peak %.1f MB, %zu evicted",
+                GClipFly.hitRate * 100.0, GClipFly.mbStreamed, GClipFly.mbPerSec, GClipFly.peakMB, GClipFly.evictions);
+            ImGui::TextColored(GClipFly.complete && !GClipFly.mismatches ? ImVec4(0.5f, 1, 0.5f, 1) : ImVec4(1, 0.4f, 0.3f, 1),
+                "  %s, %zu texels differ from source", GClipFly.complete ? "complete" : "incomplete", GClipFly.mismatches);
+        }
+        if (GClipTiles.IsOpen()) {
+            ImGui::Text("  Tile file: %d levels, %zu tiles, %.1f MB, built in %.0f ms (%.0f + %.0f), %.1f MB/s, RAM %.1f MB",
+                GClipBuild.levels, GClipBuild.tiles, GClipBuild.outputMB, GClipBuild.totalMs, GClipBuild.pyramidMs,
+                GClipBuild.normalMs, GClipBuild.mbPerSec, GClipBuild.peakRamBytes / (1024.0 * 1024.0));
+            if (ImGui::Button("Tile Read Benchmark")) GClipReadBench = GClipTiles.BenchmarkRandomReads();
+            if (GClipReadBench.reads)
+                ImGui::Text("  %d random reads: avg %.2f us, p50 %.2f, p99 %.2f, max %.1f us (%.0f MB/s)", GClipReadBench.reads,
+                    GClipReadBench.avgUs, GClipReadBench.p50Us, GClipReadBench.p99Us, GClipReadBench.maxUs, GClipReadBench.mbPerSec);
+        }
+    }
+    const MeshOpt::CacheReport& vc = GPatch.VertexCacheReport();
+    ImGui::Text("Patch vertex cache (%s%d): ACMR %.3f -> %.3f, ATVR %.3f -> %.3f (%.2f ms)",
+        MeshOpt::ModelName(vc.model), vc.cacheSize, vc.before.acmr, vc.after.acmr, vc.before.atvr, vc.after.atvr, vc.optimizeMs);
+    if (ImGui::Combo("Patch Vertex Format", &GPatchFormat, "Float32\0Quant16\0VertexId\0"))
+        GPatch.InitPatch(GDev.Dev(), GPatchRes, 16, (GridVertexFormat)GPatchFormat);
+    const GridBuildStats& gs = GPatch.BuildStats();
+    ImGui::Text("Patch: %u verts x %uB + %u idx x %uB = %.1f KB, %.3f ms%s",
+        gs.vertices, gs.vertexStride, gs.indices, gs.indexStride,
+        (gs.vertexBytes + gs.indexBytes) / 1024.0, gs.buildMs, gs.sharedIB ? " (shared IB)" : "");
+    if (ImGui::Button("Grid Build Benchmark")) {
+        const int sizes[3] = { 256, 1024, 4096 };
+        for (int f = 0; f < 3; ++f)
+            for (int i = 0; i < 3; ++i) {
+                // Float32 4096^2은 약 1GB라 생략, 기존 경로는 1024까지만
+                if (f == (int)GridVertexFormat::Float32 && sizes[i] > 1024) { GGridBench[f][i] = {}; continue; }
+                GGridBench[f][i] = Grid::Benchmark(sizes[i], (GridVertexFormat)f, sizes[i] <= 1024);
+            }
+    }
+    for (int f = 0; f < 3; ++f) {
+        for (int i = 0; i < 3; ++i) {
+            const Grid::BenchResult& b = GGridBench[f][i];
+            if (b.n == 0) continue;
+            ImGui::Text("  %-8s %4d^2: %7.2f ms, %5.1f B/vert, %6.1f MB", Grid::FormatName((GridVertexFormat)f),
+                b.n, b.buildMs, b.bytesPerVertex, b.bytes / (1024.0 * 1024.0));
+            if (b.legacyMs > 0.0) {
+                ImGui::SameLine();
+                ImGui::Text("(legacy %.2f ms, %.1f MB)", b.legacyMs, b.legacyBytes / (1024.0 * 1024.0));
+            }
+        }
+    }
+
+    // CPU 높이장: 카메라 아래 지면 + 배치 질의 벤치마크
+    if (ImGui::Checkbox("Walk Mode", &GWalkMode)) GCam.SetWalkMode(GWalkMode);
+    ImGui::SameLine();
+    float eye = GCam.EyeHeight();
+    if (ImGui::SliderFloat("Eye Height", &eye, 0.05f, 5.0f, "%.2f")) GCam.SetEyeHeight(eye);
+    if (!GHeightField.Empty()) {
+        const DirectX::XMFLOAT3 cp = GCam.Position();
+        float gh = 0.0f, slope = 0.0f;
+        HeightQueryOut q;
+        q.height = &gh; q.slope = &slope;
+        GHeightField.Query(&cp.x, &cp.z, 1, q, TerrainHeightField::Path::Scalar);
+        ImGui::Text("Ground: %.3f m (camera %+.3f), slope %.2f", gh, cp.y - gh, slope);
+    }
+    if (ImGui::Button("Height Query Benchmark") && !GHeightField.Empty()) {
+        for (int p = 0; p < 3; ++p)
+            GHeightBench[p] = GHeightField.Benchmark(1 << 20, GHeightBenchPaths[p]);
+    }
+    for (int p = 0; p < 3; ++p) {
+        const TerrainHeightField::BenchResult& r = GHeightBench[p];
+        if (r.queries == 0) continue;
+        ImGui::Text("  %-6s height %7.1f / +normal,slope %7.1f Mq/s, mismatch %d",
+            TerrainHeightField::PathName(TerrainHeightField::Resolve(GHeightBenchPaths[p])),
+            r.mqueriesPerSec, r.mqueriesPerSecFull, (int)r.mismatches);
+    }
+    if (GPickHit.hit) {
+        ImGui::Text("Pick: (%.3f, %.3f, %.3f) dist %.3f, normal (%.2f, %.2f, %.2f)", GPickHit.pos[0], GPickHit.pos[1], GPickHit.pos[2],
+            GPickHit.distance, GPickHit.normal[0], GPickHit.normal[1], GPickHit.normal[2]);
+    }
+    else {
+        ImGui::TextUnformatted("Pick: -");
+    }
+    ImGui::SameLine();
+    ImGui::Text("(%d levels, %.1f KB)", GPicker.LevelCount(), GPicker.Bytes() / 1024.0);
+    if (ImGui::Button("Pick Benchmark") && !GPicker.Empty()) GPickBench = GPicker.Benchmark(10000);
+    if (GPickBench.rays) {
+        ImGui::Text("  %zu rays, %zu hits: pyramid %.2f ms (MT %.2f), %.2f Mray/s, %.1f nodes/ray",
+            GPickBench.rays, GPickBench.hits, GPickBench.pickMs, GPickBench.pickMsMT, GPickBench.mraysPerSec, GPickBench.stepsPerRay);
+        ImGui::Text("  naive march %.2f ms (%.1f samples/ray), x%.1f, disagree %d",
+            GPickBench.marchMs, GPickBench.marchStepsPerRay,
+            GPickBench.pickMs > 0.0 ? GPickBench.marchMs / GPickBench.pickMs : 0.0, (int)GPickBench.disagreements);
+    }
+
+    ImGui::Checkbox("Frustum Cull", &GFrustumCull);
+    ImGui::Text("Cull: %d / %d visible, %.3f ms (%s)", (int)GTerrainVisible.size(), (int)GTerrainDraws.size(),
+        GCullMs, Cull::PathName(Cull::ResolvePath(CullPath::Auto)));
+    ImGui::Checkbox("Horizon Cull", &GHorizonCull);
+    if (GHorizonCull) {
+        const HorizonCullStats& hs = GHorizon.Stats();
+        ImGui::SameLine();
+        if (hs.skipped) ImGui::TextUnformatted("skipped (camera outside/below terrain)");
+        else ImGui::Text("%d / %d culled (%.1f%%), %.3f ms", hs.culled, hs.tested, hs.CulledPercent(), hs.ms);
+    }
+    if (ImGui::Button("Horizon Flythrough Check") && !GPicker.Empty()) {
+        TerrainSelectParams sp;
+        sp.heightScale = GHeightScale;
+        sp.viewportH = (float)GHeight;
+        sp.fovY = GCam.FovY();
+        sp.pixelError = GLodPixelError;
+        GHorizonFly = TerrainHorizonCull::Flythrough(GTerrain, GHeightField, GPicker, sp);
+    }
+    if (GHorizonFly.frames) {
+        ImGui::Text("  %d frames: culled avg %.1f%% / max %.1f%% (reference hidden %.1f%%), %.3f ms",
+            GHorizonFly.frames, GHorizonFly.avgCulledPercent, GHorizonFly.maxCulledPercent,
+            GHorizonFly.refHiddenPercent, GHorizonFly.avgMs);
+        ImGui::TextColored(GHorizonFly.violations ? ImVec4(1, 0.4f, 0.3f, 1) : ImVec4(0.5f, 1, 0.5f, 1),
+            "  %zu visible nodes culled (%zu reference rays)", GHorizonFly.violations, GHorizonFly.samples);
+    }
+    if (ImGui::Button("Cull Benchmark")) {
+        const size_t counts[3] = { 10000, 100000, 1000000 };
+        for (int p = 0; p < 3; ++p)
+            for (int c = 0; c < 3; ++c)
+                GCullBench[p][c] = Cull::Benchmark(GCam.GetFrustum(), counts[c], GCullBenchPaths[p]);
+    }
+    for (int p = 0; p < 3; ++p) {
+        if (GCullBench[p][0].boxes == 0) continue;
+        ImGui::Text("  %-6s %6.1f / %6.1f / %6.1f Mbox/s (10k/100k/1M), mismatch %d",
+            Cull::PathName(Cull::ResolvePath(GCullBenchPaths[p])),
+            GCullBench[p][0].mboxesPerSec, GCullBench[p][1].mboxesPerSec, GCullBench[p][2].mboxesPerSec,
+            (int)(GCullBench[p][0].mismatches + GCullBench[p][1].mismatches + GCullBench[p][2].mismatches));
+    }
+
+    ImGui::Text("Pixel kernels: %s", PixelKernels::PathName(PixelKernels::Resolve(PixelKernels::Path::Auto)));
+    if (ImGui::Button("Pixel Kernel Benchmark")) {
+        for (int p = 0; p < 3; ++p)
+            GPixelBench[p] = PixelKernels::Benchmark(4096, 4096, GPixelBenchPaths[p]);
+    }
+    for (int p = 0; p < 3; ++p) {
+        const PixelKernels::BenchResult& r = GPixelBench[p];
+        if (r.rgbGBs <= 0.0) continue;
+        ImGui::Text("  %-6s RGB %.2f / RGBA %.2f / Gray %.2f GB/s, mismatch %d",
+            PixelKernels::PathName(PixelKernels::Resolve(GPixelBenchPaths[p])),
+            r.rgbGBs, r.rgbaGBs, r.grayGBs, (int)r.mismatches);
+    }
+
+    if (ImGui::Button("Mip Chain Check")) {
+        GMipCheck[0] = Mip::SelfCheck(4096, 4096, 4, MipFilter::SRGB);
+        GMipCheck[1] = Mip::SelfCheck(4096, 4096, 1, MipFilter::Linear);
+    }
+    if (GMipCheck[0].bytes) {
+        ImGui::Text("  RGBA8 sRGB: %.2f ms, max err %d", GMipCheck[0].buildMs, GMipCheck[0].maxError);
+        ImGui::Text("  R8 Linear : %.2f ms, max err %d", GMipCheck[1].buildMs, GMipCheck[1].maxError);
+    }
+
+    if (ImGui::Button("BC Encode Benchmark")) {
+        for (int f = 0; f < 3; ++f)
+            for (int q = 0; q < 3; ++q)
+                GBCBench[f][q] = BC::Benchmark(GBCFormats[f], GBCQualities[q]);
+    }
+    for (int f = 0; f < 3; ++f) {
+        for (int q = 0; q < 3; ++q) {
+            const BC::BenchResult& r = GBCBench[f][q];
+            if (!r.blocks) continue;
+            ImGui::Text("  %s %-6s %6.2f Mblocks/s, %.2f dB",
+                BC::FormatName(GBCFormats[f]), BC::QualityName(GBCQualities[q]), r.mblocksPerSec, r.psnr);
+        }
+    }
+
+    // 텍스처 캐시
+    const AssetManager::Stats& as = GAssets.GetStats();
+    ImGui::Text("Assets: %d cached, %d live, %.1f KB, loads %d / hits %d / evicted %d",
+        (int)as.entries, (int)as.live, as.gpuBytes / 1024.0, (int)as.loads, (int)as.hits, (int)as.evictions);
+    GAssets.ForEach([](const TextureInfo& t) {
+        ImGui::Text("  %-12s %4ux%-4u %7.1f KB %6.2f ms ref %u",
+            t.name.c_str(), t.width, t.height, t.gpuBytes / 1024.0, t.loadMs, t.refCount);
+        if (t.psnr > 0.0) { ImGui::SameLine(); ImGui::Text("%.2f dB", t.psnr); }
+    });
+    if (ImGui::Button("Evict Unused")) GAssets.EvictUnused();
+
+    DrawProfiler();
+    DrawJobs();
+    DrawFrameMemory();
+    DrawStartupTimeline();
+
+    ImGui::End();
+}
+
 static void RenderFrame() {
-    GShader.TryHotReload();
+    Prof::BeginFrame();
+    {
+        JM_PROFILE_ZONE("Hot Reload");
+        if (GWatcher.Running()) PumpFileChanges();
+        else for (ShaderProgram* sp : GShaderPrograms) sp->TryHotReload();
+        Jobs::PumpMain();                                           // 끝난 셰이더 변형 등 메인 스레드 몫
+    }
+    {
+        JM_PROFILE_ZONE("Asset Update");
+        GAssets.Update();
+    }
     GDev.BeginFrame(GClear);
     auto* c = GDev.Ctx();
-    ID3D11Buffer* cb = GSceneCB.Get();
 
     // dt 계산 (고정 프레임이 아니면)
     static LARGE_INTEGER freq{}, prev{};
@@ -424,103 +1454,222 @@ static void RenderFrame() {
     float dt = float(now.QuadPart - prev.QuadPart) / float(freq.QuadPart);
     prev = now;
 
-    // 카메라 업데이트
-    GCam.UpdateFromKeyboardWin32(dt);
+    // 카메라 업데이트 (행렬/절두체는 프레임당 1회 캐시)
+    {
+        JM_PROFILE_ZONE("Camera");
+        GCam.UpdateFromKeyboardWin32(dt);
+        // 높이장/피커는 HUD 값(HeightScale 등)을 매 프레임 따른다 (피라미드는 0~255 단위라 재빌드 없음)
+        GHeightField.SetGridSize(GGridSizeX, GGridSizeZ);
+        GHeightField.SetHeightScale(GHeightScale);
+        // 걷기 모드: 이동 후 지면에 붙인다
+        if (GCam.WalkMode() && !GHeightField.Empty()) {
+            const DirectX::XMFLOAT3 p = GCam.Position();
+            GCam.ClampToGround(GHeightField.HeightAt(p.x, p.z));
+        }
+        float aspect = (float)GWidth / (float)GHeight;
+        GCam.UpdateFrame(aspect);
+    }
+
+    // 클립맵: 도착한 타일 반영 → 창 이동/띠 채우기 → 바뀐 텍셀만 업로드
+    if (GClipmapMode && !GClipmap.Empty()) {
+        JM_PROFILE_ZONE("Clipmap Update");
+        GTilePager.SetBudget((size_t)GClipBudgetMB << 20);
+        GTilePager.Update();
+        const DirectX::XMFLOAT3 p = GCam.Position();
+        GClipmap.Update(p.x, p.z);
+        GClipmapGPU.Upload(c, GClipmap);
+    }
+
+    // 커서 아래 지형 (HUD 표시)
+    {
+        JM_PROFILE_ZONE("Terrain Pick");
+        GPickHit = {};
+        POINT cur;
+        if (!GPicker.Empty() && GetCursorPos(&cur) && ScreenToClient(GWnd, &cur)) {
+            DirectX::XMFLOAT3 o, d;
+            GCam.ScreenRay((float)cur.x, (float)cur.y, (float)GWidth, (float)GHeight, o, d);
+            GPickHit = GPicker.Pick(TerrainRay{ { o.x, o.y, o.z }, { d.x, d.y, d.z } });
+        }
+    }
 
     // 행렬 계산
-    float aspect = (float)GWidth / (float)GHeight;
     DirectX::XMMATRIX World = DirectX::XMMatrixIdentity();
     DirectX::XMMATRIX View = GCam.View();
-    DirectX::XMMATRIX Proj = GCam.Proj(aspect);
+    DirectX::XMMATRIX Proj = GCam.Proj();
 
-    // 상수버퍼 업로드
-    
-    SceneCB scb{};
+    // 상수버퍼 내용 (업로드는 커맨드 리스트가, 내용이 바뀐 것만)
+    // 스테이징은 프레임 아레나에: 다음 프레임까지 유효 (더블 버퍼), EndFrame에서 한꺼번에 해제
+    FrameMem::FrameArena& frame = FrameMem::Default();
+    SceneCB& scb = *frame.New<SceneCB>();
     scb.WVP = DirectX::XMMatrixTranspose(World * View * Proj);
     scb.LightDir = { -0.4f, -1.0f, -0.3f };
     scb.FogColor = GFogColor;
     scb.FogDensity = GFogDensity;
     scb.CamPos = GCam.Position();
 
-    D3D11_MAPPED_SUBRESOURCE m{};
-    HR(c->Map(cb, 0, D3D11_MAP_WRITE_DISCARD, 0, &m));
-    memcpy(m.pData, &scb, sizeof(SceneCB));
-    c->Unmap(cb, 0);
-
     // ── Terrain CB(b1) 채우기 ───────────────────────────────
-    TerrainCBCPU tcb{};
+    // HeightScale/필터가 바뀌었으면 노멀 맵을 행 예산만큼 다시 베이크
+    {
+        JM_PROFILE_ZONE("Normal Map Update");
+        GNormalMap.SetParams(CurrentNormalBakeParams());
+        GNormalMap.Update(c);
+    }
+
+    TerrainCBCPU& tcb = *frame.New<TerrainCBCPU>();
     tcb.HeightScale = GHeightScale;
+    tcb.UseBakedNormals = (GUseBakedNormals && GNormalMap.Ready()) ? 1.0f : 0.0f;
     tcb.GridSize = { GGridSizeX, GGridSizeZ };
     //tcb.TexelSize = { 1.0f / 256.0f, 1.0f / 256.0f }; // 우리가 만든 높이맵 크기
     tcb.TexelSize = { 1.0f / float(GhmW), 1.0f / float(GhmH) };
 
-    D3D11_MAPPED_SUBRESOURCE mt{};
-    HR(c->Map(GTerrainCB.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mt));
-    memcpy(mt.pData, &tcb, sizeof(TerrainCBCPU));
-    c->Unmap(GTerrainCB.Get(), 0);
-
-    // VS/PS에 바인딩
-    ID3D11Buffer* cb1 = GTerrainCB.Get();
-    c->VSSetConstantBuffers(1, 1, &cb1);
-    c->PSSetConstantBuffers(1, 1, &cb1);
-    
-    // Heightmap 리소스를 바인딩 
-    ID3D11ShaderResourceView* srv = GHeightSRV.Get();
-    ID3D11SamplerState* s = GHeightSamp.Get();
-    c->VSSetShaderResources(0, 1, &srv);
-    c->VSSetSamplers(0, 1, &s);
-
-    MatCBCPU mat{};
+    MatCBCPU& mat = *frame.New<MatCBCPU>();
     mat.thresholds = { GH_GrassMax, GH_SnowMin, GS_SlopeLo, GS_SlopeHi };
     mat.band = GBlendBand;
     mat.uvScale = GUvScale;
 
-    D3D11_MAPPED_SUBRESOURCE mat_map{};
-    HR(c->Map(GMatCB.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mat_map));
-    memcpy(mat_map.pData, &mat, sizeof(mat));
-    c->Unmap(GMatCB.Get(), 0);
-
-    ID3D11Buffer* b2 = GMatCB.Get();
-    c->PSSetConstantBuffers(2, 1, &b2);
-
-
-    c->RSSetState(GWireframe ? GRS_Wire.Get() : GRS_Solid.Get());
-
-
-    GShader.Bind(c);
-    GGrid.Bind(c);
-    c->DrawIndexed(GGrid.IndexCount(), 0, 0);
-    c->VSSetConstantBuffers(0, 1, &cb);
-    c->PSSetConstantBuffers(0, 1, &cb);
+    // ── 쿼드트리 LOD 선택 ───────────────────────────────────
+    TerrainSelectParams tsp{};
+    DirectX::XMFLOAT3 camPos = GCam.Position();
+    tsp.camPos[0] = camPos.x; tsp.camPos[1] = camPos.y; tsp.camPos[2] = camPos.z;
+    tsp.heightScale = GHeightScale;
+    tsp.viewportH = (float)GHeight;
+    tsp.fovY = GCam.FovY();
+    tsp.pixelError = GLodPixelError;
+    {
+        JM_PROFILE_ZONE("Terrain Select");
+        GTerrain.Select(tsp, GTerrainDraws);
+    }
 
-    ID3D11ShaderResourceView* srvs[3] = { GTexGrass.Get(), GTexRock.Get(), GTexSnow.Get() };
-    ID3D11SamplerState* samp = GAlbedoSamp.Get();
-    c->PSSetShaderResources(0, 3, srvs); // t0,t1,t2
-    c->PSSetSamplers(0, 1, &samp);       // s0
+    // ── 노드 AABB 절두체 컬링 → 보이는 드로우 인덱스 ─────────────
+    {
+        JM_PROFILE_ZONE("Terrain Cull");
+        auto t0 = std::chrono::steady_clock::now();
+        const size_t n = GTerrainDraws.size();
+        GTerrainVisible.resize(n);
+        size_t vis = n;
+        if (GFrustumCull) {
+            GTerrainBoxes.Clear();
+            GTerrainBoxes.Reserve(n);
+            for (const TerrainDraw& d : GTerrainDraws)
+                GTerrainBoxes.Push(d.x, d.minY, d.z, d.x + d.sizeX, d.maxY, d.z + d.sizeZ);
+            vis = Cull::FrustumAABBs(GCam.GetFrustum(), GTerrainBoxes, GTerrainVisible.data());
+        }
+        else {
+            for (size_t i = 0; i < n; ++i) GTerrainVisible[i] = (uint32_t)i;
+        }
+        GTerrainVisible.resize(vis);
+        GCullMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    }
 
+    // ── 지평선 가림 컬링 (가까운 노드부터, 모든 선택 노드를 가림자로) ──
+    if (GHorizonCull && !GHeightField.Empty()) {
+        JM_PROFILE_ZONE("Terrain Horizon Cull");
+        const TerrainQuadTreeDesc& qd = GTerrain.Desc();
+        HorizonCullParams hp;
+        hp.camPos[0] = camPos.x; hp.camPos[1] = camPos.y; hp.camPos[2] = camPos.z;
+        hp.groundY = GHeightField.HeightAt(camPos.x, camPos.z);
+        hp.minX = qd.originX; hp.minZ = qd.originZ;
+        hp.maxX = qd.originX + qd.sizeX; hp.maxZ = qd.originZ + qd.sizeZ;
+        GHorizon.Cull(hp, GTerrainDraws, GTerrainVisible);
+    }
 
-    ImGui_ImplDX11_NewFrame(); ImGui_ImplWin32_NewFrame(); ImGui::NewFrame();
-    ImGui::Begin("HUD");
-    ImGui::ColorEdit3("Clear", GClear);
-    ImGui::Checkbox("VSync", &GVsync);
-    ImGui::SliderFloat("HeightScale", &GHeightScale, 0.0f, 10.0f, "%.2f");
+    // ── 지형 패스 기록 (바인딩 → 드로우 순) ─────────────────────
+    // 변형 키: 아직 컴파일 중이면 기본 변형 (다음 프레임부터 교체)
+    const bool fogOn = GFogDensity > 0.0f;
+    const int  splat = GWireframe ? 0 : GSplatCount;
+    ShaderProgram& sp = GShader[(int)GPatch.Format()];
+    const ShaderProgram::Variant& spv = sp.Select(TerrainVariantKey(sp.Permutations(), fogOn, splat, tcb.UseBakedNormals > 0.5f));
+    TerrainPassResources tr;
+    tr.pipeline.inputLayout = spv.il.Get();
+    tr.pipeline.vs = spv.vs.Get();
+    tr.pipeline.ps = spv.ps.Get();
+    tr.pipeline.rasterizer = GWireframe ? GRS_Wire.Get() : GRS_Solid.Get();
+    tr.pipeline.name = "terrain";
+    TerrainPass::ApplyRequirements(tr.pipeline);
+    tr.patch.vb = GPatch.VertexBuffer();
+    tr.patch.stride = GPatch.VertexStride();
+    tr.patch.ib = GPatch.IndexBuffer();
+    tr.patch.indexFormat = GPatch.IndexFormat() == DXGI_FORMAT_R16_UINT ? Render::IndexFormat::U16 : Render::IndexFormat::U32;
+    tr.indexCount = GPatch.IndexCount();
+    tr.patchRes = GPatch.PatchRes();
+    tr.sceneCB = GSceneCB.Get();
+    tr.terrainCB = GTerrainCB.Get();
+    tr.matCB = GMatCB.Get();
+    tr.nodeCB = GNodeCB.Get();
+    tr.heightSRV = GAssets.SRV(GHeightTex);         // t0: Heightmap
+    tr.normalSRV = GNormalMap.SRV();                // t1: 노멀/높이
+    tr.heightSampler = GHeightSamp.Get();
+    tr.albedoSRVs[0] = GAssets.SRV(GTexGrass);
+    tr.albedoSRVs[1] = GAssets.SRV(GTexRock);
+    tr.albedoSRVs[2] = GAssets.SRV(GTexSnow);
+    tr.albedoSampler = GAlbedoSamp.Get();
+
+    TerrainPassConstants tk;
+    tk.scene = &scb;   tk.sceneBytes = sizeof(scb);
+    tk.terrain = &tcb; tk.terrainBytes = sizeof(tcb);
+    tk.mat = &mat;     tk.matBytes = sizeof(mat);
+    tk.camPos[0] = camPos.x; tk.camPos[1] = camPos.y; tk.camPos[2] = camPos.z;
+
+    const bool clipmapDraw = GClipmapMode && !GClipmap.Empty() && GClipmapGPU.Ready();
+    TerrainClipmapResources cr;
+    if (clipmapDraw) {
+        const ShaderProgram::Variant& cv = GClipShader.Select(TerrainVariantKey(GClipShader.Permutations(), fogOn, splat, false));
+        cr.pipeline.vs = cv.vs.Get();
+        cr.pipeline.ps = cv.ps.Get();
+        cr.pipeline.rasterizer = tr.pipeline.rasterizer;
+        cr.pipeline.name = "terrain clipmap";
+        TerrainClipmapPass::ApplyRequirements(cr.pipeline);
+        for (int v = 0; v < TerrainClipmap::kRingVariants; ++v) {
+            cr.rings[v].ib = GClipmapGPU.RingIB(v);
+            cr.rings[v].indexFormat = Render::IndexFormat::U16;
+            cr.ringIndexCount[v] = GClipmapGPU.RingIndexCount(v);
+        }
+        cr.sceneCB = tr.sceneCB;
+        cr.terrainCB = tr.terrainCB;
+        cr.matCB = tr.matCB;
+        cr.levelCB = GClipCB.Get();
+        cr.clipSRV = GClipmapGPU.SRV();
+        for (int i = 0; i < 3; ++i) cr.albedoSRVs[i] = tr.albedoSRVs[i];
+        cr.albedoSampler = tr.albedoSampler;
+    }
 
-    ImGui::SliderFloat("UV Scale", &GUvScale, 1.0f, 32.0f, "%.1f");
-    ImGui::SliderFloat("H GrassMax", &GH_GrassMax, 0.0f, 1.0f);
-    ImGui::SliderFloat("H SnowMin", &GH_SnowMin, 0.0f, 1.0f);
-    ImGui::SliderFloat("Slope Lo", &GS_SlopeLo, 0.0f, 1.0f);
-    ImGui::SliderFloat("Slope Hi", &GS_SlopeHi, 0.0f, 1.0f);
-    ImGui::SliderFloat("Blend Band", &GBlendBand, 0.01f, 0.2f, "%.2f");
+    {
+        JM_PROFILE_ZONE("Terrain Record");
+        GCmdList.Reset();
+        if (clipmapDraw) TerrainClipmapPass::Record(GCmdList, cr, tk, GClipmap);
+        else TerrainPass::Record(GCmdList, tr, tk, GTerrain, GTerrainDraws, GTerrainVisible);
+        GCmdList.Sort();
+    }
 
-    ImGui::ColorEdit3("FogColor", &GFogColor.x);
-    ImGui::SliderFloat("FogDensity", &GFogDensity, 0.0f, 0.2f, "%.3f");
+    {
+        JM_PROFILE_ZONE("Submit");
+        if (GNullBackend) {
+            GNullExec.Submit(GCmdList);
+        }
+        else {
+            // 지난 프레임 ImGui가 상태를 바꿨으므로 바인딩 캐시는 매 프레임 무효화 (업로드 사본은 유지)
+            GD3DExec.SetContext(c);
+            GD3DExec.InvalidateState();
+            GD3DExec.Submit(GCmdList);
+        }
+    }
 
-    ImGui::Checkbox("Wireframe", &GWireframe);
+    {
+        JM_PROFILE_ZONE("ImGui");
+        ImGui_ImplDX11_NewFrame(); ImGui_ImplWin32_NewFrame(); ImGui::NewFrame();
+        DrawHUD();
+        ImGui::Render();
+        ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+    }
+    {
+        JM_PROFILE_ZONE("Present");
+        GDev.EndFrame(GVsync);
+    }
 
-    ImGui::End();
-    ImGui::Render();
-    ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
-    GDev.EndFrame(GVsync);
+    static bool firstFrame = true;
+    if (firstFrame) { GAssets.Mark("First frame"); firstFrame = false; }
+    frame.EndFrame();
+    Prof::EndFrame();
 }
 
 // ---------------- WinMain ----------------
@@ -537,6 +1686,7 @@ int APIENTRY wWinMain(HINSTANCE h, HINSTANCE, LPWSTR, int n) {
     GWnd = CreateWindowW(wc.lpszClassName, L"M0 Renderer", WS_OVERLAPPEDWINDOW | WS_VISIBLE,
         CW_USEDEFAULT, CW_USEDEFAULT, rc.right - rc.left, rc.bottom - rc.top, nullptr, nullptr, h, nullptr);
 
+    Prof::SetThreadName("main");
     InitAll();
     MSG msg{}; bool run = true;
     while (run) {
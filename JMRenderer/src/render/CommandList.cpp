@@ -0,0 +1,286 @@
+#include "CommandList.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Render {
+
+    bool PipelineDesc::operator==(const PipelineDesc& o) const
+    {
+        return inputLayout == o.inputLayout && vs == o.vs && ps == o.ps && rasterizer == o.rasterizer &&
+            memcmp(requiredCBs, o.requiredCBs, sizeof(requiredCBs)) == 0 &&
+            memcmp(requiredSRVs, o.requiredSRVs, sizeof(requiredSRVs)) == 0 &&
+            memcmp(requiredSamplers, o.requiredSamplers, sizeof(requiredSamplers)) == 0;
+    }
+
+    bool MeshDesc::operator==(const MeshDesc& o) const
+    {
+        return vb == o.vb && stride == o.stride && ib == o.ib && indexFormat == o.indexFormat;
+    }
+
+    bool BindState::operator==(const BindState& o) const
+    {
+        // е  POD 迭
+        return memcmp(this, &o, sizeof(BindState)) == 0;
+    }
+
+    uint64_t MakeSortKey(uint8_t layer, uint32_t pipeline, uint32_t mesh, float depth01)
+    {
+        const float d = std::min(std::max(depth01, 0.0f), 1.0f);
+        const uint64_t dq = (uint64_t)(d * 4294967295.0);
+        return ((uint64_t)layer << 56) | ((uint64_t)(pipeline & 0xFFF) << 44) |
+            ((uint64_t)(mesh & 0xFFF) << 32) | dq;
+    }
+
+    //  CommandList 
+
+    void CommandList::Reset()
+    {
+        // 뷮  (Ӹ Ҵ )
+        mPipelines.clear();
+        mMeshes.clear();
+        mStates.clear();
+        mUploads.clear();
+        mDraws.clear();
+        mPayload.clear();
+        mCur = {};
+        mStateDirty = true;
+        mPipeline = mMesh = -1;
+        mLayer = 0;
+    }
+
+    void CommandList::SetPipeline(const PipelineDesc& p)
+    {
+        auto it = std::find(mPipelines.begin(), mPipelines.end(), p);
+        if (it == mPipelines.end()) it = mPipelines.insert(mPipelines.end(), p);
+        mPipeline = it - mPipelines.begin();
+    }
+
+    void CommandList::SetMesh(const MeshDesc& m)
+    {
+        auto it = std::find(mMeshes.begin(), mMeshes.end(), m);
+        if (it == mMeshes.end()) it = mMeshes.insert(mMeshes.end(), m);
+        mMesh = it - mMeshes.begin();
+    }
+
+    void CommandList::BindCB(uint8_t stages, int slot, Handle buffer)
+    {
+        if (slot < 0 || slot >= kMaxCBs) return;
+        for (int s = 0; s < kStages; ++s) {
+            if (!(stages & (1 << s))) continue;
+            mCur.cb[s][slot] = buffer;
+            mCur.cbVersion[s][slot] = VersionOf(buffer);
+        }
+        mStateDirty = true;
+    }
+
+    void CommandList::BindSRV(uint8_t stages, int slot, Handle srv)
+    {
+        if (slot < 0 || slot >= kMaxSRVs) return;
+        for (int s = 0; s < kStages; ++s)
+            if (stages & (1 << s)) mCur.srv[s][slot] = srv;
+        mStateDirty = true;
+    }
+
+    void CommandList::BindSampler(uint8_t stages, int slot, Handle sampler)
+    {
+        if (slot < 0 || slot >= kMaxSamplers) return;
+        for (int s = 0; s < kStages; ++s)
+            if (stages & (1 << s)) mCur.sampler[s][slot] = sampler;
+        mStateDirty = true;
+    }
+
+    uint32_t CommandList::VersionOf(Handle buffer) const
+    {
+        for (size_t i = mUploads.size(); i-- > 0;)
+            if (mUploads[i].buffer == buffer) return (uint32_t)i + 1;
+        return 0;
+    }
+
+    void CommandList::UpdateBuffer(Handle buffer, const void* data, size_t bytes)
+    {
+        if (!buffer || !data || bytes == 0) return;
+        Upload u;
+        u.buffer = buffer;
+        u.offset = (uint32_t)mPayload.size();
+        u.bytes = (uint32_t)bytes;
+        const uint8_t* src = static_cast<const uint8_t*>(data);
+        mPayload.insert(mPayload.end(), src, src + bytes);
+        mUploads.push_back(u);
+
+        // ̹ ε Ե   
+        const uint32_t v = (uint32_t)mUploads.size();
+        for (int s = 0; s < kStages; ++s)
+            for (int i = 0; i < kMaxCBs; ++i)
+                if (mCur.cb[s][i] == buffer) { mCur.cbVersion[s][i] = v; mStateDirty = true; }
+    }
+
+    void CommandList::DrawIndexed(uint32_t indexCount, uint32_t startIndex, int32_t baseVertex, float depth01)
+    {
+        if (indexCount == 0) return;
+        if (mStateDirty) {
+            if (mStates.empty() || !(mStates.back() == mCur)) mStates.push_back(mCur);
+            mStateDirty = false;
+        }
+        DrawItem d;
+        // /޽ð  ִ ε ǥ    ɷ
+        d.pipeline = mPipeline < 0 ? ~0u : (uint32_t)mPipeline;
+        d.mesh = mMesh < 0 ? ~0u : (uint32_t)mMesh;
+        d.state = (uint32_t)mStates.size() - 1;
+        d.indexCount = indexCount;
+        d.startIndex = startIndex;
+        d.baseVertex = baseVertex;
+        d.key = MakeSortKey(mLayer, d.pipeline, d.mesh, depth01);
+        mDraws.push_back(d);
+    }
+
+    void CommandList::Sort()
+    {
+        std::stable_sort(mDraws.begin(), mDraws.end(),
+            [](const DrawItem& a, const DrawItem& b) { return a.key < b.key; });
+    }
+
+    //  CommandExecutor 
+
+    void CommandExecutor::InvalidateState()
+    {
+        mValid = false;
+    }
+
+    void CommandExecutor::ForgetBuffer(Handle buffer)
+    {
+        mShadows.erase(std::remove_if(mShadows.begin(), mShadows.end(),
+            [&](const Shadow& s) { return s.buffer == buffer; }), mShadows.end());
+    }
+
+    CommandExecutor::Shadow& CommandExecutor::ShadowOf(Handle buffer)
+    {
+        for (Shadow& s : mShadows)
+            if (s.buffer == buffer) return s;
+        mShadows.emplace_back();
+        mShadows.back().buffer = buffer;
+        return mShadows.back();
+    }
+
+    const char* CommandExecutor::Validate(const CommandList& list, const DrawItem& d) const
+    {
+        if (d.pipeline >= list.Pipelines().size()) return "draw without pipeline";
+        if (d.mesh >= list.Meshes().size()) return "draw without mesh";
+        const PipelineDesc& p = list.Pipelines()[d.pipeline];
+        const MeshDesc& m = list.Meshes()[d.mesh];
+        const BindState& b = list.States()[d.state];
+        if (!p.vs || !p.ps) return "pipeline without shaders";
+        if (!m.ib) return "mesh without index buffer";
+        if (m.stride != 0 && !m.vb) return "mesh without vertex buffer";
+        if ((m.stride != 0) != (p.inputLayout != nullptr)) return "input layout does not match mesh";
+        for (int s = 0; s < kStages; ++s) {
+            for (int i = 0; i < kMaxCBs; ++i)
+                if ((p.requiredCBs[s] & (1 << i)) && !b.cb[s][i]) return s == 0 ? "VS constant buffer unbound" : "PS constant buffer unbound";
+            for (int i = 0; i < kMaxSRVs; ++i)
+                if ((p.requiredSRVs[s] & (1 << i)) && !b.srv[s][i]) return s == 0 ? "VS texture unbound" : "PS texture unbound";
+            for (int i = 0; i < kMaxSamplers; ++i)
+                if ((p.requiredSamplers[s] & (1 << i)) && !b.sampler[s][i]) return s == 0 ? "VS sampler unbound" : "PS sampler unbound";
+        }
+        return nullptr;
+    }
+
+    // ٲ     (D3D11 *SetXXX(first, count) )
+    template<int N, class Fn>
+    void CommandExecutor::ApplySlots(Handle (&cur)[N], const Handle (&want)[N], uint32_t& binds, Fn&& apply)
+    {
+        int first = N, last = -1;
+        for (int i = 0; i < N; ++i) {
+            if (cur[i] == want[i]) {
+                if (want[i]) ++mStats.elidedBinds;
+                continue;
+            }
+            first = std::min(first, i);
+            last = i;
+            ++binds;
+        }
+        if (last < 0) return;
+        for (int i = first; i <= last; ++i) cur[i] = want[i];
+        apply(first, last - first + 1, &cur[first]);
+        ++mStats.apiCalls;
+    }
+
+    const ExecStats& CommandExecutor::Submit(const CommandList& list)
+    {
+        mStats = {};
+        for (Shadow& s : mShadows) s.version = 0;
+        if (!mValid) {
+            //    : ĳø  ù ο찡  εϰ (  /޽ÿ   )
+            mPipeline = {};
+            mMesh = {};
+            mBound = {};
+        }
+
+        for (const DrawItem& d : list.Draws()) {
+            if (const char* err = Validate(list, d)) {
+                ++mStats.invalidDraws;
+                if (!mStats.firstError) mStats.firstError = err;
+                continue;
+            }
+            const PipelineDesc& p = list.Pipelines()[d.pipeline];
+            const MeshDesc& m = list.Meshes()[d.mesh];
+            const BindState& b = list.States()[d.state];
+
+            if (!(mPipeline == p)) {
+                mPipeline = p;
+                ApplyPipeline(p);
+                ++mStats.pipelineBinds;
+                ++mStats.apiCalls;
+            }
+            else {
+                ++mStats.elidedBinds;
+            }
+            if (!(mMesh == m)) {
+                mMesh = m;
+                ApplyMesh(m);
+                ++mStats.meshBinds;
+                ++mStats.apiCalls;
+            }
+            else {
+                ++mStats.elidedBinds;
+            }
+
+            // ε:      ٸ 
+            for (int s = 0; s < kStages; ++s) {
+                for (int i = 0; i < kMaxCBs; ++i) {
+                    const uint32_t v = b.cbVersion[s][i];
+                    if (!b.cb[s][i] || v == 0) continue;
+                    Shadow& sh = ShadowOf(b.cb[s][i]);
+                    if (sh.version == v) continue;      // ̹ Submit ̹ ݿ
+                    sh.version = v;
+                    const Upload& u = list.Uploads()[v - 1];
+                    const uint8_t* data = list.Payload() + u.offset;
+                    if (sh.bytes.size() == u.bytes && memcmp(sh.bytes.data(), data, u.bytes) == 0) {
+                        ++mStats.elidedUploads;
+                        continue;
+                    }
+                    sh.bytes.assign(data, data + u.bytes);
+                    ApplyUpload(u.buffer, data, u.bytes);
+                    ++mStats.uploads;
+                    ++mStats.apiCalls;
+                }
+            }
+
+            for (int s = 0; s < kStages; ++s) {
+                const Stage st = (Stage)s;
+                ApplySlots(mBound.cb[s], b.cb[s], mStats.cbBinds,
+                    [&](int f, int n, const Handle* h) { ApplyCBs(st, f, n, h); });
+                ApplySlots(mBound.srv[s], b.srv[s], mStats.srvBinds,
+                    [&](int f, int n, const Handle* h) { ApplySRVs(st, f, n, h); });
+                ApplySlots(mBound.sampler[s], b.sampler[s], mStats.samplerBinds,
+                    [&](int f, int n, const Handle* h) { ApplySamplers(st, f, n, h); });
+            }
+
+            ApplyDrawIndexed(d.indexCount, d.startIndex, d.baseVertex);
+            ++mStats.draws;
+            ++mStats.apiCalls;
+        }
+        EndSubmit();
+        mValid = true;
+        return mStats;
+    }
+
+} // namespace Render
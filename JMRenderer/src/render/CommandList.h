@@ -0,0 +1,177 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 鿣   Ŀǵ Ʈ (D3D  , 帮  )
+// : /޽/ε/ε " " ٲٰ, ο찡  ¸  
+//  ε ο ڿ ϸ  ο쿡  ʴ´ (Ⱑ  ɷ)
+// :  Ű  ο츦   ¿ ٸ ͸ 鿣忡 ѱ,   (elide)Ѵ
+namespace Render {
+
+    // 鿣 ü  (D3D11: ID3D11Buffer* ). Ʈ 񱳸 ϰ  ʴ´
+    using Handle = const void*;
+
+    enum class Stage : uint8_t { VS, PS, Count };
+    enum StageMask : uint8_t { StageVS = 1, StagePS = 2, StageAll = 3 };
+    enum class IndexFormat : uint8_t { U16, U32 };
+
+    constexpr int kMaxCBs = 4;          // b0~b3
+    constexpr int kMaxSRVs = 4;         // t0~t3
+    constexpr int kMaxSamplers = 2;     // s0~s1
+    constexpr int kStages = (int)Stage::Count;
+
+    // ̴ +  . required*: ο  ݵ ε ־ ϴ  (Ʈ = )
+    struct PipelineDesc {
+        Handle inputLayout = nullptr;   //    ޽ø nullptr
+        Handle vs = nullptr, ps = nullptr;
+        Handle rasterizer = nullptr;
+        uint8_t requiredCBs[kStages] = {};
+        uint8_t requiredSRVs[kStages] = {};
+        uint8_t requiredSamplers[kStages] = {};
+        const char* name = "";
+
+        bool operator==(const PipelineDesc& o) const;
+    };
+
+    struct MeshDesc {
+        Handle vb = nullptr;            // stride 0̸    (SV_VertexID)
+        uint32_t stride = 0;
+        Handle ib = nullptr;
+        IndexFormat indexFormat = IndexFormat::U32;
+
+        bool operator==(const MeshDesc& o) const;
+    };
+
+    // ο  ε. cbVersion    ° ε   ϴ (0 = ε )
+    struct BindState {
+        Handle cb[kStages][kMaxCBs] = {};
+        Handle srv[kStages][kMaxSRVs] = {};
+        Handle sampler[kStages][kMaxSamplers] = {};
+        uint32_t cbVersion[kStages][kMaxCBs] = {};
+
+        bool operator==(const BindState& o) const;
+    };
+
+    // ε =  ü  (  WRITE_DISCARD)
+    struct Upload {
+        Handle buffer = nullptr;
+        uint32_t offset = 0, bytes = 0;     // CommandList::Payload()  
+    };
+
+    struct DrawItem {
+        uint64_t key = 0;
+        uint32_t pipeline = 0, mesh = 0, state = 0;
+        uint32_t indexCount = 0, startIndex = 0;
+        int32_t  baseVertex = 0;
+    };
+
+    //  Ű: [̾ 8][ 12][޽ 12][ 32].  Ű    ( )
+    uint64_t MakeSortKey(uint8_t layer, uint32_t pipeline, uint32_t mesh, float depth01);
+
+    class CommandList {
+    public:
+        void Reset();
+
+        void SetLayer(uint8_t layer) { mLayer = layer; }
+        void SetPipeline(const PipelineDesc& p);
+        void SetMesh(const MeshDesc& m);
+        void BindCB(uint8_t stages, int slot, Handle buffer);
+        void BindSRV(uint8_t stages, int slot, Handle srv);
+        void BindSampler(uint8_t stages, int slot, Handle sampler);
+
+        //  ο buffer data   (ο İ )
+        void UpdateBuffer(Handle buffer, const void* data, size_t bytes);
+        template<class T> void UpdateBuffer(Handle buffer, const T& data) { UpdateBuffer(buffer, &data, sizeof(T)); }
+
+        // depth01:  ̾//޽   (0 = , տ ڷ)
+        void DrawIndexed(uint32_t indexCount, uint32_t startIndex = 0, int32_t baseVertex = 0, float depth01 = 0.0f);
+
+        // ο츦 Ű  ( )
+        void Sort();
+
+        const std::vector<PipelineDesc>& Pipelines() const { return mPipelines; }
+        const std::vector<MeshDesc>& Meshes() const { return mMeshes; }
+        const std::vector<BindState>& States() const { return mStates; }
+        const std::vector<Upload>& Uploads() const { return mUploads; }
+        const std::vector<DrawItem>& Draws() const { return mDraws; }
+        const uint8_t* Payload() const { return mPayload.data(); }
+
+    private:
+        uint32_t VersionOf(Handle buffer) const;
+
+        std::vector<PipelineDesc> mPipelines;
+        std::vector<MeshDesc> mMeshes;
+        std::vector<BindState> mStates;
+        std::vector<Upload> mUploads;       //  v = mUploads[v - 1]
+        std::vector<DrawItem> mDraws;
+        std::vector<uint8_t> mPayload;
+
+        BindState mCur;
+        bool mStateDirty = true;            // mCur mStates.back() ٸ
+        int64_t mPipeline = -1, mMesh = -1;
+        uint8_t mLayer = 0;
+    };
+
+    // (Submit  ) . elided =  ο츶  εϴ   ȣ   
+    struct ExecStats {
+        uint32_t draws = 0;
+        uint32_t invalidDraws = 0;          //  з ǳʶ
+        uint32_t pipelineBinds = 0, meshBinds = 0;
+        uint32_t cbBinds = 0, srvBinds = 0, samplerBinds = 0;
+        uint32_t uploads = 0;
+        uint32_t apiCalls = 0;              // 鿣 ȣ  (   )
+        uint32_t elidedBinds = 0;
+        uint32_t elidedUploads = 0;         //   ε 
+        const char* firstError = nullptr;   // ù   
+
+        uint32_t Binds() const { return pipelineBinds + meshBinds + cbBinds + srvBinds + samplerBinds; }
+    };
+
+    //  // ⼭,  API ȣ⸸ Ļ Ŭ
+    class CommandExecutor {
+    public:
+        virtual ~CommandExecutor() = default;
+
+        // list Sort()   
+        const ExecStats& Submit(const CommandList& list);
+        const ExecStats& Stats() const { return mStats; }
+
+        // ܺ ڵ(ImGui ) ¸ ǵ  Submit  ٽ ε
+        // ε 纻  (  ״̹Ƿ)
+        void InvalidateState();
+        void ForgetBuffer(Handle buffer);   //  / 
+
+    protected:
+        virtual void ApplyPipeline(const PipelineDesc& p) = 0;
+        virtual void ApplyMesh(const MeshDesc& m) = 0;
+        //   [first, first+count)
+        virtual void ApplyCBs(Stage s, int first, int count, const Handle* buffers) = 0;
+        virtual void ApplySRVs(Stage s, int first, int count, const Handle* srvs) = 0;
+        virtual void ApplySamplers(Stage s, int first, int count, const Handle* samplers) = 0;
+        virtual void ApplyUpload(Handle buffer, const void* data, size_t bytes) = 0;
+        virtual void ApplyDrawIndexed(uint32_t indexCount, uint32_t startIndex, int32_t baseVertex) = 0;
+        //  ο츦 ѱ  (  鿣尡 ⼭  ׸)
+        virtual void EndSubmit() {}
+
+    private:
+        const char* Validate(const CommandList& list, const DrawItem& d) const;
+        template<int N, class Fn>
+        void ApplySlots(Handle (&cur)[N], const Handle (&want)[N], uint32_t& binds, Fn&& apply);
+
+        struct Shadow {
+            Handle buffer = nullptr;
+            std::vector<uint8_t> bytes;
+            uint32_t version = 0;           // ̹ Submit ݿ  (0 = )
+        };
+        Shadow& ShadowOf(Handle buffer);
+
+        ExecStats mStats;
+        bool mValid = false;                // Ʒ ĳð  鿣 ¿ 
+        PipelineDesc mPipeline;
+        MeshDesc mMesh;
+        BindState mBound;
+        std::vector<Shadow> mShadows;       // ۺ  ε  (  )
+    };
+
+} // namespace Render
@@ -0,0 +1,81 @@
+#include "D3D11Executor.h"
+#include <cassert>
+#include <cstring>
+
+#ifndef HR
+#define HR(x) do { HRESULT __hr=(x); assert(SUCCEEDED(__hr)); } while(0)
+#endif
+
+using namespace Render;
+
+namespace {
+
+    template<class T>
+    T* As(Handle h) { return static_cast<T*>(const_cast<void*>(h)); }
+
+    // Handle 迭  ID3D11* 迭 (  ۾  )
+    template<class T, int N>
+    void Cast(const Handle* src, int count, T* (&dst)[N])
+    {
+        for (int i = 0; i < count && i < N; ++i) dst[i] = As<T>(src[i]);
+    }
+
+} // namespace
+
+void D3D11Executor::ApplyPipeline(const PipelineDesc& p)
+{
+    mCtx->IASetInputLayout(As<ID3D11InputLayout>(p.inputLayout));
+    mCtx->VSSetShader(As<ID3D11VertexShader>(p.vs), nullptr, 0);
+    mCtx->PSSetShader(As<ID3D11PixelShader>(p.ps), nullptr, 0);
+    mCtx->RSSetState(As<ID3D11RasterizerState>(p.rasterizer));
+}
+
+void D3D11Executor::ApplyMesh(const MeshDesc& m)
+{
+    // stride 0:    SV_VertexID
+    ID3D11Buffer* vb = As<ID3D11Buffer>(m.vb);
+    UINT stride = m.stride, offset = 0;
+    mCtx->IASetVertexBuffers(0, 1, &vb, &stride, &offset);
+    mCtx->IASetIndexBuffer(As<ID3D11Buffer>(m.ib),
+        m.indexFormat == IndexFormat::U16 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT, 0);
+    mCtx->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+}
+
+void D3D11Executor::ApplyCBs(Stage s, int first, int count, const Handle* buffers)
+{
+    ID3D11Buffer* b[kMaxCBs] = {};
+    Cast(buffers, count, b);
+    if (s == Stage::VS) mCtx->VSSetConstantBuffers(first, count, b);
+    else mCtx->PSSetConstantBuffers(first, count, b);
+}
+
+void D3D11Executor::ApplySRVs(Stage s, int first, int count, const Handle* srvs)
+{
+    ID3D11ShaderResourceView* v[kMaxSRVs] = {};
+    Cast(srvs, count, v);
+    if (s == Stage::VS) mCtx->VSSetShaderResources(first, count, v);
+    else mCtx->PSSetShaderResources(first, count, v);
+}
+
+void D3D11Executor::ApplySamplers(Stage s, int first, int count, const Handle* samplers)
+{
+    ID3D11SamplerState* v[kMaxSamplers] = {};
+    Cast(samplers, count, v);
+    if (s == Stage::VS) mCtx->VSSetSamplers(first, count, v);
+    else mCtx->PSSetSamplers(first, count, v);
+}
+
+void D3D11Executor::ApplyUpload(Handle buffer, const void* data, size_t bytes)
+{
+    //  ۴ DYNAMIC + CPU_ACCESS_WRITE  ־ Ѵ
+    ID3D11Buffer* b = As<ID3D11Buffer>(buffer);
+    D3D11_MAPPED_SUBRESOURCE m{};
+    HR(mCtx->Map(b, 0, D3D11_MAP_WRITE_DISCARD, 0, &m));
+    memcpy(m.pData, data, bytes);
+    mCtx->Unmap(b, 0);
+}
+
+void D3D11Executor::ApplyDrawIndexed(uint32_t indexCount, uint32_t startIndex, int32_t baseVertex)
+{
+    mCtx->DrawIndexed(indexCount, startIndex, baseVertex);
+}
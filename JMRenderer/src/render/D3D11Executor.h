@@ -0,0 +1,21 @@
+#pragma once
+#include <d3d11.h>
+#include "CommandList.h"
+
+// Ŀǵ Ʈ  ؽƮ  (Handle = ID3D11* )
+class D3D11Executor : public Render::CommandExecutor {
+public:
+    void SetContext(ID3D11DeviceContext* ctx) { mCtx = ctx; }
+
+protected:
+    void ApplyPipeline(const Render::PipelineDesc& p) override;
+    void ApplyMesh(const Render::MeshDesc& m) override;
+    void ApplyCBs(Render::Stage s, int first, int count, const Render::Handle* buffers) override;
+    void ApplySRVs(Render::Stage s, int first, int count, const Render::Handle* srvs) override;
+    void ApplySamplers(Render::Stage s, int first, int count, const Render::Handle* samplers) override;
+    void ApplyUpload(Render::Handle buffer, const void* data, size_t bytes) override;
+    void ApplyDrawIndexed(uint32_t indexCount, uint32_t startIndex, int32_t baseVertex) override;
+
+private:
+    ID3D11DeviceContext* mCtx = nullptr;
+};
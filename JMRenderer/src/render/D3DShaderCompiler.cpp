@@ -0,0 +1,109 @@
+#include "D3DShaderCompiler.h"
+#include <d3dcompiler.h>
+#include <d3d11shader.h>
+#include <wrl/client.h>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+
+using Microsoft::WRL::ComPtr;
+namespace fs = std::filesystem;
+
+namespace {
+
+    bool ReadText(const fs::path& path, std::string& out)
+    {
+        std::ifstream f(path, std::ios::binary);
+        if (!f) return false;
+        out.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    std::string BlobText(ID3DBlob* b)
+    {
+        return b ? std::string(static_cast<const char*>(b->GetBufferPointer()), b->GetBufferSize()) : std::string();
+    }
+
+    //    #include ã,   Ѵ (۴ ü   )
+    class RecordingInclude : public ID3DInclude {
+    public:
+        RecordingInclude(const fs::path& root, std::vector<fs::path>& opened) : mRoot(root.parent_path()), mOpened(opened) {}
+
+        HRESULT __stdcall Open(D3D_INCLUDE_TYPE, LPCSTR name, LPCVOID parent, LPCVOID* data, UINT* bytes) override
+        {
+            auto it = mDirs.find(parent);
+            const fs::path& base = it != mDirs.end() ? it->second : mRoot;
+            const fs::path p = (base / fs::u8path(name)).lexically_normal();
+
+            auto buf = std::make_unique<std::string>();
+            if (!ReadText(p, *buf)) return E_FAIL;
+            mOpened.push_back(p);
+            mDirs[buf->data()] = p.parent_path();
+            *data = buf->data();
+            *bytes = (UINT)buf->size();
+            mBuffers.push_back(std::move(buf));
+            return S_OK;
+        }
+
+        HRESULT __stdcall Close(LPCVOID) override { return S_OK; }
+
+    private:
+        fs::path mRoot;
+        std::vector<fs::path>& mOpened;
+        std::map<LPCVOID, fs::path> mDirs;
+        std::vector<std::unique_ptr<std::string>> mBuffers;
+    };
+
+} // namespace
+
+const char* D3DShaderCompiler::Identity() const
+{
+    return D3DCOMPILER_DLL_A;
+}
+
+bool D3DShaderCompiler::Preprocess(const ShaderCompileDesc& d, std::string& text,
+                                   std::vector<fs::path>& includes, std::string& errors)
+{
+    std::string src;
+    if (!ReadText(d.path, src)) { errors = "cannot read " + d.path.u8string(); return false; }
+
+    std::vector<D3D_SHADER_MACRO> macros;
+    for (const ShaderDefine& def : d.defines) macros.push_back({ def.name.c_str(), def.value.c_str() });
+    macros.push_back({ nullptr, nullptr });
+
+    RecordingInclude inc(d.path, includes);
+    const std::string name = d.path.u8string();
+    ComPtr<ID3DBlob> out, err;
+    const HRESULT hr = D3DPreprocess(src.data(), src.size(), name.c_str(), macros.data(), &inc,
+                                     out.GetAddressOf(), err.GetAddressOf());
+    errors = BlobText(err.Get());
+    if (FAILED(hr) || !out) return false;
+    text.assign(static_cast<const char*>(out->GetBufferPointer()), out->GetBufferSize());
+    return true;
+}
+
+bool D3DShaderCompiler::Compile(const ShaderCompileDesc& d, const std::string& text,
+                                std::vector<uint8_t>& bytecode, std::string& errors)
+{
+    // define/#include ó ̹ 
+    const std::string name = d.path.u8string();
+    ComPtr<ID3DBlob> code, err;
+    const HRESULT hr = D3DCompile(text.data(), text.size(), name.c_str(), nullptr, nullptr,
+                                  d.entry.c_str(), d.profile.c_str(), d.flags, 0, code.GetAddressOf(), err.GetAddressOf());
+    errors = BlobText(err.Get());
+    if (FAILED(hr) || !code) return false;
+    const uint8_t* p = static_cast<const uint8_t*>(code->GetBufferPointer());
+    bytecode.assign(p, p + code->GetBufferSize());
+    return true;
+}
+
+uint32_t D3DShaderCompiler::InstructionCount(const std::vector<uint8_t>& bytecode)
+{
+    ComPtr<ID3D11ShaderReflection> refl;
+    if (bytecode.empty() || FAILED(D3DReflect(bytecode.data(), bytecode.size(), __uuidof(ID3D11ShaderReflection),
+                                              reinterpret_cast<void**>(refl.GetAddressOf()))))
+        return 0;
+    D3D11_SHADER_DESC sd{};
+    return SUCCEEDED(refl->GetDesc(&sd)) ? sd.InstructionCount : 0;
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include "ShaderCache.h"
+
+// D3DCompiler 鿣: D3DPreprocess #include/define ġ (  ), ģ ؽƮ D3DCompile
+// #include "x"     . ɾ  D3DReflect
+class D3DShaderCompiler : public ShaderCompiler {
+public:
+    const char* Identity() const override;
+    bool Preprocess(const ShaderCompileDesc& d, std::string& text,
+                    std::vector<std::filesystem::path>& includes, std::string& errors) override;
+    bool Compile(const ShaderCompileDesc& d, const std::string& text,
+                 std::vector<uint8_t>& bytecode, std::string& errors) override;
+    uint32_t InstructionCount(const std::vector<uint8_t>& bytecode) override;
+};
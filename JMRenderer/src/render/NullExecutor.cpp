@@ -0,0 +1,56 @@
+#include "NullExecutor.h"
+
+using namespace Render;
+
+const char* NullExecutor::CallName(CallType t)
+{
+    switch (t) {
+    case CallType::Pipeline:    return "Pipeline";
+    case CallType::Mesh:        return "Mesh";
+    case CallType::CBs:         return "CBs";
+    case CallType::SRVs:        return "SRVs";
+    case CallType::Samplers:    return "Samplers";
+    case CallType::Upload:      return "Upload";
+    default:                    return "DrawIndexed";
+    }
+}
+
+void NullExecutor::Record(CallType t, Stage s, int first, int count, Handle h)
+{
+    if (mRecord) mCalls.push_back({ t, s, first, count, h });
+}
+
+void NullExecutor::ApplyPipeline(const PipelineDesc& p)
+{
+    Record(CallType::Pipeline, Stage::VS, 0, 1, p.vs);
+}
+
+void NullExecutor::ApplyMesh(const MeshDesc& m)
+{
+    Record(CallType::Mesh, Stage::VS, 0, 1, m.ib);
+}
+
+void NullExecutor::ApplyCBs(Stage s, int first, int count, const Handle* buffers)
+{
+    Record(CallType::CBs, s, first, count, buffers[0]);
+}
+
+void NullExecutor::ApplySRVs(Stage s, int first, int count, const Handle* srvs)
+{
+    Record(CallType::SRVs, s, first, count, srvs[0]);
+}
+
+void NullExecutor::ApplySamplers(Stage s, int first, int count, const Handle* samplers)
+{
+    Record(CallType::Samplers, s, first, count, samplers[0]);
+}
+
+void NullExecutor::ApplyUpload(Handle buffer, const void*, size_t bytes)
+{
+    Record(CallType::Upload, Stage::VS, 0, (int)bytes, buffer);
+}
+
+void NullExecutor::ApplyDrawIndexed(uint32_t indexCount, uint32_t startIndex, int32_t)
+{
+    Record(CallType::DrawIndexed, Stage::VS, (int)startIndex, (int)indexCount, nullptr);
+}
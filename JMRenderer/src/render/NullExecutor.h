@@ -0,0 +1,39 @@
+#pragma once
+#include <vector>
+#include "CommandList.h"
+
+// GPU  Ŀǵ Ʈ ϴ 鿣 (帮 , /)
+// ε/ε/ο  D3D11Executor  CommandExecutor  ״ ģ
+class NullExecutor : public Render::CommandExecutor {
+public:
+    enum class CallType : uint8_t { Pipeline, Mesh, CBs, SRVs, Samplers, Upload, DrawIndexed };
+
+    // 鿣忡  ȣ   (recordCalls  )
+    struct Call {
+        CallType type;
+        Render::Stage stage;    // CBs/SRVs/Samplers
+        int first, count;       //  , DrawIndexed (startIndex, indexCount)
+        Render::Handle handle;  // ù /ε 
+    };
+
+    void SetRecordCalls(bool on) { mRecord = on; }
+    const std::vector<Call>& Calls() const { return mCalls; }
+    void ClearCalls() { mCalls.clear(); }
+
+    static const char* CallName(CallType t);
+
+protected:
+    void ApplyPipeline(const Render::PipelineDesc& p) override;
+    void ApplyMesh(const Render::MeshDesc& m) override;
+    void ApplyCBs(Render::Stage s, int first, int count, const Render::Handle* buffers) override;
+    void ApplySRVs(Render::Stage s, int first, int count, const Render::Handle* srvs) override;
+    void ApplySamplers(Render::Stage s, int first, int count, const Render::Handle* samplers) override;
+    void ApplyUpload(Render::Handle buffer, const void* data, size_t bytes) override;
+    void ApplyDrawIndexed(uint32_t indexCount, uint32_t startIndex, int32_t baseVertex) override;
+
+private:
+    void Record(CallType t, Render::Stage s, int first, int count, Render::Handle h);
+
+    bool mRecord = false;
+    std::vector<Call> mCalls;
+};
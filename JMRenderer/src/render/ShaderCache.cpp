@@ -0,0 +1,319 @@
+#include "ShaderCache.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    constexpr uint32_t kEntryMagic = 0x43534D4A;   // "JMSC"
+    constexpr uint32_t kEntryVersion = 1;
+
+    struct EntryHeader {
+        uint32_t magic, version;
+        uint64_t keyA, keyB;
+        uint32_t size;
+        float    compileMs;                     // ó Ͽ ɸ ð (   ð )
+        uint64_t check;                         // Ʈڵ FNV-1a
+    };
+
+    double MsSince(std::chrono::steady_clock::time_point t0)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    }
+
+    uint64_t Fnv1a(const uint8_t* p, size_t n)
+    {
+        uint64_t h = 0xCBF29CE484222325ull;
+        for (size_t i = 0; i < n; ++i) h = (h ^ p[i]) * 0x100000001B3ull;
+        return h;
+    }
+
+    uint64_t Mix64(uint64_t x)
+    {
+        x ^= x >> 33; x *= 0xFF51AFD7ED558CCDull;
+        x ^= x >> 33; x *= 0xC4CEB9FE1A85EC53ull;
+        x ^= x >> 33;
+        return x;
+    }
+
+    //  迭 64Ʈ ؽø Բ  128Ʈ Ű (FNV-1a + /ȸ)
+    // ʵ帶 ̸  ־ ("ab","c") ("a","bc") 
+    struct KeyHasher {
+        uint64_t a = 0xCBF29CE484222325ull, b = 0x9E3779B97F4A7C15ull;
+
+        void Bytes(const void* data, size_t n)
+        {
+            const uint8_t* p = static_cast<const uint8_t*>(data);
+            for (size_t i = 0; i < n; ++i) {
+                a = (a ^ p[i]) * 0x100000001B3ull;
+                b = ((b ^ p[i]) * 0xBF58476D1CE4E5B9ull);
+                b = (b << 27) | (b >> 37);
+            }
+        }
+        void U64(uint64_t v) { Bytes(&v, sizeof(v)); }
+        void Str(const std::string& s) { U64(s.size()); Bytes(s.data(), s.size()); }
+    };
+
+    FILE* OpenFile(const fs::path& path, bool write)
+    {
+        FILE* f = nullptr;
+#if defined(_MSC_VER)
+        if (_wfopen_s(&f, path.c_str(), write ? L"wb" : L"rb") != 0) f = nullptr;
+#else
+        f = fopen(path.c_str(), write ? "wb" : "rb");
+#endif
+        return f;
+    }
+
+    bool ParseKey(const std::string& stem, ShaderCache::Key& k)
+    {
+        if (stem.size() != 32 || stem.find_first_not_of("0123456789abcdef") != std::string::npos) return false;
+        k.a = strtoull(stem.substr(0, 16).c_str(), nullptr, 16);
+        k.b = strtoull(stem.substr(16).c_str(), nullptr, 16);
+        return true;
+    }
+
+} // namespace
+
+ShaderCache::Key ShaderCache::MakeKey(const ShaderCompileDesc& d, const std::string& text,
+                                      const std::vector<fs::path>& includes, const char* identity)
+{
+    KeyHasher h;
+    h.Str(identity ? identity : "");
+    h.Str(d.entry);
+    h.Str(d.profile);
+    h.U64(d.flags);
+    h.U64(d.defines.size());
+    for (const ShaderDefine& def : d.defines) { h.Str(def.name); h.Str(def.value); }
+    h.U64(includes.size());
+    for (const fs::path& p : includes) h.Str(p.generic_u8string());
+    h.Str(text);
+    return Key{ Mix64(h.a), Mix64(h.b ^ h.a) };
+}
+
+std::string ShaderCache::KeyName(const Key& k)
+{
+    char s[33];
+    snprintf(s, sizeof(s), "%016llx%016llx", (unsigned long long)k.a, (unsigned long long)k.b);
+    return s;
+}
+
+fs::path ShaderCache::EntryPath(const Key& k) const
+{
+    return mDir / (KeyName(k) + ".bin");
+}
+
+bool ShaderCache::Init(const fs::path& dir, size_t maxBytes, ShaderCompiler* compiler)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mCompiler = compiler;
+    mMaxBytes = maxBytes;
+    mIndex.clear();
+    mBytes = 0;
+    mTick = 0;
+    mStats = {};
+    mDir.clear();
+
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+    if (!fs::is_directory(dir, ec)) return false;
+    mDir = dir;
+    mTmpSalt = ((uint64_t)std::random_device{}() << 32) ^ std::random_device{}();
+
+    //  ׸ :  ð  = LRU .  ð  .tmp   
+    struct Found { fs::file_time_type time; Key key; size_t bytes; };
+    std::vector<Found> found;
+    const auto staleTmp = fs::file_time_type::clock::now() - std::chrono::hours(1);
+    for (fs::directory_iterator it(mDir, ec), end; !ec && it != end; it.increment(ec)) {
+        if (!it->is_regular_file(ec)) continue;
+        const fs::path& p = it->path();
+        const fs::file_time_type t = it->last_write_time(ec);
+        if (p.extension() == ".tmp") {
+            if (!ec && t < staleTmp) fs::remove(p, ec);
+            continue;
+        }
+        Key k;
+        if (p.extension() != ".bin" || !ParseKey(p.stem().string(), k)) continue;
+        found.push_back(Found{ t, k, (size_t)it->file_size(ec) });
+    }
+    std::sort(found.begin(), found.end(), [](const Found& a, const Found& b) { return a.time < b.time; });
+    for (const Found& f : found) {
+        mIndex[f.key] = Entry{ f.bytes, ++mTick };
+        mBytes += f.bytes;
+    }
+    EvictLocked();
+    return true;
+}
+
+void ShaderCache::SetMaxBytes(size_t maxBytes)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mMaxBytes = maxBytes;
+    EvictLocked();
+}
+
+void ShaderCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    std::error_code ec;
+    for (const auto& kv : mIndex) fs::remove(EntryPath(kv.first), ec);
+    mIndex.clear();
+    mBytes = 0;
+}
+
+void ShaderCache::ResetCounters()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStats = {};
+}
+
+ShaderCacheStats ShaderCache::Stats() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    ShaderCacheStats s = mStats;
+    s.entries = mIndex.size();
+    s.bytes = mBytes;
+    return s;
+}
+
+bool ShaderCache::Compile(const ShaderCompileDesc& d, ShaderCompileOutput& out)
+{
+    out = {};
+    const auto t0 = std::chrono::steady_clock::now();
+    if (!mCompiler) { out.errors = "ShaderCache: no compiler"; return false; }
+
+    std::string text;
+    const bool pre = mCompiler->Preprocess(d, text, out.includes, out.errors);
+    const double preMs = MsSince(t0);
+    if (!pre) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStats.preprocessMs += preMs;
+        ++mStats.failures;
+        out.ms = preMs;
+        return false;
+    }
+
+    const Key k = MakeKey(d, text, out.includes, mCompiler->Identity());
+    float firstMs = 0.0f;
+    if (Enabled() && Load(k, out.bytecode, firstMs)) {
+        out.cacheHit = true;
+        out.ms = MsSince(t0);
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStats.preprocessMs += preMs;
+        ++mStats.hits;
+        mStats.savedMs += firstMs;
+        return true;
+    }
+
+    const auto tc = std::chrono::steady_clock::now();
+    const bool ok = mCompiler->Compile(d, text, out.bytecode, out.errors);
+    const double compileMs = MsSince(tc);
+    if (ok && Enabled()) Store(k, out.bytecode, (float)compileMs);
+    out.ms = MsSince(t0);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStats.preprocessMs += preMs;
+    mStats.compileMs += compileMs;
+    if (ok) ++mStats.misses;
+    else    ++mStats.failures;
+    return ok;
+}
+
+bool ShaderCache::Load(const Key& k, std::vector<uint8_t>& bytecode, float& compileMs)
+{
+    const fs::path path = EntryPath(k);
+    FILE* f = OpenFile(path, false);
+    if (!f) {
+        // ٸ μ  ο 
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto it = mIndex.find(k);
+        if (it != mIndex.end()) { mBytes -= it->second.bytes; mIndex.erase(it); }
+        return false;
+    }
+
+    EntryHeader h{};
+    bool ok = fread(&h, sizeof(h), 1, f) == 1 && h.magic == kEntryMagic && h.version == kEntryVersion &&
+              h.keyA == k.a && h.keyB == k.b && h.size > 0;
+    if (ok) {
+        bytecode.resize(h.size);
+        ok = fread(bytecode.data(), 1, h.size, f) == h.size && Fnv1a(bytecode.data(), h.size) == h.check;
+    }
+    fclose(f);
+
+    std::error_code ec;
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (!ok) {
+        bytecode.clear();
+        ++mStats.corrupt;
+        fs::remove(path, ec);
+        auto it = mIndex.find(k);
+        if (it != mIndex.end()) { mBytes -= it->second.bytes; mIndex.erase(it); }
+        return false;
+    }
+
+    //  ð  (  LRU )
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+    Entry& e = mIndex[k];
+    if (e.bytes == 0) { e.bytes = sizeof(h) + h.size; mBytes += e.bytes; }
+    e.lastUse = ++mTick;
+    compileMs = h.compileMs;
+    return true;
+}
+
+void ShaderCache::Store(const Key& k, const std::vector<uint8_t>& bytecode, float compileMs)
+{
+    uint64_t n;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        n = ++mTmpCounter;
+    }
+    char suffix[48];
+    snprintf(suffix, sizeof(suffix), ".%016llx%llu.tmp", (unsigned long long)mTmpSalt, (unsigned long long)n);
+    const fs::path path = EntryPath(k);
+    fs::path tmp = path;
+    tmp += suffix;
+
+    EntryHeader h{};
+    h.magic = kEntryMagic; h.version = kEntryVersion;
+    h.keyA = k.a; h.keyB = k.b;
+    h.size = (uint32_t)bytecode.size();
+    h.compileMs = compileMs;
+    h.check = Fnv1a(bytecode.data(), bytecode.size());
+
+    FILE* f = OpenFile(tmp, true);
+    if (!f) return;
+    bool ok = fwrite(&h, sizeof(h), 1, f) == 1 && fwrite(bytecode.data(), 1, bytecode.size(), f) == bytecode.size();
+    if (fclose(f) != 0) ok = false;
+
+    std::error_code ec;
+    if (ok) fs::rename(tmp, path, ec);
+    if (!ok || ec) { fs::remove(tmp, ec); return; }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    Entry& e = mIndex[k];
+    mBytes -= e.bytes;
+    e.bytes = sizeof(h) + bytecode.size();
+    e.lastUse = ++mTick;
+    mBytes += e.bytes;
+    EvictLocked();
+}
+
+void ShaderCache::EvictLocked()
+{
+    //  ֱ ׸ ϳ  (Ѻ ū  ׸ Ź ٽ ϵ ʰ)
+    std::error_code ec;
+    while (mBytes > mMaxBytes && mIndex.size() > 1) {
+        auto victim = std::min_element(mIndex.begin(), mIndex.end(),
+            [](const auto& a, const auto& b) { return a.second.lastUse < b.second.lastUse; });
+        fs::remove(EntryPath(victim->first), ec);
+        mBytes -= victim->second.bytes;
+        mIndex.erase(victim);
+        ++mStats.evictions;
+    }
+}
@@ -0,0 +1,113 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// ̴  û (Ű   Է)
+struct ShaderDefine {
+    std::string name, value;
+};
+
+struct ShaderCompileDesc {
+    std::filesystem::path path;
+    std::string entry = "main";
+    std::string profile;                        // "vs_5_0", "ps_5_0" ...
+    std::vector<ShaderDefine> defines;
+    uint32_t flags = 0;                         // Ϸ ÷ (D3DCOMPILE_*)
+};
+
+struct ShaderCompileOutput {
+    std::vector<uint8_t> bytecode;
+    std::vector<std::filesystem::path> includes;    // ó   ()
+    std::string errors;
+    bool   cacheHit = false;
+    double ms = 0.0;                            // ó + (ȸ Ǵ )
+};
+
+// Ϸ 鿣 (D3DShaderCompiler,   ).  忡 ÿ Ҹ  ִ
+class ShaderCompiler {
+public:
+    virtual ~ShaderCompiler() = default;
+
+    // Ϸ / (Ű   Ϸ ٲ  ̽)
+    virtual const char* Identity() const = 0;
+
+    // #include  ģ ؽƮ +    
+    virtual bool Preprocess(const ShaderCompileDesc& d, std::string& text,
+                            std::vector<std::filesystem::path>& includes, std::string& errors) = 0;
+
+    // ó ؽƮ  Ʈڵ ( ؽƮ   ĳð )
+    virtual bool Compile(const ShaderCompileDesc& d, const std::string& text,
+                         std::vector<uint8_t>& bytecode, std::string& errors) = 0;
+
+    // Ʈڵ ɾ  ( 񱳿). 𸣸 0
+    virtual uint32_t InstructionCount(const std::vector<uint8_t>& bytecode) { (void)bytecode; return 0; }
+};
+
+struct ShaderCacheStats {
+    int    hits = 0, misses = 0, failures = 0;
+    int    evictions = 0, corrupt = 0;          // corrupt:  з  ׸
+    double compileMs = 0.0;                     // ̽   ð
+    double savedMs = 0.0;                       //  ׸ ó ϵ  ɸ ð 
+    double preprocessMs = 0.0;
+    size_t entries = 0, bytes = 0;
+};
+
+//  ؽ Ű Ʈڵ ũ ĳ
+// Ű = 128Ʈ ؽ(ó ؽƮ,   , define, entry, profile, flags, Ϸ Identity)
+// ׸ = <Ű hex>.bin ( + Ʈڵ). ӽ Ͽ  ̸ ٲٱ  ٸ /μ   ׸  
+// ũ       ׸  ( ð   ð    ڿ LRU)
+// Compile   (θ װ, ó/  )
+class ShaderCache {
+public:
+    struct Key {
+        uint64_t a = 0, b = 0;
+        bool operator==(const Key& o) const { return a == o.a && b == o.b; }
+    };
+
+    // dir  . ϸ ĳ  Ź  (false ȯ, Compile ״ )
+    bool Init(const std::filesystem::path& dir, size_t maxBytes, ShaderCompiler* compiler);
+    bool Enabled() const { return !mDir.empty(); }
+
+    bool Compile(const ShaderCompileDesc& d, ShaderCompileOutput& out);
+
+    void SetMaxBytes(size_t maxBytes);
+    size_t MaxBytes() const { return mMaxBytes; }
+    void Clear();                               // ׸   
+    void ResetCounters();
+    ShaderCacheStats Stats() const;
+
+    static Key MakeKey(const ShaderCompileDesc& d, const std::string& text,
+                       const std::vector<std::filesystem::path>& includes, const char* identity);
+    static std::string KeyName(const Key& k);  // 32ڸ hex
+
+private:
+    struct KeyHash {
+        size_t operator()(const Key& k) const { return (size_t)(k.a ^ (k.b * 0x9E3779B97F4A7C15ull)); }
+    };
+    struct Entry {
+        size_t   bytes = 0;                     //  ũ
+        uint64_t lastUse = 0;                   // LRU 
+    };
+
+    bool Load(const Key& k, std::vector<uint8_t>& bytecode, float& compileMs);
+    void Store(const Key& k, const std::vector<uint8_t>& bytecode, float compileMs);
+    void EvictLocked();
+    std::filesystem::path EntryPath(const Key& k) const;
+
+    ShaderCompiler* mCompiler = nullptr;
+    std::filesystem::path mDir;
+    size_t mMaxBytes = 64u << 20;
+
+    mutable std::mutex mMutex;
+    std::unordered_map<Key, Entry, KeyHash> mIndex;
+    uint64_t mTick = 0;
+    uint64_t mTmpSalt = 0;                      // ӽ  ̸ (μ )
+    uint64_t mTmpCounter = 0;
+    size_t   mBytes = 0;
+    ShaderCacheStats mStats;
+};
@@ -0,0 +1,95 @@
+#include "ShaderPermutation.h"
+#include "../utils/Parallel.h"
+#include "../utils/Profiler.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+
+ShaderPermutations::ShaderPermutations(std::vector<ShaderFeature> features)
+    : mFeatures(std::move(features))
+{
+    for (const ShaderFeature& f : mFeatures) {
+        uint32_t bits = 0;
+        while ((1u << bits) <= f.maxValue) ++bits;
+        mShift.push_back(mKeyBits);
+        mMask.push_back((1u << bits) - 1);
+        mKeyBits += bits;
+    }
+    assert(mKeyBits <= kMaxKeyBits);
+}
+
+uint32_t ShaderPermutations::Set(uint32_t key, size_t feature, uint32_t value) const
+{
+    value = std::min(value, mFeatures[feature].maxValue);
+    return (key & ~(mMask[feature] << mShift[feature])) | (value << mShift[feature]);
+}
+
+uint32_t ShaderPermutations::Get(uint32_t key, size_t feature) const
+{
+    return (key >> mShift[feature]) & mMask[feature];
+}
+
+bool ShaderPermutations::Valid(uint32_t key) const
+{
+    if (key >= KeySpace()) return false;
+    for (size_t i = 0; i < mFeatures.size(); ++i)
+        if (Get(key, i) > mFeatures[i].maxValue) return false;
+    return true;
+}
+
+std::vector<uint32_t> ShaderPermutations::AllKeys() const
+{
+    std::vector<uint32_t> keys;
+    for (uint32_t k = 0; k < KeySpace(); ++k)
+        if (Valid(k)) keys.push_back(k);
+    return keys;
+}
+
+void ShaderPermutations::Defines(uint32_t key, std::vector<ShaderDefine>& out) const
+{
+    for (size_t i = 0; i < mFeatures.size(); ++i)
+        out.push_back(ShaderDefine{ mFeatures[i].name, std::to_string(Get(key, i)) });
+}
+
+std::string ShaderPermutations::Describe(uint32_t key) const
+{
+    std::string s;
+    for (size_t i = 0; i < mFeatures.size(); ++i) {
+        if (!s.empty()) s += ' ';
+        s += mFeatures[i].name + '=' + std::to_string(Get(key, i));
+    }
+    return s.empty() ? "(base)" : s;
+}
+
+bool CompileShaderVariant(ShaderCache& cache, ShaderCompiler& compiler, const ShaderProgramDesc& d,
+                          const ShaderPermutations& perms, uint32_t key, ShaderVariantBytecode& out)
+{
+    JM_PROFILE_ZONE("Shader Variant");
+    const auto t0 = std::chrono::steady_clock::now();
+    out = {};
+    out.key = key;
+
+    ShaderCompileDesc vs, ps;
+    vs.path = d.vsPath; vs.entry = d.vsEntry; vs.profile = d.vsProfile; vs.flags = d.flags;
+    ps.path = d.psPath; ps.entry = d.psEntry; ps.profile = d.psProfile; ps.flags = d.flags;
+    perms.Defines(key, vs.defines);
+    ps.defines = vs.defines;
+
+    out.ok = cache.Compile(vs, out.vs) && cache.Compile(ps, out.ps);
+    if (out.ok) {
+        out.vsInstructions = compiler.InstructionCount(out.vs.bytecode);
+        out.psInstructions = compiler.InstructionCount(out.ps.bytecode);
+    }
+    out.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    return out.ok;
+}
+
+void CompileShaderVariants(ShaderCache& cache, ShaderCompiler& compiler, const ShaderProgramDesc& d,
+                           const ShaderPermutations& perms, const std::vector<uint32_t>& keys,
+                           std::vector<ShaderVariantBytecode>& out)
+{
+    out.assign(keys.size(), {});
+    Parallel::For(0, keys.size(), 1, [&](size_t b, size_t e) {
+        for (size_t i = b; i < e; ++i) CompileShaderVariant(cache, compiler, d, perms, keys[i], out[i]);
+    });
+}
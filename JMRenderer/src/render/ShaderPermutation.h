@@ -0,0 +1,68 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "ShaderCache.h"
+
+// ̴  : ̸  define (FOG=1, SPLAT_COUNT=2 ...)
+struct ShaderFeature {
+    std::string name;
+    uint32_t    maxValue = 1;                   // 1 = ѱ/, 3 = 0~3 (2Ʈ) ...
+};
+
+//    Ʈũ Ű.     ̾ δ (ù   Ʈ)
+// Ű ۾Ƽ ( 8Ʈ ̸)  ̺ Ű ٷ εѴ
+class ShaderPermutations {
+public:
+    static constexpr uint32_t kMaxKeyBits = 12;  //  ̺ 4096ĭ
+
+    ShaderPermutations() = default;
+    explicit ShaderPermutations(std::vector<ShaderFeature> features);
+
+    size_t   FeatureCount() const { return mFeatures.size(); }
+    const ShaderFeature& Feature(size_t i) const { return mFeatures[i]; }
+    uint32_t KeyBits() const { return mKeyBits; }
+    uint32_t KeySpace() const { return 1u << mKeyBits; }
+
+    // value maxValue ڸ
+    uint32_t Set(uint32_t key, size_t feature, uint32_t value) const;
+    uint32_t Get(uint32_t key, size_t feature) const;
+    bool     Valid(uint32_t key) const;         //    maxValue 
+    std::vector<uint32_t> AllKeys() const;
+
+    void        Defines(uint32_t key, std::vector<ShaderDefine>& out) const;
+    std::string Describe(uint32_t key) const;   // "FOG=1 SPLAT_COUNT=3"
+
+private:
+    std::vector<ShaderFeature> mFeatures;
+    std::vector<uint32_t> mShift, mMask;
+    uint32_t mKeyBits = 0;
+};
+
+// VS + PS   ( define ٸ)
+struct ShaderProgramDesc {
+    std::filesystem::path vsPath, psPath;
+    std::string vsEntry = "VSMain", psEntry = "PSMain";
+    std::string vsProfile = "vs_5_0", psProfile = "ps_5_0";
+    uint32_t    flags = 0;
+};
+
+struct ShaderVariantBytecode {
+    uint32_t key = 0;
+    bool     ok = false;
+    ShaderCompileOutput vs, ps;
+    uint32_t vsInstructions = 0, psInstructions = 0;
+    double   ms = 0.0;                          //  ܰ  (ĳ ̸ ó + ȸ)
+    bool     CacheHit() const { return vs.cacheHit && ps.cacheHit; }
+};
+
+//  ϳ Ʈڵ (D3D ü  ȣ ).   (cache  )
+bool CompileShaderVariant(ShaderCache& cache, ShaderCompiler& compiler, const ShaderProgramDesc& d,
+                          const ShaderPermutations& perms, uint32_t key, ShaderVariantBytecode& out);
+
+//    ھ ( ϳ = ۾ ϳ). out keys 
+void CompileShaderVariants(ShaderCache& cache, ShaderCompiler& compiler, const ShaderProgramDesc& d,
+                           const ShaderPermutations& perms, const std::vector<uint32_t>& keys,
+                           std::vector<ShaderVariantBytecode>& out);
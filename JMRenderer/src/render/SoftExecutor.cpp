@@ -0,0 +1,106 @@
+#include "SoftExecutor.h"
+#include <algorithm>
+
+using namespace Render;
+
+namespace {
+
+    template<class T>
+    const T* As(Handle h) { return static_cast<const T*>(h); }
+
+} // namespace
+
+void SoftExecutor::ApplyPipeline(const PipelineDesc& p)
+{
+    mCur.vs = As<Soft::VertexProgram>(p.vs);
+    mCur.ps = As<Soft::PixelProgram>(p.ps);
+    const Soft::RasterState* rs = As<Soft::RasterState>(p.rasterizer);
+    mCur.raster = rs ? *rs : Soft::RasterState{};
+}
+
+void SoftExecutor::ApplyMesh(const MeshDesc& m)
+{
+    mVB = As<Soft::Buffer>(m.vb);
+    mIB = As<Soft::Buffer>(m.ib);
+    mCur.stride = m.stride;
+    mCur.index16 = m.indexFormat == IndexFormat::U16;
+}
+
+void SoftExecutor::ApplyCBs(Stage s, int first, int count, const Handle* buffers)
+{
+    for (int i = 0; i < count; ++i) mCBs[(int)s][first + i] = As<Soft::Buffer>(buffers[i]);
+}
+
+void SoftExecutor::ApplySRVs(Stage s, int first, int count, const Handle* srvs)
+{
+    for (int i = 0; i < count; ++i) mCur.res.srv[(int)s][first + i] = As<Soft::Texture>(srvs[i]);
+}
+
+void SoftExecutor::ApplySamplers(Stage s, int first, int count, const Handle* samplers)
+{
+    for (int i = 0; i < count; ++i) mCur.res.sampler[(int)s][first + i] = As<Soft::Sampler>(samplers[i]);
+}
+
+void SoftExecutor::ApplyUpload(Handle buffer, const void* data, size_t bytes)
+{
+    Soft::Buffer* b = const_cast<Soft::Buffer*>(As<Soft::Buffer>(buffer));
+    const uint8_t* src = static_cast<const uint8_t*>(data);
+    b->bytes.assign(src, src + bytes);
+    //  ο ڱ   
+    mSnapshots.erase(std::remove_if(mSnapshots.begin(), mSnapshots.end(),
+        [&](const Snapshot& s) { return s.buffer == b; }), mSnapshots.end());
+}
+
+uint32_t SoftExecutor::SnapshotOf(const Soft::Buffer* b)
+{
+    for (const Snapshot& s : mSnapshots)
+        if (s.buffer == b) return s.offset;
+    // 16Ʈ  (̴  float б)
+    const uint32_t offset = (uint32_t)((mArena.size() + 15) & ~size_t(15));
+    mArena.resize(offset + b->bytes.size());
+    std::copy(b->bytes.begin(), b->bytes.end(), mArena.begin() + offset);
+    mSnapshots.push_back({ b, offset });
+    return offset;
+}
+
+void SoftExecutor::ApplyDrawIndexed(uint32_t indexCount, uint32_t startIndex, int32_t baseVertex)
+{
+    if (!mIB) return;
+    Soft::DrawCall dc = mCur;
+    dc.vertices = mVB ? mVB->bytes.data() : nullptr;
+    dc.indices = mIB->bytes.data();
+    dc.indexCount = indexCount;
+    dc.startIndex = startIndex;
+    dc.baseVertex = baseVertex;
+    // ε   ο  (GPU ǵ  )
+    const size_t indexBytes = dc.index16 ? 2 : 4;
+    if ((size_t)(startIndex + indexCount) * indexBytes > mIB->bytes.size()) return;
+
+    for (int s = 0; s < kStages; ++s)
+        for (int i = 0; i < kMaxCBs; ++i)
+            mPendingCB.push_back(mCBs[s][i] ? SnapshotOf(mCBs[s][i]) : ~0u);
+    mPending.push_back(dc);
+}
+
+void SoftExecutor::EndSubmit()
+{
+    // Ʒ Ҵ     
+    if (mTarget) {
+        mRaster.Begin(*mTarget);
+        for (size_t d = 0; d < mPending.size(); ++d) {
+            Soft::DrawCall& dc = mPending[d];
+            const uint32_t* off = &mPendingCB[d * kStages * kMaxCBs];
+            for (int s = 0; s < kStages; ++s)
+                for (int i = 0; i < kMaxCBs; ++i) {
+                    const uint32_t o = off[s * kMaxCBs + i];
+                    dc.res.cb[s][i] = o == ~0u ? nullptr : mArena.data() + o;
+                }
+            mRaster.Draw(dc);
+        }
+        mRaster.Flush(mPath, mParallel);
+    }
+    mPending.clear();
+    mPendingCB.clear();
+    mArena.clear();
+    mSnapshots.clear();
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <vector>
+#include "CommandList.h"
+#include "SoftRaster.h"
+
+// Ŀǵ Ʈ CPU Ͷ  (帮 ,  ̹)
+// Handle: VS/PS = Soft::VertexProgram*/PixelProgram*,   = Soft::RasterState*,
+//          = Soft::Buffer*, SRV = Soft::Texture*, ÷ = Soft::Sampler*, Է ̾ƿ 񱳿 ǥ
+// ο       ΰ Submit (EndSubmit) Ѳ Ѵ
+class SoftExecutor : public Render::CommandExecutor {
+public:
+    void SetTarget(Soft::Target* target) { mTarget = target; }
+    void SetPath(Soft::Path path) { mPath = path; }
+    void SetParallel(bool on) { mParallel = on; }
+
+    const Soft::FrameStats& RasterStats() const { return mRaster.Stats(); }
+
+protected:
+    void ApplyPipeline(const Render::PipelineDesc& p) override;
+    void ApplyMesh(const Render::MeshDesc& m) override;
+    void ApplyCBs(Render::Stage s, int first, int count, const Render::Handle* buffers) override;
+    void ApplySRVs(Render::Stage s, int first, int count, const Render::Handle* srvs) override;
+    void ApplySamplers(Render::Stage s, int first, int count, const Render::Handle* samplers) override;
+    void ApplyUpload(Render::Handle buffer, const void* data, size_t bytes) override;
+    void ApplyDrawIndexed(uint32_t indexCount, uint32_t startIndex, int32_t baseVertex) override;
+    void EndSubmit() override;
+
+private:
+    //    ġ (ε  ο쳢 )
+    struct Snapshot {
+        const Soft::Buffer* buffer;
+        uint32_t offset;
+    };
+    uint32_t SnapshotOf(const Soft::Buffer* b);
+
+    Soft::Target* mTarget = nullptr;
+    Soft::Path mPath = Soft::Path::Auto;
+    bool mParallel = true;
+    Soft::Rasterizer mRaster;
+
+    Soft::DrawCall mCur;                            //  ε (res.cb Ʒ mCBs)
+    const Soft::Buffer* mVB = nullptr;
+    const Soft::Buffer* mIB = nullptr;
+    const Soft::Buffer* mCBs[Render::kStages][Render::kMaxCBs] = {};
+
+    std::vector<Soft::DrawCall> mPending;
+    std::vector<uint32_t> mPendingCB;               // ο [kStages * kMaxCBs] Ʒ  (~0 = )
+    std::vector<uint8_t> mArena;
+    std::vector<Snapshot> mSnapshots;
+};
@@ -0,0 +1,548 @@
+#include "SoftRaster.h"
+#include "../utils/Parallel.h"
+#include "../utils/Profiler.h"
+#include "../utils/Simd.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+    double MsSince(std::chrono::steady_clock::time_point t0)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    }
+
+    int WrapI(int i, int n) { i %= n; return i < 0 ? i + n : i; }
+
+    uint8_t ToUnorm8(float v)
+    {
+        v = std::min(std::max(v, 0.0f), 1.0f);
+        return (uint8_t)(v * 255.0f + 0.5f);
+    }
+
+    // Ŭ     (near  Ŭ)
+    Soft::ClipVertex Lerp(const Soft::ClipVertex& a, const Soft::ClipVertex& b, float t, int nvar)
+    {
+        Soft::ClipVertex r;
+        for (int i = 0; i < 4; ++i) r.pos[i] = a.pos[i] + (b.pos[i] - a.pos[i]) * t;
+        for (int i = 0; i < nvar; ++i) r.var[i] = a.var[i] + (b.var[i] - a.var[i]) * t;
+        return r;
+    }
+
+    // ȭ   (1/256 ȼ )
+    struct ScreenVertex {
+        float x, y, z, invW;
+        const Soft::ClipVertex* clip;
+    };
+
+    //  ȼ ̵ ( , Į)
+    struct ShadeCtx {
+        const Soft::Rasterizer::Tri* t;
+        const Soft::DrawCall* dc;
+        int nvar;
+        uint32_t* colorRow;
+        float* depthRow;
+    };
+
+    void ShadeLanes(const ShadeCtx& s, int x0, float cy, uint32_t mask, const float* z)
+    {
+        const Soft::Rasterizer::Tri& t = *s.t;
+        float var[Soft::kMaxVaryings];
+        while (mask) {
+            const int i = Simd::Ctz32(mask);
+            mask &= mask - 1;
+            const int x = x0 + i;
+            const float cx = (float)x + 0.5f;
+            const float oneOverW = (t.w[0] * cx + t.w[1] * cy) + t.w[2];
+            const float w = 1.0f / oneOverW;
+            for (int k = 0; k < s.nvar; ++k)
+                var[k] = ((t.var[k][0] * cx + t.var[k][1] * cy) + t.var[k][2]) * w;
+            s.colorRow[x] = s.dc->ps->fn(s.dc->res, var, t.uvPerPixel);
+            s.depthRow[x] = z[i];
+        }
+    }
+
+    struct TileCounters { size_t shaded = 0, rejected = 0; };
+
+    bool Covered(const Soft::Rasterizer::Tri& t, int k, float cx, float cy)
+    {
+        const float e = (t.e[k][0] * cx + t.e[k][1] * cy) + t.e[k][2];
+        return t.topLeft[k] ? e >= 0.0f : e > 0.0f;
+    }
+
+    void RasterRowsScalar(const ShadeCtx& base, const Soft::Target& tg, int rx0, int rx1, int ry0, int ry1, TileCounters& c)
+    {
+        const Soft::Rasterizer::Tri& t = *base.t;
+        for (int y = ry0; y <= ry1; ++y) {
+            ShadeCtx s = base;
+            s.colorRow = const_cast<uint32_t*>(tg.color.data()) + (size_t)y * tg.pitch;
+            s.depthRow = const_cast<float*>(tg.depth.data()) + (size_t)y * tg.pitch;
+            const float cy = (float)y + 0.5f;
+            for (int x = rx0; x <= rx1; ++x) {
+                const float cx = (float)x + 0.5f;
+                if (!Covered(t, 0, cx, cy) || !Covered(t, 1, cx, cy) || !Covered(t, 2, cx, cy)) continue;
+                const float z = (t.z[0] * cx + t.z[1] * cy) + t.z[2];
+                if (!(z < s.depthRow[x])) { ++c.rejected; continue; }
+                ShadeLanes(s, x, cy, 1u, &z);
+                ++c.shaded;
+            }
+        }
+    }
+
+#if JM_SIMD_X86
+    JM_TARGET_SSE41
+    void RasterRowsSSE41(const ShadeCtx& base, const Soft::Target& tg, int rx0, int rx1, int ry0, int ry1, TileCounters& c)
+    {
+        const Soft::Rasterizer::Tri& t = *base.t;
+        const __m128 lane = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+        __m128 ea[3], ec[3];
+        for (int k = 0; k < 3; ++k) { ea[k] = _mm_set1_ps(t.e[k][0]); ec[k] = _mm_set1_ps(t.e[k][2]); }
+        const __m128 za = _mm_set1_ps(t.z[0]), zc = _mm_set1_ps(t.z[2]);
+        const int xa = rx0 & ~3;
+        alignas(16) float z[4];
+        for (int y = ry0; y <= ry1; ++y) {
+            ShadeCtx s = base;
+            s.colorRow = const_cast<uint32_t*>(tg.color.data()) + (size_t)y * tg.pitch;
+            s.depthRow = const_cast<float*>(tg.depth.data()) + (size_t)y * tg.pitch;
+            const float cy = (float)y + 0.5f;
+            const __m128 zy = _mm_set1_ps(t.z[1] * cy);
+            for (int x = xa; x <= rx1; x += 4) {
+                const __m128 cx = _mm_add_ps(_mm_set1_ps((float)x + 0.5f), lane);
+                __m128 in = _mm_and_ps(_mm_cmpge_ps(cx, _mm_set1_ps((float)rx0)), _mm_cmple_ps(cx, _mm_set1_ps((float)rx1 + 0.5f)));
+                for (int k = 0; k < 3; ++k) {
+                    const __m128 e = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ea[k], cx), _mm_set1_ps(t.e[k][1] * cy)), ec[k]);
+                    in = _mm_and_ps(in, t.topLeft[k] ? _mm_cmpge_ps(e, _mm_setzero_ps()) : _mm_cmpgt_ps(e, _mm_setzero_ps()));
+                }
+                const int cover = _mm_movemask_ps(in);
+                if (!cover) continue;
+                const __m128 zv = _mm_add_ps(_mm_add_ps(_mm_mul_ps(za, cx), zy), zc);
+                const int pass = _mm_movemask_ps(_mm_and_ps(in, _mm_cmplt_ps(zv, _mm_loadu_ps(s.depthRow + x))));
+                c.rejected += (size_t)Simd::Popcount32((uint32_t)(cover & ~pass));
+                if (!pass) continue;
+                _mm_store_ps(z, zv);
+                ShadeLanes(s, x, cy, (uint32_t)pass, z);
+                c.shaded += (size_t)Simd::Popcount32((uint32_t)pass);
+            }
+        }
+    }
+
+    JM_TARGET_AVX2
+    void RasterRowsAVX2(const ShadeCtx& base, const Soft::Target& tg, int rx0, int rx1, int ry0, int ry1, TileCounters& c)
+    {
+        const Soft::Rasterizer::Tri& t = *base.t;
+        const __m256 lane = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+        __m256 ea[3], ec[3];
+        for (int k = 0; k < 3; ++k) { ea[k] = _mm256_set1_ps(t.e[k][0]); ec[k] = _mm256_set1_ps(t.e[k][2]); }
+        const __m256 za = _mm256_set1_ps(t.z[0]), zc = _mm256_set1_ps(t.z[2]);
+        const int xa = rx0 & ~7;
+        alignas(32) float z[8];
+        for (int y = ry0; y <= ry1; ++y) {
+            ShadeCtx s = base;
+            s.colorRow = const_cast<uint32_t*>(tg.color.data()) + (size_t)y * tg.pitch;
+            s.depthRow = const_cast<float*>(tg.depth.data()) + (size_t)y * tg.pitch;
+            const float cy = (float)y + 0.5f;
+            const __m256 zy = _mm256_set1_ps(t.z[1] * cy);
+            for (int x = xa; x <= rx1; x += 8) {
+                const __m256 cx = _mm256_add_ps(_mm256_set1_ps((float)x + 0.5f), lane);
+                __m256 in = _mm256_and_ps(_mm256_cmp_ps(cx, _mm256_set1_ps((float)rx0), _CMP_GE_OQ),
+                    _mm256_cmp_ps(cx, _mm256_set1_ps((float)rx1 + 0.5f), _CMP_LE_OQ));
+                for (int k = 0; k < 3; ++k) {
+                    const __m256 e = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ea[k], cx), _mm256_set1_ps(t.e[k][1] * cy)), ec[k]);
+                    in = _mm256_and_ps(in, t.topLeft[k] ? _mm256_cmp_ps(e, _mm256_setzero_ps(), _CMP_GE_OQ)
+                                                        : _mm256_cmp_ps(e, _mm256_setzero_ps(), _CMP_GT_OQ));
+                }
+                const int cover = _mm256_movemask_ps(in);
+                if (!cover) continue;
+                const __m256 zv = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(za, cx), zy), zc);
+                const int pass = _mm256_movemask_ps(_mm256_and_ps(in, _mm256_cmp_ps(zv, _mm256_loadu_ps(s.depthRow + x), _CMP_LT_OQ)));
+                c.rejected += (size_t)Simd::Popcount32((uint32_t)(cover & ~pass));
+                if (!pass) continue;
+                _mm256_store_ps(z, zv);
+                ShadeLanes(s, x, cy, (uint32_t)pass, z);
+                c.shaded += (size_t)Simd::Popcount32((uint32_t)pass);
+            }
+        }
+    }
+#endif
+
+} // namespace
+
+namespace Soft {
+
+    Path Resolve(Path path)
+    {
+#if JM_SIMD_X86
+        const Simd::CpuFeatures& f = Simd::Cpu();
+        if (path == Path::Auto) return f.avx2 ? Path::AVX2 : (f.sse41 ? Path::SSE41 : Path::Scalar);
+        if (path == Path::AVX2 && !f.avx2) return f.sse41 ? Path::SSE41 : Path::Scalar;
+        if (path == Path::SSE41 && !f.sse41) return Path::Scalar;
+        return path;
+#else
+        (void)path;
+        return Path::Scalar;
+#endif
+    }
+
+    const char* PathName(Path path)
+    {
+        switch (path) {
+        case Path::Scalar: return "Scalar";
+        case Path::SSE41:  return "SSE4.1";
+        case Path::AVX2:   return "AVX2";
+        default:           return "Auto";
+        }
+    }
+
+    //  Texture 
+
+    bool Texture::Init(const uint8_t* src, unsigned w, unsigned h, size_t rowPitch, unsigned channels, MipFilter mips)
+    {
+        if (!src || w == 0 || h == 0 || (channels != 1 && channels != 4)) return false;
+        const size_t pitch = (size_t)w * channels;
+        mBase.resize(pitch * h);
+        for (unsigned y = 0; y < h; ++y) memcpy(mBase.data() + y * pitch, src + y * rowPitch, pitch);
+        Mip::Build(mBase.data(), w, h, pitch, channels, mips, mChain);
+        return !mChain.levels.empty();
+    }
+
+    void Texture::InitSolid(const uint8_t rgba[4])
+    {
+        Init(rgba, 1, 1, 4, 4, MipFilter::None);
+    }
+
+    void Texture::SampleLevel(int level, float u, float v, bool linear, float out[4]) const
+    {
+        const MipLevel& l = mChain.levels[level];
+        const int w = (int)l.width, h = (int)l.height, ch = (int)mChain.channels;
+        auto texel = [&](int x, int y, float* o) {
+            const uint8_t* p = l.data + (size_t)WrapI(y, h) * l.rowPitch + (size_t)WrapI(x, w) * ch;
+            for (int c = 0; c < ch; ++c) o[c] = p[c] * (1.0f / 255.0f);
+        };
+        if (!linear) { texel((int)std::floor(u * w), (int)std::floor(v * h), out); return; }
+
+        const float fx = u * w - 0.5f, fy = v * h - 0.5f;
+        const float x0f = std::floor(fx), y0f = std::floor(fy);
+        const float tx = fx - x0f, ty = fy - y0f;
+        const int x0 = (int)x0f, y0 = (int)y0f;
+        float a[4], b[4], c[4], d[4];
+        texel(x0, y0, a); texel(x0 + 1, y0, b);
+        texel(x0, y0 + 1, c); texel(x0 + 1, y0 + 1, d);
+        for (int i = 0; i < ch; ++i) {
+            const float top = a[i] + (b[i] - a[i]) * tx;
+            const float bot = c[i] + (d[i] - c[i]) * tx;
+            out[i] = top + (bot - top) * ty;
+        }
+    }
+
+    void Texture::Sample(float u, float v, float lod, bool linear, float out[4]) const
+    {
+        out[0] = out[1] = out[2] = 0.0f; out[3] = 1.0f;
+        if (mChain.levels.empty()) return;
+        const int last = (int)mChain.levels.size() - 1;
+        lod = std::min(std::max(lod, 0.0f), (float)last);
+        if (!linear) { SampleLevel((int)(lod + 0.5f), u, v, false, out); return; }
+
+        const int l0 = (int)lod;
+        const float t = lod - (float)l0;
+        SampleLevel(l0, u, v, true, out);
+        if (t > 0.0f && l0 < last) {
+            float o1[4];
+            SampleLevel(l0 + 1, u, v, true, o1);
+            for (unsigned i = 0; i < mChain.channels; ++i) out[i] += (o1[i] - out[i]) * t;
+        }
+    }
+
+    //  Target 
+
+    void Target::Resize(int w, int h)
+    {
+        width = std::max(w, 1);
+        height = std::max(h, 1);
+        pitch = (width + kTileSize - 1) / kTileSize * kTileSize;
+        color.assign((size_t)pitch * height, 0);
+        depth.assign((size_t)pitch * height, 1.0f);
+    }
+
+    void Target::Clear(const float rgba[4], float z)
+    {
+        const uint32_t c = ToUnorm8(rgba[0]) | (ToUnorm8(rgba[1]) << 8) | (ToUnorm8(rgba[2]) << 16) | ((uint32_t)ToUnorm8(rgba[3]) << 24);
+        std::fill(color.begin(), color.end(), c);
+        std::fill(depth.begin(), depth.end(), z);
+    }
+
+    bool Target::WriteBMP(const std::filesystem::path& path) const
+    {
+        const uint32_t rowBytes = ((uint32_t)width * 3 + 3u) & ~3u;
+        const uint32_t imageBytes = rowBytes * (uint32_t)height;
+        uint8_t hdr[54] = {};
+        auto put16 = [&](int o, uint32_t v) { hdr[o] = (uint8_t)v; hdr[o + 1] = (uint8_t)(v >> 8); };
+        auto put32 = [&](int o, uint32_t v) { put16(o, v & 0xFFFF); put16(o + 2, v >> 16); };
+        put16(0, 0x4D42);
+        put32(2, 54 + imageBytes);
+        put32(10, 54);
+        put32(14, 40);
+        put32(18, (uint32_t)width);
+        put32(22, (uint32_t)height);       //  = bottom-up
+        put16(26, 1);
+        put16(28, 24);
+        put32(34, imageBytes);
+
+        FILE* f = nullptr;
+#if defined(_MSC_VER)
+        if (_wfopen_s(&f, path.c_str(), L"wb") != 0) f = nullptr;
+#else
+        f = fopen(path.c_str(), "wb");
+#endif
+        if (!f) return false;
+        bool ok = fwrite(hdr, 1, sizeof(hdr), f) == sizeof(hdr);
+        std::vector<uint8_t> row(rowBytes, 0);
+        for (int y = height - 1; y >= 0 && ok; --y) {
+            const uint32_t* src = color.data() + (size_t)y * pitch;
+            for (int x = 0; x < width; ++x) {
+                row[x * 3 + 0] = (uint8_t)(src[x] >> 16);   // B
+                row[x * 3 + 1] = (uint8_t)(src[x] >> 8);    // G
+                row[x * 3 + 2] = (uint8_t)(src[x]);         // R
+            }
+            ok = fwrite(row.data(), 1, rowBytes, f) == rowBytes;
+        }
+        fclose(f);
+        return ok;
+    }
+
+    //  Rasterizer 
+
+    void Rasterizer::Begin(Target& target)
+    {
+        mTarget = &target;
+        mDraws.clear();
+        mStats = {};
+    }
+
+    void Rasterizer::Draw(const DrawCall& dc)
+    {
+        if (!mTarget || !dc.vs || !dc.vs->fn || !dc.ps || !dc.ps->fn || !dc.indices || dc.indexCount < 3) return;
+        if (dc.stride != 0 && !dc.vertices) return;
+        mDraws.push_back(dc);
+    }
+
+    void Rasterizer::SetupDraw(uint32_t drawIndex, std::vector<Tri>& out, FrameStats& st) const
+    {
+        const DrawCall& dc = mDraws[drawIndex];
+        const int nvar = std::min(dc.vs->varyings, kMaxVaryings);
+        const float W = (float)mTarget->width, H = (float)mTarget->height;
+        out.clear();
+
+        auto index = [&](uint32_t i) -> int64_t {
+            const uint32_t raw = dc.index16 ? ((const uint16_t*)dc.indices)[dc.startIndex + i]
+                                            : ((const uint32_t*)dc.indices)[dc.startIndex + i];
+            return (int64_t)raw + dc.baseVertex;
+        };
+
+        // ϴ   VS 
+        int64_t lo = INT64_MAX, hi = -1;
+        const uint32_t count = dc.indexCount / 3 * 3;
+        for (uint32_t i = 0; i < count; ++i) { const int64_t v = index(i); lo = std::min(lo, v); hi = std::max(hi, v); }
+        if (hi < 0 || lo < 0) return;
+        std::vector<ClipVertex> verts((size_t)(hi - lo + 1));
+        for (int64_t v = lo; v <= hi; ++v) {
+            const uint8_t* src = dc.stride ? dc.vertices + (size_t)v * dc.stride : nullptr;
+            dc.vs->fn(dc.res, (uint32_t)v, src, verts[(size_t)(v - lo)]);
+        }
+        st.vertices += verts.size();
+
+        auto emit = [&](const ClipVertex* c0, const ClipVertex* c1, const ClipVertex* c2) {
+            ScreenVertex s[3];
+            const ClipVertex* cv[3] = { c0, c1, c2 };
+            for (int k = 0; k < 3; ++k) {
+                const float iw = 1.0f / cv[k]->pos[3];
+                s[k].x = std::round((cv[k]->pos[0] * iw * 0.5f + 0.5f) * W * 256.0f) * (1.0f / 256.0f);
+                s[k].y = std::round((0.5f - cv[k]->pos[1] * iw * 0.5f) * H * 256.0f) * (1.0f / 256.0f);
+                s[k].z = cv[k]->pos[2] * iw;
+                s[k].invW = iw;
+                s[k].clip = cv[k];
+            }
+            float det = (s[1].x - s[0].x) * (s[2].y - s[0].y) - (s[2].x - s[0].x) * (s[1].y - s[0].y);
+            // ȭ y Ʒ  det > 0 ð  (D3D ⺻ ո)
+            if (det == 0.0f ||
+                (dc.raster.cull == CullMode::Back && det < 0.0f) ||
+                (dc.raster.cull == CullMode::Front && det > 0.0f)) { ++st.culled; return; }
+            if (det < 0.0f) { std::swap(s[1], s[2]); det = -det; }
+
+            Tri t;
+            const float minXf = std::min({ s[0].x, s[1].x, s[2].x }), maxXf = std::max({ s[0].x, s[1].x, s[2].x });
+            const float minYf = std::min({ s[0].y, s[1].y, s[2].y }), maxYf = std::max({ s[0].y, s[1].y, s[2].y });
+            t.minX = std::max(0, (int)std::ceil(minXf - 0.5f));
+            t.maxX = std::min(mTarget->width - 1, (int)std::floor(maxXf - 0.5f));
+            t.minY = std::max(0, (int)std::ceil(minYf - 0.5f));
+            t.maxY = std::min(mTarget->height - 1, (int)std::floor(maxYf - 0.5f));
+            if (t.minX > t.maxX || t.minY > t.maxY) { ++st.culled; return; }
+
+            //  k =  k  (i  j)
+            for (int k = 0; k < 3; ++k) {
+                const ScreenVertex& a = s[(k + 1) % 3];
+                const ScreenVertex& b = s[(k + 2) % 3];
+                const float A = a.y - b.y, B = b.x - a.x;
+                t.e[k][0] = A;
+                t.e[k][1] = B;
+                t.e[k][2] = a.x * b.y - b.x * a.y;
+                t.topLeft[k] = A > 0.0f || (A == 0.0f && B > 0.0f);
+            }
+
+            const float invDet = 1.0f / det;
+            auto plane = [&](float f0, float f1, float f2, float* p) {
+                const float dx = ((f1 - f0) * (s[2].y - s[0].y) - (f2 - f0) * (s[1].y - s[0].y)) * invDet;
+                const float dy = ((f2 - f0) * (s[1].x - s[0].x) - (f1 - f0) * (s[2].x - s[0].x)) * invDet;
+                p[0] = dx; p[1] = dy; p[2] = f0 - dx * s[0].x - dy * s[0].y;
+            };
+            plane(s[0].z, s[1].z, s[2].z, t.z);
+            plane(s[0].invW, s[1].invW, s[2].invW, t.w);
+            for (int i = 0; i < nvar; ++i)
+                plane(s[0].clip->var[i] * s[0].invW, s[1].clip->var[i] * s[1].invW, s[2].clip->var[i] * s[2].invW, t.var[i]);
+
+            t.uvPerPixel = 0.0f;
+            if (dc.vs->lodVarying >= 0 && dc.vs->lodVarying + 1 < nvar) {
+                const int u = dc.vs->lodVarying;
+                const float uvArea = std::fabs(
+                    (s[1].clip->var[u] - s[0].clip->var[u]) * (s[2].clip->var[u + 1] - s[0].clip->var[u + 1]) -
+                    (s[2].clip->var[u] - s[0].clip->var[u]) * (s[1].clip->var[u + 1] - s[0].clip->var[u + 1]));
+                t.uvPerPixel = std::sqrt(uvArea * invDet);
+            }
+            t.draw = drawIndex;
+            out.push_back(t);
+        };
+
+        for (uint32_t i = 0; i < count; i += 3) {
+            ++st.triangles;
+            const ClipVertex* v[3] = {
+                &verts[(size_t)(index(i) - lo)], &verts[(size_t)(index(i + 1) - lo)], &verts[(size_t)(index(i + 2) - lo)] };
+
+            // ȭ  ڸ  (  ٱ   )
+            auto allOut = [&](auto&& outside) { return outside(*v[0]) && outside(*v[1]) && outside(*v[2]); };
+            if (allOut([](const ClipVertex& c) { return c.pos[0] < -c.pos[3]; }) ||
+                allOut([](const ClipVertex& c) { return c.pos[0] > c.pos[3]; }) ||
+                allOut([](const ClipVertex& c) { return c.pos[1] < -c.pos[3]; }) ||
+                allOut([](const ClipVertex& c) { return c.pos[1] > c.pos[3]; }) ||
+                allOut([](const ClipVertex& c) { return c.pos[2] > c.pos[3]; }) ||
+                allOut([](const ClipVertex& c) { return c.pos[2] < 0.0f; })) { ++st.culled; continue; }
+
+            const bool in0 = v[0]->pos[2] >= 0.0f, in1 = v[1]->pos[2] >= 0.0f, in2 = v[2]->pos[2] >= 0.0f;
+            if (in0 && in1 && in2) { emit(v[0], v[1], v[2]); continue; }
+
+            // near (z = 0) Ŭ  ִ 簢  ä ﰢ 2
+            ++st.clipped;
+            ClipVertex poly[4];
+            int n = 0;
+            for (int k = 0; k < 3; ++k) {
+                const ClipVertex& a = *v[k];
+                const ClipVertex& b = *v[(k + 1) % 3];
+                const bool ia = a.pos[2] >= 0.0f, ib = b.pos[2] >= 0.0f;
+                if (ia) poly[n++] = a;
+                if (ia != ib) poly[n++] = Lerp(a, b, a.pos[2] / (a.pos[2] - b.pos[2]), nvar);
+            }
+            for (int k = 1; k + 1 < n; ++k) emit(&poly[0], &poly[k], &poly[k + 1]);
+        }
+        st.setupTris += out.size();
+    }
+
+    void Rasterizer::RasterTile(int tile, Path path, FrameStats& st)
+    {
+        const int tx0 = (tile % mTilesX) * kTileSize, ty0 = (tile / mTilesX) * kTileSize;
+        const int tx1 = std::min(tx0 + kTileSize, mTarget->width) - 1;
+        const int ty1 = std::min(ty0 + kTileSize, mTarget->height) - 1;
+        TileCounters c;
+        for (uint32_t ti : mBins[tile]) {
+            const Tri& t = *mTris[ti];
+            const int rx0 = std::max(t.minX, tx0), rx1 = std::min(t.maxX, tx1);
+            const int ry0 = std::max(t.minY, ty0), ry1 = std::min(t.maxY, ty1);
+            if (rx0 > rx1 || ry0 > ry1) continue;
+            ShadeCtx s;
+            s.t = &t;
+            s.dc = &mDraws[t.draw];
+            s.nvar = std::min(s.dc->vs->varyings, kMaxVaryings);
+            s.colorRow = nullptr;
+            s.depthRow = nullptr;
+            switch (path) {
+#if JM_SIMD_X86
+            case Path::AVX2:  RasterRowsAVX2(s, *mTarget, rx0, rx1, ry0, ry1, c); break;
+            case Path::SSE41: RasterRowsSSE41(s, *mTarget, rx0, rx1, ry0, ry1, c); break;
+#endif
+            default:          RasterRowsScalar(s, *mTarget, rx0, rx1, ry0, ry1, c); break;
+            }
+        }
+        st.pixelsShaded += c.shaded;
+        st.depthRejected += c.rejected;
+    }
+
+    const FrameStats& Rasterizer::Flush(Path path, bool parallel)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        mStats = {};
+        if (!mTarget) return mStats;
+        path = Resolve(path);
+        mStats.draws = mDraws.size();
+
+        // 1) ο캰 VS + ¾ (ο  ,  ο  )
+        mDrawTris.resize(mDraws.size());
+        std::atomic<size_t> vertices{ 0 }, triangles{ 0 }, culled{ 0 }, clipped{ 0 }, setupTris{ 0 };
+        auto setup = [&](size_t b, size_t e) {
+            JM_PROFILE_ZONE("Soft Setup");
+            FrameStats st;
+            for (size_t d = b; d < e; ++d) SetupDraw((uint32_t)d, mDrawTris[d], st);
+            vertices += st.vertices; triangles += st.triangles; culled += st.culled;
+            clipped += st.clipped; setupTris += st.setupTris;
+        };
+        if (parallel) Parallel::For(0, mDraws.size(), 4, setup);
+        else setup(0, mDraws.size());
+        mStats.vertices = vertices; mStats.triangles = triangles; mStats.culled = culled;
+        mStats.clipped = clipped; mStats.setupTris = setupTris;
+        mStats.setupMs = MsSince(t0);
+
+        // 2)  (    Ÿ ȿ ο/ﰢ )
+        auto t1 = std::chrono::steady_clock::now();
+        {
+            JM_PROFILE_ZONE("Soft Bin");
+            mTilesX = (mTarget->width + kTileSize - 1) / kTileSize;
+            mTilesY = (mTarget->height + kTileSize - 1) / kTileSize;
+            mStats.tiles = mTilesX * mTilesY;
+            mBins.resize(mStats.tiles);
+            for (auto& b : mBins) b.clear();
+            mTris.clear();
+            for (const auto& tris : mDrawTris) {
+                for (const Tri& t : tris) {
+                    const uint32_t ti = (uint32_t)mTris.size();
+                    mTris.push_back(&t);
+                    for (int ty = t.minY / kTileSize; ty <= t.maxY / kTileSize; ++ty)
+                        for (int tx = t.minX / kTileSize; tx <= t.maxX / kTileSize; ++tx) {
+                            mBins[ty * mTilesX + tx].push_back(ti);
+                            ++mStats.binRefs;
+                        }
+                }
+            }
+        }
+        mStats.binMs = MsSince(t1);
+
+        // 3) Ÿ  (Ÿϳ ġ Ƿ  )
+        auto t2 = std::chrono::steady_clock::now();
+        std::atomic<size_t> shaded{ 0 }, rejected{ 0 };
+        auto raster = [&](size_t b, size_t e) {
+            JM_PROFILE_ZONE("Soft Raster");
+            FrameStats st;
+            for (size_t tile = b; tile < e; ++tile) RasterTile((int)tile, path, st);
+            shaded += st.pixelsShaded; rejected += st.depthRejected;
+        };
+        if (parallel) Parallel::For(0, (size_t)mStats.tiles, 1, raster);
+        else raster(0, (size_t)mStats.tiles);
+        mStats.pixelsShaded = shaded;
+        mStats.depthRejected = rejected;
+        mStats.rasterMs = MsSince(t2);
+
+        mDraws.clear();
+        mStats.totalMs = MsSince(t0);
+        return mStats;
+    }
+
+} // namespace Soft
@@ -0,0 +1,158 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+#include "../utils/MipChain.h"
+
+// CPU Ÿ Ͷ (D3D  , 帮 / ̹)
+// Draw ϸ ϰ Flush: ο캰 VS + ﰢ ¾()  64x64 Ÿ   ŸϺ ()
+// Ŀ/̴ SIMD 4/8ȼ, ̵  ȼ Į.  /  ϰ 
+// Ծ D3D11 : Ŭ  0 <= z <= w, ȼ ߽ (x+0.5, y+0.5), top-left Ģ, ð  = ո, LESS 
+namespace Soft {
+
+    constexpr int kMaxVaryings = 8;
+    constexpr int kTileSize = 64;
+
+    enum class Path { Auto, Scalar, SSE41, AVX2 };  // Ŀ/ ׽Ʈ : 1 / 4 / 8
+    Path Resolve(Path path);
+    const char* PathName(Path path);
+
+    // RGBA8 Ǵ R8 ؽó + ü (ּ  WRAP, GPU ÷ )
+    //  0 mBase ŰǷ   (̵ ۰ ״ζ )
+    class Texture {
+    public:
+        Texture() = default;
+        Texture(const Texture&) = delete;
+        Texture& operator=(const Texture&) = delete;
+        Texture(Texture&&) = default;
+        Texture& operator=(Texture&&) = default;
+
+        // src Ѵ. mips == None̸  0
+        bool Init(const uint8_t* src, unsigned w, unsigned h, size_t rowPitch, unsigned channels, MipFilter mips);
+        // ܻ 1x1 (ε   ü)
+        void InitSolid(const uint8_t rgba[4]);
+
+        // 0~1  (R8 out[0]). linear: ̸Ͼ +    (MIN_MAG_MIP_LINEAR)
+        void Sample(float u, float v, float lod, bool linear, float out[4]) const;
+
+        unsigned Width() const { return mChain.levels.empty() ? 0 : mChain.levels[0].width; }
+        unsigned Height() const { return mChain.levels.empty() ? 0 : mChain.levels[0].height; }
+        unsigned Channels() const { return mChain.channels; }
+        int Levels() const { return (int)mChain.levels.size(); }
+
+    private:
+        void SampleLevel(int level, float u, float v, bool linear, float out[4]) const;
+
+        std::vector<uint8_t> mBase;     //  0 (MipChain ̸ Ų)
+        MipChain mChain;
+    };
+
+    struct Sampler { bool linear = true; };
+
+    // /ε/  (Ʈ ״)
+    struct Buffer { std::vector<uint8_t> bytes; };
+
+    enum class CullMode { None, Back, Front };
+    struct RasterState { CullMode cull = CullMode::Back; };
+
+    //  RGBA8 + float .  ġ Ÿ ũ ø (SIMD ε尡    ʰ)
+    struct Target {
+        int width = 0, height = 0, pitch = 0;
+        std::vector<uint32_t> color;    // R | G<<8 | B<<16 | A<<24
+        std::vector<float> depth;
+
+        void Resize(int w, int h);
+        void Clear(const float rgba[4], float z = 1.0f);
+        uint32_t Pixel(int x, int y) const { return color[(size_t)y * pitch + x]; }
+        bool WriteBMP(const std::filesystem::path& path) const;     // 24-bit, bottom-up
+    };
+
+    // ο  ڿ ( ۴ Ʈ )
+    struct DrawResources {
+        const uint8_t* cb[2][4] = {};           // [VS/PS][]
+        const Texture* srv[2][4] = {};
+        const Sampler* sampler[2][2] = {};
+    };
+
+    struct ClipVertex {
+        float pos[4];                   // Ŭ 
+        float var[kMaxVaryings];
+    };
+
+    // vertex: stride 0̸ nullptr (SV_VertexID)
+    using VertexFn = void (*)(const DrawResources& r, uint32_t vertexId, const uint8_t* vertex, ClipVertex& out);
+    // uvPerPixel: lodVarying   ȭ  ȼ ϴ  (ﰢ  ٻ,  ÿ)
+    using PixelFn = uint32_t (*)(const DrawResources& r, const float* var, float uvPerPixel);
+
+    struct VertexProgram {
+        VertexFn fn = nullptr;
+        int varyings = 0;
+        int lodVarying = -1;            //  LOD  varying  ( -1)
+        const char* name = "";
+    };
+    struct PixelProgram {
+        PixelFn fn = nullptr;
+        const char* name = "";
+    };
+
+    struct DrawCall {
+        const VertexProgram* vs = nullptr;
+        const PixelProgram* ps = nullptr;
+        RasterState raster;
+        const uint8_t* vertices = nullptr;
+        uint32_t stride = 0;
+        const uint8_t* indices = nullptr;
+        bool index16 = false;
+        uint32_t indexCount = 0, startIndex = 0;
+        int32_t baseVertex = 0;
+        DrawResources res;
+    };
+
+    struct FrameStats {
+        size_t draws = 0;
+        size_t vertices = 0;            // VS  
+        size_t triangles = 0;           // Է
+        size_t culled = 0;              // ޸/ȭ/ȭ /near 
+        size_t clipped = 0;             // near 鿡  ߸ 
+        size_t setupTris = 0;           // ͷ Ѿ 
+        size_t binRefs = 0;             // Ÿ  
+        size_t pixelsShaded = 0;
+        size_t depthRejected = 0;
+        int    tiles = 0;
+        double setupMs = 0.0, binMs = 0.0, rasterMs = 0.0, totalMs = 0.0;
+    };
+
+    class Rasterizer {
+    public:
+        void Begin(Target& target);
+        void Draw(const DrawCall& dc);      // dc.res Ű ޸𸮴 Flush 
+        const FrameStats& Flush(Path path = Path::Auto, bool parallel = true);
+        const FrameStats& Stats() const { return mStats; }
+
+        // ¾ ﰢ (  a*x + b*y + c, ȼ ǥ)
+        struct Tri {
+            float e[3][3];              //  Լ ( >= 0)
+            bool  topLeft[3];           // 0 ȼ  
+            float z[3];                 // z/w
+            float w[3];                 // 1/w
+            float var[kMaxVaryings][3]; // var/w
+            int   minX, minY, maxX, maxY;
+            float uvPerPixel;
+            uint32_t draw;
+        };
+
+    private:
+        void SetupDraw(uint32_t drawIndex, std::vector<Tri>& out, FrameStats& st) const;
+        void RasterTile(int tile, Path path, FrameStats& st);
+
+        Target* mTarget = nullptr;
+        std::vector<DrawCall> mDraws;
+        std::vector<std::vector<Tri>> mDrawTris;
+        std::vector<const Tri*> mTris;
+        std::vector<std::vector<uint32_t>> mBins;
+        int mTilesX = 0, mTilesY = 0;
+        FrameStats mStats;
+    };
+
+} // namespace Soft
@@ -0,0 +1,362 @@
+#include "TerrainClipmap.h"
+#include "TerrainTilePager.h"
+#include "TerrainTileSource.h"
+#include "../utils/FrameArena.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <thread>
+#include <unordered_map>
+
+using namespace Render;
+
+namespace {
+
+    inline int FloorDiv2(int v) { return v >> 1; }     //  Ʈ = 
+    inline int Mod(int v, int m) { v %= m; return v < 0 ? v + m : v; }
+
+    // [x, x + w)   Ÿ 迡 ڸ 
+    struct Seg { int x, w, tile; };
+    using SegList = FrameMem::Vector<Seg>;
+    void Split(int x, int w, int levelSize, int tileSize, SegList& out)
+    {
+        out.clear();
+        while (w > 0) {
+            const int xw = Mod(x, levelSize);
+            const int run = std::min({ w, tileSize - xw % tileSize, levelSize - xw });
+            out.push_back({ x, run, xw / tileSize });
+            x += run; w -= run;
+        }
+    }
+
+    // â : ī޶  c ¦   â(size-1)  ó д
+    inline int SnapOrigin(double c, int size) { return 2 * (int)std::floor(c * 0.5) - (size / 2 - 2); }
+
+} // namespace
+
+bool TerrainClipmap::Init(const ClipmapDesc& d, const TerrainTileSource& src, TerrainTilePager& pager)
+{
+    Clear();
+    if (d.size < 16 || d.size > 256 || (d.size & (d.size - 1))) return false;
+    if (src.Width() <= 0 || src.Height() <= 0 || src.LevelCount() <= 0) return false;
+
+    mDesc = d;
+    mDesc.levels = std::max(1, std::min(d.levels, src.LevelCount()));
+    mSrc = &src;
+    mPager = &pager;
+    mLevels.resize(mDesc.levels);
+    for (Level& lv : mLevels) lv.texels.assign((size_t)d.size * d.size, 0);
+    mStats.finestLevel = mDesc.levels;
+    return true;
+}
+
+void TerrainClipmap::Clear()
+{
+    mLevels.clear();
+    mUploads.clear();
+    mSrc = nullptr;
+    mPager = nullptr;
+    mStats = {};
+}
+
+void TerrainClipmap::Invalidate()
+{
+    for (Level& lv : mLevels) { lv.valid = false; lv.pieces.clear(); }
+}
+
+void TerrainClipmap::AddRect(int l, int x, int z, int w, int h)
+{
+    if (w <= 0 || h <= 0) return;
+    const int tile = mSrc->TileSize();
+    //    Ҹ ũġ   Ʒ    ǰ´
+    FrameMem::Scope scratch(FrameMem::Default().Local());
+    SegList xs(scratch.Arena()), zs(scratch.Arena());
+    Split(x, w, mSrc->LevelWidth(l), tile, xs);
+    Split(z, h, mSrc->LevelHeight(l), tile, zs);
+    std::vector<Piece>& pieces = mLevels[l].pieces;
+    for (const Seg& sz : zs)
+        for (const Seg& sx : xs)
+            pieces.push_back({ sx.x, sz.x, sx.w, sz.w, sx.tile, sz.tile });
+}
+
+void TerrainClipmap::CopyPiece(int l, const Piece& p, const uint8_t* tile)
+{
+    Level& lv = mLevels[l];
+    const int n = mDesc.size, mask = n - 1, ts = mSrc->TileSize();
+    const int sx = Mod(p.x, mSrc->LevelWidth(l)) - p.tx * ts;
+    const int sz = Mod(p.z, mSrc->LevelHeight(l)) - p.tz * ts;
+
+    // ䷯ 迡 x/z ִ  
+    const int bx = p.x & mask, bz = p.z & mask;
+    const int w0 = std::min(p.w, n - bx), h0 = std::min(p.h, n - bz);
+    for (int r = 0; r < p.h; ++r) {
+        const uint8_t* src = tile + (size_t)(sz + r) * ts + sx;
+        uint8_t* dst = lv.texels.data() + (size_t)((bz + r) & mask) * n;
+        memcpy(dst + bx, src, (size_t)w0);
+        if (w0 < p.w) memcpy(dst, src + w0, (size_t)(p.w - w0));
+    }
+
+    const int xs[2][2] = { { bx, w0 }, { 0, p.w - w0 } };
+    const int zs[2][2] = { { bz, h0 }, { 0, p.h - h0 } };
+    for (const auto& zr : zs)
+        for (const auto& xr : xs)
+            if (xr[1] > 0 && zr[1] > 0) mUploads.push_back({ l, xr[0], zr[0], xr[1], zr[1] });
+    mStats.texelsUpdated += p.w * p.h;
+}
+
+void TerrainClipmap::Fill(int l)
+{
+    std::vector<Piece>& pieces = mLevels[l].pieces;
+    size_t keep = 0;
+    for (size_t i = 0; i < pieces.size(); ++i) {
+        const Piece& p = pieces[i];
+        if (const uint8_t* tile = mPager->Acquire(l, p.tx, p.tz)) CopyPiece(l, p, tile);
+        else pieces[keep++] = p;
+    }
+    pieces.resize(keep);
+}
+
+void TerrainClipmap::Prefetch(int l)
+{
+    const Level& lv = mLevels[l];
+    const int n = mDesc.size, tile = mSrc->TileSize(), margin = tile / 2;
+    FrameMem::Scope scratch(FrameMem::Default().Local());
+    SegList xs(scratch.Arena()), zs(scratch.Arena());
+    Split(lv.ox - margin, n + 2 * margin, mSrc->LevelWidth(l), tile, xs);
+    Split(lv.oz - margin, n + 2 * margin, mSrc->LevelHeight(l), tile, zs);
+    for (const Seg& sz : zs)
+        for (const Seg& sx : xs)
+            mPager->Prefetch(l, sx.tile, sz.tile);
+}
+
+void TerrainClipmap::Update(float camX, float camZ)
+{
+    const auto t0 = std::chrono::steady_clock::now();
+    mUploads.clear();
+    const int finest = mStats.finestLevel;
+    mStats = {};
+    mStats.finestLevel = finest;
+    if (mLevels.empty()) return;
+
+    //  0 ؼ ǥ (ؼ ߽ = )
+    const int n = mDesc.size;
+    const double c0x = ((double)camX / mDesc.gridSizeX + 0.5) * mSrc->Width() - 0.5;
+    const double c0z = ((double)camZ / mDesc.gridSizeZ + 0.5) * mSrc->Height() - 0.5;
+
+    for (int l = Levels() - 1; l >= 0; --l) {
+        Level& lv = mLevels[l];
+        const double cx = std::ldexp(c0x, -l), cz = std::ldexp(c0z, -l);
+        const int ox = SnapOrigin(cx, n), oz = SnapOrigin(cz, n);
+        lv.camX = (float)cx; lv.camZ = (float)cz;
+
+        const int dx = ox - lv.ox, dz = oz - lv.oz;
+        if (!lv.valid || std::abs(dx) >= n || std::abs(dz) >= n) {
+            lv.pieces.clear();
+            lv.ox = ox; lv.oz = oz;
+            lv.valid = true;
+            AddRect(l, ox, oz, n, n);
+            ++mStats.fullRefills;
+        }
+        else if (dx || dz) {
+            //     â ڸ,     +   (ġ ʴ L)
+            std::vector<Piece>& pieces = lv.pieces;
+            size_t keep = 0;
+            for (const Piece& p : pieces) {
+                const int x0 = std::max(p.x, ox), x1 = std::min(p.x + p.w, ox + n);
+                const int z0 = std::max(p.z, oz), z1 = std::min(p.z + p.h, oz + n);
+                if (x0 < x1 && z0 < z1) pieces[keep++] = { x0, z0, x1 - x0, z1 - z0, p.tx, p.tz };
+            }
+            pieces.resize(keep);
+
+            const int oldX = lv.ox, oldZ = lv.oz;
+            lv.ox = ox; lv.oz = oz;
+            if (dx > 0) AddRect(l, oldX + n, oz, dx, n);
+            else if (dx < 0) AddRect(l, ox, oz, -dx, n);
+            const int keepX = std::max(ox, oldX), keepW = n - std::abs(dx);
+            if (dz > 0) AddRect(l, keepX, oldZ + n, keepW, dz);
+            else if (dz < 0) AddRect(l, keepX, oz, keepW, -dz);
+            ++mStats.stripLevels;
+        }
+        Fill(l);
+        Prefetch(l);
+        mStats.pendingPieces += (int)lv.pieces.size();
+    }
+
+    //  ģ   غ  ׸
+    int f = Levels();
+    while (f > 0 && LevelReady(f - 1)) --f;
+    mStats.finestLevel = f;
+    mStats.uploads = (int)mUploads.size();
+    mStats.updateMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+TerrainClipmapCB TerrainClipmap::LevelCB(int l) const
+{
+    const Level& lv = mLevels[l];
+    const int n = mDesc.size;
+    TerrainClipmapCB cb{};
+    cb.Origin[0] = lv.ox; cb.Origin[1] = lv.oz;
+    cb.CamSample[0] = lv.camX; cb.CamSample[1] = lv.camZ;
+    cb.LevelScale = std::ldexp(1.0f, l);
+    cb.Level = (float)l;
+    cb.CoarseLevel = (l + 1 < Levels() && LevelReady(l + 1)) ? (float)(l + 1) : -1.0f;
+    // ٱ  ī޶󿡼 ּ size/2 - 2   ű⼭  1 (ģ   ġ = ƴ )
+    const float width = std::max(2.0f, n * 0.1f);
+    cb.MorphStart = (n / 2 - 2) - width;
+    cb.MorphInvWidth = 1.0f / width;
+    cb.Size = (float)n;
+    return cb;
+}
+
+int TerrainClipmap::RingVariant(int l) const
+{
+    if (l <= 0) return kRingVariants - 1;
+    const int base = mDesc.size / 4 - 1;
+    const int hx = FloorDiv2(mLevels[l - 1].ox) - mLevels[l].ox - base;
+    const int hz = FloorDiv2(mLevels[l - 1].oz) - mLevels[l].oz - base;
+    return (hx & 1) | ((hz & 1) << 1);
+}
+
+void TerrainClipmap::BuildRingIndices(int size, int variant, std::vector<uint32_t>& out)
+{
+    const int vn = size - 1, quads = size - 2;
+    const int base = size / 4 - 1, hole = size / 2 - 1;
+    const bool full = variant >= 4;
+    const int hx0 = base + (variant & 1), hz0 = base + ((variant >> 1) & 1);
+    out.clear();
+    out.reserve((size_t)quads * quads * 6);
+
+    // 32  ȴ´ ( ĳ )
+    const int stripW = 32;
+    for (int sx = 0; sx < quads; sx += stripW) {
+        for (int z = 0; z < quads; ++z) {
+            for (int x = sx; x < std::min(quads, sx + stripW); ++x) {
+                if (!full && x >= hx0 && x < hx0 + hole && z >= hz0 && z < hz0 + hole) continue;
+                const uint32_t i0 = z * vn + x, i1 = i0 + 1, i2 = i0 + vn, i3 = i2 + 1;
+                out.push_back(i0); out.push_back(i2); out.push_back(i1);
+                out.push_back(i1); out.push_back(i2); out.push_back(i3);
+            }
+        }
+    }
+}
+
+size_t TerrainClipmap::Verify() const
+{
+    if (mLevels.empty()) return 0;
+    const int n = mDesc.size, mask = n - 1, ts = mSrc->TileSize();
+    std::unordered_map<uint64_t, std::vector<uint8_t>> tiles;
+    size_t bad = 0;
+    for (int l = 0; l < Levels(); ++l) {
+        if (!LevelReady(l)) continue;
+        const Level& lv = mLevels[l];
+        const int lw = mSrc->LevelWidth(l), lh = mSrc->LevelHeight(l);
+        for (int j = lv.oz; j < lv.oz + n; ++j) {
+            for (int i = lv.ox; i < lv.ox + n; ++i) {
+                const int wi = Mod(i, lw), wj = Mod(j, lh);
+                const uint64_t key = ((uint64_t)l << 48) | ((uint64_t)(wj / ts) << 24) | (uint64_t)(wi / ts);
+                auto it = tiles.find(key);
+                if (it == tiles.end()) {
+                    it = tiles.emplace(key, std::vector<uint8_t>(mSrc->TileBytes())).first;
+                    mSrc->ReadTile(l, wi / ts, wj / ts, it->second.data());
+                }
+                const uint8_t want = it->second[(size_t)(wj % ts) * ts + wi % ts];
+                bad += lv.texels[(size_t)(j & mask) * n + (i & mask)] != want;
+            }
+        }
+    }
+    return bad;
+}
+
+TerrainClipmap::FlythroughResult TerrainClipmap::Flythrough(const TerrainTileSource& src, const ClipmapDesc& d,
+    size_t budgetBytes, int frames, float speed, double frameMs, bool drain)
+{
+    FlythroughResult r;
+    TerrainTilePager pager;
+    TerrainClipmap clip;
+    if (frames <= 0 || !pager.Start(&src, budgetBytes) || !clip.Init(d, src, pager)) return r;
+
+    // ؼ/  /.         찡 
+    const float texel = d.gridSizeX / src.Width();
+    float x = 0.0f, z = 0.0f;
+    size_t texels = 0;
+    double sumMs = 0.0;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; ++f) {
+        if (frameMs > 0.0)
+            std::this_thread::sleep_until(t0 + std::chrono::duration<double, std::milli>(frameMs * f));
+        const float a = f * 0.02f;
+        x += speed * texel * std::cos(0.6f * std::sin(a));
+        z += speed * texel * std::sin(0.6f * std::sin(a)) + 0.3f * speed * texel;
+
+        if (drain) pager.WaitIdle();
+        else pager.Update();
+        clip.Update(x, z);
+        const ClipmapStats& s = clip.Stats();
+        sumMs += s.updateMs;
+        r.maxUpdateMs = std::max(r.maxUpdateMs, s.updateMs);
+        texels += s.texelsUpdated;
+        r.notReadyFrames += s.finestLevel > 0;
+        ++r.frames;
+    }
+    const double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    //  û  ޾ â ϼ   
+    for (int i = 0; i < 64 && clip.Stats().pendingPieces + (clip.Stats().finestLevel > 0); ++i) {
+        pager.WaitIdle();
+        clip.Update(x, z);
+    }
+
+    const TilePagerStats& ps = pager.Stats();
+    r.avgUpdateMs = sumMs / r.frames;
+    r.avgTexelsPerFrame = (double)texels / r.frames;
+    r.hitRate = ps.HitRate();
+    r.mbStreamed = ps.bytesStreamed / (1024.0 * 1024.0);
+    r.mbPerSec = sec > 0.0 ? r.mbStreamed / sec : 0.0;
+    r.peakMB = ps.peakBytes / (1024.0 * 1024.0);
+    r.evictions = ps.evictions;
+    r.complete = clip.FinestLevel() == 0;
+    r.mismatches = clip.Verify();
+    return r;
+}
+
+namespace TerrainClipmapPass {
+
+    void ApplyRequirements(PipelineDesc& p)
+    {
+        const int vs = (int)Stage::VS, ps = (int)Stage::PS;
+        p.requiredCBs[vs] = (1 << 0) | (1 << 1) | (1 << 3);
+        p.requiredCBs[ps] = (1 << 0) | (1 << 1) | (1 << 2);
+        p.requiredSRVs[vs] = (1 << 0);
+        p.requiredSRVs[ps] = (1 << 0) | (1 << 1) | (1 << 2);
+        p.requiredSamplers[vs] = 0;                         // Load 
+        p.requiredSamplers[ps] = (1 << 0);
+    }
+
+    void Record(CommandList& list, const TerrainClipmapResources& r, const TerrainPassConstants& k,
+        const TerrainClipmap& clip)
+    {
+        const int finest = clip.FinestLevel(), levels = clip.Levels();
+        if (finest >= levels) return;
+
+        list.UpdateBuffer(r.sceneCB, k.scene, k.sceneBytes);
+        list.UpdateBuffer(r.terrainCB, k.terrain, k.terrainBytes);
+        list.UpdateBuffer(r.matCB, k.mat, k.matBytes);
+        list.BindCB(StageAll, 0, r.sceneCB);
+        list.BindCB(StageAll, 1, r.terrainCB);
+        list.BindCB(StagePS, 2, r.matCB);
+        list.BindCB(StageVS, 3, r.levelCB);
+        list.BindSRV(StageVS, 0, r.clipSRV);
+        for (int i = 0; i < 3; ++i) list.BindSRV(StagePS, i, r.albedoSRVs[i]);
+        list.BindSampler(StagePS, 0, r.albedoSampler);
+        list.SetPipeline(r.pipeline);
+
+        for (int l = finest; l < levels; ++l) {
+            list.UpdateBuffer(r.levelCB, clip.LevelCB(l));
+            const int v = l == finest ? TerrainClipmap::kRingVariants - 1 : clip.RingVariant(l);
+            list.SetMesh(r.rings[v]);
+            list.DrawIndexed(r.ringIndexCount[v], 0, 0, (float)(l - finest) / levels);
+        }
+    }
+
+} // namespace TerrainClipmapPass
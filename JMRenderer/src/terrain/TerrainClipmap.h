@@ -0,0 +1,161 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "TerrainPass.h"
+#include "../render/CommandList.h"
+
+class TerrainTileSource;
+class TerrainTilePager;
+
+// Ʈ Ŭ (CPU  , D3D  )
+//  l ī޶ ֺ size x size  â ( =  0 ؼ 2^l), ̴ ䷯ ּ 
+// ( (i, j)  (i & (size-1), j & (size-1))) ΰ â ̸   L 츸 ä
+//   Ÿ     ,   Ÿ   ӿ ٽ õ
+// â   Ÿ ׵θ ̸ û д (Ÿ 踦 Ѵ ӿ ٸ ʵ)
+// â    ¦     â ģ  ڿ Ȯ  ( ġ 2x2)
+//  â  size-1 x size-1  ( / )
+
+struct ClipmapDesc {
+    int   levels = 6;               //     δ
+    int   size = 256;               //  ؽó   (2 ŵ, 16 ~ 256: 16Ʈ ε)
+    float gridSizeX = 10.0f, gridSizeZ = 10.0f;    //  ü  ũ ( ߽)
+};
+
+// ䷯ ؼ 簢 (迡  )  UpdateSubresource  
+struct ClipmapUpload {
+    int level;
+    int x, z, w, h;
+};
+
+struct ClipmapStats {
+    int    texelsUpdated = 0;       // ̹ Update ä ؼ
+    int    uploads = 0;             // ε 簢 
+    int    pendingPieces = 0;       // Ÿ ٸ 
+    int    stripLevels = 0;         // L 츸   
+    int    fullRefills = 0;         // â ü ٽ ä  
+    int    finestLevel = 0;         // ׸  ִ    (Levels() )
+    double updateMs = 0.0;
+};
+
+//  ο (b3): terrain_clipmap_vs.hlsl ClipmapCB  ġ
+struct TerrainClipmapCB {
+    int32_t Origin[2];      // â  ( )
+    float   CamSample[2];   // ī޶ (  ǥ)
+    float   LevelScale;     // 2^level
+    float   Level;
+    float   CoarseLevel;    //    (-1 = )
+    float   MorphStart;     // ī޶  Ÿ (ü)  ģ  
+    float   MorphInvWidth;
+    float   Size;
+    float   _pad[2];
+};
+
+class TerrainClipmap {
+public:
+    // src/pager Ŭ    ־ Ѵ (pager src Start )
+    bool Init(const ClipmapDesc& d, const TerrainTileSource& src, TerrainTilePager& pager);
+    void Clear();
+    bool Empty() const { return mLevels.empty(); }
+
+    // ī޶ XZ()  â ű, /   ä (ģ )
+    void Update(float camX, float camZ);
+    void Invalidate();      //  Update   ü ٽ ä
+
+    const ClipmapDesc& Desc() const { return mDesc; }
+    int Levels() const { return (int)mLevels.size(); }
+    int Size() const { return mDesc.size; }
+    const uint8_t* LevelData(int l) const { return mLevels[l].texels.data(); }
+    int OriginX(int l) const { return mLevels[l].ox; }
+    int OriginZ(int l) const { return mLevels[l].oz; }
+    bool LevelReady(int l) const { return mLevels[l].valid && mLevels[l].pieces.empty(); }
+    int FinestLevel() const { return mStats.finestLevel; }
+
+    // ̹ Update ٲ ؼ (GPU ε)
+    const std::vector<ClipmapUpload>& Uploads() const { return mUploads; }
+    const ClipmapStats& Stats() const { return mStats; }
+
+    //  l ο  (ģ  ְ غ )
+    TerrainClipmapCB LevelCB(int l) const;
+    //  l(> FinestLevel)  ġ   ε  0~3
+    int RingVariant(int l) const;
+
+    // غ  â ü   ٸ ؼ  (0̾ )
+    size_t Verify() const;
+
+    //  ε ( =  켱 (size-1)^2, ȣ = z * (size-1) + x)
+    // variant 0~3:   (size/4 - 1 + (v & 1), size/4 - 1 + (v >> 1)), ũ size/2 - 1 
+    // variant 4:   ü  (  )
+    static constexpr int kRingVariants = 5;
+    static void BuildRingIndices(int size, int variant, std::vector<uint32_t>& out);
+
+    struct FlythroughResult {
+        int    frames = 0;
+        double avgUpdateMs = 0.0, maxUpdateMs = 0.0;
+        double avgTexelsPerFrame = 0.0;
+        int    notReadyFrames = 0;      //    غ  
+        double hitRate = 0.0;
+        double mbStreamed = 0.0;
+        double mbPerSec = 0.0;          // Ʈ Ʈ / ü  ð
+        double peakMB = 0.0;            // ĳ ִ 
+        size_t evictions = 0;
+        bool   complete = false;        //     غ
+        size_t mismatches = 0;          //   Verify
+    };
+
+    //   speed( 0 ؼ/) ұ  Ӹ  Update  Ŭ Update
+    // frameMs:   (0 =  , Ŀ  ð  ־ )
+    // drain: Ӹ  Update  WaitIdle (  û   ־ Ÿְ̹ , ׽Ʈ)
+    //   û  ޾ Verify
+    static FlythroughResult Flythrough(const TerrainTileSource& src, const ClipmapDesc& d, size_t budgetBytes,
+        int frames = 300, float speed = 4.0f, double frameMs = 4.0, bool drain = false);
+
+private:
+    //   ǥ 簢,  Ÿ ϳ ȿ ְ  踦  
+    struct Piece {
+        int x, z, w, h;
+        int tx, tz;
+    };
+    struct Level {
+        std::vector<uint8_t> texels;    // size x size ䷯
+        std::vector<Piece> pieces;      // ä  
+        int ox = 0, oz = 0;
+        float camX = 0.0f, camZ = 0.0f; //   ǥ
+        bool valid = false;             // â  ̶ 
+    };
+
+    void AddRect(int l, int x, int z, int w, int h);
+    void Fill(int l);
+    void Prefetch(int l);
+    void CopyPiece(int l, const Piece& p, const uint8_t* tile);
+
+    ClipmapDesc mDesc;
+    const TerrainTileSource* mSrc = nullptr;
+    TerrainTilePager* mPager = nullptr;
+    std::vector<Level> mLevels;
+    std::vector<ClipmapUpload> mUploads;
+    ClipmapStats mStats;
+};
+
+// Ŭ  Ŀǵ Ʈ  (TerrainPass  b0~b2/˺, VS t0 =  ؽó 迭)
+struct TerrainClipmapResources {
+    Render::PipelineDesc pipeline;          //    (SV_VertexID)
+    Render::MeshDesc     rings[TerrainClipmap::kRingVariants];
+    uint32_t ringIndexCount[TerrainClipmap::kRingVariants] = {};
+
+    Render::Handle sceneCB = nullptr, terrainCB = nullptr, matCB = nullptr;
+    Render::Handle levelCB = nullptr;       // b3 (VS)
+    Render::Handle clipSRV = nullptr;       // VS t0 (Texture2DArray)
+    Render::Handle albedoSRVs[3] = {};
+    Render::Handle albedoSampler = nullptr;
+};
+
+namespace TerrainClipmapPass {
+
+    void ApplyRequirements(Render::PipelineDesc& p);
+
+    // FinestLevel  ģ   ο ϳ (  )
+    void Record(Render::CommandList& list, const TerrainClipmapResources& r, const TerrainPassConstants& k,
+        const TerrainClipmap& clip);
+
+} // namespace TerrainClipmapPass
@@ -0,0 +1,76 @@
+#include "TerrainClipmapGPU.h"
+#include <vector>
+
+bool TerrainClipmapGPU::Init(ID3D11Device* dev, int size, int levels)
+{
+    Release();
+    if (!dev || size < 16 || size > 256 || levels <= 0) return false;
+    mSize = size; mLevels = levels;
+
+    // UpdateSubresource κ ϹǷ DEFAULT, VS Load ϹǷ  
+    D3D11_TEXTURE2D_DESC td{};
+    td.Width = (UINT)size; td.Height = (UINT)size;
+    td.MipLevels = 1; td.ArraySize = (UINT)levels;
+    td.Format = DXGI_FORMAT_R8_UNORM;
+    td.SampleDesc.Count = 1;
+    td.Usage = D3D11_USAGE_DEFAULT;
+    td.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+    if (FAILED(dev->CreateTexture2D(&td, nullptr, mTex.GetAddressOf()))) { Release(); return false; }
+    if (FAILED(dev->CreateShaderResourceView(mTex.Get(), nullptr, mSRV.GetAddressOf()))) { Release(); return false; }
+
+    //  (size-1)^2 <= 65536  16Ʈ ε
+    std::vector<uint32_t> inds;
+    std::vector<uint16_t> i16;
+    for (int v = 0; v < TerrainClipmap::kRingVariants; ++v) {
+        TerrainClipmap::BuildRingIndices(size, v, inds);
+        i16.assign(inds.begin(), inds.end());
+
+        D3D11_BUFFER_DESC bd{};
+        bd.ByteWidth = (UINT)(i16.size() * sizeof(uint16_t));
+        bd.Usage = D3D11_USAGE_IMMUTABLE;
+        bd.BindFlags = D3D11_BIND_INDEX_BUFFER;
+        D3D11_SUBRESOURCE_DATA init{};
+        init.pSysMem = i16.data();
+        if (FAILED(dev->CreateBuffer(&bd, &init, mRingIB[v].GetAddressOf()))) { Release(); return false; }
+        mRingCount[v] = (uint32_t)i16.size();
+    }
+    mFull = true;
+    return true;
+}
+
+void TerrainClipmapGPU::Release()
+{
+    mSRV.Reset();
+    mTex.Reset();
+    for (int v = 0; v < TerrainClipmap::kRingVariants; ++v) { mRingIB[v].Reset(); mRingCount[v] = 0; }
+    mSize = mLevels = 0;
+    mStats = {};
+}
+
+void TerrainClipmapGPU::Upload(ID3D11DeviceContext* ctx, const TerrainClipmap& clip)
+{
+    mStats = {};
+    if (!mTex || clip.Empty() || clip.Size() != mSize || clip.Levels() > mLevels) return;
+
+    const UINT pitch = (UINT)mSize;
+    if (mFull) {
+        for (int l = 0; l < clip.Levels(); ++l) {
+            ctx->UpdateSubresource(mTex.Get(), D3D11CalcSubresource(0, (UINT)l, 1), nullptr, clip.LevelData(l), pitch, 0);
+            ++mStats.uploads;
+            mStats.uploadBytes += (size_t)mSize * mSize;
+        }
+        mFull = false;
+        return;
+    }
+
+    for (const ClipmapUpload& u : clip.Uploads()) {
+        D3D11_BOX box{};
+        box.left = (UINT)u.x; box.right = (UINT)(u.x + u.w);
+        box.top = (UINT)u.z; box.bottom = (UINT)(u.z + u.h);
+        box.front = 0; box.back = 1;
+        const uint8_t* src = clip.LevelData(u.level) + (size_t)u.z * mSize + u.x;
+        ctx->UpdateSubresource(mTex.Get(), D3D11CalcSubresource(0, (UINT)u.level, 1), &box, src, pitch, 0);
+        ++mStats.uploads;
+        mStats.uploadBytes += (size_t)u.w * u.h;
+    }
+}
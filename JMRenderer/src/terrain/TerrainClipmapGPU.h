@@ -0,0 +1,39 @@
+#pragma once
+#include <d3d11.h>
+#include <wrl/client.h>
+#include <cstddef>
+#include <cstdint>
+#include "TerrainClipmap.h"
+
+using Microsoft::WRL::ComPtr;
+
+// Ŭ GPU ҽ:  ䷯  ؽó (R8 Texture2DArray, ̽ = )
+// +  ε  5 (  , SV_VertexID   ǥ)
+//   Ŭ Update  Upload: ٲ 簢 UpdateSubresource
+class TerrainClipmapGPU {
+public:
+    struct Stats {
+        int    uploads = 0;         //  Upload UpdateSubresource 
+        size_t uploadBytes = 0;
+    };
+
+    bool Init(ID3D11Device* dev, int size, int levels);
+    void Release();
+    bool Ready() const { return mSRV.Get() != nullptr; }
+
+    void Upload(ID3D11DeviceContext* ctx, const TerrainClipmap& clip);
+
+    ID3D11ShaderResourceView* SRV() const { return mSRV.Get(); }
+    ID3D11Buffer* RingIB(int variant) const { return mRingIB[variant].Get(); }
+    uint32_t RingIndexCount(int variant) const { return mRingCount[variant]; }
+    const Stats& GetStats() const { return mStats; }
+
+private:
+    ComPtr<ID3D11Texture2D> mTex;
+    ComPtr<ID3D11ShaderResourceView> mSRV;
+    ComPtr<ID3D11Buffer> mRingIB[TerrainClipmap::kRingVariants];
+    uint32_t mRingCount[TerrainClipmap::kRingVariants] = {};
+    int mSize = 0, mLevels = 0;
+    bool mFull = true;              //  Upload   ü (Init )
+    Stats mStats;
+};
@@ -0,0 +1,375 @@
+#include "TerrainHeightField.h"
+#include "../utils/Simd.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+namespace {
+
+    struct Ctx {
+        const float* texels;
+        int w, h;
+        float fw, fh;
+        float invGridX, invGridZ;
+        float heightScale;
+        float kx, kz;   // HeightScale / ؼ  (ȭ    )
+    };
+
+    //  Į   
+    // SIMD ο    ( Ʈ ġ)
+
+    inline float Lerp(float a, float b, float t) { return a + (b - a) * t; }
+
+    // ǥ  ؼ  (  ĭ + Ҽ).   [0,1) , NaN/Inf 0
+    inline void TexelCoord(float p, float invGrid, float size, int& i0, float& f)
+    {
+        float u = p * invGrid + 0.5f;
+        u = u - std::floor(u);
+        if (!(u >= 0.0f && u < 1.0f)) u = 0.0f;
+        const float t = u * size - 0.5f;
+        const float fl = std::floor(t);
+        f = t - fl;
+        i0 = (int)fl;   // [-1, size-1]
+    }
+
+    // i0 + k (k = 0..2) [0, n) (WRAP)
+    inline int Wrap(int i, int n)
+    {
+        if (i < 0) i += n;
+        if (i >= n) i -= n;
+        return i;
+    }
+
+    template<bool Full>
+    void QueryOne(const Ctx& c, float x, float z, const HeightQueryOut& out, size_t i)
+    {
+        int ix, iy;
+        float fx, fy;
+        TexelCoord(x, c.invGridX, c.fw, ix, fx);
+        TexelCoord(z, c.invGridZ, c.fh, iy, fy);
+        const int c0 = Wrap(ix, c.w), c1 = Wrap(ix + 1, c.w);
+        const float* r0 = c.texels + (size_t)Wrap(iy, c.h) * c.w;
+        const float* r1 = c.texels + (size_t)Wrap(iy + 1, c.h) * c.w;
+
+        const float h00 = r0[c0], h10 = r0[c1], h01 = r1[c0], h11 = r1[c1];
+        const float h = Lerp(Lerp(h00, h10, fx), Lerp(h01, h11, fx), fy);
+        if (out.height) out.height[i] = h * c.heightScale;
+        if (!Full) return;
+
+        // /Ʒ  ؼ ̿ (Ҽδ )
+        const int c2 = Wrap(ix + 2, c.w);
+        const float* r2 = c.texels + (size_t)Wrap(iy + 2, c.h) * c.w;
+        const float h20 = r0[c2], h21 = r1[c2], h02 = r2[c0], h12 = r2[c1];
+        const float hr = Lerp(Lerp(h10, h20, fx), Lerp(h11, h21, fx), fy);
+        const float hd = Lerp(Lerp(h01, h11, fx), Lerp(h02, h12, fx), fy);
+
+        // cross((0,hd-h,dz), (dx,hr-h,0))  (-gx, 1, -gz)
+        const float gx = (hr - h) * c.kx, gz = (hd - h) * c.kz;
+        const float s2 = gx * gx + gz * gz;
+        const float inv = 1.0f / std::sqrt(1.0f + s2);
+        if (out.nx) out.nx[i] = -gx * inv;
+        if (out.ny) out.ny[i] = inv;
+        if (out.nz) out.nz[i] = -gz * inv;
+        if (out.slope) out.slope[i] = std::sqrt(s2);
+    }
+
+    template<bool Full>
+    void QueryScalar(const Ctx& c, const float* x, const float* z, size_t begin, size_t end, const HeightQueryOut& out)
+    {
+        for (size_t i = begin; i < end; ++i) QueryOne<Full>(c, x[i], z[i], out, i);
+    }
+
+#if JM_SIMD_X86
+    //  SSE4.1 4-wide (gather : ε  Į ε) 
+    JM_TARGET_SSE41 inline void TexelCoord4(__m128 p, float invGrid, float size, __m128i& i0, __m128& f)
+    {
+        const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f);
+        __m128 u = _mm_add_ps(_mm_mul_ps(p, _mm_set1_ps(invGrid)), _mm_set1_ps(0.5f));
+        u = _mm_sub_ps(u, _mm_floor_ps(u));
+        u = _mm_and_ps(u, _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmplt_ps(u, one)));
+        const __m128 t = _mm_sub_ps(_mm_mul_ps(u, _mm_set1_ps(size)), _mm_set1_ps(0.5f));
+        const __m128 fl = _mm_floor_ps(t);
+        f = _mm_sub_ps(t, fl);
+        i0 = _mm_cvttps_epi32(fl);
+    }
+
+    JM_TARGET_SSE41 inline __m128i Wrap4(__m128i i, int n)
+    {
+        const __m128i nn = _mm_set1_epi32(n);
+        i = _mm_add_epi32(i, _mm_and_si128(_mm_cmplt_epi32(i, _mm_setzero_si128()), nn));
+        return _mm_sub_epi32(i, _mm_andnot_si128(_mm_cmplt_epi32(i, nn), nn));
+    }
+
+    JM_TARGET_SSE41 inline __m128 Load4(const float* t, __m128i row, __m128i col)
+    {
+        alignas(16) int32_t r[4], k[4];
+        _mm_store_si128((__m128i*)r, row);
+        _mm_store_si128((__m128i*)k, col);
+        return _mm_setr_ps(t[(size_t)r[0] + k[0]], t[(size_t)r[1] + k[1]], t[(size_t)r[2] + k[2]], t[(size_t)r[3] + k[3]]);
+    }
+
+    JM_TARGET_SSE41 inline __m128 Lerp4(__m128 a, __m128 b, __m128 t)
+    {
+        return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t));
+    }
+
+    template<bool Full>
+    JM_TARGET_SSE41 void QuerySSE41(const Ctx& c, const float* x, const float* z, size_t n, const HeightQueryOut& out)
+    {
+        const __m128i one = _mm_set1_epi32(1), two = _mm_set1_epi32(2), w = _mm_set1_epi32(c.w);
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m128i ix, iy;
+            __m128 fx, fy;
+            TexelCoord4(_mm_loadu_ps(x + i), c.invGridX, c.fw, ix, fx);
+            TexelCoord4(_mm_loadu_ps(z + i), c.invGridZ, c.fh, iy, fy);
+            const __m128i c0 = Wrap4(ix, c.w), c1 = Wrap4(_mm_add_epi32(ix, one), c.w);
+            const __m128i r0 = _mm_mullo_epi32(Wrap4(iy, c.h), w);
+            const __m128i r1 = _mm_mullo_epi32(Wrap4(_mm_add_epi32(iy, one), c.h), w);
+
+            const __m128 h00 = Load4(c.texels, r0, c0), h10 = Load4(c.texels, r0, c1);
+            const __m128 h01 = Load4(c.texels, r1, c0), h11 = Load4(c.texels, r1, c1);
+            const __m128 h = Lerp4(Lerp4(h00, h10, fx), Lerp4(h01, h11, fx), fy);
+            if (out.height) _mm_storeu_ps(out.height + i, _mm_mul_ps(h, _mm_set1_ps(c.heightScale)));
+            if (!Full) continue;
+
+            const __m128i c2 = Wrap4(_mm_add_epi32(ix, two), c.w);
+            const __m128i r2 = _mm_mullo_epi32(Wrap4(_mm_add_epi32(iy, two), c.h), w);
+            const __m128 h20 = Load4(c.texels, r0, c2), h21 = Load4(c.texels, r1, c2);
+            const __m128 h02 = Load4(c.texels, r2, c0), h12 = Load4(c.texels, r2, c1);
+            const __m128 hr = Lerp4(Lerp4(h10, h20, fx), Lerp4(h11, h21, fx), fy);
+            const __m128 hd = Lerp4(Lerp4(h01, h11, fx), Lerp4(h02, h12, fx), fy);
+
+            const __m128 gx = _mm_mul_ps(_mm_sub_ps(hr, h), _mm_set1_ps(c.kx));
+            const __m128 gz = _mm_mul_ps(_mm_sub_ps(hd, h), _mm_set1_ps(c.kz));
+            const __m128 s2 = _mm_add_ps(_mm_mul_ps(gx, gx), _mm_mul_ps(gz, gz));
+            const __m128 fone = _mm_set1_ps(1.0f), sign = _mm_set1_ps(-0.0f);
+            const __m128 inv = _mm_div_ps(fone, _mm_sqrt_ps(_mm_add_ps(fone, s2)));
+            if (out.nx) _mm_storeu_ps(out.nx + i, _mm_mul_ps(_mm_xor_ps(gx, sign), inv));
+            if (out.ny) _mm_storeu_ps(out.ny + i, inv);
+            if (out.nz) _mm_storeu_ps(out.nz + i, _mm_mul_ps(_mm_xor_ps(gz, sign), inv));
+            if (out.slope) _mm_storeu_ps(out.slope + i, _mm_sqrt_ps(s2));
+        }
+        QueryScalar<Full>(c, x, z, i, n, out);
+    }
+
+    //  AVX2 8-wide (ϵ gather) 
+    JM_TARGET_AVX2 inline void TexelCoord8(__m256 p, float invGrid, float size, __m256i& i0, __m256& f)
+    {
+        const __m256 zero = _mm256_setzero_ps(), one = _mm256_set1_ps(1.0f);
+        __m256 u = _mm256_add_ps(_mm256_mul_ps(p, _mm256_set1_ps(invGrid)), _mm256_set1_ps(0.5f));
+        u = _mm256_sub_ps(u, _mm256_floor_ps(u));
+        u = _mm256_and_ps(u, _mm256_and_ps(_mm256_cmp_ps(u, zero, _CMP_GE_OQ), _mm256_cmp_ps(u, one, _CMP_LT_OQ)));
+        const __m256 t = _mm256_sub_ps(_mm256_mul_ps(u, _mm256_set1_ps(size)), _mm256_set1_ps(0.5f));
+        const __m256 fl = _mm256_floor_ps(t);
+        f = _mm256_sub_ps(t, fl);
+        i0 = _mm256_cvttps_epi32(fl);
+    }
+
+    JM_TARGET_AVX2 inline __m256i Wrap8(__m256i i, int n)
+    {
+        const __m256i nn = _mm256_set1_epi32(n);
+        i = _mm256_add_epi32(i, _mm256_and_si256(_mm256_cmpgt_epi32(_mm256_setzero_si256(), i), nn));
+        return _mm256_sub_epi32(i, _mm256_andnot_si256(_mm256_cmpgt_epi32(nn, i), nn));
+    }
+
+    JM_TARGET_AVX2 inline __m256 Load8(const float* t, __m256i row, __m256i col)
+    {
+        return _mm256_i32gather_ps(t, _mm256_add_epi32(row, col), 4);
+    }
+
+    JM_TARGET_AVX2 inline __m256 Lerp8(__m256 a, __m256 b, __m256 t)
+    {
+        return _mm256_add_ps(a, _mm256_mul_ps(_mm256_sub_ps(b, a), t));
+    }
+
+    template<bool Full>
+    JM_TARGET_AVX2 void QueryAVX2(const Ctx& c, const float* x, const float* z, size_t n, const HeightQueryOut& out)
+    {
+        const __m256i one = _mm256_set1_epi32(1), two = _mm256_set1_epi32(2), w = _mm256_set1_epi32(c.w);
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256i ix, iy;
+            __m256 fx, fy;
+            TexelCoord8(_mm256_loadu_ps(x + i), c.invGridX, c.fw, ix, fx);
+            TexelCoord8(_mm256_loadu_ps(z + i), c.invGridZ, c.fh, iy, fy);
+            const __m256i c0 = Wrap8(ix, c.w), c1 = Wrap8(_mm256_add_epi32(ix, one), c.w);
+            const __m256i r0 = _mm256_mullo_epi32(Wrap8(iy, c.h), w);
+            const __m256i r1 = _mm256_mullo_epi32(Wrap8(_mm256_add_epi32(iy, one), c.h), w);
+
+            const __m256 h00 = Load8(c.texels, r0, c0), h10 = Load8(c.texels, r0, c1);
+            const __m256 h01 = Load8(c.texels, r1, c0), h11 = Load8(c.texels, r1, c1);
+            const __m256 h = Lerp8(Lerp8(h00, h10, fx), Lerp8(h01, h11, fx), fy);
+            if (out.height) _mm256_storeu_ps(out.height + i, _mm256_mul_ps(h, _mm256_set1_ps(c.heightScale)));
+            if (!Full) continue;
+
+            const __m256i c2 = Wrap8(_mm256_add_epi32(ix, two), c.w);
+            const __m256i r2 = _mm256_mullo_epi32(Wrap8(_mm256_add_epi32(iy, two), c.h), w);
+            const __m256 h20 = Load8(c.texels, r0, c2), h21 = Load8(c.texels, r1, c2);
+            const __m256 h02 = Load8(c.texels, r2, c0), h12 = Load8(c.texels, r2, c1);
+            const __m256 hr = Lerp8(Lerp8(h10, h20, fx), Lerp8(h11, h21, fx), fy);
+            const __m256 hd = Lerp8(Lerp8(h01, h11, fx), Lerp8(h02, h12, fx), fy);
+
+            const __m256 gx = _mm256_mul_ps(_mm256_sub_ps(hr, h), _mm256_set1_ps(c.kx));
+            const __m256 gz = _mm256_mul_ps(_mm256_sub_ps(hd, h), _mm256_set1_ps(c.kz));
+            const __m256 s2 = _mm256_add_ps(_mm256_mul_ps(gx, gx), _mm256_mul_ps(gz, gz));
+            const __m256 fone = _mm256_set1_ps(1.0f), sign = _mm256_set1_ps(-0.0f);
+            const __m256 inv = _mm256_div_ps(fone, _mm256_sqrt_ps(_mm256_add_ps(fone, s2)));
+            if (out.nx) _mm256_storeu_ps(out.nx + i, _mm256_mul_ps(_mm256_xor_ps(gx, sign), inv));
+            if (out.ny) _mm256_storeu_ps(out.ny + i, inv);
+            if (out.nz) _mm256_storeu_ps(out.nz + i, _mm256_mul_ps(_mm256_xor_ps(gz, sign), inv));
+            if (out.slope) _mm256_storeu_ps(out.slope + i, _mm256_sqrt_ps(s2));
+        }
+        QueryScalar<Full>(c, x, z, i, n, out);
+    }
+#endif
+
+    template<bool Full>
+    void Dispatch(const Ctx& c, TerrainHeightField::Path path, const float* x, const float* z, size_t n, const HeightQueryOut& out)
+    {
+        switch (path) {
+#if JM_SIMD_X86
+        case TerrainHeightField::Path::AVX2:  QueryAVX2<Full>(c, x, z, n, out); break;
+        case TerrainHeightField::Path::SSE41: QuerySSE41<Full>(c, x, z, n, out); break;
+#endif
+        default:                              QueryScalar<Full>(c, x, z, 0, n, out); break;
+        }
+    }
+
+} // namespace
+
+TerrainHeightField::Path TerrainHeightField::Resolve(Path path)
+{
+#if JM_SIMD_X86
+    const Simd::CpuFeatures& cpu = Simd::Cpu();
+    if (path == Path::Auto) path = Path::AVX2;
+    if (path == Path::AVX2 && !cpu.avx2) path = Path::SSE41;
+    if (path == Path::SSE41 && !cpu.sse41) path = Path::Scalar;
+    return path;
+#else
+    (void)path;
+    return Path::Scalar;
+#endif
+}
+
+const char* TerrainHeightField::PathName(Path path)
+{
+    switch (path) {
+    case Path::Scalar: return "Scalar";
+    case Path::SSE41:  return "SSE4.1";
+    case Path::AVX2:   return "AVX2";
+    default:           return "Auto";
+    }
+}
+
+bool TerrainHeightField::Init(const uint8_t* heights, int w, int h, float gridSizeX, float gridSizeZ, float heightScale)
+{
+    Clear();
+    // ̿ ؼ     ʵ 2 ̻
+    if (!heights || w < 2 || h < 2) return false;
+    mTexels.resize((size_t)w * h);
+    for (size_t i = 0; i < mTexels.size(); ++i) mTexels[i] = heights[i] * (1.0f / 255.0f);
+    mW = w; mH = h;
+    SetGridSize(gridSizeX, gridSizeZ);
+    mHeightScale = heightScale;
+    return true;
+}
+
+void TerrainHeightField::SetRows(const uint8_t* heights, int y0, int y1)
+{
+    y0 = std::max(y0, 0); y1 = std::min(y1, mH);
+    if (!heights) return;
+    for (size_t i = (size_t)y0 * mW; i < (size_t)y1 * mW; ++i) mTexels[i] = heights[i] * (1.0f / 255.0f);
+}
+
+void TerrainHeightField::Clear()
+{
+    mTexels.clear();
+    mTexels.shrink_to_fit();
+    mW = mH = 0;
+}
+
+void TerrainHeightField::SetGridSize(float x, float z)
+{
+    mGridX = std::max(x, 1e-6f);
+    mGridZ = std::max(z, 1e-6f);
+}
+
+float TerrainHeightField::HeightAt(float x, float z) const
+{
+    float h = 0.0f;
+    HeightQueryOut out;
+    out.height = &h;
+    Query(&x, &z, 1, out, Path::Scalar);
+    return h;
+}
+
+void TerrainHeightField::NormalAt(float x, float z, float n[3]) const
+{
+    n[0] = 0.0f; n[1] = 1.0f; n[2] = 0.0f;
+    HeightQueryOut out;
+    out.nx = &n[0]; out.ny = &n[1]; out.nz = &n[2];
+    Query(&x, &z, 1, out, Path::Scalar);
+}
+
+void TerrainHeightField::Query(const float* x, const float* z, size_t n, const HeightQueryOut& out, Path path) const
+{
+    if (Empty() || n == 0) return;
+    Ctx c;
+    c.texels = mTexels.data();
+    c.w = mW; c.h = mH;
+    c.fw = (float)mW; c.fh = (float)mH;
+    c.invGridX = 1.0f / mGridX; c.invGridZ = 1.0f / mGridZ;
+    c.heightScale = mHeightScale;
+    c.kx = mHeightScale * (float)mW / mGridX;
+    c.kz = mHeightScale * (float)mH / mGridZ;
+
+    path = Resolve(path);
+    if (out.nx || out.ny || out.nz || out.slope) Dispatch<true>(c, path, x, z, n, out);
+    else if (out.height) Dispatch<false>(c, path, x, z, n, out);
+}
+
+TerrainHeightField::BenchResult TerrainHeightField::Benchmark(size_t count, Path path, int iterations) const
+{
+    BenchResult r;
+    if (Empty() || count == 0) return r;
+    r.queries = count;
+
+    std::vector<float> x(count), z(count);
+    std::mt19937 rng(4321);
+    std::uniform_real_distribution<float> px(-0.75f * mGridX, 0.75f * mGridX), pz(-0.75f * mGridZ, 0.75f * mGridZ);
+    for (size_t i = 0; i < count; ++i) { x[i] = px(rng); z[i] = pz(rng); }
+
+    // [0]: Į , [1]:  
+    std::vector<float> buf[2][5];
+    HeightQueryOut outs[2];
+    for (int k = 0; k < 2; ++k) {
+        for (auto& b : buf[k]) b.assign(count, 0.0f);
+        outs[k] = { buf[k][0].data(), buf[k][1].data(), buf[k][2].data(), buf[k][3].data(), buf[k][4].data() };
+    }
+    HeightQueryOut heightOnly;
+    heightOnly.height = outs[1].height;
+
+    auto time = [&](auto&& fn) {
+        double best = 1e30;
+        for (int i = 0; i < std::max(1, iterations); ++i) {
+            auto t0 = std::chrono::steady_clock::now();
+            fn();
+            best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count());
+        }
+        return best;
+    };
+
+    Query(x.data(), z.data(), count, outs[0], Path::Scalar);
+    r.heightMs = time([&] { Query(x.data(), z.data(), count, heightOnly, path); });
+    for (size_t i = 0; i < count; ++i) r.mismatches += std::memcmp(&buf[0][0][i], &buf[1][0][i], 4) != 0;
+    r.fullMs = time([&] { Query(x.data(), z.data(), count, outs[1], path); });
+    for (int k = 0; k < 5; ++k)
+        for (size_t i = 0; i < count; ++i) r.mismatches += std::memcmp(&buf[0][k][i], &buf[1][k][i], 4) != 0;
+
+    r.mqueriesPerSec = r.heightMs > 0.0 ? (double)count / (r.heightMs * 1000.0) : 0.0;
+    r.mqueriesPerSecFull = r.fullMs > 0.0 ? (double)count / (r.fullMs * 1000.0) : 0.0;
+    return r;
+}
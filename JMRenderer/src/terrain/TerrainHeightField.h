@@ -0,0 +1,71 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// CPU : GPU  R8 ̸ 纻 "  ̴?" 
+// ǥ/ʹ terrain_vs.hlsl 
+//   uv = xz / GridSize + 0.5 (  ߽), ؼ ߽  ּ, WRAP ּ
+//    =  * HeightScale
+//    = /Ʒ ؼ ̿   (NormalFromHeights)
+// D3D  . ġ Ǵ SoA Է 8(AVX2)/4(SSE4.1) óϰ ο ϰ  
+
+// ġ   (SoA, ʿ  迭 nullptr)
+struct HeightQueryOut {
+    float* height = nullptr;
+    float* nx = nullptr;
+    float* ny = nullptr;
+    float* nz = nullptr;
+    float* slope = nullptr;     // || = rise/run (0 = , 1 = 45)
+};
+
+class TerrainHeightField {
+public:
+    enum class Path { Auto, Scalar, SSE41, AVX2 };
+
+    static Path Resolve(Path path);
+    static const char* PathName(Path path);
+
+    // heights: R8 w*h (top-down, BMP::DecodeR8 / AssetManager cpuPixels  ġ)
+    bool Init(const uint8_t* heights, int w, int h, float gridSizeX, float gridSizeZ, float heightScale);
+    void Clear();
+    bool Empty() const { return mTexels.empty(); }
+    // heights(Init  w*h ü ̹)  [y0, y1) ٽ д´ ( ε)
+    void SetRows(const uint8_t* heights, int y0, int y1);
+
+    //   ٲ  ִ  (HUD ̴)
+    void SetGridSize(float x, float z);
+    void SetHeightScale(float s) { mHeightScale = s; }
+
+    int Width() const { return mW; }
+    int Height() const { return mH; }
+    const float* Texels() const { return mTexels.data(); }
+    float GridSizeX() const { return mGridX; }
+    float GridSizeZ() const { return mGridZ; }
+    float HeightScale() const { return mHeightScale; }
+
+    //   (Į )
+    float HeightAt(float x, float z) const;
+    void NormalAt(float x, float z, float n[3]) const;
+
+    // n  (x[i], z[i])  out 迭. /⸦   ̸ (̿  )
+    void Query(const float* x, const float* z, size_t n, const HeightQueryOut& out, Path path = Path::Auto) const;
+
+    struct BenchResult {
+        size_t queries = 0;
+        double heightMs = 0.0;          // ̸
+        double fullMs = 0.0;            //  +  + 
+        double mqueriesPerSec = 0.0;    // ̸ 
+        double mqueriesPerSecFull = 0.0;
+        size_t mismatches = 0;          // Į ٸ   (float Ʈ )
+    };
+
+    //   1.5 ȿ  õ count  ̾  ( ھ)
+    BenchResult Benchmark(size_t count, Path path, int iterations = 4) const;
+
+private:
+    std::vector<float> mTexels;     // 0~1 (R8_UNORM  )
+    int mW = 0, mH = 0;
+    float mGridX = 1.0f, mGridZ = 1.0f;
+    float mHeightScale = 1.0f;
+};
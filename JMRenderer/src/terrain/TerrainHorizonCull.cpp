@@ -0,0 +1,233 @@
+#include "TerrainHorizonCull.h"
+#include "TerrainHeightField.h"
+#include "TerrainPicker.h"
+#include "../utils/FrustumCull.h"
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+    constexpr float kPi = 3.14159265358979323846f;
+
+    // ī޶󿡼   簢  Ÿ/ 
+    struct RectView {
+        bool  inside;       // ī޶ XZ 簢 
+        float dNear;        //   
+        float dMax;         //   𼭸
+        float dExit;        // 簢  ü  Ÿ  (  ּ Ÿ)
+        float azLo, azHi;   //  (, azLo <= azHi,  < pi)
+    };
+
+    inline float SegDist(float px, float pz, float a, float b0, float b1, bool alongZ)
+    {
+        // alongZ: x = a, z  [b0, b1] / ƴϸ z = a, x  [b0, b1]
+        const float u = alongZ ? pz : px, v = alongZ ? px : pz;
+        const float du = u < b0 ? b0 - u : (u > b1 ? u - b1 : 0.0f);
+        return std::sqrt(du * du + (v - a) * (v - a));
+    }
+
+    RectView Measure(float cx, float cz, const TerrainDraw& d)
+    {
+        const float x0 = d.x, z0 = d.z, x1 = d.x + d.sizeX, z1 = d.z + d.sizeZ;
+        RectView r;
+        r.inside = cx >= x0 && cx <= x1 && cz >= z0 && cz <= z1;
+        const float nx = std::max(std::max(x0 - cx, cx - x1), 0.0f);
+        const float nz = std::max(std::max(z0 - cz, cz - z1), 0.0f);
+        r.dNear = std::sqrt(nx * nx + nz * nz);
+        const float fx = std::max(std::fabs(x0 - cx), std::fabs(x1 - cx));
+        const float fz = std::max(std::fabs(z0 - cz), std::fabs(z1 - cz));
+        r.dMax = std::sqrt(fx * fx + fz * fz);
+        r.azLo = r.azHi = 0.0f;
+        r.dExit = r.dMax;
+        if (r.inside) return r;
+
+        // ü ī޶  θ 
+        if (cx > x0) r.dExit = std::min(r.dExit, SegDist(cx, cz, x0, z0, z1, true));
+        if (cx < x1) r.dExit = std::min(r.dExit, SegDist(cx, cz, x1, z0, z1, true));
+        if (cz > z0) r.dExit = std::min(r.dExit, SegDist(cx, cz, z0, x0, x1, false));
+        if (cz < z1) r.dExit = std::min(r.dExit, SegDist(cx, cz, z1, x0, x1, false));
+
+        // ߽   𼭸    Ѵ
+        const float ac = std::atan2((z0 + z1) * 0.5f - cz, (x0 + x1) * 0.5f - cx);
+        float lo = 0.0f, hi = 0.0f;
+        const float xs[2] = { x0, x1 }, zs[2] = { z0, z1 };
+        for (int i = 0; i < 4; ++i) {
+            float a = std::atan2(zs[i >> 1] - cz, xs[i & 1] - cx) - ac;
+            if (a > kPi) a -= 2.0f * kPi;
+            if (a < -kPi) a += 2.0f * kPi;
+            lo = std::min(lo, a);
+            hi = std::max(hi, a);
+        }
+        r.azLo = ac + lo;
+        r.azHi = ac + hi;
+        return r;
+    }
+
+    inline int WrapBin(int k, int n) { k %= n; return k < 0 ? k + n : k; }
+
+} // namespace
+
+TerrainHorizonCull::TerrainHorizonCull(int bins)
+{
+    bins = std::max(bins, 16);
+    mTan.resize(bins);
+    mDist.resize(bins);
+}
+
+void TerrainHorizonCull::Cull(const HorizonCullParams& p, const std::vector<TerrainDraw>& draws, std::vector<uint32_t>& visible)
+{
+    const auto t0 = std::chrono::steady_clock::now();
+    mStats = {};
+    mStats.tested = (int)visible.size();
+
+    const float cx = p.camPos[0], cy = p.camPos[1], cz = p.camPos[2];
+    if (cx < p.minX || cx > p.maxX || cz < p.minZ || cz > p.maxZ || cy < p.groundY) {
+        mStats.skipped = true;
+        mStats.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        return;
+    }
+
+    const int bins = (int)mTan.size();
+    const float binW = 2.0f * kPi / bins, invBinW = 1.0f / binW;
+    const float eps = 1e-3f;    // ĭ  ݿø  (ĭ  )
+    std::fill(mTan.begin(), mTan.end(), -FLT_MAX);
+    std::fill(mDist.begin(), mDist.end(), 0.0f);
+
+    // 0: ü , 1: ˻ , 2: 
+    mInFrustum.assign(draws.size(), 0);
+    for (uint32_t i : visible) mInFrustum[i] = 1;
+
+    //   (ڰ  򼱿 )
+    mOrder.clear();
+    mOrder.reserve(draws.size());
+    for (uint32_t i = 0; i < (uint32_t)draws.size(); ++i)
+        mOrder.push_back({ Measure(cx, cz, draws[i]).dNear, i });
+    std::sort(mOrder.begin(), mOrder.end());
+
+    for (const auto& o : mOrder) {
+        const TerrainDraw& d = draws[o.second];
+        const RectView v = Measure(cx, cz, d);
+        if (v.inside) continue;     // ī޶ ߹ : ˻絵   
+        const float a0 = (v.azLo + kPi) * invBinW, a1 = (v.azHi + kPi) * invBinW;
+
+        // ˻:    Ӱ tan <= tanMax,  Ÿ >= dNear
+        if (mInFrustum[o.second] == 1) {
+            const float rise = d.maxY - cy;
+            const float tanMax = rise / (rise >= 0.0f ? v.dNear : v.dMax);
+            bool hidden = v.dNear > 0.0f;
+            for (int k = (int)std::floor(a0 - eps), k1 = (int)std::floor(a1 + eps); hidden && k <= k1; ++k) {
+                const int b = WrapBin(k, bins);
+                hidden = tanMax < mTan[b] && v.dNear >= mDist[b];
+            }
+            if (hidden) {
+                mInFrustum[o.second] = 2;
+                ++mStats.culled;
+            }
+        }
+
+        // : minY Ʒ  . ĭ    ü tan < drop/Ÿ  ȿ   
+        // ī޶󺸴   Ÿ ,    Ÿ  
+        const float drop = d.minY - cy;
+        const float tanOcc = drop / (drop < 0.0f ? v.dExit : v.dMax);
+        if (!(tanOcc > -FLT_MAX)) continue;
+        for (int k = (int)std::ceil(a0 + eps), k1 = (int)std::floor(a1 - eps) - 1; k <= k1; ++k) {
+            const int b = WrapBin(k, bins);
+            if (tanOcc > mTan[b]) {
+                mTan[b] = tanOcc;
+                mDist[b] = std::max(mDist[b], v.dMax);
+            }
+        }
+    }
+
+    visible.erase(std::remove_if(visible.begin(), visible.end(),
+        [&](uint32_t i) { return mInFrustum[i] == 2; }), visible.end());
+    mStats.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+TerrainHorizonCull::FlythroughResult TerrainHorizonCull::Flythrough(const TerrainQuadTree& tree, const TerrainHeightField& field,
+    const TerrainPicker& picker, const TerrainSelectParams& select, int frames, int samples)
+{
+    FlythroughResult r;
+    if (field.Empty() || picker.Empty() || frames <= 0) return r;
+    samples = std::max(samples, 2);
+
+    TerrainQuadTree t = tree;
+    const TerrainQuadTreeDesc& qd = t.Desc();
+    const float centerX = qd.originX + qd.sizeX * 0.5f, centerZ = qd.originZ + qd.sizeZ * 0.5f;
+    const float radius = 0.3f * std::min(qd.sizeX, qd.sizeZ);
+    const float eyeH = 0.02f * std::max(qd.sizeX, qd.sizeZ);
+
+    TerrainHorizonCull hc;
+    std::vector<TerrainDraw> draws;
+    std::vector<uint32_t> full, vis;
+    std::vector<uint8_t> culled;
+    AABBSoA boxes;
+    size_t tested = 0, refHidden = 0;
+    double sumMs = 0.0;
+
+    for (int f = 0; f < frames; ++f) {
+        //       ణ ٺ
+        const float a = 2.0f * kPi * f / frames;
+        float eye[3] = { centerX + radius * std::cos(a), 0.0f, centerZ + radius * std::sin(a) };
+        eye[1] = field.HeightAt(eye[0], eye[2]) + eyeH;
+        const float target[3] = { eye[0] - std::sin(a), eye[1] - 0.15f, eye[2] + std::cos(a) };
+        float vp[16];
+        Cull::LookAtViewProj(eye, target, select.fovY, 16.0f / 9.0f, 0.1f, 500.0f, vp);
+        const Frustum fr = Frustum::FromViewProj(vp);
+
+        TerrainSelectParams sp = select;
+        sp.camPos[0] = eye[0]; sp.camPos[1] = eye[1]; sp.camPos[2] = eye[2];
+        t.Select(sp, draws);
+
+        boxes.Clear();
+        boxes.Reserve(draws.size());
+        for (const TerrainDraw& d : draws) boxes.Push(d.x, d.minY, d.z, d.x + d.sizeX, d.maxY, d.z + d.sizeZ);
+        full.resize(draws.size());
+        full.resize(Cull::FrustumAABBs(fr, boxes, full.data()));
+
+        HorizonCullParams hp;
+        hp.camPos[0] = eye[0]; hp.camPos[1] = eye[1]; hp.camPos[2] = eye[2];
+        hp.groundY = eye[1] - eyeH;
+        hp.minX = qd.originX; hp.minZ = qd.originZ;
+        hp.maxX = qd.originX + qd.sizeX; hp.maxZ = qd.originZ + qd.sizeZ;
+        vis = full;
+        hc.Cull(hp, draws, vis);
+        const HorizonCullStats& s = hc.Stats();
+        sumMs += s.ms;
+        r.maxCulledPercent = std::max(r.maxCulledPercent, (double)s.CulledPercent());
+        tested += full.size();
+
+        culled.assign(draws.size(), 1);
+        for (uint32_t i : vis) culled[i] = 0;
+
+        // :  ǥ   ü ȿ      ϳ  
+        for (uint32_t i : full) {
+            const TerrainDraw& d = draws[i];
+            bool seen = false;
+            for (int sz = 0; sz < samples && !seen; ++sz) {
+                for (int sx = 0; sx < samples && !seen; ++sx) {
+                    const float px = d.x + d.sizeX * sx / (samples - 1);
+                    const float pz = d.z + d.sizeZ * sz / (samples - 1);
+                    const float py = field.HeightAt(px, pz) + 1e-3f;
+                    bool inside = true;
+                    for (const auto& pl : fr.planes) inside &= pl[0] * px + pl[1] * py + pl[2] * pz + pl[3] >= 0.0f;
+                    if (!inside) continue;
+                    TerrainRay ray{ { eye[0], eye[1], eye[2] }, { px - eye[0], py - eye[1], pz - eye[2] } };
+                    const float dist = std::sqrt(ray.dir[0] * ray.dir[0] + ray.dir[1] * ray.dir[1] + ray.dir[2] * ray.dir[2]);
+                    ++r.samples;
+                    seen = !picker.Pick(ray, dist - 1e-3f).hit;
+                }
+            }
+            refHidden += !seen;
+            r.violations += seen && culled[i];
+        }
+        r.avgCulledPercent += s.CulledPercent();
+        ++r.frames;
+    }
+    r.avgCulledPercent /= r.frames;
+    r.avgMs = sumMs / r.frames;
+    r.refHiddenPercent = tested ? 100.0 * refHidden / tested : 0.0;
+    return r;
+}
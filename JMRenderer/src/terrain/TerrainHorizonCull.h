@@ -0,0 +1,67 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "TerrainQuadTree.h"
+
+class TerrainHeightField;
+class TerrainPicker;
+
+//   ø (CPU, ü ø  ܰ)
+// ī޶ ֺ  binsĭ  1D  ۿ " (tan Ӱ) Ʒ " 
+// 带   
+//   ˻:  ְ(maxY)  ִ Ӱ ġ  ĭ  Ʒ 
+//   :  (minY) Ʒ   ̹Ƿ,    ĭ  ø
+// ڴ , ˻ ְ Ƿ  (̴   )
+// : ī޶  簢 ,   (ƴϸ ǳʶ)
+
+struct HorizonCullParams {
+    float camPos[3] = { 0, 0, 0 };
+    float groundY = 0.0f;                   // ī޶ XZ  
+    float minX = -5.0f, minZ = -5.0f;       //  簢
+    float maxX = 5.0f, maxZ = 5.0f;
+};
+
+struct HorizonCullStats {
+    int    tested = 0;      // Է (ü ) 
+    int    culled = 0;
+    bool   skipped = false; //  Ҹ (ī޶  /Ʒ)
+    double ms = 0.0;
+
+    float CulledPercent() const { return tested ? 100.0f * culled / tested : 0.0f; }
+};
+
+class TerrainHorizonCull {
+public:
+    explicit TerrainHorizonCull(int bins = 1024);
+
+    // draws: ̹  õ  ü ( ڷ )
+    // visible: ü  draws ε      
+    void Cull(const HorizonCullParams& p, const std::vector<TerrainDraw>& draws, std::vector<uint32_t>& visible);
+
+    const HorizonCullStats& Stats() const { return mStats; }
+    int Bins() const { return (int)mTan.size(); }
+
+    struct FlythroughResult {
+        int    frames = 0;
+        double avgCulledPercent = 0.0;
+        double maxCulledPercent = 0.0;
+        double refHiddenPercent = 0.0;  //  ˻     (ø )
+        double avgMs = 0.0;
+        size_t samples = 0;             //  ˻  
+        size_t violations = 0;          // µ  ˻ ̴   (0̾ )
+    };
+
+    //     θ frames    LOD   ü   ø 
+    // ü    ǥ samples x samples  ŷ  ˻ ( )
+    // tree ؼ . select camPos 
+    static FlythroughResult Flythrough(const TerrainQuadTree& tree, const TerrainHeightField& field,
+        const TerrainPicker& picker, const TerrainSelectParams& select, int frames = 120, int samples = 7);
+
+private:
+    std::vector<float> mTan;        // ĭ   (̺  ü )
+    std::vector<float> mDist;       // ĭ  ִ  Ÿ (̺  忡 )
+    std::vector<std::pair<float, uint32_t>> mOrder;
+    std::vector<uint8_t> mInFrustum;
+    HorizonCullStats mStats;
+};
@@ -0,0 +1,542 @@
+#include "TerrainNoise.h"
+#include "../utils/JobSystem.h"
+#include "../utils/Simd.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+//  δ   (FMA )  Į Ʈ  
+namespace {
+
+    constexpr int kMaxOctaves = 16;
+    constexpr int kWarpOctaves = 4;     //  ̾ ĸ
+    constexpr int kTile = 64;
+
+    //    0~1 (   )
+    constexpr float kFbmScale = 1.1f;
+    constexpr float kRidgedScale = 1.4f, kRidgedBias = -0.31f;
+
+    struct Octave {
+        float    period;    //  ü  ĭ  (float)
+        int32_t  periodI;
+        float    amp;
+    };
+
+    struct Ctx {
+        NoiseType type = NoiseType::FBm;
+        int count = 0, warpCount = 0;
+        Octave oct[kMaxOctaves];
+        uint32_t seed[3][kMaxOctaves];      // [̾: ü/X/Y][Ÿ]
+        float invNorm = 1.0f, warpInvNorm = 1.0f;
+        float warp = 0.0f;
+        float invW = 1.0f, invH = 1.0f;
+    };
+
+    Ctx MakeCtx(const NoiseParams& p, int w, int h)
+    {
+        Ctx c;
+        c.type = p.type;
+        c.warp = p.warp;
+        c.invW = 1.0f / (float)std::max(w, 1);
+        c.invH = 1.0f / (float)std::max(h, 1);
+
+        //  ػ  Ѵ ļ ؼ ̿ Ƿ ڸ
+        const double nyquist = std::max(2, std::max(w, h) / 2);
+        double cells = std::max(1, p.baseCells);
+        float amp = 1.0f, norm = 0.0f, warpNorm = 0.0f;
+        for (int o = 0; o < std::min(p.octaves, kMaxOctaves); ++o) {
+            const int32_t period = (int32_t)std::lround(cells);
+            if (o > 0 && period > nyquist) break;
+            c.oct[o] = { (float)period, period, amp };
+            for (int l = 0; l < 3; ++l)
+                c.seed[l][o] = p.seed * 0x9E3779B1u + (uint32_t)l * 0x85EBCA77u + (uint32_t)o * 0xC2B2AE3Du;
+            norm += amp;
+            if (o < kWarpOctaves) warpNorm += amp;
+            amp *= p.gain;
+            cells *= std::max(1.0f, p.lacunarity);
+            ++c.count;
+        }
+        c.warpCount = std::min(c.count, kWarpOctaves);
+        c.invNorm = norm > 0.0f ? 1.0f / norm : 1.0f;
+        c.warpInvNorm = warpNorm > 0.0f ? 1.0f / warpNorm : 1.0f;
+        return c;
+    }
+
+    //  Į ( ) 
+    inline uint32_t Hash(int32_t ix, int32_t iy, uint32_t seed)
+    {
+        uint32_t h = seed ^ ((uint32_t)ix * 0x27D4EB2Du) ^ ((uint32_t)iy * 0x165667B1u);
+        h ^= h >> 15; h *= 0x2C1B3C6Du;
+        h ^= h >> 12; h *= 0x297A2D39u;
+        h ^= h >> 15;
+        return h;
+    }
+
+    // 8 ׷Ʈ: (1, 0.5), (0.5, 1)
+    inline float Grad(uint32_t h, float x, float y)
+    {
+        const float u = (h & 4) ? y : x;
+        const float v = (h & 4) ? x : y;
+        const float a = (h & 1) ? -u : u;
+        const float hv = v * 0.5f;
+        const float b = (h & 2) ? -hv : hv;
+        return a + b;
+    }
+
+    inline float Fade(float t) { return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f); }
+
+    //  ǥ ֱ  (ֱ⺸ ū  µ ó)
+    inline int32_t WrapCell(float f, const Octave& o)
+    {
+        return (int32_t)(f - o.period * std::floor(f / o.period));
+    }
+
+    float Noise(float x, float y, const Octave& o, uint32_t seed)
+    {
+        const float fx = std::floor(x), fy = std::floor(y);
+        const float tx = x - fx, ty = y - fy;
+        const int32_t x0 = WrapCell(fx, o), y0 = WrapCell(fy, o);
+        int32_t x1 = x0 + 1, y1 = y0 + 1;
+        if (x1 == o.periodI) x1 = 0;
+        if (y1 == o.periodI) y1 = 0;
+
+        const float n00 = Grad(Hash(x0, y0, seed), tx, ty);
+        const float n10 = Grad(Hash(x1, y0, seed), tx - 1.0f, ty);
+        const float n01 = Grad(Hash(x0, y1, seed), tx, ty - 1.0f);
+        const float n11 = Grad(Hash(x1, y1, seed), tx - 1.0f, ty - 1.0f);
+
+        const float sx = Fade(tx), sy = Fade(ty);
+        const float a = n00 + (n10 - n00) * sx;
+        const float b = n01 + (n11 - n01) * sx;
+        return a + (b - a) * sy;
+    }
+
+    float Fbm(const Ctx& c, int layer, int count, float invNorm, float u, float v)
+    {
+        float sum = 0.0f;
+        for (int o = 0; o < count; ++o) {
+            const Octave& oc = c.oct[o];
+            sum = sum + Noise(u * oc.period, v * oc.period, oc, c.seed[layer][o]) * oc.amp;
+        }
+        return sum * invNorm;
+    }
+
+    float Ridged(const Ctx& c, float u, float v)
+    {
+        float sum = 0.0f, weight = 1.0f;
+        for (int o = 0; o < c.count; ++o) {
+            const Octave& oc = c.oct[o];
+            float r = 1.0f - std::fabs(Noise(u * oc.period, v * oc.period, oc, c.seed[0][o]));
+            r = r * r;
+            r = r * weight;
+            weight = std::min(std::max(r * 2.0f, 0.0f), 1.0f);
+            sum = sum + r * oc.amp;
+        }
+        return sum * c.invNorm;
+    }
+
+    float Value(const Ctx& c, float u, float v)
+    {
+        float r;
+        switch (c.type) {
+        case NoiseType::Ridged:
+            r = Ridged(c, u, v) * kRidgedScale + kRidgedBias;
+            break;
+        case NoiseType::DomainWarp: {
+            const float qx = Fbm(c, 1, c.warpCount, c.warpInvNorm, u, v);
+            const float qy = Fbm(c, 2, c.warpCount, c.warpInvNorm, u, v);
+            r = Fbm(c, 0, c.count, c.invNorm, u + c.warp * qx, v + c.warp * qy) * kFbmScale + 0.5f;
+            break;
+        }
+        default:
+            r = Fbm(c, 0, c.count, c.invNorm, u, v) * kFbmScale + 0.5f;
+            break;
+        }
+        return std::min(std::max(r, 0.0f), 1.0f);
+    }
+
+    void RowScalar(const Ctx& c, int x0, int n, float v, float* out)
+    {
+        for (int i = 0; i < n; ++i)
+            out[i] = Value(c, ((float)(x0 + i) + 0.5f) * c.invW, v);
+    }
+
+#if JM_SIMD_X86
+    //  SSE4.1 (4) 
+    JM_TARGET_SSE41 inline __m128i Hash4(__m128i ix, __m128i iy, __m128i seed)
+    {
+        __m128i h = _mm_xor_si128(_mm_xor_si128(seed, _mm_mullo_epi32(ix, _mm_set1_epi32((int)0x27D4EB2Du))),
+            _mm_mullo_epi32(iy, _mm_set1_epi32((int)0x165667B1u)));
+        h = _mm_xor_si128(h, _mm_srli_epi32(h, 15)); h = _mm_mullo_epi32(h, _mm_set1_epi32((int)0x2C1B3C6Du));
+        h = _mm_xor_si128(h, _mm_srli_epi32(h, 12)); h = _mm_mullo_epi32(h, _mm_set1_epi32((int)0x297A2D39u));
+        return _mm_xor_si128(h, _mm_srli_epi32(h, 15));
+    }
+
+    JM_TARGET_SSE41 inline __m128 Grad4(__m128i h, __m128 x, __m128 y)
+    {
+        const __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(h, _mm_set1_epi32(4)), _mm_set1_epi32(4)));
+        const __m128 u = _mm_blendv_ps(x, y, swap);
+        const __m128 v = _mm_blendv_ps(y, x, swap);
+        const __m128 su = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(1)), 31));
+        const __m128 sv = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(2)), 30));
+        return _mm_add_ps(_mm_xor_ps(u, su), _mm_xor_ps(_mm_mul_ps(v, _mm_set1_ps(0.5f)), sv));
+    }
+
+    JM_TARGET_SSE41 inline __m128 Fade4(__m128 t)
+    {
+        const __m128 p = _mm_add_ps(_mm_mul_ps(t, _mm_sub_ps(_mm_mul_ps(t, _mm_set1_ps(6.0f)), _mm_set1_ps(15.0f))), _mm_set1_ps(10.0f));
+        return _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(t, t), t), p);
+    }
+
+    JM_TARGET_SSE41 inline __m128i WrapCell4(__m128 f, __m128 period)
+    {
+        return _mm_cvttps_epi32(_mm_sub_ps(f, _mm_mul_ps(period, _mm_floor_ps(_mm_div_ps(f, period)))));
+    }
+
+    JM_TARGET_SSE41 __m128 Noise4(__m128 x, __m128 y, const Octave& o, uint32_t seed)
+    {
+        const __m128 period = _mm_set1_ps(o.period);
+        const __m128i periodI = _mm_set1_epi32(o.periodI), one = _mm_set1_epi32(1);
+        const __m128 fx = _mm_floor_ps(x), fy = _mm_floor_ps(y);
+        const __m128 tx = _mm_sub_ps(x, fx), ty = _mm_sub_ps(y, fy);
+        const __m128i x0 = WrapCell4(fx, period), y0 = WrapCell4(fy, period);
+        __m128i x1 = _mm_add_epi32(x0, one), y1 = _mm_add_epi32(y0, one);
+        x1 = _mm_andnot_si128(_mm_cmpeq_epi32(x1, periodI), x1);
+        y1 = _mm_andnot_si128(_mm_cmpeq_epi32(y1, periodI), y1);
+
+        const __m128i s = _mm_set1_epi32((int)seed);
+        const __m128 fone = _mm_set1_ps(1.0f);
+        const __m128 tx1 = _mm_sub_ps(tx, fone), ty1 = _mm_sub_ps(ty, fone);
+        const __m128 n00 = Grad4(Hash4(x0, y0, s), tx, ty);
+        const __m128 n10 = Grad4(Hash4(x1, y0, s), tx1, ty);
+        const __m128 n01 = Grad4(Hash4(x0, y1, s), tx, ty1);
+        const __m128 n11 = Grad4(Hash4(x1, y1, s), tx1, ty1);
+
+        const __m128 sx = Fade4(tx), sy = Fade4(ty);
+        const __m128 a = _mm_add_ps(n00, _mm_mul_ps(_mm_sub_ps(n10, n00), sx));
+        const __m128 b = _mm_add_ps(n01, _mm_mul_ps(_mm_sub_ps(n11, n01), sx));
+        return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), sy));
+    }
+
+    JM_TARGET_SSE41 __m128 Fbm4(const Ctx& c, int layer, int count, float invNorm, __m128 u, __m128 v)
+    {
+        __m128 sum = _mm_setzero_ps();
+        for (int o = 0; o < count; ++o) {
+            const Octave& oc = c.oct[o];
+            const __m128 per = _mm_set1_ps(oc.period);
+            const __m128 n = Noise4(_mm_mul_ps(u, per), _mm_mul_ps(v, per), oc, c.seed[layer][o]);
+            sum = _mm_add_ps(sum, _mm_mul_ps(n, _mm_set1_ps(oc.amp)));
+        }
+        return _mm_mul_ps(sum, _mm_set1_ps(invNorm));
+    }
+
+    JM_TARGET_SSE41 __m128 Ridged4(const Ctx& c, __m128 u, __m128 v)
+    {
+        const __m128 fone = _mm_set1_ps(1.0f), two = _mm_set1_ps(2.0f), zero = _mm_setzero_ps();
+        const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+        __m128 sum = zero, weight = fone;
+        for (int o = 0; o < c.count; ++o) {
+            const Octave& oc = c.oct[o];
+            const __m128 per = _mm_set1_ps(oc.period);
+            const __m128 n = Noise4(_mm_mul_ps(u, per), _mm_mul_ps(v, per), oc, c.seed[0][o]);
+            __m128 r = _mm_sub_ps(fone, _mm_and_ps(n, absMask));
+            r = _mm_mul_ps(r, r);
+            r = _mm_mul_ps(r, weight);
+            weight = _mm_min_ps(_mm_max_ps(_mm_mul_ps(r, two), zero), fone);
+            sum = _mm_add_ps(sum, _mm_mul_ps(r, _mm_set1_ps(oc.amp)));
+        }
+        return _mm_mul_ps(sum, _mm_set1_ps(c.invNorm));
+    }
+
+    JM_TARGET_SSE41 void RowSSE41(const Ctx& c, int x0, int n, float v, float* out)
+    {
+        const __m128 vv = _mm_set1_ps(v), invW = _mm_set1_ps(c.invW), half = _mm_set1_ps(0.5f);
+        const __m128 zero = _mm_setzero_ps(), fone = _mm_set1_ps(1.0f);
+        int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            const __m128i xi = _mm_add_epi32(_mm_set1_epi32(x0 + i), _mm_setr_epi32(0, 1, 2, 3));
+            const __m128 u = _mm_mul_ps(_mm_add_ps(_mm_cvtepi32_ps(xi), half), invW);
+            __m128 r;
+            switch (c.type) {
+            case NoiseType::Ridged:
+                r = _mm_add_ps(_mm_mul_ps(Ridged4(c, u, vv), _mm_set1_ps(kRidgedScale)), _mm_set1_ps(kRidgedBias));
+                break;
+            case NoiseType::DomainWarp: {
+                const __m128 w = _mm_set1_ps(c.warp);
+                const __m128 qx = Fbm4(c, 1, c.warpCount, c.warpInvNorm, u, vv);
+                const __m128 qy = Fbm4(c, 2, c.warpCount, c.warpInvNorm, u, vv);
+                r = Fbm4(c, 0, c.count, c.invNorm, _mm_add_ps(u, _mm_mul_ps(w, qx)), _mm_add_ps(vv, _mm_mul_ps(w, qy)));
+                r = _mm_add_ps(_mm_mul_ps(r, _mm_set1_ps(kFbmScale)), half);
+                break;
+            }
+            default:
+                r = _mm_add_ps(_mm_mul_ps(Fbm4(c, 0, c.count, c.invNorm, u, vv), _mm_set1_ps(kFbmScale)), half);
+                break;
+            }
+            _mm_storeu_ps(out + i, _mm_min_ps(_mm_max_ps(r, zero), fone));
+        }
+        RowScalar(c, x0 + i, n - i, v, out + i);
+    }
+
+    //  AVX2 (8) 
+    JM_TARGET_AVX2 inline __m256i Hash8(__m256i ix, __m256i iy, __m256i seed)
+    {
+        __m256i h = _mm256_xor_si256(_mm256_xor_si256(seed, _mm256_mullo_epi32(ix, _mm256_set1_epi32((int)0x27D4EB2Du))),
+            _mm256_mullo_epi32(iy, _mm256_set1_epi32((int)0x165667B1u)));
+        h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 15)); h = _mm256_mullo_epi32(h, _mm256_set1_epi32((int)0x2C1B3C6Du));
+        h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 12)); h = _mm256_mullo_epi32(h, _mm256_set1_epi32((int)0x297A2D39u));
+        return _mm256_xor_si256(h, _mm256_srli_epi32(h, 15));
+    }
+
+    JM_TARGET_AVX2 inline __m256 Grad8(__m256i h, __m256 x, __m256 y)
+    {
+        const __m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(h, _mm256_set1_epi32(4)), _mm256_set1_epi32(4)));
+        const __m256 u = _mm256_blendv_ps(x, y, swap);
+        const __m256 v = _mm256_blendv_ps(y, x, swap);
+        const __m256 su = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(1)), 31));
+        const __m256 sv = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(2)), 30));
+        return _mm256_add_ps(_mm256_xor_ps(u, su), _mm256_xor_ps(_mm256_mul_ps(v, _mm256_set1_ps(0.5f)), sv));
+    }
+
+    JM_TARGET_AVX2 inline __m256 Fade8(__m256 t)
+    {
+        const __m256 p = _mm256_add_ps(_mm256_mul_ps(t, _mm256_sub_ps(_mm256_mul_ps(t, _mm256_set1_ps(6.0f)), _mm256_set1_ps(15.0f))), _mm256_set1_ps(10.0f));
+        return _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(t, t), t), p);
+    }
+
+    JM_TARGET_AVX2 inline __m256i WrapCell8(__m256 f, __m256 period)
+    {
+        return _mm256_cvttps_epi32(_mm256_sub_ps(f, _mm256_mul_ps(period, _mm256_floor_ps(_mm256_div_ps(f, period)))));
+    }
+
+    JM_TARGET_AVX2 __m256 Noise8(__m256 x, __m256 y, const Octave& o, uint32_t seed)
+    {
+        const __m256 period = _mm256_set1_ps(o.period);
+        const __m256i periodI = _mm256_set1_epi32(o.periodI), one = _mm256_set1_epi32(1);
+        const __m256 fx = _mm256_floor_ps(x), fy = _mm256_floor_ps(y);
+        const __m256 tx = _mm256_sub_ps(x, fx), ty = _mm256_sub_ps(y, fy);
+        const __m256i x0 = WrapCell8(fx, period), y0 = WrapCell8(fy, period);
+        __m256i x1 = _mm256_add_epi32(x0, one), y1 = _mm256_add_epi32(y0, one);
+        x1 = _mm256_andnot_si256(_mm256_cmpeq_epi32(x1, periodI), x1);
+        y1 = _mm256_andnot_si256(_mm256_cmpeq_epi32(y1, periodI), y1);
+
+        const __m256i s = _mm256_set1_epi32((int)seed);
+        const __m256 fone = _mm256_set1_ps(1.0f);
+        const __m256 tx1 = _mm256_sub_ps(tx, fone), ty1 = _mm256_sub_ps(ty, fone);
+        const __m256 n00 = Grad8(Hash8(x0, y0, s), tx, ty);
+        const __m256 n10 = Grad8(Hash8(x1, y0, s), tx1, ty);
+        const __m256 n01 = Grad8(Hash8(x0, y1, s), tx, ty1);
+        const __m256 n11 = Grad8(Hash8(x1, y1, s), tx1, ty1);
+
+        const __m256 sx = Fade8(tx), sy = Fade8(ty);
+        const __m256 a = _mm256_add_ps(n00, _mm256_mul_ps(_mm256_sub_ps(n10, n00), sx));
+        const __m256 b = _mm256_add_ps(n01, _mm256_mul_ps(_mm256_sub_ps(n11, n01), sx));
+        return _mm256_add_ps(a, _mm256_mul_ps(_mm256_sub_ps(b, a), sy));
+    }
+
+    JM_TARGET_AVX2 __m256 Fbm8(const Ctx& c, int layer, int count, float invNorm, __m256 u, __m256 v)
+    {
+        __m256 sum = _mm256_setzero_ps();
+        for (int o = 0; o < count; ++o) {
+            const Octave& oc = c.oct[o];
+            const __m256 per = _mm256_set1_ps(oc.period);
+            const __m256 n = Noise8(_mm256_mul_ps(u, per), _mm256_mul_ps(v, per), oc, c.seed[layer][o]);
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(n, _mm256_set1_ps(oc.amp)));
+        }
+        return _mm256_mul_ps(sum, _mm256_set1_ps(invNorm));
+    }
+
+    JM_TARGET_AVX2 __m256 Ridged8(const Ctx& c, __m256 u, __m256 v)
+    {
+        const __m256 fone = _mm256_set1_ps(1.0f), two = _mm256_set1_ps(2.0f), zero = _mm256_setzero_ps();
+        const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+        __m256 sum = zero, weight = fone;
+        for (int o = 0; o < c.count; ++o) {
+            const Octave& oc = c.oct[o];
+            const __m256 per = _mm256_set1_ps(oc.period);
+            const __m256 n = Noise8(_mm256_mul_ps(u, per), _mm256_mul_ps(v, per), oc, c.seed[0][o]);
+            __m256 r = _mm256_sub_ps(fone, _mm256_and_ps(n, absMask));
+            r = _mm256_mul_ps(r, r);
+            r = _mm256_mul_ps(r, weight);
+            weight = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(r, two), zero), fone);
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(r, _mm256_set1_ps(oc.amp)));
+        }
+        return _mm256_mul_ps(sum, _mm256_set1_ps(c.invNorm));
+    }
+
+    JM_TARGET_AVX2 void RowAVX2(const Ctx& c, int x0, int n, float v, float* out)
+    {
+        const __m256 vv = _mm256_set1_ps(v), invW = _mm256_set1_ps(c.invW), half = _mm256_set1_ps(0.5f);
+        const __m256 zero = _mm256_setzero_ps(), fone = _mm256_set1_ps(1.0f);
+        int i = 0;
+        for (; i + 8 <= n; i += 8) {
+            const __m256i xi = _mm256_add_epi32(_mm256_set1_epi32(x0 + i), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+            const __m256 u = _mm256_mul_ps(_mm256_add_ps(_mm256_cvtepi32_ps(xi), half), invW);
+            __m256 r;
+            switch (c.type) {
+            case NoiseType::Ridged:
+                r = _mm256_add_ps(_mm256_mul_ps(Ridged8(c, u, vv), _mm256_set1_ps(kRidgedScale)), _mm256_set1_ps(kRidgedBias));
+                break;
+            case NoiseType::DomainWarp: {
+                const __m256 w = _mm256_set1_ps(c.warp);
+                const __m256 qx = Fbm8(c, 1, c.warpCount, c.warpInvNorm, u, vv);
+                const __m256 qy = Fbm8(c, 2, c.warpCount, c.warpInvNorm, u, vv);
+                r = Fbm8(c, 0, c.count, c.invNorm, _mm256_add_ps(u, _mm256_mul_ps(w, qx)), _mm256_add_ps(vv, _mm256_mul_ps(w, qy)));
+                r = _mm256_add_ps(_mm256_mul_ps(r, _mm256_set1_ps(kFbmScale)), half);
+                break;
+            }
+            default:
+                r = _mm256_add_ps(_mm256_mul_ps(Fbm8(c, 0, c.count, c.invNorm, u, vv), _mm256_set1_ps(kFbmScale)), half);
+                break;
+            }
+            _mm256_storeu_ps(out + i, _mm256_min_ps(_mm256_max_ps(r, zero), fone));
+        }
+        RowScalar(c, x0 + i, n - i, v, out + i);
+    }
+#endif
+
+    void Row(const Ctx& c, TerrainNoise::Path path, int x0, int n, int y, float* out)
+    {
+        const float v = ((float)y + 0.5f) * c.invH;
+        switch (path) {
+#if JM_SIMD_X86
+        case TerrainNoise::Path::AVX2:  RowAVX2(c, x0, n, v, out); break;
+        case TerrainNoise::Path::SSE41: RowSSE41(c, x0, n, v, out); break;
+#endif
+        default:                        RowScalar(c, x0, n, v, out); break;
+        }
+    }
+
+    void Store(const float* src, int n, NoiseFormat fmt, uint8_t* dst)
+    {
+        switch (fmt) {
+        case NoiseFormat::R8:
+            for (int i = 0; i < n; ++i) dst[i] = (uint8_t)(int)(src[i] * 255.0f + 0.5f);
+            break;
+        case NoiseFormat::R16: {
+            uint16_t* d = reinterpret_cast<uint16_t*>(dst);
+            for (int i = 0; i < n; ++i) d[i] = (uint16_t)(int)(src[i] * 65535.0f + 0.5f);
+            break;
+        }
+        default:
+            std::memcpy(dst, src, (size_t)n * sizeof(float));
+            break;
+        }
+    }
+
+} // namespace
+
+namespace TerrainNoise {
+
+    Path Resolve(Path path)
+    {
+#if JM_SIMD_X86
+        const Simd::CpuFeatures& cpu = Simd::Cpu();
+        if (path == Path::Auto) path = Path::AVX2;
+        if (path == Path::AVX2 && !cpu.avx2) path = Path::SSE41;
+        if (path == Path::SSE41 && !cpu.sse41) path = Path::Scalar;
+        return path;
+#else
+        (void)path;
+        return Path::Scalar;
+#endif
+    }
+
+    const char* PathName(Path path)
+    {
+        switch (path) {
+        case Path::Scalar: return "Scalar";
+        case Path::SSE41:  return "SSE4.1";
+        case Path::AVX2:   return "AVX2";
+        default:           return "Auto";
+        }
+    }
+
+    const char* TypeName(NoiseType type)
+    {
+        switch (type) {
+        case NoiseType::Ridged:     return "Ridged";
+        case NoiseType::DomainWarp: return "DomainWarp";
+        default:                    return "fBm";
+        }
+    }
+
+    size_t FormatBytes(NoiseFormat fmt)
+    {
+        switch (fmt) {
+        case NoiseFormat::R8:  return 1;
+        case NoiseFormat::R16: return 2;
+        default:               return 4;
+        }
+    }
+
+    void Generate(const NoiseParams& p, int w, int h, NoiseFormat fmt, void* dst, size_t rowPitch,
+        Path path, bool parallel)
+    {
+        if (!dst || w <= 0 || h <= 0) return;
+        const Ctx c = MakeCtx(p, w, h);
+        path = Resolve(path);
+        const size_t bpp = FormatBytes(fmt);
+        uint8_t* base = static_cast<uint8_t*>(dst);
+
+        const int tilesX = (w + kTile - 1) / kTile, tilesY = (h + kTile - 1) / kTile;
+        auto tiles = [&](size_t t0, size_t t1) {
+            float row[kTile];
+            for (size_t t = t0; t < t1; ++t) {
+                const int x0 = (int)(t % tilesX) * kTile, y0 = (int)(t / tilesX) * kTile;
+                const int n = std::min(kTile, w - x0);
+                for (int y = y0; y < std::min(h, y0 + kTile); ++y) {
+                    Row(c, path, x0, n, y, row);
+                    Store(row, n, fmt, base + (size_t)y * rowPitch + (size_t)x0 * bpp);
+                }
+            }
+        };
+
+        const size_t count = (size_t)tilesX * tilesY;
+        if (parallel) Jobs::For(0, count, 1, tiles);    // Ÿ ϳ = ۾ ϳ,  Ŀ  
+        else tiles(0, count);
+    }
+
+    std::vector<uint8_t> GenerateR8(const NoiseParams& p, int w, int h)
+    {
+        std::vector<uint8_t> out((size_t)std::max(w, 0) * std::max(h, 0));
+        Generate(p, w, h, NoiseFormat::R8, out.data(), (size_t)w);
+        return out;
+    }
+
+    float Sample(const NoiseParams& p, int w, int h, float u, float v)
+    {
+        return Value(MakeCtx(p, w, h), u, v);
+    }
+
+    BenchResult Benchmark(int w, int h, NoiseType type, Path path, int iterations)
+    {
+        NoiseParams p;
+        p.type = type;
+        const size_t n = (size_t)w * h;
+        std::vector<float> ref(n), single(n), par(n);
+        const size_t pitch = (size_t)w * sizeof(float);
+
+        auto time = [&](auto&& fn) {
+            double best = 1e30;
+            for (int i = 0; i < std::max(1, iterations); ++i) {
+                auto t0 = std::chrono::steady_clock::now();
+                fn();
+                best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count());
+            }
+            return best;
+        };
+
+        BenchResult r;
+        Generate(p, w, h, NoiseFormat::Float, ref.data(), pitch, Path::Scalar, true);
+        r.singleMs = time([&] { Generate(p, w, h, NoiseFormat::Float, single.data(), pitch, path, false); });
+        r.parallelMs = time([&] { Generate(p, w, h, NoiseFormat::Float, par.data(), pitch, path, true); });
+        r.msamplesPerSec = r.singleMs > 0.0 ? (double)n / (r.singleMs * 1000.0) : 0.0;
+        r.msamplesPerSecMT = r.parallelMs > 0.0 ? (double)n / (r.parallelMs * 1000.0) : 0.0;
+        for (size_t i = 0; i < n; ++i)
+            r.mismatches += (std::memcmp(&ref[i], &single[i], 4) != 0) + (std::memcmp(&ref[i], &par[i], 4) != 0);
+        return r;
+    }
+
+} // namespace TerrainNoise
@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//  ̸  (׷Ʈ   fBm / ridged / domain warp)
+// D3D   CPU  .  Ķ͸ /  ϰ  
+// ڰ  ũ εǹǷ    Ÿϸȴ (÷ WRAP ġ)
+
+enum class NoiseType {
+    FBm,        // Ÿ 
+    Ridged,     // 1-|n|  + ġ ǵ (ɼ)
+    DomainWarp, // fBm   ǥ  fBm
+};
+
+//  :   top-down, rowPitch Ʈ
+// R8  BMP::Image(PixelFormat::R8) / AssetManager, R16  R16_UNORM, Float  R32_FLOAT
+enum class NoiseFormat { R8, R16, Float };
+
+struct NoiseParams {
+    uint32_t  seed = 1337;
+    NoiseType type = NoiseType::FBm;
+    int   baseCells = 4;        // ù Ÿ  ü  ĭ 
+    int   octaves = 10;         //  ػ  ļ ߸
+    float lacunarity = 2.0f;    // Ÿ긶 ĭ   ( ݿø)
+    float gain = 0.5f;          // Ÿ긶  
+    float warp = 0.25f;         // DomainWarp: ǥ 鸲 ( ũ )
+};
+
+namespace TerrainNoise {
+
+    enum class Path { Auto, Scalar, SSE41, AVX2 };   // AVX2: 8, SSE4.1: 4
+
+    Path Resolve(Path path);
+    const char* PathName(Path path);
+    const char* TypeName(NoiseType type);
+    size_t FormatBytes(NoiseFormat fmt);
+
+    // w x h 64x64 ŸϷ   ھ  (parallel=false ȣ 常)
+    // 0~1 ȭ ̸ fmt ȭ(ݿø)
+    void Generate(const NoiseParams& p, int w, int h, NoiseFormat fmt, void* dst, size_t rowPitch,
+        Path path = Path::Auto, bool parallel = true);
+
+    // R8  Լ (w*h, top-down)
+    std::vector<uint8_t> GenerateR8(const NoiseParams& p, int w, int h);
+
+    //   0~1  (Į  , u/v   [0,1))
+    float Sample(const NoiseParams& p, int w, int h, float u, float v);
+
+    struct BenchResult {
+        double singleMs = 0.0;          //  
+        double parallelMs = 0.0;        // Ÿ 
+        double msamplesPerSec = 0.0;    //   
+        double msamplesPerSecMT = 0.0;  //  
+        size_t mismatches = 0;          // Į ٸ   (float Ʈ )
+    };
+
+    // w x h float  
+    BenchResult Benchmark(int w, int h, NoiseType type, Path path, int iterations = 3);
+
+} // namespace TerrainNoise
@@ -0,0 +1,244 @@
+#include "TerrainNormalBake.h"
+#include "../utils/Parallel.h"
+#include "../utils/Simd.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+//      
+// ߾ : (h[x+1] - h[x-1]) / 255 * hs / (2 dx), Һ ġ  4 /4 ߰
+static void GradScale(const NormalBakeParams& p, int w, int h, float& sx, float& sz)
+{
+    const float dx = p.gridSizeX / (float)w, dz = p.gridSizeZ / (float)h;
+    const float k = (p.filter == NormalBakeFilter::Sobel) ? 0.25f : 1.0f;
+    sx = p.heightScale / 255.0f / (2.0f * dx) * k;
+    sz = p.heightScale / 255.0f / (2.0f * dz) * k;
+}
+
+static inline uint32_t EncodeTexel(int gxi, int gzi, float sx, float sz, uint8_t height)
+{
+    const float gx = (float)gxi * sx, gz = (float)gzi * sz;
+    const float inv = 1.0f / std::sqrt(gx * gx + gz * gz + 1.0f);
+    // n = normalize(-gx, 1, -gz)  [0,255]
+    const uint32_t r = (uint32_t)(int)(-gx * inv * 127.5f + 128.0f);
+    const uint32_t g = (uint32_t)(int)(inv * 127.5f + 128.0f);
+    const uint32_t b = (uint32_t)(int)(-gz * inv * 127.5f + 128.0f);
+    return std::min(r, 255u) | (std::min(g, 255u) << 8) | (std::min(b, 255u) << 16) | ((uint32_t)height << 24);
+}
+
+static void Texel(const uint8_t* up, const uint8_t* cur, const uint8_t* dn, int xl, int x, int xr,
+    NormalBakeFilter f, float sx, float sz, uint8_t* dst)
+{
+    int gx, gz;
+    if (f == NormalBakeFilter::Sobel) {
+        gx = (up[xr] + 2 * cur[xr] + dn[xr]) - (up[xl] + 2 * cur[xl] + dn[xl]);
+        gz = (dn[xl] + 2 * dn[x] + dn[xr]) - (up[xl] + 2 * up[x] + up[xr]);
+    }
+    else {
+        gx = cur[xr] - cur[xl];
+        gz = dn[x] - up[x];
+    }
+    const uint32_t t = EncodeTexel(gx, gz, sx, sz, cur[x]);
+    dst[0] = (uint8_t)t; dst[1] = (uint8_t)(t >> 8); dst[2] = (uint8_t)(t >> 16); dst[3] = (uint8_t)(t >> 24);
+}
+
+#if JM_SIMD_X86
+// 4Ʈ  int32 x4
+static inline __m128i Load4(const uint8_t* p)
+{
+    int v; std::memcpy(&v, p, 4);
+    const __m128i z = _mm_setzero_si128();
+    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(v), z), z);
+}
+
+//   [1, w-1) 4ؼ, ȯ ó  x + 1
+static int RowSSE2(const uint8_t* up, const uint8_t* cur, const uint8_t* dn, int w,
+    NormalBakeFilter f, float sx, float sz, uint8_t* dst)
+{
+    const __m128 vsx = _mm_set1_ps(sx), vsz = _mm_set1_ps(sz);
+    const __m128 one = _mm_set1_ps(1.0f), half = _mm_set1_ps(127.5f), bias = _mm_set1_ps(128.0f);
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    const __m128i max255 = _mm_set1_epi32(255);
+
+    int x = 1;
+    for (; x + 4 <= w - 1; x += 4) {
+        __m128i gx, gz;
+        const __m128i c0 = Load4(cur + x - 1), c2 = Load4(cur + x + 1);
+        if (f == NormalBakeFilter::Sobel) {
+            const __m128i u0 = Load4(up + x - 1), u1 = Load4(up + x), u2 = Load4(up + x + 1);
+            const __m128i d0 = Load4(dn + x - 1), d1 = Load4(dn + x), d2 = Load4(dn + x + 1);
+            gx = _mm_sub_epi32(_mm_add_epi32(_mm_add_epi32(u2, _mm_slli_epi32(c2, 1)), d2),
+                _mm_add_epi32(_mm_add_epi32(u0, _mm_slli_epi32(c0, 1)), d0));
+            gz = _mm_sub_epi32(_mm_add_epi32(_mm_add_epi32(d0, _mm_slli_epi32(d1, 1)), d2),
+                _mm_add_epi32(_mm_add_epi32(u0, _mm_slli_epi32(u1, 1)), u2));
+        }
+        else {
+            gx = _mm_sub_epi32(c2, c0);
+            gz = _mm_sub_epi32(Load4(dn + x), Load4(up + x));
+        }
+
+        const __m128 fx = _mm_mul_ps(_mm_cvtepi32_ps(gx), vsx);
+        const __m128 fz = _mm_mul_ps(_mm_cvtepi32_ps(gz), vsz);
+        const __m128 l2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(fx, fx), _mm_mul_ps(fz, fz)), one);
+        const __m128 inv = _mm_div_ps(one, _mm_sqrt_ps(l2));
+
+        auto enc = [&](__m128 n) {
+            __m128i v = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(n, half), bias));
+            // SSE2 epi32 min  񱳷 Ŭ
+            const __m128i gt = _mm_cmpgt_epi32(v, max255);
+            return _mm_or_si128(_mm_andnot_si128(gt, v), _mm_and_si128(gt, max255));
+        };
+        const __m128i r = enc(_mm_mul_ps(_mm_xor_ps(fx, sign), inv));
+        const __m128i g = enc(inv);
+        const __m128i b = enc(_mm_mul_ps(_mm_xor_ps(fz, sign), inv));
+        const __m128i a = Load4(cur + x);
+
+        const __m128i px = _mm_or_si128(_mm_or_si128(r, _mm_slli_epi32(g, 8)),
+            _mm_or_si128(_mm_slli_epi32(b, 16), _mm_slli_epi32(a, 24)));
+        _mm_storeu_si128((__m128i*)(dst + (size_t)x * 4), px);
+    }
+    return x;
+}
+#endif
+
+namespace TerrainBake {
+
+    void NormalHeight(const uint8_t* heights, int w, int h, const NormalBakeParams& p,
+        uint8_t* out, int y0, int y1, bool simd)
+    {
+        if (!heights || !out || w <= 0 || h <= 0) return;
+        float sx, sz;
+        GradScale(p, w, h, sx, sz);
+
+        for (int y = std::max(0, y0); y < std::min(h, y1); ++y) {
+            const uint8_t* up = heights + (size_t)((y + h - 1) % h) * w;
+            const uint8_t* cur = heights + (size_t)y * w;
+            const uint8_t* dn = heights + (size_t)((y + 1) % h) * w;
+            uint8_t* dst = out + (size_t)y * w * 4;
+
+            //  ʿ    Į
+            Texel(up, cur, dn, (w - 1) % w, 0, 1 % w, p.filter, sx, sz, dst);
+            int x = 1;
+#if JM_SIMD_X86
+            if (simd && w > 2) x = RowSSE2(up, cur, dn, w, p.filter, sx, sz, dst);
+#else
+            (void)simd;
+#endif
+            for (; x < w; ++x)
+                Texel(up, cur, dn, x - 1, x, (x + 1) % w, p.filter, sx, sz, dst + (size_t)x * 4);
+        }
+    }
+
+    void NormalHeightParallel(const uint8_t* heights, int w, int h, const NormalBakeParams& p,
+        uint8_t* out, int y0, int y1)
+    {
+        y0 = std::max(0, y0); y1 = std::min(h, y1);
+        if (y1 <= y0) return;
+        const size_t grain = std::max<size_t>(1, 16384 / std::max(w, 1));
+        Parallel::For((size_t)y0, (size_t)y1, grain, [&](size_t a, size_t b) {
+            NormalHeight(heights, w, h, p, out, (int)a, (int)b, true);
+        });
+    }
+
+    BenchResult Benchmark(int w, int h, NormalBakeFilter filter, int iterations)
+    {
+        // ε巯  +  
+        std::vector<uint8_t> hm((size_t)w * h);
+        std::mt19937 rng(5);
+        for (int y = 0; y < h; ++y)
+            for (int x = 0; x < w; ++x) {
+                const float v = 128.0f + 90.0f * std::sin(x * 0.013f) * std::cos(y * 0.017f);
+                hm[(size_t)y * w + x] = (uint8_t)std::clamp((int)v + (int)(rng() % 9) - 4, 0, 255);
+            }
+
+        NormalBakeParams p;
+        p.heightScale = 1.5f;
+        p.filter = filter;
+        std::vector<uint8_t> a((size_t)w * h * 4), b(a.size()), c(a.size());
+
+        auto time = [&](auto&& fn) {
+            double best = 1e30;
+            for (int i = 0; i < std::max(1, iterations); ++i) {
+                auto t0 = std::chrono::steady_clock::now();
+                fn();
+                best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count());
+            }
+            return best;
+        };
+
+        BenchResult r;
+        r.scalarMs = time([&] { NormalHeight(hm.data(), w, h, p, a.data(), 0, h, false); });
+        r.simdMs = time([&] { NormalHeight(hm.data(), w, h, p, b.data(), 0, h, true); });
+        r.parallelMs = time([&] { NormalHeightParallel(hm.data(), w, h, p, c.data(), 0, h); });
+        r.mtexelsPerSec = r.parallelMs > 0.0 ? (double)w * h / (r.parallelMs * 1000.0) : 0.0;
+        for (size_t i = 0; i < a.size(); ++i) r.mismatches += (a[i] != b[i]) + (a[i] != c[i]);
+        return r;
+    }
+
+} // namespace TerrainBake
+
+static bool SameParams(const NormalBakeParams& a, const NormalBakeParams& b)
+{
+    return a.gridSizeX == b.gridSizeX && a.gridSizeZ == b.gridSizeZ &&
+        a.heightScale == b.heightScale && a.filter == b.filter;
+}
+
+bool NormalBakeBuffer::Init(const uint8_t* heights, int w, int h, const NormalBakeParams& p)
+{
+    Clear();
+    if (!heights || w <= 0 || h <= 0) return false;
+    mW = w; mH = h;
+    mParams = p;
+    mHeights.assign(heights, heights + (size_t)w * h);
+    mTexels.resize((size_t)w * h * 4);
+    mDirty.assign(h, 0);
+    TerrainBake::NormalHeightParallel(mHeights.data(), w, h, mParams, mTexels.data(), 0, h);
+    return true;
+}
+
+void NormalBakeBuffer::Clear()
+{
+    mHeights.clear();
+    mTexels.clear();
+    mDirty.clear();
+    mW = mH = 0;
+    mPending = 0;
+}
+
+bool NormalBakeBuffer::SetParams(const NormalBakeParams& p)
+{
+    if (SameParams(p, mParams)) return false;
+    mParams = p;
+    for (int y = 0; y < mH; ++y) MarkRow(y);
+    return true;
+}
+
+void NormalBakeBuffer::MarkRow(int y)
+{
+    y = ((y % mH) + mH) % mH;
+    if (!mDirty[y]) { mDirty[y] = 1; ++mPending; }
+}
+
+void NormalBakeBuffer::SetRows(const uint8_t* heights, int y0, int y1)
+{
+    y0 = std::max(y0, 0); y1 = std::min(y1, mH);
+    if (!heights || y1 <= y0) return;
+    std::memcpy(mHeights.data() + (size_t)y0 * mW, heights + (size_t)y0 * mW, (size_t)(y1 - y0) * mW);
+    //  Ʒ   Ƿ  ྿  ( ݴ )
+    for (int y = y0 - 1; y <= y1; ++y) MarkRow(y);
+}
+
+int NormalBakeBuffer::BakeDirty(int maxRows, int& y0, int& y1)
+{
+    y0 = y1 = 0;
+    if (mPending == 0) return 0;
+    y0 = (int)(std::find(mDirty.begin(), mDirty.end(), (uint8_t)1) - mDirty.begin());
+    y1 = y0;
+    while (y1 < mH && mDirty[y1] && y1 - y0 < std::max(maxRows, 1)) mDirty[y1++] = 0;
+    mPending -= y1 - y0;
+    TerrainBake::NormalHeightParallel(mHeights.data(), mW, mH, mParams, mTexels.data(), y0, y1);
+    return y1 - y0;
+}
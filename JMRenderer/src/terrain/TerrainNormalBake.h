@@ -0,0 +1,75 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ̸(R8)  + (RGBA8) CPU ũ
+// D3D   CPU   (帮 ׽Ʈ/ġ )
+// : rgb =   * 0.5 + 0.5, a =    VS   ÷ ̿ 
+
+enum class NormalBakeFilter {
+    Central,    // ߾  (4̿)
+    Sobel,      // 3x3 Һ (8̿,  )
+};
+
+struct NormalBakeParams {
+    float gridSizeX = 10.0f, gridSizeZ = 10.0f;    //  ũ (TerrainCB.GridSize)
+    float heightScale = 1.0f;                       // TerrainCB.HeightScale
+    NormalBakeFilter filter = NormalBakeFilter::Sobel;
+};
+
+namespace TerrainBake {
+
+    //  [y0, y1) ũ (ڸ ÷  )
+    // heights: w*h, out: w*h*4 (ü ̹  ּ)
+    // simd=false Į  ( Ʈ  )
+    void NormalHeight(const uint8_t* heights, int w, int h, const NormalBakeParams& p,
+        uint8_t* out, int y0, int y1, bool simd = true);
+
+    // ü    ھ  ũ
+    void NormalHeightParallel(const uint8_t* heights, int w, int h, const NormalBakeParams& p,
+        uint8_t* out, int y0, int y1);
+
+    struct BenchResult {
+        double scalarMs = 0.0;      //   Į
+        double simdMs = 0.0;        //   SIMD
+        double parallelMs = 0.0;    // Ƽ SIMD
+        double mtexelsPerSec = 0.0; // Ƽ 
+        size_t mismatches = 0;      // Į ٸ Ʈ 
+    };
+
+    BenchResult Benchmark(int w, int h, NormalBakeFilter filter, int iterations = 3);
+
+} // namespace TerrainBake
+
+//  纻 + ũ  + Ƽ  (TerrainNormalMap CPU , D3D  ׽Ʈ )
+//   ٲ п    (Ʒ  ,  ) ٽ ũѴ
+class NormalBakeBuffer {
+public:
+    // heights  д. ù ũ  ü
+    bool Init(const uint8_t* heights, int w, int h, const NormalBakeParams& p);
+    void Clear();
+
+    //  ٲ ü Ƽ (ȯ true)
+    bool SetParams(const NormalBakeParams& p);
+    // heights(w*h ü ̹)  [y0, y1) 纻 ű ޴  Ƽ
+    void SetRows(const uint8_t* heights, int y0, int y1);
+
+    //  ӵ Ƽ  ִ maxRows ũ. [y0, y1) ְ ȯ   ( 0)
+    int BakeDirty(int maxRows, int& y0, int& y1);
+
+    int Width() const { return mW; }
+    int Height() const { return mH; }
+    int PendingRows() const { return mPending; }
+    const uint8_t* Texels() const { return mTexels.data(); }   // w*h*4
+
+private:
+    void MarkRow(int y);
+
+    std::vector<uint8_t> mHeights;
+    std::vector<uint8_t> mTexels;
+    std::vector<uint8_t> mDirty;    // ະ ÷
+    int mW = 0, mH = 0;
+    int mPending = 0;
+    NormalBakeParams mParams;
+};
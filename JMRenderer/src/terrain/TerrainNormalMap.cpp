@@ -0,0 +1,61 @@
+#include "TerrainNormalMap.h"
+#include <algorithm>
+#include <chrono>
+
+bool TerrainNormalMap::Init(ID3D11Device* dev, const uint8_t* heights, int w, int h, const NormalBakeParams& p)
+{
+    mTex.Reset(); mSRV.Reset();
+    mStats = {};
+    auto t0 = std::chrono::steady_clock::now();
+    if (!mBake.Init(heights, w, h, p)) return false;
+
+    // UpdateSubresource κ ϹǷ DEFAULT
+    D3D11_TEXTURE2D_DESC td{};
+    td.Width = w; td.Height = h; td.MipLevels = 1; td.ArraySize = 1;
+    td.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    td.SampleDesc.Count = 1;
+    td.Usage = D3D11_USAGE_DEFAULT;
+    td.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+    D3D11_SUBRESOURCE_DATA srd{};
+    srd.pSysMem = mBake.Texels();
+    srd.SysMemPitch = (UINT)w * 4;
+    if (FAILED(dev->CreateTexture2D(&td, &srd, mTex.GetAddressOf()))) return false;
+    if (FAILED(dev->CreateShaderResourceView(mTex.Get(), nullptr, mSRV.GetAddressOf()))) { mTex.Reset(); return false; }
+
+    mStats.lastBakeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    mStats.lastRows = h;
+    return true;
+}
+
+void TerrainNormalMap::SetParams(const NormalBakeParams& p)
+{
+    if (mBake.SetParams(p)) ++mStats.rebakes;
+}
+
+void TerrainNormalMap::MarkDirty(const uint8_t* heights, int y0, int y1)
+{
+    mBake.SetRows(heights, y0, y1);
+}
+
+int TerrainNormalMap::Update(ID3D11DeviceContext* ctx, size_t maxTexels)
+{
+    mStats.pendingRows = mBake.PendingRows();
+    if (!mTex || mBake.PendingRows() == 0) return 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    const int w = mBake.Width();
+    int y0, y1;
+    const int rows = mBake.BakeDirty((int)std::min(maxTexels / (size_t)w, (size_t)mBake.Height()), y0, y1);
+
+    D3D11_BOX box{};
+    box.left = 0; box.right = (UINT)w;
+    box.top = (UINT)y0; box.bottom = (UINT)y1;
+    box.front = 0; box.back = 1;
+    ctx->UpdateSubresource(mTex.Get(), 0, &box, mBake.Texels() + (size_t)y0 * w * 4, (UINT)w * 4, 0);
+
+    mStats.lastRows = rows;
+    mStats.pendingRows = mBake.PendingRows();
+    mStats.lastBakeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    return rows;
+}
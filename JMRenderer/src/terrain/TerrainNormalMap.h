@@ -0,0 +1,41 @@
+#pragma once
+#include <d3d11.h>
+#include <wrl/client.h>
+#include <cstdint>
+#include "TerrainNormalBake.h"
+
+using Microsoft::WRL::ComPtr;
+
+// ũ + ؽó (RGBA8, VS ̶  )
+// Ķͳ ̰ ٲ Ƽ ุ ٽ ũ  ุ εѴ
+class TerrainNormalMap {
+public:
+    struct Stats {
+        double lastBakeMs = 0.0;    //  Update ũ + ε
+        int    lastRows = 0;
+        int    pendingRows = 0;     //   Ƽ 
+        size_t rebakes = 0;         // ü ȿȭ Ƚ
+    };
+
+    // heights  д. ù ũ  ü
+    bool Init(ID3D11Device* dev, const uint8_t* heights, int w, int h, const NormalBakeParams& p);
+
+    // GridSize/HeightScale/Ͱ ٲ ü Ƽ
+    void SetParams(const NormalBakeParams& p);
+    //   [y0, y1) ٲ ( ε/). heights w*h ü ̹,  ุ Ѵ
+    void MarkDirty(const uint8_t* heights, int y0, int y1);
+
+    // Ƽ  maxTexels 길ŭ ũ/ε. ȯ ó  
+    int Update(ID3D11DeviceContext* ctx, size_t maxTexels = 1u << 18);
+
+    bool Ready() const { return mSRV.Get() != nullptr; }
+    ID3D11ShaderResourceView* SRV() const { return mSRV.Get(); }
+    const Stats& GetStats() const { return mStats; }
+
+private:
+    NormalBakeBuffer mBake;
+
+    ComPtr<ID3D11Texture2D> mTex;
+    ComPtr<ID3D11ShaderResourceView> mSRV;
+    Stats mStats;
+};
@@ -0,0 +1,70 @@
+#include "TerrainPass.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace Render;
+
+namespace TerrainPass {
+
+    void ApplyRequirements(PipelineDesc& p)
+    {
+        const int vs = (int)Stage::VS, ps = (int)Stage::PS;
+        p.requiredCBs[vs] = (1 << 0) | (1 << 1) | (1 << 3);
+        p.requiredCBs[ps] = (1 << 0) | (1 << 1) | (1 << 2);
+        p.requiredSRVs[vs] = (1 << 0);                      // t1 UseBakedNormals  
+        p.requiredSRVs[ps] = (1 << 0) | (1 << 1) | (1 << 2);
+        p.requiredSamplers[vs] = (1 << 0);
+        p.requiredSamplers[ps] = (1 << 0);
+    }
+
+    void Record(CommandList& list, const TerrainPassResources& r, const TerrainPassConstants& k,
+        const TerrainQuadTree& tree, const std::vector<TerrainDraw>& draws, const std::vector<uint32_t>& visible)
+    {
+        //   + ε (ο캸 )
+        list.UpdateBuffer(r.sceneCB, k.scene, k.sceneBytes);
+        list.UpdateBuffer(r.terrainCB, k.terrain, k.terrainBytes);
+        list.UpdateBuffer(r.matCB, k.mat, k.matBytes);
+        list.BindCB(StageAll, 0, r.sceneCB);
+        list.BindCB(StageAll, 1, r.terrainCB);
+        list.BindCB(StagePS, 2, r.matCB);
+        list.BindCB(StageVS, 3, r.nodeCB);
+        list.BindSRV(StageVS, 0, r.heightSRV);
+        list.BindSRV(StageVS, 1, r.normalSRV);
+        list.BindSampler(StageVS, 0, r.heightSampler);
+        for (int i = 0; i < 3; ++i) list.BindSRV(StagePS, i, r.albedoSRVs[i]);
+        list.BindSampler(StagePS, 0, r.albedoSampler);
+
+        list.SetPipeline(r.pipeline);
+        list.SetMesh(r.patch);
+
+        //  ߽ɱ Ÿ տ ڷ (  Ⱒ)
+        auto dist = [&](const TerrainDraw& d) {
+            const float dx = d.x + d.sizeX * 0.5f - k.camPos[0];
+            const float dy = (d.minY + d.maxY) * 0.5f - k.camPos[1];
+            const float dz = d.z + d.sizeZ * 0.5f - k.camPos[2];
+            return std::sqrt(dx * dx + dy * dy + dz * dz);
+        };
+        float maxDist = 1e-6f;
+        for (uint32_t vi : visible) maxDist = std::max(maxDist, dist(draws[vi]));
+
+        const uint32_t quadIdx = r.indexCount / 4;
+        for (uint32_t vi : visible) {
+            const TerrainDraw& d = draws[vi];
+            TerrainNodeCB ncb{};
+            ncb.NodeOrigin[0] = d.x; ncb.NodeOrigin[1] = d.z;
+            ncb.NodeSize[0] = d.sizeX; ncb.NodeSize[1] = d.sizeZ;
+            tree.MorphConsts(d.lod, ncb.MorphConsts);
+            ncb.PatchRes = (float)r.patchRes;
+            list.UpdateBuffer(r.nodeCB, ncb);
+
+            const float depth = dist(d) / maxDist;
+            if (d.quadMask == TerrainQuadAll) {
+                list.DrawIndexed(r.indexCount, 0, 0, depth);
+                continue;
+            }
+            for (uint32_t q = 0; q < 4; ++q)
+                if (d.quadMask & (1u << q)) list.DrawIndexed(quadIdx, q * quadIdx, 0, depth);
+        }
+    }
+
+} // namespace TerrainPass
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "TerrainQuadTree.h"
+#include "../render/CommandList.h"
+
+//  н Ŀǵ Ʈ  (D3D    NullExecutor 帮  )
+//  /ε ο캸  ϰ,  ο տ ڷ  Ű ش
+
+//  (b3): terrain_vs.hlsl NodeCB  ġ
+struct TerrainNodeCB {
+    float NodeOrigin[2];    //  ּ 𼭸( XZ)
+    float NodeSize[2];      //  ũ( XZ)
+    float MorphConsts[2];   // (start, 1/(end-start))
+    float PatchRes;         // ġ    
+    float _pad;
+};
+
+struct TerrainPassResources {
+    Render::PipelineDesc pipeline;      // ġ  ˰ ¦ ̴ (ʼ  ApplyRequirements)
+    Render::MeshDesc     patch;
+    uint32_t indexCount = 0;            // ġ ü (и = 1/4)
+    int      patchRes = 16;
+
+    Render::Handle sceneCB = nullptr;   // b0 (VS/PS)
+    Render::Handle terrainCB = nullptr; // b1 (VS/PS)
+    Render::Handle matCB = nullptr;     // b2 (PS)
+    Render::Handle nodeCB = nullptr;    // b3 (VS)
+    Render::Handle heightSRV = nullptr, normalSRV = nullptr;   // VS t0, t1 (t1 ũ غ  nullptr )
+    Render::Handle heightSampler = nullptr;                   // VS s0
+    Render::Handle albedoSRVs[3] = {};                        // PS t0~t2 (grass, rock, snow)
+    Render::Handle albedoSampler = nullptr;                   // PS s0
+};
+
+//    (main SceneCB/TerrainCBCPU/MatCBCPU Ʈ ״)
+struct TerrainPassConstants {
+    const void* scene = nullptr;   size_t sceneBytes = 0;
+    const void* terrain = nullptr; size_t terrainBytes = 0;
+    const void* mat = nullptr;     size_t matBytes = 0;
+    float camPos[3] = { 0, 0, 0 };
+};
+
+namespace TerrainPass {
+
+    //  ̴  д  ʼ ǥ
+    void ApplyRequirements(Render::PipelineDesc& p);
+
+    // visible: draws ε (ø )
+    void Record(Render::CommandList& list, const TerrainPassResources& r, const TerrainPassConstants& k,
+        const TerrainQuadTree& tree, const std::vector<TerrainDraw>& draws, const std::vector<uint32_t>& visible);
+
+} // namespace TerrainPass
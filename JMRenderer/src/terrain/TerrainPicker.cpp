@@ -0,0 +1,396 @@
+#include "TerrainPicker.h"
+#include "TerrainHeightField.h"
+#include "../utils/Parallel.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+namespace {
+
+    inline int Wrap(int i, int n)
+    {
+        if (i < 0) i += n;
+        if (i >= n) i -= n;
+        return i;
+    }
+
+    //       ĭ
+    inline int DirFloor(double v, double dir)
+    {
+        return dir >= 0.0 ? (int)std::floor(v) : (int)std::ceil(v) - 1;
+    }
+
+} // namespace
+
+bool TerrainPicker::Build(const TerrainHeightField& field)
+{
+    Clear();
+    if (field.Empty()) return false;
+    mField = &field;
+
+    //  : ؼ ߽ (L-1, L) x (M-1, M)  ġ.  ڸ  ؼ WRAP ġ 
+    Level leaf;
+    leaf.w = field.Width() + 1; leaf.h = field.Height() + 1;
+    leaf.minH.resize((size_t)leaf.w * leaf.h);
+    leaf.maxH.resize((size_t)leaf.w * leaf.h);
+    mLevels.push_back(std::move(leaf));
+    for (int m = 0; m < mLevels[0].h; ++m) LeafRow(m);
+
+    //  : ڽ 2x2 (Ȧ  ø,  / ڽ ϳ  ) 
+    while (mLevels.back().w > 1 || mLevels.back().h > 1) {
+        const Level& c = mLevels.back();
+        Level p;
+        p.w = (c.w + 1) / 2; p.h = (c.h + 1) / 2;
+        p.minH.resize((size_t)p.w * p.h);
+        p.maxH.resize((size_t)p.w * p.h);
+        mLevels.push_back(std::move(p));
+        for (int z = 0; z < mLevels.back().h; ++z) ParentRow((int)mLevels.size() - 1, z);
+    }
+    return true;
+}
+
+void TerrainPicker::LeafRow(int m)
+{
+    const int W = mField->Width(), H = mField->Height();
+    const float* T = mField->Texels();
+    Level& leaf = mLevels[0];
+    const float* r0 = T + (size_t)Wrap(m - 1, H) * W;
+    const float* r1 = T + (size_t)Wrap(m, H) * W;
+    for (int l = 0; l < leaf.w; ++l) {
+        const int c0 = Wrap(l - 1, W), c1 = Wrap(l, W);
+        const float lo = std::min(std::min(r0[c0], r0[c1]), std::min(r1[c0], r1[c1]));
+        const float hi = std::max(std::max(r0[c0], r0[c1]), std::max(r1[c0], r1[c1]));
+        // ؼ R8/255 ݿø Ȯ ǵư
+        leaf.minH[(size_t)m * leaf.w + l] = (uint8_t)(lo * 255.0f + 0.5f);
+        leaf.maxH[(size_t)m * leaf.w + l] = (uint8_t)(hi * 255.0f + 0.5f);
+    }
+}
+
+void TerrainPicker::ParentRow(int level, int z)
+{
+    const Level& c = mLevels[level - 1];
+    Level& p = mLevels[level];
+    for (int x = 0; x < p.w; ++x) {
+        uint8_t lo = 255, hi = 0;
+        for (int q = 0; q < 4; ++q) {
+            const int cx = x * 2 + (q & 1), cz = z * 2 + (q >> 1);
+            if (cx >= c.w || cz >= c.h) continue;
+            lo = std::min(lo, c.minH[(size_t)cz * c.w + cx]);
+            hi = std::max(hi, c.maxH[(size_t)cz * c.w + cx]);
+        }
+        p.minH[(size_t)z * p.w + x] = lo;
+        p.maxH[(size_t)z * p.w + x] = hi;
+    }
+}
+
+void TerrainPicker::UpdateRows(int y0, int y1)
+{
+    if (mLevels.empty() || y1 <= y0) return;
+    const int H = mField->Height();
+
+    //   M ؼ  M-1, M()  
+    std::vector<uint8_t> dirty(mLevels[0].h, 0);
+    for (int m = 0; m < mLevels[0].h; ++m) {
+        const int a = Wrap(m - 1, H), b = Wrap(m, H);
+        dirty[m] = (a >= y0 && a < y1) || (b >= y0 && b < y1);
+        if (dirty[m]) LeafRow(m);
+    }
+
+    //  : ڽ    ϳ ٲ ุ 
+    for (int level = 1; level < (int)mLevels.size(); ++level) {
+        const int ch = mLevels[level - 1].h;
+        for (int z = 0; z < mLevels[level].h; ++z) {
+            dirty[z] = dirty[z * 2] || (z * 2 + 1 < ch && dirty[z * 2 + 1]);
+            if (dirty[z]) ParentRow(level, z);
+        }
+    }
+}
+
+void TerrainPicker::Clear()
+{
+    mLevels.clear();
+    mField = nullptr;
+}
+
+size_t TerrainPicker::Bytes() const
+{
+    size_t n = 0;
+    for (const Level& l : mLevels) n += l.minH.size() + l.maxH.size();
+    return n;
+}
+
+bool TerrainPicker::Setup(const TerrainRay& ray, float maxDist, RaySetup& s) const
+{
+    const TerrainHeightField& f = *mField;
+    const double len = std::sqrt((double)ray.dir[0] * ray.dir[0] + (double)ray.dir[1] * ray.dir[1] + (double)ray.dir[2] * ray.dir[2]);
+    if (!(len > 0.0) || !std::isfinite(len)) return false;
+    for (int a = 0; a < 3; ++a) {
+        if (!std::isfinite(ray.origin[a])) return false;
+        s.dirN[a] = ray.dir[a] / len;
+    }
+
+    //   : ؼ ߽ i x = ((i + 0.5) / W - 0.5) * GridX,  L ؼ L-1 ~ L 
+    const int W = f.Width(), H = f.Height();
+    const double sx = W / (double)f.GridSizeX(), sz = H / (double)f.GridSizeZ();
+    s.o[0] = ray.origin[0] * sx + W * 0.5 + 0.5;
+    s.o[1] = ray.origin[1];
+    s.o[2] = ray.origin[2] * sz + H * 0.5 + 0.5;
+    s.d[0] = s.dirN[0] * sx;
+    s.d[1] = s.dirN[1];
+    s.d[2] = s.dirN[2] * sz;
+    s.k = f.HeightScale() / 255.0;
+
+    //   (x/z  簢, y Ʈ  )
+    const Level& root = mLevels.back();
+    const double y0 = root.minH[0] * s.k, y1 = root.maxH[0] * s.k;
+    const double lo[3] = { 0.5, std::min(y0, y1), 0.5 };
+    const double hi[3] = { W + 0.5, std::max(y0, y1), H + 0.5 };
+    s.tEnter = 0.0;
+    s.tExit = maxDist;
+    for (int a = 0; a < 3; ++a) {
+        if (s.d[a] == 0.0) {
+            if (s.o[a] < lo[a] || s.o[a] > hi[a]) return false;
+            continue;
+        }
+        double t0 = (lo[a] - s.o[a]) / s.d[a], t1 = (hi[a] - s.o[a]) / s.d[a];
+        if (t0 > t1) std::swap(t0, t1);
+        s.tEnter = std::max(s.tEnter, t0);
+        s.tExit = std::min(s.tExit, t1);
+    }
+    return s.tEnter <= s.tExit;
+}
+
+//  ġ h(a,b) = h00 + ex*a + ez*b + exz*a*b   ù  (a, b   0~1)
+// y(t) - h(t) = A t^2 + B t + C  [t0, t1]    
+bool TerrainPicker::LeafHit(int cx, int cz, const RaySetup& s, double t0, double t1, double& tHit) const
+{
+    const TerrainHeightField& f = *mField;
+    const int W = f.Width(), H = f.Height();
+    const float* T = f.Texels();
+    const double hs = f.HeightScale();
+    const float* r0 = T + (size_t)Wrap(cz - 1, H) * W;
+    const float* r1 = T + (size_t)Wrap(cz, H) * W;
+    const int c0 = Wrap(cx - 1, W), c1 = Wrap(cx, W);
+    const double h00 = r0[c0] * hs, h10 = r0[c1] * hs, h01 = r1[c0] * hs, h11 = r1[c1] * hs;
+    const double ex = h10 - h00, ez = h01 - h00, exz = h00 - h10 - h01 + h11;
+
+    const double a0 = s.o[0] + s.d[0] * t0 - cx;
+    const double b0 = s.o[2] + s.d[2] * t0 - cz;
+    const double y0 = s.o[1] + s.d[1] * t0;
+    const double da = s.d[0], db = s.d[2];
+    const double A = -exz * da * db;
+    const double B = s.d[1] - ex * da - ez * db - exz * (a0 * db + b0 * da);
+    const double C = y0 - (h00 + ex * a0 + ez * b0 + exz * a0 * b0);
+    const double span = t1 - t0;
+
+    // Ա ̹ Ʒ:  ̰ų    ݿø 
+    if (C <= 0.0) { tHit = t0; return true; }
+
+    double tau = -1.0;
+    if (std::fabs(A) <= 1e-12 * (std::fabs(B) + std::fabs(C))) {
+        if (B < 0.0) tau = -C / B;
+    }
+    else {
+        const double disc = B * B - 4.0 * A * C;
+        if (disc >= 0.0) {
+            //   ϴ  
+            const double q = -0.5 * (B + std::copysign(std::sqrt(disc), B));
+            const double ra = q / A, rb = q != 0.0 ? C / q : ra;
+            const double lo = std::min(ra, rb), hi = std::max(ra, rb);
+            tau = lo >= 0.0 ? lo : hi;
+        }
+    }
+    if (tau >= 0.0 && tau <= span * (1.0 + 1e-9) + 1e-12) {
+        tHit = t0 + std::min(tau, span);
+        return true;
+    }
+    //    ۿ  ⱸ Ʒ 
+    if ((A * span + B) * span + C <= 0.0) { tHit = t1; return true; }
+    return false;
+}
+
+void TerrainPicker::Finish(const TerrainRay& ray, const RaySetup& s, double t, TerrainRayHit& out) const
+{
+    out.hit = true;
+    out.distance = (float)t;
+    for (int a = 0; a < 3; ++a) out.pos[a] = (float)(ray.origin[a] + s.dirN[a] * t);
+    mField->NormalAt(out.pos[0], out.pos[2], out.normal);
+}
+
+TerrainRayHit TerrainPicker::Trace(const TerrainRay& ray, float maxDist, uint64_t* steps) const
+{
+    TerrainRayHit r;
+    RaySetup s;
+    if (Empty() || !Setup(ray, maxDist, s)) return r;
+
+    const int top = (int)mLevels.size() - 1;
+    const int stepX = s.d[0] >= 0.0 ? 1 : -1, stepZ = s.d[2] >= 0.0 ? 1 : -1;
+    int l = top, cx = 0, cz = 0;
+    double t = s.tEnter;
+    uint64_t visited = 0;
+
+    // ĭ: ̰  ְ Ʒ  , ƴϸ ĭ ü ǳʶڴ
+    const int maxSteps = 64 * (mLevels[0].w + mLevels[0].h) * (top + 1);
+    for (int guard = 0; guard < maxSteps; ++guard) {
+        ++visited;
+        const Level& lv = mLevels[l];
+        const double size = (double)(1 << l);
+        double tx = 1e300, tz = 1e300;
+        if (s.d[0] > 0.0) tx = ((cx + 1) * size - s.o[0]) / s.d[0];
+        else if (s.d[0] < 0.0) tx = (cx * size - s.o[0]) / s.d[0];
+        if (s.d[2] > 0.0) tz = ((cz + 1) * size - s.o[2]) / s.d[2];
+        else if (s.d[2] < 0.0) tz = (cz * size - s.o[2]) / s.d[2];
+        const double tOut = std::min(std::min(tx, tz), s.tExit);
+
+        //   Ʒ   ü: ĭ ȿ ̰  ְ Ʒ  ĺ
+        const double ya = s.o[1] + s.d[1] * t, yb = s.o[1] + s.d[1] * tOut;
+        const size_t idx = (size_t)cz * lv.w + cx;
+        if (std::min(ya, yb) <= std::max(lv.minH[idx] * s.k, lv.maxH[idx] * s.k)) {
+            if (l > 0) {
+                //  ġ  ڽ (θ  Ŭ)
+                --l;
+                const double half = (double)(1 << l);
+                const Level& child = mLevels[l];
+                const int nx = DirFloor((s.o[0] + s.d[0] * t) / half, s.d[0]);
+                const int nz = DirFloor((s.o[2] + s.d[2] * t) / half, s.d[2]);
+                cx = std::min(std::max(nx, cx * 2), std::min(cx * 2 + 1, child.w - 1));
+                cz = std::min(std::max(nz, cz * 2), std::min(cz * 2 + 1, child.h - 1));
+                continue;
+            }
+            double tHit;
+            if (LeafHit(cx, cz, s, t, tOut, tHit)) {
+                Finish(ray, s, tHit, r);
+                break;
+            }
+        }
+
+        if (tOut >= s.tExit) break;
+        const int px = cx >> 1, pz = cz >> 1;
+        if (tx <= tz) cx += stepX;
+        if (tz <= tx) cz += stepZ;
+        t = tOut;
+        if (cx < 0 || cz < 0 || cx >= lv.w || cz >= lv.h) break;
+        // θ 踦 Ѿ  ܰ  ٽ 
+        if (l < top && ((cx >> 1) != px || (cz >> 1) != pz)) { ++l; cx >>= 1; cz >>= 1; }
+    }
+    if (steps) *steps += visited;
+    return r;
+}
+
+TerrainRayHit TerrainPicker::MarchImpl(const TerrainRay& ray, float maxDist, uint64_t* steps) const
+{
+    TerrainRayHit r;
+    RaySetup s;
+    if (Empty() || !Setup(ray, maxDist, s)) return r;
+
+    const TerrainHeightField& f = *mField;
+    const double step = 0.5 * std::min(f.GridSizeX() / (double)f.Width(), f.GridSizeZ() / (double)f.Height());
+    auto below = [&](double t) {
+        const double x = ray.origin[0] + s.dirN[0] * t, y = ray.origin[1] + s.dirN[1] * t, z = ray.origin[2] + s.dirN[2] * t;
+        return y <= f.HeightAt((float)x, (float)z);
+    };
+
+    uint64_t n = 1;
+    double prev = s.tEnter;
+    if (below(prev)) {
+        Finish(ray, s, prev, r);
+    }
+    else {
+        for (double t = prev + step; ; t += step) {
+            const double tc = std::min(t, s.tExit);
+            ++n;
+            if (below(tc)) {
+                double lo = prev, hi = tc;
+                for (int i = 0; i < 20; ++i) {
+                    const double mid = 0.5 * (lo + hi);
+                    if (below(mid)) hi = mid; else lo = mid;
+                }
+                n += 20;
+                Finish(ray, s, hi, r);
+                break;
+            }
+            if (tc >= s.tExit) break;
+            prev = tc;
+        }
+    }
+    if (steps) *steps += n;
+    return r;
+}
+
+void TerrainPicker::Pick(const TerrainRay* rays, size_t n, TerrainRayHit* out, float maxDist, bool parallel) const
+{
+    auto run = [&](size_t b, size_t e) {
+        for (size_t i = b; i < e; ++i) out[i] = Trace(rays[i], maxDist, nullptr);
+    };
+    if (parallel) Parallel::For(0, n, 256, run);
+    else run(0, n);
+}
+
+TerrainRayHit TerrainPicker::Pick(const TerrainRay& ray, float maxDist) const
+{
+    return Trace(ray, maxDist, nullptr);
+}
+
+TerrainRayHit TerrainPicker::March(const TerrainRay& ray, float maxDist) const
+{
+    return MarchImpl(ray, maxDist, nullptr);
+}
+
+TerrainPicker::BenchResult TerrainPicker::Benchmark(size_t count, int iterations) const
+{
+    BenchResult r;
+    if (Empty() || count == 0) return r;
+    const TerrainHeightField& f = *mField;
+    const float gx = f.GridSizeX(), gz = f.GridSizeZ();
+    const float top = mLevels.back().maxH[0] * f.HeightScale() / 255.0f;
+
+    //    ̿    ϸϰ   (ġ ̰  ƴ)
+    std::vector<TerrainRay> rays(count);
+    std::mt19937 rng(2024);
+    std::uniform_real_distribution<float> ux(-0.45f * gx, 0.45f * gx), uz(-0.45f * gz, 0.45f * gz);
+    std::uniform_real_distribution<float> uy(0.05f, 0.3f), angle(0.0f, 6.2831853f), down(0.05f, 0.6f);
+    for (TerrainRay& ray : rays) {
+        const float a = angle(rng);
+        ray.origin[0] = ux(rng);
+        ray.origin[2] = uz(rng);
+        ray.origin[1] = top + uy(rng) * std::max(gx, gz) * 0.1f;
+        ray.dir[0] = std::cos(a);
+        ray.dir[1] = -down(rng);
+        ray.dir[2] = std::sin(a);
+    }
+
+    auto time = [&](auto&& fn) {
+        double best = 1e30;
+        for (int i = 0; i < std::max(1, iterations); ++i) {
+            auto t0 = std::chrono::steady_clock::now();
+            fn();
+            best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count());
+        }
+        return best;
+    };
+
+    std::vector<TerrainRayHit> pick(count), pickMT(count), march(count);
+    r.rays = count;
+    r.pickMs = time([&] { Pick(rays.data(), count, pick.data(), 1e30f, false); });
+    r.pickMsMT = time([&] { Pick(rays.data(), count, pickMT.data(), 1e30f, true); });
+    r.marchMs = time([&] { for (size_t i = 0; i < count; ++i) march[i] = March(rays[i]); });
+
+    uint64_t steps = 0, marchSteps = 0;
+    for (size_t i = 0; i < count; ++i) {
+        Trace(rays[i], 1e30f, &steps);
+        MarchImpl(rays[i], 1e30f, &marchSteps);
+    }
+    r.stepsPerRay = (double)steps / count;
+    r.marchStepsPerRay = (double)marchSteps / count;
+    r.mraysPerSec = r.pickMs > 0.0 ? (double)count / (r.pickMs * 1000.0) : 0.0;
+
+    const float texel = std::max(gx / f.Width(), gz / f.Height());
+    for (size_t i = 0; i < count; ++i) {
+        r.hits += pick[i].hit;
+        const bool differ = pick[i].hit != march[i].hit || pick[i].hit != pickMT[i].hit ||
+            (pick[i].hit && std::fabs(pick[i].distance - march[i].distance) > texel);
+        r.disagreements += differ;
+    }
+    return r;
+}
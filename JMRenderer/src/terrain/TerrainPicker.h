@@ -0,0 +1,85 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class TerrainHeightField;
+
+// ̸ min/max Ƕ̵ +   ȸ ( ŷ)
+//  = ؼ ߽ 4  ּ ġ ϳ (̴ ð  )
+// ̰  ְ θ   ü ǳʶٰ,  ġ ؼ 
+//  = ̰ ó  /Ʒ   ( Ʒ ϸ )
+//   簢 [-GridSize/2, GridSize/2] (  WRAP ݺ )
+// D3D  . (TerrainHeightField) ϹǷ ũⰡ ٲ Build,
+// Ϻ ุ ٲ(TerrainHeightField::SetRows) UpdateRows ٽ ȣ
+
+struct TerrainRay {
+    float origin[3];
+    float dir[3];           // ȭ ʾƵ  (distance  Ÿ)
+};
+
+struct TerrainRayHit {
+    bool  hit = false;
+    float pos[3] = {};
+    float normal[3] = { 0, 1, 0 };  //   (NormalAt)
+    float distance = 0.0f;          // origin pos
+};
+
+class TerrainPicker {
+public:
+    bool Build(const TerrainHeightField& field);
+    void Clear();
+    //  ؼ  [y0, y1) ٲ:      ٽ 
+    void UpdateRows(int y0, int y1);
+    bool Empty() const { return mLevels.empty(); }
+    int LevelCount() const { return (int)mLevels.size(); }
+    size_t Bytes() const;
+
+    // maxDist  ù . parallel̸  ھ ̸  ó
+    void Pick(const TerrainRay* rays, size_t n, TerrainRayHit* out, float maxDist = 1e30f, bool parallel = false) const;
+    TerrainRayHit Pick(const TerrainRay& ray, float maxDist = 1e30f) const;
+
+    //  :  ؼ    + ̺ Ž ( 츮 ĥ  )
+    TerrainRayHit March(const TerrainRay& ray, float maxDist = 1e30f) const;
+
+    struct BenchResult {
+        size_t rays = 0;
+        size_t hits = 0;
+        double pickMs = 0.0;            //  ( )
+        double pickMsMT = 0.0;          //  ()
+        double marchMs = 0.0;           //   ( )
+        double mraysPerSec = 0.0;       //    
+        double stepsPerRay = 0.0;       //   湮
+        double marchStepsPerRay = 0.0;  //  
+        size_t disagreements = 0;       //   Ǵ Ÿ(1ؼ ʰ) ٸ   (밳  ģ )
+    };
+
+    //     Ʒ 񽺵   õ  count
+    BenchResult Benchmark(size_t count, int iterations = 3) const;
+
+private:
+    struct Level {
+        int w = 0, h = 0;
+        std::vector<uint8_t> minH, maxH;    // 0~255 (R8  ),  켱
+    };
+
+    // ̸   ű  ڷ ڸ 
+    // : x/z   ( L = [L, L+1)), y  . t  Ÿ ״
+    struct RaySetup {
+        double o[3], d[3];
+        double dirN[3];         // ȭ  
+        double tEnter, tExit;
+        double k;               // 0~255   
+    };
+
+    void LeafRow(int m);
+    void ParentRow(int level, int z);
+    bool Setup(const TerrainRay& ray, float maxDist, RaySetup& s) const;
+    bool LeafHit(int cx, int cz, const RaySetup& s, double t0, double t1, double& tHit) const;
+    void Finish(const TerrainRay& ray, const RaySetup& s, double t, TerrainRayHit& out) const;
+    TerrainRayHit Trace(const TerrainRay& ray, float maxDist, uint64_t* steps) const;
+    TerrainRayHit MarchImpl(const TerrainRay& ray, float maxDist, uint64_t* steps) const;
+
+    const TerrainHeightField* mField = nullptr;
+    std::vector<Level> mLevels;         // [0] =  (W+1)x(H+1),  = 1x1
+};
@@ -0,0 +1,226 @@
+#include "TerrainQuadTree.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+static inline bool SphereIntersectsBox(const float c[3], float r, const float box[6])
+{
+    float d2 = 0.0f;
+    for (int a = 0; a < 3; ++a) {
+        float v = c[a];
+        if (v < box[a])          d2 += (box[a] - v) * (box[a] - v);
+        else if (v > box[a + 3]) d2 += (v - box[a + 3]) * (v - box[a + 3]);
+    }
+    return d2 <= r * r;
+}
+
+void TerrainQuadTree::Build(const TerrainQuadTreeDesc& desc, const uint8_t* heights, int w, int h)
+{
+    mDesc = desc;
+    mDesc.lodCount = std::max(1, std::min(mDesc.lodCount, 12));
+    mDesc.patchRes = std::max(2, mDesc.patchRes & ~1); //   ¦
+
+    const int L = mDesc.lodCount;
+    mMinH.assign(L, {});
+    mMaxH.assign(L, {});
+
+    //  LOD 0: 尡  ؼ(̸Ͼ footprint ) min/max 
+    const int n0 = NodesPerSide(0);
+    mMinH[0].resize(n0 * n0);
+    mMaxH[0].resize(n0 * n0);
+    for (int iz = 0; iz < n0; ++iz) LeafRow(iz, heights, w, h);
+
+    //   LOD: ڽ 4 min/max 
+    for (int lod = 1; lod < L; ++lod) {
+        const int n = NodesPerSide(lod);
+        mMinH[lod].resize(n * n);
+        mMaxH[lod].resize(n * n);
+        for (int iz = 0; iz < n; ++iz) ParentRow(lod, iz);
+    }
+
+    mRanges.assign(L, 0.0f);
+    mMorph.assign(L * 2, 0.0f);
+}
+
+// uv  ؼ ߽ ǥ (u*w - 0.5), ÷ WRAP̹Ƿ  μ д´
+static inline void LeafTexels(int i, int n, int size, int& t0, int& t1)
+{
+    t0 = (int)std::floor((float)i / n * size - 0.5f);
+    t1 = (int)std::floor((float)(i + 1) / n * size - 0.5f) + 1;
+}
+
+void TerrainQuadTree::LeafRow(int iz, const uint8_t* heights, int w, int h)
+{
+    const int n0 = NodesPerSide(0);
+    for (int ix = 0; ix < n0; ++ix) {
+        uint8_t lo = 0, hi = 255;
+        if (heights && w > 0 && h > 0) {
+            int tx0, tx1, tz0, tz1;
+            LeafTexels(ix, n0, w, tx0, tx1);
+            LeafTexels(iz, n0, h, tz0, tz1);
+            lo = 255; hi = 0;
+            for (int tz = tz0; tz <= tz1; ++tz) {
+                const uint8_t* row = heights + (size_t)(((tz % h) + h) % h) * w;
+                for (int tx = tx0; tx <= tx1; ++tx) {
+                    uint8_t v = row[((tx % w) + w) % w];
+                    lo = std::min(lo, v);
+                    hi = std::max(hi, v);
+                }
+            }
+        }
+        mMinH[0][iz * n0 + ix] = lo;
+        mMaxH[0][iz * n0 + ix] = hi;
+    }
+}
+
+void TerrainQuadTree::ParentRow(int lod, int iz)
+{
+    const int n = NodesPerSide(lod), cn = n * 2;
+    for (int ix = 0; ix < n; ++ix) {
+        uint8_t lo = 255, hi = 0;
+        for (int q = 0; q < 4; ++q) {
+            int c = (iz * 2 + (q >> 1)) * cn + (ix * 2 + (q & 1));
+            lo = std::min(lo, mMinH[lod - 1][c]);
+            hi = std::max(hi, mMaxH[lod - 1][c]);
+        }
+        mMinH[lod][iz * n + ix] = lo;
+        mMaxH[lod][iz * n + ix] = hi;
+    }
+}
+
+void TerrainQuadTree::UpdateRows(const uint8_t* heights, int w, int h, int y0, int y1)
+{
+    if (mMinH.empty() || !heights || w <= 0 || h <= 0 || y1 <= y0) return;
+
+    //  LOD 0: footprint( ) ٲ ࿡ ɸ  ุ 
+    const int n0 = NodesPerSide(0);
+    std::vector<uint8_t> dirty(n0, 0);
+    for (int iz = 0; iz < n0; ++iz) {
+        int tz0, tz1;
+        LeafTexels(iz, n0, h, tz0, tz1);
+        for (int tz = tz0; tz <= tz1 && !dirty[iz]; ++tz) {
+            const int r = ((tz % h) + h) % h;
+            dirty[iz] = r >= y0 && r < y1;
+        }
+        if (dirty[iz]) LeafRow(iz, heights, w, h);
+    }
+
+    //  : ڽ    ϳ ٲ ุ (dirty[iz]   ) 
+    for (int lod = 1; lod < mDesc.lodCount; ++lod) {
+        const int n = NodesPerSide(lod);
+        for (int iz = 0; iz < n; ++iz) {
+            dirty[iz] = dirty[iz * 2] || dirty[iz * 2 + 1];
+            if (dirty[iz]) ParentRow(lod, iz);
+        }
+    }
+}
+
+int TerrainQuadTree::SuggestLodCount(int texW, int texH, int patchRes)
+{
+    //   ϳ ġ ػ󵵸ŭ ؼ 
+    float texPerPatch = (float)std::max(texW, texH) / (float)std::max(patchRes, 1);
+    int L = 1 + (int)std::ceil(std::log2(std::max(texPerPatch, 1.0f)));
+    return std::max(1, std::min(L, 12));
+}
+
+void TerrainQuadTree::NodeBox(int lod, int ix, int iz, float hs, float box[6]) const
+{
+    const int n = NodesPerSide(lod);
+    const float sx = mDesc.sizeX / n, sz = mDesc.sizeZ / n;
+    const int i = iz * n + ix;
+    box[0] = mDesc.originX + ix * sx;
+    box[1] = mMinH[lod][i] * (1.0f / 255.0f) * hs;
+    box[2] = mDesc.originZ + iz * sz;
+    box[3] = box[0] + sx;
+    box[4] = mMaxH[lod][i] * (1.0f / 255.0f) * hs;
+    box[5] = box[2] + sz;
+}
+
+void TerrainQuadTree::Emit(int lod, int ix, int iz, uint16_t mask, std::vector<TerrainDraw>& out)
+{
+    float b[6];
+    NodeBox(lod, ix, iz, mHeightScale, b);
+    TerrainDraw d;
+    d.x = b[0]; d.z = b[2];
+    d.sizeX = b[3] - b[0]; d.sizeZ = b[5] - b[2];
+    d.minY = b[1]; d.maxY = b[4];
+    d.lod = (uint16_t)lod;
+    d.quadMask = mask;
+    out.push_back(d);
+
+    mStats.drawCount++;
+    for (int q = 0; q < 4; ++q) mStats.quadCount += (mask >> q) & 1;
+}
+
+// ȯ:    ó true, ڱ LOD Ÿ ̸ false (θ ׸)
+bool TerrainQuadTree::SelectNode(int lod, int ix, int iz, std::vector<TerrainDraw>& out)
+{
+    mStats.nodesVisited++;
+
+    float box[6];
+    NodeBox(lod, ix, iz, mHeightScale, box);
+    if (!SphereIntersectsBox(mCam, mRanges[lod], box)) return false;
+
+    if (lod == 0 || !SphereIntersectsBox(mCam, mRanges[lod - 1], box)) {
+        Emit(lod, ix, iz, TerrainQuadAll, out);
+        return true;
+    }
+
+    // ڽ    LOD Ÿ ۿ ִ и鸸  LOD ׸
+    uint16_t mask = 0;
+    for (int q = 0; q < 4; ++q) {
+        if (!SelectNode(lod - 1, ix * 2 + (q & 1), iz * 2 + (q >> 1), out))
+            mask |= (uint16_t)(1u << q);
+    }
+    if (mask) Emit(lod, ix, iz, mask, out);
+    return true;
+}
+
+void TerrainQuadTree::Select(const TerrainSelectParams& p, std::vector<TerrainDraw>& out)
+{
+    auto t0 = std::chrono::steady_clock::now();
+
+    out.clear();
+    mStats = {};
+    if (mMinH.empty()) return;
+
+    mCam[0] = p.camPos[0]; mCam[1] = p.camPos[1]; mCam[2] = p.camPos[2];
+    mHeightScale = p.heightScale;
+
+    //  ȭ   LOD Ÿ 
+    //   s Ÿ d ȭ鿡 ϴ ȼ  s * K / d, K = H / (2 tan(fov/2))
+    const int L = mDesc.lodCount;
+    const int n0 = NodesPerSide(0);
+    const float leafX = mDesc.sizeX / n0, leafZ = mDesc.sizeZ / n0;
+    const float spacing0 = std::max(leafX, leafZ) / mDesc.patchRes;
+    const float K = p.viewportH / (2.0f * std::tan(p.fovY * 0.5f));
+    //   庸 ª ̿ LOD ̰ 1   ־  д
+    const float leafDiag = std::sqrt(leafX * leafX + leafZ * leafZ);
+    const float r0 = std::max(spacing0 * K / std::max(p.pixelError, 0.01f), leafDiag * 2.0f);
+
+    float prev = 0.0f;
+    for (int lod = 0; lod < L; ++lod) {
+        float r = r0 * (float)(1 << lod);
+        float start = prev + (r - prev) * p.morphStartRatio;
+        mRanges[lod] = r;
+        mMorph[lod * 2 + 0] = start;
+        mMorph[lod * 2 + 1] = (lod == L - 1) ? 0.0f : 1.0f / std::max(r - start, 1e-6f);
+        prev = r;
+    }
+
+    // Ʈ Ÿ ϰ ׻ ׸
+    const int top = L - 1;
+    const int nTop = NodesPerSide(top);
+    for (int iz = 0; iz < nTop; ++iz)
+        for (int ix = 0; ix < nTop; ++ix)
+            if (!SelectNode(top, ix, iz, out)) Emit(top, ix, iz, TerrainQuadAll, out);
+
+    auto t1 = std::chrono::steady_clock::now();
+    mStats.selectMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+void TerrainQuadTree::MorphConsts(int lod, float out[2]) const
+{
+    out[0] = mMorph[lod * 2 + 0];
+    out[1] = mMorph[lod * 2 + 1];
+}
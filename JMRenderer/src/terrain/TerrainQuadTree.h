@@ -0,0 +1,81 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+// CDLOD Ÿ Ʈ LOD ñ
+// D3D   CPU   (帮 ׽Ʈ/ġ )
+
+struct TerrainQuadTreeDesc {
+    float originX = -5.0f, originZ = -5.0f; //  ּ 𼭸( XZ)
+    float sizeX = 10.0f, sizeZ = 10.0f;     //  ü ũ( XZ)
+    int   lodCount = 5;                     // LOD ܰ  (0 =  )
+    int   patchRes = 16;                    // ġ     (¦)
+};
+
+struct TerrainSelectParams {
+    float camPos[3] = { 0, 0, 0 };
+    float heightScale = 1.0f;
+    float viewportH = 900.0f;       // ȼ
+    float fovY = 0.785398f;         // 
+    float pixelError = 2.0f;        //  ȭ (ȼ)
+    float morphStartRatio = 0.66f;  //    (LOD  )
+};
+
+// и Ʈ: bit0(-X-Z), bit1(+X-Z), bit2(-X+Z), bit3(+X+Z)
+enum : uint16_t { TerrainQuadAll = 0xF };
+
+// (node, lod) ο  
+struct TerrainDraw {
+    float x, z;             //  ּ 𼭸
+    float sizeX, sizeZ;     //  ũ
+    float minY, maxY;       //    (HeightScale )
+    uint16_t lod;
+    uint16_t quadMask;      // ׸ и (TerrainQuadAll = ü)
+};
+
+struct TerrainSelectStats {
+    int    nodesVisited = 0;
+    int    drawCount = 0;
+    int    quadCount = 0;       // и  ο 
+    double selectMs = 0.0;
+};
+
+class TerrainQuadTree {
+public:
+    // heights: R8 ̸ (nullptr̸   0~1 )
+    void Build(const TerrainQuadTreeDesc& desc, const uint8_t* heights, int w, int h);
+    //   [y0, y1) ٲ ( w*h Build ):  ࿡ ɸ   ٽ 
+    void UpdateRows(const uint8_t* heights, int w, int h, int y0, int y1);
+
+    // ī޶  带  out  (out Ź )
+    void Select(const TerrainSelectParams& p, std::vector<TerrainDraw>& out);
+
+    const TerrainQuadTreeDesc& Desc() const { return mDesc; }
+    const TerrainSelectStats& Stats() const { return mStats; }
+
+    //  Select  LOD  Ÿ
+    float LodRange(int lod) const { return mRanges[lod]; }
+    // ̴   (start, 1/(end-start)) - ֻ LOD  
+    void MorphConsts(int lod, float out[2]) const;
+
+    // lod 0       2^(lodCount-1)
+    static int SuggestLodCount(int texW, int texH, int patchRes);
+
+private:
+    int  NodesPerSide(int lod) const { return 1 << (mDesc.lodCount - 1 - lod); }
+    void LeafRow(int iz, const uint8_t* heights, int w, int h);
+    void ParentRow(int lod, int iz);
+    void NodeBox(int lod, int ix, int iz, float hs, float box[6]) const;
+    bool SelectNode(int lod, int ix, int iz, std::vector<TerrainDraw>& out);
+    void Emit(int lod, int ix, int iz, uint16_t mask, std::vector<TerrainDraw>& out);
+
+    TerrainQuadTreeDesc mDesc;
+    // LOD   min/max (0~255,  켱)
+    std::vector<std::vector<uint8_t>> mMinH, mMaxH;
+
+    std::vector<float> mRanges;
+    std::vector<float> mMorph;      // lod*2 + {start, invLen}
+    float mCam[3] = { 0, 0, 0 };
+    float mHeightScale = 1.0f;
+    TerrainSelectStats mStats;
+};
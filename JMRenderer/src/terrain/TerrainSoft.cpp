@@ -0,0 +1,421 @@
+#include "TerrainSoft.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+    float Saturate(float v) { return std::min(std::max(v, 0.0f), 1.0f); }
+    float Frac(float v) { return v - std::floor(v); }
+
+    float SmoothStep(float a, float b, float x)
+    {
+        const float t = Saturate((x - a) / (b - a));
+        return t * t * (3.0f - 2.0f * t);
+    }
+
+    void Normalize3(float v[3])
+    {
+        const float len = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+        const float inv = len > 0.0f ? 1.0f / len : 0.0f;
+        v[0] *= inv; v[1] *= inv; v[2] *= inv;
+    }
+
+    template<class T>
+    T LoadCB(const uint8_t* p)
+    {
+        T v{};
+        if (p) memcpy(&v, p, sizeof(T));
+        return v;
+    }
+
+    bool LinearOf(const Soft::Sampler* s) { return s ? s->linear : true; }
+
+    //  terrain_vs.hlsl 
+
+    struct VSConsts {
+        TerrainSoftSceneCB scene;
+        TerrainSoftTerrainCB terrain;
+        TerrainNodeCB node;
+        const Soft::Texture* height;
+        const Soft::Texture* normalHeight;
+        bool linear;
+    };
+
+    VSConsts LoadVS(const Soft::DrawResources& r)
+    {
+        const int vs = (int)Render::Stage::VS;
+        VSConsts c;
+        c.scene = LoadCB<TerrainSoftSceneCB>(r.cb[vs][0]);
+        c.terrain = LoadCB<TerrainSoftTerrainCB>(r.cb[vs][1]);
+        c.node = LoadCB<TerrainNodeCB>(r.cb[vs][3]);
+        c.height = r.srv[vs][0];
+        c.normalHeight = r.srv[vs][1];
+        c.linear = LinearOf(r.sampler[vs][0]);
+        return c;
+    }
+
+    float SampleChannel(const VSConsts& c, const Soft::Texture* t, float u, float v, int ch)
+    {
+        if (!t) return 0.0f;
+        float o[4];
+        t->Sample(u, v, 0.0f, c.linear, o);
+        return o[ch];
+    }
+
+    bool Baked(const VSConsts& c) { return c.terrain.UseBakedNormals > 0.5f && c.normalHeight; }
+
+    float SampleHeight(const VSConsts& c, float u, float v)
+    {
+        if (Baked(c)) return SampleChannel(c, c.normalHeight, u, v, 3) * c.terrain.HeightScale;
+        return SampleChannel(c, c.height, u, v, 0) * c.terrain.HeightScale;
+    }
+
+    void NormalFromHeights(const VSConsts& c, float u, float v, float h, float n[3])
+    {
+        const float hr = SampleChannel(c, c.height, u + c.terrain.TexelSize[0], v, 0) * c.terrain.HeightScale;
+        const float hd = SampleChannel(c, c.height, u, v + c.terrain.TexelSize[1], 0) * c.terrain.HeightScale;
+        const float dx = c.terrain.GridSize[0] * c.terrain.TexelSize[0];
+        const float dz = c.terrain.GridSize[1] * c.terrain.TexelSize[1];
+        // cross(Bd, Tr), Tr = (dx, hr-h, 0), Bd = (0, hd-h, dz)
+        const float Tr[3] = { dx, hr - h, 0.0f }, Bd[3] = { 0.0f, hd - h, dz };
+        n[0] = Bd[1] * Tr[2] - Bd[2] * Tr[1];
+        n[1] = Bd[2] * Tr[0] - Bd[0] * Tr[2];
+        n[2] = Bd[0] * Tr[1] - Bd[1] * Tr[0];
+        Normalize3(n);
+    }
+
+    // g: ġ  ǥ(0~1).  varying: nrmWS(0~2), uv(3~4), worldPos(5~7)
+    void TerrainVS(const Soft::DrawResources& r, float gx, float gz, Soft::ClipVertex& o)
+    {
+        const VSConsts c = LoadVS(r);
+        const TerrainNodeCB& nd = c.node;
+
+        //  :    ī޶ Ÿ
+        const float x0 = nd.NodeOrigin[0] + gx * nd.NodeSize[0];
+        const float z0 = nd.NodeOrigin[1] + gz * nd.NodeSize[1];
+        const float h0 = SampleHeight(c, x0 / c.terrain.GridSize[0] + 0.5f, z0 / c.terrain.GridSize[1] + 0.5f);
+        const float d0[3] = { x0 - c.scene.CamPos[0], h0 - c.scene.CamPos[1], z0 - c.scene.CamPos[2] };
+        const float dist = std::sqrt(d0[0] * d0[0] + d0[1] * d0[1] + d0[2] * d0[2]);
+        const float k = Saturate((dist - nd.MorphConsts[0]) * nd.MorphConsts[1]);
+
+        const float mx = gx - Frac(gx * nd.PatchRes * 0.5f) * 2.0f / nd.PatchRes * k;
+        const float mz = gz - Frac(gz * nd.PatchRes * 0.5f) * 2.0f / nd.PatchRes * k;
+        const float x = nd.NodeOrigin[0] + mx * nd.NodeSize[0];
+        const float z = nd.NodeOrigin[1] + mz * nd.NodeSize[1];
+        const float u = x / c.terrain.GridSize[0] + 0.5f;
+        const float v = z / c.terrain.GridSize[1] + 0.5f;
+
+        float h, n[3];
+        if (Baked(c)) {
+            float nh[4];
+            c.normalHeight->Sample(u, v, 0.0f, c.linear, nh);
+            h = nh[3] * c.terrain.HeightScale;
+            n[0] = nh[0] * 2.0f - 1.0f; n[1] = nh[1] * 2.0f - 1.0f; n[2] = nh[2] * 2.0f - 1.0f;
+            Normalize3(n);
+        }
+        else {
+            h = SampleChannel(c, c.height, u, v, 0) * c.terrain.HeightScale;
+            NormalFromHeights(c, u, v, h, n);
+        }
+
+        // mul(float4(p, 1), gWVP): ø  ġ Ƿ  j 
+        const float p[4] = { x, h, z, 1.0f };
+        for (int j = 0; j < 4; ++j) {
+            const float* row = c.scene.WVP + j * 4;
+            o.pos[j] = row[0] * p[0] + row[1] * p[1] + row[2] * p[2] + row[3] * p[3];
+        }
+        o.var[0] = n[0]; o.var[1] = n[1]; o.var[2] = n[2];
+        o.var[3] = u;    o.var[4] = v;
+        o.var[5] = x;    o.var[6] = h;    o.var[7] = z;
+    }
+
+    void VSMain(const Soft::DrawResources& r, uint32_t, const uint8_t* vertex, Soft::ClipVertex& o)
+    {
+        float uv[2];
+        memcpy(uv, vertex + offsetof(VertexPNT, uv), sizeof(uv));
+        TerrainVS(r, uv[0], uv[1], o);
+    }
+
+    void VSMainQuant16(const Soft::DrawResources& r, uint32_t, const uint8_t* vertex, Soft::ClipVertex& o)
+    {
+        VertexQuant16 q;
+        memcpy(&q, vertex, sizeof(q));
+        const float res = LoadCB<TerrainNodeCB>(r.cb[(int)Render::Stage::VS][3]).PatchRes;
+        TerrainVS(r, (float)q.x / res, (float)q.z / res, o);
+    }
+
+    void VSMainVertexId(const Soft::DrawResources& r, uint32_t vid, const uint8_t*, Soft::ClipVertex& o)
+    {
+        const float res = LoadCB<TerrainNodeCB>(r.cb[(int)Render::Stage::VS][3]).PatchRes;
+        const uint32_t vn = (uint32_t)res + 1;
+        TerrainVS(r, (float)(vid % vn) / res, (float)(vid / vn) / res, o);
+    }
+
+    //  terrain_ps.hlsl 
+
+    uint32_t PSMain(const Soft::DrawResources& r, const float* var, float uvPerPixel)
+    {
+        const int ps = (int)Render::Stage::PS;
+        const TerrainSoftSceneCB scene = LoadCB<TerrainSoftSceneCB>(r.cb[ps][0]);
+        const TerrainSoftTerrainCB terrain = LoadCB<TerrainSoftTerrainCB>(r.cb[ps][1]);
+        const TerrainSoftMatCB mat = LoadCB<TerrainSoftMatCB>(r.cb[ps][2]);
+
+        float N[3] = { var[0], var[1], var[2] };
+        Normalize3(N);
+        float L[3] = { -scene.LightDir[0], -scene.LightDir[1], -scene.LightDir[2] };
+        Normalize3(L);
+        const float ndl = Saturate(N[0] * L[0] + N[1] * L[1] + N[2] * L[2]);
+
+        const float hNorm = Saturate(var[6] / std::max(terrain.HeightScale, 1e-4f));
+        const float slope = 1.0f - Saturate(N[1]);
+
+        const float wSnow = SmoothStep(mat.thresholds[1] - mat.band, mat.thresholds[1] + mat.band, hNorm);
+        const float wRock = SmoothStep(mat.thresholds[2], mat.thresholds[3], slope);
+        const float wGrass = 1.0f - std::max(wSnow, wRock);
+        const float sum = wGrass + wRock + wSnow + 1e-5f;
+        const float w[3] = { wGrass / sum, wRock / sum, wSnow / sum };
+
+        // Sample():  ﰢ  ȭ ̺ 
+        const float u = var[3] * mat.uvScale, v = var[4] * mat.uvScale;
+        const bool linear = LinearOf(r.sampler[ps][0]);
+        float albedo[3] = { 0, 0, 0 };
+        for (int i = 0; i < 3; ++i) {
+            const Soft::Texture* t = r.srv[ps][i];
+            if (!t) continue;
+            const float texels = uvPerPixel * mat.uvScale * (float)std::max(t->Width(), t->Height());
+            const float lod = texels > 0.0f ? std::log2(texels) : 0.0f;
+            float c[4];
+            t->Sample(u, v, lod, linear, c);
+            for (int k = 0; k < 3; ++k) albedo[k] += w[i] * c[k];
+        }
+
+        const float dx = var[5] - scene.CamPos[0], dy = var[6] - scene.CamPos[1], dz = var[7] - scene.CamPos[2];
+        const float d = std::sqrt(dx * dx + dy * dy + dz * dz);
+        const float f = Saturate(1.0f - std::exp(-scene.FogDensity * d));
+
+        uint32_t out = 0xFF000000u;
+        for (int k = 0; k < 3; ++k) {
+            const float col = albedo[k] * (0.2f + 0.8f * ndl);
+            const float fogged = col + (scene.FogColor[k] - col) * f;
+            out |= (uint32_t)(Saturate(fogged) * 255.0f + 0.5f) << (8 * k);
+        }
+        return out;
+    }
+
+    const Soft::VertexProgram kVertexPrograms[3] = {
+        { VSMain, 8, 3, "VSMain" },
+        { VSMainQuant16, 8, 3, "VSMainQuant16" },
+        { VSMainVertexId, 8, 3, "VSMainVertexId" },
+    };
+    const Soft::PixelProgram kPixelProgram = { PSMain, "PSMain" };
+
+    double MsSince(std::chrono::steady_clock::time_point t0)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    }
+
+} // namespace
+
+namespace TerrainSoft {
+
+    const Soft::VertexProgram& VertexProgram(GridVertexFormat format)
+    {
+        return kVertexPrograms[std::min(std::max((int)format, 0), 2)];
+    }
+
+    const Soft::PixelProgram& PixelProgram()
+    {
+        return kPixelProgram;
+    }
+
+} // namespace TerrainSoft
+
+//  TerrainSoftRenderer 
+
+bool TerrainSoftRenderer::Init(const uint8_t* heights, int w, int h, float gridSizeX, float gridSizeZ, int patchRes)
+{
+    if (!heights || w <= 0 || h <= 0) return false;
+    mHeights.assign(heights, heights + (size_t)w * h);
+    mW = w; mH = h;
+    mGridX = gridSizeX; mGridZ = gridSizeZ;
+    mPatchRes = std::max(2, patchRes & ~1);
+    mBakedScale = -1.0f;
+    if (!mHeightTex.Init(mHeights.data(), w, h, w, 1, MipFilter::Linear)) return false;
+
+    // Ʈ: main BuildTerrainTree  
+    TerrainQuadTreeDesc qd{};
+    qd.originX = -gridSizeX * 0.5f; qd.originZ = -gridSizeZ * 0.5f;
+    qd.sizeX = gridSizeX; qd.sizeZ = gridSizeZ;
+    qd.patchRes = mPatchRes;
+    qd.lodCount = TerrainQuadTree::SuggestLodCount(w, h, mPatchRes);
+    mTree.Build(qd, mHeights.data(), w, h);
+
+    // ġ: GridMesh::InitPatch  и  (ĳ ȭ CPU ǹ  )
+    const int vn = mPatchRes + 1;
+    std::vector<uint32_t> inds;
+    Grid::BuildPatchIndices(mPatchRes, inds);
+    mIndexCount = (uint32_t)inds.size();
+    if (vn * vn <= 65536) {
+        mIB.bytes.resize(inds.size() * sizeof(uint16_t));
+        uint16_t* dst = reinterpret_cast<uint16_t*>(mIB.bytes.data());
+        for (size_t i = 0; i < inds.size(); ++i) dst[i] = (uint16_t)inds[i];
+    }
+    else {
+        mIB.bytes.resize(inds.size() * sizeof(uint32_t));
+        memcpy(mIB.bytes.data(), inds.data(), mIB.bytes.size());
+    }
+
+    std::vector<VertexPNT> pnt(vn * vn);
+    std::vector<VertexQuant16> q16(vn * vn);
+    for (int z = 0; z < vn; ++z)
+        for (int x = 0; x < vn; ++x) {
+            const float u = (float)x / mPatchRes, v = (float)z / mPatchRes;
+            pnt[z * vn + x] = { { u, 0.0f, v }, { 0, 1, 0 }, { u, v } };
+            q16[z * vn + x] = { (uint16_t)x, (uint16_t)z };
+        }
+    mVB[(int)GridVertexFormat::Float32].bytes.assign((const uint8_t*)pnt.data(), (const uint8_t*)(pnt.data() + pnt.size()));
+    mVB[(int)GridVertexFormat::Quant16].bytes.assign((const uint8_t*)q16.data(), (const uint8_t*)(q16.data() + q16.size()));
+    mVB[(int)GridVertexFormat::VertexId].bytes.clear();
+
+    // ˺ ε  ü (ܵ//)
+    const uint8_t solid[3][4] = { { 86, 125, 70, 255 }, { 120, 112, 104, 255 }, { 235, 238, 242, 255 } };
+    for (int i = 0; i < 3; ++i)
+        if (mAlbedo[i].Levels() == 0) mAlbedo[i].InitSolid(solid[i]);
+    return true;
+}
+
+void TerrainSoftRenderer::SetAlbedo(int i, const uint8_t* rgba, int w, int h, size_t rowPitch)
+{
+    if (i < 0 || i >= 3 || !rgba) return;
+    mAlbedo[i].Init(rgba, w, h, rowPitch, 4, MipFilter::Linear);
+}
+
+void TerrainSoftRenderer::Rebake(float heightScale)
+{
+    NormalBakeParams bp;
+    bp.gridSizeX = mGridX; bp.gridSizeZ = mGridZ;
+    bp.heightScale = heightScale;
+    mNormalHeight.resize((size_t)mW * mH * 4);
+    TerrainBake::NormalHeightParallel(mHeights.data(), mW, mH, bp, mNormalHeight.data(), 0, mH);
+    mNormalTex.Init(mNormalHeight.data(), mW, mH, (size_t)mW * 4, 4, MipFilter::Linear);
+    mBakedScale = heightScale;
+}
+
+const Soft::FrameStats& TerrainSoftRenderer::Render(const TerrainSoftFrame& f, Soft::Target& target,
+    Soft::Path path, bool parallel)
+{
+    if (mHeights.empty()) return mExec.RasterStats();
+    if (f.bakedNormals && mBakedScale != f.heightScale) Rebake(f.heightScale);
+    target.Clear(f.clear);
+
+    // LOD  + ü ø (RenderFrame  )
+    TerrainSelectParams tsp{};
+    memcpy(tsp.camPos, f.camPos, sizeof(tsp.camPos));
+    tsp.heightScale = f.heightScale;
+    tsp.viewportH = (float)target.height;
+    tsp.fovY = f.fovY;
+    tsp.pixelError = f.pixelError;
+    mTree.Select(tsp, mDraws);
+
+    mVisible.resize(mDraws.size());
+    size_t vis = mDraws.size();
+    if (f.frustumCull) {
+        mBoxes.Clear();
+        mBoxes.Reserve(mDraws.size());
+        for (const TerrainDraw& d : mDraws) mBoxes.Push(d.x, d.minY, d.z, d.x + d.sizeX, d.maxY, d.z + d.sizeZ);
+        vis = Cull::FrustumAABBs(Frustum::FromViewProj(f.viewProj), mBoxes, mVisible.data());
+    }
+    else {
+        for (size_t i = 0; i < vis; ++i) mVisible[i] = (uint32_t)i;
+    }
+    mVisible.resize(vis);
+
+    TerrainSoftSceneCB scene{};
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j) scene.WVP[j * 4 + i] = f.viewProj[i * 4 + j];
+    memcpy(scene.LightDir, f.lightDir, sizeof(scene.LightDir));
+    memcpy(scene.FogColor, f.fogColor, sizeof(scene.FogColor));
+    scene.FogDensity = f.fogDensity;
+    memcpy(scene.CamPos, f.camPos, sizeof(scene.CamPos));
+
+    TerrainSoftTerrainCB terrain{};
+    terrain.HeightScale = f.heightScale;
+    terrain.UseBakedNormals = f.bakedNormals ? 1.0f : 0.0f;
+    terrain.GridSize[0] = mGridX; terrain.GridSize[1] = mGridZ;
+    terrain.TexelSize[0] = 1.0f / (float)mW; terrain.TexelSize[1] = 1.0f / (float)mH;
+
+    TerrainSoftMatCB mat{};
+    memcpy(mat.thresholds, f.thresholds, sizeof(mat.thresholds));
+    mat.band = f.band;
+    mat.uvScale = f.uvScale;
+
+    const int fmt = (int)f.format;
+    TerrainPassResources tr;
+    tr.pipeline.inputLayout = f.format == GridVertexFormat::VertexId ? nullptr : &mLayoutMarker;
+    tr.pipeline.vs = &TerrainSoft::VertexProgram(f.format);
+    tr.pipeline.ps = &TerrainSoft::PixelProgram();
+    tr.pipeline.rasterizer = &mSolid;
+    tr.pipeline.name = "terrain (soft)";
+    TerrainPass::ApplyRequirements(tr.pipeline);
+    tr.patch.vb = f.format == GridVertexFormat::VertexId ? nullptr : &mVB[fmt];
+    tr.patch.stride = Grid::VertexStride(f.format);
+    tr.patch.ib = &mIB;
+    tr.patch.indexFormat = (mPatchRes + 1) * (mPatchRes + 1) <= 65536 ? Render::IndexFormat::U16 : Render::IndexFormat::U32;
+    tr.indexCount = mIndexCount;
+    tr.patchRes = mPatchRes;
+    tr.sceneCB = &mSceneCB;
+    tr.terrainCB = &mTerrainCB;
+    tr.matCB = &mMatCB;
+    tr.nodeCB = &mNodeCB;
+    tr.heightSRV = &mHeightTex;
+    tr.normalSRV = f.bakedNormals ? &mNormalTex : nullptr;
+    tr.heightSampler = &mLinear;
+    for (int i = 0; i < 3; ++i) tr.albedoSRVs[i] = &mAlbedo[i];
+    tr.albedoSampler = &mLinear;
+
+    TerrainPassConstants tk;
+    tk.scene = &scene;     tk.sceneBytes = sizeof(scene);
+    tk.terrain = &terrain; tk.terrainBytes = sizeof(terrain);
+    tk.mat = &mat;         tk.matBytes = sizeof(mat);
+    memcpy(tk.camPos, f.camPos, sizeof(tk.camPos));
+
+    mList.Reset();
+    TerrainPass::Record(mList, tr, tk, mTree, mDraws, mVisible);
+    mList.Sort();
+
+    mExec.SetTarget(&target);
+    mExec.SetPath(path);
+    mExec.SetParallel(parallel);
+    mExec.Submit(mList);
+    return mExec.RasterStats();
+}
+
+TerrainSoftRenderer::BenchResult TerrainSoftRenderer::Benchmark(const TerrainSoftFrame& f, int width, int height,
+    Soft::Path path, int iterations)
+{
+    BenchResult r;
+    r.path = Soft::Resolve(path);
+    iterations = std::max(iterations, 1);
+
+    Soft::Target ref, t;
+    ref.Resize(width, height);
+    t.Resize(width, height);
+    Render(f, ref, Soft::Path::Scalar, false);     //  ̹ (ũ ⼭)
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) Render(f, t, r.path, false);
+    r.singleMs = MsSince(t0) / iterations;
+
+    t0 = std::chrono::steady_clock::now();
+    size_t shaded = 0;
+    for (int i = 0; i < iterations; ++i) shaded += Render(f, t, r.path, true).pixelsShaded;
+    r.parallelMs = MsSince(t0) / iterations;
+    r.mpixPerSec = r.parallelMs > 0.0 ? (double)shaded / iterations / (r.parallelMs * 1000.0) : 0.0;
+
+    for (int y = 0; y < height; ++y)
+        for (int x = 0; x < width; ++x)
+            if (t.Pixel(x, y) != ref.Pixel(x, y)) ++r.mismatches;
+    return r;
+}
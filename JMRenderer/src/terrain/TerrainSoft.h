@@ -0,0 +1,111 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "TerrainNormalBake.h"
+#include "TerrainPass.h"
+#include "TerrainQuadTree.h"
+#include "../grid/GridIndices.h"
+#include "../utils/FrustumCull.h"
+#include "../render/SoftExecutor.h"
+
+//  ̴ CPU  (terrain_vs.hlsl / terrain_ps.hlsl  ) + 帮 
+// GPU  Ʈ   ü ø  TerrainPass::Record  SoftExecutor   ׸
+// (ó , ̴    ̹ 񱳿)
+
+//   CPU ġ: HLSL cbuffer  Ʈ (main SceneCB/TerrainCBCPU/MatCBCPU ȣȯ)
+struct TerrainSoftSceneCB {
+    float WVP[16];          // ġ World*View*Proj (GPU ø ״)
+    float LightDir[3];  float _pad0;
+    float FogColor[3];  float FogDensity;
+    float CamPos[3];    float _pad1;
+};
+struct TerrainSoftTerrainCB {
+    float HeightScale;
+    float UseBakedNormals;
+    float _padA[2];
+    float GridSize[2];
+    float TexelSize[2];
+};
+struct TerrainSoftMatCB {
+    float thresholds[4];    // x=hGrassMax, y=hSnowMin, z=slopeLo, w=slopeHi
+    float band;   float _pad[3];
+    float uvScale; float _pad2[3];
+};
+
+//   Է (⺻ main HUD ⺻ )
+struct TerrainSoftFrame {
+    float viewProj[16] = {};        //  켱 + ຤ Ծ (DirectXMath )
+    float camPos[3] = { 0, 0, 0 };
+    float fovY = 0.785398f;
+    float pixelError = 2.0f;
+    float heightScale = 1.5f;
+    bool  bakedNormals = true;
+    bool  frustumCull = true;
+    float lightDir[3] = { -0.4f, -1.0f, -0.3f };
+    float fogColor[3] = { 0.6f, 0.7f, 0.8f };
+    float fogDensity = 0.06f;
+    float thresholds[4] = { 0.35f, 0.75f, 0.45f, 0.85f };
+    float band = 0.08f;
+    float uvScale = 8.0f;
+    float clear[4] = { 0.1f, 0.1f, 0.1f, 1.0f };
+    GridVertexFormat format = GridVertexFormat::Quant16;
+};
+
+namespace TerrainSoft {
+
+    // GridVertexFormat  (VSMain / VSMainQuant16 / VSMainVertexId)
+    const Soft::VertexProgram& VertexProgram(GridVertexFormat format);
+    const Soft::PixelProgram& PixelProgram();
+
+} // namespace TerrainSoft
+
+class TerrainSoftRenderer {
+public:
+    // heights: R8 ().   ߽ gridSizeX x gridSizeZ
+    bool Init(const uint8_t* heights, int w, int h, float gridSizeX, float gridSizeZ, int patchRes = 16);
+    // i: 0 grass, 1 rock, 2 snow. RGBA8 (,  ).   ܻ
+    void SetAlbedo(int i, const uint8_t* rgba, int w, int h, size_t rowPitch);
+
+    // target ũ   ׸
+    const Soft::FrameStats& Render(const TerrainSoftFrame& f, Soft::Target& target,
+        Soft::Path path = Soft::Path::Auto, bool parallel = true);
+
+    const Render::ExecStats& ExecStats() const { return mExec.Stats(); }
+    const Soft::FrameStats& RasterStats() const { return mExec.RasterStats(); }
+    size_t DrawCount() const { return mVisible.size(); }
+
+    struct BenchResult {
+        Soft::Path path = Soft::Path::Scalar;
+        double singleMs = 0.0;      //   1 
+        double parallelMs = 0.0;    // Ƽ
+        double mpixPerSec = 0.0;    // Ƽ  ̵ ȼ
+        size_t mismatches = 0;      // Į   ̹ ٸ ȼ 
+    };
+    BenchResult Benchmark(const TerrainSoftFrame& f, int width, int height, Soft::Path path, int iterations = 3);
+
+private:
+    void Rebake(float heightScale);
+
+    std::vector<uint8_t> mHeights;
+    std::vector<uint8_t> mNormalHeight;
+    int mW = 0, mH = 0;
+    float mGridX = 10.0f, mGridZ = 10.0f;
+    int mPatchRes = 16;
+    float mBakedScale = -1.0f;
+
+    Soft::Texture mHeightTex, mNormalTex, mAlbedo[3];
+    Soft::Sampler mLinear;
+    Soft::RasterState mSolid;
+    Soft::Buffer mVB[3], mIB;           // VB: GridVertexFormat (VertexId  )
+    Soft::Buffer mSceneCB, mTerrainCB, mMatCB, mNodeCB;
+    uint32_t mIndexCount = 0;
+    int mLayoutMarker = 0;              // Է ̾ƿ Handle (  ִ )
+
+    TerrainQuadTree mTree;
+    std::vector<TerrainDraw> mDraws;
+    AABBSoA mBoxes;
+    std::vector<uint32_t> mVisible;
+    Render::CommandList mList;
+    SoftExecutor mExec;
+};
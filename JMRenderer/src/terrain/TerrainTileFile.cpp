@@ -0,0 +1,469 @@
+#include "TerrainTileFile.h"
+#include "../utils/BMPDecode.h"
+#include "../utils/Parallel.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <system_error>
+#include <vector>
+
+using namespace TerrainTileFormat;
+
+namespace {
+
+    double MsSince(std::chrono::steady_clock::time_point t0)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    }
+
+    FILE* OpenWrite(const std::filesystem::path& path)
+    {
+        FILE* f = nullptr;
+#if defined(_MSC_VER)
+        if (_wfopen_s(&f, path.c_str(), L"w+b") != 0) f = nullptr;
+#else
+        f = fopen(path.c_str(), "w+b");
+#endif
+        return f;
+    }
+
+    bool Seek(FILE* f, uint64_t pos)
+    {
+#if defined(_MSC_VER)
+        return _fseeki64(f, (long long)pos, SEEK_SET) == 0;
+#else
+        return fseeko(f, (off_t)pos, SEEK_SET) == 0;
+#endif
+    }
+
+    bool WriteAt(FILE* f, uint64_t pos, const void* data, size_t bytes)
+    {
+        return Seek(f, pos) && fwrite(data, 1, bytes, f) == bytes;
+    }
+
+    // [-1, 1]  snorm8 (ݿø, lround ȣ )
+    inline int8_t ToSnorm8(float v)
+    {
+        v *= 127.0f;
+        return (int8_t)(v < 0.0f ? (int)(v - 0.5f) : (int)(v + 0.5f));
+    }
+
+    bool ReadAt(FILE* f, uint64_t pos, void* data, size_t bytes)
+    {
+        return Seek(f, pos) && fread(data, 1, bytes, f) == bytes;
+    }
+
+    //    ϳ : Ÿ     
+    struct BuildLevel {
+        int w = 0, h = 0, tilesX = 0, tilesZ = 0;
+        uint32_t firstTile = 0;
+        std::vector<uint8_t> band;          // w * T
+        int rows = 0;                       // band  
+        int done = 0;                       //    ü 
+        int tz = 0;                         //   Ÿ 
+    };
+
+    class Builder {
+    public:
+        Builder(FILE* f, int T, std::vector<BuildLevel>& levels, std::vector<TileEntry>& tiles)
+            : mF(f), mT(T), mLv(levels), mTiles(tiles) {}
+
+        //  l 쿡 rows  ׿  (   )
+        bool Push(int l, const uint8_t* src, int count)
+        {
+            BuildLevel& L = mLv[l];
+            memcpy(L.band.data() + (size_t)L.rows * L.w, src, (size_t)count * L.w);
+            L.rows += count;
+            L.done += count;
+            if (L.rows == mT || L.done == L.h) return Flush(l);
+            return true;
+        }
+
+        //   Ÿ  ,    2x2 
+        bool Flush(int l)
+        {
+            BuildLevel& L = mLv[l];
+            const int T = mT, rows = L.rows;
+            const size_t tb = (size_t)T * T;
+            mStage.resize(std::max(mStage.size(), tb * L.tilesX));
+            Parallel::For(0, (size_t)L.tilesX, 16, [&](size_t b, size_t e) {
+                for (size_t tx = b; tx < e; ++tx) {
+                    uint8_t* dst = mStage.data() + tx * tb;
+                    const int x0 = (int)tx * T, cw = std::min(T, L.w - x0);
+                    if (cw < T || rows < T) memset(dst, 0, tb);
+                    for (int z = 0; z < rows; ++z) memcpy(dst + (size_t)z * T, L.band.data() + (size_t)z * L.w + x0, (size_t)cw);
+                }
+            });
+            for (int tx = 0; tx < L.tilesX; ++tx) {
+                const TileEntry& te = mTiles[L.firstTile + (size_t)L.tz * L.tilesX + tx];
+                if (!WriteAt(mF, te.offset, mStage.data() + (size_t)tx * tb, tb)) return false;
+            }
+            ++L.tz;
+
+            if (l + 1 < (int)mLv.size()) {
+                BuildLevel& N = mLv[l + 1];
+                //    ¦ (T ¦)  ¦  ȿ .  1     
+                const int outRows = L.h == 1 ? 1 : rows / 2;
+                mDown.resize((size_t)N.w * std::max(outRows, 1));
+                Parallel::For(0, (size_t)outRows, 8, [&](size_t b, size_t e) {
+                    for (size_t r = b; r < e; ++r) {
+                        const uint8_t* r0 = L.band.data() + (size_t)std::min<int>((int)r * 2, rows - 1) * L.w;
+                        const uint8_t* r1 = L.band.data() + (size_t)std::min<int>((int)r * 2 + 1, rows - 1) * L.w;
+                        uint8_t* out = mDown.data() + r * N.w;
+                        for (int x = 0; x < N.w; ++x) {
+                            const int a = x * 2, c = std::min(a + 1, L.w - 1);
+                            out[x] = (uint8_t)((r0[a] + r0[c] + r1[a] + r1[c] + 2) >> 2);
+                        }
+                    }
+                });
+                L.rows = 0;
+                if (outRows > 0) return Push(l + 1, mDown.data(), outRows);
+            }
+            L.rows = 0;
+            return true;
+        }
+
+        size_t StageBytes() const { return mStage.capacity() + mDown.capacity(); }
+
+    private:
+        FILE* mF;
+        int mT;
+        std::vector<BuildLevel>& mLv;
+        std::vector<TileEntry>& mTiles;
+        std::vector<uint8_t> mStage;
+        std::vector<uint8_t> mDown;
+    };
+
+    // 2ܰ:  Ÿ   ̸ ٽ о  + min/max (̿ /  ȿ )
+    bool BakeNormals(FILE* f, int T, const BuildLevel& L, int level, const TerrainTileBuildDesc& desc,
+                     std::vector<TileEntry>& tiles, size_t& ramBytes)
+    {
+        const size_t tb = (size_t)T * T;
+        std::vector<uint8_t> tileBuf(tb * L.tilesX);
+        auto readRow = [&](int tz, std::vector<uint8_t>& img) -> bool {    // Ÿ    켱 w * T
+            img.resize((size_t)L.w * T);
+            for (int tx = 0; tx < L.tilesX; ++tx)
+                if (!ReadAt(f, tiles[L.firstTile + (size_t)tz * L.tilesX + tx].offset, tileBuf.data() + (size_t)tx * tb, tb)) return false;
+            for (int z = 0; z < T; ++z)
+                for (int tx = 0; tx < L.tilesX; ++tx) {
+                    const int x0 = tx * T, cw = std::min(T, L.w - x0);
+                    memcpy(img.data() + (size_t)z * L.w + x0, tileBuf.data() + (size_t)tx * tb + (size_t)z * T, (size_t)cw);
+                }
+            return true;
+        };
+
+        //    (ù   ̿) ù  (  Ʒ ̿)
+        std::vector<uint8_t> cur, next, lastRow((size_t)L.w), firstRow((size_t)L.w), above((size_t)L.w);
+        if (!readRow(L.tilesZ - 1, cur)) return false;
+        memcpy(lastRow.data(), cur.data() + (size_t)((L.h - 1) % T) * L.w, (size_t)L.w);
+        if (!readRow(0, cur)) return false;
+        memcpy(firstRow.data(), cur.data(), (size_t)L.w);
+        above = lastRow;
+
+        const float scale = desc.heightScale / 255.0f;
+        const float sx = desc.texelWorldX * (float)(1 << level), sz = desc.texelWorldZ * (float)(1 << level);
+        const float kx = scale / (2.0f * sx), kz = scale / (2.0f * sz);
+        std::vector<int8_t> nrm(tb * 2 * L.tilesX);
+        ramBytes = std::max(ramBytes, tileBuf.size() + nrm.size() + (size_t)L.w * T * 2 + (size_t)L.w * 3);
+
+        for (int tz = 0; tz < L.tilesZ; ++tz) {
+            const int z0 = tz * T, ch = std::min(T, L.h - z0);
+            if (tz + 1 < L.tilesZ && !readRow(tz + 1, next)) return false;
+            const uint8_t* below = tz + 1 < L.tilesZ ? next.data() : firstRow.data();
+            auto row = [&](int z) -> const uint8_t* {  //    (-1 ~ ch)
+                return z < 0 ? above.data() : z >= ch ? below : cur.data() + (size_t)z * L.w;
+            };
+
+            Parallel::For(0, (size_t)L.tilesX, 4, [&](size_t b, size_t e) {
+                for (size_t tx = b; tx < e; ++tx) {
+                    int8_t* out = nrm.data() + tx * tb * 2;
+                    memset(out, 0, tb * 2);
+                    const int x0 = (int)tx * T, cw = std::min(T, L.w - x0);
+                    int mn = 255, mx = 0;
+                    for (int z = 0; z < ch; ++z) {
+                        const uint8_t* ru = row(z - 1);
+                        const uint8_t* rc = row(z);
+                        const uint8_t* rd = row(z + 1);
+                        int8_t* o = out + (size_t)z * T * 2;
+                        // ̴ NormalFromDiff  ߾ 
+                        auto texel = [&](int x, int xl, int xr) {
+                            const float nx = -(float)(rc[xr] - rc[xl]) * kx, nz = -(float)(rd[x0 + x] - ru[x0 + x]) * kz;
+                            const float inv = 1.0f / std::sqrt(nx * nx + 1.0f + nz * nz);
+                            o[x * 2] = ToSnorm8(nx * inv);
+                            o[x * 2 + 1] = ToSnorm8(nz * inv);
+                        };
+                        //     ,  б 
+                        const int xa = x0 == 0 ? 1 : 0, xb = x0 + cw == L.w ? cw - 1 : cw;
+                        if (xa) texel(0, L.w - 1, std::min(1, L.w - 1));
+                        for (int x = xa; x < xb; ++x) texel(x, x0 + x - 1, x0 + x + 1);
+                        if (xb < cw && (xb > 0 || !xa)) texel(xb, x0 + xb - 1, 0);
+                        for (int x = 0; x < cw; ++x) {
+                            mn = std::min<int>(mn, rc[x0 + x]);
+                            mx = std::max<int>(mx, rc[x0 + x]);
+                        }
+                    }
+                    TileEntry& te = tiles[L.firstTile + (size_t)tz * L.tilesX + tx];
+                    te.minH = (uint8_t)mn;
+                    te.maxH = (uint8_t)mx;
+                }
+            });
+            for (int tx = 0; tx < L.tilesX; ++tx) {
+                const TileEntry& te = tiles[L.firstTile + (size_t)tz * L.tilesX + tx];
+                if (!WriteAt(f, te.offset + tb, nrm.data() + (size_t)tx * tb * 2, tb * 2)) return false;
+            }
+
+            memcpy(above.data(), cur.data() + (size_t)(ch - 1) * L.w, (size_t)L.w);
+            cur.swap(next);
+        }
+        return true;
+    }
+
+} // namespace
+
+// ---------------------------------------------------------------- б
+
+bool TerrainTileFile::Open(const std::filesystem::path& path)
+{
+    Close();
+    if (!mFile.Open(path)) return false;
+    const uint8_t* d = mFile.Data();
+    const uint64_t size = mFile.Size();
+
+    // /ǥ  ȿ ְ  ũⰡ Ģ ´ Ȯ (߸ų ٸ  )
+    TerrainTileFormat::Header h;
+    bool ok = size >= sizeof(h);
+    if (ok) {
+        memcpy(&h, d, sizeof(h));
+        ok = h.magic == kMagic && h.version == kVersion && h.width > 0 && h.height > 0 &&
+             h.tileSize >= 16 && h.tileSize <= 256 && h.levels > 0 && h.levels <= 32 && h.fileBytes == size &&
+             h.levelTableOffset % 8 == 0 && h.tileTableOffset % 8 == 0 &&
+             h.levelTableOffset + (uint64_t)h.levels * sizeof(LevelEntry) <= size &&
+             h.tileTableOffset + (uint64_t)h.tileCount * sizeof(TileEntry) <= size;
+    }
+    if (ok) {
+        mHeader = h;
+        mLevels = reinterpret_cast<const LevelEntry*>(d + h.levelTableOffset);
+        mTiles = reinterpret_cast<const TileEntry*>(d + h.tileTableOffset);
+        const uint64_t rec = RecordBytes((int)h.tileSize);
+        uint32_t first = 0;
+        for (int l = 0; ok && l < (int)h.levels; ++l) {
+            const LevelEntry& L = mLevels[l];
+            ok = (int)L.width == LevelWidth(l) && (int)L.height == LevelHeight(l) && (int)L.tilesX == TilesX(l) &&
+                 (int)L.tilesZ == TilesZ(l) && L.firstTile == first;
+            first += L.tilesX * L.tilesZ;
+        }
+        ok = ok && first == h.tileCount && (LevelWidth((int)h.levels - 1) == 1 && LevelHeight((int)h.levels - 1) == 1);
+        for (uint32_t i = 0; ok && i < h.tileCount; ++i)
+            ok = mTiles[i].offset >= h.dataOffset && mTiles[i].offset + rec <= size;
+    }
+    if (!ok) Close();
+    return ok;
+}
+
+void TerrainTileFile::Close()
+{
+    mFile.Close();
+    mHeader = {};
+    mLevels = nullptr;
+    mTiles = nullptr;
+}
+
+const TileEntry* TerrainTileFile::Entry(int level, int tx, int tz) const
+{
+    if (!mTiles || level < 0 || level >= (int)mHeader.levels) return nullptr;
+    const LevelEntry& L = mLevels[level];
+    if (tx < 0 || tz < 0 || tx >= (int)L.tilesX || tz >= (int)L.tilesZ) return nullptr;
+    return &mTiles[L.firstTile + (size_t)tz * L.tilesX + tx];
+}
+
+const uint8_t* TerrainTileFile::TileHeights(int level, int tx, int tz) const
+{
+    const TileEntry* e = Entry(level, tx, tz);
+    return e ? mFile.Data() + e->offset : nullptr;
+}
+
+const int8_t* TerrainTileFile::TileNormals(int level, int tx, int tz) const
+{
+    const TileEntry* e = Entry(level, tx, tz);
+    return e ? reinterpret_cast<const int8_t*>(mFile.Data() + e->offset + TileBytes()) : nullptr;
+}
+
+bool TerrainTileFile::TileMinMax(int level, int tx, int tz, uint8_t& mn, uint8_t& mx) const
+{
+    const TileEntry* e = Entry(level, tx, tz);
+    if (!e) return false;
+    mn = e->minH; mx = e->maxH;
+    return true;
+}
+
+bool TerrainTileFile::ReadTile(int level, int tx, int tz, uint8_t* dst) const
+{
+    const uint8_t* src = TileHeights(level, tx, tz);
+    if (!src) return false;
+    memcpy(dst, src, TileBytes());
+    return true;
+}
+
+TerrainTileReadBench TerrainTileFile::BenchmarkRandomReads(int count, uint32_t seed) const
+{
+    TerrainTileReadBench r;
+    if (!IsOpen() || count <= 0) return r;
+
+    // Ÿ ǥ ü յ ( 0 Ÿ κ   Ʈְ )
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<uint32_t> pick(0, mHeader.tileCount - 1);
+    std::vector<uint8_t> buf(TileBytes());
+    std::vector<double> us((size_t)count);
+    unsigned sink = 0;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) {
+        const uint32_t id = pick(rng);
+        int l = 0;
+        while (l + 1 < (int)mHeader.levels && mLevels[l + 1].firstTile <= id) ++l;
+        const uint32_t local = id - mLevels[l].firstTile;
+
+        const auto s = std::chrono::steady_clock::now();
+        ReadTile(l, (int)(local % mLevels[l].tilesX), (int)(local / mLevels[l].tilesX), buf.data());
+        us[(size_t)i] = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - s).count();
+        sink += buf[(size_t)i % buf.size()];
+    }
+    const double totalMs = MsSince(t0);
+
+    std::sort(us.begin(), us.end());
+    double sum = 0.0;
+    for (double v : us) sum += v;
+    r.reads = count;
+    r.avgUs = sum / count;
+    r.p50Us = us[(size_t)count / 2];
+    r.p99Us = us[std::min((size_t)count - 1, (size_t)count * 99 / 100)];
+    r.maxUs = us.back();
+    r.checksum = sink;
+    r.mbPerSec = totalMs > 0.0 ? (double)count * TileBytes() / (1 << 20) / (totalMs * 0.001) : 0.0;
+    return r;
+}
+
+// ---------------------------------------------------------------- 
+
+bool TerrainTileFile::Build(const std::filesystem::path& outPath, int w, int h, const RowReader& rows,
+                            const TerrainTileBuildDesc& desc, TerrainTileBuildStats* stats)
+{
+    const int T = desc.tileSize;
+    if (w <= 0 || h <= 0 || !rows || T < 16 || T > 256 || (T & (T - 1))) return false;
+    const auto t0 = std::chrono::steady_clock::now();
+
+    // ̾ƿ: ũ ̸    Ÿ ġ ̸ 
+    std::vector<BuildLevel> levels;
+    for (int l = 0;; ++l) {
+        BuildLevel L;
+        L.w = LevelSize(w, l); L.h = LevelSize(h, l);
+        L.tilesX = (L.w + T - 1) / T; L.tilesZ = (L.h + T - 1) / T;
+        L.firstTile = levels.empty() ? 0 : levels.back().firstTile + (uint32_t)(levels.back().tilesX * levels.back().tilesZ);
+        levels.push_back(std::move(L));
+        if (levels.back().w == 1 && levels.back().h == 1) break;
+    }
+    const uint32_t tileCount = levels.back().firstTile + (uint32_t)(levels.back().tilesX * levels.back().tilesZ);
+
+    TerrainTileFormat::Header hd;
+    hd.magic = kMagic; hd.version = kVersion;
+    hd.width = (uint32_t)w; hd.height = (uint32_t)h;
+    hd.tileSize = (uint32_t)T; hd.levels = (uint32_t)levels.size();
+    hd.tileCount = tileCount;
+    hd.heightScale = desc.heightScale;
+    hd.texelWorldX = desc.texelWorldX; hd.texelWorldZ = desc.texelWorldZ;
+    hd.levelTableOffset = sizeof(hd);
+    hd.tileTableOffset = hd.levelTableOffset + levels.size() * sizeof(LevelEntry);
+    hd.dataOffset = (hd.tileTableOffset + (uint64_t)tileCount * sizeof(TileEntry) + kAlign - 1) & ~(kAlign - 1);
+    const uint64_t rec = RecordBytes(T);
+    hd.fileBytes = hd.dataOffset + (uint64_t)tileCount * rec;
+
+    std::vector<TileEntry> tiles(tileCount);
+    for (uint32_t i = 0; i < tileCount; ++i) tiles[i] = TileEntry{ hd.dataOffset + i * rec, 0, 0, {} };
+
+    std::filesystem::path tmp = outPath;
+    tmp += ".tmp";
+    FILE* f = OpenWrite(tmp);
+    if (!f) return false;
+
+    // 1ܰ: Է Ÿ   ̾ Ʈ   0 Ÿ,      
+    for (BuildLevel& L : levels) L.band.resize((size_t)L.w * T);
+    Builder b(f, T, levels, tiles);
+    bool ok = true;
+    std::vector<uint8_t> in((size_t)w * T);
+    for (int z0 = 0; ok && z0 < h; z0 += T) {
+        const int n = std::min(T, h - z0);
+        Parallel::For(0, (size_t)n, 4, [&](size_t rb, size_t re) {
+            rows(z0 + (int)rb, (int)(re - rb), in.data() + rb * (size_t)w);
+        });
+        ok = b.Push(0, in.data(), n);
+    }
+    size_t bandBytes = in.size() + b.StageBytes();
+    for (const BuildLevel& L : levels) bandBytes += L.band.size();
+    const double pyramidMs = MsSince(t0);
+
+    // 2ܰ:  + min/max ( ۴  ʿ )
+    for (BuildLevel& L : levels) { L.band.clear(); L.band.shrink_to_fit(); }
+    size_t normalBytes = 0;
+    for (int l = 0; ok && l < (int)levels.size(); ++l)
+        ok = BakeNormals(f, T, levels[l], l, desc, tiles, normalBytes);
+
+    // ǥ    (  ϼ )
+    std::vector<LevelEntry> lt(levels.size());
+    for (size_t l = 0; l < levels.size(); ++l)
+        lt[l] = LevelEntry{ (uint32_t)levels[l].w, (uint32_t)levels[l].h, (uint32_t)levels[l].tilesX,
+                            (uint32_t)levels[l].tilesZ, levels[l].firstTile, {} };
+    const uint8_t zero = 0;
+    if (ok && rec > (uint64_t)T * T * 3) ok = WriteAt(f, hd.fileBytes - 1, &zero, 1);  //  ڵ е  ũ ä
+    ok = ok && WriteAt(f, hd.levelTableOffset, lt.data(), lt.size() * sizeof(LevelEntry)) &&
+         WriteAt(f, hd.tileTableOffset, tiles.data(), tiles.size() * sizeof(TileEntry)) &&
+         WriteAt(f, 0, &hd, sizeof(hd));
+    if (fclose(f) != 0) ok = false;
+
+    std::error_code ec;
+    if (ok) {
+        std::filesystem::rename(tmp, outPath, ec);
+        ok = !ec;
+    }
+    if (!ok) {
+        std::filesystem::remove(tmp, ec);
+        return false;
+    }
+
+    if (stats) {
+        *stats = {};
+        stats->totalMs = MsSince(t0);
+        stats->pyramidMs = pyramidMs;
+        stats->normalMs = stats->totalMs - pyramidMs;
+        stats->inputMB = (double)w * h / (1 << 20);
+        stats->outputMB = (double)hd.fileBytes / (1 << 20);
+        stats->mbPerSec = stats->totalMs > 0.0 ? stats->inputMB / (stats->totalMs * 0.001) : 0.0;
+        stats->levels = (int)levels.size();
+        stats->tiles = tileCount;
+        stats->peakRamBytes = std::max(bandBytes, normalBytes) + tiles.size() * sizeof(TileEntry);
+    }
+    return true;
+}
+
+bool TerrainTileFile::BuildFromRaw(const std::filesystem::path& outPath, const std::filesystem::path& rawPath, int w, int h,
+                                   const TerrainTileBuildDesc& desc, TerrainTileBuildStats* stats)
+{
+    MappedFile raw;
+    if (w <= 0 || h <= 0 || !raw.Open(rawPath) || raw.Size() < (size_t)w * h) return false;
+    const uint8_t* src = raw.Data();
+    return Build(outPath, w, h, [&](int z, int count, uint8_t* dst) {
+        memcpy(dst, src + (size_t)z * w, (size_t)count * w);
+    }, desc, stats);
+}
+
+bool TerrainTileFile::BuildFromBMP(const std::filesystem::path& outPath, const std::filesystem::path& bmpPath,
+                                   const TerrainTileBuildDesc& desc, TerrainTileBuildStats* stats)
+{
+    BMP::RowReaderR8 bmp;
+    if (!bmp.Open(bmpPath)) return false;
+    const unsigned w = bmp.Width();
+    return Build(outPath, (int)w, (int)bmp.Height(), [&](int z, int count, uint8_t* dst) {
+        for (int i = 0; i < count; ++i) bmp.ReadRow((unsigned)(z + i), dst + (size_t)i * w);
+    }, desc, stats);
+}
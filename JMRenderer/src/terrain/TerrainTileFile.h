@@ -0,0 +1,117 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include "TerrainTileSource.h"
+
+// Ÿ   (.jmt):  0 ~ 1x1 ü  Ƕ̵带  ũ ŸϷ , ޸  д´
+// [][ ǥ][Ÿ ǥ][Ÿ ڵ...] (Ʋ , ڵ 4 KB )
+// Ÿ ڵ =  T*T (R8) +  T*T*2 (X, Z snorm8  Y 籸), Ÿ ǥ = ڵ ġ +  min/max
+//  l+1 =  l 2x2 ڽ  (Ȧ  /   ũ max(1, n >> 1))
+namespace TerrainTileFormat {
+
+    constexpr uint32_t kMagic = 0x46544D4A;    // "JMTF"
+    constexpr uint32_t kVersion = 1;
+    constexpr uint64_t kAlign = 4096;
+
+    struct Header {
+        uint32_t magic = 0, version = 0;
+        uint32_t width = 0, height = 0;         //  0
+        uint32_t tileSize = 0, levels = 0;
+        uint32_t tileCount = 0, _pad0 = 0;
+        float    heightScale = 1.0f;            //    (R8 1.0   )
+        float    texelWorldX = 1.0f;            //  0 ؼ  
+        float    texelWorldZ = 1.0f;
+        float    _pad1 = 0.0f;
+        uint64_t levelTableOffset = 0;
+        uint64_t tileTableOffset = 0;
+        uint64_t dataOffset = 0;
+        uint64_t fileBytes = 0;
+    };
+    static_assert(sizeof(Header) == 80, "TerrainTileFormat::Header layout");
+
+    struct LevelEntry {
+        uint32_t width, height, tilesX, tilesZ;
+        uint32_t firstTile, _pad[3];
+    };
+
+    //   Ÿ : tz  켱
+    struct TileEntry {
+        uint64_t offset;                        // ڵ ġ ( ó)
+        uint8_t  minH, maxH;                    //   ؼ
+        uint8_t  _pad[6];
+    };
+
+} // namespace TerrainTileFormat
+
+struct TerrainTileBuildDesc {
+    int   tileSize = 64;                        // 2 ŵ, 16 ~ 256
+    float heightScale = 1.0f;
+    float texelWorldX = 1.0f, texelWorldZ = 1.0f;
+};
+
+struct TerrainTileBuildStats {
+    double totalMs = 0.0;
+    double pyramidMs = 0.0;                     // 1ܰ: Է Ʈ +  Ÿ + 
+    double normalMs = 0.0;                      // 2ܰ: Ÿ  + min/max
+    double inputMB = 0.0, outputMB = 0.0;
+    double mbPerSec = 0.0;                      // Է 
+    int    levels = 0;
+    size_t tiles = 0;
+    size_t peakRamBytes = 0;                    //  ۾  ִ (Է ũ ,  * Ÿ ũ⿡ )
+};
+
+//  Ÿ б  (ʵ Ͽ ReadTile, OS ĳ  ״)
+struct TerrainTileReadBench {
+    int    reads = 0;
+    double avgUs = 0.0, p50Us = 0.0, p99Us = 0.0, maxUs = 0.0;
+    double mbPerSec = 0.0;
+    unsigned checksum = 0;                      //  Ʈ Ϻ  (簡 ȭ  ʰ)
+};
+
+//   б API: TerrainTileSource ̶ Ŭ/ ״ 
+class TerrainTileFile : public TerrainTileSource {
+public:
+    bool Open(const std::filesystem::path& path);
+    void Close();
+    bool IsOpen() const { return mFile.IsOpen(); }
+
+    int Width() const override { return (int)mHeader.width; }
+    int Height() const override { return (int)mHeader.height; }
+    int TileSize() const override { return (int)mHeader.tileSize; }
+    int LevelCount() const override { return (int)mHeader.levels; }
+    bool ReadTile(int level, int tx, int tz, uint8_t* dst) const override;
+
+    //   ( ̸ nullptr).  ؼ (x, z) snorm8
+    const uint8_t* TileHeights(int level, int tx, int tz) const;
+    const int8_t* TileNormals(int level, int tx, int tz) const;
+    bool TileMinMax(int level, int tx, int tz, uint8_t& mn, uint8_t& mx) const;
+
+    const TerrainTileFormat::Header& Header() const { return mHeader; }
+    size_t FileBytes() const { return mFile.Size(); }
+
+    TerrainTileReadBench BenchmarkRandomReads(int count = 4096, uint32_t seed = 1) const;
+
+    // Է  : rows [z, z + count) dst(ġ = ) .  忡 ÿ Ҹ
+    using RowReader = std::function<void(int z, int count, uint8_t* dst)>;
+
+    // ƿھ : Է Ÿ     θ ޸𸮿 ø
+    // ӽ Ͽ     ̸ ٲٱ (߰ ϸ   )
+    static bool Build(const std::filesystem::path& outPath, int w, int h, const RowReader& rows,
+                      const TerrainTileBuildDesc& desc, TerrainTileBuildStats* stats = nullptr);
+    static bool BuildFromRaw(const std::filesystem::path& outPath, const std::filesystem::path& rawPath, int w, int h,
+                             const TerrainTileBuildDesc& desc, TerrainTileBuildStats* stats = nullptr);
+    static bool BuildFromBMP(const std::filesystem::path& outPath, const std::filesystem::path& bmpPath,
+                             const TerrainTileBuildDesc& desc, TerrainTileBuildStats* stats = nullptr);
+
+    static uint64_t RecordBytes(int tileSize) { return ((uint64_t)tileSize * tileSize * 3 + TerrainTileFormat::kAlign - 1) & ~(TerrainTileFormat::kAlign - 1); }
+
+private:
+    const TerrainTileFormat::TileEntry* Entry(int level, int tx, int tz) const;
+
+    MappedFile mFile;
+    TerrainTileFormat::Header mHeader;
+    const TerrainTileFormat::LevelEntry* mLevels = nullptr;
+    const TerrainTileFormat::TileEntry* mTiles = nullptr;
+};
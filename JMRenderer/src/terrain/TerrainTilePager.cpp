@@ -0,0 +1,191 @@
+#include "TerrainTilePager.h"
+#include "TerrainTileSource.h"
+#include "../utils/Profiler.h"
+#include <algorithm>
+
+bool TerrainTilePager::Start(const TerrainTileSource* src, size_t budgetBytes)
+{
+    Stop();
+    if (!src || src->TileSize() <= 0) return false;
+    mSrc = src;
+    mBudget = budgetBytes;
+    mQuit = false;
+    mRateStart = std::chrono::steady_clock::now();
+    mThread = std::thread([this] { Worker(); });
+    return true;
+}
+
+void TerrainTilePager::Stop()
+{
+    if (mThread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lk(mMutex);
+            mQuit = true;
+            mQueue.clear();
+        }
+        mWake.notify_all();
+        mThread.join();
+    }
+    mSrc = nullptr;
+    mTiles.clear();
+    mLru.clear();
+    mInFlight.clear();
+    mArrived.clear();
+    mDone.clear();
+    mBusy = 0;
+    mReadMs = 0.0;
+    mRateBytes = 0;
+    mUpdates = 0;
+    mStats = {};
+}
+
+void TerrainTilePager::ResetCounters()
+{
+    mStats.requests = mStats.hits = mStats.misses = mStats.waits = mStats.prefetches = 0;
+    mStats.loads = mStats.failed = mStats.evictions = 0;
+    mStats.bytesStreamed = 0;
+    mStats.peakBytes = mStats.residentBytes;
+    mRateBytes = 0;
+    mRateStart = std::chrono::steady_clock::now();
+}
+
+const uint8_t* TerrainTilePager::Acquire(int level, int tx, int tz)
+{
+    if (!mSrc) return nullptr;
+    ++mStats.requests;
+    const uint64_t key = Key(level, tx, tz);
+    auto it = mTiles.find(key);
+    if (it != mTiles.end()) {
+        ++mStats.hits;
+        mLru.splice(mLru.begin(), mLru, it->second.lru);
+        return it->second.data.data();
+    }
+
+    if (!mInFlight.insert(key).second) {
+        ++mStats.waits;
+        return nullptr;
+    }
+    ++mStats.misses;
+    Request(key);
+    return nullptr;
+}
+
+void TerrainTilePager::Prefetch(int level, int tx, int tz)
+{
+    if (!mSrc) return;
+    const uint64_t key = Key(level, tx, tz);
+    auto it = mTiles.find(key);
+    if (it != mTiles.end()) {
+        mLru.splice(mLru.begin(), mLru, it->second.lru);
+        return;
+    }
+    if (!mInFlight.insert(key).second) return;
+    ++mStats.prefetches;
+    Request(key);
+}
+
+void TerrainTilePager::Request(uint64_t key)
+{
+    {
+        std::lock_guard<std::mutex> lk(mMutex);
+        mQueue.push_back(key);
+    }
+    mWake.notify_one();
+    mStats.queued = mInFlight.size();
+}
+
+size_t TerrainTilePager::Update()
+{
+    if (!mSrc) return 0;
+    {
+        std::lock_guard<std::mutex> lk(mMutex);
+        mArrived.swap(mDone);
+        mStats.readMs = mReadMs;
+    }
+
+    ++mUpdates;
+    size_t added = 0;
+    for (Loaded& l : mArrived) {
+        mInFlight.erase(l.key);
+        if (!l.ok) { ++mStats.failed; continue; }
+        const size_t bytes = l.data.size();
+        mLru.push_front(l.key);
+        Tile& t = mTiles[l.key];
+        t.data = std::move(l.data);
+        t.lru = mLru.begin();
+        t.arrived = mUpdates;
+        mStats.residentBytes += bytes;
+        mStats.bytesStreamed += bytes;
+        mRateBytes += bytes;
+        ++mStats.loads;
+        ++added;
+    }
+    mArrived.clear();
+    mStats.peakBytes = std::max(mStats.peakBytes, mStats.residentBytes);
+    Evict();
+
+    // 0.5  
+    const auto now = std::chrono::steady_clock::now();
+    const double sec = std::chrono::duration<double>(now - mRateStart).count();
+    if (sec >= 0.5) {
+        mStats.mbPerSec = mRateBytes / (1024.0 * 1024.0) / sec;
+        mRateBytes = 0;
+        mRateStart = now;
+    }
+    mStats.queued = mInFlight.size();
+    mStats.residentTiles = mTiles.size();
+    return added;
+}
+
+size_t TerrainTilePager::WaitIdle()
+{
+    if (!mSrc) return 0;
+    {
+        std::unique_lock<std::mutex> lk(mMutex);
+        mIdle.wait(lk, [&] { return mQueue.empty() && mBusy == 0; });
+    }
+    return Update();
+}
+
+void TerrainTilePager::Evict()
+{
+    while (mStats.residentBytes > mBudget && !mLru.empty()) {
+        auto it = mTiles.find(mLru.back());
+        if (it->second.arrived == mUpdates) break;
+        mStats.residentBytes -= it->second.data.size();
+        mTiles.erase(it);
+        mLru.pop_back();
+        ++mStats.evictions;
+    }
+}
+
+void TerrainTilePager::Worker()
+{
+    Prof::SetThreadName("tile pager");
+    const size_t tileBytes = mSrc->TileBytes();
+    std::unique_lock<std::mutex> lk(mMutex);
+    for (;;) {
+        mWake.wait(lk, [&] { return mQuit || !mQueue.empty(); });
+        if (mQuit) break;
+        const uint64_t key = mQueue.front();
+        mQueue.pop_front();
+        ++mBusy;
+        lk.unlock();
+
+        Loaded l{ key, false, std::vector<uint8_t>(tileBytes) };
+        const auto t0 = std::chrono::steady_clock::now();
+        {
+            JM_PROFILE_ZONE("Tile Read");
+            const int level = (int)(key >> 56);
+            const int tz = (int)((key >> 28) & 0xFFFFFFF), tx = (int)(key & 0xFFFFFFF);
+            l.ok = mSrc->ReadTile(level, tx, tz, l.data.data());
+        }
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+        lk.lock();
+        mReadMs += ms;
+        mDone.push_back(std::move(l));
+        --mBusy;
+        if (mQueue.empty() && mBusy == 0) mIdle.notify_all();
+    }
+}
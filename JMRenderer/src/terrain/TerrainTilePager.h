@@ -0,0 +1,111 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class TerrainTileSource;
+
+//  Ÿ LRU ĳ + ׶  (D3D  )
+//  : Acquire Ÿ ã,  û ְ nullptr (   ٽ õ)
+// Ŀ  ϳ û   а, Update()  忡 ĳÿ ִ´
+//  ĳ ü   . ޸       ŸϺ 
+// (  Ÿ     д   ۾Ƶ û    д´)
+struct TilePagerStats {
+    size_t requests = 0;        // Acquire ȣ = hits + misses + waits
+    size_t hits = 0;
+    size_t misses = 0;          //  б û
+    size_t waits = 0;           // ̹ û Ÿ ٽ ã (߷ )
+    size_t prefetches = 0;      // Prefetch  б û
+    size_t loads = 0;           // Ŀ о ĳÿ  Ÿ
+    size_t failed = 0;          //  б 
+    size_t evictions = 0;
+    size_t queued = 0;          // û   ĳÿ  Ÿ ( + д )
+    size_t residentTiles = 0;
+    size_t residentBytes = 0;
+    size_t peakBytes = 0;
+    uint64_t bytesStreamed = 0; // 
+    double mbPerSec = 0.0;      // ֱ  Ʈ ӵ
+    double readMs = 0.0;        // Ŀ  б ð
+
+    double HitRate() const { return hits + misses ? (double)hits / (hits + misses) : 0.0; }
+};
+
+class TerrainTilePager {
+public:
+    TerrainTilePager() = default;
+    ~TerrainTilePager() { Stop(); }
+    TerrainTilePager(const TerrainTilePager&) = delete;
+    TerrainTilePager& operator=(const TerrainTilePager&) = delete;
+
+    // src Stop   ־ Ѵ
+    bool Start(const TerrainTileSource* src, size_t budgetBytes);
+    void Stop();    // Ŀ  + ĳ 
+    bool Running() const { return mSrc != nullptr; }
+
+    void SetBudget(size_t budgetBytes) { mBudget = budgetBytes; }
+    size_t Budget() const { return mBudget; }
+
+    //  Ÿ̸  ( Update ȿ), ƴϸ û  nullptr
+    const uint8_t* Acquire(int level, int tx, int tz);
+    //  ʿ Ÿ: ϸ LRU ,  û (߷ 迡  )
+    void Prefetch(int level, int tx, int tz);
+
+    //  б⸦ ĳÿ ְ  .   Acquire . ȯ   Ÿ 
+    size_t Update();
+    //   û    ٸ  Update (帮 )
+    size_t WaitIdle();
+
+    const TilePagerStats& Stats() const { return mStats; }
+    void ResetCounters();   // û//Ʈ  0
+
+private:
+    struct Tile {
+        std::vector<uint8_t> data;
+        std::list<uint64_t>::iterator lru;
+        uint64_t arrived = 0;       //  Update ȣ ( Update  )
+    };
+    struct Loaded {
+        uint64_t key;
+        bool ok;
+        std::vector<uint8_t> data;
+    };
+
+    static uint64_t Key(int level, int tx, int tz)
+    {
+        return ((uint64_t)(uint8_t)level << 56) | ((uint64_t)(uint32_t)tz & 0xFFFFFFF) << 28 | ((uint32_t)tx & 0xFFFFFFF);
+    }
+    void Request(uint64_t key);
+    void Worker();
+    void Evict();
+
+    const TerrainTileSource* mSrc = nullptr;
+    size_t mBudget = 0;
+
+    //   
+    std::unordered_map<uint64_t, Tile> mTiles;
+    std::list<uint64_t> mLru;               //  = ֱ
+    std::unordered_set<uint64_t> mInFlight;
+    std::vector<Loaded> mArrived;
+    uint64_t mUpdates = 0;
+    std::chrono::steady_clock::time_point mRateStart;
+    uint64_t mRateBytes = 0;
+    TilePagerStats mStats;
+
+    // Ŀ 
+    std::mutex mMutex;
+    std::condition_variable mWake, mIdle;
+    std::deque<uint64_t> mQueue;
+    std::vector<Loaded> mDone;
+    size_t mBusy = 0;                       // Ŀ д  Ÿ 
+    double mReadMs = 0.0;
+    bool mQuit = false;
+    std::thread mThread;
+};
@@ -0,0 +1,75 @@
+#include "TerrainTileSource.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <system_error>
+
+bool TerrainRawTileSource::Open(const std::filesystem::path& path, int w, int h, int tileSize)
+{
+    Close();
+    if (w <= 0 || h <= 0 || tileSize <= 0) return false;
+    if (!mFile.Open(path)) return false;
+    if (mFile.Size() < (size_t)w * h) { mFile.Close(); return false; }
+
+    mW = w; mH = h; mTile = tileSize;
+    mLevels = 1;
+    while ((w >> mLevels) > 0 || (h >> mLevels) > 0) ++mLevels;  // 1x1 (D3D   )
+    return true;
+}
+
+void TerrainRawTileSource::Close()
+{
+    mFile.Close();
+    mW = mH = mLevels = 0;
+}
+
+bool TerrainRawTileSource::ReadTile(int level, int tx, int tz, uint8_t* dst) const
+{
+    if (!mFile.IsOpen() || level < 0 || level >= mLevels) return false;
+    if (tx < 0 || tz < 0 || tx >= TilesX(level) || tz >= TilesZ(level)) return false;
+
+    const int lw = LevelWidth(level), lh = LevelHeight(level);
+    const int x0 = tx * mTile, z0 = tz * mTile;
+    const int cw = std::min(mTile, lw - x0), ch = std::min(mTile, lh - z0);
+    const uint8_t* src = mFile.Data();
+
+    if (cw < mTile || ch < mTile) memset(dst, 0, (size_t)mTile * mTile);
+    for (int z = 0; z < ch; ++z) {
+        const uint8_t* row = src + (size_t)((z0 + z) << level) * mW;
+        uint8_t* out = dst + (size_t)z * mTile;
+        if (level == 0) {
+            memcpy(out, row + x0, (size_t)cw);
+            continue;
+        }
+        for (int x = 0; x < cw; ++x) out[x] = row[(size_t)(x0 + x) << level];
+    }
+    return true;
+}
+
+bool TerrainRawTileSource::Write(const std::filesystem::path& path, const uint8_t* pixels, int w, int h)
+{
+    if (!pixels || w <= 0 || h <= 0) return false;
+    std::filesystem::path tmp = path;
+    tmp += ".tmp";
+
+    FILE* f = nullptr;
+#if defined(_MSC_VER)
+    if (_wfopen_s(&f, tmp.c_str(), L"wb") != 0) f = nullptr;
+#else
+    f = fopen(tmp.c_str(), "wb");
+#endif
+    if (!f) return false;
+    const size_t bytes = (size_t)w * h;
+    const bool ok = fwrite(pixels, 1, bytes, f) == bytes;
+    if (fclose(f) != 0 || !ok) {
+        std::error_code ec;
+        std::filesystem::remove(tmp, ec);
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    if (!ec) return true;
+    std::filesystem::remove(tmp, ec);
+    return false;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include "../utils/MappedFile.h"
+
+//   Ÿ  (Ŭ  Ŀ 忡 д´  ReadTile  ؾ )
+//  l ũ = max(1, W >> l),  l  i  0 ؼ i << l ġ ( ҽ  , Ÿ  2x2 ڽ )
+// Ÿ =  TileSize x TileSize 簢 (/Ʒ ڸ Ÿ   0 ä)
+class TerrainTileSource {
+public:
+    virtual ~TerrainTileSource() = default;
+
+    virtual int Width() const = 0;          //  0
+    virtual int Height() const = 0;
+    virtual int TileSize() const = 0;
+    virtual int LevelCount() const = 0;
+
+    // dst: TileSize * TileSize Ʈ ( 켱).   Ÿ̸ false
+    virtual bool ReadTile(int level, int tx, int tz, uint8_t* dst) const = 0;
+
+    int LevelWidth(int level) const { return LevelSize(Width(), level); }
+    int LevelHeight(int level) const { return LevelSize(Height(), level); }
+    int TilesX(int level) const { return (LevelWidth(level) + TileSize() - 1) / TileSize(); }
+    int TilesZ(int level) const { return (LevelHeight(level) + TileSize() - 1) / TileSize(); }
+    size_t TileBytes() const { return (size_t)TileSize() * TileSize(); }
+
+    static int LevelSize(int size, int level) { return size >> level > 0 ? size >> level : 1; }
+};
+
+//   R8   (w*h Ʈ,  켱) ޸  д´
+// ģ  2^l    (ʿ  ũ ö´)
+class TerrainRawTileSource : public TerrainTileSource {
+public:
+    bool Open(const std::filesystem::path& path, int w, int h, int tileSize = 64);
+    void Close();
+    bool IsOpen() const { return mFile.IsOpen(); }
+
+    int Width() const override { return mW; }
+    int Height() const override { return mH; }
+    int TileSize() const override { return mTile; }
+    int LevelCount() const override { return mLevels; }
+    bool ReadTile(int level, int tx, int tz, uint8_t* dst) const override;
+
+    // pixels path  Ϸ  (ӽ Ͽ  ̸ ٲٱ)
+    static bool Write(const std::filesystem::path& path, const uint8_t* pixels, int w, int h);
+
+private:
+    MappedFile mFile;
+    int mW = 0, mH = 0, mTile = 64, mLevels = 0;
+};
@@ -0,0 +1,162 @@
+#include "BMPDecode.h"
+#include "JobSystem.h"
+#include "MappedFile.h"
+#include "PixelKernels.h"
+#include <cstring>
+
+#pragma pack(push,1)
+struct BmpFileHeader {
+    unsigned short bfType;      // 'BM' = 0x4D42
+    unsigned int   bfSize;
+    unsigned short bfReserved1;
+    unsigned short bfReserved2;
+    unsigned int   bfOffBits;
+};
+struct BmpInfoHeader {
+    unsigned int   biSize;      // 40 (BITMAPINFOHEADER)
+    int            biWidth;
+    int            biHeight;    // >0: bottom-up, <0: top-down
+    unsigned short biPlanes;    // 1
+    unsigned short biBitCount;  // 24 Ǵ 32 
+    unsigned int   biCompression; // 0(BI_RGB) 
+    unsigned int   biSizeImage;
+    int            biXPelsPerMeter;
+    int            biYPelsPerMeter;
+    unsigned int   biClrUsed;
+    unsigned int   biClrImportant;
+};
+#pragma pack(pop)
+
+// ε Ͽ о ȼ 迭 ġ
+struct BmpLayout {
+    unsigned W = 0, H = 0, bitCount = 0;
+    bool bottomUp = true;
+    size_t srcStride = 0;
+    const uint8_t* pixels = nullptr;    //   ù 
+};
+
+static bool ParseHeaders(const uint8_t* data, size_t size, BmpLayout& out) {
+    BmpFileHeader fh{};
+    BmpInfoHeader ih{};
+    if (size < sizeof(fh) + sizeof(ih)) return false;
+    std::memcpy(&fh, data, sizeof(fh));
+    std::memcpy(&ih, data + sizeof(fh), sizeof(ih));
+    if (fh.bfType != 0x4D42) return false;
+    if (ih.biSize < 40 || ih.biPlanes != 1) return false;
+    if (ih.biCompression != 0) return false; // BI_RGB
+    if (ih.biWidth <= 0 || ih.biHeight == 0) return false;
+    if (!(ih.biBitCount == 24 || ih.biBitCount == 32)) return false;
+
+    out.W = (unsigned)ih.biWidth;
+    out.H = (unsigned)(ih.biHeight > 0 ? ih.biHeight : -(long long)ih.biHeight);
+    out.bottomUp = (ih.biHeight > 0);
+    out.bitCount = ih.biBitCount;
+    out.srcStride = ((size_t)out.W * (out.bitCount / 8) + 3u) & ~(size_t)3u; // 4Ʈ е
+
+    // ȼ 迭  ȿ   ִ Ȯ (߸  )
+    unsigned long long need = (unsigned long long)fh.bfOffBits + (unsigned long long)out.srcStride * out.H;
+    if (need > size) return false;
+    out.pixels = data + fh.bfOffBits;
+    return true;
+}
+
+namespace BMP {
+
+    constexpr size_t kRowGrain = 64;
+
+    bool DecodeRGBA8(const std::filesystem::path& path, Image& out, bool allowBGRA)
+    {
+        out = Image{};
+        auto mf = std::make_shared<MappedFile>();
+        if (!mf->Open(path)) return false;
+
+        BmpLayout L;
+        if (!ParseHeaders(mf->Data(), mf->Size(), L)) return false;
+
+        out.width = L.W;
+        out.height = L.H;
+
+        // top-down 32-bit: BGRA8 ؽó  ״ ѱ
+        if (L.bitCount == 32 && !L.bottomUp && allowBGRA) {
+            out.format = PixelFormat::BGRA8;
+            out.rowPitch = L.srcStride;
+            out.data = L.pixels;
+            out.mapping = std::move(mf);
+            return true;
+        }
+
+        out.format = PixelFormat::RGBA8;
+        out.rowPitch = (size_t)L.W * 4;
+        out.pixels.resize(out.rowPitch * L.H);
+        // ೢ   64  Ŀ (δ  ٸ Բ ó)
+        Jobs::For(0, L.H, kRowGrain, [&](size_t y0, size_t y1) {
+            for (size_t y = y0; y < y1; ++y) {
+                const uint8_t* src = L.pixels + y * L.srcStride;
+                size_t dy = L.bottomUp ? (L.H - 1 - y) : y;
+                uint8_t* dst = &out.pixels[dy * out.rowPitch];
+                if (L.bitCount == 24) PixelKernels::BGRtoRGBA(src, dst, L.W);
+                else                  PixelKernels::BGRAtoRGBA(src, dst, L.W); // A ״(κ 0x00 Ǵ 0xFF)
+            }
+        });
+        out.data = out.pixels.data();
+        return true;
+    }
+
+    bool DecodeR8(const std::filesystem::path& path, Image& out)
+    {
+        out = Image{};
+        MappedFile mf;
+        if (!mf.Open(path)) return false;
+
+        BmpLayout L;
+        if (!ParseHeaders(mf.Data(), mf.Size(), L)) return false;
+        if (L.bitCount != 24) return false; // R8 δ 24-bit
+
+        out.width = L.W;
+        out.height = L.H;
+        out.format = PixelFormat::R8;
+        out.rowPitch = L.W;
+        out.pixels.resize(out.rowPitch * L.H);
+        Jobs::For(0, L.H, kRowGrain, [&](size_t y0, size_t y1) {
+            for (size_t y = y0; y < y1; ++y) {
+                const uint8_t* src = L.pixels + y * L.srcStride;
+                size_t dy = L.bottomUp ? (L.H - 1 - y) : y;
+                PixelKernels::BGRtoGray(src, &out.pixels[dy * out.rowPitch], L.W);
+            }
+        });
+        out.data = out.pixels.data();
+        return true;
+    }
+
+    bool RowReaderR8::Open(const std::filesystem::path& path)
+    {
+        Close();
+        auto mf = std::make_shared<MappedFile>();
+        if (!mf->Open(path)) return false;
+
+        BmpLayout L;
+        if (!ParseHeaders(mf->Data(), mf->Size(), L)) return false;
+        mW = L.W; mH = L.H; mBits = L.bitCount;
+        mBottomUp = L.bottomUp;
+        mStride = L.srcStride;
+        mPixels = L.pixels;
+        mFile = std::move(mf);
+        return true;
+    }
+
+    void RowReaderR8::Close()
+    {
+        mFile.reset();
+        mPixels = nullptr;
+        mStride = 0;
+        mW = mH = mBits = 0;
+    }
+
+    void RowReaderR8::ReadRow(unsigned y, uint8_t* dst) const
+    {
+        const uint8_t* src = mPixels + (size_t)(mBottomUp ? (mH - 1 - y) : y) * mStride;
+        if (mBits == 24) { PixelKernels::BGRtoGray(src, dst, mW); return; }
+        for (unsigned x = 0; x < mW; ++x, src += 4) dst[x] = PixelKernels::ToGray(src[2], src[1], src[0]);
+    }
+
+} // namespace BMP
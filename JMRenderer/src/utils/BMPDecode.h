@@ -0,0 +1,55 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+class MappedFile;
+
+// BMP ڴ (D3D  )
+//  ޸  , ε ࿡  ε ۷ ٷ ȯѴ
+namespace BMP {
+
+    enum class PixelFormat { RGBA8, BGRA8, R8 };
+
+    struct Image {
+        unsigned width = 0, height = 0;
+        PixelFormat format = PixelFormat::RGBA8;
+        size_t rowPitch = 0;                    // Ʈ
+        const uint8_t* data = nullptr;          // ù (top-down)
+
+        std::vector<uint8_t> pixels;            // ȯ   
+        std::shared_ptr<MappedFile> mapping;    //    
+
+        bool IsZeroCopy() const { return mapping != nullptr; }
+        size_t SizeBytes() const { return rowPitch * height; }
+    };
+
+    // 24/32-bit BMP  RGBA8
+    // allowBGRA: top-down 32-bit BGRA8 ״  Ų( )
+    bool DecodeRGBA8(const std::filesystem::path& path, Image& out, bool allowBGRA = true);
+
+    // 24-bit BMP  R8 (ġ ׷ 0.299, 0.587, 0.114)
+    bool DecodeR8(const std::filesystem::path& path, Image& out);
+
+    // ū BMP  Ʈ (° ڵ ):  ϰ û ุ R8 ȯ
+    // 24/32-bit  ġ ׷. ReadRow б⸸ ϹǷ  忡 ȣ 
+    class RowReaderR8 {
+    public:
+        bool Open(const std::filesystem::path& path);
+        void Close();
+        bool IsOpen() const { return mPixels != nullptr; }
+
+        unsigned Width() const { return mW; }
+        unsigned Height() const { return mH; }
+        void ReadRow(unsigned y, uint8_t* dst) const;   // y: top-down, dst: Width() Ʈ
+
+    private:
+        std::shared_ptr<MappedFile> mFile;
+        const uint8_t* mPixels = nullptr;               //   ù 
+        size_t mStride = 0;
+        unsigned mW = 0, mH = 0, mBits = 0;
+        bool mBottomUp = true;
+    };
+
+} // namespace BMP
@@ -1,223 +1,184 @@
 #include "BMTexture.h"
+#include "BMPDecode.h"
 #include <vector>
-#include <cstdio>
 #include <cassert>
 
 using Microsoft::WRL::ComPtr;
 
-#pragma pack(push,1)
-struct BmpFileHeader {
-    unsigned short bfType;      // 'BM' = 0x4D42
-    unsigned int   bfSize;
-    unsigned short bfReserved1;
-    unsigned short bfReserved2;
-    unsigned int   bfOffBits;
-};
-struct BmpInfoHeader {
-    unsigned int   biSize;      // 40 (BITMAPINFOHEADER)
-    int            biWidth;
-    int            biHeight;    // >0: bottom-up, <0: top-down
-    unsigned short biPlanes;    // 1
-    unsigned short biBitCount;  // 24 Ǵ 32 
-    unsigned int   biCompression; // 0(BI_RGB) 
-    unsigned int   biSizeImage;
-    int            biXPelsPerMeter;
-    int            biYPelsPerMeter;
-    unsigned int   biClrUsed;
-    unsigned int   biClrImportant;
-};
-#pragma pack(pop)
-
-static inline unsigned char toGray(unsigned char r, unsigned char g, unsigned char b) {
-    float y = 0.299f * r + 0.587f * g + 0.114f * b;
-    int v = (int)(y + 0.5f);
-    if (v < 0) v = 0; if (v > 255) v = 255;
-    return (unsigned char)v;
+static DXGI_FORMAT ToDXGI(BMP::PixelFormat f) {
+    switch (f) {
+    case BMP::PixelFormat::BGRA8: return DXGI_FORMAT_B8G8R8A8_UNORM;
+    case BMP::PixelFormat::R8:    return DXGI_FORMAT_R8_UNORM;
+    default:                      return DXGI_FORMAT_R8G8B8A8_UNORM;
+    }
+}
+
+static DXGI_FORMAT ToDXGI(BC::Format f) {
+    switch (f) {
+    case BC::Format::BC4: return DXGI_FORMAT_BC4_UNORM;
+    case BC::Format::BC5: return DXGI_FORMAT_BC5_UNORM;
+    default:              return DXGI_FORMAT_BC1_UNORM;
+    }
 }
 
-static bool ReadHeaders(FILE* fp, BmpFileHeader& fh, BmpInfoHeader& ih) {
-    if (std::fread(&fh, sizeof(fh), 1, fp) != 1) return false;
-    if (std::fread(&ih, sizeof(ih), 1, fp) != 1) return false;
-    if (fh.bfType != 0x4D42) return false;
-    if (ih.biSize < 40 || ih.biPlanes != 1) return false;
-    if (ih.biCompression != 0) return false; // BI_RGB
-    if (ih.biWidth <= 0 || ih.biHeight == 0) return false;
-    return true;
+//   迭  Texture2D + SRV
+static bool CreateTextureSRV(ID3D11Device* dev, DXGI_FORMAT fmt, unsigned w, unsigned h,
+    const std::vector<D3D11_SUBRESOURCE_DATA>& srd, ComPtr<ID3D11ShaderResourceView>& outSRV)
+{
+    D3D11_TEXTURE2D_DESC td{};
+    td.Width = w; td.Height = h; td.MipLevels = (UINT)srd.size(); td.ArraySize = 1;
+    td.Format = fmt;
+    td.SampleDesc.Count = 1;
+    td.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+    ComPtr<ID3D11Texture2D> tex;
+    HRESULT hr = dev->CreateTexture2D(&td, srd.data(), tex.GetAddressOf());
+    if (FAILED(hr)) return false;
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC sd{};
+    sd.Format = td.Format;
+    sd.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+    sd.Texture2D.MostDetailedMip = 0;
+    sd.Texture2D.MipLevels = td.MipLevels;
+
+    hr = dev->CreateShaderResourceView(tex.Get(), &sd, outSRV.GetAddressOf());
+    return SUCCEEDED(hr);
 }
 
 namespace BMP {
 
-    bool LoadRGBA8(ID3D11Device* dev, const wchar_t* path,
-        ComPtr<ID3D11ShaderResourceView>& outSRV,
-        unsigned* outW, unsigned* outH)
+    bool Prepare(const Image& img, MipFilter mips, TextureData& out)
     {
-        outSRV.Reset();
-        if (outW) *outW = 0; if (outH) *outH = 0;
-
-        FILE* fp = nullptr;
-#ifdef _WIN32
-        _wfopen_s(&fp, path, L"rb");
-#else
-        fp = std::fopen(/*convert path*/, "rb");
-#endif
-        if (!fp) return false;
-
-        BmpFileHeader fh{};
-        BmpInfoHeader ih{};
-        bool ok = ReadHeaders(fp, fh, ih);
-        if (!ok) { std::fclose(fp); return false; }
-
-        const unsigned W = (unsigned)ih.biWidth;
-        const unsigned H = (unsigned)(ih.biHeight > 0 ? ih.biHeight : -ih.biHeight);
-        const bool bottomUp = (ih.biHeight > 0);
-        const unsigned bc = ih.biBitCount;
-
-        if (!(bc == 24 || bc == 32)) { std::fclose(fp); return false; }
-
-        std::fseek(fp, (long)fh.bfOffBits, SEEK_SET);
-
-        std::vector<unsigned char> dataRGBA(W * H * 4);
-
-        if (bc == 24) {
-            const unsigned srcStride = ((W * 3u) + 3u) & ~3u; // 4Ʈ е
-            std::vector<unsigned char> row(srcStride);
-            for (unsigned y = 0; y < H; ++y) {
-                if (std::fread(row.data(), 1, srcStride, fp) != srcStride) { std::fclose(fp); return false; }
-                unsigned dy = bottomUp ? (H - 1 - y) : y;
-                unsigned char* dst = &dataRGBA[dy * W * 4];
-                for (unsigned x = 0; x < W; ++x) {
-                    unsigned char B = row[x * 3 + 0];
-                    unsigned char G = row[x * 3 + 1];
-                    unsigned char R = row[x * 3 + 2];
-                    dst[x * 4 + 0] = R;
-                    dst[x * 4 + 1] = G;
-                    dst[x * 4 + 2] = B;
-                    dst[x * 4 + 3] = 255; // 
-                }
-            }
+        // out.source ǵ帮 ʴ´ (img out.source  )
+        out.levels.clear(); out.resized.clear(); out.surfaces.clear(); out.psnr = 0.0;
+        if (!img.data) return false;
+
+        // CPU ü ( 0 img ״ Ŵ)
+        const unsigned ch = (img.format == PixelFormat::R8) ? 1u : 4u;
+        Mip::Build(img.data, img.width, img.height, img.rowPitch, ch, mips, out.chain);
+
+        out.format = ToDXGI(img.format);
+        out.width = img.width; out.height = img.height;
+        out.levels.resize(out.chain.levels.size());
+        for (size_t i = 0; i < out.chain.levels.size(); ++i) {
+            out.levels[i].pSysMem = out.chain.levels[i].data;
+            out.levels[i].SysMemPitch = (UINT)out.chain.levels[i].rowPitch;
         }
-        else { // 32-bit BGRA
-            const unsigned srcStride = W * 4u;
-            std::vector<unsigned char> row(srcStride);
-            for (unsigned y = 0; y < H; ++y) {
-                if (std::fread(row.data(), 1, srcStride, fp) != srcStride) { std::fclose(fp); return false; }
-                unsigned dy = bottomUp ? (H - 1 - y) : y;
-                unsigned char* dst = &dataRGBA[dy * W * 4];
-                for (unsigned x = 0; x < W; ++x) {
-                    unsigned char B = row[x * 4 + 0];
-                    unsigned char G = row[x * 4 + 1];
-                    unsigned char R = row[x * 4 + 2];
-                    unsigned char A = row[x * 4 + 3];
-                    dst[x * 4 + 0] = R;
-                    dst[x * 4 + 1] = G;
-                    dst[x * 4 + 2] = B;
-                    dst[x * 4 + 3] = A; // ״ (κ 0x00 Ǵ 0xFF)
-                }
-            }
-        }
-
-        std::fclose(fp);
-
-        // D3D ؽó/ SRV 
-        D3D11_TEXTURE2D_DESC td{};
-        td.Width = W; td.Height = H; td.MipLevels = 1; td.ArraySize = 1;
-        td.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-        td.SampleDesc.Count = 1;
-        td.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+        return true;
+    }
 
-        D3D11_SUBRESOURCE_DATA srd{};
-        srd.pSysMem = dataRGBA.data();
-        srd.SysMemPitch = W * 4;
+    bool PrepareCompressed(const Image& img, BC::Format fmt, BC::Quality quality, MipFilter mips,
+        TextureData& out, bool computePSNR)
+    {
+        // out.source ǵ帮 ʴ´ (img out.source  )
+        out.levels.clear(); out.resized.clear(); out.surfaces.clear(); out.psnr = 0.0;
+        if (!img.data) return false;
+
+        const unsigned ch = (img.format == PixelFormat::R8) ? 1u : 4u;
+        const uint8_t* base = img.data;
+        unsigned w = img.width, h = img.height;
+        size_t pitch = img.rowPitch;
+
+        // BC ֻ  4  Ѵ   ÷ Ű (Ÿϸ UV )
+        if ((w | h) & 3u) {
+            const unsigned dw = (w + 3) & ~3u, dh = (h + 3) & ~3u;
+            Mip::ResizeWrap(base, w, h, pitch, ch, dw, dh, out.resized);
+            base = out.resized.data(); w = dw; h = dh; pitch = (size_t)dw * ch;
+        }
 
-        ComPtr<ID3D11Texture2D> tex;
-        HRESULT hr = dev->CreateTexture2D(&td, &srd, tex.GetAddressOf());
-        if (FAILED(hr)) return false;
+        Mip::Build(base, w, h, pitch, ch, mips, out.chain);
+
+        out.format = ToDXGI(fmt);
+        out.width = w; out.height = h;
+        out.surfaces.resize(out.chain.levels.size());
+        out.levels.resize(out.chain.levels.size());
+        for (size_t i = 0; i < out.chain.levels.size(); ++i) {
+            BC::Source s;
+            s.data = out.chain.levels[i].data;
+            s.width = out.chain.levels[i].width; s.height = out.chain.levels[i].height;
+            s.rowPitch = out.chain.levels[i].rowPitch;
+            s.channels = ch;
+            s.swapRB = (img.format == PixelFormat::BGRA8);
+            BC::Encode(s, fmt, quality, out.surfaces[i]);
+            if (i == 0 && computePSNR) out.psnr = BC::PSNR(s, out.surfaces[0]);
+
+            out.levels[i].pSysMem = out.surfaces[i].blocks.data();
+            out.levels[i].SysMemPitch = (UINT)out.surfaces[i].RowPitch();
+        }
+        return true;
+    }
 
-        D3D11_SHADER_RESOURCE_VIEW_DESC sd{};
-        sd.Format = td.Format;
-        sd.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-        sd.Texture2D.MostDetailedMip = 0;
-        sd.Texture2D.MipLevels = 1;
+    bool CreateSRV(ID3D11Device* dev, const TextureData& data,
+        ComPtr<ID3D11ShaderResourceView>& outSRV)
+    {
+        outSRV.Reset();
+        if (data.levels.empty()) return false;
+        return CreateTextureSRV(dev, data.format, data.width, data.height, data.levels, outSRV);
+    }
 
-        hr = dev->CreateShaderResourceView(tex.Get(), &sd, outSRV.GetAddressOf());
-        if (FAILED(hr)) return false;
+    bool CreateSRV(ID3D11Device* dev, const Image& img,
+        ComPtr<ID3D11ShaderResourceView>& outSRV, MipFilter mips)
+    {
+        outSRV.Reset();
+        TextureData data;
+        if (!Prepare(img, mips, data)) return false;
+        return CreateSRV(dev, data, outSRV);
+    }
 
-        if (outW) *outW = W;
-        if (outH) *outH = H;
-        return true;
+    bool CreateSRVCompressed(ID3D11Device* dev, const Image& img, BC::Format fmt,
+        ComPtr<ID3D11ShaderResourceView>& outSRV, BC::Quality quality, MipFilter mips, double* outPSNR)
+    {
+        outSRV.Reset();
+        if (outPSNR) *outPSNR = 0.0;
+        TextureData data;
+        if (!PrepareCompressed(img, fmt, quality, mips, data, outPSNR != nullptr)) return false;
+        if (outPSNR) *outPSNR = data.psnr;
+        return CreateSRV(dev, data, outSRV);
     }
 
-    bool LoadR8(ID3D11Device* dev, const wchar_t* path,
+    bool LoadRGBA8(ID3D11Device* dev, const wchar_t* path,
         ComPtr<ID3D11ShaderResourceView>& outSRV,
-        unsigned* outW, unsigned* outH)
+        unsigned* outW, unsigned* outH, MipFilter mips)
     {
         outSRV.Reset();
         if (outW) *outW = 0; if (outH) *outH = 0;
 
-        FILE* fp = nullptr;
-#ifdef _WIN32
-        _wfopen_s(&fp, path, L"rb");
-#else
-        fp = std::fopen(/*convert path*/, "rb");
-#endif
-        if (!fp) return false;
-
-        BmpFileHeader fh{};
-        BmpInfoHeader ih{};
-        bool ok = ReadHeaders(fp, fh, ih);
-        if (!ok) { std::fclose(fp); return false; }
-
-        const unsigned W = (unsigned)ih.biWidth;
-        const unsigned H = (unsigned)(ih.biHeight > 0 ? ih.biHeight : -ih.biHeight);
-        const bool bottomUp = (ih.biHeight > 0);
-        const unsigned bc = ih.biBitCount;
-
-        if (bc != 24) { std::fclose(fp); return false; } // R8 δ 24-bit
-
-        std::fseek(fp, (long)fh.bfOffBits, SEEK_SET);
-
-        const unsigned srcStride = ((W * 3u) + 3u) & ~3u; // 4Ʈ е
-        std::vector<unsigned char> row(srcStride);
-        std::vector<unsigned char> gray(W * H);
-
-        for (unsigned y = 0; y < H; ++y) {
-            if (std::fread(row.data(), 1, srcStride, fp) != srcStride) { std::fclose(fp); return false; }
-            unsigned dy = bottomUp ? (H - 1 - y) : y;
-            unsigned char* dst = &gray[dy * W];
-            for (unsigned x = 0; x < W; ++x) {
-                unsigned char B = row[x * 3 + 0];
-                unsigned char G = row[x * 3 + 1];
-                unsigned char R = row[x * 3 + 2];
-                dst[x] = toGray(R, G, B);
-            }
-        }
-        std::fclose(fp);
+        Image img;
+        if (!DecodeRGBA8(path, img)) return false;
+        if (!CreateSRV(dev, img, outSRV, mips)) return false;
 
-        D3D11_TEXTURE2D_DESC td{};
-        td.Width = W; td.Height = H; td.MipLevels = 1; td.ArraySize = 1;
-        td.Format = DXGI_FORMAT_R8_UNORM;
-        td.SampleDesc.Count = 1;
-        td.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+        if (outW) *outW = img.width;
+        if (outH) *outH = img.height;
+        return true;
+    }
 
-        D3D11_SUBRESOURCE_DATA srd{};
-        srd.pSysMem = gray.data();
-        srd.SysMemPitch = W * sizeof(unsigned char);
+    bool LoadCompressed(ID3D11Device* dev, const wchar_t* path, BC::Format fmt,
+        ComPtr<ID3D11ShaderResourceView>& outSRV, BC::Quality quality, double* outPSNR)
+    {
+        outSRV.Reset();
+        if (outPSNR) *outPSNR = 0.0;
 
-        ComPtr<ID3D11Texture2D> tex;
-        HRESULT hr = dev->CreateTexture2D(&td, &srd, tex.GetAddressOf());
-        if (FAILED(hr)) return false;
+        Image img;
+        if (!(fmt == BC::Format::BC4 ? DecodeR8(path, img) : DecodeRGBA8(path, img))) return false;
+        const MipFilter mips = (fmt == BC::Format::BC1) ? MipFilter::SRGB : MipFilter::Linear;
+        return CreateSRVCompressed(dev, img, fmt, outSRV, quality, mips, outPSNR);
+    }
 
-        D3D11_SHADER_RESOURCE_VIEW_DESC sd{};
-        sd.Format = td.Format;
-        sd.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-        sd.Texture2D.MostDetailedMip = 0;
-        sd.Texture2D.MipLevels = 1;
+    bool LoadR8(ID3D11Device* dev, const wchar_t* path,
+        ComPtr<ID3D11ShaderResourceView>& outSRV,
+        unsigned* outW, unsigned* outH,
+        std::vector<unsigned char>* outPixels, MipFilter mips)
+    {
+        outSRV.Reset();
+        if (outW) *outW = 0; if (outH) *outH = 0;
 
-        hr = dev->CreateShaderResourceView(tex.Get(), &sd, outSRV.GetAddressOf());
-        if (FAILED(hr)) return false;
+        Image img;
+        if (!DecodeR8(path, img)) return false;
+        if (!CreateSRV(dev, img, outSRV, mips)) return false;
 
-        if (outW) *outW = W;
-        if (outH) *outH = H;
+        if (outW) *outW = img.width;
+        if (outH) *outH = img.height;
+        if (outPixels) outPixels->swap(img.pixels);
         return true;
     }
 
@@ -1,17 +1,76 @@
 #pragma once
 #include <wrl/client.h>
 #include <d3d11.h>
+#include <vector>
+#include "BMPDecode.h"
+#include "BlockCompress.h"
+#include "MipChain.h"
 
 namespace BMP {
 
+    // ε  CPU ؽó ( /BC ڵ Ϸ)
+    // D3D ȣ  Ŀ 忡   ְ,  ̽ 忡 Ѵ
+    //  0  ̹ ų  Ƿ source ̹ Ű θ   
+    struct TextureData {
+        DXGI_FORMAT format = DXGI_FORMAT_UNKNOWN;
+        unsigned width = 0, height = 0;
+        std::vector<D3D11_SUBRESOURCE_DATA> levels;
+        double psnr = 0.0;                  // BC (computePSNR)
+
+        Image source;
+        std::vector<uint8_t> resized;       // BC 4  
+        MipChain chain;
+        std::vector<BC::Surface> surfaces;
+    };
+
+    bool Prepare(const Image& img, MipFilter mips, TextureData& out);
+    bool PrepareCompressed(const Image& img, BC::Format fmt, BC::Quality quality, MipFilter mips,
+        TextureData& out, bool computePSNR = false);
+    bool CreateSRV(
+        ID3D11Device* dev,
+        const TextureData& data,
+        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& outSRV);
+
+    // ڵ ̹  Texture2D + SRV (ڵ BMPDecode.h)
+    // mips != None̸ CPU ü ü  Բ ε
+    bool CreateSRV(
+        ID3D11Device* dev,
+        const Image& img,
+        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& outSRV,
+        MipFilter mips = MipFilter::None);
+
+    // ڵ ̹  BC  Texture2D + SRV (Ӹ CPU ڵ)
+    // BC1: RGB, BC4: R, BC5: RG. ֻ 4  ƴϸ  ÷ 
+    // outPSNR:  0   PSNR(dB), 
+    bool CreateSRVCompressed(
+        ID3D11Device* dev,
+        const Image& img,
+        BC::Format fmt,
+        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& outSRV,
+        BC::Quality quality = BC::Quality::Normal,
+        MipFilter mips = MipFilter::SRGB,
+        double* outPSNR = nullptr);
+
     // 24/32-bit BMP  RGBA8_UNORM ؽó SRV
+    // (top-down 32-bit   BGRA8_UNORM)
     // outW/outH (ʿ  nullptr)
     bool LoadRGBA8(
         ID3D11Device* dev,
         const wchar_t* path,
         Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& outSRV,
         unsigned* outW = nullptr,
-        unsigned* outH = nullptr);
+        unsigned* outH = nullptr,
+        MipFilter mips = MipFilter::SRGB);     // ˺:   ٿ
+
+    // BMP  BC  ؽó SRV (BC1/BC5 RGBA8, BC4 R8 ڵ)
+    // : BC1 sRGB,  ܴ 
+    bool LoadCompressed(
+        ID3D11Device* dev,
+        const wchar_t* path,
+        BC::Format fmt,
+        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& outSRV,
+        BC::Quality quality = BC::Quality::Normal,
+        double* outPSNR = nullptr);
 
     // 24-bit BMP  R8_UNORM ؽó SRV (̸)
     // RGB ġ ׷ ȯ(0.299, 0.587, 0.114)
@@ -20,6 +79,8 @@ namespace BMP {
         const wchar_t* path,
         Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& outSRV,
         unsigned* outW = nullptr,
-        unsigned* outH = nullptr);
+        unsigned* outH = nullptr,
+        std::vector<unsigned char>* outPixels = nullptr, // CPU 纻(W*H, top-down)
+        MipFilter mips = MipFilter::Linear);    // :  (Min/Max )
 
 } // namespace BMP
@@ -0,0 +1,495 @@
+#include "BlockCompress.h"
+#include "Parallel.h"
+#include "Simd.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+//   Է: äκ 16ȼ (R, G, B) 
+struct Block {
+    uint8_t c[3][16];
+};
+
+static void FetchBlock(const BC::Source& s, unsigned bx, unsigned by, unsigned nch, Block& b)
+{
+    const unsigned map[3] = { s.swapRB ? 2u : 0u, 1u, s.swapRB ? 0u : 2u };
+    for (unsigned y = 0; y < 4; ++y) {
+        const uint8_t* row = s.data + (size_t)std::min(by * 4 + y, s.height - 1) * s.rowPitch;
+        for (unsigned x = 0; x < 4; ++x) {
+            const uint8_t* p = row + (size_t)std::min(bx * 4 + x, s.width - 1) * s.channels;
+            for (unsigned c = 0; c < nch; ++c) b.c[c][y * 4 + x] = p[map[c]];
+        }
+    }
+}
+
+//  BC1 
+static uint16_t Pack565(const int e[3])
+{
+    return (uint16_t)((((e[0] * 31 + 127) / 255) << 11) | (((e[1] * 63 + 127) / 255) << 5) | ((e[2] * 31 + 127) / 255));
+}
+
+static void Unpack565(uint16_t c, int rgb[3])
+{
+    const int r = (c >> 11) & 31, g = (c >> 5) & 63, b = c & 31;
+    rgb[0] = (r << 3) | (r >> 2);
+    rgb[1] = (g << 2) | (g >> 4);
+    rgb[2] = (b << 3) | (b >> 2);
+}
+
+static void PaletteBC1(uint16_t c0, uint16_t c1, int pal[4][3])
+{
+    Unpack565(c0, pal[0]);
+    Unpack565(c1, pal[1]);
+    for (int c = 0; c < 3; ++c) {
+        if (c0 > c1) {
+            pal[2][c] = (2 * pal[0][c] + pal[1][c] + 1) / 3;
+            pal[3][c] = (pal[0][c] + 2 * pal[1][c] + 1) / 3;
+        }
+        else {  // 3  (c0 <= c1)
+            pal[2][c] = (pal[0][c] + pal[1][c] + 1) / 2;
+            pal[3][c] = 0;
+        }
+    }
+}
+
+// 16ȼ ȷƮ ֱ ε, ȯ   
+static int SelectBC1(const Block& b, const int pal[4][3], uint8_t idx[16])
+{
+    int err = 0;
+#if JM_SIMD_X86
+    const __m128i z = _mm_setzero_si128();
+    __m128 pr[4], pg[4], pb[4];
+    for (int k = 0; k < 4; ++k) {
+        pr[k] = _mm_set1_ps((float)pal[k][0]);
+        pg[k] = _mm_set1_ps((float)pal[k][1]);
+        pb[k] = _mm_set1_ps((float)pal[k][2]);
+    }
+    auto load4 = [&](const uint8_t* p) {
+        int v; std::memcpy(&v, p, 4);
+        return _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(v), z), z));
+    };
+    for (int g = 0; g < 16; g += 4) {
+        const __m128 r = load4(b.c[0] + g), gg = load4(b.c[1] + g), bb = load4(b.c[2] + g);
+        __m128 best = _mm_set1_ps(1e30f);
+        __m128i bi = z;
+        for (int k = 0; k < 4; ++k) {
+            __m128 dr = _mm_sub_ps(r, pr[k]), dg = _mm_sub_ps(gg, pg[k]), db = _mm_sub_ps(bb, pb[k]);
+            __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dr, dr), _mm_mul_ps(dg, dg)), _mm_mul_ps(db, db));
+            __m128i m = _mm_castps_si128(_mm_cmplt_ps(d, best));
+            best = _mm_min_ps(d, best);
+            bi = _mm_or_si128(_mm_andnot_si128(m, bi), _mm_and_si128(m, _mm_set1_epi32(k)));
+        }
+        alignas(16) int bis[4]; alignas(16) float bests[4];
+        _mm_store_si128((__m128i*)bis, bi);
+        _mm_store_ps(bests, best);
+        for (int i = 0; i < 4; ++i) { idx[g + i] = (uint8_t)bis[i]; err += (int)bests[i]; }
+    }
+#else
+    for (int i = 0; i < 16; ++i) {
+        int best = INT32_MAX, bi = 0;
+        for (int k = 0; k < 4; ++k) {
+            const int dr = b.c[0][i] - pal[k][0], dg = b.c[1][i] - pal[k][1], db = b.c[2][i] - pal[k][2];
+            const int d = dr * dr + dg * dg + db * db;
+            if (d < best) { best = d; bi = k; }
+        }
+        idx[i] = (uint8_t)bi;
+        err += best;
+    }
+#endif
+    return err;
+}
+
+struct BC1Result {
+    uint16_t c0 = 0, c1 = 0;
+    uint8_t idx[16] = {};
+    int err = INT32_MAX;
+};
+
+//   565 ȭ(4  )  ε 
+static void FinishBC1(const Block& b, const int e0[3], const int e1[3], BC1Result& best)
+{
+    BC1Result r;
+    r.c0 = Pack565(e0); r.c1 = Pack565(e1);
+    if (r.c0 < r.c1) std::swap(r.c0, r.c1);
+
+    int pal[4][3];
+    PaletteBC1(r.c0, r.c1, pal);
+    if (r.c0 == r.c1) {
+        // ܻ: 3 忡 ε 0 
+        r.err = 0;
+        for (int i = 0; i < 16; ++i) {
+            r.idx[i] = 0;
+            for (int c = 0; c < 3; ++c) { const int d = b.c[c][i] - pal[0][c]; r.err += d * d; }
+        }
+    }
+    else r.err = SelectBC1(b, pal, r.idx);
+
+    if (r.err < best.err) best = r;
+}
+
+static void EndpointsBBox(const Block& b, int e0[3], int e1[3])
+{
+    for (int c = 0; c < 3; ++c) {
+        int mn = 255, mx = 0;
+        for (int i = 0; i < 16; ++i) { mn = std::min<int>(mn, b.c[c][i]); mx = std::max<int>(mx, b.c[c][i]); }
+        const int inset = (mx - mn) >> 4;
+        e0[c] = mx - inset; e1[c] = mn + inset;
+    }
+}
+
+// л ּ    
+static void EndpointsPCA(const Block& b, int e0[3], int e1[3])
+{
+    float mean[3] = {};
+    for (int c = 0; c < 3; ++c)
+        for (int i = 0; i < 16; ++i) mean[c] += b.c[c][i];
+    for (float& m : mean) m *= 1.0f / 16.0f;
+
+    float cov[6] = {};  // rr rg rb gg gb bb
+    for (int i = 0; i < 16; ++i) {
+        const float r = b.c[0][i] - mean[0], g = b.c[1][i] - mean[1], bl = b.c[2][i] - mean[2];
+        cov[0] += r * r; cov[1] += r * g; cov[2] += r * bl;
+        cov[3] += g * g; cov[4] += g * bl; cov[5] += bl * bl;
+    }
+
+    // ŵ ݺ  : л  ū ä л 
+    // (ڽ 밢 ϸ /ʷó ݴ ̴ Ͽ  0 ࿡ ӹ)
+    const float rows[3][3] = { { cov[0], cov[1], cov[2] }, { cov[1], cov[3], cov[4] }, { cov[2], cov[4], cov[5] } };
+    const int top = (cov[0] >= cov[3] && cov[0] >= cov[5]) ? 0 : (cov[3] >= cov[5] ? 1 : 2);
+    float v[3] = { rows[top][0], rows[top][1], rows[top][2] };
+    for (int it = 0; it < 4; ++it) {
+        const float x = cov[0] * v[0] + cov[1] * v[1] + cov[2] * v[2];
+        const float y = cov[1] * v[0] + cov[3] * v[1] + cov[4] * v[2];
+        const float z = cov[2] * v[0] + cov[4] * v[1] + cov[5] * v[2];
+        const float m = std::max(std::fabs(x), std::max(std::fabs(y), std::fabs(z)));
+        if (m < 1e-6f) break;
+        v[0] = x / m; v[1] = y / m; v[2] = z / m;
+    }
+
+    const float len2 = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+    if (len2 < 1e-12f) { EndpointsBBox(b, e0, e1); return; }
+    const float inv = 1.0f / std::sqrt(len2);
+    for (float& a : v) a *= inv;
+
+    //     ٿ ڽ   
+    float tMin = 1e30f, tMax = -1e30f;
+    for (int i = 0; i < 16; ++i) {
+        const float t = (b.c[0][i] - mean[0]) * v[0] + (b.c[1][i] - mean[1]) * v[1] + (b.c[2][i] - mean[2]) * v[2];
+        tMin = std::min(tMin, t); tMax = std::max(tMax, t);
+    }
+    const float inset = (tMax - tMin) / 16.0f;
+    tMin += inset; tMax -= inset;
+    for (int c = 0; c < 3; ++c) {
+        e0[c] = std::clamp((int)std::lround(mean[c] + v[c] * tMax), 0, 255);
+        e1[c] = std::clamp((int)std::lround(mean[c] + v[c] * tMin), 0, 255);
+    }
+}
+
+//  ε  ּ  (ε k c0 ġ)
+static bool RefineBC1(const Block& b, const BC1Result& r, int e0[3], int e1[3])
+{
+    static const float w0[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+    float aa = 0, ab = 0, bb = 0, ax[3] = {}, bx[3] = {};
+    for (int i = 0; i < 16; ++i) {
+        const float a = w0[r.idx[i]], be = 1.0f - a;
+        aa += a * a; ab += a * be; bb += be * be;
+        for (int c = 0; c < 3; ++c) { ax[c] += a * b.c[c][i]; bx[c] += be * b.c[c][i]; }
+    }
+    const float det = aa * bb - ab * ab;
+    if (std::fabs(det) < 1e-6f) return false;
+    const float inv = 1.0f / det;
+    for (int c = 0; c < 3; ++c) {
+        e0[c] = std::clamp((int)std::lround((ax[c] * bb - bx[c] * ab) * inv), 0, 255);
+        e1[c] = std::clamp((int)std::lround((bx[c] * aa - ax[c] * ab) * inv), 0, 255);
+    }
+    return true;
+}
+
+static void EncodeBC1Block(const Block& b, BC::Quality q, uint8_t* out)
+{
+    BC1Result best;
+    int e0[3], e1[3];
+    EndpointsBBox(b, e0, e1);
+    FinishBC1(b, e0, e1, best);
+    if (q != BC::Quality::Fast) {
+        //  밢 ƴ Ͽ, ڽ  ڸ 
+        EndpointsPCA(b, e0, e1);
+        FinishBC1(b, e0, e1, best);
+    }
+
+    if (q == BC::Quality::High && best.c0 != best.c1) {
+        for (int it = 0; it < 2; ++it) {
+            const int prev = best.err;
+            if (!RefineBC1(b, best, e0, e1)) break;
+            FinishBC1(b, e0, e1, best);
+            if (best.err >= prev) break;
+        }
+    }
+
+    uint32_t bits = 0;
+    for (int i = 0; i < 16; ++i) bits |= (uint32_t)best.idx[i] << (2 * i);
+    out[0] = (uint8_t)best.c0; out[1] = (uint8_t)(best.c0 >> 8);
+    out[2] = (uint8_t)best.c1; out[3] = (uint8_t)(best.c1 >> 8);
+    std::memcpy(out + 4, &bits, 4);
+}
+
+//  BC4 
+static void PaletteBC4(int e0, int e1, int pal[8])
+{
+    pal[0] = e0; pal[1] = e1;
+    if (e0 > e1) {
+        for (int k = 1; k <= 6; ++k) pal[k + 1] = ((7 - k) * e0 + k * e1 + 3) / 7;
+    }
+    else {  // 6  + 0/255
+        for (int k = 1; k <= 4; ++k) pal[k + 1] = ((5 - k) * e0 + k * e1 + 2) / 5;
+        pal[6] = 0; pal[7] = 255;
+    }
+}
+
+static int SelectBC4(const uint8_t v[16], const int pal[8], uint8_t idx[16])
+{
+    int err = 0;
+#if JM_SIMD_X86
+    const __m128i z = _mm_setzero_si128();
+    const __m128i x = _mm_loadu_si128((const __m128i*)v);
+    const __m128i xs[2] = { _mm_unpacklo_epi8(x, z), _mm_unpackhi_epi8(x, z) };
+    for (int h = 0; h < 2; ++h) {
+        __m128i best = _mm_set1_epi16(0x7FFF), bi = z;
+        for (int k = 0; k < 8; ++k) {
+            const __m128i p = _mm_set1_epi16((short)pal[k]);
+            const __m128i d = _mm_max_epi16(_mm_sub_epi16(xs[h], p), _mm_sub_epi16(p, xs[h]));
+            const __m128i m = _mm_cmplt_epi16(d, best);
+            best = _mm_min_epi16(d, best);
+            bi = _mm_or_si128(_mm_andnot_si128(m, bi), _mm_and_si128(m, _mm_set1_epi16((short)k)));
+        }
+        alignas(16) int16_t bis[8], bests[8];
+        _mm_store_si128((__m128i*)bis, bi);
+        _mm_store_si128((__m128i*)bests, best);
+        for (int i = 0; i < 8; ++i) { idx[h * 8 + i] = (uint8_t)bis[i]; err += bests[i] * bests[i]; }
+    }
+#else
+    for (int i = 0; i < 16; ++i) {
+        int best = INT32_MAX, bi = 0;
+        for (int k = 0; k < 8; ++k) {
+            const int d = std::abs((int)v[i] - pal[k]);
+            if (d < best) { best = d; bi = k; }
+        }
+        idx[i] = (uint8_t)bi;
+        err += best * best;
+    }
+#endif
+    return err;
+}
+
+struct BC4Result {
+    int e0 = 0, e1 = 0;
+    uint8_t idx[16] = {};
+    int err = INT32_MAX;
+};
+
+static void TryBC4(const uint8_t v[16], int e0, int e1, BC4Result& best)
+{
+    BC4Result r;
+    r.e0 = e0; r.e1 = e1;
+    int pal[8];
+    PaletteBC4(e0, e1, pal);
+    r.err = SelectBC4(v, pal, r.idx);
+    if (r.err < best.err) best = r;
+}
+
+static void EncodeBC4Block(const uint8_t v[16], BC::Quality q, uint8_t* out)
+{
+    int mn = 255, mx = 0, mnIn = 255, mxIn = 0;
+    bool extremes = false;
+    for (int i = 0; i < 16; ++i) {
+        mn = std::min<int>(mn, v[i]); mx = std::max<int>(mx, v[i]);
+        if (v[i] == 0 || v[i] == 255) extremes = true;
+        else { mnIn = std::min<int>(mnIn, v[i]); mxIn = std::max<int>(mxIn, v[i]); }
+    }
+    if (mnIn > mxIn) mnIn = mxIn = 0;   //  0/255
+
+    BC4Result best;
+    if (mx == mn) TryBC4(v, mx, mn, best);  // ܻ (e0 == e1  ε 0)
+    else {
+        TryBC4(v, mx, mn, best);            // 8  (e0 > e1)
+        if (q != BC::Quality::Fast && extremes) TryBC4(v, mnIn, mxIn, best);
+
+        if (q == BC::Quality::High) {
+            //  ֺ 2 Ž (  )
+            for (int d0 = -2; d0 <= 2; ++d0)
+                for (int d1 = -2; d1 <= 2; ++d1) {
+                    const int a = std::clamp(mx + d0, 0, 255), b = std::clamp(mn + d1, 0, 255);
+                    if (a > b) TryBC4(v, a, b, best);
+                    if (extremes) {
+                        const int c = std::clamp(mnIn + d0, 0, 255), d = std::clamp(mxIn + d1, 0, 255);
+                        if (c <= d) TryBC4(v, c, d, best);
+                    }
+                }
+        }
+    }
+
+    uint64_t bits = 0;
+    for (int i = 0; i < 16; ++i) bits |= (uint64_t)best.idx[i] << (3 * i);
+    out[0] = (uint8_t)best.e0; out[1] = (uint8_t)best.e1;
+    for (int i = 0; i < 6; ++i) out[2 + i] = (uint8_t)(bits >> (8 * i));
+}
+
+static void DecodeBC4Block(const uint8_t* in, uint8_t* dst, size_t pitch, unsigned stride, unsigned bw, unsigned bh)
+{
+    int pal[8];
+    PaletteBC4(in[0], in[1], pal);
+    uint64_t bits = 0;
+    for (int i = 0; i < 6; ++i) bits |= (uint64_t)in[2 + i] << (8 * i);
+    for (unsigned y = 0; y < bh; ++y)
+        for (unsigned x = 0; x < bw; ++x)
+            dst[y * pitch + x * stride] = (uint8_t)pal[(bits >> (3 * (y * 4 + x))) & 7];
+}
+
+namespace BC {
+
+    size_t Surface::RowPitch() const { return (size_t)blocksX * BlockBytes(format); }
+
+    unsigned BlockBytes(Format f) { return f == Format::BC5 ? 16u : 8u; }
+
+    const char* FormatName(Format f)
+    {
+        switch (f) {
+        case Format::BC1: return "BC1";
+        case Format::BC4: return "BC4";
+        default:          return "BC5";
+        }
+    }
+
+    const char* QualityName(Quality q)
+    {
+        switch (q) {
+        case Quality::Fast:   return "Fast";
+        case Quality::Normal: return "Normal";
+        default:              return "High";
+        }
+    }
+
+    static unsigned ChannelsUsed(Format f) { return f == Format::BC1 ? 3u : (f == Format::BC5 ? 2u : 1u); }
+
+    void Encode(const Source& src, Format fmt, Quality quality, Surface& out)
+    {
+        out.format = fmt;
+        out.width = src.width; out.height = src.height;
+        out.blocksX = (src.width + 3) / 4; out.blocksY = (src.height + 3) / 4;
+        out.blocks.assign((size_t)out.blocksX * out.blocksY * BlockBytes(fmt), 0);
+
+        const unsigned nch = ChannelsUsed(fmt);
+        if (!src.data || out.blocks.empty() || src.channels < nch) return;
+
+        const size_t grain = std::max<size_t>(1, 1024 / out.blocksX);
+        Parallel::For(0, out.blocksY, grain, [&](size_t y0, size_t y1) {
+            Block b;
+            for (size_t by = y0; by < y1; ++by) {
+                uint8_t* dst = out.blocks.data() + by * out.RowPitch();
+                for (unsigned bx = 0; bx < out.blocksX; ++bx) {
+                    FetchBlock(src, bx, (unsigned)by, nch, b);
+                    switch (fmt) {
+                    case Format::BC1: EncodeBC1Block(b, quality, dst); dst += 8; break;
+                    case Format::BC4: EncodeBC4Block(b.c[0], quality, dst); dst += 8; break;
+                    case Format::BC5:
+                        EncodeBC4Block(b.c[0], quality, dst);
+                        EncodeBC4Block(b.c[1], quality, dst + 8);
+                        dst += 16;
+                        break;
+                    }
+                }
+            }
+        });
+    }
+
+    void Decode(const Surface& s, std::vector<uint8_t>& out, unsigned& outChannels)
+    {
+        outChannels = (s.format == Format::BC1) ? 4u : ChannelsUsed(s.format);
+        const size_t pitch = (size_t)s.width * outChannels;
+        out.assign(pitch * s.height, 0);
+
+        for (unsigned by = 0; by < s.blocksY; ++by) {
+            for (unsigned bx = 0; bx < s.blocksX; ++bx) {
+                const uint8_t* in = s.blocks.data() + by * s.RowPitch() + (size_t)bx * BlockBytes(s.format);
+                uint8_t* dst = out.data() + (size_t)by * 4 * pitch + (size_t)bx * 4 * outChannels;
+                const unsigned bw = std::min(4u, s.width - bx * 4), bh = std::min(4u, s.height - by * 4);
+
+                if (s.format == Format::BC1) {
+                    const uint16_t c0 = (uint16_t)(in[0] | (in[1] << 8)), c1 = (uint16_t)(in[2] | (in[3] << 8));
+                    int pal[4][3];
+                    PaletteBC1(c0, c1, pal);
+                    uint32_t bits; std::memcpy(&bits, in + 4, 4);
+                    for (unsigned y = 0; y < bh; ++y)
+                        for (unsigned x = 0; x < bw; ++x) {
+                            const unsigned k = (bits >> (2 * (y * 4 + x))) & 3;
+                            uint8_t* p = dst + y * pitch + x * 4;
+                            p[0] = (uint8_t)pal[k][0]; p[1] = (uint8_t)pal[k][1]; p[2] = (uint8_t)pal[k][2];
+                            p[3] = (c0 <= c1 && k == 3) ? 0 : 255;
+                        }
+                }
+                else {
+                    DecodeBC4Block(in, dst, pitch, outChannels, bw, bh);
+                    if (s.format == Format::BC5) DecodeBC4Block(in + 8, dst + 1, pitch, outChannels, bw, bh);
+                }
+            }
+        }
+    }
+
+    double PSNR(const Source& src, const Surface& s)
+    {
+        std::vector<uint8_t> dec;
+        unsigned dch = 0;
+        Decode(s, dec, dch);
+
+        const unsigned nch = ChannelsUsed(s.format);
+        const unsigned map[3] = { src.swapRB ? 2u : 0u, 1u, src.swapRB ? 0u : 2u };
+        double sum = 0.0;
+        for (unsigned y = 0; y < src.height; ++y) {
+            const uint8_t* a = src.data + y * src.rowPitch;
+            const uint8_t* b = dec.data() + (size_t)y * src.width * dch;
+            for (unsigned x = 0; x < src.width; ++x)
+                for (unsigned c = 0; c < nch; ++c) {
+                    const double d = (double)a[x * src.channels + map[c]] - b[x * dch + c];
+                    sum += d * d;
+                }
+        }
+        const double mse = sum / ((double)src.width * src.height * nch);
+        return mse > 0.0 ? 10.0 * std::log10(255.0 * 255.0 / mse) : 99.0;
+    }
+
+    BenchResult Benchmark(Format fmt, Quality quality, unsigned w, unsigned h, int iterations)
+    {
+        // ؽó  ε巯 ȭ +  
+        std::vector<uint8_t> img((size_t)w * h * 4);
+        std::mt19937 rng(11);
+        std::uniform_int_distribution<int> noise(-6, 6);
+        for (unsigned y = 0; y < h; ++y)
+            for (unsigned x = 0; x < w; ++x) {
+                uint8_t* p = &img[((size_t)y * w + x) * 4];
+                const float s = std::sin(x * 0.021f) * std::cos(y * 0.034f);
+                p[0] = (uint8_t)std::clamp((int)(128 + 100 * s) + noise(rng), 0, 255);
+                p[1] = (uint8_t)std::clamp((int)(x * 255 / w) + noise(rng), 0, 255);
+                p[2] = (uint8_t)std::clamp((int)(200 - 80 * s) + noise(rng), 0, 255);
+                p[3] = 255;
+            }
+
+        Source src;
+        src.data = img.data(); src.width = w; src.height = h; src.rowPitch = (size_t)w * 4; src.channels = 4;
+
+        BenchResult r;
+        Surface s;
+        r.ms = 1e30;
+        for (int it = 0; it < std::max(1, iterations); ++it) {
+            auto t0 = std::chrono::steady_clock::now();
+            Encode(src, fmt, quality, s);
+            r.ms = std::min(r.ms, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count());
+        }
+        r.blocks = (size_t)s.blocksX * s.blocksY;
+        r.mblocksPerSec = r.ms > 0.0 ? r.blocks / (r.ms * 1000.0) : 0.0;
+        r.psnr = PSNR(src, s);
+        return r;
+    }
+
+} // namespace BC
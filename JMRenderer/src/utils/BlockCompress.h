@@ -0,0 +1,63 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// BC1/BC4/BC5   ڴ (D3D  )
+// 4x4  ,    ھ  óѴ
+namespace BC {
+
+    enum class Format {
+        BC1,    // RGB 565   + 2bit ε (8B/, ˺)
+        BC4,    //  ä (8B/,  )
+        BC5,    //  ä BC4 x2 (16B/, /Լ)
+    };
+
+    enum class Quality {
+        Fast,   // ٿ ڽ 
+        Normal, // ڽ/ּ     (BC4: 0/255 嵵 õ)
+        High,   // Normal +  ּ/ֺ Ž
+    };
+
+    // Է ȼ  (top-down)
+    struct Source {
+        const uint8_t* data = nullptr;
+        unsigned width = 0, height = 0;
+        size_t rowPitch = 0;
+        unsigned channels = 4;      // ȼ Ʈ (BC1  3, BC5  2)
+        bool swapRB = false;        // BGRA Է̸ true
+    };
+
+    struct Surface {
+        Format format = Format::BC1;
+        unsigned width = 0, height = 0;
+        unsigned blocksX = 0, blocksY = 0;
+        std::vector<uint8_t> blocks;
+
+        size_t RowPitch() const;    //    Ʈ (D3D SysMemPitch)
+    };
+
+    unsigned BlockBytes(Format f);
+    const char* FormatName(Format f);
+    const char* QualityName(Quality q);
+
+    // ڸ   /  ä
+    void Encode(const Source& src, Format fmt, Quality quality, Surface& out);
+
+    // BC1  RGBA8, BC4  R8, BC5  RG8 (outChannels ȼ Ʈ)
+    void Decode(const Surface& s, std::vector<uint8_t>& out, unsigned& outChannels);
+
+    // ڵ  ä  PSNR(dB).   99
+    double PSNR(const Source& src, const Surface& s);
+
+    struct BenchResult {
+        size_t blocks = 0;
+        double ms = 0.0;            // ݺ  ּڰ
+        double mblocksPerSec = 0.0;
+        double psnr = 0.0;
+    };
+
+    // w x h ռ ̹(׶Ʈ +  + ) 
+    BenchResult Benchmark(Format fmt, Quality quality, unsigned w = 1024, unsigned h = 1024, int iterations = 3);
+
+} // namespace BC
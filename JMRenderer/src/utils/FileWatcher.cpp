@@ -0,0 +1,314 @@
+#include "FileWatcher.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cctype>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+std::string FileWatcher::PathKey(const fs::path& path)
+{
+    std::error_code ec;
+    fs::path p = fs::absolute(path, ec);
+    if (ec) p = path;
+    std::string key = p.lexically_normal().generic_u8string();
+#ifdef _WIN32
+    //  δ ҹ  
+    std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+#endif
+    return key;
+}
+
+FileWatcher::Stats FileWatcher::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(mStatsMutex);
+    return mStats;
+}
+
+void FileWatcher::OnRawEvent(const fs::path& path)
+{
+    const auto due = std::chrono::steady_clock::now() + std::chrono::milliseconds(mDebounceMs);
+    std::string key = PathKey(path);
+    auto it = mPending.find(key);
+    std::lock_guard<std::mutex> lock(mStatsMutex);
+    ++mStats.rawEvents;
+    if (it != mPending.end()) {
+        it->second.due = due;
+        ++mStats.coalesced;
+        return;
+    }
+    mPending.emplace(std::move(key), Pending{ path, due });
+}
+
+int FileWatcher::FlushDue()
+{
+    const auto now = std::chrono::steady_clock::now();
+    int waitMs = -1;
+    for (auto it = mPending.begin(); it != mPending.end();) {
+        if (it->second.due > now) {
+            const int ms = (int)std::chrono::duration_cast<std::chrono::milliseconds>(it->second.due - now).count() + 1;
+            waitMs = waitMs < 0 ? ms : std::min(waitMs, ms);
+            ++it;
+            continue;
+        }
+        fs::path p = it->second.path;
+        if (!mQueue.TryPush(std::move(p))) {   // ť    尡    ִ´
+            waitMs = waitMs < 0 ? 10 : std::min(waitMs, 10);
+            ++it;
+            continue;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mStatsMutex);
+            ++mStats.posted;
+        }
+        it = mPending.erase(it);
+    }
+    return waitMs;
+}
+
+#ifdef _WIN32
+
+bool FileWatcher::Start(const std::vector<fs::path>& dirs, int debounceMs)
+{
+    Stop();
+    mDirs.clear();
+    std::error_code ec;
+    for (const fs::path& d : dirs)
+        if (fs::is_directory(d, ec)) mDirs.push_back(fs::absolute(d, ec).lexically_normal());
+    if (mDirs.empty()) return false;
+
+    fs::path drained;
+    while (mQueue.TryPop(drained)) {}
+    mDebounceMs = std::max(0, debounceMs);
+    mStats = {};
+    mStopEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    if (!mStopEvent) return false;
+    mThread = std::thread([this] { Run(); });
+    return true;
+}
+
+void FileWatcher::Stop()
+{
+    if (!mThread.joinable()) return;
+    mStop = true;
+    SetEvent((HANDLE)mStopEvent);
+    mThread.join();
+    CloseHandle((HANDLE)mStopEvent);
+    mStopEvent = nullptr;
+    mPending.clear();
+    mStop = false;
+}
+
+void FileWatcher::Run()
+{
+    Prof::SetThreadName("file watcher");
+
+    // ͸ ģ I/O  Ǿ ( Ʈ )
+    struct DirWatch {
+        HANDLE dir = INVALID_HANDLE_VALUE;
+        OVERLAPPED ov{};
+        std::vector<DWORD> buf = std::vector<DWORD>(16 << 10);  // 64 KB, DWORD 
+        fs::path root;
+    };
+    const DWORD filter = FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE;
+    auto issue = [&](DirWatch& w) {
+        return ReadDirectoryChangesW(w.dir, w.buf.data(), (DWORD)(w.buf.size() * sizeof(DWORD)), TRUE, filter,
+                                     nullptr, &w.ov, nullptr) != FALSE;
+    };
+
+    std::vector<DirWatch> watches(mDirs.size());
+    std::vector<HANDLE> handles{ (HANDLE)mStopEvent };
+    for (size_t i = 0; i < mDirs.size(); ++i) {
+        DirWatch& w = watches[i];
+        w.root = mDirs[i];
+        w.dir = CreateFileW(w.root.c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                            nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+        w.ov.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        if (w.dir == INVALID_HANDLE_VALUE || !w.ov.hEvent || !issue(w)) {
+            if (w.dir != INVALID_HANDLE_VALUE) CloseHandle(w.dir);
+            if (w.ov.hEvent) CloseHandle(w.ov.hEvent);
+            w.dir = INVALID_HANDLE_VALUE;
+            w.ov.hEvent = nullptr;
+        }
+    }
+    std::vector<DirWatch*> active;
+    for (DirWatch& w : watches)
+        if (w.dir != INVALID_HANDLE_VALUE) { active.push_back(&w); handles.push_back(w.ov.hEvent); }
+
+    while (!mStop.load()) {
+        const int waitMs = FlushDue();
+        const DWORD r = WaitForMultipleObjects((DWORD)handles.size(), handles.data(), FALSE,
+                                               waitMs < 0 ? INFINITE : (DWORD)waitMs);
+        if (r == WAIT_OBJECT_0 || r == WAIT_FAILED) break;
+        if (r == WAIT_TIMEOUT || r >= WAIT_OBJECT_0 + handles.size()) continue;
+
+        DirWatch& w = *active[r - WAIT_OBJECT_0 - 1];
+        DWORD bytes = 0;
+        if (GetOverlappedResult(w.dir, &w.ov, &bytes, FALSE)) {
+            if (bytes == 0) {
+                std::lock_guard<std::mutex> lock(mStatsMutex);
+                ++mStats.overflows;
+            }
+            const uint8_t* p = reinterpret_cast<const uint8_t*>(w.buf.data());
+            for (DWORD off = 0; bytes > 0;) {
+                const FILE_NOTIFY_INFORMATION* fni = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(p + off);
+                if (fni->Action != FILE_ACTION_REMOVED && fni->Action != FILE_ACTION_RENAMED_OLD_NAME) {
+                    const fs::path full = w.root / std::wstring(fni->FileName, fni->FileNameLength / sizeof(WCHAR));
+                    std::error_code ec;
+                    if (!fs::is_directory(full, ec)) OnRawEvent(full);
+                }
+                if (!fni->NextEntryOffset) break;
+                off += fni->NextEntryOffset;
+            }
+        }
+        if (!issue(w)) ResetEvent(w.ov.hEvent);   // ͸    ô 
+    }
+
+    for (DirWatch* w : active) {
+        CancelIoEx(w->dir, &w->ov);
+        DWORD bytes = 0;
+        GetOverlappedResult(w->dir, &w->ov, &bytes, TRUE);
+        CloseHandle(w->dir);
+        CloseHandle(w->ov.hEvent);
+    }
+}
+
+#else
+
+void FileWatcher::AddWatchTree(const fs::path& dir)
+{
+    const uint32_t mask = IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE_SELF;
+    std::error_code ec;
+    const int wd = inotify_add_watch(mInotify, dir.c_str(), mask);
+    if (wd >= 0) mWatchDirs[wd] = dir;
+    for (fs::recursive_directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+        if (!it->is_directory(ec)) continue;
+        const int sub = inotify_add_watch(mInotify, it->path().c_str(), mask);
+        if (sub >= 0) mWatchDirs[sub] = it->path();
+    }
+}
+
+bool FileWatcher::Start(const std::vector<fs::path>& dirs, int debounceMs)
+{
+    Stop();
+    mDirs.clear();
+    mInotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (mInotify < 0) return false;
+    std::error_code ec;
+    for (const fs::path& d : dirs) {
+        if (!fs::is_directory(d, ec)) continue;
+        mDirs.push_back(fs::absolute(d, ec).lexically_normal());
+        AddWatchTree(mDirs.back());
+    }
+    if (mWatchDirs.empty() || pipe(mWakeFd) != 0) {
+        close(mInotify);
+        mInotify = -1;
+        mWatchDirs.clear();
+        return false;
+    }
+
+    fs::path drained;
+    while (mQueue.TryPop(drained)) {}
+    mDebounceMs = std::max(0, debounceMs);
+    mStats = {};
+    mThread = std::thread([this] { Run(); });
+    return true;
+}
+
+void FileWatcher::Stop()
+{
+    if (!mThread.joinable()) return;
+    mStop = true;
+    const char c = 0;
+    if (write(mWakeFd[1], &c, 1) < 0) {}
+    mThread.join();
+    close(mInotify);
+    close(mWakeFd[0]);
+    close(mWakeFd[1]);
+    mInotify = mWakeFd[0] = mWakeFd[1] = -1;
+    mWatchDirs.clear();
+    mPending.clear();
+    mStop = false;
+}
+
+void FileWatcher::Run()
+{
+    Prof::SetThreadName("file watcher");
+    alignas(inotify_event) char buf[16 << 10];
+    while (!mStop.load()) {
+        const int waitMs = FlushDue();
+        pollfd fds[2] = { { mInotify, POLLIN, 0 }, { mWakeFd[0], POLLIN, 0 } };
+        if (poll(fds, 2, waitMs) < 0) continue;
+        if (fds[1].revents) break;
+        if (!(fds[0].revents & POLLIN)) continue;
+
+        for (;;) {
+            const ssize_t n = read(mInotify, buf, sizeof(buf));
+            if (n <= 0) break;
+            for (ssize_t off = 0; off < n;) {
+                const inotify_event* ev = reinterpret_cast<const inotify_event*>(buf + off);
+                off += (ssize_t)(sizeof(inotify_event) + ev->len);
+                if (ev->mask & IN_Q_OVERFLOW) {
+                    std::lock_guard<std::mutex> lock(mStatsMutex);
+                    ++mStats.overflows;
+                    continue;
+                }
+                auto it = mWatchDirs.find(ev->wd);
+                if (it == mWatchDirs.end()) continue;
+                if (ev->mask & IN_IGNORED) { mWatchDirs.erase(it); continue; }
+                if (!ev->len) continue;
+                const fs::path full = it->second / ev->name;
+                if (ev->mask & IN_ISDIR) {
+                    //   ͸  (inotify Ͱ ƴ)
+                    if (ev->mask & (IN_CREATE | IN_MOVED_TO)) AddWatchTree(full);
+                    continue;
+                }
+                OnRawEvent(full);
+            }
+        }
+    }
+}
+
+#endif
+
+//  FileDependencies 
+void FileDependencies::Set(uint32_t owner, const std::vector<fs::path>& files)
+{
+    Remove(owner);
+    std::vector<std::string>& keys = mFiles[owner];
+    for (const fs::path& f : files) {
+        std::string k = FileWatcher::PathKey(f);
+        if (std::find(keys.begin(), keys.end(), k) != keys.end()) continue;
+        mOwners[k].push_back(owner);
+        keys.push_back(std::move(k));
+    }
+}
+
+void FileDependencies::Remove(uint32_t owner)
+{
+    auto it = mFiles.find(owner);
+    if (it == mFiles.end()) return;
+    for (const std::string& k : it->second) {
+        auto o = mOwners.find(k);
+        if (o == mOwners.end()) continue;
+        o->second.erase(std::remove(o->second.begin(), o->second.end(), owner), o->second.end());
+        if (o->second.empty()) mOwners.erase(o);
+    }
+    mFiles.erase(it);
+}
+
+void FileDependencies::Owners(const std::string& key, std::vector<uint32_t>& out) const
+{
+    auto it = mOwners.find(key);
+    if (it != mOwners.end()) out.insert(out.end(), it->second.begin(), it->second.end());
+}
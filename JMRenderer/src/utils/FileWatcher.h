@@ -0,0 +1,86 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "SpscQueue.h"
+
+// ׶    (Windows: ReadDirectoryChangesW, Linux: inotify)
+//  尡 ̺Ʈ  debounceMs   ϸ ť ø (   ̺Ʈ     )
+//   Poll ⸸ Ѵ (/ý ȣ )
+class FileWatcher {
+public:
+    struct Stats {
+        uint64_t rawEvents = 0;     // OS  ̺Ʈ
+        uint64_t posted = 0;        // ٿ  ť ø 
+        uint64_t coalesced = 0;     // ٿ  ̺Ʈ
+        uint64_t overflows = 0;     // OS  ħ (   ĥ  )
+    };
+
+    FileWatcher() = default;
+    ~FileWatcher() { Stop(); }
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    // dirs Ʒ ͷ . ϳ  ϸ false
+    bool Start(const std::vector<std::filesystem::path>& dirs, int debounceMs = 100);
+    void Stop();
+    bool Running() const { return mThread.joinable(); }
+
+    //   : ٿ    ( )
+    bool Poll(std::filesystem::path& out) { return mQueue.TryPop(out); }
+
+    Stats GetStats() const;
+
+    // 񱳿  Ű:  + ȭ + '/'  (Windows ҹ)
+    static std::string PathKey(const std::filesystem::path& path);
+
+private:
+    struct Pending {
+        std::filesystem::path path;
+        std::chrono::steady_clock::time_point due;
+    };
+
+    void Run();
+    void OnRawEvent(const std::filesystem::path& path);
+    int  FlushDue();                //   ׸ ť, ȯ:  ѱ ms (-1 = )
+
+    std::vector<std::filesystem::path> mDirs;
+    int mDebounceMs = 100;
+    std::thread mThread;
+    std::atomic<bool> mStop{ false };
+    SpscQueue<std::filesystem::path> mQueue{ 256 };
+    std::unordered_map<std::string, Pending> mPending;  //   
+
+    mutable std::mutex mStatsMutex;
+    Stats mStats;
+
+#ifdef _WIN32
+    void* mStopEvent = nullptr;     // HANDLE
+#else
+    int mInotify = -1;
+    int mWakeFd[2] = { -1, -1 };    // Stop  poll 
+    std::unordered_map<int, std::filesystem::path> mWatchDirs;  // inotify wd  ͸
+    void AddWatchTree(const std::filesystem::path& dir);
+#endif
+};
+
+//   (̴ α׷ )  . ڴ ڱ    ° ٲ۴
+//   
+class FileDependencies {
+public:
+    void Set(uint32_t owner, const std::vector<std::filesystem::path>& files);
+    void Remove(uint32_t owner);
+    // key = FileWatcher::PathKey. out δ
+    void Owners(const std::string& key, std::vector<uint32_t>& out) const;
+    size_t FileCount() const { return mOwners.size(); }
+
+private:
+    std::unordered_map<uint32_t, std::vector<std::string>> mFiles;
+    std::unordered_map<std::string, std::vector<uint32_t>> mOwners;
+};
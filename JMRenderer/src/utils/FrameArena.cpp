@@ -0,0 +1,384 @@
+#include "FrameArena.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace FrameMem {
+
+    // ---- LinearArena ----
+
+    LinearArena::~LinearArena()
+    {
+        for (Block& b : mBlocks) ::operator delete(b.data, std::align_val_t(64));
+    }
+
+    void LinearArena::Select(size_t block, size_t offset, size_t base)
+    {
+        mCur = block;
+        mOff = offset;
+        mBase = base;
+        mData = (block < mBlocks.size()) ? mBlocks[block].data : nullptr;
+        mSize = (block < mBlocks.size()) ? mBlocks[block].size : 0;
+    }
+
+    void* LinearArena::AllocSlow(size_t bytes, size_t align)
+    {
+        //       (ǰ ڸ ̹ ִ ,  )
+        if (mData) Select(mCur + 1, 0, mBase + mSize);
+        for (;;) {
+            if (mCur == mBlocks.size()) {
+                const size_t size = std::max(mBlockBytes, bytes + align);
+                mBlocks.push_back({ static_cast<uint8_t*>(::operator new(size, std::align_val_t(64))), size });
+                mCapacity += size;
+                if (mBlocks.size() > 1) ++mOverflows;
+                Select(mCur, 0, mBase);
+            }
+            const uintptr_t base = (uintptr_t)mData;
+            const size_t start = (size_t)(((base + align - 1) & ~(uintptr_t)(align - 1)) - base);
+            if (start + bytes <= mSize) {
+                mOff = start + bytes;
+                return mData + start;
+            }
+            Select(mCur + 1, 0, mBase + mSize);
+        }
+    }
+
+    void LinearArena::Free(void* p, size_t bytes)
+    {
+        if (!p) return;
+        if (mPoison) std::memset(p, kPoisonByte, bytes);
+        uint8_t* q = static_cast<uint8_t*>(p);
+        if (mData && q >= mData && q + bytes == mData + mOff) {
+            mPeak = std::max(mPeak, Used());
+            mOff = (size_t)(q - mData);
+        }
+    }
+
+    void LinearArena::PoisonRange(size_t fromBlock, size_t fromOff, size_t toBlock, size_t toOff)
+    {
+        for (size_t i = fromBlock; i <= toBlock && i < mBlocks.size(); ++i) {
+            const size_t a = (i == fromBlock) ? fromOff : 0;
+            const size_t b = (i == toBlock) ? toOff : mBlocks[i].size;
+            if (b > a) std::memset(mBlocks[i].data + a, kPoisonByte, b - a);
+        }
+    }
+
+    void LinearArena::Rewind(const Marker& m)
+    {
+        mPeak = std::max(mPeak, Used());
+        if (mPoison) PoisonRange(m.block, m.offset, mCur, mOff);
+        Select(m.block, m.offset, m.base);
+    }
+
+    void LinearArena::Reset()
+    {
+        Rewind(Marker{});
+
+        //     Ͽ  ģ
+        if (mBlocks.size() > 1) {
+            for (Block& b : mBlocks) ::operator delete(b.data, std::align_val_t(64));
+            mBlocks.clear();
+            mBlocks.push_back({ static_cast<uint8_t*>(::operator new(mCapacity, std::align_val_t(64))), mCapacity });
+            if (mPoison) std::memset(mBlocks[0].data, kPoisonByte, mCapacity);
+            Select(0, 0, 0);
+        }
+        mPeak = 0;
+        mAllocs = 0;
+        mOverflows = 0;
+    }
+
+    // ---- FrameArena ----
+
+    namespace {
+
+        std::atomic<uint64_t> gSerial{ 0 };
+
+        //  ִ FrameArena ( 尡 ̹ ı Ʒ ǵ帮 ʵ)
+        std::mutex gLiveMutex;
+        std::vector<FrameArena*> gLive;
+
+        bool Alive(FrameArena* fa) { return std::find(gLive.begin(), gLive.end(), fa) != gLive.end(); }
+
+    } // namespace
+
+    // 帶   FrameArena ϳ (κ Default ϳ) +  尡 ϵ Ʒ
+    // 尡  Ҹڰ   ִ Ʒ  带 
+    struct ThreadExitHook {
+        const FrameArena* owner = nullptr;
+        uint64_t serial = 0;
+        void* arenas = nullptr;
+        std::vector<FrameArena*> registered;
+
+        ~ThreadExitHook()
+        {
+            const std::thread::id id = std::this_thread::get_id();
+            std::lock_guard<std::mutex> lock(gLiveMutex);
+            for (FrameArena* fa : registered)
+                if (Alive(fa)) fa->Unregister(id);
+        }
+    };
+    static thread_local ThreadExitHook tCache;
+
+    FrameArena::FrameArena()
+    {
+        mSerial.store(++gSerial);
+        std::lock_guard<std::mutex> lock(gLiveMutex);
+        gLive.push_back(this);
+    }
+
+    FrameArena::~FrameArena()
+    {
+        std::lock_guard<std::mutex> lock(gLiveMutex);
+        gLive.erase(std::find(gLive.begin(), gLive.end(), this));
+    }
+
+    void FrameArena::Init(int frames, size_t mainBlockBytes, size_t threadBlockBytes)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mFrames = std::min(std::max(frames, 1), kMaxFrames);
+        mMainBlockBytes = mainBlockBytes;
+        mThreadBlockBytes = threadBlockBytes;
+        mMainId = std::this_thread::get_id();
+        mThreads.clear();
+        mSlot.store(0);
+        mFrameIndex = 0;
+        mLast = {};
+        mHighWater = 0;
+        std::fill(std::begin(mHistory), std::end(mHistory), 0.0f);
+        mHistoryHead = 0;
+        mSerial.store(++gSerial);
+    }
+
+    FrameArena::ThreadArenas* FrameArena::Register()
+    {
+        const std::thread::id id = std::this_thread::get_id();
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (auto& t : mThreads)
+            if (t->id == id && !t->framesLeft) return t.get();
+
+        auto t = std::make_unique<ThreadArenas>();
+        t->id = id;
+        const size_t block = (id == mMainId) ? mMainBlockBytes : mThreadBlockBytes;
+        for (auto& a : t->frames) {
+            a = std::make_unique<LinearArena>(block);
+            a->SetPoison(mPoison);
+        }
+        mThreads.push_back(std::move(t));
+        return mThreads.back().get();
+    }
+
+    LinearArena& FrameArena::Local()
+    {
+        const uint64_t serial = mSerial.load(std::memory_order_acquire);
+        if (tCache.owner != this || tCache.serial != serial) {
+            tCache.arenas = Register();
+            tCache.owner = this;
+            tCache.serial = serial;
+            std::lock_guard<std::mutex> lock(gLiveMutex);
+            std::vector<FrameArena*>& reg = tCache.registered;
+            reg.erase(std::remove_if(reg.begin(), reg.end(), [](FrameArena* fa) { return !Alive(fa); }), reg.end());
+            if (std::find(reg.begin(), reg.end(), this) == reg.end()) reg.push_back(this);
+        }
+        return *static_cast<ThreadArenas*>(tCache.arenas)->frames[mSlot.load(std::memory_order_acquire)];
+    }
+
+    void FrameArena::EndFrame()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        const int slot = mSlot.load();
+        FrameStats s;
+        for (auto& t : mThreads) {
+            const LinearArena& a = *t->frames[slot];
+            if (t->id == mMainId) s.mainBytes += a.Peak();
+            else if (a.Allocations()) { s.threadBytes += a.Peak(); ++s.threads; }
+            s.allocations += a.Allocations();
+            s.overflowBlocks += a.Overflows();
+            for (int f = 0; f < mFrames; ++f) s.capacity += t->frames[f]->Capacity();
+        }
+
+        //   frames      ƹ  ʴ´
+        const int next = (slot + 1) % mFrames;
+        for (auto& t : mThreads) t->frames[next]->Reset();
+        mSlot.store(next, std::memory_order_release);
+
+        //  : frames      
+        mThreads.erase(std::remove_if(mThreads.begin(), mThreads.end(),
+            [](const std::unique_ptr<ThreadArenas>& t) { return t->framesLeft && --t->framesLeft == 0; }), mThreads.end());
+
+        mLast = s;
+        mHighWater = std::max(mHighWater, s.Total());
+        mHistory[mHistoryHead] = (float)(s.Total() / 1024.0);
+        mHistoryHead = (mHistoryHead + 1) % kHistory;
+        ++mFrameIndex;
+    }
+
+    void FrameArena::Unregister(std::thread::id id)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (auto& t : mThreads)
+            if (t->id == id && !t->framesLeft) t->framesLeft = mFrames;
+    }
+
+    size_t FrameArena::ThreadCount() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mThreads.size();
+    }
+
+    void FrameArena::SetPoison(bool on)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPoison = on;
+        for (auto& t : mThreads)
+            for (auto& a : t->frames) a->SetPoison(on);
+    }
+
+    void FrameArena::History(float outKB[kHistory]) const
+    {
+        for (int i = 0; i < kHistory; ++i) outKB[i] = mHistory[(mHistoryHead + i) % kHistory];
+    }
+
+    FrameArena& Default()
+    {
+        static FrameArena s;
+        return s;
+    }
+
+    // ---- ġũ ----
+
+    namespace {
+
+        inline uint32_t Hash(uint32_t x)
+        {
+            x ^= x >> 16; x *= 0x7FEB352Du; x ^= x >> 15; x *= 0x846CA68Bu; x ^= x >> 16;
+            return x;
+        }
+
+        struct DrawItem32 { float f[6]; uint32_t lod, mask; };         // TerrainDraw ũ
+        struct SceneCB256 { float m[64]; };
+        struct SmallCB64 { float v[16]; };
+        struct NodeCB32 { float v[8]; };
+
+        //  ۾ Ҵ⸸ ٲ㼭
+        struct StdPolicy {
+            template<class T> std::allocator<T> Alloc() { return {}; }
+            template<class T> T* New() { return new T(); }
+            template<class T> void Delete(T* p) { delete p; }
+            void EndFrame() {}
+        };
+        struct ArenaPolicy {
+            FrameArena& fa;
+            template<class T> Allocator<T> Alloc() { return fa.Alloc<T>(); }
+            template<class T> T* New() { return fa.New<T>(); }
+            template<class T> void Delete(T*) {}
+            void EndFrame() { fa.EndFrame(); }
+        };
+
+        template<class P, class T>
+        using VecOf = std::vector<T, decltype(std::declval<P&>().template Alloc<T>())>;
+
+        // ø ó ũ⸦ 𸣰 push_back (reserve )
+        template<class P>
+        uint64_t VisibleLists(P& p)
+        {
+            VecOf<P, uint32_t> vis(p.template Alloc<uint32_t>());
+            VecOf<P, DrawItem32> draws(p.template Alloc<DrawItem32>());
+            for (uint32_t i = 0; i < 4096; ++i)
+                if (Hash(i) & 1) vis.push_back(i);
+            for (uint32_t i = 0; i < 1024; ++i) draws.push_back({ { (float)i }, i & 7, Hash(i) & 15 });
+            uint64_t sum = vis.size();
+            for (const DrawItem32& d : draws) sum += d.mask;
+            return sum;
+        }
+
+        // 帶  
+        template<class P>
+        uint64_t NodeLists(P& p)
+        {
+            uint64_t sum = 0;
+            for (uint32_t n = 0; n < 512; ++n) {
+                VecOf<P, float> list(p.template Alloc<float>());
+                const uint32_t count = 1 + (Hash(n) & 15);
+                for (uint32_t i = 0; i < count; ++i) list.push_back((float)i);
+                sum += list.size();
+            }
+            return sum;
+        }
+
+        //   ¡ (SceneCB/TerrainCB/MatCB + 庰 CB)
+        template<class P>
+        uint64_t CBStaging(P& p)
+        {
+            SceneCB256* scene = p.template New<SceneCB256>();
+            SmallCB64* terrain = p.template New<SmallCB64>();
+            SmallCB64* mat = p.template New<SmallCB64>();
+            scene->m[0] = 1.0f; terrain->v[0] = 2.0f; mat->v[0] = 3.0f;
+            uint64_t sum = (uint64_t)(scene->m[0] + terrain->v[0] + mat->v[0]);
+            NodeCB32* nodes[1024];
+            for (uint32_t i = 0; i < 1024; ++i) {
+                nodes[i] = p.template New<NodeCB32>();
+                nodes[i]->v[0] = (float)(i & 3);
+            }
+            for (NodeCB32* n : nodes) { sum += (uint64_t)n->v[0]; p.Delete(n); }
+            p.Delete(scene); p.Delete(terrain); p.Delete(mat);
+            return sum;
+        }
+
+        // Ŀ ۾ ũġ (Ʒ  庰 Ʒ)
+        template<class P>
+        uint64_t JobScratch(P& p)
+        {
+            std::atomic<uint64_t> sum{ 0 };
+            Jobs::For(0, 64, 1, [&](size_t b, size_t e) {
+                for (size_t j = b; j < e; ++j) {
+                    VecOf<P, uint32_t> scratch(p.template Alloc<uint32_t>());
+                    for (uint32_t i = 0; i < 512; ++i) scratch.push_back(Hash((uint32_t)j * 512 + i) & 0xFF);
+                    uint64_t local = 0;
+                    for (uint32_t v : scratch) local += v;
+                    sum.fetch_add(local, std::memory_order_relaxed);
+                }
+            });
+            return sum.load();
+        }
+
+        template<class P, class W>
+        double TimeFrames(P& p, W&& work, int frames, uint64_t& checksum)
+        {
+            for (int i = 0; i < 5; ++i) { work(p); p.EndFrame(); }     //  ũⰡ ڸ 
+            checksum = 0;
+            const auto t0 = std::chrono::steady_clock::now();
+            for (int i = 0; i < frames; ++i) { checksum += work(p); p.EndFrame(); }
+            return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / frames;
+        }
+
+    } // namespace
+
+    std::vector<BenchResult> Benchmark(int frames)
+    {
+        frames = std::max(frames, 1);
+        FrameArena fa;
+        fa.Init(2, 64 << 10, 16 << 10);     // Ϻη ۰: ù ӿ ġ  α
+        fa.SetPoison(false);
+        StdPolicy sp;
+        ArenaPolicy ap{ fa };
+
+        std::vector<BenchResult> out;
+        auto run = [&](const char* name, auto&& stdWork, auto&& arenaWork) {
+            BenchResult r;
+            r.name = name;
+            uint64_t a = 0, b = 0;
+            r.stdUs = TimeFrames(sp, stdWork, frames, a);
+            r.arenaUs = TimeFrames(ap, arenaWork, frames, b);
+            r.arenaBytes = fa.LastFrame().Total();
+            r.checksum = (a == b) ? a : 0;      // 0 =  ٸ
+            out.push_back(r);
+        };
+        run("visible lists", [](StdPolicy& p) { return VisibleLists(p); }, [](ArenaPolicy& p) { return VisibleLists(p); });
+        run("node lists", [](StdPolicy& p) { return NodeLists(p); }, [](ArenaPolicy& p) { return NodeLists(p); });
+        run("CB staging", [](StdPolicy& p) { return CBStaging(p); }, [](ArenaPolicy& p) { return CBStaging(p); });
+        run("job scratch", [](StdPolicy& p) { return JobScratch(p); }, [](ArenaPolicy& p) { return JobScratch(p); });
+        return out;
+    }
+
+} // namespace FrameMem
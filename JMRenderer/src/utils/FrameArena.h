@@ -0,0 +1,239 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//   ӽ ޸ (̴  ,   ¡, ũġ 迭 ...)
+// Ҵ =  ,  =   °.  delete/Ҹ ȣ 
+namespace FrameMem {
+
+    //   ⺻  ޸𸮸 0xDD ´ (  ͸  ٷ Ƽ )
+#if defined(_DEBUG)
+    constexpr bool kPoisonDefault = true;
+#else
+    constexpr bool kPoisonDefault = false;
+#endif
+    constexpr uint8_t kPoisonByte = 0xDD;
+
+    // () Ҵ.  ڶ  ϳ  , Reset ϳ ģ
+    //     Ӵ  ϳ, Ҵ  + 
+    //    (帶 : FrameArena::Local)
+    class LinearArena {
+    public:
+        struct Marker {
+            size_t block = 0, offset = 0, base = 0;
+        };
+
+        explicit LinearArena(size_t blockBytes = 64 << 10) : mBlockBytes(blockBytes) {}
+        ~LinearArena();
+        LinearArena(const LinearArena&) = delete;
+        LinearArena& operator=(const LinearArena&) = delete;
+
+        // align 2 ŵ.  ( Ͽ ) ζ
+        void* Alloc(size_t bytes, size_t align = alignof(std::max_align_t))
+        {
+            ++mAllocs;
+            const uintptr_t base = (uintptr_t)mData;
+            const size_t start = (size_t)(((base + mOff + align - 1) & ~(uintptr_t)(align - 1)) - base);
+            if (start + bytes <= mSize) {
+                mOff = start + bytes;
+                return mData + start;
+            }
+            return AllocSlow(bytes, align);
+        }
+        //  Ҵ̸ ǵ (vector Ŀ   ). ƴϸ  ä⸸
+        void  Free(void* p, size_t bytes);
+
+        // Ҹڸ θ Ƿ trivially destructible
+        template<class T, class... Args>
+        T* New(Args&&... args)
+        {
+            static_assert(std::is_trivially_destructible<T>::value, "arena objects are never destroyed");
+            return new (Alloc(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+        template<class T>
+        T* NewArray(size_t n)
+        {
+            static_assert(std::is_trivially_destructible<T>::value, "arena objects are never destroyed");
+            T* p = static_cast<T*>(Alloc(n * sizeof(T), alignof(T)));
+            for (size_t i = 0; i < n; ++i) new (p + i) T();
+            return p;
+        }
+
+        Marker Mark() const { return { mCur, mOff, mBase }; }
+        void   Rewind(const Marker& m);     // m  Ҵ  
+        void   Reset();                     //   + ģ  ġ +   ʱȭ
+
+        void SetBlockBytes(size_t bytes) { mBlockBytes = bytes; }
+        void SetPoison(bool on) { mPoison = on; }
+        bool Poison() const { return mPoison; }
+
+        size_t   Used() const { return mBase + mOff; }   //    
+        size_t   Peak() const { return std::max(mPeak, Used()); }   //  Reset  ְ
+        size_t   Capacity() const { return mCapacity; }
+        uint32_t Allocations() const { return mAllocs; }
+        uint32_t Overflows() const { return mOverflows; }    //  Reset    
+
+    private:
+        struct Block {
+            uint8_t* data = nullptr;
+            size_t size = 0;
+        };
+        void* AllocSlow(size_t bytes, size_t align);
+        void  Select(size_t block, size_t offset, size_t base);
+        void  PoisonRange(size_t fromBlock, size_t fromOff, size_t toBlock, size_t toOff);
+
+        std::vector<Block> mBlocks;
+        size_t mBlockBytes;
+        size_t mCur = 0, mOff = 0;          //  ϰ   ġ
+        uint8_t* mData = nullptr;           // mBlocks[mCur] ( nullptr, ũ 0)
+        size_t mSize = 0;
+        size_t mBase = 0;                   //    ϵ ũ 
+        size_t mCapacity = 0;
+        size_t mPeak = 0;
+        uint32_t mAllocs = 0, mOverflows = 0;
+        bool mPoison = kPoisonDefault;
+    };
+
+    // ǰ : Լ  ũġ  Ʒ    ش
+    // (EndFrame θ ʴ 帮 ġũ  ޸𸮰  ʴ´)
+    class Scope {
+    public:
+        explicit Scope(LinearArena& a) : mArena(a), mMark(a.Mark()) {}
+        ~Scope() { mArena.Rewind(mMark); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        LinearArena& Arena() const { return mArena; }
+    private:
+        LinearArena& mArena;
+        LinearArena::Marker mMark;
+    };
+
+    // STL Ҵ : std::vector<T, Allocator<T>>  Ʒ Ҵ
+    template<class T>
+    class Allocator {
+    public:
+        using value_type = T;
+
+        Allocator(LinearArena& a) noexcept : mArena(&a) {}
+        template<class U>
+        Allocator(const Allocator<U>& o) noexcept : mArena(o.Arena()) {}
+
+        T* allocate(size_t n) { return static_cast<T*>(mArena->Alloc(n * sizeof(T), alignof(T))); }
+        void deallocate(T* p, size_t n) noexcept { mArena->Free(p, n * sizeof(T)); }
+
+        LinearArena* Arena() const noexcept { return mArena; }
+
+        template<class U> bool operator==(const Allocator<U>& o) const noexcept { return mArena == o.Arena(); }
+        template<class U> bool operator!=(const Allocator<U>& o) const noexcept { return mArena != o.Arena(); }
+
+    private:
+        LinearArena* mArena;
+    };
+
+    template<class T>
+    using Vector = std::vector<T, Allocator<T>>;
+
+    //   뷮 (EndFrame )
+    struct FrameStats {
+        size_t   mainBytes = 0;             //   ְ 뷮
+        size_t   threadBytes = 0;           // ٸ  
+        size_t   capacity = 0;              //  /  
+        uint32_t threads = 0;               // ̹ ӿ Ҵ ٸ  
+        uint32_t allocations = 0;
+        uint32_t overflowBlocks = 0;        //      ( ¿ )
+        size_t   Total() const { return mainBytes + threadBytes; }
+    };
+
+    //  Ʒ:  frames (2 = , 3 = Ʈ )  
+    //  N Ҵ ޸𸮴 N + frames - 1   ȿ (ѵ  ʰ д ʿ)
+    // 帶 Ժ Ʒ    Ŀ ۾   Local() Ҵ
+    // Ģ: ̹ ӿ Ҵϴ ۾ EndFrame   ־ Ѵ (Jobs::Wait)
+    // 尡    Ʒ frames EndFrame ڿ  (׵ Ҵ ʹ ȿ)
+    //    ª  (ٷ Init/Shutdown ݺ, δ ...) ᵵ  ʴ´
+    struct ThreadExitHook;
+
+    class FrameArena {
+    public:
+        static constexpr int kMaxFrames = 3;
+        static constexpr int kHistory = 256;
+
+        FrameArena();
+        ~FrameArena();
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        // ȣ 尡   (mainBlockBytes ).    , ٸ 尡  
+        void Init(int frames = 2, size_t mainBlockBytes = 1 << 20, size_t threadBlockBytes = 64 << 10);
+        int  Frames() const { return mFrames; }
+        uint64_t FrameIndex() const { return mFrameIndex; }
+
+        // ȣ  ̹  Ʒ
+        LinearArena& Local();
+        template<class T, class... Args>
+        T* New(Args&&... args) { return Local().New<T>(std::forward<Args>(args)...); }
+        template<class T>
+        Allocator<T> Alloc() { return Allocator<T>(Local()); }
+
+        //  ,   (Present ): 踦    
+        void EndFrame();
+
+        void SetPoison(bool on);
+        bool Poison() const { return mPoison; }
+
+        const FrameStats& LastFrame() const { return mLast; }
+        size_t HighWater() const { return mHighWater; }     // ݱ   ְ (Total)
+        void   History(float outKB[kHistory]) const;        //  ͺ, KB
+
+        // Ʒ    (     )
+        size_t ThreadCount() const;
+
+    private:
+        friend struct ThreadExitHook;
+
+        struct ThreadArenas {
+            std::thread::id id;
+            std::unique_ptr<LinearArena> frames[kMaxFrames];
+            int framesLeft = 0;             // 尡    EndFrame  (0 =  )
+        };
+        ThreadArenas* Register();
+        void Unregister(std::thread::id id);    //   (ThreadExitHook Ҹ)
+
+        mutable std::mutex mMutex;
+        std::vector<std::unique_ptr<ThreadArenas>> mThreads;
+        std::thread::id mMainId;
+        std::atomic<uint64_t> mSerial{ 0 };     // 庰 ĳ ȿȭ (Init/  )
+        std::atomic<int> mSlot{ 0 };
+        int mFrames = 2;
+        size_t mMainBlockBytes = 1 << 20, mThreadBlockBytes = 64 << 10;
+        bool mPoison = kPoisonDefault;
+
+        uint64_t mFrameIndex = 0;
+        FrameStats mLast;
+        size_t mHighWater = 0;
+        float mHistory[kHistory] = {};
+        int mHistoryHead = 0;
+    };
+
+    //   Ʒ (InitAll Init, RenderFrame  EndFrame)
+    FrameArena& Default();
+
+    //   ۾ std::allocator Ʒ  (Ӵ  us)
+    struct BenchResult {
+        const char* name = "";
+        double stdUs = 0.0;
+        double arenaUs = 0.0;
+        size_t arenaBytes = 0;              // Ʒ   ְ 뷮
+        uint64_t checksum = 0;              //   ƾ Ѵ
+    };
+    std::vector<BenchResult> Benchmark(int frames = 200);
+
+} // namespace FrameMem
@@ -0,0 +1,230 @@
+#include "FrustumCull.h"
+#include "Simd.h"
+#include <chrono>
+#include <cmath>
+#include <random>
+
+Frustum Frustum::FromViewProj(const float m[16])
+{
+    // clip = v * M    M   (Gribb-Hartmann)
+    auto col = [&](int j, float out[4]) {
+        out[0] = m[0 * 4 + j]; out[1] = m[1 * 4 + j]; out[2] = m[2 * 4 + j]; out[3] = m[3 * 4 + j];
+    };
+    float c0[4], c1[4], c2[4], c3[4];
+    col(0, c0); col(1, c1); col(2, c2); col(3, c3);
+
+    Frustum f;
+    for (int k = 0; k < 4; ++k) {
+        f.planes[0][k] = c3[k] + c0[k]; // Left
+        f.planes[1][k] = c3[k] - c0[k]; // Right
+        f.planes[2][k] = c3[k] + c1[k]; // Bottom
+        f.planes[3][k] = c3[k] - c1[k]; // Top
+        f.planes[4][k] = c2[k];         // Near (z >= 0)
+        f.planes[5][k] = c3[k] - c2[k]; // Far
+    }
+    for (auto& p : f.planes) {
+        float len = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+        if (len > 0.0f) { p[0] /= len; p[1] /= len; p[2] /= len; p[3] /= len; }
+    }
+    return f;
+}
+
+void AABBSoA::Clear()
+{
+    minX.clear(); minY.clear(); minZ.clear();
+    maxX.clear(); maxY.clear(); maxZ.clear();
+}
+
+void AABBSoA::Reserve(size_t n)
+{
+    minX.reserve(n); minY.reserve(n); minZ.reserve(n);
+    maxX.reserve(n); maxY.reserve(n); maxZ.reserve(n);
+}
+
+void AABBSoA::Push(float x0, float y0, float z0, float x1, float y1, float z1)
+{
+    minX.push_back(x0); minY.push_back(y0); minZ.push_back(z0);
+    maxX.push_back(x1); maxY.push_back(y1); maxZ.push_back(z1);
+}
+
+//  Į   
+// p-vertex:      𼭸  ڿ  ٱ
+static inline bool BoxVisibleScalar(const Frustum& f, const AABBSoA& b, size_t i)
+{
+    for (const auto& p : f.planes) {
+        float x = p[0] >= 0.0f ? b.maxX[i] : b.minX[i];
+        float y = p[1] >= 0.0f ? b.maxY[i] : b.minY[i];
+        float z = p[2] >= 0.0f ? b.maxZ[i] : b.minZ[i];
+        // SIMD ο    ( Ʈ ġ)
+        if ((p[0] * x + p[1] * y) + (p[2] * z + p[3]) < 0.0f) return false;
+    }
+    return true;
+}
+
+static size_t CullScalar(const Frustum& f, const AABBSoA& b, size_t begin, size_t end, uint32_t* out)
+{
+    size_t n = 0;
+    for (size_t i = begin; i < end; ++i)
+        if (BoxVisibleScalar(f, b, i)) out[n++] = (uint32_t)i;
+    return n;
+}
+
+#if JM_SIMD_X86
+//  SSE 4-wide 
+static size_t CullSSE(const Frustum& f, const AABBSoA& b, uint32_t* out)
+{
+    const size_t count = b.Size();
+    const size_t body = count & ~(size_t)3;
+    size_t n = 0;
+    for (size_t i = 0; i < body; i += 4) {
+        __m128 outside = _mm_setzero_ps();
+        for (const auto& p : f.planes) {
+            __m128 x = _mm_loadu_ps(p[0] >= 0.0f ? &b.maxX[i] : &b.minX[i]);
+            __m128 y = _mm_loadu_ps(p[1] >= 0.0f ? &b.maxY[i] : &b.minY[i]);
+            __m128 z = _mm_loadu_ps(p[2] >= 0.0f ? &b.maxZ[i] : &b.minZ[i]);
+            __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(p[0]), x),
+                _mm_mul_ps(_mm_set1_ps(p[1]), y)),
+                _mm_add_ps(_mm_mul_ps(_mm_set1_ps(p[2]), z), _mm_set1_ps(p[3])));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(d, _mm_setzero_ps()));
+        }
+        uint32_t vis = ~(uint32_t)_mm_movemask_ps(outside) & 0xFu;
+        while (vis) {
+            out[n++] = (uint32_t)(i + Simd::Ctz32(vis));
+            vis &= vis - 1;
+        }
+    }
+    return n + CullScalar(f, b, body, count, out + n);
+}
+
+//  AVX 8-wide 
+JM_TARGET_AVX static size_t CullAVX(const Frustum& f, const AABBSoA& b, uint32_t* out)
+{
+    const size_t count = b.Size();
+    const size_t body = count & ~(size_t)7;
+    size_t n = 0;
+    for (size_t i = 0; i < body; i += 8) {
+        __m256 outside = _mm256_setzero_ps();
+        for (const auto& p : f.planes) {
+            __m256 x = _mm256_loadu_ps(p[0] >= 0.0f ? &b.maxX[i] : &b.minX[i]);
+            __m256 y = _mm256_loadu_ps(p[1] >= 0.0f ? &b.maxY[i] : &b.minY[i]);
+            __m256 z = _mm256_loadu_ps(p[2] >= 0.0f ? &b.maxZ[i] : &b.minZ[i]);
+            __m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p[0]), x),
+                _mm256_mul_ps(_mm256_set1_ps(p[1]), y)),
+                _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p[2]), z), _mm256_set1_ps(p[3])));
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(d, _mm256_setzero_ps(), _CMP_LT_OQ));
+        }
+        uint32_t vis = ~(uint32_t)_mm256_movemask_ps(outside) & 0xFFu;
+        while (vis) {
+            out[n++] = (uint32_t)(i + Simd::Ctz32(vis));
+            vis &= vis - 1;
+        }
+    }
+    return n + CullScalar(f, b, body, count, out + n);
+}
+#endif
+
+namespace Cull {
+
+    void LookAtViewProj(const float eye[3], const float target[3], float fovY, float aspect,
+        float zNear, float zFar, float out[16])
+    {
+        auto normalize = [](float v[3]) {
+            const float len = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+            const float inv = len > 0.0f ? 1.0f / len : 0.0f;
+            v[0] *= inv; v[1] *= inv; v[2] *= inv;
+        };
+        float zA[3] = { target[0] - eye[0], target[1] - eye[1], target[2] - eye[2] };
+        normalize(zA);
+        // xA = up x zA (up = +Y)
+        float xA[3] = { zA[2], 0.0f, -zA[0] };
+        normalize(xA);
+        const float yA[3] = { zA[1] * xA[2] - zA[2] * xA[1], zA[2] * xA[0] - zA[0] * xA[2], zA[0] * xA[1] - zA[1] * xA[0] };
+
+        const float view[16] = {
+            xA[0], yA[0], zA[0], 0.0f,
+            xA[1], yA[1], zA[1], 0.0f,
+            xA[2], yA[2], zA[2], 0.0f,
+            -(xA[0] * eye[0] + xA[1] * eye[1] + xA[2] * eye[2]),
+            -(yA[0] * eye[0] + yA[1] * eye[1] + yA[2] * eye[2]),
+            -(zA[0] * eye[0] + zA[1] * eye[1] + zA[2] * eye[2]), 1.0f,
+        };
+        const float h = 1.0f / std::tan(fovY * 0.5f), w = h / aspect, r = zFar / (zFar - zNear);
+        const float proj[16] = {
+            w, 0, 0, 0,
+            0, h, 0, 0,
+            0, 0, r, 1,
+            0, 0, -r * zNear, 0,
+        };
+        for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 4; ++j) {
+                float s = 0.0f;
+                for (int k = 0; k < 4; ++k) s += view[i * 4 + k] * proj[k * 4 + j];
+                out[i * 4 + j] = s;
+            }
+    }
+
+    CullPath ResolvePath(CullPath path)
+    {
+#if JM_SIMD_X86
+        if (path == CullPath::Auto) return Simd::Cpu().avx ? CullPath::AVX : CullPath::SSE;
+        if (path == CullPath::AVX && !Simd::Cpu().avx) return CullPath::SSE;
+        return path;
+#else
+        (void)path;
+        return CullPath::Scalar;
+#endif
+    }
+
+    const char* PathName(CullPath path)
+    {
+        switch (path) {
+        case CullPath::Scalar: return "Scalar";
+        case CullPath::SSE:    return "SSE";
+        case CullPath::AVX:    return "AVX";
+        default:               return "Auto";
+        }
+    }
+
+    size_t FrustumAABBs(const Frustum& f, const AABBSoA& boxes, uint32_t* outVisible, CullPath path)
+    {
+        switch (ResolvePath(path)) {
+#if JM_SIMD_X86
+        case CullPath::SSE: return CullSSE(f, boxes, outVisible);
+        case CullPath::AVX: return CullAVX(f, boxes, outVisible);
+#endif
+        default:            return CullScalar(f, boxes, 0, boxes.Size(), outVisible);
+        }
+    }
+
+    BenchResult Benchmark(const Frustum& f, size_t count, CullPath path, float extent, int iterations)
+    {
+        AABBSoA boxes;
+        boxes.Reserve(count);
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> pos(-extent, extent);
+        std::uniform_real_distribution<float> half(0.1f, extent * 0.01f + 0.1f);
+        for (size_t i = 0; i < count; ++i) {
+            float cx = pos(rng), cy = pos(rng), cz = pos(rng), h = half(rng);
+            boxes.Push(cx - h, cy - h, cz - h, cx + h, cy + h, cz + h);
+        }
+
+        std::vector<uint32_t> ref(count), vis(count);
+        size_t refCount = CullScalar(f, boxes, 0, count, ref.data());
+
+        BenchResult r;
+        r.boxes = count;
+        iterations = iterations < 1 ? 1 : iterations;
+        auto t0 = std::chrono::steady_clock::now();
+        for (int it = 0; it < iterations; ++it)
+            r.visible = FrustumAABBs(f, boxes, vis.data(), path);
+        auto t1 = std::chrono::steady_clock::now();
+
+        r.ms = std::chrono::duration<double, std::milli>(t1 - t0).count() / iterations;
+        r.mboxesPerSec = r.ms > 0.0 ? (double)count / (r.ms * 1000.0) : 0.0;
+        r.mismatches = (r.visible > refCount) ? r.visible - refCount : refCount - r.visible;
+        for (size_t i = 0; i < r.visible && i < refCount; ++i)
+            if (vis[i] != ref[i]) r.mismatches++;
+        return r;
+    }
+
+} // namespace Cull
@@ -0,0 +1,56 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// ü  6: a*x + b*y + c*z + d >= 0 ̸ 
+// : Left, Right, Bottom, Top, Near, Far
+struct Frustum {
+    float planes[6][4] = {};
+
+    //  켱 + ຤(v*M) Ծ ViewProj (DirectXMath ), D3D  0~1
+    static Frustum FromViewProj(const float m[16]);
+};
+
+// SoA AABB 迭 (SIMD ε带  к и)
+struct AABBSoA {
+    std::vector<float> minX, minY, minZ;
+    std::vector<float> maxX, maxY, maxZ;
+
+    size_t Size() const { return minX.size(); }
+    void Clear();
+    void Reserve(size_t n);
+    void Push(float x0, float y0, float z0, float x1, float y1, float z1);
+};
+
+enum class CullPath { Auto, Scalar, SSE, AVX };
+
+namespace Cull {
+
+    // ü ġ ڽ ε outVisible  ,  ȯ
+    // outVisible boxes.Size() ̻ ȮǾ ־ Ѵ
+    size_t FrustumAABBs(const Frustum& f, const AABBSoA& boxes, uint32_t* outVisible,
+        CullPath path = CullPath::Auto);
+
+    // XMMatrixLookAtLH * XMMatrixPerspectiveFovLH (DirectXMath , 帮 /׽Ʈ)
+    //  Frustum::FromViewProj   켱 + ຤ Ծ
+    void LookAtViewProj(const float eye[3], const float target[3], float fovY, float aspect,
+        float zNear, float zFar, float out[16]);
+
+    // Auto   
+    CullPath ResolvePath(CullPath path);
+    const char* PathName(CullPath path);
+
+    struct BenchResult {
+        size_t boxes = 0;
+        size_t visible = 0;
+        size_t mismatches = 0;  // Į  ο ٸ  
+        double ms = 0.0;        // 1ȸ 
+        double mboxesPerSec = 0.0;
+    };
+
+    //  ֺ [-extent, extent]^3   õ count ڽ   ( ھ)
+    BenchResult Benchmark(const Frustum& f, size_t count, CullPath path, float extent = 100.0f,
+        int iterations = 8);
+
+} // namespace Cull
@@ -0,0 +1,573 @@
+#include "JobSystem.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+namespace Jobs {
+
+    struct Job {
+        Task fn;
+        Counter* counter = nullptr;
+    };
+
+    namespace {
+
+        //  尡  ٷ Ŀ ȣ
+        struct ThreadIdentity {
+            const Scheduler* owner = nullptr;
+            int index = -1;
+        };
+        thread_local ThreadIdentity tSelf;
+
+        // Chase-Lev  ( ũ).   Push false  ִ  ٷ 
+        // 潺  seq_cst  길  (TSAN ״ ϰ, x86 ̰  )
+        class Deque {
+        public:
+            static constexpr int64_t kCapacity = 1 << 13;
+
+            bool Push(Job* j)       // θ
+            {
+                const int64_t b = mBottom.load(std::memory_order_relaxed);
+                const int64_t t = mTop.load(std::memory_order_acquire);
+                if (b - t >= kCapacity) return false;
+                mSlots[b & (kCapacity - 1)].store(j, std::memory_order_relaxed);
+                mBottom.store(b + 1, std::memory_order_seq_cst);
+                return true;
+            }
+
+            Job* Pop()              // θ (Ʒ)
+            {
+                const int64_t b = mBottom.load(std::memory_order_relaxed) - 1;
+                mBottom.store(b, std::memory_order_seq_cst);
+                int64_t t = mTop.load(std::memory_order_seq_cst);
+                if (t > b) {        //  
+                    mBottom.store(b + 1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+                Job* j = mSlots[b & (kCapacity - 1)].load(std::memory_order_relaxed);
+                if (t == b) {       //  ϳ: ġ ʰ 
+                    if (!mTop.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst)) j = nullptr;
+                    mBottom.store(b + 1, std::memory_order_relaxed);
+                }
+                return j;
+            }
+
+            Job* Steal()            // ƹ  ()
+            {
+                int64_t t = mTop.load(std::memory_order_seq_cst);
+                const int64_t b = mBottom.load(std::memory_order_seq_cst);
+                if (t >= b) return nullptr;
+                Job* j = mSlots[t & (kCapacity - 1)].load(std::memory_order_relaxed);
+                if (!mTop.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst)) return nullptr;
+                return j;
+            }
+
+        private:
+            alignas(64) std::atomic<int64_t> mTop{ 0 };
+            alignas(64) std::atomic<int64_t> mBottom{ 0 };
+            std::atomic<Job*> mSlots[kCapacity] = {};
+        };
+
+        double MsSince(std::chrono::steady_clock::time_point t0)
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        }
+
+    } // namespace
+
+    struct Scheduler::Worker {
+        Deque deque;
+        std::thread thread;
+        std::atomic<uint64_t> executed{ 0 };
+        std::atomic<uint64_t> stolen{ 0 };
+        uint32_t rng = 0;                       // ĥ   (  )
+    };
+
+    Counter::~Counter()
+    {
+        //  ڰ ļ ۾ ѱ ̸  
+        while (mBusy.load(std::memory_order_acquire) != 0) std::this_thread::yield();
+        for (Job* j : mThen) delete j;          //  Ǯ  ļ ۾
+    }
+
+    bool Counter::Done() const
+    {
+        return mCount.load(std::memory_order_acquire) == 0 && mBusy.load(std::memory_order_acquire) == 0;
+    }
+
+    Scheduler::Scheduler() = default;
+    Scheduler::~Scheduler() { Shutdown(); }
+
+    int Scheduler::Self() const
+    {
+        return tSelf.owner == this ? tSelf.index : -1;
+    }
+
+    void Scheduler::Init(unsigned workers)
+    {
+        if (Running()) return;
+        if (workers == 0) {
+            workers = std::thread::hardware_concurrency();
+            if (workers == 0) workers = 4;
+        }
+
+        mWorkers.clear();
+        for (unsigned i = 0; i < workers; ++i) {
+            mWorkers.push_back(std::make_unique<Worker>());
+            mWorkers.back()->rng = 0x9E3779B9u * (i + 1);
+        }
+        mStop.store(false);
+        mOutstanding.store(0);
+
+        mPrevOwner = tSelf.owner;
+        mPrevIndex = tSelf.index;
+        tSelf = { this, 0 };
+        mRunning.store(true, std::memory_order_release);
+
+        for (unsigned i = 1; i < workers; ++i)
+            mWorkers[i]->thread = std::thread(&Scheduler::WorkerLoop, this, (int)i);
+    }
+
+    void Scheduler::Shutdown()
+    {
+        if (!Running()) return;
+
+        //  ۾ (۾    )   ó
+        const int self = Self();
+        while (mOutstanding.load() != 0) {
+            bool stolen = false;
+            if (Job* j = Find(self, stolen)) Execute(j, self, stolen);
+            else std::this_thread::yield();
+        }
+
+        mStop.store(true);
+        {
+            std::lock_guard<std::mutex> lock(mSleepMutex);
+            mWake.notify_all();
+        }
+        for (auto& w : mWorkers)
+            if (w->thread.joinable()) w->thread.join();
+
+        mRunning.store(false, std::memory_order_release);
+        if (tSelf.owner == this) tSelf = { mPrevOwner, mPrevIndex };
+        mWorkers.clear();
+    }
+
+    void Scheduler::Run(Task fn, Counter* c)
+    {
+        if (!Running()) { fn(); return; }
+        if (c) c->mCount.fetch_add(1);
+        Push(new Job{ std::move(fn), c });
+    }
+
+    void Scheduler::Then(Counter& dep, Task fn, Counter* c)
+    {
+        if (c) c->mCount.fetch_add(1);
+        Job* j = new Job{ std::move(fn), c };
+        {
+            std::lock_guard<std::mutex> lock(dep.mMutex);
+            if (dep.mCount.load() != 0) { dep.mThen.push_back(j); return; }
+        }
+        Push(j);
+    }
+
+    void Scheduler::Wait(Counter& c)
+    {
+        const int self = Self();
+        while (!c.Done()) {
+            bool stolen = false;
+            if (Job* j = Find(self, stolen)) Execute(j, self, stolen);
+            else std::this_thread::yield();
+        }
+    }
+
+    void Scheduler::For(size_t begin, size_t end, size_t grain, std::function<void(size_t, size_t)> fn, Counter& c)
+    {
+        if (end <= begin) return;
+        grain = std::max<size_t>(grain, 1);
+        const size_t chunks = (end - begin + grain - 1) / grain;
+        if (chunks <= 1) { fn(begin, end); return; }
+        if (!Running()) {
+            for (size_t b = begin; b < end; b += grain) fn(b, std::min(end, b + grain));
+            return;
+        }
+        Split(begin, end, grain, 0, chunks, std::make_shared<const std::function<void(size_t, size_t)>>(std::move(fn)), &c);
+    }
+
+    // ۾ ϳ [c0, c1)  ô´. Ǹ          ó
+    //   log ܰ ,  Ŀ ū ( ) ģ
+    void Scheduler::Split(size_t begin, size_t end, size_t grain, size_t c0, size_t c1, const RangeFn& fn, Counter* c)
+    {
+        Run([this, begin, end, grain, c0, c1, fn, c]() mutable {
+            while (c1 - c0 > 1) {
+                const size_t mid = c0 + (c1 - c0) / 2;
+                Split(begin, end, grain, mid, c1, fn, c);
+                c1 = mid;
+            }
+            const size_t b = begin + c0 * grain;
+            (*fn)(b, std::min(end, b + grain));
+        }, c);
+    }
+
+    void Scheduler::Push(Job* j)
+    {
+        if (!Running()) { Execute(j, -1, false); return; }
+        mOutstanding.fetch_add(1);
+
+        const int self = Self();
+        if (self >= 0) {
+            if (!mWorkers[self]->deque.Push(j)) {
+                mInlined.fetch_add(1, std::memory_order_relaxed);
+                Execute(j, self, false);
+                return;
+            }
+        }
+        else {
+            std::lock_guard<std::mutex> lock(mInjectMutex);
+            mInject.push_back(j);
+            mInjectCount.fetch_add(1);
+            mInjected.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        mEpoch.fetch_add(1);
+        if (mSleepers.load() > 0) {
+            std::lock_guard<std::mutex> lock(mSleepMutex);
+            mWake.notify_one();
+        }
+    }
+
+    Job* Scheduler::Find(int self, bool& stolen)
+    {
+        stolen = false;
+        if (self >= 0)
+            if (Job* j = mWorkers[self]->deque.Pop()) return j;
+
+        if (mInjectCount.load() != 0) {
+            std::lock_guard<std::mutex> lock(mInjectMutex);
+            if (mInjectHead < mInject.size()) {
+                Job* j = mInject[mInjectHead++];
+                mInjectCount.fetch_sub(1);
+                if (mInjectHead == mInject.size()) { mInject.clear(); mInjectHead = 0; }
+                return j;
+            }
+        }
+
+        const size_t n = mWorkers.size();
+        size_t start = 0;
+        if (self >= 0) {
+            uint32_t& r = mWorkers[self]->rng;
+            r ^= r << 13; r ^= r >> 17; r ^= r << 5;
+            start = r % n;
+        }
+        for (size_t k = 0; k < n; ++k) {
+            const size_t v = (start + k) % n;
+            if ((int)v == self) continue;
+            if (Job* j = mWorkers[v]->deque.Steal()) { stolen = true; return j; }
+        }
+        return nullptr;
+    }
+
+    void Scheduler::Execute(Job* j, int self, bool stolen)
+    {
+        j->fn();
+        Counter* c = j->counter;
+        delete j;
+
+        if (self >= 0) {
+            Worker& w = *mWorkers[self];
+            w.executed.fetch_add(1, std::memory_order_relaxed);
+            if (stolen) w.stolen.fetch_add(1, std::memory_order_relaxed);
+        }
+        else mExternal.fetch_add(1, std::memory_order_relaxed);
+
+        Finish(c);
+        if (Running()) mOutstanding.fetch_sub(1);   // ļ ۾    Shutdown ġ ʴ´
+    }
+
+    void Scheduler::Finish(Counter* c)
+    {
+        if (!c) return;
+        c->mBusy.fetch_add(1);
+        if (c->mCount.fetch_sub(1) == 1) {
+            std::vector<Job*> then;
+            {
+                std::lock_guard<std::mutex> lock(c->mMutex);
+                then.swap(c->mThen);
+            }
+            for (Job* j : then) Push(j);
+        }
+        c->mBusy.fetch_sub(1, std::memory_order_release);  //  c ǵ帮 ʴ´
+    }
+
+    void Scheduler::WorkerLoop(int index)
+    {
+        tSelf = { this, index };
+        char name[32];
+        snprintf(name, sizeof(name), "job worker %d", index);
+        Prof::SetThreadName(name);
+
+        int idle = 0;
+        for (;;) {
+            bool stolen = false;
+            if (Job* j = Find(index, stolen)) {
+                Execute(j, index, stolen);
+                idle = 0;
+                continue;
+            }
+            if (mStop.load()) break;
+            if (++idle < 64) { std::this_thread::yield(); continue; }
+
+            //   epoch а    Ȯ   ڿ  ۾ epoch ٲ ٷ 
+            mSleepers.fetch_add(1);
+            const uint64_t epoch = mEpoch.load();
+            if (Job* j = Find(index, stolen)) {
+                mSleepers.fetch_sub(1);
+                Execute(j, index, stolen);
+                idle = 0;
+                continue;
+            }
+            {
+                std::unique_lock<std::mutex> lock(mSleepMutex);
+                mWake.wait(lock, [&] { return mEpoch.load() != epoch || mStop.load(); });
+            }
+            mSleepers.fetch_sub(1);
+            idle = 0;
+        }
+        tSelf = {};
+    }
+
+    Stats Scheduler::GetStats() const
+    {
+        Stats s;
+        for (const auto& w : mWorkers)
+            s.workers.push_back({ w->executed.load(std::memory_order_relaxed), w->stolen.load(std::memory_order_relaxed) });
+        s.injected = mInjected.load(std::memory_order_relaxed);
+        s.external = mExternal.load(std::memory_order_relaxed);
+        s.inlined = mInlined.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    void Scheduler::ResetStats()
+    {
+        for (auto& w : mWorkers) { w->executed.store(0); w->stolen.store(0); }
+        mInjected.store(0);
+        mExternal.store(0);
+        mInlined.store(0);
+    }
+
+    Scheduler& Default()
+    {
+        static Scheduler s;
+        return s;
+    }
+
+    // ----   ť ----
+
+    namespace {
+        std::mutex gMainMutex;
+        std::vector<Task> gMainTasks;
+    }
+
+    void RunOnMain(Task fn)
+    {
+        std::lock_guard<std::mutex> lock(gMainMutex);
+        gMainTasks.push_back(std::move(fn));
+    }
+
+    size_t PumpMain()
+    {
+        std::vector<Task> tasks;
+        {
+            std::lock_guard<std::mutex> lock(gMainMutex);
+            tasks.swap(gMainTasks);
+        }
+        for (Task& t : tasks) t();
+        return tasks.size();
+    }
+
+    // ---- ġũ / Ʈ ----
+
+    namespace {
+
+        //   :  ؽ    
+        inline uint32_t HashNoise(uint32_t x, uint32_t y)
+        {
+            uint32_t h = x * 0x8DA6B343u ^ y * 0xD8163841u;
+            for (int i = 0; i < 8; ++i) { h ^= h >> 15; h *= 0x2C1B3C6Du; h ^= h >> 12; h *= 0x297A2D39u; }
+            return h;
+        }
+
+    } // namespace
+
+    std::vector<ScalingResult> BenchmarkScaling(unsigned maxWorkers)
+    {
+        JM_PROFILE_ZONE("Jobs Benchmark");
+        if (maxWorkers == 0) {
+            maxWorkers = std::thread::hardware_concurrency();
+            if (maxWorkers == 0) maxWorkers = 4;
+        }
+
+        constexpr size_t kSize = 2048;
+        constexpr int kTiny = 100000;
+        constexpr int kStages = 64, kWidth = 64;
+
+        std::vector<ScalingResult> results;
+        std::vector<uint64_t> rowSums(kSize);
+        for (unsigned w = 1; w <= maxWorkers; ++w) {
+            Scheduler s;
+            s.Init(w);
+            ScalingResult r;
+            r.workers = w;
+
+            auto t0 = std::chrono::steady_clock::now();
+            s.For(0, kSize, 16, [&](size_t y0, size_t y1) {
+                for (size_t y = y0; y < y1; ++y) {
+                    uint64_t sum = 0;
+                    for (size_t x = 0; x < kSize; ++x) sum += HashNoise((uint32_t)x, (uint32_t)y) >> 24;
+                    rowSums[y] = sum;
+                }
+            });
+            r.forMs = MsSince(t0);
+            for (uint64_t v : rowSums) r.checksum += v;
+
+            std::atomic<uint64_t> sink{ 0 };
+            t0 = std::chrono::steady_clock::now();
+            {
+                Counter c;
+                for (int i = 0; i < kTiny; ++i) s.Run([&sink] { sink.fetch_add(1, std::memory_order_relaxed); }, &c);
+                s.Wait(c);
+            }
+            r.tinyNsPerJob = MsSince(t0) * 1e6 / kTiny;
+
+            t0 = std::chrono::steady_clock::now();
+            {
+                std::vector<std::unique_ptr<Counter>> stages;
+                for (int k = 0; k < kStages; ++k) stages.push_back(std::make_unique<Counter>());
+                for (int i = 0; i < kWidth; ++i)
+                    s.Run([&sink, i] { sink.fetch_add(HashNoise(i, 0) & 1, std::memory_order_relaxed); }, stages[0].get());
+                for (int k = 1; k < kStages; ++k)
+                    for (int i = 0; i < kWidth; ++i)
+                        s.Then(*stages[k - 1], [&sink, i, k] { sink.fetch_add(HashNoise(i, k) & 1, std::memory_order_relaxed); }, stages[k].get());
+                s.Wait(*stages.back());
+                for (auto& c : stages) s.Wait(*c);      // ı   
+            }
+            r.graphMs = MsSince(t0);
+
+            s.Shutdown();
+            r.speedup = results.empty() ? 1.0 : results.front().forMs / std::max(r.forMs, 1e-6);
+            results.push_back(r);
+        }
+        return results;
+    }
+
+    StressResult StressTest(unsigned workers, int rounds)
+    {
+        JM_PROFILE_ZONE("Jobs Stress");
+        StressResult res;
+        const auto t0 = std::chrono::steady_clock::now();
+        auto fail = [&](const char* what) { if (res.ok) { res.ok = false; res.firstError = what; } };
+
+        for (int round = 0; round < rounds && res.ok; ++round) {
+            Scheduler s;
+            s.Init(workers);
+
+            // 1) For:  ε Ȯ  ,   begin + k*grain
+            {
+                const size_t begin = 5, end = 5 + 20011, grain = 7;
+                std::vector<std::atomic<uint8_t>> hits(end);
+                std::atomic<bool> badChunk{ false };
+                s.For(begin, end, grain, [&](size_t b, size_t e) {
+                    if ((b - begin) % grain != 0 || e - b > grain) badChunk = true;
+                    for (size_t i = b; i < e; ++i) hits[i].fetch_add(1, std::memory_order_relaxed);
+                });
+                for (size_t i = 0; i < end; ++i)
+                    if (hits[i].load() != (i >= begin ? 1 : 0)) { fail("For: index not visited exactly once"); break; }
+                if (badChunk) fail("For: chunk boundary mismatch");
+            }
+
+            // 2) ø For ( Wait ٸ ۾ ;  )
+            {
+                std::atomic<uint64_t> sum{ 0 };
+                s.For(0, 64, 1, [&](size_t a, size_t b) {
+                    for (size_t o = a; o < b; ++o)
+                        s.For(0, 256, 16, [&](size_t x, size_t y) {
+                            uint64_t local = 0;
+                            for (size_t i = x; i < y; ++i) local += i;
+                            sum.fetch_add(local, std::memory_order_relaxed);
+                        });
+                });
+                if (sum.load() != 64ull * (255 * 256 / 2)) fail("nested For: wrong sum");
+            }
+
+            // 3)  : ۾ ڽ ۾   īͷ ( 4096)
+            {
+                std::atomic<int> leaves{ 0 };
+                Counter c;
+                std::function<void(int)> spawn = [&](int depth) {
+                    if (depth == 0) { leaves.fetch_add(1, std::memory_order_relaxed); return; }
+                    s.Run([&, depth] { spawn(depth - 1); }, &c);
+                    s.Run([&, depth] { spawn(depth - 1); }, &c);
+                };
+                s.Run([&] { spawn(12); }, &c);
+                s.Wait(c);
+                if (leaves.load() != 4096) fail("recursive spawn: leaf count");
+            }
+
+            // 4) Then : kܰ ۾ k-1ܰ谡   ڿ
+            {
+                constexpr int kStages = 32, kWidth = 8;
+                std::vector<std::atomic<int>> done(kStages);
+                std::atomic<bool> early{ false };
+                std::vector<std::unique_ptr<Counter>> stages;
+                for (int k = 0; k < kStages; ++k) stages.push_back(std::make_unique<Counter>());
+                for (int k = 0; k < kStages; ++k)
+                    for (int i = 0; i < kWidth; ++i) {
+                        auto body = [&, k] {
+                            if (k > 0 && done[k - 1].load() != kWidth) early = true;
+                            done[k].fetch_add(1);
+                        };
+                        if (k == 0) s.Run(body, stages[0].get());
+                        else s.Then(*stages[k - 1], body, stages[k].get());
+                    }
+                for (auto& c : stages) s.Wait(*c);
+                if (early) fail("Then: ran before dependency");
+                for (int k = 0; k < kStages; ++k)
+                    if (done[k].load() != kWidth) { fail("Then: stage incomplete"); break; }
+            }
+
+            // 5) Ŀ ƴ    ( ť)
+            {
+                std::atomic<int> count{ 0 };
+                std::vector<std::thread> ext;
+                for (int t = 0; t < 2; ++t)
+                    ext.emplace_back([&] {
+                        Counter c;
+                        for (int i = 0; i < 500; ++i) s.Run([&count] { count.fetch_add(1); }, &c);
+                        s.Wait(c);
+                    });
+                for (auto& t : ext) t.join();
+                if (count.load() != 1000) fail("external submit: count");
+            }
+
+            // 6)  ĥ ŭ   (ģ ۾  ڸ )
+            {
+                std::atomic<int> count{ 0 };
+                Counter c;
+                for (int i = 0; i < 10000; ++i) s.Run([&count] { count.fetch_add(1, std::memory_order_relaxed); }, &c);
+                s.Wait(c);
+                if (count.load() != 10000) fail("overflow: count");
+            }
+
+            const Stats st = s.GetStats();
+            for (const WorkerStats& w : st.workers) res.jobs += w.executed;
+            res.jobs += st.external;
+            s.Shutdown();
+        }
+
+        res.ms = MsSince(t0);
+        return res;
+    }
+
+} // namespace Jobs
@@ -0,0 +1,161 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// ۾ ġ ٷ
+// Ŀ Chase-Lev :  Ʒ ְ/ (LIFO, ĳ ģȭ), ٸ Ŀ  ģ (FIFO)
+// Ŀ ƴ ( δ )  ۾   ť
+// Init θ 尡 0 Ŀ:   ʰ Wait ߿  ´
+// ٸ   ʰ ٸ ۾  ó (ø For  )
+namespace Jobs {
+
+    using Task = std::function<void()>;
+    struct Job;
+
+    //  ī: ۾   +1,   -1
+    // 0 Ǹ Then ɾ  ļ ۾ ִ´ ()
+    // Done()   ڿ ٷ ıص  (  ī͸  ǵ帮 ʴ´)
+    class Counter {
+    public:
+        Counter() = default;
+        ~Counter();
+        Counter(const Counter&) = delete;
+        Counter& operator=(const Counter&) = delete;
+
+        bool Done() const;
+        int  Pending() const { return mCount.load(std::memory_order_acquire); }
+
+    private:
+        friend class Scheduler;
+        std::atomic<int> mCount{ 0 };
+        std::atomic<int> mBusy{ 0 };            //    ( ڰ ļ ۾  )
+        std::mutex mMutex;
+        std::vector<Job*> mThen;
+    };
+
+    struct WorkerStats {
+        uint64_t executed = 0;                  //  ۾
+        uint64_t stolen = 0;                    //  ٸ  ģ 
+    };
+
+    struct Stats {
+        std::vector<WorkerStats> workers;       // 0 = Init 
+        uint64_t injected = 0;                  // Ŀ ƴ 尡  ۾
+        uint64_t external = 0;                  // Ŀ ƴ 尡  ó ۾
+        uint64_t inlined = 0;                   //    ִ ڸ ٷ 
+    };
+
+    class Scheduler {
+    public:
+        Scheduler();
+        ~Scheduler();
+        Scheduler(const Scheduler&) = delete;
+        Scheduler& operator=(const Scheduler&) = delete;
+
+        // workers: ȣ   (0 = ϵ  )
+        void Init(unsigned workers = 0);
+        //  ۾  ó  Ŀ . Init θ 忡
+        void Shutdown();
+        bool Running() const { return mRunning.load(std::memory_order_acquire); }
+        unsigned WorkerCount() const { return (unsigned)mWorkers.size(); }
+
+        //   ƴϸ  ڸ 
+        void Run(Task fn, Counter* c = nullptr);
+        // dep 0 Ǹ fn ִ´ (̹ 0̸ ٷ). c  +1
+        void Then(Counter& dep, Task fn, Counter* c = nullptr);
+        // c 0   ٸ ۾ óϸ ٸ
+        void Wait(Counter& c);
+
+        // [begin, end) grain ũ  (begin + k*grain )  fn(b, e).   ݺ 
+        void For(size_t begin, size_t end, size_t grain, std::function<void(size_t, size_t)> fn, Counter& c);
+        void For(size_t begin, size_t end, size_t grain, std::function<void(size_t, size_t)> fn)
+        {
+            Counter c;
+            For(begin, end, grain, std::move(fn), c);
+            Wait(c);
+        }
+
+        Stats GetStats() const;
+        void ResetStats();
+
+    private:
+        struct Worker;
+        using RangeFn = std::shared_ptr<const std::function<void(size_t, size_t)>>;
+
+        void Push(Job* j);
+        Job* Find(int self, bool& stolen);      //     ť  ġ
+        void Execute(Job* j, int self, bool stolen);
+        void Finish(Counter* c);
+        void Split(size_t begin, size_t end, size_t grain, size_t c0, size_t c1, const RangeFn& fn, Counter* c);
+        void WorkerLoop(int index);
+        int  Self() const;                      //  ٷ Ŀ ȣ, ƴϸ -1
+
+        std::vector<std::unique_ptr<Worker>> mWorkers;
+        std::atomic<bool> mRunning{ false };
+        std::atomic<bool> mStop{ false };
+        std::atomic<int64_t> mOutstanding{ 0 }; // ־    ۾ (Shutdown  )
+
+        mutable std::mutex mInjectMutex;
+        std::vector<Job*> mInject;              // FIFO  (տ)
+        size_t mInjectHead = 0;
+        std::atomic<size_t> mInjectCount{ 0 };
+
+        //  Ŀ :   epoch +1,  Ŀ  notify
+        std::mutex mSleepMutex;
+        std::condition_variable mWake;
+        std::atomic<uint64_t> mEpoch{ 0 };
+        std::atomic<int> mSleepers{ 0 };
+
+        std::atomic<uint64_t> mInjected{ 0 }, mExternal{ 0 }, mInlined{ 0 };
+        const Scheduler* mPrevOwner = nullptr;  // Init   Ҽ (ġũ ٷ  )
+        int mPrevIndex = -1;
+    };
+
+    //  ٷ (InitAll Init). Ʒ Լ ̰ 
+    Scheduler& Default();
+    inline void Init(unsigned workers = 0) { Default().Init(workers); }
+    inline void Shutdown() { Default().Shutdown(); }
+    inline bool Running() { return Default().Running(); }
+    inline void Run(Task fn, Counter* c = nullptr) { Default().Run(std::move(fn), c); }
+    inline void Then(Counter& dep, Task fn, Counter* c = nullptr) { Default().Then(dep, std::move(fn), c); }
+    inline void Wait(Counter& c) { Default().Wait(c); }
+    inline void For(size_t begin, size_t end, size_t grain, std::function<void(size_t, size_t)> fn, Counter& c)
+    {
+        Default().For(begin, end, grain, std::move(fn), c);
+    }
+    inline void For(size_t begin, size_t end, size_t grain, std::function<void(size_t, size_t)> fn)
+    {
+        Default().For(begin, end, grain, std::move(fn));
+    }
+
+    //    ť (̽/ؽƮ ȣ). ƹ 忡 ְ,   PumpMain 
+    void RunOnMain(Task fn);
+    size_t PumpMain();                          // ȯ:  
+
+    // 1..maxWorkers Ŀ  ó ð (ٷ   , Default )
+    struct ScalingResult {
+        unsigned workers = 0;
+        double forMs = 0.0;                     //   For ( 2048x2048, 16 )
+        double tinyNsPerJob = 0.0;              //  ۾ 10  (ٷ )
+        double graphMs = 0.0;                   // Then  64ܰ x 64۾
+        double speedup = 0.0;                   // For: 1Ŀ 
+        uint64_t checksum = 0;
+    };
+    std::vector<ScalingResult> BenchmarkScaling(unsigned maxWorkers = 0);
+
+    // Ʈ: ø For/ /Then /ܺ  /Init-Shutdown ݺ 
+    struct StressResult {
+        bool ok = true;
+        uint64_t jobs = 0;
+        double ms = 0.0;
+        const char* firstError = "";
+    };
+    StressResult StressTest(unsigned workers = 0, int rounds = 20);
+
+} // namespace Jobs
@@ -0,0 +1,91 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile& MappedFile::operator=(MappedFile&& o) noexcept
+{
+    if (this == &o) return *this;
+    Close();
+    mData = o.mData; mSize = o.mSize;
+    o.mData = nullptr; o.mSize = 0;
+#ifdef _WIN32
+    mFile = o.mFile; mMapping = o.mMapping;
+    o.mFile = nullptr; o.mMapping = nullptr;
+#else
+    mFd = o.mFd; o.mFd = -1;
+#endif
+    return *this;
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::filesystem::path& path)
+{
+    Close();
+    HANDLE f = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (f == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER sz{};
+    if (!GetFileSizeEx(f, &sz) || sz.QuadPart == 0) { CloseHandle(f); return false; }
+
+    HANDLE m = CreateFileMappingW(f, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m) { CloseHandle(f); return false; }
+
+    void* p = MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0);
+    if (!p) { CloseHandle(m); CloseHandle(f); return false; }
+
+    mFile = f; mMapping = m;
+    mData = (const uint8_t*)p;
+    mSize = (size_t)sz.QuadPart;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (mData) UnmapViewOfFile(mData);
+    if (mMapping) CloseHandle((HANDLE)mMapping);
+    if (mFile) CloseHandle((HANDLE)mFile);
+    mData = nullptr; mSize = 0;
+    mFile = mMapping = nullptr;
+}
+
+#else
+
+bool MappedFile::Open(const std::filesystem::path& path)
+{
+    Close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st {};
+    if (fstat(fd, &st) != 0 || st.st_size == 0) { ::close(fd); return false; }
+
+    void* p = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED) { ::close(fd); return false; }
+    madvise(p, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+    mFd = fd;
+    mData = (const uint8_t*)p;
+    mSize = (size_t)st.st_size;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (mData) munmap((void*)mData, mSize);
+    if (mFd >= 0) ::close(mFd);
+    mData = nullptr; mSize = 0;
+    mFd = -1;
+}
+
+#endif
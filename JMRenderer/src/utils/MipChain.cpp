@@ -0,0 +1,249 @@
+#include "MipChain.h"
+#include "Parallel.h"
+#include "Simd.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+//  sRGB ȯ ̺ 
+static double SrgbToLinear(double s) { return s <= 0.04045 ? s / 12.92 : std::pow((s + 0.055) / 1.055, 2.4); }
+static double LinearToSrgb(double l) { return l <= 0.0031308 ? l * 12.92 : 1.055 * std::pow(l, 1.0 / 2.4) - 0.055; }
+
+struct SrgbTables {
+    float   toLinear[256];
+    uint8_t toSrgb[65536];      //   * 65535 ε
+    SrgbTables() {
+        for (int i = 0; i < 256; ++i) toLinear[i] = (float)SrgbToLinear(i / 255.0);
+        for (int i = 0; i < 65536; ++i)
+            toSrgb[i] = (uint8_t)std::lround(std::min(1.0, std::max(0.0, LinearToSrgb(i / 65535.0))) * 255.0);
+    }
+};
+
+static const SrgbTables& Srgb()
+{
+    static const SrgbTables t;
+    return t;
+}
+
+//    : r0/r1 ҽ  , sw ҽ  
+static void RowScalar(const uint8_t* r0, const uint8_t* r1, uint8_t* dst, unsigned x0, unsigned dw,
+    unsigned sw, unsigned ch, MipFilter f)
+{
+    const SrgbTables* t = (f == MipFilter::SRGB) ? &Srgb() : nullptr;
+    for (unsigned x = x0; x < dw; ++x) {
+        const unsigned a = std::min(2 * x, sw - 1) * ch, b = std::min(2 * x + 1, sw - 1) * ch;
+        for (unsigned c = 0; c < ch; ++c) {
+            const unsigned p = r0[a + c], q = r0[b + c], r = r1[a + c], s = r1[b + c];
+            uint8_t v;
+            switch (f) {
+            case MipFilter::Min: v = (uint8_t)std::min(std::min(p, q), std::min(r, s)); break;
+            case MipFilter::Max: v = (uint8_t)std::max(std::max(p, q), std::max(r, s)); break;
+            case MipFilter::SRGB:
+                if (c != 3) {
+                    float l = (t->toLinear[p] + t->toLinear[q] + t->toLinear[r] + t->toLinear[s]) * 0.25f;
+                    v = t->toSrgb[(int)(l * 65535.0f + 0.5f)];
+                    break;
+                }
+                v = (uint8_t)((p + q + r + s + 2) >> 2); // Ĵ 
+                break;
+            default: v = (uint8_t)((p + q + r + s + 2) >> 2); break;
+            }
+            dst[x * ch + c] = v;
+        }
+    }
+}
+
+#if JM_SIMD_X86
+// SSE2 (x64 ⺻): Linear/Min/Max, ȯ ó  ȼ 
+static unsigned RowSSE2(const uint8_t* r0, const uint8_t* r1, uint8_t* dst, unsigned dw, unsigned ch, MipFilter f)
+{
+    const __m128i z = _mm_setzero_si128();
+    const __m128i lo8 = _mm_set1_epi16(0x00FF);
+    const __m128i two = _mm_set1_epi16(2);
+    unsigned x = 0;
+
+    if (ch == 4) {
+        // ҽ 4ȼ(16B) x 2   2ȼ
+        for (; x + 2 <= dw; x += 2) {
+            __m128i a = _mm_loadu_si128((const __m128i*)(r0 + x * 8));
+            __m128i b = _mm_loadu_si128((const __m128i*)(r1 + x * 8));
+            if (f == MipFilter::Linear) {
+                __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, z), _mm_unpacklo_epi8(b, z));
+                __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, z), _mm_unpackhi_epi8(b, z));
+                __m128i s = _mm_unpacklo_epi64(_mm_add_epi16(lo, _mm_srli_si128(lo, 8)),
+                    _mm_add_epi16(hi, _mm_srli_si128(hi, 8)));
+                s = _mm_srli_epi16(_mm_add_epi16(s, two), 2);
+                _mm_storel_epi64((__m128i*)(dst + x * 4), _mm_packus_epi16(s, s));
+            }
+            else {
+                __m128i m = (f == MipFilter::Min) ? _mm_min_epu8(a, b) : _mm_max_epu8(a, b);
+                __m128i h = _mm_srli_epi64(m, 32);
+                m = (f == MipFilter::Min) ? _mm_min_epu8(m, h) : _mm_max_epu8(m, h);
+                _mm_storel_epi64((__m128i*)(dst + x * 4), _mm_shuffle_epi32(m, _MM_SHUFFLE(3, 1, 2, 0)));
+            }
+        }
+    }
+    else {
+        // ҽ 16ȼ x 2   8ȼ
+        for (; x + 8 <= dw; x += 8) {
+            __m128i a = _mm_loadu_si128((const __m128i*)(r0 + x * 2));
+            __m128i b = _mm_loadu_si128((const __m128i*)(r1 + x * 2));
+            __m128i v;
+            if (f == MipFilter::Linear) {
+                __m128i s = _mm_add_epi16(_mm_add_epi16(_mm_and_si128(a, lo8), _mm_srli_epi16(a, 8)),
+                    _mm_add_epi16(_mm_and_si128(b, lo8), _mm_srli_epi16(b, 8)));
+                v = _mm_srli_epi16(_mm_add_epi16(s, two), 2);
+            }
+            else if (f == MipFilter::Min) {
+                __m128i m = _mm_min_epu8(a, b);
+                v = _mm_min_epi16(_mm_and_si128(m, lo8), _mm_srli_epi16(m, 8));
+            }
+            else {
+                __m128i m = _mm_max_epu8(a, b);
+                v = _mm_max_epi16(_mm_and_si128(m, lo8), _mm_srli_epi16(m, 8));
+            }
+            _mm_storel_epi64((__m128i*)(dst + x), _mm_packus_epi16(v, v));
+        }
+    }
+    return x;
+}
+#endif
+
+static void DownsampleLevel(const MipLevel& s, const MipLevel& d, uint8_t* dData, unsigned ch, MipFilter f)
+{
+    const size_t rowBytes = (size_t)d.width * ch;
+    const size_t grain = std::max<size_t>(1, (64 * 1024) / std::max<size_t>(rowBytes, 1));
+
+    Parallel::For(0, d.height, grain, [&](size_t y0, size_t y1) {
+        for (size_t y = y0; y < y1; ++y) {
+            const uint8_t* r0 = s.data + std::min<size_t>(2 * y, s.height - 1) * s.rowPitch;
+            const uint8_t* r1 = s.data + std::min<size_t>(2 * y + 1, s.height - 1) * s.rowPitch;
+            uint8_t* dst = dData + y * d.rowPitch;
+            unsigned x = 0;
+#if JM_SIMD_X86
+            // ҽ  1̸  Ŭ ʿ Į
+            if (f != MipFilter::SRGB && s.width > 1) x = RowSSE2(r0, r1, dst, d.width, ch, f);
+#endif
+            RowScalar(r0, r1, dst, x, d.width, s.width, ch, f);
+        }
+    });
+}
+
+namespace Mip {
+
+    unsigned LevelCount(unsigned w, unsigned h)
+    {
+        unsigned n = 1;
+        while (w > 1 || h > 1) { w = std::max(1u, w >> 1); h = std::max(1u, h >> 1); ++n; }
+        return n;
+    }
+
+    void Build(const uint8_t* src, unsigned w, unsigned h, size_t rowPitch, unsigned channels,
+        MipFilter filter, MipChain& out)
+    {
+        out.channels = channels;
+        out.levels.clear();
+        out.storage.clear();
+        out.levels.push_back({ w, h, rowPitch, src });
+        if (filter == MipFilter::None || !src || w == 0 || h == 0) return;
+
+        //  ġ      Ҵ
+        const unsigned count = LevelCount(w, h);
+        std::vector<size_t> offsets;
+        size_t total = 0;
+        unsigned lw = w, lh = h;
+        for (unsigned i = 1; i < count; ++i) {
+            lw = std::max(1u, lw >> 1); lh = std::max(1u, lh >> 1);
+            offsets.push_back(total);
+            total += (size_t)lw * lh * channels;
+            out.levels.push_back({ lw, lh, (size_t)lw * channels, nullptr });
+        }
+        out.storage.resize(total);
+        for (unsigned i = 1; i < count; ++i) out.levels[i].data = out.storage.data() + offsets[i - 1];
+
+        for (unsigned i = 1; i < count; ++i)
+            DownsampleLevel(out.levels[i - 1], out.levels[i], out.storage.data() + offsets[i - 1], channels, filter);
+    }
+
+    void ResizeWrap(const uint8_t* src, unsigned w, unsigned h, size_t rowPitch, unsigned ch,
+        unsigned dw, unsigned dh, std::vector<uint8_t>& dst)
+    {
+        dst.assign((size_t)dw * dh * ch, 0);
+        if (!src || !w || !h || !dw || !dh) return;
+
+        const float sx = (float)w / dw, sy = (float)h / dh;
+        Parallel::For(0, dh, 64, [&](size_t y0, size_t y1) {
+            for (size_t y = y0; y < y1; ++y) {
+                const float fy = (y + 0.5f) * sy - 0.5f;
+                const int iy = (int)std::floor(fy);
+                const float ty = fy - iy;
+                const uint8_t* r0 = src + (size_t)((iy + (int)h) % (int)h) * rowPitch;
+                const uint8_t* r1 = src + (size_t)((iy + 1) % (int)h) * rowPitch;
+                uint8_t* d = dst.data() + y * dw * ch;
+                for (unsigned x = 0; x < dw; ++x) {
+                    const float fx = (x + 0.5f) * sx - 0.5f;
+                    const int ix = (int)std::floor(fx);
+                    const float tx = fx - ix;
+                    const size_t a = (size_t)((ix + (int)w) % (int)w) * ch, b = (size_t)((ix + 1) % (int)w) * ch;
+                    for (unsigned c = 0; c < ch; ++c) {
+                        const float top = r0[a + c] + (r0[b + c] - r0[a + c]) * tx;
+                        const float bot = r1[a + c] + (r1[b + c] - r1[a + c]) * tx;
+                        d[x * ch + c] = (uint8_t)(top + (bot - top) * ty + 0.5f);
+                    }
+                }
+            }
+        });
+    }
+
+    void DownsampleReference(const uint8_t* src, unsigned w, unsigned h, size_t rowPitch,
+        unsigned ch, MipFilter f, std::vector<uint8_t>& dst)
+    {
+        const unsigned dw = std::max(1u, w >> 1), dh = std::max(1u, h >> 1);
+        dst.assign((size_t)dw * dh * ch, 0);
+        for (unsigned y = 0; y < dh; ++y) {
+            for (unsigned x = 0; x < dw; ++x) {
+                for (unsigned c = 0; c < ch; ++c) {
+                    double acc = 0.0, lo = 255.0, hi = 0.0;
+                    for (unsigned k = 0; k < 4; ++k) {
+                        unsigned sx = std::min(2 * x + (k & 1), w - 1), sy = std::min(2 * y + (k >> 1), h - 1);
+                        double v = src[sy * rowPitch + sx * ch + c];
+                        lo = std::min(lo, v); hi = std::max(hi, v);
+                        acc += (f == MipFilter::SRGB && c != 3) ? SrgbToLinear(v / 255.0) : v;
+                    }
+                    double r;
+                    if (f == MipFilter::Min) r = lo;
+                    else if (f == MipFilter::Max) r = hi;
+                    else if (f == MipFilter::SRGB && c != 3) r = LinearToSrgb(acc * 0.25) * 255.0;
+                    else r = acc * 0.25;
+                    dst[((size_t)y * dw + x) * ch + c] = (uint8_t)std::floor(r + 0.5);
+                }
+            }
+        }
+    }
+
+    CheckResult SelfCheck(unsigned w, unsigned h, unsigned channels, MipFilter filter)
+    {
+        std::vector<uint8_t> img((size_t)w * h * channels);
+        std::mt19937 rng(7);
+        for (auto& b : img) b = (uint8_t)(rng() & 0xFF);
+
+        CheckResult r;
+        MipChain chain;
+        auto t0 = std::chrono::steady_clock::now();
+        Build(img.data(), w, h, (size_t)w * channels, channels, filter, chain);
+        r.buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        r.bytes = chain.StorageBytes();
+
+        std::vector<uint8_t> ref;
+        for (size_t i = 1; i < chain.levels.size(); ++i) {
+            const MipLevel& s = chain.levels[i - 1];
+            const MipLevel& d = chain.levels[i];
+            DownsampleReference(s.data, s.width, s.height, s.rowPitch, channels, filter, ref);
+            for (size_t k = 0; k < ref.size(); ++k)
+                r.maxError = std::max(r.maxError, std::abs((int)ref[k] - (int)d.data[k]));
+        }
+        return r;
+    }
+
+} // namespace Mip
@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// CPU ü  (D3D  )
+//   ũ D3D Ģ(max(1, w >> 1))  2x2 ڽ ͷ δ
+
+enum class MipFilter {
+    None,       //   ( 0)
+    Linear,     // äκ  (/)
+    SRGB,       //     sRGB ڵ (˺, Ĵ )
+    Min,        // 2x2 ּڰ (̸  )
+    Max,        // 2x2 ִ (̸  )
+};
+
+struct MipLevel {
+    unsigned width = 0, height = 0;
+    size_t rowPitch = 0;
+    const uint8_t* data = nullptr;
+};
+
+struct MipChain {
+    unsigned channels = 4;                 // 1 (R8) Ǵ 4 (RGBA8/BGRA8)
+    std::vector<MipLevel> levels;          // levels[0]  Ų( )
+    std::vector<uint8_t> storage;          //  1 ̻
+
+    size_t StorageBytes() const { return storage.size(); }
+};
+
+namespace Mip {
+
+    unsigned LevelCount(unsigned w, unsigned h);
+
+    // src out ̴   ־ Ѵ ( 0 src Ŵ)
+    //    ھ  ó
+    void Build(const uint8_t* src, unsigned w, unsigned h, size_t rowPitch, unsigned channels,
+        MipFilter filter, MipChain& out);
+
+    // ̸Ͼ  (ڸ ) -   4   
+    void ResizeWrap(const uint8_t* src, unsigned w, unsigned h, size_t rowPitch, unsigned channels,
+        unsigned dw, unsigned dh, std::vector<uint8_t>& dst);
+
+    //  ڽ  (double е,  ) - 
+    void DownsampleReference(const uint8_t* src, unsigned w, unsigned h, size_t rowPitch,
+        unsigned channels, MipFilter filter, std::vector<uint8_t>& dst);
+
+    struct CheckResult {
+        int    maxError = 0;       //  1 ̻   ִ (LSB)
+        double buildMs = 0.0;
+        size_t bytes = 0;          //   1 ̻ Ʈ
+    };
+
+    // w x h  ̹ Build ð    
+    CheckResult SelfCheck(unsigned w, unsigned h, unsigned channels, MipFilter filter);
+
+} // namespace Mip
@@ -0,0 +1,51 @@
+// src/utils/Parallel.h
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+#include "JobSystem.h"
+
+namespace Parallel {
+
+    inline unsigned WorkerCount()
+    {
+        unsigned n = std::thread::hardware_concurrency();
+        return n ? n : 4;
+    }
+
+    // [begin, end) grain ũ    ھ fn(b, e) 
+    // ȣ 嵵 Բ ϰ, ȯ     ִ
+    // ۾ ٷ    Ŀ鿡 ѱ (  , ø ȣ⵵  Ŀ Ǯ)
+    template<class F>
+    void For(size_t begin, size_t end, size_t grain, F&& fn)
+    {
+        if (end <= begin) return;
+        grain = std::max<size_t>(grain, 1);
+        const size_t chunks = (end - begin + grain - 1) / grain;
+        if (chunks <= 1) { fn(begin, end); return; }
+        if (Jobs::Running()) {
+            Jobs::For(begin, end, grain, [&fn](size_t b, size_t e) { fn(b, e); });
+            return;
+        }
+
+        std::atomic<size_t> next{ 0 };
+        auto work = [&] {
+            for (;;) {
+                size_t c = next.fetch_add(1, std::memory_order_relaxed);
+                if (c >= chunks) break;
+                size_t b = begin + c * grain;
+                fn(b, std::min(end, b + grain));
+            }
+        };
+
+        const size_t extra = std::min<size_t>(WorkerCount(), chunks) - 1;
+        std::vector<std::thread> threads;
+        threads.reserve(extra);
+        for (size_t i = 0; i < extra; ++i) threads.emplace_back(work);
+        work();
+        for (auto& t : threads) t.join();
+    }
+
+} // namespace Parallel
@@ -0,0 +1,289 @@
+#include "PixelKernels.h"
+#include "Simd.h"
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace PixelKernels {
+
+    uint8_t ToGray(uint8_t r, uint8_t g, uint8_t b) {
+        float y = 0.299f * r + 0.587f * g + 0.114f * b;
+        int v = (int)(y + 0.5f);
+        if (v < 0) v = 0;
+        if (v > 255) v = 255;
+        return (uint8_t)v;
+    }
+
+} // namespace PixelKernels
+
+//  Į 
+static void BGRtoRGBA_Scalar(const uint8_t* src, uint8_t* dst, size_t n) {
+    for (size_t x = 0; x < n; ++x) {
+        dst[x * 4 + 0] = src[x * 3 + 2];
+        dst[x * 4 + 1] = src[x * 3 + 1];
+        dst[x * 4 + 2] = src[x * 3 + 0];
+        dst[x * 4 + 3] = 255; // 
+    }
+}
+
+static void BGRAtoRGBA_Scalar(const uint8_t* src, uint8_t* dst, size_t n) {
+    for (size_t x = 0; x < n; ++x) {
+        dst[x * 4 + 0] = src[x * 4 + 2];
+        dst[x * 4 + 1] = src[x * 4 + 1];
+        dst[x * 4 + 2] = src[x * 4 + 0];
+        dst[x * 4 + 3] = src[x * 4 + 3];
+    }
+}
+
+static void BGRtoGray_Scalar(const uint8_t* src, uint8_t* dst, size_t n) {
+    for (size_t x = 0; x < n; ++x)
+        dst[x] = PixelKernels::ToGray(src[x * 3 + 2], src[x * 3 + 1], src[x * 3 + 0]);
+}
+
+#if JM_SIMD_X86
+
+// ׷ ȯ (Ҽ):
+//   e = 299R + 587G + 114B (, Ȯ), v = floor((e + 500) / 1000)
+//    float  +  ̾ Ȯ Ѵ (e+500 <= 255500)
+//   (e + 500) 1000  (Ȯ .5) float Į  ݿø 
+//   ٸ   ־ ش ȼ Į ٽ   Į Ʈ ġ
+
+// 4ȼ(BGR 12Ʈ, 16Ʈ ε)   v Ÿ ũ
+JM_TARGET_SSSE3 static inline __m128i Gray4_SSSE3(__m128i v, __m128i& tie)
+{
+    const __m128i shBG = _mm_setr_epi8(0, -1, 1, -1, 3, -1, 4, -1, 6, -1, 7, -1, 9, -1, 10, -1);
+    const __m128i shR = _mm_setr_epi8(2, -1, -1, -1, 5, -1, -1, -1, 8, -1, -1, -1, 11, -1, -1, -1);
+    const __m128i wBG = _mm_set1_epi32((587 << 16) | 114);
+    const __m128i wR = _mm_set1_epi32(299);
+
+    __m128i e = _mm_add_epi32(_mm_madd_epi16(_mm_shuffle_epi8(v, shBG), wBG),
+        _mm_madd_epi16(_mm_shuffle_epi8(v, shR), wR));
+    __m128i n = _mm_add_epi32(e, _mm_set1_epi32(500));
+    __m128i q = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(n), _mm_set1_ps(0.001f)),
+        _mm_set1_ps(0.0001f)));
+    tie = _mm_cmpeq_epi32(_mm_madd_epi16(q, _mm_set1_epi32(1000)), n);
+    return q;
+}
+
+static inline void FixTies(const uint8_t* src, uint8_t* dst, uint32_t mask)
+{
+    while (mask) {
+        int k = Simd::Ctz32(mask);
+        dst[k] = PixelKernels::ToGray(src[k * 3 + 2], src[k * 3 + 1], src[k * 3 + 0]);
+        mask &= mask - 1;
+    }
+}
+
+//  SSSE3 
+JM_TARGET_SSSE3 static void BGRtoRGBA_SSSE3(const uint8_t* src, uint8_t* dst, size_t n) {
+    const __m128i sh = _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+    const __m128i a = _mm_set1_epi32((int)0xFF000000u);
+    size_t i = 0;
+    // 16Ʈ ε尡 12Ʈ Ƿ  4Ʈ  ʿ
+    for (; i + 18 <= n; i += 16) {
+        const uint8_t* s = src + i * 3;
+        __m128i p0 = _mm_loadu_si128((const __m128i*)(s + 0));
+        __m128i p1 = _mm_loadu_si128((const __m128i*)(s + 12));
+        __m128i p2 = _mm_loadu_si128((const __m128i*)(s + 24));
+        __m128i p3 = _mm_loadu_si128((const __m128i*)(s + 36));
+        _mm_storeu_si128((__m128i*)(dst + i * 4 + 0), _mm_or_si128(_mm_shuffle_epi8(p0, sh), a));
+        _mm_storeu_si128((__m128i*)(dst + i * 4 + 16), _mm_or_si128(_mm_shuffle_epi8(p1, sh), a));
+        _mm_storeu_si128((__m128i*)(dst + i * 4 + 32), _mm_or_si128(_mm_shuffle_epi8(p2, sh), a));
+        _mm_storeu_si128((__m128i*)(dst + i * 4 + 48), _mm_or_si128(_mm_shuffle_epi8(p3, sh), a));
+    }
+    for (; i + 6 <= n; i += 4) {
+        __m128i p = _mm_loadu_si128((const __m128i*)(src + i * 3));
+        _mm_storeu_si128((__m128i*)(dst + i * 4), _mm_or_si128(_mm_shuffle_epi8(p, sh), a));
+    }
+    BGRtoRGBA_Scalar(src + i * 3, dst + i * 4, n - i);
+}
+
+JM_TARGET_SSSE3 static void BGRAtoRGBA_SSSE3(const uint8_t* src, uint8_t* dst, size_t n) {
+    const __m128i sh = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i p = _mm_loadu_si128((const __m128i*)(src + i * 4));
+        _mm_storeu_si128((__m128i*)(dst + i * 4), _mm_shuffle_epi8(p, sh));
+    }
+    BGRAtoRGBA_Scalar(src + i * 4, dst + i * 4, n - i);
+}
+
+JM_TARGET_SSSE3 static void BGRtoGray_SSSE3(const uint8_t* src, uint8_t* dst, size_t n) {
+    size_t i = 0;
+    for (; i + 10 <= n; i += 8) {
+        const uint8_t* s = src + i * 3;
+        __m128i t0, t1;
+        __m128i q0 = Gray4_SSSE3(_mm_loadu_si128((const __m128i*)(s + 0)), t0);
+        __m128i q1 = Gray4_SSSE3(_mm_loadu_si128((const __m128i*)(s + 12)), t1);
+        __m128i b = _mm_packus_epi16(_mm_packs_epi32(q0, q1), _mm_setzero_si128());
+        _mm_storel_epi64((__m128i*)(dst + i), b);
+        uint32_t tie = (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(t0))
+            | ((uint32_t)_mm_movemask_ps(_mm_castsi128_ps(t1)) << 4);
+        if (tie) FixTies(s, dst + i, tie);
+    }
+    BGRtoGray_Scalar(src + i * 3, dst + i, n - i);
+}
+
+//  AVX2 
+// 24-bit Է 128-bit θ 4ȼ (   Ƿ   ε)
+JM_TARGET_AVX2 static inline __m256i Load2x12(const uint8_t* s)
+{
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)s)),
+        _mm_loadu_si128((const __m128i*)(s + 12)), 1);
+}
+
+JM_TARGET_AVX2 static void BGRtoRGBA_AVX2(const uint8_t* src, uint8_t* dst, size_t n) {
+    const __m256i sh = _mm256_setr_epi8(
+        2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1,
+        2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+    const __m256i a = _mm256_set1_epi32((int)0xFF000000u);
+    size_t i = 0;
+    for (; i + 18 <= n; i += 16) {
+        const uint8_t* s = src + i * 3;
+        __m256i p0 = Load2x12(s);
+        __m256i p1 = Load2x12(s + 24);
+        _mm256_storeu_si256((__m256i*)(dst + i * 4 + 0), _mm256_or_si256(_mm256_shuffle_epi8(p0, sh), a));
+        _mm256_storeu_si256((__m256i*)(dst + i * 4 + 32), _mm256_or_si256(_mm256_shuffle_epi8(p1, sh), a));
+    }
+    BGRtoRGBA_SSSE3(src + i * 3, dst + i * 4, n - i);
+}
+
+JM_TARGET_AVX2 static void BGRAtoRGBA_AVX2(const uint8_t* src, uint8_t* dst, size_t n) {
+    const __m256i sh = _mm256_setr_epi8(
+        2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+        2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i p0 = _mm256_loadu_si256((const __m256i*)(src + i * 4));
+        __m256i p1 = _mm256_loadu_si256((const __m256i*)(src + i * 4 + 32));
+        _mm256_storeu_si256((__m256i*)(dst + i * 4), _mm256_shuffle_epi8(p0, sh));
+        _mm256_storeu_si256((__m256i*)(dst + i * 4 + 32), _mm256_shuffle_epi8(p1, sh));
+    }
+    BGRAtoRGBA_SSSE3(src + i * 4, dst + i * 4, n - i);
+}
+
+JM_TARGET_AVX2 static inline __m256i Gray8_AVX2(__m256i v, uint32_t& tieMask)
+{
+    const __m256i shBG = _mm256_setr_epi8(
+        0, -1, 1, -1, 3, -1, 4, -1, 6, -1, 7, -1, 9, -1, 10, -1,
+        0, -1, 1, -1, 3, -1, 4, -1, 6, -1, 7, -1, 9, -1, 10, -1);
+    const __m256i shR = _mm256_setr_epi8(
+        2, -1, -1, -1, 5, -1, -1, -1, 8, -1, -1, -1, 11, -1, -1, -1,
+        2, -1, -1, -1, 5, -1, -1, -1, 8, -1, -1, -1, 11, -1, -1, -1);
+    const __m256i wBG = _mm256_set1_epi32((587 << 16) | 114);
+    const __m256i wR = _mm256_set1_epi32(299);
+
+    __m256i e = _mm256_add_epi32(_mm256_madd_epi16(_mm256_shuffle_epi8(v, shBG), wBG),
+        _mm256_madd_epi16(_mm256_shuffle_epi8(v, shR), wR));
+    __m256i n = _mm256_add_epi32(e, _mm256_set1_epi32(500));
+    __m256i q = _mm256_cvttps_epi32(_mm256_add_ps(
+        _mm256_mul_ps(_mm256_cvtepi32_ps(n), _mm256_set1_ps(0.001f)), _mm256_set1_ps(0.0001f)));
+    __m256i tie = _mm256_cmpeq_epi32(_mm256_madd_epi16(q, _mm256_set1_epi32(1000)), n);
+    tieMask = (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(tie));
+    return q;
+}
+
+JM_TARGET_AVX2 static void BGRtoGray_AVX2(const uint8_t* src, uint8_t* dst, size_t n) {
+    size_t i = 0;
+    for (; i + 18 <= n; i += 16) {
+        const uint8_t* s = src + i * 3;
+        uint32_t t0, t1;
+        __m256i q0 = Gray8_AVX2(Load2x12(s), t0);
+        __m256i q1 = Gray8_AVX2(Load2x12(s + 24), t1);
+        __m128i w0 = _mm_packs_epi32(_mm256_castsi256_si128(q0), _mm256_extracti128_si256(q0, 1));
+        __m128i w1 = _mm_packs_epi32(_mm256_castsi256_si128(q1), _mm256_extracti128_si256(q1, 1));
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(w0, w1));
+        uint32_t tie = t0 | (t1 << 8);
+        if (tie) FixTies(s, dst + i, tie);
+    }
+    BGRtoGray_SSSE3(src + i * 3, dst + i, n - i);
+}
+
+#endif // JM_SIMD_X86
+
+namespace PixelKernels {
+
+    Path Resolve(Path path)
+    {
+#if JM_SIMD_X86
+        const Simd::CpuFeatures& cpu = Simd::Cpu();
+        if (path == Path::Auto) path = Path::AVX2;
+        if (path == Path::AVX2 && !cpu.avx2) path = Path::SSSE3;
+        if (path == Path::SSSE3 && !cpu.ssse3) path = Path::Scalar;
+        return path;
+#else
+        (void)path;
+        return Path::Scalar;
+#endif
+    }
+
+    const char* PathName(Path path)
+    {
+        switch (path) {
+        case Path::Scalar: return "Scalar";
+        case Path::SSSE3:  return "SSSE3";
+        case Path::AVX2:   return "AVX2";
+        default:           return "Auto";
+        }
+    }
+
+    void BGRtoRGBA(const uint8_t* src, uint8_t* dst, size_t n, Path path)
+    {
+        switch (Resolve(path)) {
+#if JM_SIMD_X86
+        case Path::AVX2:  BGRtoRGBA_AVX2(src, dst, n); break;
+        case Path::SSSE3: BGRtoRGBA_SSSE3(src, dst, n); break;
+#endif
+        default:          BGRtoRGBA_Scalar(src, dst, n); break;
+        }
+    }
+
+    void BGRAtoRGBA(const uint8_t* src, uint8_t* dst, size_t n, Path path)
+    {
+        switch (Resolve(path)) {
+#if JM_SIMD_X86
+        case Path::AVX2:  BGRAtoRGBA_AVX2(src, dst, n); break;
+        case Path::SSSE3: BGRAtoRGBA_SSSE3(src, dst, n); break;
+#endif
+        default:          BGRAtoRGBA_Scalar(src, dst, n); break;
+        }
+    }
+
+    void BGRtoGray(const uint8_t* src, uint8_t* dst, size_t n, Path path)
+    {
+        switch (Resolve(path)) {
+#if JM_SIMD_X86
+        case Path::AVX2:  BGRtoGray_AVX2(src, dst, n); break;
+        case Path::SSSE3: BGRtoGray_SSSE3(src, dst, n); break;
+#endif
+        default:          BGRtoGray_Scalar(src, dst, n); break;
+        }
+    }
+
+    BenchResult Benchmark(unsigned w, unsigned h, Path path, int iterations)
+    {
+        const size_t n = (size_t)w * h;
+        std::vector<uint8_t> src(n * 4), dst(n * 4), ref(n * 4);
+        std::mt19937 rng(42);
+        for (auto& b : src) b = (uint8_t)(rng() & 0xFF);
+        iterations = iterations < 1 ? 1 : iterations;
+
+        BenchResult r;
+        auto measure = [&](auto fn, size_t srcBytes, size_t dstBytes) {
+            fn(src.data(), ref.data(), n, Path::Scalar);
+            auto t0 = std::chrono::steady_clock::now();
+            for (int it = 0; it < iterations; ++it) fn(src.data(), dst.data(), n, path);
+            auto t1 = std::chrono::steady_clock::now();
+            if (std::memcmp(dst.data(), ref.data(), dstBytes) != 0)
+                for (size_t i = 0; i < dstBytes; ++i) r.mismatches += dst[i] != ref[i];
+            double s = std::chrono::duration<double>(t1 - t0).count() / iterations;
+            return s > 0.0 ? (double)srcBytes / s * 1e-9 : 0.0;
+        };
+        r.rgbGBs = measure(BGRtoRGBA, n * 3, n * 4);
+        r.rgbaGBs = measure(BGRAtoRGBA, n * 4, n * 4);
+        r.grayGBs = measure(BGRtoGray, n * 3, n);
+        return r;
+    }
+
+} // namespace PixelKernels
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// ؽó δ ȼ ȯ Ŀ (SSSE3/AVX2 + Į)
+//  δ Į  Ʈ  
+namespace PixelKernels {
+
+    enum class Path { Auto, Scalar, SSSE3, AVX2 };
+
+    // n ȼ ȯ. src/dst ġ  ȴ
+    void BGRtoRGBA(const uint8_t* src, uint8_t* dst, size_t n, Path path = Path::Auto);   // 24  32bit, A=255
+    void BGRAtoRGBA(const uint8_t* src, uint8_t* dst, size_t n, Path path = Path::Auto);  // 32  32bit
+    void BGRtoGray(const uint8_t* src, uint8_t* dst, size_t n, Path path = Path::Auto);   // 24bit  R8
+
+    //  BMP δ ׷ ȯ (0.299, 0.587, 0.114, ݿø)
+    uint8_t ToGray(uint8_t r, uint8_t g, uint8_t b);
+
+    Path Resolve(Path path);
+    const char* PathName(Path path);
+
+    struct BenchResult {
+        double rgbGBs = 0.0;    // BGRRGBA (ҽ Ʈ  GB/s)
+        double rgbaGBs = 0.0;   // BGRARGBA
+        double grayGBs = 0.0;   // BGRGray
+        size_t mismatches = 0;  // Į  ٸ Ʈ 
+    };
+
+    // w x h  ̹  ( )
+    BenchResult Benchmark(unsigned w, unsigned h, Path path, int iterations = 4);
+
+} // namespace PixelKernels
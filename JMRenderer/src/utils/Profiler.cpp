@@ -0,0 +1,263 @@
+#include "Profiler.h"
+
+#if JM_PROFILE
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+namespace Prof {
+
+    //  ϳ   尡 д  ( )
+    // д    head ٽ ,     ִ ĭ 
+    struct Ring {
+        Event events[kRingEvents];
+        std::atomic<uint64_t> head{ 0 };    //   ȣ ( )
+        std::atomic<bool> owned{ false };   //  ִ 尡  
+        uint32_t index = 0;
+        uint32_t depth = 0;                 //  常 
+        uint64_t readCursor = 0;            //  常 
+        char name[32] = {};
+    };
+
+    namespace {
+
+        constexpr int kMaxRings = 64;
+
+        std::mutex GRingLock;                               //  ȹ/ ( δ  )
+        std::unique_ptr<Ring> GRings[kMaxRings];
+        std::atomic<int> GRingCount{ 0 };
+
+        const auto GEpoch = std::chrono::steady_clock::now();
+
+        FrameCapture GLast, GBuilding;
+        float GHistory[kHistory] = {};
+        int GHistoryNext = 0;
+        bool GPaused = false;
+
+        //     ݳ  ª  ۾ 尡 ݺŵ      
+        struct RingHolder {
+            Ring* ring = nullptr;
+            bool tried = false;
+            ~RingHolder() { if (ring) ring->owned.store(false, std::memory_order_release); }
+        };
+        thread_local RingHolder tRing;
+
+        Ring* AcquireRing()
+        {
+            std::lock_guard<std::mutex> lock(GRingLock);
+            const int n = GRingCount.load(std::memory_order_relaxed);
+            for (int i = 0; i < n; ++i) {
+                Ring* r = GRings[i].get();
+                if (!r->owned.load(std::memory_order_acquire)) {
+                    r->owned.store(true, std::memory_order_relaxed);
+                    r->depth = 0;
+                    snprintf(r->name, sizeof(r->name), "thread %d", i);
+                    return r;
+                }
+            }
+            if (n >= kMaxRings) return nullptr;    //     
+            GRings[n] = std::make_unique<Ring>();
+            Ring* r = GRings[n].get();
+            r->index = (uint32_t)n;
+            r->owned.store(true, std::memory_order_relaxed);
+            snprintf(r->name, sizeof(r->name), "thread %d", n);
+            GRingCount.store(n + 1, std::memory_order_release);
+            return r;
+        }
+
+        Ring* ThisRing()
+        {
+            if (!tRing.tried) { tRing.ring = AcquireRing(); tRing.tried = true; }
+            return tRing.ring;
+        }
+
+        // [from, to)      out ߰,   ȯ (   ̻ и  )
+        uint64_t CopyEvents(const Ring& r, uint64_t from, uint64_t to, std::vector<Event>& out)
+        {
+            uint64_t lost = 0;
+            if (to - from > kRingEvents) { lost = to - kRingEvents - from; from = to - kRingEvents; }
+            const size_t start = out.size();
+            for (uint64_t i = from; i < to; ++i) out.push_back(r.events[i & (kRingEvents - 1)]);
+            // ϴ   ŭ    ִ
+            const uint64_t h = r.head.load(std::memory_order_acquire);
+            const uint64_t safeFrom = h > kRingEvents ? h - kRingEvents : 0;
+            if (safeFrom <= from) return lost;
+            const uint64_t overwritten = std::min(safeFrom, to) - from;
+            out.erase(out.begin() + start, out.begin() + start + (size_t)overwritten);
+            return lost + overwritten;
+        }
+
+    } // namespace
+
+    uint64_t NowNs()
+    {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - GEpoch).count();
+    }
+
+    void SetThreadName(const char* name)
+    {
+        if (Ring* r = ThisRing()) snprintf(r->name, sizeof(r->name), "%s", name);
+    }
+
+    Zone::Zone(const char* name) : mName(name), mRing(ThisRing())
+    {
+        if (mRing) ++mRing->depth;
+        mBegin = NowNs();
+    }
+
+    Zone::~Zone()
+    {
+        const uint64_t end = NowNs();
+        if (!mRing) return;
+        const uint32_t depth = --mRing->depth;
+        const uint64_t h = mRing->head.load(std::memory_order_relaxed);
+        mRing->events[h & (kRingEvents - 1)] = { mName, mBegin, end, depth, mRing->index };
+        mRing->head.store(h + 1, std::memory_order_release);
+    }
+
+    void BeginFrame()
+    {
+        GBuilding.events.clear();
+        GBuilding.threads.clear();
+        GBuilding.dropped = 0;
+        GBuilding.beginNs = NowNs();
+    }
+
+    void EndFrame()
+    {
+        GBuilding.endNs = NowNs();
+        const int n = GRingCount.load(std::memory_order_acquire);
+        for (int i = 0; i < n; ++i) {
+            Ring& r = *GRings[i];
+            const uint64_t h = r.head.load(std::memory_order_acquire);
+            const size_t before = GBuilding.events.size();
+            GBuilding.dropped += CopyEvents(r, r.readCursor, h, GBuilding.events);
+            r.readCursor = h;
+            //  ӿ  (BeginFrame  ) 
+            GBuilding.events.erase(std::remove_if(GBuilding.events.begin() + before, GBuilding.events.end(),
+                [](const Event& e) { return e.endNs < GBuilding.beginNs; }), GBuilding.events.end());
+            if (GBuilding.events.size() > before) {
+                ThreadInfo t{ r.index, {} };
+                memcpy(t.name, r.name, sizeof(t.name));
+                GBuilding.threads.push_back(t);
+            }
+        }
+        std::sort(GBuilding.events.begin(), GBuilding.events.end(), [](const Event& a, const Event& b) {
+            return a.thread != b.thread ? a.thread < b.thread : a.beginNs != b.beginNs ? a.beginNs < b.beginNs : a.depth < b.depth;
+        });
+
+        GHistory[GHistoryNext] = (float)GBuilding.Ms();
+        GHistoryNext = (GHistoryNext + 1) % kHistory;
+        if (!GPaused) std::swap(GLast, GBuilding);
+    }
+
+    void SetPaused(bool paused) { GPaused = paused; }
+    bool Paused() { return GPaused; }
+
+    const FrameCapture& LastFrame() { return GLast; }
+
+    void FrameHistory(float out[kHistory])
+    {
+        for (int i = 0; i < kHistory; ++i) out[i] = GHistory[(GHistoryNext + i) % kHistory];
+    }
+
+    void Summarize(const FrameCapture& f, std::vector<ZoneStat>& out)
+    {
+        out.clear();
+        auto statOf = [&](const char* name) -> ZoneStat& {
+            for (ZoneStat& s : out)
+                if (s.name == name || strcmp(s.name, name) == 0) return s;
+            out.push_back({ name, 0.0, 0.0, 0 });
+            return out.back();
+        };
+
+        // events (, )    θ ã´
+        std::vector<const Event*> stack;
+        std::vector<double> childMs;
+        uint32_t thread = ~0u;
+        auto pop = [&] {
+            const Event* e = stack.back();
+            const double ms = (e->endNs - e->beginNs) * 1e-6;
+            ZoneStat& s = statOf(e->name);
+            s.selfMs += ms - childMs.back();
+            stack.pop_back();
+            childMs.pop_back();
+            if (!childMs.empty()) childMs.back() += ms;
+        };
+        for (const Event& e : f.events) {
+            if (e.thread != thread) { while (!stack.empty()) pop(); thread = e.thread; }
+            while (!stack.empty() && stack.back()->endNs <= e.beginNs) pop();
+
+            ZoneStat& s = statOf(e.name);
+            ++s.calls;
+            bool nested = false;    // : ٱʸ հ迡
+            for (const Event* p : stack) nested |= strcmp(p->name, e.name) == 0;
+            if (!nested) s.totalMs += (e.endNs - e.beginNs) * 1e-6;
+            stack.push_back(&e);
+            childMs.push_back(0.0);
+        }
+        while (!stack.empty()) pop();
+
+        std::sort(out.begin(), out.end(), [](const ZoneStat& a, const ZoneStat& b) { return a.totalMs > b.totalMs; });
+    }
+
+    size_t WriteChromeTrace(const std::filesystem::path& path)
+    {
+        //     (HUD ĸó  б Ŀ ǵ帮 )
+        std::vector<Event> events;
+        std::vector<ThreadInfo> threads;
+        const int n = GRingCount.load(std::memory_order_acquire);
+        for (int i = 0; i < n; ++i) {
+            const Ring& r = *GRings[i];
+            const uint64_t h = r.head.load(std::memory_order_acquire);
+            CopyEvents(r, h > kRingEvents ? h - kRingEvents : 0, h, events);
+            ThreadInfo t{ r.index, {} };
+            memcpy(t.name, r.name, sizeof(t.name));
+            threads.push_back(t);
+        }
+
+        FILE* f = nullptr;
+#if defined(_MSC_VER)
+        if (_wfopen_s(&f, path.c_str(), L"wb") != 0) f = nullptr;
+#else
+        f = fopen(path.c_str(), "wb");
+#endif
+        if (!f) return 0;
+
+        // ̸ ڵ忡  ͷ̶ ǥ/ø ó
+        auto writeName = [&](const char* s) {
+            for (; *s; ++s) {
+                if (*s == '"' || *s == '\\') fputc('\\', f);
+                fputc(*s, f);
+            }
+        };
+        fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", f);
+        bool first = true;
+        for (const ThreadInfo& t : threads) {
+            fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"", first ? "" : ",\n", t.thread);
+            writeName(t.name);
+            fputs("\"}}", f);
+            first = false;
+        }
+        for (const Event& e : events) {
+            fprintf(f, "%s{\"name\":\"", first ? "" : ",\n");
+            writeName(e.name);
+            fprintf(f, "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                e.thread, e.beginNs * 1e-3, (e.endNs - e.beginNs) * 1e-3);
+            first = false;
+        }
+        fputs("\n]}\n", f);
+        const bool ok = ferror(f) == 0;
+        fclose(f);
+        return ok ? events.size() : 0;
+    }
+
+} // namespace Prof
+
+#endif // JM_PROFILE
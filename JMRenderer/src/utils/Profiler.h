@@ -0,0 +1,107 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+//  CPU  Ϸ
+// JM_PROFILE_ZONE("̸"):  / ð 庰  ۿ  ( , Ҵ )
+//  尡  (EndFrame)   о     HUD ÷ ׷
+// WriteChromeTrace:    θ chrome://tracing / Perfetto JSON
+// JM_PROFILE=0 ϸ ũδ  , Լ  ζ ( )
+#ifndef JM_PROFILE
+#define JM_PROFILE 1
+#endif
+
+namespace Prof {
+
+    // ̸ ڿ ͷ   α׷ ü ͸
+    struct Event {
+        const char* name;
+        uint64_t beginNs, endNs;    // μ  
+        uint32_t depth;             //    ø  (0 = ֻ)
+        uint32_t thread;            //  ȣ
+    };
+
+    struct ThreadInfo {
+        uint32_t thread;
+        char name[32];
+    };
+
+    //   [beginNs, endNs)   (,  ð )
+    struct FrameCapture {
+        uint64_t beginNs = 0, endNs = 0;
+        std::vector<Event> events;
+        std::vector<ThreadInfo> threads;    // events  常
+        uint64_t dropped = 0;               // б     ( )
+
+        double Ms() const { return (endNs - beginNs) * 1e-6; }
+    };
+
+    // ̸ հ ( ,  )
+    struct ZoneStat {
+        const char* name;
+        double totalMs;     // ø  ̸ ٱʸ
+        double selfMs;      // ڽ  
+        uint32_t calls;
+    };
+
+    constexpr size_t kRingEvents = 1 << 14;    // 
+    constexpr int kHistory = 256;              //  ð  
+
+#if JM_PROFILE
+
+    uint64_t NowNs();
+
+    // ȣ  ̸ (Ʈ̽/HUD ǥÿ)
+    void SetThreadName(const char* name);
+
+    class Zone {
+    public:
+        explicit Zone(const char* name);
+        ~Zone();
+        Zone(const Zone&) = delete;
+        Zone& operator=(const Zone&) = delete;
+    private:
+        const char* mName;
+        uint64_t mBegin;
+        struct Ring* mRing;
+    };
+
+    //  忡 Ӹ  
+    void BeginFrame();
+    void EndFrame();
+
+    void SetPaused(bool paused);        //  ĸó  ( )
+    bool Paused();
+
+    const FrameCapture& LastFrame();
+    //  ͺ kHistory (ms).   ä ĭ 0
+    void FrameHistory(float out[kHistory]);
+    void Summarize(const FrameCapture& f, std::vector<ZoneStat>& out);     // totalMs 
+
+    // ȯ:    (  0)
+    size_t WriteChromeTrace(const std::filesystem::path& path);
+
+#define JM_PROFILE_CONCAT2(a, b) a##b
+#define JM_PROFILE_CONCAT(a, b) JM_PROFILE_CONCAT2(a, b)
+#define JM_PROFILE_ZONE(name) ::Prof::Zone JM_PROFILE_CONCAT(jmProfZone_, __LINE__)(name)
+
+#else
+
+    inline uint64_t NowNs() { return 0; }
+    inline void SetThreadName(const char*) {}
+    inline void BeginFrame() {}
+    inline void EndFrame() {}
+    inline void SetPaused(bool) {}
+    inline bool Paused() { return false; }
+    inline const FrameCapture& LastFrame() { static const FrameCapture f; return f; }
+    inline void FrameHistory(float out[kHistory]) { for (int i = 0; i < kHistory; ++i) out[i] = 0.0f; }
+    inline void Summarize(const FrameCapture&, std::vector<ZoneStat>& out) { out.clear(); }
+    inline size_t WriteChromeTrace(const std::filesystem::path&) { return 0; }
+
+#define JM_PROFILE_ZONE(name) ((void)0)
+
+#endif
+
+} // namespace Prof
@@ -0,0 +1,103 @@
+// src/utils/Simd.h
+#pragma once
+#include <cstdint>
+
+// x86 SIMD    (  ÷ Į θ)
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define JM_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#else
+#define JM_SIMD_X86 0
+#endif
+
+// Լ  Ÿ : MSVC ÷  intrinsic  , GCC/Clang Ӽ ʿ
+#if JM_SIMD_X86 && !defined(_MSC_VER)
+#define JM_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define JM_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define JM_TARGET_AVX   __attribute__((target("avx")))
+#define JM_TARGET_AVX2  __attribute__((target("avx2")))
+#else
+#define JM_TARGET_SSSE3
+#define JM_TARGET_SSE41
+#define JM_TARGET_AVX
+#define JM_TARGET_AVX2
+#endif
+
+namespace Simd {
+
+    struct CpuFeatures {
+        bool sse41 = false;
+        bool ssse3 = false;
+        bool avx = false;
+        bool avx2 = false;
+    };
+
+    // Ÿ CPU   ( 1ȸ)
+    inline const CpuFeatures& Cpu()
+    {
+        static const CpuFeatures f = [] {
+            CpuFeatures r;
+#if JM_SIMD_X86
+            unsigned a = 0, b = 0, c = 0, d = 0;
+#if defined(_MSC_VER)
+            int i[4];
+            __cpuid(i, 0); unsigned maxLeaf = (unsigned)i[0];
+            __cpuid(i, 1); c = (unsigned)i[2];
+#else
+            unsigned maxLeaf = __get_cpuid_max(0, nullptr);
+            __cpuid(1, a, b, c, d);
+#endif
+            r.ssse3 = (c & (1u << 9)) != 0;
+            r.sse41 = (c & (1u << 19)) != 0;
+            // AVX: CPU  + OS YMM  (OSXSAVE, XCR0 Ʈ 1/2)
+            bool osxsave = (c & (1u << 27)) != 0;
+            bool ymm = false;
+            if (osxsave) {
+#if defined(_MSC_VER)
+                ymm = (_xgetbv(0) & 6) == 6;
+#else
+                unsigned lo, hi;
+                __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+                ymm = (lo & 6) == 6;
+#endif
+            }
+            r.avx = ymm && (c & (1u << 28)) != 0;
+            if (maxLeaf >= 7) {
+#if defined(_MSC_VER)
+                __cpuidex(i, 7, 0); b = (unsigned)i[1];
+#else
+                __cpuid_count(7, 0, a, b, c, d);
+#endif
+                r.avx2 = r.avx && (b & (1u << 5)) != 0;
+            }
+            (void)a; (void)d;
+#endif
+            return r;
+        }();
+        return f;
+    }
+
+    //  1Ʈ ġ (x != 0)
+    inline int Ctz32(uint32_t x)
+    {
+#if defined(_MSC_VER)
+        unsigned long i; _BitScanForward(&i, x); return (int)i;
+#else
+        return __builtin_ctz(x);
+#endif
+    }
+
+    // 1Ʈ 
+    inline int Popcount32(uint32_t x)
+    {
+        x = x - ((x >> 1) & 0x55555555u);
+        x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u);
+        return (int)((((x + (x >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24);
+    }
+
+} // namespace Simd
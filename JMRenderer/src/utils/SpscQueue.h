@@ -0,0 +1,49 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+//   /  Һ   ( )
+// 뷮 2 ŵ ø.   TryPush false (ڰ  ִٰ ٽ õ)
+template<class T>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t capacity = 256)
+    {
+        size_t n = 1;
+        while (n < capacity) n <<= 1;
+        mSlots.resize(n);
+        mMask = n - 1;
+    }
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    //   
+    bool TryPush(T&& v)
+    {
+        const size_t t = mTail.load(std::memory_order_relaxed);
+        if (t - mHead.load(std::memory_order_acquire) == mSlots.size()) return false;
+        mSlots[t & mMask] = std::move(v);
+        mTail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Һ  
+    bool TryPop(T& out)
+    {
+        const size_t h = mHead.load(std::memory_order_relaxed);
+        if (h == mTail.load(std::memory_order_acquire)) return false;
+        out = std::move(mSlots[h & mMask]);
+        mHead.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t Capacity() const { return mSlots.size(); }
+
+private:
+    std::vector<T> mSlots;
+    size_t mMask = 0;
+    alignas(64) std::atomic<size_t> mHead{ 0 };     // Һڰ 
+    alignas(64) std::atomic<size_t> mTail{ 0 };     // ڰ 
+};
@@ -12,41 +12,80 @@ CameraFPS::CameraFPS()
     mYaw = 0.f; mPitch = 0.f;
 }
 
-void CameraFPS::SetPosition(const XMFLOAT3& p) { mPos = p; }
+void CameraFPS::SetPosition(const XMFLOAT3& p) { mPos = p; mViewDirty = true; }
 
 void CameraFPS::SetYawPitch(float yawRad, float pitchRad) {
     mYaw = yawRad;
     mPitch = Clamp(pitchRad, -1.5f, 1.5f);
+    mBasisDirty = mViewDirty = true;
 }
 
 void CameraFPS::AddYawPitch(float dYaw, float dPitch) {
     mYaw += dYaw;
     mPitch = Clamp(mPitch + dPitch, -1.5f, 1.5f);
+    mBasisDirty = mViewDirty = true;
 }
 
 void CameraFPS::SetLens(float fovY, float zn, float zf) {
     mFovY = fovY; mZNear = zn; mZFar = zf;
 }
 
-XMVECTOR CameraFPS::Forward() const {
-    XMVECTOR f = XMVectorSet(
+// sin/cos yaw/pitch ٲ 쿡 
+void CameraFPS::UpdateBasis() const {
+    if (!mBasisDirty) return;
+    XMVECTOR f = XMVector3Normalize(XMVectorSet(
         cosf(mPitch) * sinf(mYaw),
         sinf(mPitch),
         cosf(mPitch) * cosf(mYaw),
-        0.0f);
-    return XMVector3Normalize(f);
+        0.0f));
+    XMVECTOR r = XMVector3Normalize(XMVector3Cross(XMVectorSet(0, 1, 0, 0), f));
+    XMVECTOR u = XMVector3Normalize(XMVector3Cross(f, r));
+    XMStoreFloat3(&mFwd, f);
+    XMStoreFloat3(&mRight, r);
+    XMStoreFloat3(&mUp, u);
+    mBasisDirty = false;
+}
+
+XMVECTOR CameraFPS::Forward() const {
+    UpdateBasis();
+    return XMLoadFloat3(&mFwd);
 }
 
 XMVECTOR CameraFPS::Right() const {
-    return XMVector3Normalize(XMVector3Cross(XMVectorSet(0, 1, 0, 0), Forward()));
+    UpdateBasis();
+    return XMLoadFloat3(&mRight);
 }
 
 XMVECTOR CameraFPS::Up() const {
-    return XMVector3Normalize(XMVector3Cross(Forward(), Right()));
+    UpdateBasis();
+    return XMLoadFloat3(&mUp);
 }
 
 XMMATRIX CameraFPS::View() const {
-    return XMMatrixLookToLH(XMLoadFloat3(&mPos), Forward(), Up());
+    if (mViewDirty) {
+        XMStoreFloat4x4(&mView, XMMatrixLookToLH(XMLoadFloat3(&mPos), Forward(), Up()));
+        mViewDirty = false;
+    }
+    return XMLoadFloat4x4(&mView);
+}
+
+void CameraFPS::UpdateFrame(float aspect) {
+    XMMATRIX P = Proj(aspect);
+    XMMATRIX VP = XMMatrixMultiply(View(), P);
+    XMStoreFloat4x4(&mProj, P);
+    XMStoreFloat4x4(&mViewProj, VP);
+    mFrustum = Frustum::FromViewProj(&mViewProj.m[0][0]);
+}
+
+void CameraFPS::ScreenRay(float px, float py, float width, float height, XMFLOAT3& origin, XMFLOAT3& dir) const {
+    // ȼ  NDC (D3D  0~1), /  ȯ
+    const float x = 2.0f * px / std::max(width, 1.0f) - 1.0f;
+    const float y = 1.0f - 2.0f * py / std::max(height, 1.0f);
+    const XMMATRIX invVP = XMMatrixInverse(nullptr, XMMatrixMultiply(View(), Proj()));
+    const XMVECTOR n = XMVector3TransformCoord(XMVectorSet(x, y, 0.0f, 1.0f), invVP);
+    const XMVECTOR f = XMVector3TransformCoord(XMVectorSet(x, y, 1.0f, 1.0f), invVP);
+    XMStoreFloat3(&origin, n);
+    XMStoreFloat3(&dir, XMVector3Normalize(XMVectorSubtract(f, n)));
 }
 
 XMMATRIX CameraFPS::Proj(float aspect) const {
@@ -61,15 +100,29 @@ void CameraFPS::UpdateFromKeyboardWin32(float dt)
     if (KeyDown(VK_UP))    AddYawPitch(0, -mTurnSpd * dt);
     if (KeyDown(VK_DOWN))  AddYawPitch(0, mTurnSpd * dt);
 
-    // WASD + Space/Ctrl ̵
+    // WASD + Space/Ctrl ̵ (ȱ : ü  θ)
+    XMVECTOR fwd = Forward();
+    if (mWalk) fwd = XMVector3Normalize(XMVectorSet(mFwd.x, 0.0f, mFwd.z, 0.0f));
     XMVECTOR pos = XMLoadFloat3(&mPos);
-    if (KeyDown('W')) pos = XMVectorAdd(pos, XMVectorScale(Forward(), mMoveSpd * dt));
-    if (KeyDown('S')) pos = XMVectorAdd(pos, XMVectorScale(Forward(), -mMoveSpd * dt));
+    if (KeyDown('W')) pos = XMVectorAdd(pos, XMVectorScale(fwd, mMoveSpd * dt));
+    if (KeyDown('S')) pos = XMVectorAdd(pos, XMVectorScale(fwd, -mMoveSpd * dt));
     if (KeyDown('A')) pos = XMVectorAdd(pos, XMVectorScale(Right(), -mMoveSpd * dt));
     if (KeyDown('D')) pos = XMVectorAdd(pos, XMVectorScale(Right(), mMoveSpd * dt));
-    if (KeyDown('E'))   pos = XMVectorAdd(pos, XMVectorSet(0, mMoveSpd * dt, 0, 0));
-    if (KeyDown('Q')) pos = XMVectorAdd(pos, XMVectorSet(0, -mMoveSpd * dt, 0, 0));
-    XMStoreFloat3(&mPos, pos);
+    if (!mWalk && KeyDown('E')) pos = XMVectorAdd(pos, XMVectorSet(0, mMoveSpd * dt, 0, 0));
+    if (!mWalk && KeyDown('Q')) pos = XMVectorAdd(pos, XMVectorSet(0, -mMoveSpd * dt, 0, 0));
+    XMFLOAT3 moved;
+    XMStoreFloat3(&moved, pos);
+    if (moved.x == mPos.x && moved.y == mPos.y && moved.z == mPos.z) return;   // ȸ AddYawPitch ǥ
+    mPos = moved;
+    mViewDirty = true;
+}
+
+void CameraFPS::ClampToGround(float groundY)
+{
+    const float y = groundY + mEyeHeight;
+    if (!mWalk || y == mPos.y) return;
+    mPos.y = y;
+    mViewDirty = true;
 }
 
 bool CameraFPS::HandleWin32MouseMsg(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam, bool wantCaptureMouse)
@@ -3,6 +3,7 @@
 #define NOMINMAX
 #include <windows.h>
 #include <DirectXMath.h>
+#include "../FrustumCull.h"
 
 class CameraFPS {
 public:
@@ -18,19 +19,42 @@ public:
     void SetMoveSpeed(float s) { mMoveSpd = s; }
     void SetTurnSpeed(float s) { mTurnSpd = s; }
     void SetLens(float fovY, float zn, float zf);
+    float FovY() const { return mFovY; }
     void SetMouseSensitivity(float s) { mMouseSens = s; }
 
+    // ȱ : WASD  ̵, Q/E . ̴ ClampToGround  + ̷ 
+    void SetWalkMode(bool on) { mWalk = on; }
+    bool WalkMode() const { return mWalk; }
+    void SetEyeHeight(float h) { mEyeHeight = h; }
+    float EyeHeight() const { return mEyeHeight; }
+
     // Է Ʈ
     void UpdateFromKeyboardWin32(float dt);
 
+    // ȱ 忡  XZ  (ȣڰ ) ޾ y =  + 
+    void ClampToGround(float groundY);
+
     // Win32 콺 ޽ ī޶󿡼 ó
     // (ȯ:  ޽ ī޶ Һ true)
     bool HandleWin32MouseMsg(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam, bool wantCaptureMouse);
 
-    // 
+    //    1ȸ ȣ: View/Proj/ViewProj ü  ĳ
+    void UpdateFrame(float aspect);
+
+    //  (View  ٲ  ٽ )
     DirectX::XMMATRIX View() const;
     DirectX::XMMATRIX Proj(float aspect) const;
 
+    // UpdateFrame  ĳ
+    DirectX::XMMATRIX Proj() const { return DirectX::XMLoadFloat4x4(&mProj); }
+    DirectX::XMMATRIX ViewProj() const { return DirectX::XMLoadFloat4x4(&mViewProj); }
+    const Frustum& GetFrustum() const { return mFrustum; }
+
+    // ȭ ǥ(ȼ, » )    (UpdateFrame  View/Proj)
+    // origin   , dir ȭ
+    void ScreenRay(float px, float py, float width, float height,
+        DirectX::XMFLOAT3& origin, DirectX::XMFLOAT3& dir) const;
+
     //  
     DirectX::XMVECTOR Forward() const;
     DirectX::XMVECTOR Right() const;
@@ -38,6 +62,7 @@ public:
 
 private:
     static float Clamp(float v, float a, float b);
+    void UpdateBasis() const;
 
     DirectX::XMFLOAT3 mPos{};
     float mYaw = 0.f;
@@ -47,6 +72,19 @@ private:
     float mFovY = DirectX::XM_PIDIV4;
     float mZNear = 0.1f;
     float mZFar = 500.f;
+    bool  mWalk = false;
+    float mEyeHeight = 1.7f;
+
+    //  /  ĳ (yaw/pitch/ġ   ȿȭ)
+    mutable bool mBasisDirty = true;
+    mutable bool mViewDirty = true;
+    mutable DirectX::XMFLOAT3 mFwd{}, mRight{}, mUp{};
+    mutable DirectX::XMFLOAT4X4 mView{};
+
+    //  ĳ
+    DirectX::XMFLOAT4X4 mProj{};
+    DirectX::XMFLOAT4X4 mViewProj{};
+    Frustum mFrustum;
 
     // 콺  
     bool  mMouseLook = false;
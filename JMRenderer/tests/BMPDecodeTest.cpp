@@ -0,0 +1,191 @@
+// BMP ڴ 帮 ׽Ʈ: ռ BMP(24/32-bit, bottom-up/top-down,  е) Ἥ
+// ȼ  ذ( δ ȯ) ϰ, ۾ ٷ  ϰ   Ȯ
+#include "TestCheck.h"
+#include "utils/BMPDecode.h"
+#include "utils/JobSystem.h"
+#include "utils/PixelKernels.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    //  ȼ (top-down, BGR Ǵ BGRA)
+    struct Source {
+        unsigned w = 0, h = 0, bits = 24;
+        std::vector<uint8_t> bgr;
+        size_t Bpp() const { return bits / 8; }
+        const uint8_t* At(unsigned x, unsigned y) const { return &bgr[((size_t)y * w + x) * Bpp()]; }
+    };
+
+    Source MakeSource(unsigned w, unsigned h, unsigned bits, uint32_t seed)
+    {
+        Source s;
+        s.w = w; s.h = h; s.bits = bits;
+        s.bgr.resize((size_t)w * h * s.Bpp());
+        std::mt19937 rng(seed);
+        for (auto& b : s.bgr) b = (uint8_t)rng();
+        return s;
+    }
+
+    void Put16(std::vector<uint8_t>& o, uint16_t v) { o.push_back((uint8_t)v); o.push_back((uint8_t)(v >> 8)); }
+    void Put32(std::vector<uint8_t>& o, uint32_t v) { for (int i = 0; i < 4; ++i) o.push_back((uint8_t)(v >> (i * 8))); }
+
+    // BITMAPFILEHEADER + BITMAPINFOHEADER + 4Ʈ е . truncate > 0̸  ߶󳽴
+    fs::path WriteBmp(const char* name, const Source& s, bool topDown, size_t truncate = 0)
+    {
+        const size_t stride = ((size_t)s.w * s.Bpp() + 3) & ~(size_t)3;
+        const uint32_t offBits = 14 + 40;
+        std::vector<uint8_t> f;
+        Put16(f, 0x4D42);
+        Put32(f, (uint32_t)(offBits + stride * s.h));
+        Put16(f, 0); Put16(f, 0);
+        Put32(f, offBits);
+        Put32(f, 40);
+        Put32(f, s.w);
+        Put32(f, topDown ? (uint32_t)-(int32_t)s.h : s.h);
+        Put16(f, 1);
+        Put16(f, (uint16_t)s.bits);
+        for (int i = 0; i < 6; ++i) Put32(f, 0);
+
+        for (unsigned r = 0; r < s.h; ++r) {
+            const unsigned y = topDown ? r : s.h - 1 - r;
+            const uint8_t* row = s.At(0, y);
+            f.insert(f.end(), row, row + (size_t)s.w * s.Bpp());
+            f.resize(f.size() + (stride - (size_t)s.w * s.Bpp()), 0);
+        }
+        f.resize(f.size() - truncate);
+
+        const fs::path p = fs::temp_directory_path() / name;
+        std::ofstream(p, std::ios::binary).write((const char*)f.data(), (std::streamsize)f.size());
+        return p;
+    }
+
+    bool SameRGBA(const BMP::Image& img, const Source& s)
+    {
+        for (unsigned y = 0; y < s.h; ++y)
+            for (unsigned x = 0; x < s.w; ++x) {
+                const uint8_t* o = img.data + y * img.rowPitch + x * 4;
+                const uint8_t* i = s.At(x, y);
+                const uint8_t a = s.bits == 32 ? i[3] : 255;
+                if (o[0] != i[2] || o[1] != i[1] || o[2] != i[0] || o[3] != a) return false;
+            }
+        return true;
+    }
+
+    bool SameGray(const BMP::Image& img, const Source& s)
+    {
+        for (unsigned y = 0; y < s.h; ++y)
+            for (unsigned x = 0; x < s.w; ++x) {
+                const uint8_t* i = s.At(x, y);
+                if (img.data[y * img.rowPitch + x] != PixelKernels::ToGray(i[2], i[1], i[0])) return false;
+            }
+        return true;
+    }
+
+    //  (64)   ǵ ̸ ,  24-bit  е  Ȧ
+    void RunDecodeChecks()
+    {
+        const Source s24 = MakeSource(37, 150, 24, 1);
+        const Source s32 = MakeSource(29, 131, 32, 2);
+
+        for (bool topDown : { false, true }) {
+            const fs::path p = WriteBmp(topDown ? "jm_bmp24_td.bmp" : "jm_bmp24_bu.bmp", s24, topDown);
+            BMP::Image rgba, gray;
+            CHECK(BMP::DecodeRGBA8(p, rgba));
+            CHECK(rgba.width == s24.w && rgba.height == s24.h);
+            CHECK(rgba.format == BMP::PixelFormat::RGBA8 && !rgba.IsZeroCopy());
+            CHECK(SameRGBA(rgba, s24));
+            CHECK(BMP::DecodeR8(p, gray));
+            CHECK(gray.format == BMP::PixelFormat::R8 && gray.rowPitch == s24.w);
+            CHECK(SameGray(gray, s24));
+
+            BMP::RowReaderR8 rows;
+            CHECK(rows.Open(p));
+            std::vector<uint8_t> row(s24.w);
+            bool same = true;
+            for (unsigned y = 0; y < s24.h; ++y) {
+                rows.ReadRow(y, row.data());
+                same = same && std::memcmp(row.data(), gray.data + y * gray.rowPitch, s24.w) == 0;
+            }
+            CHECK(same);
+            fs::remove(p);
+        }
+
+        // 32-bit bottom-up: ȯ, top-down:  ״ (allowBGRA=false ȯ)
+        {
+            const fs::path p = WriteBmp("jm_bmp32_bu.bmp", s32, false);
+            BMP::Image img, gray;
+            CHECK(BMP::DecodeRGBA8(p, img));
+            CHECK(img.format == BMP::PixelFormat::RGBA8 && SameRGBA(img, s32));
+            CHECK(!BMP::DecodeR8(p, gray));     // R8 δ 24-bit
+            fs::remove(p);
+        }
+        {
+            const fs::path p = WriteBmp("jm_bmp32_td.bmp", s32, true);
+            BMP::Image zc, conv;
+            CHECK(BMP::DecodeRGBA8(p, zc));
+            CHECK(zc.format == BMP::PixelFormat::BGRA8 && zc.IsZeroCopy() && zc.pixels.empty());
+            CHECK(zc.rowPitch == (size_t)s32.w * 4);
+            CHECK(std::memcmp(zc.data, s32.bgr.data(), s32.bgr.size()) == 0);
+            CHECK(BMP::DecodeRGBA8(p, conv, false));
+            CHECK(conv.format == BMP::PixelFormat::RGBA8 && SameRGBA(conv, s32));
+
+            BMP::RowReaderR8 rows;
+            CHECK(rows.Open(p));
+            std::vector<uint8_t> row(s32.w);
+            rows.ReadRow(s32.h / 2, row.data());
+            const uint8_t* i = s32.At(3, s32.h / 2);
+            CHECK(row[3] == PixelKernels::ToGray(i[2], i[1], i[0]));
+            zc = {};
+            fs::remove(p);
+        }
+
+        // ߸  /  
+        {
+            const fs::path p = WriteBmp("jm_bmp_trunc.bmp", s24, false, 7);
+            BMP::Image img;
+            CHECK(!BMP::DecodeRGBA8(p, img));
+            CHECK(!BMP::DecodeR8(p, img));
+            fs::remove(p);
+            CHECK(!BMP::DecodeRGBA8(fs::temp_directory_path() / "jm_bmp_missing.bmp", img));
+        }
+    }
+
+    //  : ڵ  + RowReader DecodeR8  
+    void RunAssetChecks()
+    {
+        const fs::path dir = JM_ASSET_DIR;
+        for (const char* name : { "heightmaps/hm.bmp", "textures/grass.bmp" }) {
+            const fs::path p = dir / name;
+            if (!fs::exists(p)) continue;
+            BMP::Image rgba, gray;
+            CHECK(BMP::DecodeRGBA8(p, rgba));
+            CHECK(rgba.width > 0 && rgba.height > 0);
+            if (!BMP::DecodeR8(p, gray)) continue;     // 32-bit 
+            BMP::RowReaderR8 rows;
+            CHECK(rows.Open(p));
+            std::vector<uint8_t> row(gray.width);
+            rows.ReadRow(gray.height - 1, row.data());
+            CHECK(std::memcmp(row.data(), gray.data + (gray.height - 1) * gray.rowPitch, gray.width) == 0);
+        }
+    }
+
+} // namespace
+
+int main()
+{
+    RunDecodeChecks();
+    RunAssetChecks();
+
+    // Ŀ  (    )  
+    Jobs::Init(4);
+    RunDecodeChecks();
+    Jobs::Shutdown();
+
+    return Test::Exit("BMPDecodeTest");
+}
@@ -0,0 +1,169 @@
+// BC1/BC4/BC5 ڴ 帮 ׽Ʈ: Ȯ ǥ   պ, ڸ ũ,
+// BGRA Է, ǰ ܰ躰 PSNR , ٷ   
+#include "TestCheck.h"
+#include "utils/BlockCompress.h"
+#include "utils/BMPDecode.h"
+#include "utils/JobSystem.h"
+#include <filesystem>
+#include <random>
+#include <vector>
+
+namespace {
+
+    const BC::Format kFormats[] = { BC::Format::BC1, BC::Format::BC4, BC::Format::BC5 };
+    const BC::Quality kQualities[] = { BC::Quality::Fast, BC::Quality::Normal, BC::Quality::High };
+
+    BC::Source MakeSource(const std::vector<uint8_t>& img, unsigned w, unsigned h, unsigned channels)
+    {
+        BC::Source s;
+        s.data = img.data();
+        s.width = w;
+        s.height = h;
+        s.rowPitch = (size_t)w * channels;
+        s.channels = channels;
+        return s;
+    }
+
+    // 565 Ȯ ǥǴ  (/ʷ) /    8x8 üĿ
+    // BC4/BC5  ǰ, BC1 High(ּ) ս  Ѵ
+    // BC1 Normal ּ  ݴ  ä  ã Ȯ (Fast ڽ 밢    )
+    void CheckExactBlocks()
+    {
+        std::vector<uint8_t> rgba(8 * 8 * 4);
+        for (size_t i = 0; i < 64; ++i) {
+            const bool a = ((i / 8) + (i % 8)) & 1;
+            rgba[i * 4 + 0] = a ? 255 : 0;
+            rgba[i * 4 + 1] = a ? 0 : 255;
+            rgba[i * 4 + 2] = 0;
+            rgba[i * 4 + 3] = 255;
+        }
+        const BC::Source src = MakeSource(rgba, 8, 8, 4);
+        for (BC::Format f : kFormats)
+            for (BC::Quality q : kQualities) {
+                BC::Surface s;
+                BC::Encode(src, f, q, s);
+                CHECK(s.blocksX == 2 && s.blocksY == 2);
+                CHECK(s.blocks.size() == 4 * BC::BlockBytes(f));
+
+                std::vector<uint8_t> dec;
+                unsigned ch = 0;
+                BC::Decode(s, dec, ch);
+                CHECK(dec.size() == (size_t)8 * 8 * ch);
+
+                const double psnr = BC::PSNR(src, s);
+                if (f == BC::Format::BC1 && q == BC::Quality::Fast) continue;
+                if (f == BC::Format::BC1 && q == BC::Quality::Normal) { CHECK(psnr >= 20.0); continue; }
+                CHECK(psnr >= 99.0);
+                bool same = true;
+                for (size_t i = 0; i < 64; ++i)
+                    for (unsigned c = 0; c < ch && c < 3; ++c) same = same && dec[i * ch + c] == rgba[i * 4 + c];
+                CHECK(same);
+            }
+    }
+
+    // 4  ƴ ũ:  , Ʈ , ڸ   ڵ  ʴ
+    void CheckEdgeSizes()
+    {
+        std::mt19937 rng(3);
+        for (unsigned w : { 1u, 3u, 5u, 17u, 64u })
+            for (unsigned h : { 1u, 2u, 7u, 33u }) {
+                std::vector<uint8_t> img((size_t)w * h * 4);
+                for (auto& b : img) b = (uint8_t)rng();
+                const BC::Source src = MakeSource(img, w, h, 4);
+                for (BC::Format f : kFormats) {
+                    BC::Surface s;
+                    BC::Encode(src, f, BC::Quality::Normal, s);
+                    CHECK(s.width == w && s.height == h);
+                    CHECK(s.blocksX == (w + 3) / 4 && s.blocksY == (h + 3) / 4);
+                    CHECK(s.blocks.size() == (size_t)s.blocksX * s.blocksY * BC::BlockBytes(f));
+                    CHECK(s.RowPitch() == (size_t)s.blocksX * BC::BlockBytes(f));
+                    CHECK(BC::PSNR(src, s) > 5.0);
+                }
+            }
+    }
+
+    // BGRA + swapRB  ̹ RGBA Է°  
+    void CheckSwapRB()
+    {
+        std::mt19937 rng(5);
+        std::vector<uint8_t> rgba(32 * 16 * 4), bgra(rgba.size());
+        for (size_t i = 0; i < rgba.size(); i += 4) {
+            for (int c = 0; c < 3; ++c) rgba[i + c] = (uint8_t)(rng() & 0xF0);
+            rgba[i + 3] = 255;
+            bgra[i + 0] = rgba[i + 2]; bgra[i + 1] = rgba[i + 1]; bgra[i + 2] = rgba[i + 0]; bgra[i + 3] = 255;
+        }
+        BC::Source a = MakeSource(rgba, 32, 16, 4), b = MakeSource(bgra, 32, 16, 4);
+        b.swapRB = true;
+        BC::Surface sa, sb;
+        BC::Encode(a, BC::Format::BC1, BC::Quality::High, sa);
+        BC::Encode(b, BC::Format::BC1, BC::Quality::High, sb);
+        CHECK(sa.blocks == sb.blocks);
+    }
+
+    // ռ ؽó(׶Ʈ +  + ) PSNR , ǰ   ʴ´
+    void CheckQuality()
+    {
+        const double minPsnr[3] = { 35.0, 50.0, 50.0 };     // BC1, BC4, BC5
+        for (int f = 0; f < 3; ++f) {
+            double prev = 0.0;
+            for (BC::Quality q : kQualities) {
+                const BC::BenchResult r = BC::Benchmark(kFormats[f], q, 256, 256, 1);
+                CHECK(r.blocks == 64 * 64);
+                CHECK(r.psnr >= minPsnr[f]);
+                CHECK(r.psnr >= prev - 0.01);
+                prev = r.psnr;
+            }
+        }
+    }
+
+    void CheckAssets()
+    {
+        const std::filesystem::path dir = JM_ASSET_DIR;
+        BMP::Image grass, hm;
+        if (BMP::DecodeRGBA8(dir / "textures/grass.bmp", grass, false)) {
+            BC::Source s;
+            s.data = grass.data; s.width = grass.width; s.height = grass.height;
+            s.rowPitch = grass.rowPitch; s.channels = 4;
+            BC::Surface out;
+            BC::Encode(s, BC::Format::BC1, BC::Quality::Normal, out);
+            CHECK(BC::PSNR(s, out) >= 30.0);
+        }
+        if (BMP::DecodeR8(dir / "heightmaps/hm.bmp", hm)) {
+            BC::Source s;
+            s.data = hm.data; s.width = hm.width; s.height = hm.height;
+            s.rowPitch = hm.rowPitch; s.channels = 1;
+            BC::Surface out;
+            BC::Encode(s, BC::Format::BC4, BC::Quality::Normal, out);
+            CHECK(BC::PSNR(s, out) >= 50.0);
+        }
+    }
+
+    //   Ŀ   
+    void CheckDeterministic()
+    {
+        std::mt19937 rng(9);
+        std::vector<uint8_t> img(300 * 200 * 4);
+        for (auto& b : img) b = (uint8_t)rng();
+        const BC::Source src = MakeSource(img, 300, 200, 4);
+        for (BC::Format f : kFormats) {
+            BC::Surface serial, parallel;
+            BC::Encode(src, f, BC::Quality::High, serial);
+            Jobs::Init(4);
+            BC::Encode(src, f, BC::Quality::High, parallel);
+            Jobs::Shutdown();
+            CHECK(serial.blocks == parallel.blocks);
+        }
+    }
+
+} // namespace
+
+int main()
+{
+    CheckExactBlocks();
+    CheckEdgeSizes();
+    CheckSwapRB();
+    CheckQuality();
+    CheckAssets();
+    CheckDeterministic();
+    return Test::Exit("BlockCompressTest");
+}
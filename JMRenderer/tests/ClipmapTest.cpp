@@ -0,0 +1,99 @@
+// Ʈ Ŭ 帮 ׽Ʈ:  ε ũ/,  ġ 4  ȿ ӹ,
+//     â   (  ־ ,  ĳ  ü Ͼ )
+// ü  Ӹ  (drain) Ŀ ӵ ϰ  
+#include "TestCheck.h"
+#include "terrain/TerrainClipmap.h"
+#include "terrain/TerrainNoise.h"
+#include "terrain/TerrainTilePager.h"
+#include "terrain/TerrainTileSource.h"
+#include <algorithm>
+#include <filesystem>
+#include <vector>
+
+namespace {
+
+    void CheckRingIndices()
+    {
+        for (int size : { 16, 64, 256 }) {
+            const size_t quads = (size_t)(size - 2) * (size - 2), hole = (size_t)(size / 2 - 1) * (size / 2 - 1);
+            for (int v = 0; v < TerrainClipmap::kRingVariants; ++v) {
+                std::vector<uint32_t> idx;
+                TerrainClipmap::BuildRingIndices(size, v, idx);
+                CHECK(idx.size() == (v == 4 ? quads : quads - hole) * 6);
+                CHECK(!idx.empty() && *std::max_element(idx.begin(), idx.end()) == (uint32_t)((size - 1) * (size - 1) - 1));
+            }
+        }
+    }
+
+    // ұ ̴   l-1 â  l   0~3  ϳ Ȯ 
+    void CheckVariants(const TerrainTileSource& src)
+    {
+        TerrainTilePager pager;
+        CHECK(pager.Start(&src, 8u << 20));
+        ClipmapDesc d;
+        d.size = 64;
+        TerrainClipmap clip;
+        CHECK(clip.Init(d, src, pager));
+        float x = -3.0f, z = 1.0f;
+        int bad = 0;
+        for (int f = 0; f < 1000; ++f) {
+            x += 0.0137f * (f % 7 - 3);
+            z += 0.011f * ((f * 5) % 9 - 4);
+            pager.Update();
+            clip.Update(x, z);
+            for (int l = 1; l < clip.Levels(); ++l) {
+                const int hx = (clip.OriginX(l - 1) >> 1) - clip.OriginX(l) - (d.size / 4 - 1);
+                const int hz = (clip.OriginZ(l - 1) >> 1) - clip.OriginZ(l) - (d.size / 4 - 1);
+                if (hx < 0 || hx > 1 || hz < 0 || hz > 1) ++bad;
+                else if (clip.RingVariant(l) != hx + 2 * hz) ++bad;
+            }
+        }
+        CHECK(bad == 0);
+        pager.WaitIdle();
+        clip.Update(x, z);
+        CHECK(clip.Verify() == 0);
+    }
+
+    void CheckFlythrough(const TerrainTileSource& src)
+    {
+        ClipmapDesc d;
+        d.size = 64;
+
+        //  : Ŀ  ͵     ƾ Ѵ
+        TerrainClipmap::FlythroughResult r = TerrainClipmap::Flythrough(src, d, 8u << 20, 200, 4.0f, 0.0);
+        CHECK(r.frames == 200);
+        CHECK(r.complete && r.mismatches == 0);
+        CHECK(r.hitRate > 0.0 && r.hitRate <= 1.0);
+
+        //  : Ÿ ü Ͼ  
+        // Ӹ û  Ƿ 鼭 ĳð  ü  ( /ٸ )
+        d.size = 128;
+        r = TerrainClipmap::Flythrough(src, d, 96u << 10, 200, 8.0f, 0.0, true);
+        CHECK(r.frames == 200);
+        CHECK(r.complete && r.mismatches == 0);
+        CHECK(r.evictions > 0);
+        CHECK(r.peakMB > 0.0);
+    }
+
+} // namespace
+
+int main()
+{
+    CheckRingIndices();
+
+    const int n = 1024;
+    const std::vector<uint8_t> px = TerrainNoise::GenerateR8(NoiseParams{}, n, n);
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "jm_clipmap_test.r8";
+    CHECK(TerrainRawTileSource::Write(path, px.data(), n, n));
+    {
+        TerrainRawTileSource src;
+        CHECK(src.Open(path, n, n, 64));
+        if (src.LevelCount() > 0) {
+            CheckVariants(src);
+            CheckFlythrough(src);
+        }
+    }
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+    return Test::Exit("ClipmapTest");
+}
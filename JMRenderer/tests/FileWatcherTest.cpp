@@ -0,0 +1,140 @@
+//  ε 帮 ׽Ʈ: SpscQueue   push/pop (,  ), FileDependencies ,
+// FileWatcher ٿ (â      ̺Ʈ  ) +        ̴ Ƽ
+#include "TestCheck.h"
+#include "utils/FileWatcher.h"
+#include "utils/SpscQueue.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    //  1 / Һ 1:         
+    void CheckSpsc()
+    {
+        SpscQueue<uint64_t> q(100);
+        CHECK(q.Capacity() == 128);
+        const uint64_t kCount = 200000;
+        std::thread producer([&] {
+            for (uint64_t i = 1; i <= kCount; ++i) {
+                uint64_t v = i;
+                while (!q.TryPush(std::move(v))) std::this_thread::yield();
+            }
+        });
+        uint64_t expect = 1, v = 0;
+        int outOfOrder = 0;
+        while (expect <= kCount) {
+            if (!q.TryPop(v)) { std::this_thread::yield(); continue; }
+            outOfOrder += v != expect;
+            ++expect;
+        }
+        producer.join();
+        CHECK(outOfOrder == 0);
+        CHECK(!q.TryPop(v));
+
+        //   TryPush false, ϳ  ٽ ȴ
+        SpscQueue<int> small(4);
+        for (int i = 0; i < 4; ++i) { int x = i; CHECK(small.TryPush(std::move(x))); }
+        int x = 9, y = -1;
+        CHECK(!small.TryPush(std::move(x)));
+        CHECK(small.TryPop(y) && y == 0);
+        x = 9;
+        CHECK(small.TryPush(std::move(x)));
+    }
+
+    void CheckDependencies(const fs::path& dir)
+    {
+        FileDependencies deps;
+        deps.Set(0, { dir / "a.hlsl", dir / "common.hlsli", dir / "common.hlsli" });
+        deps.Set(1, { dir / "b.hlsl", dir / "common.hlsli" });
+        deps.Set(2, { dir / "c.hlsl" });
+        CHECK(deps.FileCount() == 4);
+
+        std::vector<uint32_t> owners;
+        deps.Owners(FileWatcher::PathKey(dir / "sub" / ".." / "common.hlsli"), owners);
+        std::sort(owners.begin(), owners.end());
+        CHECK((owners == std::vector<uint32_t>{ 0, 1 }));
+
+        //  ° ٲٸ  Ͽ  ̻ ã ʴ´
+        deps.Set(1, { dir / "b.hlsl" });
+        owners.clear();
+        deps.Owners(FileWatcher::PathKey(dir / "common.hlsli"), owners);
+        CHECK((owners == std::vector<uint32_t>{ 0 }));
+        deps.Remove(0);
+        owners.clear();
+        deps.Owners(FileWatcher::PathKey(dir / "common.hlsli"), owners);
+        CHECK(owners.empty());
+        CHECK(deps.FileCount() == 2);
+    }
+
+    void Write(const fs::path& path, int i)
+    {
+        std::ofstream(path) << "float4 common" << i << ";\n";
+    }
+
+    //    ť  Poll  Owners (main PumpFileChanges  帧)
+    void CheckWatcher(const fs::path& dir)
+    {
+        const int kDebounceMs = 250;
+        FileDependencies deps;
+        deps.Set(0, { dir / "a.hlsl", dir / "common.hlsli" });
+        deps.Set(1, { dir / "b.hlsl", dir / "common.hlsli" });
+        deps.Set(2, { dir / "c.hlsl" });
+
+        FileWatcher w;
+        CHECK(w.Start({ dir }, kDebounceMs));
+        if (!w.Running()) return;
+
+        //    Ⱑ    â ȿ   
+        for (int i = 0; i < 5; ++i) {
+            Write(dir / "common.hlsli", i);
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        std::vector<fs::path> events;
+        fs::path p;
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (events.empty() && std::chrono::steady_clock::now() < deadline) {
+            while (w.Poll(p)) events.push_back(p);
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        // â      ʾƾ Ѵ
+        std::this_thread::sleep_for(std::chrono::milliseconds(kDebounceMs * 2));
+        while (w.Poll(p)) events.push_back(p);
+
+        CHECK(events.size() == 1);
+        const FileWatcher::Stats s = w.GetStats();
+        CHECK(s.posted == 1);
+        CHECK(s.rawEvents > 1 && s.coalesced == s.rawEvents - 1);
+
+        std::vector<uint32_t> dirty;
+        for (const fs::path& e : events) deps.Owners(FileWatcher::PathKey(e), dirty);
+        std::sort(dirty.begin(), dirty.end());
+        CHECK((dirty == std::vector<uint32_t>{ 0, 1 }));
+        w.Stop();
+        CHECK(!w.Running());
+    }
+
+} // namespace
+
+int main()
+{
+    const fs::path dir = fs::temp_directory_path() / "jm_file_watcher_test";
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+    fs::create_directories(dir);
+    for (const char* name : { "a.hlsl", "b.hlsl", "c.hlsl" }) std::ofstream(dir / name) << "#include \"common.hlsli\"\n";
+    Write(dir / "common.hlsli", -1);
+
+    CheckSpsc();
+    CheckDependencies(dir);
+    CheckWatcher(dir);
+
+    fs::remove_all(dir, ec);
+    return Test::Exit("FileWatcherTest");
+}
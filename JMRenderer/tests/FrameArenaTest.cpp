@@ -0,0 +1,111 @@
+//  Ʒ 帮 ׽Ʈ:   (frames    ä),   Ʒ ,
+// 庸  ı/Init Ʒ, ġũ  Ҵ  ġ
+#include "TestCheck.h"
+#include "utils/FrameArena.h"
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    bool Filled(const uint8_t* p, size_t n, uint8_t v)
+    {
+        for (size_t i = 0; i < n; ++i)
+            if (p[i] != v) return false;
+        return true;
+    }
+
+    //  N Ҵ N + frames - 1  ״,  ٽ ƿ 
+    void CheckSlots()
+    {
+        FrameMem::FrameArena fa;
+        fa.Init(3);
+        fa.SetPoison(true);
+        uint8_t* p = static_cast<uint8_t*>(fa.Local().Alloc(256));
+        std::memset(p, 0x5A, 256);
+        fa.EndFrame();
+        fa.EndFrame();
+        CHECK(Filled(p, 256, 0x5A));
+        fa.EndFrame();
+        CHECK(Filled(p, 256, FrameMem::kPoisonByte));
+        CHECK(fa.FrameIndex() == 3);
+    }
+
+    // ª  :  ̹  ʹ frames   ȿ,   Ʒ 
+    void CheckThreadExit()
+    {
+        const int kThreads = 8;
+        const size_t kBytes = 1000;
+        FrameMem::FrameArena fa;
+        fa.Init(2, 1 << 16, 1 << 12);
+        fa.SetPoison(true);
+        fa.Local();
+        const size_t mainCapacity = [&] { fa.EndFrame(); return fa.LastFrame().capacity; }();
+
+        for (int round = 0; round < 20; ++round) {
+            std::vector<uint8_t*> ptrs(kThreads);
+            std::vector<std::thread> threads;
+            for (int t = 0; t < kThreads; ++t)
+                threads.emplace_back([&, t] {
+                    ptrs[t] = static_cast<uint8_t*>(fa.Local().Alloc(kBytes));
+                    std::memset(ptrs[t], 0x40 + t, kBytes);
+                });
+            for (std::thread& t : threads) t.join();
+            CHECK(fa.ThreadCount() == 1 + kThreads);
+
+            fa.EndFrame();
+            CHECK(fa.LastFrame().threads == (uint32_t)kThreads);
+            for (int t = 0; t < kThreads; ++t) CHECK(Filled(ptrs[t], kBytes, (uint8_t)(0x40 + t)));
+            CHECK(fa.ThreadCount() == 1 + kThreads);
+
+            fa.EndFrame();
+            CHECK(fa.ThreadCount() == 1);
+        }
+        fa.EndFrame();
+        CHECK(fa.LastFrame().capacity == mainCapacity);
+    }
+
+    // 尡   Ʒ ıǰų ٽ Initŵ   
+    void CheckArenaGoneFirst()
+    {
+        std::atomic<int> stage{ 0 };
+        auto fa = std::make_unique<FrameMem::FrameArena>();
+        fa->Init(2);
+        FrameMem::FrameArena other;
+        other.Init(2);
+        std::thread worker([&] {
+            fa->Local().Alloc(64);
+            other.Local().Alloc(64);
+            stage = 1;
+            while (stage != 2) std::this_thread::yield();
+        });
+        while (stage != 1) std::this_thread::yield();
+        fa.reset();
+        other.Init(2);
+        CHECK(other.ThreadCount() == 0);
+        stage = 2;
+        worker.join();
+        other.EndFrame();
+        CHECK(other.ThreadCount() == 0);
+    }
+
+    void CheckBenchmark()
+    {
+        for (const FrameMem::BenchResult& r : FrameMem::Benchmark(10)) {
+            CHECK(r.checksum != 0);
+            CHECK(r.arenaBytes > 0);
+        }
+    }
+
+} // namespace
+
+int main()
+{
+    CheckSlots();
+    CheckThreadExit();
+    CheckArenaGoneFirst();
+    CheckBenchmark();
+    return Test::Exit("FrameArenaTest");
+}
@@ -0,0 +1,98 @@
+// ̸ κ  帮 ׽Ʈ ( ε ):  Ϻθ ٲ ̸
+// Ʈ UpdateRows /  SetRows / Ŀ UpdateRows ģ  ó ٽ  Ͱ 
+#include "TestCheck.h"
+#include "terrain/TerrainHeightField.h"
+#include "terrain/TerrainNoise.h"
+#include "terrain/TerrainPicker.h"
+#include "terrain/TerrainQuadTree.h"
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+    const float kGrid = 10.0f, kHeightScale = 1.5f;
+
+    bool SameDraws(const std::vector<TerrainDraw>& a, const std::vector<TerrainDraw>& b)
+    {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); ++i)
+            if (a[i].x != b[i].x || a[i].z != b[i].z || a[i].lod != b[i].lod || a[i].quadMask != b[i].quadMask ||
+                a[i].minY != b[i].minY || a[i].maxY != b[i].maxY) return false;
+        return true;
+    }
+
+    //  ī޶󿡼 ģ Ʈ  Ʈ  /  
+    bool SameSelection(TerrainQuadTree& a, TerrainQuadTree& b)
+    {
+        std::vector<TerrainDraw> da, db;
+        const float cams[][3] = { { 0, 0.3f, 0 }, { -4.5f, 0.2f, 4.5f }, { 2, 3, -3 } };
+        for (const float* cam : cams) {
+            TerrainSelectParams sp;
+            sp.camPos[0] = cam[0]; sp.camPos[1] = cam[1]; sp.camPos[2] = cam[2];
+            sp.heightScale = kHeightScale;
+            sp.pixelError = 0.5f;
+            a.Select(sp, da);
+            b.Select(sp, db);
+            if (!SameDraws(da, db)) return false;
+        }
+        return true;
+    }
+
+    bool SamePicks(const TerrainPicker& a, const TerrainPicker& b)
+    {
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<float> u(-kGrid * 0.5f, kGrid * 0.5f);
+        for (int i = 0; i < 2000; ++i) {
+            const TerrainRay ray{ { u(rng), 3.0f, u(rng) }, { u(rng) * 0.2f, -1.0f, u(rng) * 0.2f } };
+            const TerrainRayHit ha = a.Pick(ray), hb = b.Pick(ray);
+            if (ha.hit != hb.hit || ha.distance != hb.distance) return false;
+        }
+        return true;
+    }
+
+    void CheckRows(int w, int h, int y0, int y1)
+    {
+        NoiseParams np;
+        std::vector<uint8_t> px = TerrainNoise::GenerateR8(np, w, h);
+
+        TerrainQuadTreeDesc qd{};
+        qd.lodCount = TerrainQuadTree::SuggestLodCount(w, h, qd.patchRes);
+        TerrainQuadTree tree;
+        tree.Build(qd, px.data(), w, h);
+        TerrainHeightField field;
+        CHECK(field.Init(px.data(), w, h, kGrid, kGrid, kHeightScale));
+        TerrainPicker picker;
+        CHECK(picker.Build(field));
+
+        //  [y0, y1)  츮/   (min/max Ȯ ٲ)
+        std::mt19937 rng((unsigned)(w * 31 + y0));
+        for (int y = y0; y < y1; ++y)
+            for (int x = 0; x < w; ++x) px[(size_t)y * w + x] = (rng() & 1) ? 255 : 0;
+
+        tree.UpdateRows(px.data(), w, h, y0, y1);
+        field.SetRows(px.data(), y0, y1);
+        picker.UpdateRows(y0, y1);
+
+        TerrainQuadTree freshTree;
+        freshTree.Build(qd, px.data(), w, h);
+        TerrainHeightField freshField;
+        CHECK(freshField.Init(px.data(), w, h, kGrid, kGrid, kHeightScale));
+        TerrainPicker freshPicker;
+        CHECK(freshPicker.Build(freshField));
+
+        CHECK(SameSelection(tree, freshTree));
+        CHECK(std::memcmp(field.Texels(), freshField.Texels(), (size_t)w * h * sizeof(float)) == 0);
+        CHECK(SamePicks(picker, freshPicker));
+    }
+
+} // namespace
+
+int main()
+{
+    CheckRows(256, 256, 100, 120);     // ߰ 
+    CheckRows(256, 256, 0, 1);         // 0:    / ()
+    CheckRows(256, 256, 255, 256);     //  
+    CheckRows(300, 170, 33, 97);       // 2 ŵ ƴ ũ
+    return Test::Exit("HeightReloadTest");
+}
@@ -0,0 +1,85 @@
+//  ø 帮 ׽Ʈ:    ο  尡  ŷ  ε
+//  ̴ (̴ Ʈ  ),  ĥ  
+#include "TestCheck.h"
+#include "terrain/TerrainHeightField.h"
+#include "terrain/TerrainHorizonCull.h"
+#include "terrain/TerrainNoise.h"
+#include "terrain/TerrainPicker.h"
+#include "utils/BMPDecode.h"
+#include <cstring>
+#include <vector>
+
+namespace {
+
+    TerrainHorizonCull::FlythroughResult Fly(const std::vector<uint8_t>& px, int w, int h, float heightScale, int frames)
+    {
+        TerrainHeightField field;
+        CHECK(field.Init(px.data(), w, h, 10.0f, 10.0f, heightScale));
+        TerrainPicker picker;
+        picker.Build(field);
+        TerrainQuadTreeDesc qd{};
+        qd.lodCount = TerrainQuadTree::SuggestLodCount(w, h, 16);
+        TerrainQuadTree tree;
+        tree.Build(qd, px.data(), w, h);
+
+        TerrainSelectParams sp;
+        sp.heightScale = heightScale;
+        return TerrainHorizonCull::Flythrough(tree, field, picker, sp, frames, 7);
+    }
+
+    void CheckResult(const TerrainHorizonCull::FlythroughResult& r, int frames)
+    {
+        CHECK(r.frames == frames);
+        CHECK(r.samples > 0);
+        CHECK(r.violations == 0);
+        CHECK(r.avgCulledPercent <= r.maxCulledPercent);
+        CHECK(r.maxCulledPercent <= 100.0);
+    }
+
+    void CheckProcedural()
+    {
+        struct Case { NoiseType type; int size; float heightScale; };
+        const Case cases[] = {
+            { NoiseType::FBm, 256, 1.5f },
+            { NoiseType::Ridged, 512, 1.5f },
+            { NoiseType::DomainWarp, 512, 3.0f },
+        };
+        for (const Case& c : cases) {
+            NoiseParams np;
+            np.type = c.type;
+            const std::vector<uint8_t> px = TerrainNoise::GenerateR8(np, c.size, c.size);
+            const TerrainHorizonCull::FlythroughResult r = Fly(px, c.size, c.size, c.heightScale, 60);
+            CheckResult(r, 60);
+            // /Ʋ   ࿡  κ 
+            if (c.type != NoiseType::FBm) CHECK(r.avgCulledPercent > 5.0);
+        }
+    }
+
+    //  ƹ͵  ʴ´
+    void CheckFlat()
+    {
+        const std::vector<uint8_t> px(128 * 128, 100);
+        const TerrainHorizonCull::FlythroughResult r = Fly(px, 128, 128, 1.5f, 30);
+        CheckResult(r, 30);
+        CHECK(r.maxCulledPercent == 0.0);
+    }
+
+    void CheckAsset()
+    {
+        BMP::Image hm;
+        if (!BMP::DecodeR8(std::filesystem::path(JM_ASSET_DIR) / "heightmaps/hm.bmp", hm)) return;
+        std::vector<uint8_t> px((size_t)hm.width * hm.height);
+        for (unsigned y = 0; y < hm.height; ++y)
+            std::memcpy(&px[(size_t)y * hm.width], hm.data + y * hm.rowPitch, hm.width);
+        CheckResult(Fly(px, (int)hm.width, (int)hm.height, 1.5f, 60), 60);
+    }
+
+} // namespace
+
+int main()
+{
+    CheckProcedural();
+    CheckFlat();
+    CheckAsset();
+    return Test::Exit("HorizonCullTest");
+}
@@ -0,0 +1,42 @@
+// ۾ ٷ 帮 ׽Ʈ: Ŀ  StressTest (ø For, Then , ܺ  , Init/Shutdown ݺ)
+// + BenchmarkScaling (Ŀ  ޶  ). GCC/Clang TSAN (JobSystemTsanTest)ε 
+//   --quick    , Ŀ 1~2 ϸ (TSANó  )
+#include "TestCheck.h"
+#include "utils/JobSystem.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+    void CheckStress(bool quick)
+    {
+        for (unsigned workers : { 1u, 2u, 4u, 8u }) {
+            const Jobs::StressResult r = Jobs::StressTest(workers, quick ? 3 : 10);
+            std::printf("  stress %u workers: %llu jobs, %.1f ms %s\n", workers, (unsigned long long)r.jobs, r.ms,
+                r.ok ? "" : r.firstError);
+            CHECK(r.ok);
+            CHECK(r.jobs > 0);
+        }
+    }
+
+    void CheckScaling(bool quick)
+    {
+        const std::vector<Jobs::ScalingResult> rs = Jobs::BenchmarkScaling(quick ? 2 : 4);
+        CHECK(rs.size() == (quick ? 2u : 4u));
+        for (const Jobs::ScalingResult& r : rs) {
+            std::printf("  %u workers: For %.2f ms (x%.2f), tiny %.0f ns/job, graph %.2f ms\n",
+                r.workers, r.forMs, r.speedup, r.tinyNsPerJob, r.graphMs);
+            CHECK(r.checksum != 0 && r.checksum == rs[0].checksum);
+        }
+    }
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const bool quick = argc > 1 && !std::strcmp(argv[1], "--quick");
+    CheckStress(quick);
+    CheckScaling(quick);
+    return Test::Exit("JobSystemTest");
+}
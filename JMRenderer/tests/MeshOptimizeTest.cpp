@@ -0,0 +1,106 @@
+//  ĳ ȭ 帮 ׽Ʈ: ĳ ùķ հ , ġ Ŀ  ﰢ(и  ),
+//  ȣ  + ó ̴ , ġ  ACMR 
+#include "TestCheck.h"
+#include "grid/MeshOptimize.h"
+#include <algorithm>
+#include <array>
+#include <vector>
+
+using namespace MeshOpt;
+
+namespace {
+
+    // GridMesh::InitPatch  и   켱 ġ ε
+    std::vector<uint32_t> PatchIndices(int res)
+    {
+        const int vn = res + 1, h = res / 2;
+        std::vector<uint32_t> out;
+        for (int q = 0; q < 4; ++q) {
+            const int x0 = (q & 1) * h, z0 = (q >> 1) * h;
+            for (int z = z0; z < z0 + h; ++z)
+                for (int x = x0; x < x0 + h; ++x) {
+                    const uint32_t i0 = z * vn + x, i1 = i0 + 1, i2 = i0 + vn, i3 = i2 + 1;
+                    for (uint32_t v : { i0, i2, i1, i1, i2, i3 }) out.push_back(v);
+                }
+        }
+        return out;
+    }
+
+    //    ä   ȣ տ   ﰢ  (inv:  ȣ   ȣ)
+    std::vector<std::array<uint32_t, 3>> Triangles(const uint32_t* idx, size_t count, const std::vector<uint32_t>* inv)
+    {
+        std::vector<std::array<uint32_t, 3>> t;
+        for (size_t i = 0; i + 2 < count; i += 3) {
+            std::array<uint32_t, 3> a{ idx[i], idx[i + 1], idx[i + 2] };
+            if (inv) for (auto& v : a) v = (*inv)[v];
+            std::rotate(a.begin(), std::min_element(a.begin(), a.end()), a.end());
+            t.push_back(a);
+        }
+        std::sort(t.begin(), t.end());
+        return t;
+    }
+
+    void CheckSimulator()
+    {
+        //  ﰢ  :  3 ȯ
+        const uint32_t twice[] = { 0, 1, 2, 0, 1, 2 };
+        CacheStats s = Simulate(twice, 6, 3, 3, CacheModel::FIFO);
+        CHECK(s.triangles == 2 && s.vertices == 3 && s.transforms == 3);
+        CHECK(s.acmr == 1.5 && s.atvr == 1.0);
+
+        // ĳ 3ĭ: 0,1,2  2,1 , 3 0 о  3,1 , 0 ̽ (   5)
+        const uint32_t seq[] = { 0, 1, 2, 2, 1, 3, 3, 1, 0 };
+        CHECK(Simulate(seq, 9, 4, 3, CacheModel::FIFO).transforms == 5);
+        CHECK(Simulate(seq, 9, 4, 3, CacheModel::LRU).transforms == 5);
+
+        //   :  ° ﰢ 0   3  
+        // FIFO 0, LRU 1 о  FIFO 6 (0, 1 ٽ ̽) / LRU 5 (1 ٽ ̽)
+        const uint32_t fifo[] = { 0, 1, 2, 0, 3, 1, 0, 3, 1 };
+        CHECK(Simulate(fifo, 9, 4, 3, CacheModel::FIFO).transforms == 6);
+        CHECK(Simulate(fifo, 9, 4, 3, CacheModel::LRU).transforms == 5);
+    }
+
+    void CheckPatchOptimize(int res)
+    {
+        std::vector<uint32_t> idx = PatchIndices(res);
+        const std::vector<uint32_t> orig = idx;
+        const size_t vc = (size_t)(res + 1) * (res + 1);
+        const size_t quarter = idx.size() / 4;
+
+        for (int q = 0; q < 4; ++q) OptimizeVertexCache(idx.data() + q * quarter, quarter, vc, 32);
+        std::vector<uint32_t> remap;
+        OptimizeVertexFetch(idx.data(), idx.size(), vc, remap);
+
+        // remap ,  ȣ ó ̴  0, 1, 2 ...
+        std::vector<uint32_t> inv(vc, ~0u);
+        for (size_t i = 0; i < vc; ++i) if (remap[i] < vc) inv[remap[i]] = (uint32_t)i;
+        CHECK(std::find(inv.begin(), inv.end(), ~0u) == inv.end());
+        uint32_t next = 0;
+        bool firstUse = true;
+        for (uint32_t v : idx) {
+            if (v > next) firstUse = false;
+            if (v == next) ++next;
+        }
+        CHECK(firstUse);
+
+        // и   ﰢ  (QuadrantIndexCount  ο )
+        for (int q = 0; q < 4; ++q)
+            CHECK(Triangles(orig.data() + q * quarter, quarter, nullptr) == Triangles(idx.data() + q * quarter, quarter, &inv));
+
+        for (CacheModel m : { CacheModel::FIFO, CacheModel::LRU }) {
+            const CacheStats before = Simulate(orig.data(), orig.size(), vc, 16, m);
+            const CacheStats after = Simulate(idx.data(), idx.size(), vc, 16, m);
+            CHECK(before.triangles == after.triangles && before.vertices == after.vertices);
+            CHECK(after.acmr < before.acmr);
+            CHECK(after.acmr < 0.75);
+        }
+    }
+
+} // namespace
+
+int main()
+{
+    CheckSimulator();
+    for (int res : { 16, 32, 64 }) CheckPatchOptimize(res);
+    return Test::Exit("MeshOptimizeTest");
+}
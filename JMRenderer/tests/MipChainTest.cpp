@@ -0,0 +1,83 @@
+// ü 帮 ׽Ʈ:  ũ Ģ,  ڽ (double) ,  հ 
+#include "TestCheck.h"
+#include "utils/JobSystem.h"
+#include "utils/MipChain.h"
+#include <utility>
+
+namespace {
+
+    // sRGB LUT պ ݿø  1 LSB,  Ȯ ƾ Ѵ
+    int Tolerance(MipFilter f) { return f == MipFilter::SRGB ? 1 : 0; }
+
+    void CheckAgainstReference()
+    {
+        const std::pair<unsigned, unsigned> sizes[] = { { 225, 225 }, { 196, 185 }, { 1, 37 }, { 3, 1 }, { 1024, 512 } };
+        for (unsigned ch : { 1u, 4u })
+            for (MipFilter f : { MipFilter::Linear, MipFilter::SRGB, MipFilter::Min, MipFilter::Max })
+                for (auto wh : sizes) {
+                    const Mip::CheckResult r = Mip::SelfCheck(wh.first, wh.second, ch, f);
+                    CHECK(r.bytes > 0);
+                    CHECK(r.maxError <= Tolerance(f));
+                }
+    }
+
+    void CheckLevels()
+    {
+        CHECK(Mip::LevelCount(1, 1) == 1);
+        CHECK(Mip::LevelCount(256, 256) == 9);
+        CHECK(Mip::LevelCount(196, 185) == 8);
+        CHECK(Mip::LevelCount(1, 37) == 6);
+
+        std::vector<uint8_t> img(196 * 185 * 4, 0x80);
+        MipChain chain;
+        Mip::Build(img.data(), 196, 185, 196 * 4, 4, MipFilter::SRGB, chain);
+        CHECK(chain.levels.size() == Mip::LevelCount(196, 185));
+        CHECK(chain.levels[0].data == img.data());     //  0  ʴ´
+        unsigned w = 196, h = 185;
+        for (const MipLevel& l : chain.levels) {
+            CHECK(l.width == w && l.height == h);
+            CHECK(l.rowPitch >= (size_t)l.width * 4);
+            w = w > 1 ? w >> 1 : 1;
+            h = h > 1 ? h >> 1 : 1;
+        }
+        // ܻ  ͷ ٿ ܻ
+        const MipLevel& last = chain.levels.back();
+        CHECK(last.width == 1 && last.height == 1 && last.data[0] == 0x80 && last.data[3] == 0x80);
+
+        MipChain none;
+        Mip::Build(img.data(), 196, 185, 196 * 4, 4, MipFilter::None, none);
+        CHECK(none.levels.size() == 1 && none.StorageBytes() == 0);
+    }
+
+    void CheckSmallExample()
+    {
+        // 4x2 R8  2x1
+        const uint8_t src[8] = { 10, 20, 0, 255,
+                                 30, 41, 100, 1 };
+        MipChain lin, mn, mx;
+        Mip::Build(src, 4, 2, 4, 1, MipFilter::Linear, lin);
+        Mip::Build(src, 4, 2, 4, 1, MipFilter::Min, mn);
+        Mip::Build(src, 4, 2, 4, 1, MipFilter::Max, mx);
+        CHECK(lin.levels.size() == 3 && lin.levels[1].width == 2 && lin.levels[1].height == 1);
+        CHECK(lin.levels[1].data[0] == 25);     // (10+20+30+41)/4 = 25.25
+        CHECK(lin.levels[1].data[1] == 89);     // (0+255+100+1)/4 = 89
+        CHECK(mn.levels[1].data[0] == 10 && mn.levels[1].data[1] == 0);
+        CHECK(mx.levels[1].data[0] == 41 && mx.levels[1].data[1] == 255);
+        CHECK(mn.levels[2].data[0] == 0 && mx.levels[2].data[0] == 255);
+    }
+
+} // namespace
+
+int main()
+{
+    CheckLevels();
+    CheckSmallExample();
+    CheckAgainstReference();
+
+    //   ۾ ٷ Ŀ Ѿ  
+    Jobs::Init(4);
+    CheckAgainstReference();
+    Jobs::Shutdown();
+
+    return Test::Exit("MipChainTest");
+}
@@ -0,0 +1,94 @@
+//  ũ  帮 ׽Ʈ:   Ϻθ ٲٰ Ƽ ุ ٽ ũ 
+// ٲ  ü  ũ Ͱ  (߰ , εǴ 0, Ķ ,  )
+#include "TestCheck.h"
+#include "terrain/TerrainNormalBake.h"
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+    const int kW = 64, kH = 48;
+
+    std::vector<uint8_t> RandomHeights(unsigned seed)
+    {
+        std::mt19937 rng(seed);
+        std::vector<uint8_t> px((size_t)kW * kH);
+        for (uint8_t& v : px) v = (uint8_t)(rng() & 0xFF);
+        return px;
+    }
+
+    //  [y0, y1) ٸ 
+    void Scribble(std::vector<uint8_t>& px, int y0, int y1, unsigned seed)
+    {
+        std::mt19937 rng(seed);
+        for (int y = y0; y < y1; ++y)
+            for (int x = 0; x < kW; ++x) px[(size_t)y * kW + x] = (uint8_t)(rng() & 0xFF);
+    }
+
+    bool SameAsFullBake(const NormalBakeBuffer& b, const std::vector<uint8_t>& px, const NormalBakeParams& p)
+    {
+        std::vector<uint8_t> ref((size_t)kW * kH * 4);
+        TerrainBake::NormalHeight(px.data(), kW, kH, p, ref.data(), 0, kH);
+        return std::memcmp(ref.data(), b.Texels(), ref.size()) == 0;
+    }
+
+    void DrainAll(NormalBakeBuffer& b)
+    {
+        int y0, y1;
+        while (b.BakeDirty(kH, y0, y1) > 0) {}
+    }
+
+    void CheckBand(NormalBakeFilter filter)
+    {
+        NormalBakeParams p;
+        p.gridSizeX = 7.0f; p.gridSizeZ = 5.0f; p.heightScale = 3.0f;
+        p.filter = filter;
+        std::vector<uint8_t> px = RandomHeights(1);
+        NormalBakeBuffer b;
+        CHECK(b.Init(px.data(), kW, kH, p));
+        CHECK(b.PendingRows() == 0);
+        CHECK(SameAsFullBake(b, px, p));
+
+        // ߰ : ٲ 4 + Ʒ  
+        Scribble(px, 10, 14, 2);
+        b.SetRows(px.data(), 10, 14);
+        CHECK(b.PendingRows() == 6);
+        int y0, y1;
+        CHECK(b.BakeDirty(kH, y0, y1) == 6 && y0 == 9 && y1 == 15);
+        CHECK(b.PendingRows() == 0);
+        CHECK(SameAsFullBake(b, px, p));
+
+        // 0:  ̿      
+        Scribble(px, 0, 1, 3);
+        b.SetRows(px.data(), 0, 1);
+        CHECK(b.PendingRows() == 3);
+        CHECK(b.BakeDirty(kH, y0, y1) == 2 && y0 == 0 && y1 == 2);
+        CHECK(b.BakeDirty(kH, y0, y1) == 1 && y0 == kH - 1 && y1 == kH);
+        CHECK(SameAsFullBake(b, px, p));
+
+        //  :   maxRows
+        Scribble(px, 20, 40, 4);
+        b.SetRows(px.data(), 20, 40);
+        CHECK(b.BakeDirty(5, y0, y1) == 5 && y0 == 19 && y1 == 24);
+        CHECK(b.PendingRows() == 22 - 5);
+        DrainAll(b);
+        CHECK(SameAsFullBake(b, px, p));
+
+        //  Ķʹ , ٲ ü
+        CHECK(!b.SetParams(p));
+        p.heightScale = 9.0f;
+        CHECK(b.SetParams(p));
+        CHECK(b.PendingRows() == kH);
+        DrainAll(b);
+        CHECK(SameAsFullBake(b, px, p));
+    }
+
+} // namespace
+
+int main()
+{
+    CheckBand(NormalBakeFilter::Central);
+    CheckBand(NormalBakeFilter::Sobel);
+    return Test::Exit("NormalMapTest");
+}
@@ -0,0 +1,147 @@
+// CPU Ϸ 帮 ׽Ʈ: ø , 庰 , ̸ հ(self  total),
+//     ,  ħ , Chrome Ʈ̽ 
+#include "TestCheck.h"
+#include "utils/Profiler.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+namespace {
+
+    void Spin(uint64_t ns)
+    {
+        const uint64_t end = Prof::NowNs() + ns;
+        while (Prof::NowNs() < end) {}
+    }
+
+    const Prof::ZoneStat* Find(const std::vector<Prof::ZoneStat>& stats, const char* name)
+    {
+        for (const Prof::ZoneStat& s : stats)
+            if (!std::strcmp(s.name, name)) return &s;
+        return nullptr;
+    }
+
+    void CheckNesting()
+    {
+        { JM_PROFILE_ZONE("before frame"); }     //     Ѵ
+
+        Prof::BeginFrame();
+        {
+            JM_PROFILE_ZONE("outer");
+            Spin(200000);
+            for (int i = 0; i < 3; ++i) {
+                JM_PROFILE_ZONE("inner");
+                Spin(100000);
+                { JM_PROFILE_ZONE("leaf"); Spin(50000); }
+            }
+        }
+        std::thread worker([] {
+            Prof::SetThreadName("test worker");
+            JM_PROFILE_ZONE("worker");
+            Spin(100000);
+        });
+        worker.join();
+        Prof::EndFrame();
+
+        const Prof::FrameCapture& f = Prof::LastFrame();
+        CHECK(f.endNs > f.beginNs);
+        CHECK(f.events.size() == 1 + 3 + 3 + 1);
+        CHECK(f.threads.size() == 2);
+        CHECK(f.dropped == 0);
+
+        uint32_t mainThread = ~0u;
+        for (const Prof::Event& e : f.events) {
+            CHECK(e.beginNs >= f.beginNs && e.endNs <= f.endNs && e.beginNs <= e.endNs);
+            CHECK(std::strcmp(e.name, "before frame") != 0);
+            if (!std::strcmp(e.name, "outer")) { CHECK(e.depth == 0); mainThread = e.thread; }
+            if (!std::strcmp(e.name, "inner")) CHECK(e.depth == 1);
+            if (!std::strcmp(e.name, "leaf")) CHECK(e.depth == 2);
+            if (!std::strcmp(e.name, "worker")) CHECK(e.depth == 0);
+        }
+        bool named = false;
+        for (const Prof::ThreadInfo& t : f.threads)
+            if (t.thread != mainThread) named = !std::strcmp(t.name, "test worker");
+        CHECK(named);
+
+        std::vector<Prof::ZoneStat> stats;
+        Prof::Summarize(f, stats);
+        const Prof::ZoneStat* outer = Find(stats, "outer");
+        const Prof::ZoneStat* inner = Find(stats, "inner");
+        const Prof::ZoneStat* leaf = Find(stats, "leaf");
+        CHECK(outer && inner && leaf && Find(stats, "worker"));
+        if (outer && inner && leaf) {
+            CHECK(outer->calls == 1 && inner->calls == 3 && leaf->calls == 3);
+            CHECK(outer->totalMs >= inner->totalMs && inner->totalMs >= leaf->totalMs);
+            CHECK(outer->selfMs <= outer->totalMs && inner->selfMs <= inner->totalMs);
+            CHECK(leaf->selfMs == leaf->totalMs);
+            CHECK(outer->totalMs >= 0.2 + 3 * 0.15 - 0.01);
+        }
+        for (size_t i = 1; i < stats.size(); ++i) CHECK(stats[i - 1].totalMs >= stats[i].totalMs);
+    }
+
+    //  ӿ   :  ŭ dropped,    ũ 
+    void CheckOverflow()
+    {
+        Prof::BeginFrame();
+        const size_t n = Prof::kRingEvents + 1000;
+        for (size_t i = 0; i < n; ++i) { JM_PROFILE_ZONE("tiny"); }
+        Prof::EndFrame();
+        const Prof::FrameCapture& f = Prof::LastFrame();
+        CHECK(f.events.size() <= Prof::kRingEvents);
+        CHECK(f.events.size() + f.dropped == n);
+
+        //   ٽ ϰ
+        Prof::BeginFrame();
+        { JM_PROFILE_ZONE("after"); }
+        Prof::EndFrame();
+        CHECK(Prof::LastFrame().events.size() == 1 && Prof::LastFrame().dropped == 0);
+    }
+
+    void CheckPauseAndHistory()
+    {
+        Prof::BeginFrame();
+        { JM_PROFILE_ZONE("kept"); }
+        Prof::EndFrame();
+        Prof::SetPaused(true);
+        Prof::BeginFrame();
+        { JM_PROFILE_ZONE("hidden"); }
+        Prof::EndFrame();
+        Prof::SetPaused(false);
+        const Prof::FrameCapture& f = Prof::LastFrame();
+        CHECK(f.events.size() == 1 && !std::strcmp(f.events[0].name, "kept"));
+
+        float history[Prof::kHistory];
+        Prof::FrameHistory(history);
+        CHECK(history[Prof::kHistory - 1] >= 0.0f && history[Prof::kHistory - 1] < 1000.0f);
+    }
+
+    void CheckChromeTrace()
+    {
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "jm_profiler_test.json";
+        const size_t written = Prof::WriteChromeTrace(path);
+        CHECK(written > 0);
+        std::ifstream in(path);
+        const std::string json((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        CHECK(!json.empty() && json.find("\"outer\"") != std::string::npos);
+        CHECK(json.find("test worker") != std::string::npos);
+        in.close();
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+
+} // namespace
+
+int main()
+{
+#if JM_PROFILE
+    Prof::SetThreadName("main");
+    CheckNesting();
+    CheckChromeTrace();
+    CheckOverflow();
+    CheckPauseAndHistory();
+#endif
+    return Test::Exit("ProfilerTest");
+}
@@ -0,0 +1,177 @@
+// Ʈ LOD  帮 ׽Ʈ: õ и  ƴ/ħ    ,
+// ̿ и LOD ̰ 1 ,   ̸    ʴ,
+//  AABB ü ø(main Terrain Cull  )  常 
+#include "TestCheck.h"
+#include "terrain/TerrainNoise.h"
+#include "terrain/TerrainQuadTree.h"
+#include "utils/FrustumCull.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+    //    (и ϳ = 2^lod ĭ)    ģ
+    struct Coverage {
+        int side = 0;
+        std::vector<int> count;
+        std::vector<int> lod;
+    };
+
+    Coverage Rasterize(const TerrainQuadTree& tree, const std::vector<TerrainDraw>& draws)
+    {
+        const TerrainQuadTreeDesc& qd = tree.Desc();
+        Coverage c;
+        c.side = 1 << qd.lodCount;
+        c.count.assign((size_t)c.side * c.side, 0);
+        c.lod.assign((size_t)c.side * c.side, -1);
+        for (const TerrainDraw& d : draws) {
+            const int q = 1 << d.lod;
+            const int cx = (int)std::lround((d.x - qd.originX) / qd.sizeX * c.side);
+            const int cz = (int)std::lround((d.z - qd.originZ) / qd.sizeZ * c.side);
+            CHECK((int)std::lround(d.sizeX / qd.sizeX * c.side) == 2 * q);
+            for (int b = 0; b < 4; ++b) {
+                if (!((d.quadMask >> b) & 1)) continue;
+                const int x0 = cx + (b & 1) * q, z0 = cz + (b >> 1) * q;
+                for (int z = z0; z < z0 + q; ++z)
+                    for (int x = x0; x < x0 + q; ++x) {
+                        if (x < 0 || z < 0 || x >= c.side || z >= c.side) { CHECK(false); continue; }
+                        ++c.count[(size_t)z * c.side + x];
+                        c.lod[(size_t)z * c.side + x] = d.lod;
+                    }
+            }
+        }
+        return c;
+    }
+
+    TerrainQuadTree MakeTree(std::vector<uint8_t>& px, int size)
+    {
+        NoiseParams np;
+        np.type = NoiseType::Ridged;
+        px = TerrainNoise::GenerateR8(np, size, size);
+        TerrainQuadTreeDesc qd{};
+        qd.lodCount = TerrainQuadTree::SuggestLodCount(size, size, qd.patchRes);
+        TerrainQuadTree tree;
+        tree.Build(qd, px.data(), size, size);
+        return tree;
+    }
+
+    const float kCams[][3] = {
+        { 0.0f, 0.3f, 0.0f }, { -4.9f, 0.2f, -4.9f }, { 3.0f, 1.0f, -1.5f },
+        { 12.0f, 2.0f, 0.0f }, { 0.5f, 8.0f, 0.5f },
+    };
+
+    //  ĭ Ȯ  , ̿ ĭ LOD ̴ 1 
+    void CheckCoverage()
+    {
+        std::vector<uint8_t> px;
+        TerrainQuadTree tree = MakeTree(px, 512);
+        std::vector<TerrainDraw> draws;
+        for (const float* cam : kCams) {
+            for (float err : { 0.5f, 2.0f, 8.0f }) {
+                TerrainSelectParams sp;
+                sp.camPos[0] = cam[0]; sp.camPos[1] = cam[1]; sp.camPos[2] = cam[2];
+                sp.heightScale = 1.5f;
+                sp.pixelError = err;
+                tree.Select(sp, draws);
+                const Coverage c = Rasterize(tree, draws);
+                int bad = 0, jumps = 0;
+                for (int z = 0; z < c.side; ++z)
+                    for (int x = 0; x < c.side; ++x) {
+                        const size_t i = (size_t)z * c.side + x;
+                        bad += c.count[i] != 1;
+                        if (x + 1 < c.side) jumps += std::abs(c.lod[i] - c.lod[i + 1]) > 1;
+                        if (z + 1 < c.side) jumps += std::abs(c.lod[i] - c.lod[i + c.side]) > 1;
+                    }
+                CHECK(bad == 0);
+                CHECK(jumps == 0);
+            }
+        }
+    }
+
+    //   ̸ и  ðų ,   ᱹ LOD 0 
+    void CheckMonotonic()
+    {
+        std::vector<uint8_t> px;
+        TerrainQuadTree tree = MakeTree(px, 512);
+        std::vector<TerrainDraw> draws;
+        for (const float* cam : kCams) {
+            int prev = 0;
+            int finest = 0;
+            for (float err : { 64.0f, 16.0f, 8.0f, 4.0f, 2.0f, 1.0f, 0.5f, 0.25f }) {
+                TerrainSelectParams sp;
+                sp.camPos[0] = cam[0]; sp.camPos[1] = cam[1]; sp.camPos[2] = cam[2];
+                sp.pixelError = err;
+                tree.Select(sp, draws);
+                CHECK(tree.Stats().quadCount >= prev);
+                CHECK(tree.Stats().drawCount == (int)draws.size());
+                prev = tree.Stats().quadCount;
+                finest = 99;
+                for (const TerrainDraw& d : draws) finest = std::min(finest, (int)d.lod);
+            }
+            if (cam[0] > -5.0f && cam[0] < 5.0f && cam[1] < 1.5f) CHECK(finest == 0);
+        }
+    }
+
+    // ڽ    ٱ̸   (FrustumAABBs  )
+    bool OutsideFrustum(const Frustum& f, const TerrainDraw& d)
+    {
+        const float lo[3] = { d.x, d.minY, d.z };
+        const float hi[3] = { d.x + d.sizeX, d.maxY, d.z + d.sizeZ };
+        for (const float* p : f.planes) {
+            //      
+            float s = p[3];
+            for (int a = 0; a < 3; ++a) s += p[a] * (p[a] >= 0.0f ? hi[a] : lo[a]);
+            if (s < 0.0f) return true;
+        }
+        return false;
+    }
+
+    void CheckFrustum()
+    {
+        std::vector<uint8_t> px;
+        TerrainQuadTree tree = MakeTree(px, 512);
+        TerrainSelectParams sp;
+        sp.camPos[0] = -2.0f; sp.camPos[1] = 0.6f; sp.camPos[2] = -1.0f;
+        sp.heightScale = 1.5f;
+        std::vector<TerrainDraw> draws;
+        tree.Select(sp, draws);
+
+        const float target[3] = { 3.0f, 0.2f, 1.0f };
+        float vp[16];
+        Cull::LookAtViewProj(sp.camPos, target, sp.fovY, 16.0f / 9.0f, 0.05f, 100.0f, vp);
+        const Frustum f = Frustum::FromViewProj(vp);
+
+        AABBSoA boxes;
+        for (const TerrainDraw& d : draws) boxes.Push(d.x, d.minY, d.z, d.x + d.sizeX, d.maxY, d.z + d.sizeZ);
+        std::vector<uint32_t> visible(draws.size());
+        visible.resize(Cull::FrustumAABBs(f, boxes, visible.data()));
+
+        std::vector<uint8_t> kept(draws.size(), 0);
+        for (uint32_t i : visible) kept[i] = 1;
+        int culled = 0, culledBehind = 0;
+        for (size_t i = 0; i < draws.size(); ++i) {
+            const TerrainDraw& d = draws[i];
+            CHECK(kept[i] == !OutsideFrustum(f, d));
+            if (kept[i]) continue;
+            ++culled;
+            // ī޶  (ü -X  ʸ)   
+            culledBehind += d.x + d.sizeX < sp.camPos[0] - 0.5f;
+        }
+        int behind = 0;
+        for (const TerrainDraw& d : draws) behind += d.x + d.sizeX < sp.camPos[0] - 0.5f;
+        CHECK(!visible.empty());
+        CHECK(culled > 0);
+        CHECK(behind > 0 && culledBehind == behind);
+    }
+
+} // namespace
+
+int main()
+{
+    CheckCoverage();
+    CheckMonotonic();
+    CheckFrustum();
+    return Test::Exit("QuadTreeTest");
+}
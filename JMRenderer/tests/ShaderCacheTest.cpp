@@ -0,0 +1,271 @@
+// ̴ Ʈڵ ĳ 帮 ׽Ʈ ( Ϸ: #include ġ ؽƮ ״ Ʈڵ)
+//   , Ű Է( /define/flags/entry/profile) ٲ ̽, д   ,
+// ջ ׸ , ũ  LRU ü,    Compile,  Ű  define պ
+#include "TestCheck.h"
+#include "render/ShaderCache.h"
+#include "render/ShaderPermutation.h"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    class StubCompiler : public ShaderCompiler {
+    public:
+        std::atomic<int> compiles{ 0 };
+
+        const char* Identity() const override { return "stub 1"; }
+
+        bool Preprocess(const ShaderCompileDesc& d, std::string& text,
+                        std::vector<fs::path>& includes, std::string& errors) override
+        {
+            for (const ShaderDefine& def : d.defines) text += "#define " + def.name + " " + def.value + "\n";
+            return Expand(d.path, text, includes, errors);
+        }
+
+        // "ERROR"   .   ô  ܴ (savedMs Ȯο)
+        bool Compile(const ShaderCompileDesc& d, const std::string& text,
+                     std::vector<uint8_t>& bytecode, std::string& errors) override
+        {
+            ++compiles;
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            if (text.find("ERROR") != std::string::npos) { errors = "syntax"; return false; }
+            bytecode.assign(text.begin(), text.end());
+            bytecode.insert(bytecode.end(), d.entry.begin(), d.entry.end());
+            return true;
+        }
+
+    private:
+        bool Expand(const fs::path& path, std::string& text, std::vector<fs::path>& includes, std::string& errors)
+        {
+            std::ifstream in(path);
+            if (!in) { errors = "missing " + path.string(); return false; }
+            const std::string kInclude = "#include \"";
+            std::string line;
+            while (std::getline(in, line)) {
+                if (line.compare(0, kInclude.size(), kInclude) == 0) {
+                    const fs::path inc = path.parent_path() / line.substr(kInclude.size(), line.size() - kInclude.size() - 1);
+                    includes.push_back(inc);
+                    if (!Expand(inc, text, includes, errors)) return false;
+                } else {
+                    text += line + "\n";
+                }
+            }
+            return true;
+        }
+    };
+
+    void WriteText(const fs::path& path, const char* text)
+    {
+        std::ofstream(path) << text;
+    }
+
+    ShaderCompileDesc WithDefine(ShaderCompileDesc d, const char* name, const std::string& value)
+    {
+        d.defines = { { name, value } };
+        return d;
+    }
+
+    void CheckHitsAndKeys(const fs::path& root, StubCompiler& stub, const ShaderCompileDesc& d)
+    {
+        ShaderCompileOutput o;
+        {
+            ShaderCache c;
+            CHECK(c.Init(root / "cache", 1u << 20, &stub));
+            CHECK(c.Compile(d, o) && !o.cacheHit && o.includes.size() == 1);
+            CHECK(c.Compile(d, o) && o.cacheHit && !o.bytecode.empty());
+            const ShaderCacheStats s = c.Stats();
+            CHECK(s.hits == 1 && s.misses == 1 && s.entries == 1 && s.savedMs > 0.0);
+        }
+
+        // : ũ ׸񿡼 ,  
+        ShaderCache c;
+        CHECK(c.Init(root / "cache", 1u << 20, &stub));
+        const int before = stub.compiles;
+        CHECK(c.Compile(d, o) && o.cacheHit && stub.compiles == before);
+        CHECK(c.Stats().entries == 1);
+
+        //   , define, flags, entry, profile  ϳ ٲ ̽
+        WriteText(root / "src" / "common.hlsli", "float4 common2;\n");
+        CHECK(c.Compile(d, o) && !o.cacheHit);
+        const ShaderCompileDesc defined = WithDefine(d, "FOO", "1");
+        CHECK(c.Compile(defined, o) && !o.cacheHit);
+        CHECK(c.Compile(defined, o) && o.cacheHit);
+        ShaderCompileDesc v = d;
+        v.flags = 1;
+        CHECK(c.Compile(v, o) && !o.cacheHit);
+        v = d;
+        v.entry = "Other";
+        CHECK(c.Compile(v, o) && !o.cacheHit);
+        v = d;
+        v.profile = "ps_5_0";
+        CHECK(c.Compile(v, o) && !o.cacheHit);
+
+        // define ̸/ 谡 Ű ƾ Ѵ (AB=C A=BC ٸ Ű)
+        CHECK(!(ShaderCache::MakeKey(WithDefine(d, "AB", "C"), "x", {}, "s") ==
+                ShaderCache::MakeKey(WithDefine(d, "A", "BC"), "x", {}, "s")));
+
+        // д  ʴ´  ٽ ҷ ,  ڿ 
+        ShaderCompileDesc bad = d;
+        bad.path = root / "src" / "bad.hlsl";
+        WriteText(bad.path, "ERROR\n");
+        CHECK(!c.Compile(bad, o) && o.errors == "syntax");
+        CHECK(!c.Compile(bad, o));
+        CHECK(c.Stats().failures == 2);
+        ShaderCompileDesc missing = d;
+        missing.path = root / "src" / "missing.hlsl";
+        CHECK(!c.Compile(missing, o));
+
+        // ջ ׸:  ٽ ,  
+        const std::string text = "float4 common2;\nfloat4 main() { return 0; }\n";
+        const fs::path entry = root / "cache" / (ShaderCache::KeyName(
+            ShaderCache::MakeKey(d, text, { root / "src" / "common.hlsli" }, stub.Identity())) + ".bin");
+        CHECK(fs::exists(entry));
+        {
+            std::fstream f(entry, std::ios::in | std::ios::out | std::ios::binary);
+            f.seekp(50);
+            f.put('Z');
+        }
+        CHECK(c.Compile(d, o) && !o.cacheHit);
+        CHECK(c.Stats().corrupt == 1);
+        CHECK(c.Compile(d, o) && o.cacheHit);
+    }
+
+    // 10    4.5 ̸ ֱ 4 ,  ڿ   ȴ
+    void CheckEviction(const fs::path& root, StubCompiler& stub, const ShaderCompileDesc& d)
+    {
+        ShaderCompileOutput o;
+        ShaderCache c;
+        CHECK(c.Init(root / "lru", 100000, &stub));
+        std::vector<ShaderCompileDesc> variants;
+        for (int i = 0; i < 10; ++i) {
+            variants.push_back(WithDefine(d, "V", std::to_string(i)));
+            CHECK(c.Compile(variants.back(), o));
+        }
+        const size_t one = c.Stats().bytes / 10;
+        CHECK(c.Compile(variants[0], o) && o.cacheHit);
+        c.SetMaxBytes(one * 4 + one / 2);
+        const ShaderCacheStats s = c.Stats();
+        CHECK(s.entries == 4 && s.evictions == 6);
+        CHECK(c.Compile(variants[0], o) && o.cacheHit);
+        CHECK(c.Compile(variants[9], o) && o.cacheHit);
+        CHECK(c.Compile(variants[1], o) && !o.cacheHit);
+
+        //   ð ػ󵵺   :  ֱٿ  1 ´
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        ShaderCache restarted;
+        CHECK(restarted.Init(root / "lru", one * 2 + one / 2, &stub));
+        CHECK(restarted.Compile(variants[1], o) && o.cacheHit);
+        int tmp = 0;
+        for (const fs::directory_entry& e : fs::directory_iterator(root / "lru"))
+            if (e.path().extension() == ".tmp") ++tmp;
+        CHECK(tmp == 0);
+    }
+
+    void CheckThreads(const fs::path& root, StubCompiler& stub, const ShaderCompileDesc& d)
+    {
+        ShaderCache c;
+        CHECK(c.Init(root / "mt", 1u << 20, &stub));
+        std::atomic<int> bad{ 0 };
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 8; ++t)
+            threads.emplace_back([&, t] {
+                for (int i = 0; i < 40; ++i) {
+                    ShaderCompileOutput o;
+                    if (!c.Compile(WithDefine(d, "V", std::to_string((i * 7 + t) % 16)), o) || o.bytecode.empty()) ++bad;
+                }
+            });
+        for (std::thread& t : threads) t.join();
+        const ShaderCacheStats s = c.Stats();
+        CHECK(bad == 0);
+        CHECK(s.entries == 16);
+        CHECK(s.hits + s.misses == 8 * 40);
+    }
+
+    // define   Ű (̸  ã´. 𸣴 ̸/ߺ̸ KeySpace())
+    uint32_t KeyFromDefines(const ShaderPermutations& perms, const std::vector<ShaderDefine>& defines)
+    {
+        uint32_t key = 0;
+        std::vector<bool> seen(perms.FeatureCount(), false);
+        for (const ShaderDefine& def : defines) {
+            size_t i = 0;
+            while (i < perms.FeatureCount() && perms.Feature(i).name != def.name) ++i;
+            if (i == perms.FeatureCount() || seen[i]) return perms.KeySpace();
+            seen[i] = true;
+            key = perms.Set(key, i, (uint32_t)std::stoul(def.value));
+        }
+        return key;
+    }
+
+    //  ȿ Ű: ɸ define ϳ,  maxValue , define   ٸ ٽ  Ű
+    //   ϳϳ( Ʈ) Ű  ,   /Ű ɷ
+    void CheckPermutations()
+    {
+        const ShaderPermutations perms({ { "FOG", 1 }, { "SPLAT_COUNT", 3 }, { "BAKED_NORMALS", 1 }, { "TAPS", 2 } });
+        CHECK(perms.KeyBits() == 6);
+
+        const std::vector<uint32_t> keys = perms.AllKeys();
+        CHECK(keys.size() == 2u * 4u * 2u * 3u);
+        std::set<std::string> seen;
+        uint32_t usedBits = 0;
+        for (uint32_t key : keys) {
+            std::vector<ShaderDefine> defines;
+            perms.Defines(key, defines);
+            CHECK(defines.size() == perms.FeatureCount());
+            std::string flat;
+            for (const ShaderDefine& def : defines) flat += def.name + '=' + def.value + ';';
+            CHECK(seen.insert(flat).second);
+            CHECK(KeyFromDefines(perms, defines) == key);
+            usedBits |= key;
+        }
+        CHECK(usedBits == perms.KeySpace() - 1);
+
+        for (size_t f = 0; f < perms.FeatureCount(); ++f) {
+            const uint32_t maxValue = perms.Feature(f).maxValue;
+            for (uint32_t v = 0; v <= maxValue; ++v) {
+                const uint32_t key = perms.Set(0, f, v);
+                CHECK(perms.Get(key, f) == v && perms.Valid(key));
+                for (size_t g = 0; g < perms.FeatureCount(); ++g)
+                    if (g != f) CHECK(perms.Get(key, g) == 0);
+            }
+            CHECK(perms.Get(perms.Set(0, f, maxValue + 5), f) == maxValue);
+        }
+        // TAPS 2Ʈ 3 ȿ ʴ
+        CHECK(!perms.Valid(3u << 4));
+        CHECK(!perms.Valid(perms.KeySpace()));
+        CHECK(perms.Describe(keys.back()) == "FOG=1 SPLAT_COUNT=3 BAKED_NORMALS=1 TAPS=2");
+        CHECK(ShaderPermutations().Describe(0) == "(base)");
+    }
+
+} // namespace
+
+int main()
+{
+    const fs::path root = fs::temp_directory_path() / "jm_shader_cache_test";
+    std::error_code ec;
+    fs::remove_all(root, ec);
+    fs::create_directories(root / "src");
+    WriteText(root / "src" / "common.hlsli", "float4 common;\n");
+    WriteText(root / "src" / "a.hlsl", "#include \"common.hlsli\"\nfloat4 main() { return 0; }\n");
+
+    StubCompiler stub;
+    ShaderCompileDesc d;
+    d.path = root / "src" / "a.hlsl";
+    d.entry = "VSMain";
+    d.profile = "vs_5_0";
+
+    CheckHitsAndKeys(root, stub, d);
+    CheckEviction(root, stub, d);
+    CheckThreads(root, stub, d);
+    CheckPermutations();
+
+    fs::remove_all(root, ec);
+    return Test::Exit("ShaderCacheTest");
+}
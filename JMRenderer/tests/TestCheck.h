@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdio>
+
+// ׽Ʈ    ˻ ũ (ӿũ )
+// CHECK ص  ϰ, main Test::Exit() 
+namespace Test {
+
+    inline int& Failures()
+    {
+        static int n = 0;
+        return n;
+    }
+
+    inline int Exit(const char* name)
+    {
+        if (Failures()) std::printf("%s: %d check(s) failed\n", name, Failures());
+        else            std::printf("%s: ok\n", name);
+        return Failures() ? 1 : 0;
+    }
+
+} // namespace Test
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+        ++Test::Failures(); \
+    } \
+} while (0)
@@ -0,0 +1,179 @@
+// Ÿ   帮 ׽Ʈ:  ռ ̸   Open   /Ÿ ذ 
+//  > 0 2x2 ڽ , ŸϺ min/max, snorm8  (1),   ؼ 0,
+// Ÿ ũ  ƴϰų Ȧ ũ, ߸ų  ջ  Open ź
+#include "TestCheck.h"
+#include "terrain/TerrainTileFile.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    const float kHeightScale = 40.0f, kTexelX = 0.5f, kTexelZ = 0.25f;
+
+    //  ٿ: 2x2 ڽ  (ݿø), Ȧ  /  (1̸ ״   )
+    std::vector<uint8_t> Downsample(const std::vector<uint8_t>& src, int w, int h, int& nw, int& nh)
+    {
+        nw = std::max(1, w >> 1); nh = std::max(1, h >> 1);
+        std::vector<uint8_t> out((size_t)nw * nh);
+        for (int z = 0; z < nh; ++z)
+            for (int x = 0; x < nw; ++x) {
+                const int x0 = 2 * x, x1 = std::min(x0 + 1, w - 1);
+                const int z0 = std::min(2 * z, h - 1), z1 = std::min(2 * z + 1, h - 1);
+                out[(size_t)z * nw + x] = (uint8_t)((src[(size_t)z0 * w + x0] + src[(size_t)z0 * w + x1] +
+                                                     src[(size_t)z1 * w + x0] + src[(size_t)z1 * w + x1] + 2) >> 2);
+            }
+        return out;
+    }
+
+    //  ؼ (gx, gz)   (x, z) snorm8:  ߾ , ؼ   2
+    void RefNormal(const std::vector<uint8_t>& lv, int w, int h, int level, int gx, int gz, long& nx, long& nz)
+    {
+        auto H = [&](int x, int z) { return (float)lv[(size_t)((z + h) % h) * w + (x + w) % w]; };
+        const float k = kHeightScale / 255.0f;
+        const float sx = kTexelX * (float)(1 << level), sz = kTexelZ * (float)(1 << level);
+        const float gxw = -(H(gx + 1, gz) - H(gx - 1, gz)) * k / (2.0f * sx);
+        const float gzw = -(H(gx, gz + 1) - H(gx, gz - 1)) * k / (2.0f * sz);
+        const float inv = 1.0f / std::sqrt(gxw * gxw + 1.0f + gzw * gzw);
+        nx = std::lround(gxw * inv * 127.0f);
+        nz = std::lround(gzw * inv * 127.0f);
+    }
+
+    void CheckRoundTrip(const fs::path& dir, int w, int h, int tileSize)
+    {
+        std::mt19937 rng((unsigned)(w * 31 + h));
+        std::vector<uint8_t> px((size_t)w * h);
+        for (size_t i = 0; i < px.size(); ++i) px[i] = (uint8_t)((i % w) * 3 + (i / w) * 5 + rng() % 7);
+
+        TerrainTileBuildDesc desc;
+        desc.tileSize = tileSize;
+        desc.heightScale = kHeightScale;
+        desc.texelWorldX = kTexelX; desc.texelWorldZ = kTexelZ;
+        const fs::path path = dir / "roundtrip.jmt";
+        TerrainTileBuildStats st;
+        CHECK(TerrainTileFile::Build(path, w, h,
+            [&](int z, int count, uint8_t* dst) { std::memcpy(dst, px.data() + (size_t)z * w, (size_t)count * w); }, desc, &st));
+
+        TerrainTileFile file;
+        CHECK(file.Open(path));
+        if (!file.IsOpen()) return;
+        CHECK(file.Width() == w && file.Height() == h && file.TileSize() == tileSize);
+        CHECK(file.LevelCount() == st.levels);
+        CHECK(file.LevelWidth(file.LevelCount() - 1) == 1 && file.LevelHeight(file.LevelCount() - 1) == 1);
+
+        std::vector<uint8_t> lv = px;
+        int lw = w, lh = h;
+        std::vector<uint8_t> tile((size_t)tileSize * tileSize);
+        size_t badHeight = 0, badNormal = 0, badMinMax = 0, tiles = 0;
+        for (int l = 0; l < file.LevelCount(); ++l) {
+            CHECK(file.LevelWidth(l) == lw && file.LevelHeight(l) == lh);
+            for (int tz = 0; tz < file.TilesZ(l); ++tz)
+                for (int tx = 0; tx < file.TilesX(l); ++tx, ++tiles) {
+                    CHECK(file.ReadTile(l, tx, tz, tile.data()));
+                    CHECK(std::memcmp(tile.data(), file.TileHeights(l, tx, tz), tile.size()) == 0);
+                    const int8_t* n = file.TileNormals(l, tx, tz);
+                    int mn = 255, mx = 0;
+                    for (int z = 0; z < tileSize; ++z)
+                        for (int x = 0; x < tileSize; ++x) {
+                            const int gx = tx * tileSize + x, gz = tz * tileSize + z;
+                            const bool in = gx < lw && gz < lh;
+                            const int ref = in ? lv[(size_t)gz * lw + gx] : 0;
+                            badHeight += tile[(size_t)z * tileSize + x] != ref;
+                            if (!in) continue;
+                            mn = std::min(mn, ref); mx = std::max(mx, ref);
+                            long nx, nz;
+                            RefNormal(lv, lw, lh, l, gx, gz, nx, nz);
+                            const int8_t* t = n + ((size_t)z * tileSize + x) * 2;
+                            badNormal += std::labs(t[0] - nx) > 1 || std::labs(t[1] - nz) > 1;
+                        }
+                    uint8_t a = 0, b = 0;
+                    CHECK(file.TileMinMax(l, tx, tz, a, b));
+                    badMinMax += a != mn || b != mx;
+                }
+            int nw, nh;
+            lv = Downsample(lv, lw, lh, nw, nh);
+            lw = nw; lh = nh;
+        }
+        CHECK(tiles == st.tiles);
+        CHECK(badHeight == 0);
+        CHECK(badNormal == 0);
+        CHECK(badMinMax == 0);
+        CHECK(!file.ReadTile(file.LevelCount(), 0, 0, tile.data()));
+        CHECK(!file.TileHeights(0, file.TilesX(0), 0));
+    }
+
+    std::vector<char> ReadAll(const fs::path& path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    bool OpensAs(const fs::path& path, const std::vector<char>& bytes)
+    {
+        std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), (std::streamsize)bytes.size());
+        TerrainTileFile f;
+        return f.Open(path);
+    }
+
+    //  ʵ ϳ ߸ 纻 ߸ 纻  ź,  
+    void CheckCorrupt(const fs::path& dir)
+    {
+        const fs::path good = dir / "good.jmt", bad = dir / "bad.jmt";
+        std::vector<uint8_t> px(200 * 100, 7);
+        TerrainTileBuildDesc desc;
+        desc.tileSize = 32;
+        CHECK(TerrainTileFile::Build(good, 200, 100,
+            [&](int z, int count, uint8_t* dst) { std::memcpy(dst, px.data() + (size_t)z * 200, (size_t)count * 200); }, desc));
+        const std::vector<char> bytes = ReadAll(good);
+        CHECK(bytes.size() > sizeof(TerrainTileFormat::Header));
+        CHECK(OpensAs(bad, bytes));
+
+        auto patched = [&](size_t offset, uint32_t value) {
+            std::vector<char> b = bytes;
+            std::memcpy(b.data() + offset, &value, sizeof(value));
+            return b;
+        };
+        using H = TerrainTileFormat::Header;
+        CHECK(!OpensAs(bad, patched(offsetof(H, magic), 0x12345678)));
+        CHECK(!OpensAs(bad, patched(offsetof(H, version), TerrainTileFormat::kVersion + 1)));
+        CHECK(!OpensAs(bad, patched(offsetof(H, width), 201)));
+        CHECK(!OpensAs(bad, patched(offsetof(H, levels), 3)));
+        CHECK(!OpensAs(bad, patched(offsetof(H, tileSize), 8)));
+        CHECK(!OpensAs(bad, patched(offsetof(H, tileCount), 1u << 30)));
+
+        CHECK(!OpensAs(bad, std::vector<char>(bytes.begin(), bytes.end() - 1)));
+        CHECK(!OpensAs(bad, std::vector<char>(bytes.begin(), bytes.begin() + sizeof(H) - 1)));
+        CHECK(!OpensAs(bad, std::vector<char>()));
+        TerrainTileFile missing;
+        CHECK(!missing.Open(dir / "missing.jmt"));
+    }
+
+} // namespace
+
+int main()
+{
+    const fs::path dir = fs::temp_directory_path() / "jm_tile_file_test";
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+    fs::create_directories(dir);
+
+    CheckRoundTrip(dir, 1, 1, 16);
+    CheckRoundTrip(dir, 64, 64, 16);      // Ÿ ũ 
+    CheckRoundTrip(dir, 1000, 37, 16);
+    CheckRoundTrip(dir, 37, 1000, 32);
+    CheckRoundTrip(dir, 513, 257, 64);    // Ȧ     / 
+    CheckRoundTrip(dir, 300, 200, 256);   // Ÿ ϳ   0
+    CheckCorrupt(dir);
+
+    fs::remove_all(dir, ec);
+    return Test::Exit("TileFileTest");
+}
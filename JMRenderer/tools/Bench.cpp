@@ -0,0 +1,288 @@
+// 帮 ġũ : ⺰ Benchmark()/SelfCheck()  ̸  
+//   jm_bench              
+//   jm_bench pixel ...     (jm_bench --list ̸ Ȯ)
+//   --quick                ũ   (ctest ũ)
+//  (Į ο ġ,  ѵ ʰ ...) ϸ  ڵ 1
+#include "grid/GridIndices.h"
+#include "terrain/TerrainHeightField.h"
+#include "terrain/TerrainNoise.h"
+#include "terrain/TerrainPicker.h"
+#include "terrain/TerrainTileFile.h"
+#include "terrain/TerrainNormalBake.h"
+#include "utils/BlockCompress.h"
+#include "utils/FrameArena.h"
+#include "utils/FrustumCull.h"
+#include "utils/MipChain.h"
+#include "utils/PixelKernels.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+    struct Options {
+        bool quick = false;
+    };
+
+    //  ؽó δ ȼ Ŀ (ҽ Ʈ  GB/s) 
+    bool BenchPixelKernels(const Options& o)
+    {
+        const unsigned n = o.quick ? 512 : 4096;
+        bool ok = true;
+        for (PixelKernels::Path p : { PixelKernels::Path::Scalar, PixelKernels::Path::SSSE3, PixelKernels::Path::AVX2 }) {
+            if (PixelKernels::Resolve(p) != p) continue;    //  CPU  
+            const PixelKernels::BenchResult r = PixelKernels::Benchmark(n, n, p, o.quick ? 1 : 4);
+            std::printf("  %-6s %ux%u: RGB %.2f / RGBA %.2f / Gray %.2f GB/s, mismatch %zu\n",
+                PixelKernels::PathName(p), n, n, r.rgbGBs, r.rgbaGBs, r.grayGBs, r.mismatches);
+            ok = ok && r.mismatches == 0;
+        }
+        return ok;
+    }
+
+    //  CPU ü ( ð +  ڽ Ϳ ִ ) 
+    bool BenchMipChain(const Options& o)
+    {
+        const unsigned n = o.quick ? 256 : 4096;
+        const Mip::CheckResult rgba = Mip::SelfCheck(n, n, 4, MipFilter::SRGB);
+        const Mip::CheckResult r8 = Mip::SelfCheck(n, n, 1, MipFilter::Linear);
+        std::printf("  RGBA8 sRGB  %ux%u: %7.2f ms, max err %d\n", n, n, rgba.buildMs, rgba.maxError);
+        std::printf("  R8 Linear   %ux%u: %7.2f ms, max err %d\n", n, n, r8.buildMs, r8.maxError);
+        return rgba.maxError <= 1 && r8.maxError == 0;
+    }
+
+    //  BC1/BC4/BC5 ڴ (/,   PSNR) 
+    // PSNR  BlockCompressTest CheckQuality  ( ռ ؽó)
+    bool BenchBlockCompress(const Options& o)
+    {
+        const unsigned n = o.quick ? 128 : 1024;
+        struct Floor { BC::Format format; double minPsnr; };
+        const Floor floors[] = { { BC::Format::BC1, 35.0 }, { BC::Format::BC4, 50.0 }, { BC::Format::BC5, 50.0 } };
+        bool ok = true;
+        for (const Floor& f : floors)
+            for (BC::Quality q : { BC::Quality::Fast, BC::Quality::Normal, BC::Quality::High }) {
+                const BC::BenchResult r = BC::Benchmark(f.format, q, n, n, o.quick ? 1 : 3);
+                std::printf("  %s %-6s %ux%u: %7.2f Mblocks/s, %.2f dB%s\n",
+                    BC::FormatName(f.format), BC::QualityName(q), n, n, r.mblocksPerSec, r.psnr,
+                    r.psnr < f.minPsnr ? " (below floor)" : "");
+                ok = ok && r.psnr >= f.minPsnr;
+            }
+        return ok;
+    }
+
+    //  + ũ (Į / SIMD / Ƽ) 
+    bool BenchNormalBake(const Options& o)
+    {
+        const int n = o.quick ? 256 : 2048;
+        bool ok = true;
+        for (NormalBakeFilter f : { NormalBakeFilter::Central, NormalBakeFilter::Sobel }) {
+            const TerrainBake::BenchResult r = TerrainBake::Benchmark(n, n, f, o.quick ? 1 : 3);
+            std::printf("  %-7s %d^2: scalar %.2f / SIMD %.2f / MT %.2f ms, %.1f Mtexel/s, mismatch %zu\n",
+                f == NormalBakeFilter::Sobel ? "Sobel" : "Central", n,
+                r.scalarMs, r.simdMs, r.parallelMs, r.mtexelsPerSec, r.mismatches);
+            ok = ok && r.mismatches == 0;
+        }
+        return ok;
+    }
+
+    //   ̸  (κ / Msample/s) 
+    bool BenchNoise(const Options& o)
+    {
+        const int n = o.quick ? 256 : 1024;
+        bool ok = true;
+        for (NoiseType t : { NoiseType::FBm, NoiseType::Ridged, NoiseType::DomainWarp })
+            for (TerrainNoise::Path p : { TerrainNoise::Path::Scalar, TerrainNoise::Path::SSE41, TerrainNoise::Path::AVX2 }) {
+                if (TerrainNoise::Resolve(p) != p) continue;
+                const TerrainNoise::BenchResult r = TerrainNoise::Benchmark(n, n, t, p, o.quick ? 1 : 3);
+                std::printf("  %-10s %-6s %d^2: %7.2f MS/s (1T) / %7.2f MS/s (MT), mismatch %zu\n",
+                    TerrainNoise::TypeName(t), TerrainNoise::PathName(p), n,
+                    r.msamplesPerSec, r.msamplesPerSecMT, r.mismatches);
+                ok = ok && r.mismatches == 0;
+            }
+        return ok;
+    }
+
+    //  CPU   (˺ ð /  Ʈ, legacy push_back ο ) 
+    bool BenchGridBuild(const Options& o)
+    {
+        const int sizes[] = { 256, 1024, 4096 };
+        bool ok = true;
+        for (GridVertexFormat f : { GridVertexFormat::Float32, GridVertexFormat::Quant16, GridVertexFormat::VertexId })
+            for (int n : sizes) {
+                if (o.quick && n > 256) break;
+                if (f == GridVertexFormat::Float32 && n > 1024) continue;
+                const Grid::BenchResult r = Grid::Benchmark(n, f, n <= 1024);
+                std::printf("  %-8s %4d^2: %7.2f ms (legacy %7.2f ms), %5.1f B/vert, %6.1f MB, mismatch %zu\n",
+                    Grid::FormatName(f), n, r.buildMs, r.legacyMs, r.bytesPerVertex, r.bytes / (1024.0 * 1024.0), r.mismatches);
+                ok = ok && r.mismatches == 0;
+            }
+        return ok;
+    }
+
+    //  ü AABB ø (main  ī޶, κ Mbox/s) 
+    bool BenchCull(const Options& o)
+    {
+        const float eye[3] = { 0.0f, 2.0f, -5.0f }, target[3] = { 0.0f, 2.0f, -4.0f };
+        float vp[16];
+        Cull::LookAtViewProj(eye, target, 0.785398f, 16.0f / 9.0f, 0.1f, 500.0f, vp);
+        const Frustum f = Frustum::FromViewProj(vp);
+        bool ok = true;
+        for (CullPath p : { CullPath::Scalar, CullPath::SSE, CullPath::AVX }) {
+            if (Cull::ResolvePath(p) != p) continue;
+            for (size_t count : { (size_t)10000, (size_t)100000, (size_t)1000000 }) {
+                if (o.quick && count > 10000) break;
+                const Cull::BenchResult r = Cull::Benchmark(f, count, p, 100.0f, o.quick ? 1 : 8);
+                std::printf("  %-6s %7zu boxes: %7.1f Mbox/s, visible %zu, mismatch %zu\n",
+                    Cull::PathName(p), count, r.mboxesPerSec, r.visible, r.mismatches);
+                ok = ok && r.mismatches == 0;
+            }
+        }
+        return ok;
+    }
+
+    // ġũ : ⺻  ̸ n^2, main  10 x 10  /  1.5
+    bool InitField(int n, TerrainHeightField& field)
+    {
+        const std::vector<uint8_t> px = TerrainNoise::GenerateR8(NoiseParams{}, n, n);
+        return field.Init(px.data(), n, n, 10.0f, 10.0f, 1.5f);
+    }
+
+    //   ϰ  (κ  / ++ Mquery/s) 
+    bool BenchHeightQuery(const Options& o)
+    {
+        TerrainHeightField field;
+        if (!InitField(o.quick ? 256 : 1024, field)) return false;
+        const size_t count = o.quick ? (1 << 14) : (1 << 20);
+        bool ok = true;
+        for (TerrainHeightField::Path p : { TerrainHeightField::Path::Scalar, TerrainHeightField::Path::SSE41, TerrainHeightField::Path::AVX2 }) {
+            if (TerrainHeightField::Resolve(p) != p) continue;
+            const TerrainHeightField::BenchResult r = field.Benchmark(count, p, o.quick ? 1 : 4);
+            std::printf("  %-6s %zu queries: height %7.1f / +normal,slope %7.1f Mq/s, mismatch %zu\n",
+                TerrainHeightField::PathName(p), r.queries, r.mqueriesPerSec, r.mqueriesPerSecFull, r.mismatches);
+            ok = ok && r.mismatches == 0;
+        }
+        return ok;
+    }
+
+    //   ŷ (min/max Ƕ̵ vs  , /) 
+    bool BenchPick(const Options& o)
+    {
+        TerrainHeightField field;
+        TerrainPicker picker;
+        if (!InitField(o.quick ? 256 : 1024, field) || !picker.Build(field)) return false;
+        const TerrainPicker::BenchResult r = picker.Benchmark(o.quick ? 1000 : 10000, o.quick ? 1 : 3);
+        std::printf("  %zu rays, %zu hits: pyramid %.2f ms (MT %.2f), %.2f Mray/s, %.1f nodes/ray\n",
+            r.rays, r.hits, r.pickMs, r.pickMsMT, r.mraysPerSec, r.stepsPerRay);
+        std::printf("  naive march %.2f ms (%.1f samples/ray), disagree %zu\n",
+            r.marchMs, r.marchStepsPerRay, r.disagreements);
+        // ġ 밳   츮 ģ   1%  Ƕ̵  ȸͷ 
+        return r.hits > 0 && r.disagreements * 100 <= r.rays;
+    }
+
+    //  Ÿ   (Է MB/s) + ʵ   Ÿ б  
+    bool BenchTileFile(const Options& o)
+    {
+        const int n = o.quick ? 512 : 4096;
+        const std::vector<uint8_t> px = TerrainNoise::GenerateR8(NoiseParams{}, n, n);
+        // ÿ  ٸ jm_bench(ctest -j )  ġ ʵ ̸ ð + 
+        const std::string name = "jm_bench_tiles_" +
+            std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + "_" +
+            std::to_string(std::random_device{}()) + ".jmt";
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+        TerrainTileBuildDesc desc;
+        desc.heightScale = 1.5f;
+        desc.texelWorldX = desc.texelWorldZ = 10.0f / n;
+        TerrainTileBuildStats st;
+        bool ok = TerrainTileFile::Build(path, n, n,
+            [&](int z, int count, uint8_t* dst) { std::memcpy(dst, px.data() + (size_t)z * n, (size_t)count * n); }, desc, &st);
+        if (ok) {
+            std::printf("  build %dx%d: %d levels, %zu tiles, %.1f ms (%.1f + %.1f), %.1f MB/s, out %.1f MB, RAM %.2f MB\n",
+                n, n, st.levels, st.tiles, st.totalMs, st.pyramidMs, st.normalMs, st.mbPerSec, st.outputMB,
+                st.peakRamBytes / (1024.0 * 1024.0));
+            TerrainTileFile file;
+            std::vector<uint8_t> tile((size_t)desc.tileSize * desc.tileSize);
+            ok = file.Open(path) && file.ReadTile(0, 0, 0, tile.data());
+            //  0 ù Ÿ Է ״
+            for (int z = 0; ok && z < desc.tileSize; ++z)
+                ok = !std::memcmp(tile.data() + (size_t)z * desc.tileSize, px.data() + (size_t)z * n, desc.tileSize);
+            if (ok) {
+                const TerrainTileReadBench r = file.BenchmarkRandomReads(o.quick ? 4096 : 50000);
+                std::printf("  %d random reads: avg %.2f us, p50 %.2f, p99 %.2f, max %.1f us (%.0f MB/s)\n",
+                    r.reads, r.avgUs, r.p50Us, r.p99Us, r.maxUs, r.mbPerSec);
+                ok = r.reads > 0;
+            }
+        }
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        return ok;
+    }
+
+    //   Ʒ vs std::allocator (  ۾, Ӵ us) 
+    bool BenchFrameArena(const Options& o)
+    {
+        bool ok = true;
+        for (const FrameMem::BenchResult& r : FrameMem::Benchmark(o.quick ? 20 : 500)) {
+            std::printf("  %-14s std %8.2f us, arena %8.2f us (x%.2f), %6.1f KB/frame\n", r.name, r.stdUs, r.arenaUs,
+                r.arenaUs > 0.0 ? r.stdUs / r.arenaUs : 0.0, r.arenaBytes / 1024.0);
+            ok = ok && r.checksum != 0;
+        }
+        return ok;
+    }
+
+    struct Entry {
+        const char* name;
+        const char* desc;
+        bool (*fn)(const Options&);
+    };
+
+    const Entry kEntries[] = {
+        { "pixel", "BGR->RGBA / BGRA->RGBA / luma kernels", BenchPixelKernels },
+        { "mip", "CPU mip chain build", BenchMipChain },
+        { "bc", "BC1/BC4/BC5 block compression", BenchBlockCompress },
+        { "normal", "normal+height map bake", BenchNormalBake },
+        { "noise", "procedural heightmap noise", BenchNoise },
+        { "grid", "CPU grid vertex/index build", BenchGridBuild },
+        { "cull", "frustum vs AABB culling", BenchCull },
+        { "height", "batched heightfield queries", BenchHeightQuery },
+        { "pick", "terrain ray picking", BenchPick },
+        { "tiles", "tile file build + random tile reads", BenchTileFile },
+        { "arena", "frame arena vs std::allocator", BenchFrameArena },
+    };
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options o;
+    std::vector<const Entry*> run;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--quick")) { o.quick = true; continue; }
+        if (!std::strcmp(argv[i], "--list")) {
+            for (const Entry& e : kEntries) std::printf("%-10s %s\n", e.name, e.desc);
+            return 0;
+        }
+        const Entry* found = nullptr;
+        for (const Entry& e : kEntries)
+            if (!std::strcmp(argv[i], e.name)) found = &e;
+        if (!found) {
+            std::fprintf(stderr, "unknown benchmark '%s' (--list)\n", argv[i]);
+            return 2;
+        }
+        run.push_back(found);
+    }
+    if (run.empty())
+        for (const Entry& e : kEntries) run.push_back(&e);
+
+    int failed = 0;
+    for (const Entry* e : run) {
+        std::printf("[%s] %s\n", e->name, e->desc);
+        if (!e->fn(o)) {
+            std::printf("[%s] FAILED\n", e->name);
+            ++failed;
+        }
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,186 @@
+// 帮  ̹: Win32/D3D  main   θ ״ 
+//   LOD   ü ø  TerrainPass::Record  Sort  NullExecutor::Submit
+//   jm_frame                   240  , ܰ躰  ð + ο/ε/ 
+//   --frames <n>  --assets <dir>  --quick (60, ctest ũ)
+// ȿ ο, / ο  ġ,  Ű    ڵ 1
+#include "render/NullExecutor.h"
+#include "terrain/TerrainNoise.h"
+#include "terrain/TerrainPass.h"
+#include "terrain/TerrainSoft.h"
+#include "utils/BMPDecode.h"
+#include "utils/FrustumCull.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+#ifndef JM_ASSET_DIR
+#define JM_ASSET_DIR "assets"
+#endif
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    double Ms(Clock::time_point a, Clock::time_point b)
+    {
+        return std::chrono::duration<double, std::milli>(b - a).count();
+    }
+
+    struct Options {
+        std::filesystem::path assets = JM_ASSET_DIR;
+        int frames = 240;
+    };
+
+    // ̸   (main  ü )
+    std::vector<uint8_t> LoadHeights(const Options& o, int& w, int& h)
+    {
+        BMP::Image hm;
+        if (BMP::DecodeR8(o.assets / "heightmaps/hm.bmp", hm)) {
+            w = (int)hm.width; h = (int)hm.height;
+            std::vector<uint8_t> px((size_t)w * h);
+            for (int y = 0; y < h; ++y) std::memcpy(&px[(size_t)y * w], hm.data + y * hm.rowPitch, w);
+            return px;
+        }
+        w = h = 256;
+        return TerrainNoise::GenerateR8(NoiseParams{}, w, h);
+    }
+
+    // 鿣 ڿ  ּҸ ٸ ڸǥ ڵ (NullExecutor ڵ 񱳸 Ѵ)
+    struct Handles {
+        int slots[24] = {};
+        Render::Handle operator[](int i) { return &slots[i]; }
+    };
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options o;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--quick")) o.frames = 60;
+        else if (!std::strcmp(argv[i], "--frames") && i + 1 < argc) o.frames = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--assets") && i + 1 < argc) o.assets = argv[++i];
+        else {
+            std::fprintf(stderr, "unknown option '%s'\n", argv[i]);
+            return 2;
+        }
+    }
+    if (o.frames <= 0) return 2;
+
+    // : main BuildTerrainTree   (10 x 10, ġ 16)
+    int w = 0, h = 0;
+    const std::vector<uint8_t> heights = LoadHeights(o, w, h);
+    const float gridSize = 10.0f, heightScale = 1.5f, aspect = 16.0f / 9.0f, viewportH = 720.0f;
+    const int patchRes = 16;
+    TerrainQuadTreeDesc qd{};
+    qd.originX = -gridSize * 0.5f; qd.originZ = -gridSize * 0.5f;
+    qd.sizeX = gridSize; qd.sizeZ = gridSize;
+    qd.patchRes = patchRes;
+    qd.lodCount = TerrainQuadTree::SuggestLodCount(w, h, patchRes);
+    TerrainQuadTree tree;
+    tree.Build(qd, heights.data(), w, h);
+
+    Handles hd;
+    TerrainPassResources r;
+    r.pipeline.inputLayout = hd[0]; r.pipeline.vs = hd[1]; r.pipeline.ps = hd[2]; r.pipeline.rasterizer = hd[3];
+    r.pipeline.name = "terrain (null)";
+    TerrainPass::ApplyRequirements(r.pipeline);
+    r.patch.vb = hd[4]; r.patch.stride = Grid::VertexStride(GridVertexFormat::Quant16);
+    r.patch.ib = hd[5]; r.patch.indexFormat = Render::IndexFormat::U16;
+    r.indexCount = patchRes * patchRes * 6;
+    r.patchRes = patchRes;
+    r.sceneCB = hd[6]; r.terrainCB = hd[7]; r.matCB = hd[8]; r.nodeCB = hd[9];
+    r.heightSRV = hd[10]; r.normalSRV = hd[11]; r.heightSampler = hd[12];
+    for (int i = 0; i < 3; ++i) r.albedoSRVs[i] = hd[13 + i];
+    r.albedoSampler = hd[16];
+
+    TerrainSoftSceneCB scene{};
+    TerrainSoftTerrainCB terrain{};
+    terrain.HeightScale = heightScale;
+    terrain.UseBakedNormals = 1.0f;
+    terrain.GridSize[0] = terrain.GridSize[1] = gridSize;
+    terrain.TexelSize[0] = 1.0f / w; terrain.TexelSize[1] = 1.0f / h;
+    TerrainSoftMatCB mat{};
+
+    std::vector<TerrainDraw> draws;
+    std::vector<uint32_t> visible;
+    AABBSoA boxes;
+    Render::CommandList list;
+    NullExecutor exec;
+
+    double selectMs = 0, cullMs = 0, recordMs = 0, sortMs = 0, submitMs = 0;
+    uint64_t selected = 0, culled = 0, recorded = 0, binds = 0, elidedBinds = 0, uploads = 0, elidedUploads = 0, apiCalls = 0;
+    unsigned invalid = 0, drawMismatch = 0, unsorted = 0;
+    const char* firstError = nullptr;
+
+    for (int f = 0; f < o.frames; ++f) {
+        //    ,   
+        const float a = 6.2831853f * f / o.frames;
+        const float eye[3] = { 3.5f * std::cos(a), 2.0f, 3.5f * std::sin(a) };
+        const float target[3] = { eye[0] - std::sin(a), 1.7f, eye[2] + std::cos(a) };
+        float vp[16];
+        Cull::LookAtViewProj(eye, target, 0.785398f, aspect, 0.1f, 500.0f, vp);
+        for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 4; ++j) scene.WVP[j * 4 + i] = vp[i * 4 + j];
+        std::memcpy(scene.CamPos, eye, sizeof(eye));
+
+        const Clock::time_point t0 = Clock::now();
+        TerrainSelectParams sp{};
+        std::memcpy(sp.camPos, eye, sizeof(eye));
+        sp.heightScale = heightScale;
+        sp.viewportH = viewportH;
+        tree.Select(sp, draws);
+
+        const Clock::time_point t1 = Clock::now();
+        boxes.Clear();
+        boxes.Reserve(draws.size());
+        for (const TerrainDraw& d : draws) boxes.Push(d.x, d.minY, d.z, d.x + d.sizeX, d.maxY, d.z + d.sizeZ);
+        visible.resize(draws.size());
+        visible.resize(Cull::FrustumAABBs(Frustum::FromViewProj(vp), boxes, visible.data()));
+
+        const Clock::time_point t2 = Clock::now();
+        TerrainPassConstants k;
+        k.scene = &scene;     k.sceneBytes = sizeof(scene);
+        k.terrain = &terrain; k.terrainBytes = sizeof(terrain);
+        k.mat = &mat;         k.matBytes = sizeof(mat);
+        std::memcpy(k.camPos, eye, sizeof(eye));
+        list.Reset();
+        TerrainPass::Record(list, r, k, tree, draws, visible);
+
+        const Clock::time_point t3 = Clock::now();
+        list.Sort();
+
+        const Clock::time_point t4 = Clock::now();
+        const Render::ExecStats& s = exec.Submit(list);
+        const Clock::time_point t5 = Clock::now();
+
+        selectMs += Ms(t0, t1); cullMs += Ms(t1, t2); recordMs += Ms(t2, t3);
+        sortMs += Ms(t3, t4); submitMs += Ms(t4, t5);
+        selected += draws.size();
+        culled += draws.size() - visible.size();
+        recorded += list.Draws().size();
+        binds += s.Binds(); elidedBinds += s.elidedBinds;
+        uploads += s.uploads; elidedUploads += s.elidedUploads;
+        apiCalls += s.apiCalls;
+        invalid += s.invalidDraws;
+        if (!firstError) firstError = s.firstError;
+        if (s.draws + s.invalidDraws != list.Draws().size()) ++drawMismatch;
+        for (size_t i = 1; i < list.Draws().size(); ++i)
+            if (list.Draws()[i].key < list.Draws()[i - 1].key) { ++unsorted; break; }
+    }
+
+    const double n = o.frames;
+    std::printf("terrain %dx%d, %d frames\n", w, h, o.frames);
+    std::printf("  per frame: select %.3f / cull %.3f / record %.3f / sort %.3f / submit %.3f ms\n",
+        selectMs / n, cullMs / n, recordMs / n, sortMs / n, submitMs / n);
+    std::printf("  nodes %.1f selected, %.1f culled, %.1f draws\n", selected / n, culled / n, recorded / n);
+    std::printf("  binds %.1f (elided %.1f), uploads %.1f (elided %.1f), backend calls %.1f\n",
+        binds / n, elidedBinds / n, uploads / n, elidedUploads / n, apiCalls / n);
+    std::printf("  invalid draws %u%s%s, draw count mismatch %u, unsorted frames %u\n",
+        invalid, firstError ? ": " : "", firstError ? firstError : "", drawMismatch, unsorted);
+    return (invalid || drawMismatch || unsorted || !recorded) ? 1 : 0;
+}
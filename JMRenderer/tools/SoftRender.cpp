@@ -0,0 +1,121 @@
+// 帮  : GPU/â  TerrainSoftRenderer  ̹ BMP   κ ó 
+//   jm_soft_render                         assets 1280x720    soft_frame.bmp + ġũ
+//   --assets <dir>                         hm.bmp / textures/*.bmp ġ (  ̸ + ܻ)
+//   --out <file.bmp>  --size <W>x<H>  --format float32|quant16|vertexid
+//   --no-bench / --quick                   ġũ  /  ũ   (ctest ũ)
+// ī޶ main  ġ(0, 2, -5) +Z .   ̹ ġ   ڵ 1
+#include "terrain/TerrainNoise.h"
+#include "terrain/TerrainSoft.h"
+#include "utils/FrustumCull.h"
+#include "utils/BMPDecode.h"
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+#ifndef JM_ASSET_DIR
+#define JM_ASSET_DIR "assets"
+#endif
+
+namespace {
+
+    struct Options {
+        std::filesystem::path assets = JM_ASSET_DIR;
+        std::filesystem::path out = "soft_frame.bmp";
+        int width = 1280, height = 720;
+        GridVertexFormat format = GridVertexFormat::Quant16;
+        bool bench = true;
+        bool quick = false;
+    };
+
+    bool ParseFormat(const char* s, GridVertexFormat& f)
+    {
+        for (GridVertexFormat c : { GridVertexFormat::Float32, GridVertexFormat::Quant16, GridVertexFormat::VertexId }) {
+            std::string name = Grid::FormatName(c);
+            for (char& ch : name) ch = (char)std::tolower((unsigned char)ch);
+            if (name == s) { f = c; return true; }
+        }
+        return false;
+    }
+
+    // ̸  main   ̸ (⺻ NoiseParams, 256^2)
+    bool InitRenderer(const Options& o, TerrainSoftRenderer& r)
+    {
+        BMP::Image hm;
+        bool ok;
+        if (BMP::DecodeR8(o.assets / "heightmaps/hm.bmp", hm)) {
+            std::vector<uint8_t> packed((size_t)hm.width * hm.height);
+            for (unsigned y = 0; y < hm.height; ++y)
+                std::memcpy(&packed[(size_t)y * hm.width], hm.data + y * hm.rowPitch, hm.width);
+            ok = r.Init(packed.data(), (int)hm.width, (int)hm.height, 10.0f, 10.0f, 16);
+            std::printf("heightmap %ux%u (hm.bmp)\n", hm.width, hm.height);
+        }
+        else {
+            const std::vector<uint8_t> gen = TerrainNoise::GenerateR8(NoiseParams{}, 256, 256);
+            ok = r.Init(gen.data(), 256, 256, 10.0f, 10.0f, 16);
+            std::printf("heightmap 256x256 (procedural)\n");
+        }
+        if (!ok) return false;
+
+        const char* albedo[3] = { "textures/grass.bmp", "textures/rock.bmp", "textures/snow.bmp" };
+        for (int i = 0; i < 3; ++i) {
+            BMP::Image img;
+            if (BMP::DecodeRGBA8(o.assets / albedo[i], img, false))
+                r.SetAlbedo(i, img.data, (int)img.width, (int)img.height, img.rowPitch);
+        }
+        return true;
+    }
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options o;
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--quick")) { o.quick = true; o.width = 320; o.height = 180; }
+        else if (!std::strcmp(argv[i], "--no-bench")) o.bench = false;
+        else if (!std::strcmp(argv[i], "--assets") && hasValue) o.assets = argv[++i];
+        else if (!std::strcmp(argv[i], "--out") && hasValue) o.out = argv[++i];
+        else if (!std::strcmp(argv[i], "--size") && hasValue && std::sscanf(argv[i + 1], "%dx%d", &o.width, &o.height) == 2) ++i;
+        else if (!std::strcmp(argv[i], "--format") && hasValue && ParseFormat(argv[i + 1], o.format)) ++i;
+        else {
+            std::fprintf(stderr, "unknown option '%s'\n", argv[i]);
+            return 2;
+        }
+    }
+    if (o.width <= 0 || o.height <= 0) return 2;
+
+    TerrainSoftRenderer renderer;
+    if (!InitRenderer(o, renderer)) {
+        std::fprintf(stderr, "TerrainSoftRenderer::Init failed\n");
+        return 1;
+    }
+
+    TerrainSoftFrame f;
+    f.format = o.format;
+    const float eye[3] = { 0.0f, 2.0f, -5.0f }, target[3] = { 0.0f, 2.0f, -4.0f };
+    std::memcpy(f.camPos, eye, sizeof(eye));
+    Cull::LookAtViewProj(eye, target, f.fovY, (float)o.width / o.height, 0.1f, 500.0f, f.viewProj);
+
+    Soft::Target image;
+    image.Resize(o.width, o.height);
+    const Soft::FrameStats& s = renderer.Render(f, image);
+    const bool written = image.WriteBMP(o.out);
+    std::printf("%s %dx%d: %zu draws, %zu tris (culled %zu, clipped %zu), %zu px, %.2f ms%s%s\n",
+        Grid::FormatName(o.format), o.width, o.height, s.draws, s.triangles, s.culled, s.clipped,
+        s.pixelsShaded, s.totalMs, written ? " -> " : "", written ? o.out.string().c_str() : "");
+    if (!written || !s.pixelsShaded || renderer.ExecStats().invalidDraws) return 1;
+    if (!o.bench) return 0;
+
+    bool ok = true;
+    for (Soft::Path p : { Soft::Path::Scalar, Soft::Path::SSE41, Soft::Path::AVX2 }) {
+        if (Soft::Resolve(p) != p) continue;
+        const TerrainSoftRenderer::BenchResult b = renderer.Benchmark(f, o.width, o.height, p, o.quick ? 1 : 3);
+        std::printf("  %-6s 1T %7.2f ms / MT %7.2f ms, %.1f Mpix/s, mismatch %zu\n",
+            Soft::PathName(b.path), b.singleMs, b.parallelMs, b.mpixPerSec, b.mismatches);
+        ok = ok && b.mismatches == 0;
+    }
+    return ok ? 0 : 1;
+}